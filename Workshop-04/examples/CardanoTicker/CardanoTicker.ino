@@ -17,6 +17,10 @@
  * 3. Fetches your token positions from MinSwap API
  * 4. Fetches your NFT collection data from MinSwap and Cexplorer APIs
  * 5. Displays this information on rotating screens with a scrolling ticker
+ *
+ * Nothing waits for anything else at startup: the screens show the data
+ * saved before the restart right away, WiFi connects in the background, and
+ * each piece of fresh data appears as soon as it arrives (see boot_timing.h).
  */
 
 // Include necessary libraries
@@ -24,15 +28,37 @@
 #include <TFT_eSPI.h> // TFT display library for ESP32
 
 // Include our custom header files
+#include "boot_timing.h"   // How long each stage of the boot took
 #include "config.h"        // Configuration (API URLs, addresses)
 #include "data_fetcher.h"  // Functions to fetch data from blockchain APIs
 #include "datascreens.h"   // Screen drawing functions
+#include "fleet_sync.h"    // Sharing data with other tickers (MQTT)
+#include "heap_profiler.h" // Free heap, fragmentation and who allocates
+#include "logger.h"        // Log messages written in the background
+#include "loop_profiler.h" // What loop() spends its time on
 #include "screen_helper.h" // Helper functions for screen rendering
 #include "secrets.h"       // WiFi credentials (not in git)
 #include "startscreen.h"   // Startup screen display
 #include "ticker.h"        // Scrolling ticker at bottom of screen
+#include "trace.h"         // Timeline of what the firmware does
 #include "wifi_manager.h"  // WiFi connection management
 
+// More WiFi networks (optional, see secrets.h.example). Older secrets.h
+// files don't have them, so they default to empty (not used).
+#ifndef WIFI_SSID_2
+#define WIFI_SSID_2 ""
+#define WIFI_PASSWORD_2 ""
+#endif
+#ifndef WIFI_SSID_3
+#define WIFI_SSID_3 ""
+#define WIFI_PASSWORD_3 ""
+#endif
+
+// The networks the device may use; it picks the best router in range
+const WifiNetwork wifiNetworks[] = {{WIFI_SSID, WIFI_PASSWORD},
+                                    {WIFI_SSID_2, WIFI_PASSWORD_2},
+                                    {WIFI_SSID_3, WIFI_PASSWORD_3}};
+
 // Create TFT display object
 // This is a global object that all screen files can access
 // TFT = Thin Film Transistor (the type of display technology)
@@ -49,6 +75,43 @@ uint8_t currentScreenIndex = 0;
 
 // Timestamp of when we last changed screens (used to know when to rotate)
 unsigned long lastScreenChange = 0;
+
+// Without saved data, the start screen stays up until the first data
+// arrives, but no longer than this (30 seconds)
+const unsigned long START_SCREEN_MAX_MS = 30000UL;
+
+// Data screens and ticker are running (the start screen is gone)
+bool screensStarted = false;
+
+// When setup() ran, for START_SCREEN_MAX_MS
+unsigned long setupMs = 0;
+
+// Fetch times the screens last showed, to notice data from other tickers
+unsigned long shownKoiosFetch = 0;
+unsigned long shownPortfolioFetch = 0;
+
+// The calls loop() makes, timed by the loop profiler (see loop_profiler.h)
+enum LoopSection {
+  SECTION_WIFI,   // wifiManagerLoop()
+  SECTION_MQTT,   // fleetSyncLoop()
+  SECTION_FETCH,  // updateDataStep(): at most one API request
+  SECTION_SCREEN, // Drawing a data screen
+  SECTION_TICKER, // updateTicker()
+  SECTION_COUNT
+};
+const char *const SECTION_NAMES[SECTION_COUNT] = {"wifi", "mqtt", "fetch",
+                                                  "screen", "ticker"};
+
+// A loop() that takes longer than this is logged as a stall. One API request
+// (TLS handshake included) fits; a request that runs into its timeout, or
+// a screen that takes a second to draw, does not.
+const unsigned long LOOP_BUDGET_MS = 1000UL;
+
+// Record a trace of the boot (see trace.h). Send d over Serial to dump it.
+const bool TRACE_BOOT = false;
+
+// How often the heap profiler logs free heap and fragmentation (10 minutes)
+const unsigned long HEAP_SAMPLE_INTERVAL_MS = 600000UL;
 } // namespace
 
 /**
@@ -59,6 +122,7 @@ unsigned long lastScreenChange = 0;
  * channels on a TV.
  */
 void showCurrentScreen() {
+  TRACE_SCOPE("screen"); // See trace.h
   switch (currentScreenIndex) {
   case 0:
     drawWalletScreen(); // Show wallet balance screen
@@ -75,6 +139,68 @@ void showCurrentScreen() {
   }
 }
 
+/**
+ * Which data the current screen shows (DATA_... bits from data_fetcher.h)
+ *
+ * When new data arrives, only the screen that shows it is drawn again.
+ */
+uint8_t dataOnCurrentScreen() {
+  switch (currentScreenIndex) {
+  case 0:
+    return DATA_BALANCE;
+  case 1:
+    return DATA_TOKENS;
+  case 2:
+    return DATA_NFTS;
+  default:
+    return 0; // The status screen shows no fetched data
+  }
+}
+
+/**
+ * Commands from the Serial Monitor for the trace recorder (see trace.h) and
+ * the heap profiler (see heap_profiler.h)
+ *
+ * t: record the next 2000 events (about one refresh cycle)
+ * d: dump them as Chrome trace JSON, to save as a .json file and open at
+ *    https://ui.perfetto.dev
+ * h: sample the heap now and list what allocated most
+ */
+void handleSerialCommands() {
+  while (Serial.available() > 0) {
+    const int command = Serial.read();
+    if (command == 't') {
+      if (traceStart()) {
+        Serial.println("Trace: recording, send d to dump");
+      }
+    } else if (command == 'd') {
+      traceDump(Serial);
+    } else if (command == 'h') {
+      heapProfilerSample();
+      heapProfilerReport(Serial);
+    }
+  }
+}
+
+/**
+ * Replace the start screen with the rotating data screens and the ticker
+ */
+void startScreens() {
+  // Initialize the scrolling ticker at the bottom of the screen
+  // The ticker shows token prices scrolling horizontally
+  initTicker();
+
+  // Show the first screen (wallet screen)
+  showCurrentScreen();
+
+  // Update the ticker to show initial content
+  updateTicker();
+
+  // Record when we last changed screens (right now, since we just showed one)
+  lastScreenChange = millis();
+  screensStarted = true;
+}
+
 /**
  * setup() - Arduino initialization function
  *
@@ -90,6 +216,22 @@ void setup() {
   // You can view these messages in the Arduino IDE Serial Monitor
   Serial.begin(115200);
 
+  // Log messages go through a ring buffer and are written in the
+  // background, so fetching and drawing don't wait for the slow UART
+  loggerBegin();
+
+  // Start the boot clock: every stage of the boot is logged with its time
+  bootTimingStart();
+  if (TRACE_BOOT) {
+    traceStart();
+  }
+
+  // Time every call in loop() and log the ones that hold it up
+  loopProfilerBegin(SECTION_NAMES, SECTION_COUNT, LOOP_BUDGET_MS);
+
+  // Log free heap and fragmentation every 10 minutes, to see it creep
+  heapProfilerBegin(HEAP_SAMPLE_INTERVAL_MS);
+
   // Initialize TFT display
   // This tells the display to wake up and get ready to show graphics
   tft.init();
@@ -108,63 +250,37 @@ void setup() {
 
   Serial.println("Start screen displayed!");
 
+  // Something is on the display: the first thing a user sees
+  bootStageDone(BOOT_FIRST_PIXEL);
+
   // Set up WiFi connection
   // WIFI_SSID is your WiFi network name
   // WIFI_PASSWORD is your WiFi password
   // These are defined in secrets.h (which you should create from
-  // secrets.h.example)
-  wifiManagerSetup(WIFI_SSID, WIFI_PASSWORD);
+  // secrets.h.example), together with up to two more networks
+  // This only starts connecting - WiFi connects in the background while
+  // setup() goes on, and wifiManagerLoop() in loop() notices when it is up
+  wifiManagerSetup(wifiNetworks, 3);
 
   // Initialize data fetcher
   // This sets all our data storage variables to zero/empty
   // Think of it as clearing a whiteboard before we start writing
   initDataFetcher();
 
-  // Wait for WiFi connection (with timeout)
-  // We need WiFi to fetch data from the internet, so we wait here
-  Serial.println("Waiting for WiFi connection...");
-  const unsigned long wifiTimeout =
-      30000; // 30 seconds timeout (in milliseconds)
-  const unsigned long wifiStart = millis(); // Record when we started waiting
-
-  // Keep checking if WiFi is connected, but don't wait forever
-  // millis() returns the number of milliseconds since the device started
-  while (!wifiManagerIsConnected() && (millis() - wifiStart) < wifiTimeout) {
-    wifiManagerLoop(); // Check WiFi status and try to connect
-    delay(100);        // Wait 100ms before checking again (don't waste CPU)
-  }
+  // If other tickers share their data over MQTT (mqttBroker in config.cpp),
+  // connect to the broker as soon as WiFi is up: when one of them already
+  // fetches, its data arrives within a moment and this ticker does not need
+  // to ask the APIs
+  fleetSyncBegin();
 
-  // If we successfully connected to WiFi, fetch data immediately
-  if (wifiManagerIsConnected()) {
-    Serial.println("WiFi connected, fetching initial data...");
-    // Force immediate fetch by calling update functions
-    // Normally these functions check if enough time has passed, but on startup
-    // we want data right away, so we call them directly
-    updateKoiosData();     // Fetch wallet balance from Koios API
-    updatePortfolioData(); // Fetch tokens and NFTs from MinSwap API
-  } else {
-    Serial.println(
-        "WiFi connection timeout - data will be fetched when connected");
-    // If WiFi failed, the device will still work, it just won't have data yet
-    // The loop() function will keep trying to connect
+  // Show the data saved before the restart right away. It is replaced piece
+  // by piece as fresh data arrives. On the very first start there is none,
+  // and the start screen stays up until the first data arrives.
+  setupMs = millis();
+  if (loadSavedData()) {
+    startScreens();
+    bootStageDone(BOOT_SAVED_DATA);
   }
-
-  // Wait a bit before starting the rotating data screens
-  // This gives the display time to settle and looks more professional
-  delay(1000);
-
-  // Initialize the scrolling ticker at the bottom of the screen
-  // The ticker shows token prices scrolling horizontally
-  initTicker();
-
-  // Show the first screen (wallet screen)
-  showCurrentScreen();
-
-  // Update the ticker to show initial content
-  updateTicker();
-
-  // Record when we last changed screens (right now, since we just showed one)
-  lastScreenChange = millis();
 }
 
 /**
@@ -175,30 +291,86 @@ void setup() {
  *
  * In this loop, we:
  * 1. Check/maintain WiFi connection
- * 2. Update blockchain data (but only when enough time has passed)
- * 3. Rotate between different screens every 10 seconds
- * 4. Update the scrolling ticker at the bottom
+ * 2. Update blockchain data (one request per pass, when it is due)
+ * 3. Redraw the screen if the data it shows just changed
+ * 4. Rotate between different screens every 10 seconds
+ * 5. Update the scrolling ticker at the bottom
+ *
+ * The loop profiler times each of these calls (loopProfilerDone() after
+ * each one), so a slow loop() can be blamed on the call that caused it.
  */
 void loop() {
+  // Before loopProfilerStart(): a trace dump takes seconds, and is counted
+  // as "other" instead of as a stall of the WiFi manager
+  handleSerialCommands();
+  loggerLoop();
+  heapProfilerLoop();
+  loopProfilerStart();
+
   // Keep WiFi connection alive and check for reconnection if needed
   // This needs to be called regularly to maintain the connection
   wifiManagerLoop();
+  if (wifiManagerIsConnected()) {
+    bootStageDone(BOOT_WIFI); // Only the first time counts
+  }
+  loopProfilerDone(SECTION_WIFI);
 
-  // Update data fetchers (they handle their own timing internally)
-  // These functions check internally if enough time has passed since last fetch
-  // They won't fetch too often, which saves bandwidth and API rate limits
-  updateKoiosData(); // Checks if 1 minute passed, then fetches wallet balance
-  updatePortfolioData(); // Checks if 10 minutes passed, then fetches
-                         // tokens/NFTs
+  // Share data with other tickers over MQTT (does nothing without a broker)
+  // This shows data another ticker fetched, or publishes what we fetched
+  fleetSyncLoop();
+  loopProfilerDone(SECTION_MQTT);
 
-  // Check if it's time to rotate to the next screen
+  // Update blockchain data (the data fetcher handles its own timing)
+  // Each call makes at most one request: the balance every minute, tokens
+  // and NFTs every 10 minutes, then the NFT floor prices one by one. That
+  // way the ticker keeps scrolling and each piece shows up when it arrives.
+  // With MQTT sharing, only one ticker fetches; the others skip this
+  uint8_t changed = 0;
+  if (fleetSyncShouldFetch()) {
+    changed = updateDataStep();
+  }
+  loopProfilerDone(SECTION_FETCH);
+
+  // Data another ticker fetched (MQTT) arrives without updateDataStep()
+  if (getLastKoiosFetchTime() != shownKoiosFetch) {
+    shownKoiosFetch = getLastKoiosFetchTime();
+    changed |= DATA_BALANCE;
+  }
+  if (getLastPortfolioFetchTime() != shownPortfolioFetch) {
+    shownPortfolioFetch = getLastPortfolioFetchTime();
+    changed |= DATA_TOKENS | DATA_NFTS;
+  }
+
+  // First start: leave the start screen when the first data is in
   const unsigned long now = millis(); // Get current time
-  if (now - lastScreenChange >= SCREEN_DURATION_MS) {
+  if (!screensStarted) {
+    if (changed != 0 || (uint32_t)(now - setupMs) >= START_SCREEN_MAX_MS) {
+      startScreens();
+      loopProfilerDone(SECTION_SCREEN);
+    } else {
+      delay(10); // Nothing to animate yet
+    }
+    return;
+  }
+
+  // Show new data at once instead of at the next screen change
+  if (changed & DATA_TOKENS) {
+    refreshTicker();
+  }
+  if (changed & dataOnCurrentScreen()) {
+    showCurrentScreen();
+  }
+
+  // Check if it's time to rotate to the next screen
+  // millis() starts again at 0 after 49.7 days; the difference, taken in
+  // 32 bits like millis() itself, is still right then
+  if ((uint32_t)(now - lastScreenChange) >= SCREEN_DURATION_MS) {
     // Time to switch screens!
     // The % operator gives us the remainder after division
     // This creates a cycle: 0 -> 1 -> 2 -> 3 -> 0 -> 1 -> ...
     // Example: if currentScreenIndex is 3, (3+1) % 4 = 0 (back to first screen)
     currentScreenIndex = (currentScreenIndex + 1) % TOTAL_SCREENS;
+    TRACE_INSTANT("screen change");
 
     // Draw the new screen
     showCurrentScreen();
@@ -206,8 +378,10 @@ void loop() {
     // Record when we changed screens so we know when to change again
     lastScreenChange = now;
   }
+  loopProfilerDone(SECTION_SCREEN);
 
   // Update the scrolling ticker at the bottom of the screen
   // This needs to be called frequently to create smooth scrolling animation
   updateTicker();
+  loopProfilerDone(SECTION_TICKER);
 }
\ No newline at end of file
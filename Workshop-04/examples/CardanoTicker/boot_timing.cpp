@@ -0,0 +1,51 @@
+/**
+ * boot_timing.cpp - Implementation of boot stage timing
+ *
+ * Keeps one timestamp per stage. The stages are reported from loop() and
+ * from the data fetcher, which both run in the Arduino loop task, so no
+ * locking is needed.
+ */
+
+#include "boot_timing.h"
+
+namespace {
+
+// Shown in the Serial output, in BootStage order
+const char *const STAGE_NAMES[BOOT_STAGES] = {
+    "first pixel", "saved data", "WiFi", "balance", "tokens", "fresh data"};
+
+unsigned long bootStartMs = 0;           // millis() when setup() started
+unsigned long stageMs[BOOT_STAGES] = {}; // After bootStartMs
+bool reached[BOOT_STAGES] = {};
+
+} // namespace
+
+void bootTimingStart() {
+  bootStartMs = millis();
+  for (int i = 0; i < BOOT_STAGES; ++i) {
+    stageMs[i] = 0;
+    reached[i] = false;
+  }
+}
+
+void bootStageDone(BootStage stage) {
+  if (stage >= BOOT_STAGES || reached[stage]) {
+    return; // Only the first time counts
+  }
+  reached[stage] = true;
+  stageMs[stage] = millis() - bootStartMs;
+
+  Serial.print("Boot: ");
+  Serial.print(STAGE_NAMES[stage]);
+  Serial.print(" after ");
+  Serial.print(stageMs[stage]);
+  Serial.println(" ms");
+}
+
+bool bootStageReached(BootStage stage) {
+  return stage < BOOT_STAGES && reached[stage];
+}
+
+unsigned long bootStageMs(BootStage stage) {
+  return bootStageReached(stage) ? stageMs[stage] : 0;
+}
@@ -0,0 +1,70 @@
+/**
+ * boot_timing.h - Header file for measuring how fast the ticker starts
+ *
+ * Boot runs in stages that overlap: the screen and the data saved before the
+ * last restart appear first, WiFi connects in the background, and the data
+ * is fetched piece by piece. This module notes when each stage is reached
+ * and prints it to Serial, for example:
+ *
+ *   Boot: first pixel after 41 ms
+ *   Boot: saved data after 63 ms
+ *   Boot: WiFi after 312 ms
+ *   Boot: balance after 655 ms
+ *   Boot: tokens after 1561 ms
+ *   Boot: fresh data after 2765 ms
+ *
+ * Times count from the start of setup(). The ESP32's own start before that
+ * (bootloader, loading the program) takes about the same time on every boot.
+ */
+
+#ifndef BOOT_TIMING_H
+#define BOOT_TIMING_H
+
+#include <Arduino.h>
+
+// The stages of a boot, in the order they usually happen
+enum BootStage {
+  BOOT_FIRST_PIXEL, // Something is on the display (the start screen)
+  BOOT_SAVED_DATA,  // Data saved before the restart is on the display
+  BOOT_WIFI,        // Connected with an IP address
+  BOOT_BALANCE,     // A fresh wallet balance arrived
+  BOOT_TOKENS,      // Fresh tokens arrived
+  BOOT_FRESH_DATA,  // Everything is fresh: balance, tokens, NFTs and their
+                    // floor prices
+  BOOT_STAGES       // Number of stages
+};
+
+/**
+ * Start the boot clock
+ *
+ * Call first thing in setup(). Forgets the stages of an earlier boot.
+ */
+void bootTimingStart();
+
+/**
+ * Note that a stage was reached
+ *
+ * Only the first call for a stage counts and is printed, so it can be called
+ * every time the stage's condition is true (for example from loop()).
+ *
+ * @param stage The stage
+ */
+void bootStageDone(BootStage stage);
+
+/**
+ * Has this boot reached the stage yet?
+ *
+ * @param stage The stage
+ * @return true once bootStageDone() was called for it
+ */
+bool bootStageReached(BootStage stage);
+
+/**
+ * When the stage was reached
+ *
+ * @param stage The stage
+ * @return Milliseconds after bootTimingStart(), or 0 if not reached yet
+ */
+unsigned long bootStageMs(BootStage stage);
+
+#endif
@@ -29,6 +29,9 @@ String cexplorerApiKey = "your-api-key-here";
 
 // API endpoint URLs
 // These point to Cardano blockchain APIs used to fetch wallet data
+// With many tickers on one network, run chain-gateway (repository root) and
+// use its URLs instead, e.g. "http://gateway.local:8080/koios/account_info",
+// so the tickers share answers instead of each asking the APIs
 
 // Koios API endpoint - fetches wallet balance (ADA)
 // Koios is a Cardano blockchain indexer that provides fast access to blockchain
@@ -44,3 +47,23 @@ const char *minswapApiUrl =
 // Cexplorer provides detailed NFT collection information including floor prices
 const char *cexplorerApiUrl =
     "https://api-mainnet-stage.cexplorer.io/v1/policy/detail";
+
+// chain-gateway snapshot endpoint - tokens and NFTs in one small binary answer
+// When set, the ticker asks the gateway for a ready-made snapshot instead of
+// parsing the MinSwap and Cexplorer JSON itself, and only falls back to those
+// APIs if the gateway does not answer. Leave empty without a gateway.
+// Example: "http://gateway.local:8080/snapshot/ticker"
+const char *snapshotUrl = "";
+
+// MQTT broker for sharing data between tickers (optional)
+// With several tickers showing the same wallet, set this to a broker on
+// your network (e.g. Mosquitto on a Raspberry Pi). One ticker then fetches
+// the data and publishes it; the others receive it instead of asking the
+// APIs themselves. Leave empty to have every ticker fetch on its own.
+// Example: "192.168.1.10" or "mqtt.local"
+const char *mqttBroker = "";
+const uint16_t mqttPort = 1883;
+
+// Tickers using the same topic prefix share data, so give each wallet its
+// own prefix (e.g. "cardanoticker/office" and "cardanoticker/home")
+const char *fleetTopic = "cardanoticker/office";
@@ -25,5 +25,11 @@ extern String walletAddress;
 extern const char *koiosApiUrl;      // Koios API - for wallet balance
 extern const char *minswapApiUrl;    // MinSwap API - for tokens and NFTs
 extern const char *cexplorerApiUrl;  // Cexplorer API - for NFT floor prices
+extern const char *snapshotUrl;      // chain-gateway snapshots (optional)
+
+// Sharing data between tickers over MQTT (optional, see fleet_sync.cpp)
+extern const char *mqttBroker;       // Broker host name or IP, "" = off
+extern const uint16_t mqttPort;      // Broker port (1883 = plain MQTT)
+extern const char *fleetTopic;       // Topic prefix shared by the tickers
 
 #endif
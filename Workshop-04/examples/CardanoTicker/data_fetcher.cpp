@@ -6,12 +6,17 @@
  * - Fetching wallet balance from Koios API
  * - Fetching token positions from MinSwap API
  * - Fetching NFT collection data from MinSwap and Cexplorer APIs
+ * - Or, with chain-gateway, fetching all tokens and NFTs as one small binary
+ *   snapshot (ticker_snapshot.h) instead of parsing the JSON here
  * - Storing and organizing all this data for display
+ * - Saving it in flash (NVS), so it can be shown right after a restart
  *
  * Key Concepts:
  * - HTTP requests: How we talk to APIs over the internet
  * - JSON parsing: APIs return data in JSON format, we need to extract it
  * - Rate limiting: We don't fetch too often to avoid hitting API limits
+ * - Steps: updateDataStep() makes one request at a time, most important
+ *   first, so the screens can show each piece as soon as it arrives
  */
 
 #include "data_fetcher.h"
@@ -19,15 +24,25 @@
 // Libraries for making HTTP requests and parsing JSON responses
 #include <ArduinoJson.h> // Parses JSON data from APIs
 #include <HTTPClient.h>  // Makes HTTP requests (GET, POST) to APIs
+#include <Preferences.h> // NVS storage for the data shown after a restart
 #include <WiFi.h>        // WiFi functionality
 
 // Our custom headers
+#include "boot_timing.h"  // Time to fresh data after a restart
 #include "config.h"       // API URLs and wallet addresses
+#include "heap_profiler.h" // Heap taken per request (HEAP_SCOPE)
+#include "logger.h"       // Log messages that don't hold up the fetch
+#include "policy_table.h" // NFT collections by Policy ID
+#include "ticker_snapshot.h" // Binary portfolio snapshots from chain-gateway
+#include "trace.h"        // Timeline of requests and parsing (traceStart())
 #include "wifi_manager.h" // WiFi connection management
 
 // Private namespace - these variables are only accessible within this file
 namespace {
 
+// Module name in log messages
+const char *const LOG_MODULE = "fetcher";
+
 // How often to fetch wallet balance (1 minute = 60,000 milliseconds)
 // UL = unsigned long (ensures the number is treated as the right type)
 constexpr unsigned long KOIOS_INTERVAL_MS = 60UL * 1000UL;
@@ -47,6 +62,20 @@ constexpr size_t MAX_TOKENS = 8;
 // Maximum number of NFT collections we can store (limited by screen display)
 constexpr size_t MAX_NFTS = 8;
 
+// Room reserved up front for the Strings above. Reserved in
+// initDataFetcher(), before any request, they sit together at the start of
+// the heap. Filled in during a fetch without room, they would land between
+// the response and the TLS buffers, and split the free heap into holes once
+// those are freed (see heap_profiler.h). Policy IDs are not Strings: they
+// are kept as their 28 bytes (POLICY_ID_BYTES) inside NFTInfo.
+constexpr unsigned int NAME_CAPACITY = 32;
+constexpr unsigned int TICKER_CAPACITY = 12;
+
+// Where the data is saved in NVS (see loadSavedData())
+const char *SAVED_NAMESPACE = "ticker";
+const char *SAVED_BALANCE_KEY = "balance";
+const char *SAVED_PORTFOLIO_KEY = "portfolio"; // A ticker_snapshot.h snapshot
+
 // Global variables to store fetched data
 // These persist between function calls (unlike local variables)
 
@@ -54,26 +83,204 @@ float walletBalance = 0.0f; // Your ADA balance (in ADA, not Lovelace)
 int tokenCount = 0;         // How many different tokens you own
 int nftCount = 0;           // How many different NFT collections you own
 
-// Array to store Policy IDs (one per NFT collection)
-// We need these to fetch floor prices from Cexplorer API
-String policyIds[MAX_POLICY_IDS];
-int policyIdCount = 0; // How many Policy IDs we've collected
+// How many NFT collections need a floor price from Cexplorer: the first
+// policyIdCount entries of pendingNfts[] (below), by their Policy IDs
+int policyIdCount = 0;
+
+// Policy ID to its collection in pendingNfts[] (the index it was added
+// with), so grouping an NFT or placing a floor price is one lookup, not a
+// search through the collections
+PolicyTable<MAX_NFTS> policyTable;
 
 // Arrays to store token and NFT data
 // Arrays are like lists - we can store multiple items
 TokenInfo tokens[MAX_TOKENS]; // Array of token information
 NFTInfo nfts[MAX_NFTS];       // Array of NFT collection information
 
+// NFT collections from MinSwap that still wait for their floor prices
+// (Cexplorer). They replace nfts[] once all prices are in, so the NFT screen
+// never shows a collection without its price in between.
+NFTInfo pendingNfts[MAX_NFTS];
+int pendingNftCount = 0;
+
 // Timestamps to track when we last fetched data
 // Used to implement rate limiting (don't fetch too often)
 unsigned long lastKoiosFetch = 0;     // When we last fetched wallet balance
-unsigned long lastPortfolioFetch = 0; // When we last fetched tokens/NFTs
+unsigned long lastPortfolioFetch = 0; // When tokens/NFTs were last completed
+unsigned long portfolioStarted = 0;   // When the last portfolio update began
+
+// A portfolio update runs in steps: one request for the lists (MinSwap),
+// then one request per NFT collection for its floor price (Cexplorer)
+enum PortfolioStep {
+  PORTFOLIO_IDLE,  // No update running
+  PORTFOLIO_FLOORS // Lists are in, asking for floor prices
+};
+PortfolioStep portfolioStep = PORTFOLIO_IDLE;
+int nextFloor = 0; // Next pendingNfts[] collection to ask Cexplorer about
+
+// Fresh data since the restart, and whether data was loaded from NVS
+bool freshBalance = false;
+bool freshPortfolio = false;
+bool savedDataLoaded = false;
+
+// Set when WiFi comes back: the next update fetches without waiting for its
+// interval, since a fetch around the outage probably failed
+bool koiosDue = false;
+bool portfolioDue = false;
+
+// Buffer for one snapshot from chain-gateway (under 1 KB)
+// The screens' data is decoded straight from here, without a JSON document
+uint8_t snapshotBuffer[SNAPSHOT_MAX_SIZE];
+
+// Content hash of the snapshot we are showing (valid if haveSnapshot)
+// Sent back to the gateway, which answers "304 Not Modified" if it is unchanged
+uint32_t shownSnapshotHash = 0;
+bool haveSnapshot = false;
 
 // Forward declarations - these functions are defined later in this file
 // We declare them here so they can be called from other functions
-void fetchWalletBalance(); // Fetches ADA balance from Koios
-void fetchMinSwapData();   // Fetches tokens/NFTs from MinSwap
-void fetchCexplorerData(const String &policyId); // Fetches NFT floor prices
+bool fetchSnapshot();      // Fetches tokens/NFTs from chain-gateway
+void showSnapshot(const SnapshotReader &snapshot); // Copies it to the arrays
+bool fetchWalletBalance(); // Fetches ADA balance from Koios
+bool fetchMinSwapData();   // Fetches tokens/NFTs from MinSwap
+void fetchCexplorerData(const uint8_t *policyId); // Fetches NFT floor prices
+
+/**
+ * Called by the WiFi manager when the connection comes back or goes away
+ *
+ * When it comes back, fetch fresh data right away instead of showing
+ * old data until the next interval.
+ */
+void onWifiChange(bool connected) {
+  if (connected) {
+    koiosDue = true;
+    portfolioDue = true;
+  }
+}
+
+// Rate limiting: is it time to fetch the balance (every minute) or the
+// tokens and NFTs (every 10 minutes)? Never fetched, or WiFi just came
+// back after an outage, also counts as due.
+// The time since the last fetch is taken in 32 bits, like millis() counts
+// on the ESP32: after 49.7 days millis() starts again at 0, and the
+// subtraction still gives the right answer. (Host builds, where unsigned
+// long has 64 bits, need the cast to get the same.)
+bool koiosIsDue(unsigned long now) {
+  return koiosDue || lastKoiosFetch == 0 ||
+         (uint32_t)(now - lastKoiosFetch) >= KOIOS_INTERVAL_MS;
+}
+
+bool portfolioIsDue(unsigned long now) {
+  return portfolioDue || portfolioStarted == 0 ||
+         (uint32_t)(now - portfolioStarted) >= PORTFOLIO_INTERVAL_MS;
+}
+
+// Everything shown is fresh: that is the end of the boot
+void checkFresh() {
+  if (freshBalance && freshPortfolio) {
+    bootStageDone(BOOT_FRESH_DATA);
+  }
+}
+
+// Save the balance for the next restart. NVS does not write a value that
+// did not change, so this wears the flash only when the balance changes.
+void saveBalance() {
+  Preferences preferences;
+  preferences.begin(SAVED_NAMESPACE, false);
+  preferences.putFloat(SAVED_BALANCE_KEY, walletBalance);
+  preferences.end();
+}
+
+// Save the tokens and NFTs shown, as a snapshot (a few hundred bytes)
+void savePortfolio() {
+  uint8_t snapshot[SNAPSHOT_MAX_SIZE];
+  const size_t length = writePortfolioSnapshot(snapshot, sizeof(snapshot));
+  if (length == 0) {
+    return;
+  }
+  Preferences preferences;
+  preferences.begin(SAVED_NAMESPACE, false);
+  preferences.putBytes(SAVED_PORTFOLIO_KEY, snapshot, length);
+  preferences.end();
+}
+
+// Fetch the balance now and record it
+bool fetchBalanceNow(unsigned long now) {
+  // Record that we're fetching now
+  lastKoiosFetch = now;
+  koiosDue = false;
+
+  // Actually fetch the wallet balance from Koios API
+  if (!fetchWalletBalance()) {
+    return false;
+  }
+  freshBalance = true;
+  saveBalance();
+  bootStageDone(BOOT_BALANCE);
+  checkFresh();
+  return true;
+}
+
+// All of the portfolio is in: show it, remember it, save it
+// fromMinSwap: the NFT collections are in pendingNfts[], not yet in nfts[]
+void finishPortfolio(bool fromMinSwap) {
+  portfolioStep = PORTFOLIO_IDLE;
+  if (fromMinSwap) {
+    // The NFT collections from MinSwap, now with their floor prices
+    for (int i = 0; i < pendingNftCount; ++i) {
+      nfts[i] = pendingNfts[i];
+    }
+    nftCount = pendingNftCount;
+  }
+  lastPortfolioFetch = millis();
+  freshPortfolio = true;
+  savePortfolio();
+  checkFresh();
+}
+
+// First step of a portfolio update: the token and NFT lists
+// Returns the DATA_... bits of what is already on the screens
+uint8_t startPortfolio(unsigned long now) {
+  // Record that we're fetching now
+  portfolioStarted = now;
+  portfolioDue = false;
+
+  // With chain-gateway, one snapshot replaces all the requests below
+  // If the gateway does not answer, fall back to asking the APIs directly
+  if (snapshotUrl[0] != '\0' && fetchSnapshot()) {
+    bootStageDone(BOOT_TOKENS);
+    finishPortfolio(false); // Floor prices are in the snapshot
+    return DATA_TOKENS | DATA_NFTS;
+  }
+  haveSnapshot = false; // The arrays are about to come from the APIs
+
+  // Fetch tokens and NFTs from MinSwap
+  // This fills tokens[] and pendingNfts[], and collects Policy IDs
+  if (!fetchMinSwapData()) {
+    return 0; // Try again at the next interval
+  }
+  bootStageDone(BOOT_TOKENS);
+  nextFloor = 0;
+  portfolioStep = PORTFOLIO_FLOORS;
+  if (policyIdCount == 0) {
+    finishPortfolio(true); // No NFTs, no floor prices to ask for
+    return DATA_TOKENS | DATA_NFTS;
+  }
+  return DATA_TOKENS;
+}
+
+// Next step of a portfolio update: the floor price of one NFT collection
+// Returns DATA_NFTS when that was the last one
+uint8_t nextPortfolioStep() {
+  // The floor price ("lowest selling price") of the next collection
+  fetchCexplorerData(pendingNfts[nextFloor].policyId);
+  ++nextFloor;
+  if (nextFloor < policyIdCount) {
+    return 0;
+  }
+  finishPortfolio(true);
+  return DATA_NFTS;
+}
 
 } // namespace
 
@@ -91,13 +298,26 @@ void initDataFetcher() {
   tokenCount = 0;
   nftCount = 0;
   policyIdCount = 0;
+  pendingNftCount = 0;
   lastKoiosFetch = 0;
   lastPortfolioFetch = 0;
+  portfolioStarted = 0;
+  portfolioStep = PORTFOLIO_IDLE;
+  koiosDue = false;
+  portfolioDue = false;
+  haveSnapshot = false;
+  freshBalance = false;
+  freshPortfolio = false;
+  savedDataLoaded = false;
+
+  // Fetch again as soon as WiFi is back after an outage
+  wifiManagerSubscribe(onWifiChange);
 
   // Clear all token data arrays
   // Loop through each position in the array and set it to empty/default values
   for (size_t i = 0; i < MAX_TOKENS; ++i) {
     tokens[i].ticker = "";      // Empty string
+    tokens[i].ticker.reserve(TICKER_CAPACITY);
     tokens[i].amount = 0.0f;    // Zero amount
     tokens[i].value = 0.0f;     // Zero value
     tokens[i].change24h = 0.0f; // Zero change
@@ -108,8 +328,11 @@ void initDataFetcher() {
     nfts[i].name = "";         // Empty name
     nfts[i].amount = 0.0f;     // Zero amount
     nfts[i].floorPrice = 0.0f; // Zero floor price
-    nfts[i].policyId = "";     // Empty policy ID
+    memset(nfts[i].policyId, 0, POLICY_ID_BYTES); // No policy ID
+    nfts[i].name.reserve(NAME_CAPACITY);
+    pendingNfts[i].name.reserve(NAME_CAPACITY);
   }
+  policyTable.clear();
 }
 
 /**
@@ -117,7 +340,8 @@ void initDataFetcher() {
  *
  * This function implements rate limiting - it only fetches data if:
  * 1. WiFi is connected
- * 2. Enough time has passed since last fetch (1 minute)
+ * 2. Enough time has passed since last fetch (1 minute), or WiFi just came
+ *    back after an outage
  *
  * Rate limiting is important because:
  * - APIs have limits on how often you can request data
@@ -135,16 +359,13 @@ void updateKoiosData() {
 
   // Rate limiting check:
   // - If lastKoiosFetch is 0, we've never fetched (allow it)
+  // - If WiFi just came back, fetch now (allow it)
   // - Otherwise, only fetch if at least 1 minute has passed
-  if (lastKoiosFetch != 0 && (now - lastKoiosFetch) < KOIOS_INTERVAL_MS) {
+  if (!koiosIsDue(now)) {
     return; // Not enough time has passed, skip this update
   }
 
-  // Record that we're fetching now
-  lastKoiosFetch = now;
-
-  // Actually fetch the wallet balance from Koios API
-  fetchWalletBalance();
+  fetchBalanceNow(now);
 }
 
 /**
@@ -165,26 +386,94 @@ void updatePortfolioData() {
     return; // Can't fetch without internet
   }
 
-  // Rate limiting - only fetch every 10 minutes
-  const unsigned long now = millis();
-  if (lastPortfolioFetch != 0 &&
-      (now - lastPortfolioFetch) < PORTFOLIO_INTERVAL_MS) {
-    return; // Not enough time has passed
+  // Step 1: Fetch tokens and NFTs from MinSwap (or the snapshot)
+  // Rate limiting - only fetch every 10 minutes, unless updateDataStep()
+  // already started
+  if (portfolioStep == PORTFOLIO_IDLE) {
+    if (!portfolioIsDue(millis())) {
+      return; // Not enough time has passed
+    }
+    startPortfolio(millis());
   }
 
-  // Record fetch time
-  lastPortfolioFetch = now;
-
-  // Step 1: Fetch tokens and NFTs from MinSwap
-  // This populates the tokens[] and nfts[] arrays, and collects Policy IDs
-  fetchMinSwapData();
-
   // Step 2: Fetch floor prices for each NFT collection from Cexplorer
-  // We loop through all Policy IDs we collected and fetch floor price data
   // This gives us the "floor price" (lowest selling price) for each collection
-  for (int i = 0; i < policyIdCount; ++i) {
-    fetchCexplorerData(policyIds[i]);
+  while (portfolioStep == PORTFOLIO_FLOORS) {
+    nextPortfolioStep();
+  }
+}
+
+/**
+ * Do the next fetch that is due - at most one HTTP request
+ *
+ * The screens and the ticker keep running between requests, and show each
+ * piece of data as soon as it arrives. The most important data comes first:
+ * 1. Wallet balance (Koios), every minute - the first screen shows it
+ * 2. Token and NFT lists (MinSwap, or one snapshot from chain-gateway),
+ *    every 10 minutes
+ * 3. NFT floor prices (Cexplorer), one collection per call. The balance
+ *    still goes first if it becomes due in between.
+ */
+uint8_t updateDataStep() {
+  if (!wifiManagerIsConnected()) {
+    return 0; // Can't fetch without internet
+  }
+  const unsigned long now = millis();
+
+  if (koiosIsDue(now)) {
+    return fetchBalanceNow(now) ? DATA_BALANCE : 0;
+  }
+  if (portfolioStep == PORTFOLIO_FLOORS) {
+    return nextPortfolioStep();
+  }
+  if (portfolioIsDue(now)) {
+    return startPortfolio(now);
+  }
+  return 0; // Nothing due
+}
+
+/**
+ * Show the data saved before the last restart
+ *
+ * Every fetch saves what it got in NVS (the ESP32's flash storage for
+ * settings): the balance as a number, tokens and NFTs as a snapshot
+ * (ticker_snapshot.h, a few hundred bytes). Reading it back takes a few
+ * milliseconds, so the screens have data to show long before WiFi is up.
+ */
+bool loadSavedData() {
+  HEAP_SCOPE(HEAP_FETCHER, "load saved data");
+  Preferences preferences;
+  preferences.begin(SAVED_NAMESPACE, true); // Read-only
+  const bool haveBalance = preferences.isKey(SAVED_BALANCE_KEY);
+  const float balance = preferences.getFloat(SAVED_BALANCE_KEY, 0.0f);
+  uint8_t snapshot[SNAPSHOT_MAX_SIZE];
+  const size_t length =
+      preferences.getBytes(SAVED_PORTFOLIO_KEY, snapshot, sizeof(snapshot));
+  preferences.end();
+
+  bool loaded = false;
+  if (haveBalance && !freshBalance) {
+    walletBalance = balance;
+    loaded = true;
+  }
+  // The snapshot is checked (content hash) before anything is shown
+  SnapshotReader reader;
+  if (length > 0 && !freshPortfolio && reader.open(snapshot, length)) {
+    showSnapshot(reader);
+    loaded = true;
+  }
+  savedDataLoaded = savedDataLoaded || loaded;
+  if (loaded) {
+    LOG_I(LOG_MODULE, "Saved data: %.6f ADA, %d tokens, %d NFT collections",
+          walletBalance, tokenCount, nftCount);
   }
+  return loaded;
+}
+
+// True from loadSavedData() until both the balance and the portfolio were
+// fetched (or received)
+bool isShowingSavedData() {
+  return savedDataLoaded && (!freshBalance || !freshPortfolio);
 }
 
 /**
@@ -206,6 +495,74 @@ int getNftCount() { return nftCount; }
 // Return when wallet balance was last fetched (for "Last updated" display)
 unsigned long getLastKoiosFetchTime() { return lastKoiosFetch; }
 
+// Return when tokens and NFTs were last fetched
+unsigned long getLastPortfolioFetchTime() { return lastPortfolioFetch; }
+
+/**
+ * Show a wallet balance another ticker fetched (see fleet_sync.cpp)
+ *
+ * Counts as a fetch, so "Last updated" is right and, should this ticker
+ * take over fetching, it does not ask Koios again straight away.
+ */
+void showWalletBalance(float balance) {
+  walletBalance = balance;
+  lastKoiosFetch = millis();
+  koiosDue = false; // Fresh, no need to fetch it after a WiFi outage
+  freshBalance = true;
+  saveBalance();
+  bootStageDone(BOOT_BALANCE);
+  checkFresh();
+}
+
+/**
+ * Show tokens and NFTs another ticker fetched (see fleet_sync.cpp)
+ *
+ * @param data A snapshot in the ticker_snapshot.h format
+ * @param length Its size in bytes
+ * @return true if the snapshot was valid and is now shown
+ */
+bool showPortfolioSnapshot(const uint8_t *data, size_t length) {
+  SnapshotReader snapshot;
+  if (!snapshot.open(data, length)) {
+    return false;
+  }
+  showSnapshot(snapshot);
+  portfolioStarted = millis();
+  portfolioDue = false;
+  portfolioStep = PORTFOLIO_IDLE; // Anything we were fetching is older
+  haveSnapshot = false; // Not the gateway's snapshot, so no ETag for it
+  bootStageDone(BOOT_TOKENS);
+  finishPortfolio(false);
+  return true;
+}
+
+/**
+ * Write the tokens and NFTs we show as a snapshot, for other tickers
+ *
+ * Numbers are converted to the snapshot's fixed-point units, so the other
+ * tickers show the same values (to about 6 significant digits, the
+ * precision of a float).
+ *
+ * @param out Buffer for the snapshot (SNAPSHOT_MAX_SIZE bytes always fit)
+ * @param outSize Size of the buffer
+ * @return Size of the snapshot, or 0 if it did not fit
+ */
+size_t writePortfolioSnapshot(uint8_t *out, size_t outSize) {
+  SnapshotWriter writer;
+  for (int i = 0; i < tokenCount; ++i) {
+    writer.addToken(tokens[i].ticker.c_str(), llround(tokens[i].amount * 1e6),
+                    llround(tokens[i].value * 1e6),
+                    static_cast<int32_t>(lround(tokens[i].change24h * 100)));
+  }
+  for (int i = 0; i < nftCount; ++i) {
+    writer.addNft(nfts[i].name.c_str(),
+                  static_cast<uint32_t>(lround(nfts[i].amount)),
+                  static_cast<uint64_t>(llround(nfts[i].floorPrice * 1e6)));
+  }
+  // The ticker has no clock, so the snapshot carries no time (0)
+  return writer.finish(0, out, outSize);
+}
+
 /**
  * Get information about a specific token
  *
@@ -237,7 +594,7 @@ TokenInfo getToken(int index) {
  */
 NFTInfo getNFT(int index) {
   // Create an empty NFT structure as default
-  NFTInfo empty = {"", 0.0f, 0.0f, ""};
+  NFTInfo empty = {"", 0.0f, 0.0f, {}};
 
   // Validate index
   if (index < 0 || index >= nftCount) {
@@ -250,6 +607,124 @@ NFTInfo getNFT(int index) {
 
 namespace {
 
+/**
+ * Copy snapshot text into a String (snapshot text has no terminating zero)
+ */
+String snapshotString(const SnapshotText &text) {
+  char buffer[SNAPSHOT_MAX_STRING_LENGTH + 1];
+  memcpy(buffer, text.data, text.length);
+  buffer[text.length] = '\0';
+  return String(buffer);
+}
+
+/**
+ * Fetch tokens and NFTs as a binary snapshot from chain-gateway
+ *
+ * The gateway asks MinSwap and Cexplorer for us, keeps only what the screens
+ * show and sends it in the compact format described in ticker_snapshot.h.
+ * That is a few hundred bytes instead of many kilobytes of JSON, and decoding
+ * it is just reading numbers from a buffer.
+ *
+ * @return true if tokens[] and nfts[] are up to date, false if the gateway
+ *         could not be used (the caller then asks the APIs directly)
+ */
+bool fetchSnapshot() {
+  TRACE_SCOPE("fetch snapshot");
+  HEAP_SCOPE(HEAP_FETCHER, "fetch snapshot");
+  LOG_I(LOG_MODULE, "Fetching portfolio snapshot from chain-gateway");
+
+  HTTPClient http;
+  String fullUrl = String(snapshotUrl);
+  fullUrl += "?v=";
+  fullUrl += SNAPSHOT_VERSION; // Format version we understand
+  fullUrl += "&address=";
+  fullUrl += walletAddress;
+  http.begin(fullUrl);
+
+  // Tell the gateway which snapshot we already have (its content hash as an
+  // ETag). If nothing changed it answers 304 and sends no data at all.
+  if (haveSnapshot) {
+    char etag[12];
+    snprintf(etag, sizeof(etag), "\"%08lx\"", (unsigned long)shownSnapshotHash);
+    http.addHeader("If-None-Match", etag);
+  }
+
+  // Tell the WiFi manager how the request went, so it can judge the link
+  const unsigned long requestStart = wifiManagerRequestStarted();
+  TRACE_BEGIN("http request");
+  int httpResponseCode = http.GET();
+  TRACE_END("http request");
+  wifiManagerRequestFinished(requestStart, httpResponseCode > 0);
+  if (httpResponseCode == 304) {
+    LOG_I(LOG_MODULE, "Portfolio unchanged");
+    http.end();
+    return true;
+  }
+  if (httpResponseCode != 200) {
+    LOG_W(LOG_MODULE,
+          "Snapshot not available (response code %d), asking the APIs "
+          "directly",
+          httpResponseCode);
+    http.end();
+    return false;
+  }
+
+  // Read the whole snapshot into our fixed buffer
+  int size = http.getSize();
+  size_t received = 0;
+  if (size > 0 && size <= static_cast<int>(sizeof(snapshotBuffer))) {
+    TRACE_BEGIN("read body");
+    received = http.getStreamPtr()->readBytes(snapshotBuffer, size);
+    TRACE_END("read body");
+  }
+  http.end();
+  TRACE_COUNTER("response bytes", received);
+
+  // Check it completely before touching the arrays the screens read
+  SnapshotReader snapshot;
+  if (size <= 0 || received != static_cast<size_t>(size) ||
+      !snapshot.open(snapshotBuffer, received)) {
+    LOG_E(LOG_MODULE, "Invalid snapshot, asking the APIs directly");
+    return false;
+  }
+
+  showSnapshot(snapshot);
+  shownSnapshotHash = snapshot.contentHash();
+  haveSnapshot = true;
+
+  LOG_I(LOG_MODULE, "Snapshot: %d tokens, %d NFT collections in %u bytes",
+        tokenCount, nftCount, (unsigned)received);
+  return true;
+}
+
+/**
+ * Copy a checked snapshot into tokens[] and nfts[], the arrays the screens read
+ */
+void showSnapshot(const SnapshotReader &snapshot) {
+  // Numbers are fixed-point: millionths of a token or USD, hundredths of a
+  // percent and lovelace
+  tokenCount = snapshot.tokenCount();
+  for (int i = 0; i < tokenCount; ++i) {
+    SnapshotToken token;
+    snapshot.token(i, token);
+    tokens[i].ticker = snapshotString(token.ticker);
+    tokens[i].amount = token.amountMicro / 1000000.0f;
+    tokens[i].value = token.valueMicroUsd / 1000000.0f;
+    tokens[i].change24h = token.change24hCentiPercent / 100.0f;
+  }
+
+  nftCount = snapshot.nftCount();
+  policyIdCount = 0; // Floor prices are already in the snapshot
+  for (int i = 0; i < nftCount; ++i) {
+    SnapshotNft nft;
+    snapshot.nft(i, nft);
+    nfts[i].name = snapshotString(nft.name);
+    nfts[i].amount = nft.count;
+    nfts[i].floorPrice = nft.floorLovelace / 1000000.0f;
+    memset(nfts[i].policyId, 0, POLICY_ID_BYTES);
+  }
+}
+
 /**
  * Fetch wallet balance from Koios API
  *
@@ -269,9 +744,11 @@ namespace {
  * - 1 ADA = 1,000,000 Lovelace
  * - We convert Lovelace to ADA for display
  */
-void fetchWalletBalance() {
-  Serial.println();
-  Serial.println("--- Fetching Wallet Balance from Koios ---");
+bool fetchWalletBalance() {
+  TRACE_SCOPE("fetch balance");
+  HEAP_SCOPE(HEAP_FETCHER, "fetch balance");
+  bool fetched = false; // Set once we have the balance
+  LOG_I(LOG_MODULE, "Fetching wallet balance from Koios");
 
   // Create HTTP client object - this handles internet communication
   HTTPClient http;
@@ -289,28 +766,35 @@ void fetchWalletBalance() {
   jsonPayload += stakeAddress; // Your stake address from config.h
   jsonPayload += "\"]}";
 
-  Serial.println("Sending POST request to Koios...");
-  Serial.print("Payload: ");
-  Serial.println(jsonPayload);
+  LOG_V(LOG_MODULE, "Payload: %s", jsonPayload.c_str());
 
   // Send the HTTP POST request and get response code
   // POST means we're sending data (unlike GET which just requests data)
+  const unsigned long requestStart = wifiManagerRequestStarted();
+  TRACE_BEGIN("http request");
   int httpResponseCode = http.POST(jsonPayload);
+  TRACE_END("http request");
+  wifiManagerRequestFinished(requestStart, httpResponseCode > 0);
 
   // Check if request was successful (response code > 0 means success)
   if (httpResponseCode > 0) {
-    Serial.print("HTTP Response Code: ");
-    Serial.println(httpResponseCode);
+    LOG_D(LOG_MODULE, "HTTP response code: %d", httpResponseCode);
 
     // Get the response data (this is JSON text)
+    TRACE_BEGIN("read body");
     String response = http.getString();
+    TRACE_END("read body");
+    TRACE_COUNTER("response bytes", response.length());
 
     // Create a JSON document to parse the response
     // 2048 = maximum size of JSON we expect (in bytes)
     DynamicJsonDocument doc(2048);
 
     // Parse the JSON string into a structured document we can access
+    TRACE_BEGIN("parse json");
     DeserializationError error = deserializeJson(doc, response);
+    TRACE_END("parse json");
+    TRACE_COUNTER("free heap", ESP.getFreeHeap());
 
     // Check if parsing was successful
     if (!error) {
@@ -333,30 +817,27 @@ void fetchWalletBalance() {
         // Example: 5,000,000 Lovelace / 1,000,000 = 5.0 ADA
         walletBalance = balanceLovelace / 1000000.0;
 
-        // Print success message to Serial Monitor
-        Serial.println();
-        Serial.println("✓ Wallet Balance Fetched Successfully!");
-        Serial.print("Stake Address: ");
-        Serial.println(accountInfo["stake_address"].as<const char *>());
-        Serial.print("Total Balance: ");
-        Serial.print(walletBalance, 6); // Print with 6 decimal places
-        Serial.println(" ADA");
+        // Log the result (6 decimal places: down to the Lovelace)
+        LOG_D(LOG_MODULE, "Stake address: %s",
+              accountInfo["stake_address"] | "?");
+        LOG_I(LOG_MODULE, "Wallet balance: %.6f ADA", walletBalance);
+        fetched = true;
       } else {
-        Serial.println("Error: Empty response from Koios API");
+        LOG_E(LOG_MODULE, "Empty response from Koios API");
       }
     } else {
       // JSON parsing failed - maybe API returned invalid JSON
-      Serial.print("JSON parsing failed: ");
-      Serial.println(error.c_str());
+      LOG_E(LOG_MODULE, "Koios: JSON parsing failed: %s", error.c_str());
     }
   } else {
     // HTTP request failed (network error, timeout, etc.)
-    Serial.print("Error in HTTP request. Response Code: ");
-    Serial.println(httpResponseCode);
+    LOG_E(LOG_MODULE, "Koios: HTTP request failed (response code %d)",
+          httpResponseCode);
   }
 
   // Always close the HTTP connection when done
   http.end();
+  return fetched;
 }
 
 /**
@@ -372,12 +853,25 @@ void fetchWalletBalance() {
  * 2. Send GET request (simpler than POST - just requesting data)
  * 3. Parse JSON response
  * 4. Extract tokens and store in tokens[] array
- * 5. Extract NFTs, group by Policy ID, and store in nfts[] array
+ * 5. Extract NFTs, group by Policy ID, and store in pendingNfts[] array
+ *    (they move to nfts[] once Cexplorer gave us their floor prices)
  * 6. Collect Policy IDs for later floor price fetching
+ *
+ * @return true if MinSwap answered with your positions
  */
-void fetchMinSwapData() {
-  Serial.println();
-  Serial.println("--- Fetching Tokens and NFTs from MinSwap ---");
+bool fetchMinSwapData() {
+  TRACE_SCOPE("fetch minswap");
+  HEAP_SCOPE(HEAP_FETCHER, "fetch minswap");
+  bool fetched = false; // Set once we have the positions
+  LOG_I(LOG_MODULE, "Fetching tokens and NFTs from MinSwap");
+
+  // Start from the collections we show, in case MinSwap sends no NFT list
+  policyTable.clear();
+  for (int i = 0; i < nftCount; ++i) {
+    pendingNfts[i] = nfts[i];
+    policyTable.add(nfts[i].policyId); // Index i, as they are added in order
+  }
+  pendingNftCount = nftCount;
 
   // Create HTTP client
   HTTPClient http;
@@ -392,195 +886,42 @@ void fetchMinSwapData() {
   fullUrl += "&only_minswap=true";        // Only show tokens from MinSwap
   fullUrl += "&filter_small_value=false"; // Don't filter out small value tokens
 
-  Serial.print("Requesting: ");
-  Serial.println(fullUrl);
+  LOG_D(LOG_MODULE, "Requesting %s", fullUrl.c_str());
 
   // Set the URL and send GET request
   // GET is simpler than POST - we're just requesting data, not sending data
   http.begin(fullUrl);
-  Serial.println("Sending GET request to MinSwap...");
+  const unsigned long requestStart = wifiManagerRequestStarted();
+  TRACE_BEGIN("http request");
   int httpResponseCode = http.GET();
+  TRACE_END("http request");
+  wifiManagerRequestFinished(requestStart, httpResponseCode > 0);
 
   if (httpResponseCode > 0) {
-    Serial.print("HTTP Response Code: ");
-    Serial.println(httpResponseCode);
+    LOG_D(LOG_MODULE, "HTTP response code: %d", httpResponseCode);
 
+    TRACE_BEGIN("read body");
     String response = http.getString();
+    TRACE_END("read body");
+    TRACE_COUNTER("response bytes", response.length());
     DynamicJsonDocument doc(8192);
+    TRACE_BEGIN("parse json");
     DeserializationError error = deserializeJson(doc, response);
+    TRACE_END("parse json");
+    TRACE_COUNTER("free heap", ESP.getFreeHeap());
 
     if (!error) {
-      Serial.println();
-      Serial.println("✓ MinSwap Data Fetched Successfully!");
-
-      // Check if response contains "positions" data
-      if (doc.containsKey("positions")) {
-        JsonObject positions = doc["positions"];
-
-        // Process NFT positions first
-        if (positions.containsKey("nft_positions")) {
-          JsonArray nftArray = positions["nft_positions"];
-
-          // Reset NFT storage before processing new data
-          nftCount = 0;
-          policyIdCount = 0;
-
-          // Process each NFT position in the array
-          // MinSwap returns each NFT as a separate entry, but we want to group
-          // them by collection (Policy ID). So if you own 3 NFTs from the same
-          // collection, we'll count them as one collection with amount = 3.
-          for (int i = 0;
-               i < nftArray.size() && nftCount < static_cast<int>(MAX_NFTS);
-               ++i) {
-            JsonObject nft = nftArray[i];
-
-            // Get the Policy ID (also called "currency_symbol" in MinSwap API)
-            // Policy ID is like a collection identifier - all NFTs from the
-            // same collection have the same Policy ID
-            const char *currencySymbol = nft["currency_symbol"];
-
-            // Skip if no Policy ID (shouldn't happen, but safety check)
-            if (currencySymbol == nullptr) {
-              continue; // Skip to next NFT
-            }
-
-            String policyId = String(currencySymbol);
-
-            // Extract NFT collection name from metadata
-            // MinSwap provides metadata with the collection name
-            String nftName = "Unknown NFT";
-            if (nft.containsKey("asset")) {
-              JsonObject assetInfo = nft["asset"];
-              if (assetInfo.containsKey("metadata")) {
-                JsonObject metadata = assetInfo["metadata"];
-                // The "|" operator means "use this value, or if missing, use
-                // default"
-                nftName = metadata["name"] | "Unknown NFT";
-              }
-            }
-
-            // Check if we already have this Policy ID in our array
-            // We want to group NFTs by collection, so we check if we've seen
-            // this Policy ID before
-            int existingIndex = -1;
-            for (int j = 0; j < nftCount; ++j) {
-              if (nfts[j].policyId == policyId) {
-                existingIndex = j; // Found it! Remember which position
-                break;
-              }
-            }
-
-            if (existingIndex >= 0) {
-              // We already have this collection - just increment the count
-              // Example: If you own 2 Cardano Punks, then find a 3rd one,
-              // we increment amount from 2 to 3
-              nfts[existingIndex].amount += 1.0f;
-            } else {
-              // New collection we haven't seen before - add it to our array
-              nfts[nftCount].name = nftName;
-              nfts[nftCount].amount = 1.0f; // First NFT from this collection
-              nfts[nftCount].floorPrice =
-                  0.0f; // Will be updated by Cexplorer later
-              nfts[nftCount].policyId = policyId;
-
-              // Save Policy ID so we can fetch floor price from Cexplorer
-              if (policyIdCount < static_cast<int>(MAX_POLICY_IDS)) {
-                policyIds[policyIdCount] = policyId;
-                ++policyIdCount;
-              }
-
-              Serial.print("  NFT Collection ");
-              Serial.print(nftCount + 1);
-              Serial.print(": ");
-              Serial.print(nftName);
-              Serial.print(" (Policy ID: ");
-              Serial.print(currencySymbol);
-              Serial.println(")");
-
-              ++nftCount; // Move to next position in array
-            }
-          }
-
-          Serial.print("NFT Collections found: ");
-          Serial.println(nftCount);
-          Serial.print("Extracted ");
-          Serial.print(policyIdCount);
-          Serial.println(" policy ID(s) for Cexplorer API calls");
-        }
-
-        // Process token positions (regular tokens, not NFTs)
-        if (positions.containsKey("asset_positions")) {
-          JsonArray assetArray = positions["asset_positions"];
-
-          // Count how many tokens we found
-          tokenCount = assetArray.size();
-
-          // Limit to maximum we can display (8 tokens)
-          if (tokenCount > static_cast<int>(MAX_TOKENS)) {
-            tokenCount = MAX_TOKENS;
-          }
-          Serial.print("Tokens found: ");
-          Serial.println(tokenCount);
-
-          // Process each token
-          for (int i = 0;
-               i < assetArray.size() && i < static_cast<int>(MAX_TOKENS); ++i) {
-            JsonObject asset = assetArray[i];
-
-            // Check if token has required data
-            if (asset.containsKey("asset")) {
-              JsonObject assetInfo = asset["asset"];
-              if (assetInfo.containsKey("metadata")) {
-                JsonObject metadata = assetInfo["metadata"];
-
-                // Extract token information from JSON
-                // The "|" operator provides default values if data is missing
-                String ticker = metadata["ticker"] |
-                                "UNKNOWN"; // Token symbol (e.g., "MIN")
-                String name = metadata["name"] | "Unknown Token"; // Full name
-                float priceUsd =
-                    asset["price_usd"] | 0.0f;         // Price per token in USD
-                float amount = asset["amount"] | 0.0f; // How many you own
-                float change24h =
-                    asset["pnl_24h_percent"] | 0.0f; // 24h price change %
-
-                // Store token data in our array
-                tokens[i].ticker = ticker;
-                tokens[i].amount = amount;
-                tokens[i].value =
-                    priceUsd * amount; // Total value = price × amount
-                tokens[i].change24h = change24h;
-
-                Serial.print("  Token ");
-                Serial.print(i + 1);
-                Serial.print(": ");
-                Serial.print(ticker);
-                Serial.print(" (");
-                Serial.print(name);
-                Serial.print(") - Price: $");
-                Serial.print(priceUsd, 4);
-                Serial.print(", Amount: ");
-                Serial.print(amount, 2);
-                Serial.print(", 24h Change: ");
-                Serial.print(change24h, 2);
-                Serial.println("%");
-              }
-            }
-          }
-        }
-      } else {
-        Serial.println("Warning: No positions found in MinSwap response");
-      }
+      fetched = readMinSwapPositions(doc) >= 0;
     } else {
-      Serial.print("JSON parsing failed: ");
-      Serial.println(error.c_str());
+      LOG_E(LOG_MODULE, "MinSwap: JSON parsing failed: %s", error.c_str());
     }
   } else {
-    Serial.print("Error in HTTP request. Response Code: ");
-    Serial.println(httpResponseCode);
+    LOG_E(LOG_MODULE, "MinSwap: HTTP request failed (response code %d)",
+          httpResponseCode);
   }
 
   http.end();
+  return fetched;
 }
 
 /**
@@ -604,11 +945,13 @@ void fetchMinSwapData() {
  * 4. Extract collection name and floor price
  * 5. Update the corresponding NFT entry in our nfts[] array
  */
-void fetchCexplorerData(const String &policyId) {
-  Serial.println();
-  Serial.println("--- Fetching NFT Info from Cexplorer ---");
-  Serial.print("Policy ID: ");
-  Serial.println(policyId);
+void fetchCexplorerData(const uint8_t *policyId) {
+  TRACE_SCOPE("fetch cexplorer");
+  HEAP_SCOPE(HEAP_FETCHER, "fetch cexplorer");
+  char policyHex[2 * POLICY_ID_BYTES + 1]; // As the API wants it
+  formatPolicyId(policyId, policyHex);
+  LOG_I(LOG_MODULE, "Fetching NFT info from Cexplorer");
+  LOG_D(LOG_MODULE, "Policy ID: %s", policyHex);
 
   // Create HTTP client
   HTTPClient http;
@@ -617,10 +960,9 @@ void fetchCexplorerData(const String &policyId) {
   // Example: https://api.cexplorer.io/v1/policy/detail?id=f0ff48bbb7...
   String fullUrl = String(cexplorerApiUrl);
   fullUrl += "?id=";
-  fullUrl += policyId;
+  fullUrl += policyHex;
 
-  Serial.print("Requesting: ");
-  Serial.println(fullUrl);
+  LOG_D(LOG_MODULE, "Requesting %s", fullUrl.c_str());
 
   // Set URL and prepare request
   http.begin(fullUrl);
@@ -629,21 +971,26 @@ void fetchCexplorerData(const String &policyId) {
   // Some APIs require authentication, but Cexplorer works without it
   // http.addHeader("api-key", cexplorerApiKey);
 
-  Serial.println("Sending GET request to Cexplorer...");
+  const unsigned long requestStart = wifiManagerRequestStarted();
+  TRACE_BEGIN("http request");
   int httpResponseCode = http.GET();
+  TRACE_END("http request");
+  wifiManagerRequestFinished(requestStart, httpResponseCode > 0);
 
   if (httpResponseCode > 0) {
-    Serial.print("HTTP Response Code: ");
-    Serial.println(httpResponseCode);
+    LOG_D(LOG_MODULE, "HTTP response code: %d", httpResponseCode);
 
+    TRACE_BEGIN("read body");
     String response = http.getString();
+    TRACE_END("read body");
+    TRACE_COUNTER("response bytes", response.length());
     DynamicJsonDocument doc(4096);
+    TRACE_BEGIN("parse json");
     DeserializationError error = deserializeJson(doc, response);
+    TRACE_END("parse json");
+    TRACE_COUNTER("free heap", ESP.getFreeHeap());
 
     if (!error) {
-      Serial.println();
-      Serial.println("✓ Cexplorer Data Fetched Successfully!");
-
       // Check if response contains "data" object
       if (doc.containsKey("data")) {
         JsonObject data = doc["data"];
@@ -656,9 +1003,6 @@ void fetchCexplorerData(const String &policyId) {
           // Cexplorer usually has better/more accurate names than MinSwap
           String collectionName = collection["name"] | "Unknown";
 
-          Serial.print("Collection Name: ");
-          Serial.println(collectionName);
-
           // Extract floor price (lowest current selling price)
           float floorPriceAda = 0.0f;
           if (collection.containsKey("stats")) {
@@ -673,43 +1017,36 @@ void fetchCexplorerData(const String &policyId) {
             // Also get number of owners (for debugging/logging)
             int owners = stats["owners"] | 0;
 
-            Serial.print("Floor Price: ");
-            Serial.print(floorPriceAda, 2); // Print with 2 decimal places
-            Serial.println(" ADA");
-            Serial.print("Owners: ");
-            Serial.println(owners);
+            LOG_I(LOG_MODULE, "%s: floor %.2f ADA, %d owners",
+                  collectionName.c_str(), floorPriceAda, owners);
           }
 
           // Now update our NFT array with the collection name and floor price
-          // We need to find which NFT entry has this Policy ID
-          for (int i = 0; i < nftCount && i < static_cast<int>(MAX_NFTS); ++i) {
-            if (nfts[i].policyId == policyId) {
-              // Found the matching NFT collection!
-              // Update with better name from Cexplorer (more accurate than
-              // MinSwap)
-              nfts[i].name = collectionName;
-
-              // Update floor price if we got one
-              if (floorPriceAda > 0.0f) {
-                nfts[i].floorPrice = floorPriceAda;
-              }
-
-              break; // Found it, no need to keep searching
+          // The hash table tells which NFT entry has this Policy ID
+          const int i = policyTable.find(policyId);
+          if (i >= 0) {
+            // Found the matching NFT collection!
+            // Update with better name from Cexplorer (more accurate than
+            // MinSwap)
+            pendingNfts[i].name = collectionName;
+
+            // Update floor price if we got one
+            if (floorPriceAda > 0.0f) {
+              pendingNfts[i].floorPrice = floorPriceAda;
             }
           }
         }
       } else {
-        Serial.println("Warning: No data found in Cexplorer response");
+        LOG_W(LOG_MODULE, "No data found in Cexplorer response");
       }
     } else {
-      Serial.print("JSON parsing failed: ");
-      Serial.println(error.c_str());
+      LOG_E(LOG_MODULE, "Cexplorer: JSON parsing failed: %s", error.c_str());
     }
   } else {
-    Serial.print("Error in HTTP request. Response Code: ");
-    Serial.println(httpResponseCode);
+    LOG_E(LOG_MODULE, "Cexplorer: HTTP request failed (response code %d)",
+          httpResponseCode);
     if (httpResponseCode == 401) {
-      Serial.println("Error: 401 Unauthorized - Check your Cexplorer API key!");
+      LOG_E(LOG_MODULE, "401 Unauthorized - Check your Cexplorer API key!");
     }
   }
 
@@ -717,3 +1054,151 @@ void fetchCexplorerData(const String &policyId) {
 }
 
 } // namespace
+
+/**
+ * Read the tokens and NFTs out of MinSwap's answer
+ *
+ * NFTs go to pendingNfts[], one entry per collection, until Cexplorer has
+ * their floor prices; tokens go straight to tokens[]. Kept apart from the
+ * HTTP request in fetchMinSwapData(), so the host benchmarks time this very
+ * code on wallets of any size.
+ */
+int readMinSwapPositions(JsonDocument &doc) {
+  // Check if response contains "positions" data
+  if (!doc.containsKey("positions")) {
+    LOG_W(LOG_MODULE, "No positions found in MinSwap response");
+    return -1;
+  }
+  JsonObject positions = doc["positions"];
+
+  // Process NFT positions first
+  if (positions.containsKey("nft_positions")) {
+    JsonArray nftArray = positions["nft_positions"];
+
+    // Reset NFT storage before processing new data
+    pendingNftCount = 0;
+    policyIdCount = 0;
+    policyTable.clear();
+
+    // Process each NFT position in the array
+    // MinSwap returns each NFT as a separate entry, but we want to group
+    // them by collection (Policy ID). So if you own 3 NFTs from the same
+    // collection, we'll count them as one collection with amount = 3.
+    // The loop walks the array with an iterator: nftArray[i] would
+    // search from the start of the array for every NFT.
+    for (JsonObject nft : nftArray) {
+      // Get the Policy ID (also called "currency_symbol" in MinSwap API)
+      // Policy ID is like a collection identifier - all NFTs from the
+      // same collection have the same Policy ID
+      const char *currencySymbol = nft["currency_symbol"];
+
+      // Decode it from hex into its 28 bytes, so comparing two is one
+      // memcmp() of 28 bytes instead of two Strings of 56 characters
+      // Skip if no Policy ID (shouldn't happen, but safety check)
+      uint8_t policyId[POLICY_ID_BYTES];
+      if (currencySymbol == nullptr ||
+          !parsePolicyId(currencySymbol, policyId)) {
+        continue; // Skip to next NFT
+      }
+
+      // Check if we already have this Policy ID
+      // We want to group NFTs by collection, so we look it up in the
+      // hash table of the collections seen so far
+      const int existingIndex = policyTable.find(policyId);
+
+      if (existingIndex >= 0) {
+        // We already have this collection - just increment the count
+        // Example: If you own 2 Cardano Punks, then find a 3rd one,
+        // we increment amount from 2 to 3
+        pendingNfts[existingIndex].amount += 1.0f;
+        continue;
+      }
+      if (pendingNftCount >= static_cast<int>(MAX_NFTS)) {
+        // As many collections as we can show. Keep going all the same: a
+        // later NFT may belong to one of them, the array is in no order.
+        continue;
+      }
+
+      // New collection we haven't seen before - add it to our array
+      NFTInfo &collection = pendingNfts[pendingNftCount];
+
+      // Extract NFT collection name from metadata
+      // MinSwap provides metadata with the collection name
+      collection.name = "Unknown NFT";
+      if (nft.containsKey("asset")) {
+        JsonObject assetInfo = nft["asset"];
+        if (assetInfo.containsKey("metadata")) {
+          JsonObject metadata = assetInfo["metadata"];
+          // The "|" operator means "use this value, or if missing, use
+          // default"
+          collection.name = metadata["name"] | "Unknown NFT";
+        }
+      }
+      collection.amount = 1.0f; // First NFT from this collection
+      collection.floorPrice = 0.0f; // Updated by Cexplorer later
+      memcpy(collection.policyId, policyId, POLICY_ID_BYTES);
+      policyTable.add(policyId); // Index pendingNftCount
+
+      // Count it for the floor prices from Cexplorer
+      if (policyIdCount < static_cast<int>(MAX_POLICY_IDS)) {
+        ++policyIdCount;
+      }
+
+      LOG_V(LOG_MODULE, "  NFT collection %d: %s (policy ID %s)",
+            pendingNftCount + 1, collection.name.c_str(), currencySymbol);
+
+      ++pendingNftCount; // Move to next position in array
+    }
+
+    LOG_I(LOG_MODULE,
+          "MinSwap: %d NFT collections, %d policy IDs for Cexplorer",
+          pendingNftCount, policyIdCount);
+  }
+
+  // Process token positions (regular tokens, not NFTs)
+  if (positions.containsKey("asset_positions")) {
+    JsonArray assetArray = positions["asset_positions"];
+
+    // Count how many tokens we found
+    tokenCount = assetArray.size();
+
+    // Limit to maximum we can display (8 tokens)
+    if (tokenCount > static_cast<int>(MAX_TOKENS)) {
+      tokenCount = MAX_TOKENS;
+    }
+    LOG_I(LOG_MODULE, "MinSwap: %d tokens", tokenCount);
+
+    // Process each token
+    for (int i = 0; i < tokenCount; ++i) {
+      JsonObject asset = assetArray[i];
+
+      // Check if token has required data
+      if (asset.containsKey("asset")) {
+        JsonObject assetInfo = asset["asset"];
+        if (assetInfo.containsKey("metadata")) {
+          JsonObject metadata = assetInfo["metadata"];
+
+          // Extract token information from JSON
+          // The "|" operator provides default values if data is missing
+          String ticker = metadata["ticker"] | "UNKNOWN"; // e.g. "MIN"
+          String name = metadata["name"] | "Unknown Token"; // Full name
+          float priceUsd = asset["price_usd"] | 0.0f; // Price per token in USD
+          float amount = asset["amount"] | 0.0f; // How many you own
+          float change24h = asset["pnl_24h_percent"] | 0.0f; // 24h change %
+
+          // Store token data in our array
+          tokens[i].ticker = ticker;
+          tokens[i].amount = amount;
+          tokens[i].value = priceUsd * amount; // Total value = price × amount
+          tokens[i].change24h = change24h;
+
+          LOG_V(LOG_MODULE,
+                "  Token %d: %s (%s) - price $%.4f, amount %.2f, 24h %.2f%%",
+                i + 1, ticker.c_str(), name.c_str(), priceUsd, amount,
+                change24h);
+        }
+      }
+    }
+  }
+  return pendingNftCount;
+}
@@ -14,6 +14,9 @@
 #define DATA_FETCHER_H
 
 #include <Arduino.h>
+#include <ArduinoJson.h>
+
+#include "policy_table.h" // POLICY_ID_BYTES
 
 /**
  * TokenInfo - Structure to store information about a Cardano token
@@ -44,10 +47,17 @@ struct NFTInfo {
   String name;        // Name of the NFT collection (e.g., "Cardano Punks")
   float amount;       // Number of NFTs you own from this collection
   float floorPrice;   // Floor price = lowest price this collection is selling for (in ADA)
-  String policyId;    // Policy ID = unique identifier for this NFT collection
+  uint8_t policyId[POLICY_ID_BYTES]; // Policy ID = unique identifier for this
+                      // NFT collection, as bytes (all zero if unknown)
                       // Used to match NFTs with their floor price data
 };
 
+// What updateDataStep() brought in - bits, so the sketch can redraw only
+// the screens that show it
+#define DATA_BALANCE 0x01 // Wallet balance (wallet screen)
+#define DATA_TOKENS 0x02  // Tokens (token screen and the ticker)
+#define DATA_NFTS 0x04    // NFT collections with floor prices (NFT screen)
+
 // Function declarations - these are implemented in data_fetcher.cpp
 
 /**
@@ -71,6 +81,40 @@ void updateKoiosData();
  */
 void updatePortfolioData();
 
+/**
+ * Do the next fetch that is due - at most one HTTP request
+ * Use this in loop() instead of the two functions above, so the screens and
+ * the ticker keep running between requests. Most important first: the
+ * balance, then the token and NFT lists, then one NFT floor price per call.
+ * @return DATA_... bits for what changed on the screens, 0 if nothing
+ */
+uint8_t updateDataStep();
+
+/**
+ * Read MinSwap's answer once it is parsed: the tokens, and the NFTs grouped
+ * by Policy ID into the collections that wait for their floor prices.
+ * updateDataStep() calls it for every MinSwap answer; host benchmarks call
+ * it with documents larger than the ticker's 8 KB.
+ * @param doc MinSwap's portfolio/tokens answer
+ * @return NFT collections found (max 8), or -1 if there are no positions
+ */
+int readMinSwapPositions(JsonDocument &doc);
+
+/**
+ * Show the data saved in flash (NVS) before the last restart
+ * Call once in setup(), after initDataFetcher(). Every fetch saves what it
+ * got, so after a restart the screens can show it at once, before WiFi is up.
+ * @return true if saved data was found
+ */
+bool loadSavedData();
+
+/**
+ * Is some of the data shown still the saved data from before the restart?
+ * @return true if loadSavedData() found data, until the balance and the
+ *         portfolio were fetched once
+ */
+bool isShowingSavedData();
+
 // Getter functions - these return the stored data
 
 /**
@@ -98,6 +142,13 @@ int getNftCount();
  */
 unsigned long getLastKoiosFetchTime();
 
+/**
+ * Get timestamp of when tokens and NFTs were last fetched (or received)
+ * completely, NFT floor prices included
+ * @return Timestamp in milliseconds, or 0 if never fetched
+ */
+unsigned long getLastPortfolioFetchTime();
+
 /**
  * Get information about a specific token
  * @param index Which token to get (0 = first token, 1 = second, etc.)
@@ -112,4 +163,29 @@ TokenInfo getToken(int index);
  */
 NFTInfo getNFT(int index);
 
+// Sharing data between tickers - used by fleet_sync.cpp, where one ticker
+// fetches and the others show what it fetched
+
+/**
+ * Show a wallet balance fetched by another ticker
+ * @param balance Balance in ADA
+ */
+void showWalletBalance(float balance);
+
+/**
+ * Show tokens and NFTs fetched by another ticker
+ * @param data Snapshot in the ticker_snapshot.h format
+ * @param length Size of the snapshot in bytes
+ * @return true if the snapshot was valid (otherwise nothing changes)
+ */
+bool showPortfolioSnapshot(const uint8_t *data, size_t length);
+
+/**
+ * Write the tokens and NFTs currently shown as a snapshot
+ * @param out Buffer (SNAPSHOT_MAX_SIZE bytes always fit)
+ * @param outSize Size of the buffer
+ * @return Size of the snapshot in bytes, or 0 if it did not fit
+ */
+size_t writePortfolioSnapshot(uint8_t *out, size_t outSize);
+
 #endif
@@ -0,0 +1,237 @@
+/**
+ * fleet_node.cpp - Leader election and snapshot sharing between tickers
+ *
+ * See fleet_node.h for the topics and how the leader is chosen.
+ */
+
+#include "fleet_node.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+// Copy text into a fixed buffer, cutting it if needed
+void copyText(char *out, size_t outSize, const char *text) {
+  snprintf(out, outSize, "%s", text);
+}
+} // namespace
+
+void FleetNode::begin(const char *prefix, const char *id, FleetLink *link) {
+  link_ = link;
+  copyText(id_, sizeof(id_), id);
+  copyText(prefix_, sizeof(prefix_), prefix);
+  snprintf(nodeTopic_, sizeof(nodeTopic_), "%s/node/%s", prefix_, id_);
+  snprintf(subscription_, sizeof(subscription_), "%s/#", prefix_);
+  snprintf(portfolioTopic_, sizeof(portfolioTopic_), "%s/portfolio", prefix_);
+  snprintf(deltaTopic_, sizeof(deltaTopic_), "%s/portfolio/delta", prefix_);
+  snprintf(balanceTopic_, sizeof(balanceTopic_), "%s/balance", prefix_);
+}
+
+void FleetNode::connected(unsigned long now) {
+  connected_ = true;
+  connectedAt_ = now;
+  nodeCount_ = 0;
+  // The broker may have lost its retained messages (a restart without
+  // persistence). Ours arrive again if it has them; until then, new data is
+  // published as a full snapshot, not as a delta against one it lacks.
+  keyframeLength_ = 0;
+  deltaLength_ = 0;
+  balance_[0] = '\0';
+  link_->publish(nodeTopic_, (const uint8_t *)"1", 1, true);
+}
+
+bool FleetNode::isLeader(unsigned long now) const {
+  if (!connected_ || (uint32_t)(now - connectedAt_) < FLEET_SETTLE_MS) {
+    return false; // Retained node topics may still be on their way
+  }
+  for (int i = 0; i < nodeCount_; i++) {
+    if (strcmp(nodes_[i], id_) < 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void FleetNode::receive(const char *topic, const uint8_t *payload,
+                        size_t length) {
+  size_t prefixLength = strlen(prefix_);
+  if (strncmp(topic, prefix_, prefixLength) != 0 ||
+      topic[prefixLength] != '/') {
+    return;
+  }
+  const char *name = topic + prefixLength + 1;
+
+  if (strncmp(name, "node/", 5) == 0) {
+    receiveNode(name + 5, length > 0);
+  } else if (strcmp(name, "portfolio") == 0) {
+    receiveKeyframe(payload, length);
+  } else if (strcmp(name, "portfolio/delta") == 0) {
+    receiveDelta(payload, length);
+  } else if (strcmp(name, "balance") == 0 && length > 0 &&
+             length < sizeof(balance_)) {
+    if (strlen(balance_) != length || memcmp(balance_, payload, length) != 0) {
+      memcpy(balance_, payload, length);
+      balance_[length] = '\0';
+      balanceVersion_++;
+    }
+  }
+}
+
+void FleetNode::receiveNode(const char *id, bool online) {
+  if (strcmp(id, id_) == 0) {
+    return; // Our own announcement
+  }
+  for (int i = 0; i < nodeCount_; i++) {
+    if (strcmp(nodes_[i], id) == 0) {
+      if (!online) {
+        // Gone: move the last entry into its place
+        nodeCount_--;
+        memcpy(nodes_[i], nodes_[nodeCount_], FLEET_ID_LENGTH);
+      }
+      return;
+    }
+  }
+  if (!online) {
+    return;
+  }
+  if (nodeCount_ < FLEET_MAX_NODES) {
+    copyText(nodes_[nodeCount_++], FLEET_ID_LENGTH, id);
+    return;
+  }
+  // Full: only the lowest ids matter for choosing the leader, so keep those
+  int highest = 0;
+  for (int i = 1; i < nodeCount_; i++) {
+    if (strcmp(nodes_[i], nodes_[highest]) > 0) {
+      highest = i;
+    }
+  }
+  if (strcmp(id, nodes_[highest]) < 0) {
+    copyText(nodes_[highest], FLEET_ID_LENGTH, id);
+  }
+}
+
+void FleetNode::receiveKeyframe(const uint8_t *payload, size_t length) {
+  SnapshotReader reader;
+  if (length > sizeof(keyframe_) || !reader.open(payload, length)) {
+    stats_.rejected++;
+    return;
+  }
+  memcpy(keyframe_, payload, length);
+  keyframeLength_ = length;
+  // The broker may have sent the retained delta first
+  if (!applyDelta()) {
+    setCurrent(payload, length, reader.contentHash());
+  }
+}
+
+void FleetNode::receiveDelta(const uint8_t *payload, size_t length) {
+  if (length > sizeof(delta_)) {
+    stats_.rejected++;
+    return;
+  }
+  memcpy(delta_, payload, length);
+  deltaLength_ = length; // 0: cleared after a new full snapshot
+  if (length > 0 && !applyDelta()) {
+    // Usually a delta for a full snapshot we have not received yet
+    stats_.rejected++;
+  }
+}
+
+bool FleetNode::applyDelta() {
+  if (keyframeLength_ == 0 || deltaLength_ == 0) {
+    return false;
+  }
+  uint8_t snapshot[SNAPSHOT_MAX_SIZE];
+  size_t length = applySnapshotDelta(keyframe_, keyframeLength_, delta_,
+                                     deltaLength_, snapshot, sizeof(snapshot));
+  SnapshotReader reader;
+  if (length == 0 || !reader.open(snapshot, length)) {
+    return false;
+  }
+  setCurrent(snapshot, length, reader.contentHash());
+  return true;
+}
+
+void FleetNode::setCurrent(const uint8_t *snapshot, size_t length,
+                           uint32_t hash) {
+  if (currentLength_ > 0 && hash == currentHash_) {
+    return; // Same content (our own message coming back, or a new base)
+  }
+  memcpy(current_, snapshot, length);
+  currentLength_ = length;
+  currentHash_ = hash;
+  portfolioVersion_++;
+}
+
+bool FleetNode::publish(const char *topic, const uint8_t *payload,
+                        size_t length) {
+  if (!link_->publish(topic, payload, length, true)) {
+    return false;
+  }
+  stats_.bytesPublished += length;
+  return true;
+}
+
+bool FleetNode::publishPortfolio(const uint8_t *snapshot, size_t length) {
+  SnapshotReader reader;
+  if (!connected_ || length > sizeof(current_) ||
+      !reader.open(snapshot, length)) {
+    return false;
+  }
+  if (keyframeLength_ > 0 && reader.contentHash() == currentHash_) {
+    return true; // Nothing new
+  }
+
+  uint8_t delta[SNAPSHOT_MAX_SIZE];
+  size_t deltaLength =
+      keyframeLength_ == 0
+          ? 0
+          : snapshotDelta(keyframe_, keyframeLength_, snapshot, length, delta,
+                          length / 2);
+  if (deltaLength == 0) {
+    return publishKeyframe(snapshot, length);
+  }
+  if (!publish(deltaTopic_, delta, deltaLength)) {
+    return false;
+  }
+  stats_.deltas++;
+  memcpy(delta_, delta, deltaLength);
+  deltaLength_ = deltaLength;
+  setCurrent(snapshot, length, reader.contentHash());
+  return true;
+}
+
+bool FleetNode::publishKeyframe(const uint8_t *snapshot, size_t length) {
+  SnapshotReader reader;
+  reader.open(snapshot, length);
+  // The old delta does not apply to the new full snapshot, so clear it;
+  // tickers that see the two in between ignore the delta (wrong base)
+  if (!publish(portfolioTopic_, snapshot, length) ||
+      !publish(deltaTopic_, nullptr, 0)) {
+    return false;
+  }
+  stats_.keyframes++;
+  memcpy(keyframe_, snapshot, length);
+  keyframeLength_ = length;
+  deltaLength_ = 0;
+  setCurrent(snapshot, length, reader.contentHash());
+  return true;
+}
+
+bool FleetNode::publishBalance(float balance) {
+  char text[FLEET_BALANCE_LENGTH];
+  snprintf(text, sizeof(text), "%.6f", balance);
+  if (strcmp(text, balance_) == 0) {
+    return true;
+  }
+  if (!connected_ || !link_->publish(balanceTopic_, (const uint8_t *)text,
+                                     strlen(text), true)) {
+    return false;
+  }
+  copyText(balance_, sizeof(balance_), text);
+  balanceVersion_++;
+  return true;
+}
+
+float FleetNode::balance() const { return (float)atof(balance_); }
@@ -0,0 +1,146 @@
+/**
+ * fleet_node.h - Sharing one ticker's data with the others over MQTT
+ *
+ * When several tickers show the same wallet, they would all ask Koios,
+ * MinSwap and Cexplorer the same questions. With an MQTT broker on the
+ * network (for example Mosquitto on a Raspberry Pi), one ticker - the
+ * leader - asks the APIs and publishes what it got. The other tickers
+ * subscribe and do not fetch at all, so the API calls stay the same whether
+ * there are 2 tickers or 50.
+ *
+ * Topics (under a prefix such as "cardanoticker/office"):
+ *
+ *   <prefix>/node/<id>        "1" while the ticker is connected (retained).
+ *                             Its last will clears it, so the broker tells
+ *                             everyone when a ticker disappears.
+ *   <prefix>/portfolio        Full snapshot of tokens and NFTs (retained,
+ *                             format in ticker_snapshot.h)
+ *   <prefix>/portfolio/delta  Changes since that full snapshot (retained)
+ *   <prefix>/balance          Wallet balance in ADA, as text (retained)
+ *
+ * Choosing the leader: the connected ticker with the lowest id leads. Every
+ * ticker sees the same retained node topics, so they all agree without
+ * voting. When the leader loses power, the broker publishes its last will
+ * (after its keep-alive runs out) and the next lowest id takes over.
+ *
+ * Full snapshots and deltas: the leader publishes a full snapshot once, and
+ * after that only a delta against it. The delta is retained too and always
+ * relative to the last full snapshot, so a ticker that joins late gets both
+ * and is up to date. When the delta grows to half the size of a full
+ * snapshot, the leader publishes a new full snapshot instead.
+ *
+ * This file has no Arduino or MQTT library dependencies (fleet_sync.cpp
+ * connects it to PubSubClient), so host-sim can run many tickers at once.
+ */
+
+#ifndef FLEET_NODE_H
+#define FLEET_NODE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ticker_snapshot.h"
+
+#define FLEET_MAX_NODES 16       // Other tickers we keep track of
+#define FLEET_ID_LENGTH 24       // Including the terminating zero
+#define FLEET_PREFIX_LENGTH 64   // Including the terminating zero
+#define FLEET_TOPIC_LENGTH 96    // Including the terminating zero
+#define FLEET_SETTLE_MS 2000UL   // Wait for retained messages before leading
+#define FLEET_BALANCE_LENGTH 24  // Balance text, including the zero
+
+// How a FleetNode sends messages (fleet_sync.cpp uses PubSubClient)
+class FleetLink {
+public:
+  virtual ~FleetLink() {}
+  virtual bool publish(const char *topic, const uint8_t *payload,
+                       size_t length, bool retained) = 0;
+};
+
+class FleetNode {
+public:
+  struct Stats {
+    uint32_t keyframes = 0;      // Full snapshots published
+    uint32_t deltas = 0;         // Deltas published
+    uint32_t bytesPublished = 0; // Snapshot and delta payloads
+    uint32_t rejected = 0;       // Received snapshots or deltas not used
+  };
+
+  // prefix and id are copied (and cut at FLEET_PREFIX_LENGTH and
+  // FLEET_ID_LENGTH)
+  void begin(const char *prefix, const char *id, FleetLink *link);
+
+  // The topic that announces this ticker; use it as the MQTT last will, with
+  // an empty retained message
+  const char *nodeTopic() const { return nodeTopic_; }
+  // The topic filter to subscribe to (<prefix>/#)
+  const char *subscription() const { return subscription_; }
+
+  // Call after connecting and subscribing: announces this ticker and
+  // forgets the others and the last full snapshot (their retained messages
+  // arrive again)
+  void connected(unsigned long now);
+  void disconnected() { connected_ = false; }
+
+  // Every message received on the subscription
+  void receive(const char *topic, const uint8_t *payload, size_t length);
+
+  // True if this ticker should ask the APIs and publish the results
+  bool isLeader(unsigned long now) const;
+
+  // Leader: publish new data. Unchanged data is not published again.
+  bool publishPortfolio(const uint8_t *snapshot, size_t length);
+  bool publishBalance(float balance);
+
+  // The latest portfolio and balance, received or published. The versions
+  // go up by one whenever the content changes.
+  uint32_t portfolioVersion() const { return portfolioVersion_; }
+  const uint8_t *portfolio(size_t &length) const {
+    length = currentLength_;
+    return current_;
+  }
+  uint32_t balanceVersion() const { return balanceVersion_; }
+  float balance() const;
+
+  const Stats &stats() const { return stats_; }
+
+private:
+  bool publish(const char *topic, const uint8_t *payload, size_t length);
+  bool publishKeyframe(const uint8_t *snapshot, size_t length);
+  void setCurrent(const uint8_t *snapshot, size_t length, uint32_t hash);
+  void receiveKeyframe(const uint8_t *payload, size_t length);
+  void receiveDelta(const uint8_t *payload, size_t length);
+  bool applyDelta();
+  void receiveNode(const char *id, bool online);
+
+  FleetLink *link_ = nullptr;
+  char id_[FLEET_ID_LENGTH] = {};
+  char prefix_[FLEET_PREFIX_LENGTH] = {};
+  char nodeTopic_[FLEET_TOPIC_LENGTH] = {};
+  char subscription_[FLEET_TOPIC_LENGTH] = {};
+  char portfolioTopic_[FLEET_TOPIC_LENGTH] = {};
+  char deltaTopic_[FLEET_TOPIC_LENGTH] = {};
+  char balanceTopic_[FLEET_TOPIC_LENGTH] = {};
+
+  bool connected_ = false;
+  unsigned long connectedAt_ = 0;
+  char nodes_[FLEET_MAX_NODES][FLEET_ID_LENGTH] = {}; // Other tickers online
+  int nodeCount_ = 0;
+
+  // Last full snapshot, and the current one (full snapshot plus delta)
+  uint8_t keyframe_[SNAPSHOT_MAX_SIZE] = {};
+  size_t keyframeLength_ = 0;
+  uint8_t current_[SNAPSHOT_MAX_SIZE] = {};
+  size_t currentLength_ = 0;
+  uint32_t currentHash_ = 0;
+  uint32_t portfolioVersion_ = 0;
+  // Last delta received, kept in case it arrived before its full snapshot
+  uint8_t delta_[SNAPSHOT_MAX_SIZE] = {};
+  size_t deltaLength_ = 0;
+
+  char balance_[FLEET_BALANCE_LENGTH] = {};
+  uint32_t balanceVersion_ = 0;
+
+  Stats stats_;
+};
+
+#endif
@@ -0,0 +1,247 @@
+/**
+ * fleet_sync.cpp - Sharing data between tickers over MQTT
+ *
+ * This file connects the FleetNode logic (fleet_node.h) to an MQTT broker
+ * with the PubSubClient library, and to the data this ticker shows
+ * (data_fetcher.h).
+ *
+ * Key Concepts:
+ * - MQTT: a small publish/subscribe protocol. Devices send messages to a
+ *   "topic" on a broker, and the broker passes them on to every device that
+ *   subscribed to it.
+ * - Retained messages: the broker keeps the last message of a topic and
+ *   gives it to devices that subscribe later, so a ticker that starts up gets
+ *   the current data at once.
+ * - Last will: a message the broker publishes for a device when it stops
+ *   answering. That is how the others notice the leader is gone.
+ *
+ * Required library: PubSubClient by Nick O'Leary (Arduino Library Manager)
+ */
+
+#include "fleet_sync.h"
+
+#include <PubSubClient.h> // MQTT client
+#include <WiFi.h>         // WiFiClient, the connection PubSubClient uses
+
+#include "config.h"          // Broker address and topic prefix
+#include "data_fetcher.h"    // The data we share
+#include "fleet_node.h"      // Leader election, snapshots and deltas
+#include "ticker_snapshot.h" // Snapshot format
+#include "wifi_manager.h"    // WiFi connection state
+
+// Private namespace - these variables are only accessible within this file
+namespace {
+
+// Time to wait between connection attempts to the broker (5 seconds)
+constexpr unsigned long MQTT_RETRY_INTERVAL_MS = 5000UL;
+
+// Seconds without a message before the broker gives up on a ticker and
+// publishes its last will. The broker waits 1.5 times this, so the other
+// tickers take over about 20 seconds after the leader loses power.
+constexpr uint16_t MQTT_KEEP_ALIVE_S = 15;
+
+// Largest message: a full snapshot plus the topic and MQTT header
+// (PubSubClient's default of 256 bytes is too small for a snapshot)
+constexpr uint16_t MQTT_BUFFER_SIZE =
+    SNAPSHOT_MAX_SIZE + FLEET_TOPIC_LENGTH + 8;
+
+WiFiClient wifiClient;         // Network connection to the broker
+PubSubClient mqtt(wifiClient); // MQTT on top of that connection
+
+/**
+ * FleetLink that sends FleetNode's messages with PubSubClient
+ */
+class MqttLink : public FleetLink {
+public:
+  bool publish(const char *topic, const uint8_t *payload, size_t length,
+               bool retained) override {
+    return mqtt.publish(topic, payload, length, retained);
+  }
+};
+
+MqttLink link;
+FleetNode node;
+
+bool enabled = false;                // True if a broker is configured
+char nodeId[FLEET_ID_LENGTH];        // "ticker-" and the WiFi MAC address
+unsigned long lastConnectAttempt = 0;
+
+// What we have already shown (follower) or published (leader)
+uint32_t shownPortfolioVersion = 0;
+uint32_t shownBalanceVersion = 0;
+unsigned long publishedKoiosFetch = 0;
+unsigned long publishedPortfolioFetch = 0;
+
+/**
+ * Called by PubSubClient for every message on our topics
+ */
+void onMqttMessage(char *topic, uint8_t *payload, unsigned int length) {
+  node.receive(topic, payload, length);
+}
+
+/**
+ * Called by the WiFi manager when the connection comes back or goes away
+ */
+void onWifiChange(bool connected) {
+  if (connected) {
+    lastConnectAttempt = 0; // Reconnect to the broker right away
+  } else {
+    // The connection to the broker broke with WiFi; the broker publishes
+    // our last will once our keep-alive runs out
+    mqtt.disconnect();
+    node.disconnected();
+  }
+}
+
+/**
+ * Connect to the broker, announce this ticker and subscribe to the others
+ */
+void connectToBroker() {
+  const unsigned long now = millis();
+  if (lastConnectAttempt != 0 &&
+      (uint32_t)(now - lastConnectAttempt) < MQTT_RETRY_INTERVAL_MS) {
+    return; // Tried recently
+  }
+  lastConnectAttempt = now;
+
+  Serial.print("MQTT: connecting to ");
+  Serial.print(mqttBroker);
+  Serial.print(" as ");
+  Serial.println(nodeId);
+
+  // Last will: an empty retained message on our node topic, which removes
+  // this ticker from everyone's list when the broker loses it
+  if (!mqtt.connect(nodeId, node.nodeTopic(), 0, true, "")) {
+    Serial.print("MQTT: connection failed, state ");
+    Serial.println(mqtt.state());
+    return;
+  }
+  mqtt.subscribe(node.subscription());
+  node.connected(now);
+  // If we lead, publish our data again in case the broker lost it
+  publishedKoiosFetch = 0;
+  publishedPortfolioFetch = 0;
+  Serial.println("MQTT: connected");
+}
+
+/**
+ * Leader: publish what this ticker fetched since the last time
+ */
+void publishFetchedData() {
+  // Balance, after each Koios fetch
+  const unsigned long koiosFetch = getLastKoiosFetchTime();
+  if (koiosFetch != 0 && koiosFetch != publishedKoiosFetch &&
+      node.publishBalance(getWalletBalance())) {
+    publishedKoiosFetch = koiosFetch;
+    shownBalanceVersion = node.balanceVersion();
+  }
+
+  // Tokens and NFTs, after each portfolio fetch
+  // FleetNode only sends what changed, so an unchanged portfolio costs
+  // nothing
+  const unsigned long portfolioFetch = getLastPortfolioFetchTime();
+  if (portfolioFetch != 0 && portfolioFetch != publishedPortfolioFetch) {
+    uint8_t snapshot[SNAPSHOT_MAX_SIZE];
+    size_t length = writePortfolioSnapshot(snapshot, sizeof(snapshot));
+    if (length > 0 && node.publishPortfolio(snapshot, length)) {
+      publishedPortfolioFetch = portfolioFetch;
+      shownPortfolioVersion = node.portfolioVersion();
+    }
+  }
+}
+
+/**
+ * Follower: show data the leader published
+ */
+void showReceivedData() {
+  if (node.balanceVersion() != shownBalanceVersion) {
+    shownBalanceVersion = node.balanceVersion();
+    showWalletBalance(node.balance());
+  }
+
+  if (node.portfolioVersion() != shownPortfolioVersion) {
+    shownPortfolioVersion = node.portfolioVersion();
+    size_t length;
+    const uint8_t *snapshot = node.portfolio(length);
+    if (showPortfolioSnapshot(snapshot, length)) {
+      Serial.print("MQTT: portfolio received (");
+      Serial.print(getTokenCount());
+      Serial.print(" tokens, ");
+      Serial.print(getNftCount());
+      Serial.println(" NFT collections)");
+    }
+  }
+}
+
+} // namespace
+
+void fleetSyncBegin() {
+  if (mqttBroker == nullptr || mqttBroker[0] == '\0') {
+    return; // No broker configured - every ticker fetches on its own
+  }
+  enabled = true;
+
+  // Our id is based on the WiFi MAC address, which no other ticker has
+  // The ticker with the lowest id fetches for the others
+  String mac = WiFi.macAddress();
+  mac.replace(":", "");
+  mac.toLowerCase();
+  snprintf(nodeId, sizeof(nodeId), "ticker-%s", mac.c_str());
+
+  node.begin(fleetTopic, nodeId, &link);
+  mqtt.setServer(mqttBroker, mqttPort);
+  mqtt.setBufferSize(MQTT_BUFFER_SIZE);
+  mqtt.setKeepAlive(MQTT_KEEP_ALIVE_S);
+  mqtt.setCallback(onMqttMessage);
+  wifiManagerSubscribe(onWifiChange);
+
+  if (!wifiManagerIsConnected()) {
+    return; // fleetSyncLoop() connects once WiFi is up
+  }
+
+  // Give the broker a moment to send the retained messages: who else is
+  // online, and the data they published
+  const unsigned long start = millis();
+  while ((uint32_t)(millis() - start) < FLEET_SETTLE_MS + 500UL) {
+    fleetSyncLoop();
+    if (!mqtt.connected()) {
+      break; // Broker not reachable, fetch on our own for now
+    }
+    delay(10);
+  }
+}
+
+void fleetSyncLoop() {
+  if (!enabled || !wifiManagerIsConnected()) {
+    return;
+  }
+
+  if (!mqtt.connected()) {
+    node.disconnected();
+    connectToBroker();
+    return;
+  }
+
+  // Receive messages (calls onMqttMessage) and answer the broker's keep-alive
+  mqtt.loop();
+
+  if (node.isLeader(millis())) {
+    publishFetchedData();
+  } else {
+    showReceivedData();
+  }
+}
+
+bool fleetSyncShouldFetch() {
+  return !enabled || !mqtt.connected() || node.isLeader(millis());
+}
+
+const char *fleetSyncRole() {
+  if (!enabled) {
+    return "Off";
+  }
+  if (!mqtt.connected()) {
+    return "No broker";
+  }
+  return node.isLeader(millis()) ? "Fetching" : "Receiving";
+}
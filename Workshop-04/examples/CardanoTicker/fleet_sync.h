@@ -0,0 +1,52 @@
+/**
+ * fleet_sync.h - Header file for sharing data between tickers over MQTT
+ *
+ * With several tickers showing the same wallet, only one of them needs to
+ * ask the APIs. This module connects to an MQTT broker (set mqttBroker in
+ * config.cpp) and either publishes what this ticker fetched, or shows what
+ * another ticker published. See fleet_node.h for how it works.
+ *
+ * Without a broker configured, every function here does nothing and the
+ * ticker fetches its own data as usual.
+ */
+
+#ifndef FLEET_SYNC_H
+#define FLEET_SYNC_H
+
+#include <Arduino.h>
+
+/**
+ * Connect to the MQTT broker and wait briefly for shared data
+ *
+ * Call once in setup(), before the first fetch. If WiFi is already
+ * connected and another ticker already publishes data, it is shown when this
+ * returns and fleetSyncShouldFetch() returns false. Otherwise it returns at
+ * once, and fleetSyncLoop() connects as soon as WiFi is up - no ticker
+ * fetches until the broker had a moment to send the shared data.
+ */
+void fleetSyncBegin();
+
+/**
+ * Stay connected, show received data, publish fetched data
+ *
+ * Call repeatedly in loop(), before the update functions.
+ */
+void fleetSyncLoop();
+
+/**
+ * Should this ticker ask the APIs itself?
+ *
+ * @return true without a broker, while the broker cannot be reached, or if
+ *         this ticker was chosen to fetch for the others
+ */
+bool fleetSyncShouldFetch();
+
+/**
+ * What this ticker does in the fleet, for the status screen
+ *
+ * @return "Off" (no broker configured), "No broker" (cannot connect),
+ *         "Fetching" (this ticker fetches for the others) or "Receiving"
+ */
+const char *fleetSyncRole();
+
+#endif
@@ -0,0 +1,285 @@
+/**
+ * heap_profiler.cpp - Implementation of the heap profiler
+ *
+ * On the board the numbers come from the ESP32's heap: ESP.getFreeHeap(),
+ * getMaxAllocHeap() (the largest free block), getMinFreeHeap() and, for the
+ * number of holes, heap_caps_get_info(). A site only sees the free heap
+ * before and after it, so what it allocated and gave back again is not
+ * counted, only what it kept and how far it pushed the low-water mark.
+ *
+ * In host builds the simulated heap (host-sim/arduino/heap_tracker.cpp)
+ * models the ESP32's allocator, and HeapScope tells it which site is
+ * running. It then counts every allocation for the innermost site.
+ *
+ * Sites register themselves in a linked list the first time they run, so
+ * there is no table to keep up to date. Everything runs in the Arduino loop
+ * task, so no locking is needed.
+ */
+
+#include "heap_profiler.h"
+
+#ifdef HOST_SIM
+#include "hostsim.h"
+#else
+#include <esp_heap_caps.h>
+#endif
+
+namespace {
+
+const char *const TAG_NAMES[HEAP_TAG_COUNT] = {"fetcher", "ticker", "screens",
+                                               "web",     "pos",    "other"};
+
+HeapSite *sites = nullptr; // Most recently registered first
+
+HeapSample history[HEAP_PROFILER_HISTORY];
+int historyCount = 0;
+int historyNext = 0; // Where the next sample goes
+
+unsigned long intervalMs = 0;
+unsigned long lastSampleMs = 0;
+bool begun = false;
+uint64_t allocationsAtSample = 0;
+
+uint32_t freeBlockCount() {
+#ifdef HOST_SIM
+  return hostsim::heapModelStats().freeBlocks;
+#else
+  multi_heap_info_t info;
+  heap_caps_get_info(&info, MALLOC_CAP_8BIT);
+  return info.free_blocks;
+#endif
+}
+
+// Allocations since the previous call (host builds only, 0 on the board)
+uint32_t allocationsSince() {
+#ifdef HOST_SIM
+  const uint64_t allocations = hostsim::heapModelStats().allocations;
+  const uint64_t since = allocations - allocationsAtSample;
+  allocationsAtSample = allocations;
+  return (uint32_t)since;
+#else
+  return 0;
+#endif
+}
+
+// How much of the heap a site took, for ranking
+uint64_t weight(const HeapSite &site) {
+#ifdef HOST_SIM
+  const hostsim::HeapSiteTotals totals = hostsim::heapSiteTotals(&site);
+  if (totals.allocations > 0) {
+    return totals.bytesAllocated;
+  }
+#endif
+  const uint32_t retained =
+      site.retainedBytes > 0 ? (uint32_t)site.retainedBytes : 0;
+  return (uint64_t)site.lowWaterBytes + retained;
+}
+
+} // namespace
+
+HeapSite::HeapSite(const char *siteName, HeapTag siteTag)
+    : name(siteName), tag(siteTag), calls(0), retainedBytes(0),
+      lowWaterBytes(0), next(sites) {
+  sites = this;
+}
+
+HeapScope::HeapScope(HeapSite &site) : site_(site) {
+  freeBefore_ = ESP.getFreeHeap();
+  minFreeBefore_ = ESP.getMinFreeHeap();
+#ifdef HOST_SIM
+  previousSite_ = hostsim::heapSetSite(&site);
+#else
+  previousSite_ = nullptr;
+#endif
+}
+
+HeapScope::~HeapScope() {
+#ifdef HOST_SIM
+  hostsim::heapSetSite(previousSite_);
+#endif
+  const uint32_t freeAfter = ESP.getFreeHeap();
+  const uint32_t minFreeAfter = ESP.getMinFreeHeap();
+  site_.calls++;
+  site_.retainedBytes += (int32_t)(freeBefore_ - freeAfter);
+  if (minFreeAfter < minFreeBefore_) {
+    site_.lowWaterBytes += minFreeBefore_ - minFreeAfter;
+  }
+}
+
+void heapProfilerBegin(unsigned long sampleIntervalMs) {
+  intervalMs = sampleIntervalMs;
+  historyCount = 0;
+  historyNext = 0;
+  allocationsSince(); // Count from here on
+  begun = true;
+  heapProfilerSample();
+}
+
+void heapProfilerLoop() {
+  // In 32 bits, so the next sample is due on time after millis() wraps
+  if (begun && (uint32_t)(millis() - lastSampleMs) >= intervalMs) {
+    heapProfilerSample();
+  }
+}
+
+HeapSample heapProfilerSample() {
+  HeapSample sample;
+  sample.atMs = millis();
+  sample.freeBytes = ESP.getFreeHeap();
+  sample.largestBlock = ESP.getMaxAllocHeap();
+  sample.minFreeBytes = ESP.getMinFreeHeap();
+  sample.freeBlocks = freeBlockCount();
+  if (sample.freeBytes > 0 && sample.largestBlock < sample.freeBytes) {
+    sample.fragmentation =
+        100 - (uint8_t)((uint64_t)sample.largestBlock * 100 / sample.freeBytes);
+  }
+  sample.allocations = allocationsSince();
+
+  history[historyNext] = sample;
+  historyNext = (historyNext + 1) % HEAP_PROFILER_HISTORY;
+  if (historyCount < HEAP_PROFILER_HISTORY) {
+    historyCount++;
+  }
+  lastSampleMs = sample.atMs;
+
+  Serial.printf("[Heap] free %.1f KB, largest %.1f KB, min %.1f KB, "
+                "%lu holes, frag %u%%",
+                sample.freeBytes / 1024.0, sample.largestBlock / 1024.0,
+                sample.minFreeBytes / 1024.0, (unsigned long)sample.freeBlocks,
+                (unsigned)sample.fragmentation);
+#ifdef HOST_SIM
+  Serial.printf(", %lu allocations", (unsigned long)sample.allocations);
+#endif
+  Serial.println();
+  return sample;
+}
+
+HeapSample heapProfilerLast() {
+  if (historyCount == 0) {
+    return HeapSample();
+  }
+  return history[(historyNext + HEAP_PROFILER_HISTORY - 1) %
+                 HEAP_PROFILER_HISTORY];
+}
+
+void heapProfilerFragmentationTrend(uint8_t &first, uint8_t &last) {
+  if (historyCount == 0) {
+    first = last = 0;
+    return;
+  }
+  const int oldest =
+      (historyNext + HEAP_PROFILER_HISTORY - historyCount) %
+      HEAP_PROFILER_HISTORY;
+  first = history[oldest].fragmentation;
+  last = heapProfilerLast().fragmentation;
+}
+
+void heapProfilerReport(Print &out, int maxSites) {
+  const HeapSample now = heapProfilerLast();
+  out.printf("[Heap] free %.1f KB, largest %.1f KB, frag %u%%\n",
+             now.freeBytes / 1024.0, now.largestBlock / 1024.0,
+             (unsigned)now.fragmentation);
+
+  // Sort the list by weight, heaviest first (insertion sort: there are only
+  // a few dozen sites, and this runs on request)
+  HeapSite *sorted = nullptr;
+  while (sites != nullptr) {
+    HeapSite *site = sites;
+    sites = site->next;
+    const uint64_t siteWeight = weight(*site);
+    HeapSite **at = &sorted;
+    while (*at != nullptr && weight(**at) >= siteWeight) {
+      at = &(*at)->next;
+    }
+    site->next = *at;
+    *at = site;
+  }
+  sites = sorted;
+
+  out.println("[Heap]   site                 tag       calls   kept KB  "
+              "low water KB");
+  int listed = 0;
+  for (const HeapSite *site = sites; site != nullptr && listed < maxSites;
+       site = site->next, listed++) {
+    out.printf("[Heap]   %-20s %-8s %6lu %9.1f %13.1f\n", site->name,
+               TAG_NAMES[site->tag], (unsigned long)site->calls,
+               site->retainedBytes / 1024.0, site->lowWaterBytes / 1024.0);
+#ifdef HOST_SIM
+    const hostsim::HeapSiteTotals totals = hostsim::heapSiteTotals(site);
+    out.printf("[Heap]     %llu allocations, %.1f KB allocated, %.1f KB live, "
+               "%.1f KB peak\n",
+               (unsigned long long)totals.allocations,
+               totals.bytesAllocated / 1024.0, totals.liveBytes / 1024.0,
+               totals.peakBytes / 1024.0);
+#endif
+  }
+
+  // Per tag. On the board a site inside another is counted in both.
+  for (int tag = 0; tag < HEAP_TAG_COUNT; tag++) {
+    uint32_t calls = 0;
+    int32_t retained = 0;
+    uint64_t allocated = 0;
+    for (const HeapSite *site = sites; site != nullptr; site = site->next) {
+      if (site->tag != tag) {
+        continue;
+      }
+      calls += site->calls;
+      retained += site->retainedBytes;
+#ifdef HOST_SIM
+      allocated += hostsim::heapSiteTotals(site).bytesAllocated;
+#endif
+    }
+    if (calls == 0) {
+      continue;
+    }
+    out.printf("[Heap]   tag %-8s %6lu calls, kept %.1f KB", TAG_NAMES[tag],
+               (unsigned long)calls, retained / 1024.0);
+    if (allocated > 0) {
+      out.printf(", allocated %.1f KB", allocated / 1024.0);
+    }
+    out.println();
+  }
+}
+
+String heapProfilerToJson() {
+  String json = "{\"intervalMs\":";
+  json += String(intervalMs);
+  json += ",\"samples\":[";
+  const int oldest =
+      (historyNext + HEAP_PROFILER_HISTORY - historyCount) %
+      HEAP_PROFILER_HISTORY;
+  for (int i = 0; i < historyCount; i++) {
+    const HeapSample &sample = history[(oldest + i) % HEAP_PROFILER_HISTORY];
+    json += i > 0 ? ",{\"agoMs\":" : "{\"agoMs\":";
+    json += String((uint32_t)(millis() - sample.atMs));
+    json += ",\"free\":";
+    json += String(sample.freeBytes);
+    json += ",\"largest\":";
+    json += String(sample.largestBlock);
+    json += ",\"minFree\":";
+    json += String(sample.minFreeBytes);
+    json += ",\"holes\":";
+    json += String(sample.freeBlocks);
+    json += ",\"fragPercent\":";
+    json += String((unsigned)sample.fragmentation);
+    json += "}";
+  }
+  json += "],\"sites\":[";
+  bool firstSite = true;
+  for (const HeapSite *site = sites; site != nullptr; site = site->next) {
+    json += firstSite ? "{\"name\":\"" : ",{\"name\":\"";
+    firstSite = false;
+    json += site->name;
+    json += "\",\"tag\":\"";
+    json += TAG_NAMES[site->tag];
+    json += "\",\"calls\":";
+    json += String(site->calls);
+    json += ",\"keptBytes\":";
+    json += String(site->retainedBytes);
+    json += ",\"lowWaterBytes\":";
+    json += String(site->lowWaterBytes);
+    json += "}";
+  }
+  json += "]}";
+  return json;
+}
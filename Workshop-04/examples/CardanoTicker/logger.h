@@ -0,0 +1,122 @@
+/**
+ * logger.h - Header file for logging without holding up the caller
+ *
+ * Serial runs at 115200 baud: about 11.5 characters per millisecond. The
+ * UART's transmit buffer holds 128 characters; once it is full,
+ * Serial.print() waits until there is room again. A fetch that prints 2000
+ * characters of URLs, payloads and token lists stands still for over 150 ms
+ * just for that. This logger takes the message and returns: it is formatted
+ * into a ring buffer, and a task of low priority writes it to Serial in the
+ * background.
+ *
+ *   LOG_I("fetcher", "Balance: %.6f ADA", walletBalance);
+ *   LOG_D("fetcher", "Requesting %s", url.c_str());
+ *
+ * prints
+ *
+ *   12.345 I fetcher: Balance: 1234.567890 ADA
+ *
+ * (seconds since boot, level, module, message). There are five levels:
+ * LOG_E (error), LOG_W (warning), LOG_I (info), LOG_D (debug) and LOG_V
+ * (verbose: payloads and per-item dumps). Levels above LOG_LEVEL are
+ * removed by the compiler, arguments included, so a LOG_D in a loop costs
+ * nothing in a build with LOG_LEVEL set to LOG_LEVEL_INFO (the default).
+ * For everything, compile with -DLOG_LEVEL=LOG_LEVEL_VERBOSE or define it
+ * before including this file.
+ *
+ * When the ring is full (Serial cannot keep up), new messages are dropped
+ * instead of waiting, and counted. The next message written says how many
+ * were lost:
+ *
+ *   15.002 W log: 12 messages dropped
+ *
+ * Messages are written in the order they were logged, also from several
+ * FreeRTOS tasks. Serial.print() elsewhere in the firmware still writes
+ * directly, so its lines can show up before log messages logged earlier.
+ */
+
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <Arduino.h>
+
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+#define LOG_LEVEL_VERBOSE 5
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+// Longest message; longer ones are cut off and end in "..."
+#define LOG_MESSAGE_SIZE 160
+
+// Messages the ring holds (a power of two). With LOG_MESSAGE_SIZE this is
+// about 5.5 KB, a static buffer (not on the heap).
+#define LOG_RING_MESSAGES 32
+
+// What the logger did since boot
+struct LoggerStats {
+  uint32_t messages = 0;  // Taken into the ring
+  uint32_t dropped = 0;   // Ring full
+  uint32_t truncated = 0; // Longer than LOG_MESSAGE_SIZE
+  uint32_t bytes = 0;     // Written to Serial
+};
+
+/**
+ * Start writing the ring to Serial (call once in setup(), after
+ * Serial.begin())
+ *
+ * On the ESP32 this starts the background task. Messages logged before
+ * are kept until then (as many as fit).
+ */
+void loggerBegin();
+
+/**
+ * Write what fits into Serial's transmit buffer without waiting (host
+ * builds, which have no tasks; does nothing on the ESP32)
+ */
+void loggerLoop();
+
+/**
+ * Write everything in the ring now, waiting for Serial (e.g. before a
+ * restart, or at the end of a test)
+ */
+void loggerFlush();
+
+LoggerStats loggerStats();
+
+// Used by the macros below
+void logWrite(uint8_t level, const char *module, const char *format, ...)
+    __attribute__((format(printf, 3, 4)));
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_E(module, ...) logWrite(LOG_LEVEL_ERROR, module, __VA_ARGS__)
+#else
+#define LOG_E(module, ...) ((void)0)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_W(module, ...) logWrite(LOG_LEVEL_WARN, module, __VA_ARGS__)
+#else
+#define LOG_W(module, ...) ((void)0)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_I(module, ...) logWrite(LOG_LEVEL_INFO, module, __VA_ARGS__)
+#else
+#define LOG_I(module, ...) ((void)0)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_D(module, ...) logWrite(LOG_LEVEL_DEBUG, module, __VA_ARGS__)
+#else
+#define LOG_D(module, ...) ((void)0)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_VERBOSE
+#define LOG_V(module, ...) logWrite(LOG_LEVEL_VERBOSE, module, __VA_ARGS__)
+#else
+#define LOG_V(module, ...) ((void)0)
+#endif
+
+#endif
@@ -15,6 +15,7 @@
 
 #include "nft_screen.h"
 #include "data_fetcher.h"
+#include "heap_profiler.h"
 #include "screen_helper.h"
 #include <TFT_eSPI.h>
 
@@ -29,6 +30,7 @@ extern TFT_eSPI tft;
  * price.
  */
 void drawNFTScreen() {
+  HEAP_SCOPE(HEAP_SCREENS, "nft screen"); // See heap_profiler.h
   // Draw header with title and page indicator
   // activeIndex = 2 means this is the third screen (0-indexed)
   renderHeader("NFT Positions", 2);
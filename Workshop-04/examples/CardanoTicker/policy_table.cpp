@@ -0,0 +1,44 @@
+/**
+ * policy_table.cpp - Policy IDs from hex and back
+ *
+ * See policy_table.h; PolicyTable itself is a template, in the header.
+ */
+
+#include "policy_table.h"
+
+namespace {
+// Value of a hex digit, -1 if it is not one
+int hexDigit(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+} // namespace
+
+bool parsePolicyId(const char *hex, uint8_t *out) {
+  for (size_t i = 0; i < POLICY_ID_BYTES; ++i) {
+    const int high = hexDigit(hex[2 * i]);
+    const int low = high < 0 ? -1 : hexDigit(hex[2 * i + 1]);
+    if (low < 0) {
+      return false; // Not hex, or too short
+    }
+    out[i] = static_cast<uint8_t>(high << 4 | low);
+  }
+  return hex[2 * POLICY_ID_BYTES] == '\0';
+}
+
+void formatPolicyId(const uint8_t *policyId, char *out) {
+  static const char digits[] = "0123456789abcdef";
+  for (size_t i = 0; i < POLICY_ID_BYTES; ++i) {
+    out[2 * i] = digits[policyId[i] >> 4];
+    out[2 * i + 1] = digits[policyId[i] & 0x0f];
+  }
+  out[2 * POLICY_ID_BYTES] = '\0';
+}
@@ -0,0 +1,105 @@
+/**
+ * policy_table.h - NFT collections by Policy ID
+ *
+ * Every NFT belongs to a collection, and the collection is named by its
+ * Policy ID: a 28-byte hash that the APIs send as 56 hex characters.
+ * parsePolicyId() decodes it once, so comparing two is one memcmp() of 28
+ * bytes instead of two Strings of 56 characters.
+ *
+ * PolicyTable finds the collection of a Policy ID with one lookup, not a
+ * search through the collections seen so far, so grouping a wallet's NFTs
+ * takes time in proportion to the NFTs. The firmware keeps one of
+ * MAX_NFTS collections (data_fetcher.cpp); host benchmarks use larger ones.
+ */
+
+#ifndef POLICY_TABLE_H
+#define POLICY_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// A Policy ID is a 28-byte hash; APIs send it as 56 hex characters
+#define POLICY_ID_BYTES 28
+
+// Decode a Policy ID from its 56 hex characters, as the APIs send it
+// Returns false if the text is anything else
+bool parsePolicyId(const char *hex, uint8_t *out);
+
+// And back, for URLs and logs (out has room for 2 * POLICY_ID_BYTES + 1)
+void formatPolicyId(const uint8_t *policyId, char *out);
+
+// Hash table from Policy ID to the collection's index: 0 for the first one
+// added, 1 for the next, and so on, so the index can be the collection's
+// place in an array. Open addressing: a slot holds the index + 1 (0 =
+// empty), and a taken slot sends the key on to the next one. Policy IDs are
+// hashes already, so their first bytes choose the slot. With at least
+// twice as many slots as collections, most lookups hit on the first try.
+template <size_t Capacity> class PolicyTable {
+  static_assert(Capacity > 0 && Capacity < 65535,
+                "Capacity must fit a slot (uint16_t)");
+
+public:
+  PolicyTable() { clear(); }
+
+  void clear() {
+    memset(slots_, 0, sizeof(slots_));
+    count_ = 0;
+  }
+
+  // Collections added since clear()
+  int size() const { return count_; }
+
+  // Index of the collection with this Policy ID, -1 if none
+  int find(const uint8_t *policyId) const {
+    size_t slot = firstSlot(policyId);
+    for (size_t probe = 0; probe < SLOTS; ++probe) {
+      if (slots_[slot] == 0) {
+        return -1; // An empty slot ends the search
+      }
+      const int index = slots_[slot] - 1;
+      if (memcmp(keys_[index], policyId, POLICY_ID_BYTES) == 0) {
+        return index;
+      }
+      slot = (slot + 1) & (SLOTS - 1); // Taken by another, try the next
+    }
+    return -1;
+  }
+
+  // Add a collection, returns its index (-1 if the table is full). It does
+  // not look for the Policy ID first: call find() for that. An ID added
+  // twice keeps the first index.
+  int add(const uint8_t *policyId) {
+    if (count_ == static_cast<int>(Capacity)) {
+      return -1;
+    }
+    size_t slot = firstSlot(policyId);
+    while (slots_[slot] != 0) { // Never full: Capacity < SLOTS
+      slot = (slot + 1) & (SLOTS - 1);
+    }
+    memcpy(keys_[count_], policyId, POLICY_ID_BYTES);
+    slots_[slot] = static_cast<uint16_t>(count_ + 1);
+    return count_++;
+  }
+
+private:
+  // The smallest power of two of at least 2 x Capacity
+  static constexpr size_t slotsFor(size_t capacity, size_t slots = 1) {
+    return slots >= 2 * capacity ? slots : slotsFor(capacity, 2 * slots);
+  }
+  static constexpr size_t SLOTS = slotsFor(Capacity);
+
+  // First slot to look in for a Policy ID
+  static size_t firstSlot(const uint8_t *policyId) {
+    const uint32_t hash = policyId[0] | policyId[1] << 8 |
+                          policyId[2] << 16 |
+                          static_cast<uint32_t>(policyId[3]) << 24;
+    return hash & (SLOTS - 1);
+  }
+
+  uint16_t slots_[SLOTS];
+  uint8_t keys_[Capacity][POLICY_ID_BYTES];
+  int count_;
+};
+
+#endif
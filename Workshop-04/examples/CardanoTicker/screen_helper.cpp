@@ -8,6 +8,7 @@
  */
 
 #include "screen_helper.h"
+#include "trace.h"
 #include <Arduino.h>
 #include <TFT_eSPI.h>
 
@@ -65,6 +66,8 @@ void ensureHeaderSprite() {
  * @param activeIndex Which screen is active (0-3) - this dot will be filled
  */
 void renderHeader(const char *title, uint8_t activeIndex) {
+  TRACE_SCOPE("header"); // See trace.h
+
   // Make sure sprite is ready
   ensureHeaderSprite();
 
@@ -126,7 +129,9 @@ void renderHeader(const char *title, uint8_t activeIndex) {
 
   // Push the sprite to the display
   // This updates the screen all at once, reducing flicker
+  TRACE_BEGIN("push header");
   headerSprite.pushSprite(0, 0);
+  TRACE_END("push header");
 }
 
 /**
@@ -141,6 +146,8 @@ void renderHeader(const char *title, uint8_t activeIndex) {
  * [Ticker - 30px]
  */
 void clearContentArea() {
+  TRACE_SCOPE("clear content");
+
   // Calculate where content area starts (right below header)
   const int top = kHeaderHeight;
 
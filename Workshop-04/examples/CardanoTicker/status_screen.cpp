@@ -7,15 +7,22 @@
  * - IP address (your device's address on the network)
  * - MAC address (unique hardware identifier)
  * - Uptime (how long the device has been running)
+ * - Data sharing with other tickers over MQTT (see fleet_sync.h)
+ * - How long loop() took in the last minute, and the slowest call in it
+ *   (see loop_profiler.h)
  * 
  * This is useful for debugging connection issues and monitoring device health.
  */
 
 #include "status_screen.h"
+#include "fleet_sync.h"
+#include "heap_profiler.h"
+#include "loop_profiler.h"
 #include "screen_helper.h"
 #include "wifi_manager.h"
 #include <TFT_eSPI.h>
 #include <WiFi.h>
+#include <esp_timer.h>
 
 // External reference to TFT display
 extern TFT_eSPI tft;
@@ -27,6 +34,7 @@ extern TFT_eSPI tft;
  * the device and network connection.
  */
 void drawStatusScreen() {
+  HEAP_SCOPE(HEAP_SCREENS, "status screen"); // See heap_profiler.h
   // Draw header with title and page indicator
   // activeIndex = 3 means this is the fourth (last) screen
   renderHeader("System", 3);
@@ -44,8 +52,10 @@ void drawStatusScreen() {
   const String macAddr = WiFi.macAddress();  // MAC address (always available)
   
   // Calculate uptime (how long device has been running)
-  const unsigned long uptimeMs = millis();  // Milliseconds since startup
-  const unsigned long uptimeSec = uptimeMs / 1000UL;  // Convert to seconds
+  // Not from millis(): it counts in 32 bits and starts again at 0 after
+  // 49.7 days. esp_timer_get_time() counts microseconds in 64 bits.
+  const uint64_t uptimeMicros = esp_timer_get_time();  // Microseconds since startup
+  const unsigned long uptimeSec = uptimeMicros / 1000000ULL;  // Convert to seconds
   
   // Break down uptime into days, hours, minutes, seconds
   const unsigned long days = uptimeSec / 86400UL;  // 86400 seconds = 1 day
@@ -114,5 +124,44 @@ void drawStatusScreen() {
   tft.print("m ");  // Minutes
   tft.print(seconds);
   tft.print("s");   // Seconds
+
+  // Draw MQTT data sharing role
+  y += 16;
+  tft.setCursor(10, y);
+  tft.print("Sharing: ");
+  // "Fetching" = this ticker asks the APIs for the others
+  // "Receiving" = another ticker fetches, this one shows its data
+  tft.print(fleetSyncRole());
+
+  // Draw how long loop() took in the last minute
+  // A "stall" is a loop() longer than the budget (see CardanoTicker.ino);
+  // while one runs, the ticker stops scrolling
+  const LoopSectionStats loopStats = loopProfilerLoop();
+  y += 16;
+  tft.setCursor(10, y);
+  tft.print("Loop: ");
+  if (loopStats.calls == 0) {
+    tft.print("measuring..."); // The first minute is not over yet
+  } else {
+    tft.print("max ");
+    tft.print(loopStats.maxMicros / 1000UL);
+    tft.print(" ms, p99 ");
+    tft.print(loopStats.p99Micros / 1000UL);
+    tft.print(" ms, ");
+    tft.print(loopProfilerStallCount());
+    tft.print(" stalls");
+
+    // Draw the call that took longest, the likely cause of a stall
+    const LoopSectionStats slowest = loopProfilerSlowest();
+    y += 16;
+    tft.setCursor(10, y);
+    tft.print("Slowest: ");
+    tft.print(slowest.name);
+    tft.print(" ");
+    tft.print(slowest.maxMicros / 1000UL);
+    tft.print(" ms (");
+    tft.print(slowest.sharePercent, 1);
+    tft.print("% of time)");
+  }
 }
 
@@ -20,6 +20,8 @@
 
 #include "ticker.h"
 #include "data_fetcher.h"
+#include "heap_profiler.h"
+#include "trace.h"
 #include <Arduino.h>
 #include <TFT_eSPI.h>
 
@@ -70,6 +72,7 @@ static float getTokenPrice(const TokenInfo& token) {
  * and lengths take up different amounts of space.
  */
 void calculateContentWidth() {
+  HEAP_SCOPE(HEAP_TICKER, "ticker width"); // See heap_profiler.h
   contentWidth = 0;  // Start with zero width
   const int tokenCount = getTokenCount();
 
@@ -158,6 +161,7 @@ void drawContentLine(int xPos) {
  * in setup(). It creates the sprite buffer and calculates content width.
  */
 void initTicker() {
+  HEAP_SCOPE(HEAP_TICKER, "ticker init"); // The sprite buffer
   // Fill entire screen with black (clean slate)
   tft.fillScreen(TFT_BLACK);
 
@@ -195,7 +199,11 @@ void initTicker() {
  * - When we reach the end, we reset scrollX to 0 and it looks continuous
  */
 void updateTicker() {
+  TRACE_SCOPE("ticker frame"); // See trace.h
+  HEAP_SCOPE(HEAP_TICKER, "ticker frame");
+
   // Clear the sprite buffer with black (erase previous frame)
+  TRACE_BEGIN("draw sprite");
   scrollSprite.fillSprite(TFT_BLACK);
 
   // Draw first copy of content
@@ -208,11 +216,14 @@ void updateTicker() {
   // We offset it by contentWidth so it appears right after the first copy
   // When first copy scrolls off left, second copy is already visible
   drawContentLine(-scrollX + contentWidth);
+  TRACE_END("draw sprite");
 
   // Push the sprite to the display
   // This updates the screen all at once (reduces flicker)
   // Position: x=0 (left edge), y=bottom of screen minus ticker height
+  TRACE_BEGIN("push sprite");
   scrollSprite.pushSprite(0, tft.height() - scrollAreaHeight);
+  TRACE_END("push sprite");
 
   // Update scroll position (move left by scrollSpeed pixels)
   scrollX += scrollSpeed;
@@ -221,10 +232,28 @@ void updateTicker() {
   // If so, reset to 0 to create the loop effect
   if (scrollX >= contentWidth) {
     scrollX = 0;  // Loop back to beginning
+    TRACE_INSTANT("ticker wrap");
   }
 
   // Small delay to control scroll speed
   // Without this, scrolling would be too fast
   // 30ms = ~33 updates per second (smooth animation)
+  TRACE_BEGIN("frame delay");
   delay(30);
+  TRACE_END("frame delay");
+}
+
+/**
+ * Show new token data in the ticker
+ *
+ * drawContentLine() reads the tokens on every frame, so only the content
+ * width (where the loop starts over) needs to be measured again.
+ */
+void refreshTicker() {
+  calculateContentWidth();
+
+  // Start over if the new content is shorter than where we scrolled to
+  if (scrollX >= contentWidth) {
+    scrollX = 0;
+  }
 }
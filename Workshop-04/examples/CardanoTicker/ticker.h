@@ -26,4 +26,12 @@ void initTicker();
  */
 void updateTicker();
 
+/**
+ * Show new token data in the ticker
+ *
+ * Measures the content again. Call this when the tokens changed, otherwise
+ * the ticker keeps the width of the old content and loops at the wrong place.
+ */
+void refreshTicker();
+
 #endif
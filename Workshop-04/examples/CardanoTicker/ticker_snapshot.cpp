@@ -0,0 +1,313 @@
+/**
+ * ticker_snapshot.cpp - Reading and writing portfolio snapshots
+ *
+ * See ticker_snapshot.h for the format.
+ */
+
+#include "ticker_snapshot.h"
+
+#include <string.h>
+
+namespace {
+constexpr size_t TOKEN_SIZE = 21;
+constexpr size_t NFT_SIZE = 13;
+constexpr size_t PATCH_HEADER_SIZE = 3;
+constexpr size_t MAX_PATCH_LENGTH = 255;
+
+uint16_t readU16(const uint8_t *p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+
+uint32_t readU32(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+         ((uint32_t)p[3] << 24);
+}
+
+uint64_t readU64(const uint8_t *p) {
+  return (uint64_t)readU32(p) | ((uint64_t)readU32(p + 4) << 32);
+}
+
+void writeU16(uint8_t *p, uint16_t value) {
+  p[0] = (uint8_t)value;
+  p[1] = (uint8_t)(value >> 8);
+}
+
+void writeU32(uint8_t *p, uint32_t value) {
+  for (int i = 0; i < 4; i++) {
+    p[i] = (uint8_t)(value >> (8 * i));
+  }
+}
+
+void writeU64(uint8_t *p, uint64_t value) {
+  writeU32(p, (uint32_t)value);
+  writeU32(p + 4, (uint32_t)(value >> 32));
+}
+} // namespace
+
+uint32_t snapshotHash(const uint8_t *data, size_t length) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < length; i++) {
+    hash ^= data[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+size_t snapshotDelta(const uint8_t *base, size_t baseLength,
+                     const uint8_t *target, size_t targetLength, uint8_t *out,
+                     size_t outSize) {
+  if (baseLength < SNAPSHOT_HEADER_SIZE || targetLength > 0xFFFF ||
+      outSize < SNAPSHOT_DELTA_HEADER_SIZE) {
+    return 0;
+  }
+  size_t pos = SNAPSHOT_DELTA_HEADER_SIZE;
+  int patchCount = 0;
+  size_t i = 0;
+  while (i < targetLength) {
+    if (i < baseLength && base[i] == target[i]) {
+      i++;
+      continue;
+    }
+    // A patch runs until PATCH_HEADER_SIZE equal bytes in a row, as a shorter
+    // gap costs less to resend than to start a new patch for
+    size_t start = i;
+    size_t end = i + 1; // One past the last changed byte
+    for (size_t j = i + 1; j < targetLength && j - start < MAX_PATCH_LENGTH &&
+                           j - end <= PATCH_HEADER_SIZE;
+         j++) {
+      if (j >= baseLength || base[j] != target[j]) {
+        end = j + 1;
+      }
+    }
+    size_t length = end - start;
+    if (patchCount == 255 || pos + PATCH_HEADER_SIZE + length > outSize) {
+      return 0;
+    }
+    writeU16(out + pos, (uint16_t)start);
+    out[pos + 2] = (uint8_t)length;
+    memcpy(out + pos + PATCH_HEADER_SIZE, target + start, length);
+    pos += PATCH_HEADER_SIZE + length;
+    patchCount++;
+    i = end;
+  }
+
+  out[0] = 'C';
+  out[1] = 'D';
+  out[2] = SNAPSHOT_VERSION;
+  out[3] = 0;
+  writeU32(out + 4, readU32(base + 8));
+  writeU16(out + 8, (uint16_t)targetLength);
+  out[10] = (uint8_t)patchCount;
+  return pos;
+}
+
+size_t applySnapshotDelta(const uint8_t *base, size_t baseLength,
+                          const uint8_t *delta, size_t deltaLength,
+                          uint8_t *out, size_t outSize) {
+  if (baseLength < SNAPSHOT_HEADER_SIZE ||
+      deltaLength < SNAPSHOT_DELTA_HEADER_SIZE || delta[0] != 'C' ||
+      delta[1] != 'D' || delta[2] != SNAPSHOT_VERSION || delta[3] != 0 ||
+      readU32(delta + 4) != readU32(base + 8)) {
+    return 0;
+  }
+  size_t length = readU16(delta + 8);
+  if (length > outSize) {
+    return 0;
+  }
+  size_t kept = length < baseLength ? length : baseLength;
+  memcpy(out, base, kept);
+  memset(out + kept, 0, length - kept);
+
+  size_t pos = SNAPSHOT_DELTA_HEADER_SIZE;
+  for (int i = 0; i < delta[10]; i++) {
+    if (pos + PATCH_HEADER_SIZE > deltaLength) {
+      return 0;
+    }
+    size_t offset = readU16(delta + pos);
+    size_t patchLength = delta[pos + 2];
+    pos += PATCH_HEADER_SIZE;
+    if (pos + patchLength > deltaLength || offset + patchLength > length) {
+      return 0;
+    }
+    memcpy(out + offset, delta + pos, patchLength);
+    pos += patchLength;
+  }
+  return pos == deltaLength ? length : 0;
+}
+
+bool SnapshotReader::open(const uint8_t *data, size_t length) {
+  *this = SnapshotReader();
+  if (length < SNAPSHOT_HEADER_SIZE + 1 || data[0] != 'C' || data[1] != 'T' ||
+      data[2] != SNAPSHOT_VERSION || data[3] != 0) {
+    return false;
+  }
+  size_t payloadLength = readU16(data + 12);
+  if (SNAPSHOT_HEADER_SIZE + payloadLength != length ||
+      snapshotHash(data + SNAPSHOT_HEADER_SIZE, payloadLength) !=
+          readU32(data + 8)) {
+    return false;
+  }
+  int tokenCount = data[14];
+  int nftCount = data[15];
+  if (tokenCount > SNAPSHOT_MAX_ITEMS || nftCount > SNAPSHOT_MAX_ITEMS) {
+    return false;
+  }
+
+  // String table
+  size_t pos = SNAPSHOT_HEADER_SIZE;
+  int stringCount = data[pos++];
+  if (stringCount > SNAPSHOT_MAX_STRINGS) {
+    return false;
+  }
+  for (int i = 0; i < stringCount; i++) {
+    if (pos >= length || data[pos] > SNAPSHOT_MAX_STRING_LENGTH ||
+        pos + 1 + data[pos] > length) {
+      return false;
+    }
+    strings_[i] = (uint16_t)pos;
+    pos += 1 + data[pos];
+  }
+
+  // Records must fill the rest exactly and name strings that exist
+  if (pos + tokenCount * TOKEN_SIZE + nftCount * NFT_SIZE != length) {
+    return false;
+  }
+  tokens_ = pos;
+  nfts_ = pos + tokenCount * TOKEN_SIZE;
+  for (int i = 0; i < tokenCount; i++) {
+    if (data[tokens_ + i * TOKEN_SIZE] >= stringCount) {
+      return false;
+    }
+  }
+  for (int i = 0; i < nftCount; i++) {
+    if (data[nfts_ + i * NFT_SIZE] >= stringCount) {
+      return false;
+    }
+  }
+
+  data_ = data;
+  generatedAt_ = readU32(data + 4);
+  contentHash_ = readU32(data + 8);
+  tokenCount_ = tokenCount;
+  nftCount_ = nftCount;
+  return true;
+}
+
+SnapshotText SnapshotReader::text(uint8_t index) const {
+  const uint8_t *entry = data_ + strings_[index];
+  return {(const char *)entry + 1, entry[0]};
+}
+
+bool SnapshotReader::token(int index, SnapshotToken &out) const {
+  if (index < 0 || index >= tokenCount_) {
+    return false;
+  }
+  const uint8_t *p = data_ + tokens_ + index * TOKEN_SIZE;
+  out.ticker = text(p[0]);
+  out.amountMicro = (int64_t)readU64(p + 1);
+  out.valueMicroUsd = (int64_t)readU64(p + 9);
+  out.change24hCentiPercent = (int32_t)readU32(p + 17);
+  return true;
+}
+
+bool SnapshotReader::nft(int index, SnapshotNft &out) const {
+  if (index < 0 || index >= nftCount_) {
+    return false;
+  }
+  const uint8_t *p = data_ + nfts_ + index * NFT_SIZE;
+  out.name = text(p[0]);
+  out.count = readU32(p + 1);
+  out.floorLovelace = readU64(p + 5);
+  return true;
+}
+
+bool SnapshotWriter::intern(const char *text, uint8_t &index) {
+  // Cut long names, but not in the middle of a UTF-8 character
+  size_t length = strlen(text);
+  if (length > SNAPSHOT_MAX_STRING_LENGTH) {
+    length = SNAPSHOT_MAX_STRING_LENGTH;
+    while (length > 0 && ((uint8_t)text[length] & 0xC0) == 0x80) {
+      length--;
+    }
+  }
+  for (int i = 0; i < stringCount_; i++) {
+    if (strlen(strings_[i]) == length &&
+        memcmp(strings_[i], text, length) == 0) {
+      index = (uint8_t)i;
+      return true;
+    }
+  }
+  if (stringCount_ >= SNAPSHOT_MAX_STRINGS) {
+    return false;
+  }
+  memcpy(strings_[stringCount_], text, length);
+  strings_[stringCount_][length] = '\0';
+  index = (uint8_t)stringCount_++;
+  return true;
+}
+
+bool SnapshotWriter::addToken(const char *ticker, int64_t amountMicro,
+                              int64_t valueMicroUsd,
+                              int32_t change24hCentiPercent) {
+  uint8_t index;
+  if (tokenCount_ >= SNAPSHOT_MAX_ITEMS || !intern(ticker, index)) {
+    return false;
+  }
+  tokens_[tokenCount_++] = {index, amountMicro, valueMicroUsd,
+                            change24hCentiPercent};
+  return true;
+}
+
+bool SnapshotWriter::addNft(const char *name, uint32_t count,
+                            uint64_t floorLovelace) {
+  uint8_t index;
+  if (nftCount_ >= SNAPSHOT_MAX_ITEMS || !intern(name, index)) {
+    return false;
+  }
+  nfts_[nftCount_++] = {index, count, floorLovelace};
+  return true;
+}
+
+size_t SnapshotWriter::finish(uint32_t generatedAt, uint8_t *out,
+                              size_t outSize) const {
+  size_t size = SNAPSHOT_HEADER_SIZE + 1 + tokenCount_ * TOKEN_SIZE +
+                nftCount_ * NFT_SIZE;
+  for (int i = 0; i < stringCount_; i++) {
+    size += 1 + strlen(strings_[i]);
+  }
+  if (size > outSize) {
+    return 0;
+  }
+
+  size_t pos = SNAPSHOT_HEADER_SIZE;
+  out[pos++] = (uint8_t)stringCount_;
+  for (int i = 0; i < stringCount_; i++) {
+    size_t length = strlen(strings_[i]);
+    out[pos++] = (uint8_t)length;
+    memcpy(out + pos, strings_[i], length);
+    pos += length;
+  }
+  for (int i = 0; i < tokenCount_; i++) {
+    out[pos] = tokens_[i].ticker;
+    writeU64(out + pos + 1, (uint64_t)tokens_[i].amountMicro);
+    writeU64(out + pos + 9, (uint64_t)tokens_[i].valueMicroUsd);
+    writeU32(out + pos + 17, (uint32_t)tokens_[i].change24hCentiPercent);
+    pos += TOKEN_SIZE;
+  }
+  for (int i = 0; i < nftCount_; i++) {
+    out[pos] = nfts_[i].name;
+    writeU32(out + pos + 1, nfts_[i].count);
+    writeU64(out + pos + 5, nfts_[i].floorLovelace);
+    pos += NFT_SIZE;
+  }
+
+  out[0] = 'C';
+  out[1] = 'T';
+  out[2] = SNAPSHOT_VERSION;
+  out[3] = 0;
+  writeU32(out + 4, generatedAt);
+  writeU32(out + 8,
+           snapshotHash(out + SNAPSHOT_HEADER_SIZE, size - SNAPSHOT_HEADER_SIZE));
+  writeU16(out + 12, (uint16_t)(size - SNAPSHOT_HEADER_SIZE));
+  out[14] = (uint8_t)tokenCount_;
+  out[15] = (uint8_t)nftCount_;
+  return size;
+}
@@ -0,0 +1,174 @@
+/**
+ * ticker_snapshot.h - Compact binary portfolio snapshot
+ *
+ * The MinSwap and Cexplorer JSON answers are many kilobytes, but the screens
+ * only show a handful of numbers and names. chain-gateway (repository root)
+ * can fetch and parse those answers once and send the ticker just what it
+ * draws, in this format. Decoding it needs no JSON library and no heap: the
+ * reader checks the whole snapshot once and then points into the buffer.
+ *
+ * Layout (all numbers little-endian):
+ *
+ *   Header, 16 bytes
+ *     0  'C' 'T'   magic
+ *     2  u8        version (SNAPSHOT_VERSION)
+ *     3  u8        flags (reserved, must be 0)
+ *     4  u32       generated at (Unix time, seconds, 0 if unknown)
+ *     8  u32       content hash (FNV-1a of everything after the header)
+ *    12  u16       payload length (bytes after the header)
+ *    14  u8        token count
+ *    15  u8        NFT collection count
+ *   Strings
+ *        u8        string count
+ *        per string: u8 length, bytes (UTF-8, no terminator)
+ *   Tokens, 21 bytes each
+ *        u8        ticker (string index)
+ *        i64       amount, millionths
+ *        i64       value in USD, millionths
+ *        i32       24h change, hundredths of a percent
+ *   NFT collections, 13 bytes each
+ *        u8        name (string index)
+ *        u32       NFTs owned
+ *        u64       floor price, lovelace
+ *
+ * Strings are interned: a name used twice ("Unknown NFT") is stored once.
+ * A reader must reject versions it does not know; a new field means a new
+ * version.
+ *
+ * Deltas turn a snapshot a device already has (the base) into a newer one.
+ * Between two updates usually only a few prices change, so a delta is a
+ * fraction of the snapshot size:
+ *
+ *     0  'C' 'D'   magic
+ *     2  u8        version (SNAPSHOT_VERSION)
+ *     3  u8        flags (reserved, must be 0)
+ *     4  u32       content hash of the base snapshot
+ *     8  u16       length of the new snapshot
+ *    10  u8        patch count
+ *        per patch: u16 offset, u8 length, bytes (written over the base)
+ *
+ * Applying a delta gives bytes that must still pass SnapshotReader::open(),
+ * whose content hash check catches a delta applied to the wrong base.
+ *
+ * This file has no Arduino dependencies, so chain-gateway builds the same
+ * code to write snapshots.
+ */
+
+#ifndef TICKER_SNAPSHOT_H
+#define TICKER_SNAPSHOT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SNAPSHOT_VERSION 1
+#define SNAPSHOT_HEADER_SIZE 16
+#define SNAPSHOT_MAX_ITEMS 8          // Tokens or NFT collections, as shown
+#define SNAPSHOT_MAX_STRINGS 16
+#define SNAPSHOT_MAX_STRING_LENGTH 32 // Longer names are cut (at a character)
+
+// Largest possible snapshot: header, every string at full length, all items
+#define SNAPSHOT_MAX_SIZE                                                     \
+  (SNAPSHOT_HEADER_SIZE + 1 +                                                 \
+   SNAPSHOT_MAX_STRINGS * (1 + SNAPSHOT_MAX_STRING_LENGTH) +                  \
+   SNAPSHOT_MAX_ITEMS * (21 + 13))
+
+// Text inside the snapshot buffer, not terminated
+struct SnapshotText {
+  const char *data;
+  uint8_t length;
+};
+
+struct SnapshotToken {
+  SnapshotText ticker;
+  int64_t amountMicro;
+  int64_t valueMicroUsd;
+  int32_t change24hCentiPercent;
+};
+
+struct SnapshotNft {
+  SnapshotText name;
+  uint32_t count;
+  uint64_t floorLovelace;
+};
+
+#define SNAPSHOT_DELTA_HEADER_SIZE 11
+
+// FNV-1a, 32 bits
+uint32_t snapshotHash(const uint8_t *data, size_t length);
+
+// Write the delta from base to target (both valid snapshots) to out.
+// Returns its size, or 0 if it does not fit in outSize.
+size_t snapshotDelta(const uint8_t *base, size_t baseLength,
+                     const uint8_t *target, size_t targetLength, uint8_t *out,
+                     size_t outSize);
+
+// Apply a delta to base, writing the new snapshot to out (which must not
+// overlap base). Returns its size, or 0 if the delta is malformed, was made
+// for a different base or does not fit. Check the result with
+// SnapshotReader::open() before using it.
+size_t applySnapshotDelta(const uint8_t *base, size_t baseLength,
+                          const uint8_t *delta, size_t deltaLength,
+                          uint8_t *out, size_t outSize);
+
+class SnapshotReader {
+public:
+  // Check the whole snapshot (magic, version, flags, hash, every length and
+  // string index). Returns false if anything is wrong; the reader is then
+  // empty.
+  // The buffer must stay unchanged while the reader is used.
+  bool open(const uint8_t *data, size_t length);
+
+  uint32_t generatedAt() const { return generatedAt_; }
+  uint32_t contentHash() const { return contentHash_; }
+  int tokenCount() const { return tokenCount_; }
+  int nftCount() const { return nftCount_; }
+
+  bool token(int index, SnapshotToken &out) const;
+  bool nft(int index, SnapshotNft &out) const;
+
+private:
+  SnapshotText text(uint8_t index) const;
+
+  const uint8_t *data_ = nullptr;
+  uint32_t generatedAt_ = 0;
+  uint32_t contentHash_ = 0;
+  int tokenCount_ = 0;
+  int nftCount_ = 0;
+  uint16_t strings_[SNAPSHOT_MAX_STRINGS] = {}; // Offsets of length bytes
+  size_t tokens_ = 0; // Offset of the first token
+  size_t nfts_ = 0;   // Offset of the first NFT collection
+};
+
+class SnapshotWriter {
+public:
+  // Returns false once SNAPSHOT_MAX_ITEMS items or SNAPSHOT_MAX_STRINGS
+  // distinct strings have been added
+  bool addToken(const char *ticker, int64_t amountMicro, int64_t valueMicroUsd,
+                int32_t change24hCentiPercent);
+  bool addNft(const char *name, uint32_t count, uint64_t floorLovelace);
+
+  // Write the snapshot to out (SNAPSHOT_MAX_SIZE bytes always fit).
+  // Returns the number of bytes written, or 0 if out is too small.
+  size_t finish(uint32_t generatedAt, uint8_t *out, size_t outSize) const;
+
+private:
+  bool intern(const char *text, uint8_t &index);
+
+  char strings_[SNAPSHOT_MAX_STRINGS][SNAPSHOT_MAX_STRING_LENGTH + 1] = {};
+  int stringCount_ = 0;
+  struct {
+    uint8_t ticker;
+    int64_t amountMicro;
+    int64_t valueMicroUsd;
+    int32_t change24hCentiPercent;
+  } tokens_[SNAPSHOT_MAX_ITEMS] = {};
+  int tokenCount_ = 0;
+  struct {
+    uint8_t name;
+    uint32_t count;
+    uint64_t floorLovelace;
+  } nfts_[SNAPSHOT_MAX_ITEMS] = {};
+  int nftCount_ = 0;
+};
+
+#endif
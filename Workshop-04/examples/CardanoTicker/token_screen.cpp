@@ -14,6 +14,7 @@
 
 #include "token_screen.h"
 #include "data_fetcher.h"
+#include "heap_profiler.h"
 #include "screen_helper.h"
 #include <TFT_eSPI.h>
 
@@ -27,6 +28,7 @@ extern TFT_eSPI tft;
  * Each row shows one token with its ticker, amount, value, and price change.
  */
 void drawTokenScreen() {
+  HEAP_SCOPE(HEAP_SCREENS, "token screen"); // See heap_profiler.h
   // Draw header with title and page indicator
   // activeIndex = 1 means this is the second screen (0-indexed)
   renderHeader("Token Positions", 1);
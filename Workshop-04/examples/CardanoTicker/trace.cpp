@@ -0,0 +1,139 @@
+/**
+ * trace.cpp - Implementation of the trace recorder
+ *
+ * Events go into a ring buffer taken from the heap by traceStart(). An event
+ * is a timestamp (micros()), the name pointer, a value (for counters) and
+ * the phase: 'B' begin, 'E' end, 'C' counter, 'i' instant, as in the Chrome
+ * trace-event format.
+ *
+ * When the ring keeps only the last events, the oldest spans may have lost
+ * their begin. traceDump() leaves out ends without a begin, so the viewer
+ * does not show broken spans.
+ */
+
+#include "trace.h"
+
+#include <stdlib.h>
+
+bool traceRecording = false;
+
+namespace {
+
+struct TraceEvent {
+  uint32_t micros;
+  const char *name;
+  int32_t value;
+  char phase;
+};
+
+TraceEvent *events = nullptr;
+size_t capacity = 0;
+size_t oldest = 0; // Index of the oldest event
+size_t count = 0;
+bool stopWhenFull = true;
+
+void printEvent(Print &out, const TraceEvent &event, uint32_t startMicros) {
+  out.print(",\n{\"name\":\"");
+  out.print(event.name);
+  out.print("\",\"ph\":\"");
+  out.print(event.phase);
+  out.print("\",\"ts\":");
+  // Unsigned difference: right across a micros() wrap-around too
+  out.print((unsigned long)(event.micros - startMicros));
+  out.print(",\"pid\":1,\"tid\":1");
+  if (event.phase == 'C') {
+    out.print(",\"args\":{\"value\":");
+    out.print((long)event.value);
+    out.print("}");
+  } else if (event.phase == 'i') {
+    out.print(",\"s\":\"t\""); // Instant on the thread's track
+  }
+  out.print("}");
+}
+
+} // namespace
+
+bool traceStart(size_t maxEvents, bool stopWhenFullMode) {
+  traceRecording = false;
+  if (maxEvents == 0) {
+    return false;
+  }
+  if (events == nullptr || capacity != maxEvents) {
+    traceFree();
+    events = (TraceEvent *)malloc(maxEvents * sizeof(TraceEvent));
+    if (events == nullptr) {
+      Serial.println("Trace: not enough memory");
+      return false;
+    }
+    capacity = maxEvents;
+  }
+  oldest = 0;
+  count = 0;
+  stopWhenFull = stopWhenFullMode;
+  traceRecording = true;
+  return true;
+}
+
+void traceStop() { traceRecording = false; }
+
+bool traceIsRecording() { return traceRecording; }
+
+size_t traceEventCount() { return count; }
+
+void traceFree() {
+  traceRecording = false;
+  free(events);
+  events = nullptr;
+  capacity = 0;
+  oldest = 0;
+  count = 0;
+}
+
+void traceRecord(char phase, const char *name, int32_t value) {
+  size_t slot;
+  if (count < capacity) {
+    slot = (oldest + count) % capacity;
+    count++;
+  } else if (stopWhenFull) {
+    traceRecording = false;
+    Serial.print("Trace: full with ");
+    Serial.print((unsigned long)count);
+    Serial.println(" events");
+    return;
+  } else {
+    slot = oldest; // Overwrite the oldest event
+    oldest = (oldest + 1) % capacity;
+  }
+  TraceEvent &event = events[slot];
+  event.micros = micros();
+  event.name = name;
+  event.value = value;
+  event.phase = phase;
+}
+
+size_t traceDump(Print &out) {
+  traceRecording = false;
+
+  out.print("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  out.print("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,"
+            "\"args\":{\"name\":\"loop()\"}}");
+
+  size_t written = 0;
+  int depth = 0; // Spans open at this point
+  const uint32_t startMicros = count > 0 ? events[oldest].micros : 0;
+  for (size_t i = 0; i < count; i++) {
+    const TraceEvent &event = events[(oldest + i) % capacity];
+    if (event.phase == 'E') {
+      if (depth == 0) {
+        continue; // Its begin was overwritten
+      }
+      depth--;
+    } else if (event.phase == 'B') {
+      depth++;
+    }
+    printEvent(out, event, startMicros);
+    written++;
+  }
+  out.print("\n]}\n");
+  return written;
+}
@@ -16,6 +16,7 @@
 #include "wallet_screen.h"
 #include "config.h"
 #include "data_fetcher.h"
+#include "heap_profiler.h"
 #include "screen_helper.h"
 #include <TFT_eSPI.h>
 
@@ -29,6 +30,7 @@ extern TFT_eSPI tft;
  * prominently, along with your stake address and last update time.
  */
 void drawWalletScreen() {
+  HEAP_SCOPE(HEAP_SCREENS, "wallet screen"); // See heap_profiler.h
   // Draw header with title and page indicator
   // activeIndex = 0 means this is the first screen
   renderHeader("Wallet", 0);
@@ -74,13 +76,16 @@ void drawWalletScreen() {
   // Get timestamp of when balance was last fetched
   const unsigned long lastFetch = getLastKoiosFetchTime();
   
-  if (lastFetch == 0) {
+  if (lastFetch == 0 && isShowingSavedData()) {
+    // Not fetched yet, but saved before the device restarted
+    tft.print("before restart");
+  } else if (lastFetch == 0) {
     // Never fetched (device just started or WiFi not connected yet)
     tft.print("Never");
   } else {
     // Calculate time difference
     const unsigned long now = millis();  // Current time
-    const unsigned long diffMs = now - lastFetch;  // Difference in milliseconds
+    const unsigned long diffMs = (uint32_t)(now - lastFetch);  // Difference in milliseconds
     const unsigned long diffSec = diffMs / 1000UL;  // Convert to seconds
 
     // Format time difference in human-readable way
@@ -6,6 +6,14 @@
 #include "web_server.h"   // HTTP web server for serving files
 #include "wifi_manager.h" // WiFi connection management
 
+// Called by the WiFi manager the moment WiFi comes back or goes away
+void onWifiChange(bool connected) {
+  // If WiFi connected after setup() gave up waiting, start the server now
+  if (connected && !webServerIsRunning()) {
+    webServerSetup();
+  }
+}
+
 void setup() {
   // Initialize serial communication for debugging
   // Serial communication lets us send messages to the computer via USB
@@ -44,6 +52,9 @@ void setup() {
   } else {
     Serial.println("WiFi connection failed - web server not started");
   }
+
+  // From now on, react to WiFi coming back instead of checking every loop()
+  wifiManagerSubscribe(onWifiChange);
 }
 
 void loop() {
@@ -52,11 +63,7 @@ void loop() {
   wifiManagerLoop();
 
   // Handle web server requests (runs asynchronously, but we call loop for
-  // consistency)
-  if (wifiManagerIsConnected() && !webServerIsRunning()) {
-    // If WiFi just reconnected, start the server
-    webServerSetup();
-  }
+  // consistency). onWifiChange() starts the server when WiFi comes back.
   webServerLoop();
 }
 
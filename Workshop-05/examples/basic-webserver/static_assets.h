@@ -0,0 +1,47 @@
+// static_assets.h - Web interface files compressed into the firmware
+//
+// GENERATED by Workshop-05/tools/embed_assets.py from data/ - do not edit.
+// Run the script again after changing anything in data/.
+
+#ifndef STATIC_ASSETS_H
+#define STATIC_ASSETS_H
+
+#include <Arduino.h>
+
+struct StaticAsset {
+  const char *path;         // URL path, e.g. "/index.html"
+  const char *contentType;  // MIME type of the uncompressed file
+  const char *etag;         // Quoted hash of the file contents
+  const char *cacheControl; // Cache-Control header value
+  const uint8_t *data;      // Gzip-compressed file
+  size_t length;            // Compressed size in bytes
+  size_t originalLength;    // Uncompressed size in bytes
+};
+
+// /index.html: 328 bytes, 240 gzipped
+static const uint8_t ASSET_INDEX_HTML[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x5d, 0x50, 0x3d, 0x4f, 0xc4, 0x30,
+    0x0c, 0xdd, 0xfb, 0x2b, 0x7c, 0x59, 0x58, 0xe8, 0x95, 0xdb, 0x18, 0x92, 0x2c, 0x07, 0xe8, 0x06,
+    0x10, 0x0c, 0x45, 0x88, 0x31, 0x6d, 0xac, 0x4b, 0x24, 0xe7, 0x43, 0x49, 0x68, 0xd5, 0x7f, 0x4f,
+    0xda, 0x82, 0x84, 0xb0, 0x2c, 0x59, 0x7e, 0xcf, 0xcf, 0xcf, 0x32, 0x3f, 0x3c, 0xbc, 0x9e, 0xfb,
+    0xcf, 0xb7, 0x47, 0x30, 0xc5, 0x91, 0x6c, 0xf8, 0x5a, 0x80, 0x94, 0xbf, 0x0a, 0x86, 0x9e, 0xc9,
+    0xa6, 0x22, 0xa8, 0xb4, 0x6c, 0xa0, 0x06, 0x77, 0x58, 0x14, 0x8c, 0x46, 0xa5, 0x8c, 0x45, 0xb0,
+    0xf7, 0xfe, 0xa9, 0xbd, 0x67, 0x7f, 0x29, 0xaf, 0x1c, 0x0a, 0x36, 0x59, 0x9c, 0x63, 0x48, 0x85,
+    0x6d, 0xcc, 0x1e, 0x63, 0xf0, 0x05, 0x7d, 0x15, 0xcd, 0x56, 0x17, 0x23, 0x34, 0x4e, 0x76, 0xc4,
+    0x76, 0x6b, 0x6e, 0xc1, 0x7a, 0x5b, 0xac, 0xa2, 0x36, 0x8f, 0x8a, 0x50, 0x9c, 0x8e, 0x77, 0xbf,
+    0x4b, 0x8b, 0x2d, 0x84, 0xf2, 0x82, 0x44, 0x01, 0x3e, 0x42, 0x22, 0x7d, 0xe0, 0xdd, 0x8e, 0x35,
+    0xbc, 0xdb, 0xef, 0x6a, 0xf8, 0x10, 0xf4, 0x52, 0xeb, 0x26, 0x30, 0xa7, 0x7f, 0xd3, 0x15, 0xd8,
+    0x99, 0x28, 0x7b, 0x63, 0x33, 0xd4, 0x54, 0x90, 0xad, 0x8b, 0x84, 0x70, 0xe9, 0x5f, 0x9e, 0x21,
+    0xaa, 0x2b, 0x42, 0xc6, 0x34, 0xa1, 0x86, 0x61, 0x81, 0x25, 0x7c, 0x25, 0x70, 0x76, 0x4c, 0x61,
+    0xbd, 0x38, 0x05, 0x22, 0x4c, 0x37, 0x19, 0x66, 0x1c, 0xf6, 0xa1, 0x74, 0xe4, 0x5d, 0x5c, 0x5d,
+    0xbb, 0x1f, 0xdb, 0x6a, 0xb1, 0x3e, 0xee, 0x1b, 0x6b, 0x17, 0xfb, 0x27, 0x48, 0x01, 0x00, 0x00,
+};
+
+static const StaticAsset STATIC_ASSETS[] = {
+    {"/index.html", "text/html", "\"3a6a59653d389602\"", "no-cache", ASSET_INDEX_HTML, 240, 328},
+};
+
+static const size_t STATIC_ASSET_COUNT =
+    sizeof(STATIC_ASSETS) / sizeof(STATIC_ASSETS[0]);
+
+#endif
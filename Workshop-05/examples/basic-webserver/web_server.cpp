@@ -1,4 +1,5 @@
 #include "web_server.h"
+#include "static_assets.h"
 #include <LittleFS.h>
 #include <WebServer.h>
 #include <WiFi.h>
@@ -8,8 +9,36 @@ WebServer server(80);       // Web server on port 80
 bool serverStarted = false; // Flag to check if server is started
 
 // Get MIME type for HTML files
+// Only used for files that are not embedded in static_assets.h
 String getContentType(String filename) { return "text/html"; }
 
+// Find the embedded web page file for a URL path
+// Returns nullptr if the path is not in static_assets.h
+const StaticAsset *findStaticAsset(const String &path) {
+  for (size_t i = 0; i < STATIC_ASSET_COUNT; i++) {
+    if (path == STATIC_ASSETS[i].path) {
+      return &STATIC_ASSETS[i];
+    }
+  }
+  return nullptr;
+}
+
+// Send an embedded file, already gzipped, straight from flash
+// If the browser sends the ETag of the copy it has cached, only a 304 Not
+// Modified goes back and the file is not sent again.
+void sendStaticAsset(const StaticAsset &asset) {
+  server.sendHeader("ETag", asset.etag);
+  server.sendHeader("Cache-Control", asset.cacheControl);
+
+  if (server.header("If-None-Match") == asset.etag) {
+    server.send(304);
+    return;
+  }
+
+  server.sendHeader("Content-Encoding", "gzip");
+  server.send_P(200, asset.contentType, (PGM_P)asset.data, asset.length);
+}
+
 // Handle file requests
 void handleFileRequest() {
   String path = server.uri();
@@ -24,7 +53,16 @@ void handleFileRequest() {
     path = "/" + path;
   }
 
-  // Check if file exists in LittleFS
+  // Pages compiled into the firmware (see static_assets.h)
+  const StaticAsset *asset = findStaticAsset(path);
+  if (asset != nullptr) {
+    sendStaticAsset(*asset);
+    Serial.print("Served asset: ");
+    Serial.println(path);
+    return;
+  }
+
+  // Any other file uploaded to LittleFS
   if (LittleFS.exists(path)) {
     String contentType = getContentType(path);
     File file = LittleFS.open(path, "r");
@@ -38,24 +76,20 @@ void handleFileRequest() {
       Serial.print("Error opening file: ");
       Serial.println(path);
     }
+    return;
+  }
+
+  // File not found - serve index.html as fallback
+  const StaticAsset *index = findStaticAsset("/index.html");
+  if (index != nullptr) {
+    sendStaticAsset(*index);
+    Serial.print("File not found, serving index.html: ");
+    Serial.println(path);
   } else {
-    // File not found - try index.html as fallback
-    if (path != "/index.html" && LittleFS.exists("/index.html")) {
-      File file = LittleFS.open("/index.html", "r");
-      if (file) {
-        server.streamFile(file, "text/html");
-        file.close();
-        Serial.print("File not found, serving index.html: ");
-        Serial.println(path);
-      } else {
-        server.send(404, "text/plain", "File not found");
-      }
-    } else {
-      // 404 Not Found
-      server.send(404, "text/plain", "File not found");
-      Serial.print("404 - File not found: ");
-      Serial.println(path);
-    }
+    // 404 Not Found
+    server.send(404, "text/plain", "File not found");
+    Serial.print("404 - File not found: ");
+    Serial.println(path);
   }
 }
 } // namespace
@@ -84,6 +118,10 @@ void webServerSetup() {
   // Serve files from root and all subdirectories
   server.onNotFound(handleFileRequest);
 
+  // Keep the header browsers use to ask if their cached copy is still current
+  const char *headerKeys[] = {"If-None-Match"};
+  server.collectHeaders(headerKeys, 1);
+
   // Start the server
   server.begin();
   serverStarted = true;
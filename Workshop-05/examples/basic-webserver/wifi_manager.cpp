@@ -2,12 +2,55 @@
  * wifi_manager.cpp - WiFi connection management implementation
  *
  * This file implements WiFi connection management with automatic reconnection.
- * It stores WiFi credentials and periodically attempts to connect or reconnect
- * if the connection is lost.
+ * It stores WiFi credentials and attempts to connect or reconnect if the
+ * connection is lost.
+ *
+ * Instead of calling WiFi.status() on every loop() pass, it registers a
+ * handler for the ESP32's WiFi events ("got IP", "disconnected"). The
+ * handler runs in the ESP32's own event task, so it only writes down what
+ * happened; wifiManagerLoop() then updates the state and calls the
+ * subscribers from loop().
+ *
+ * Connecting the usual way takes several seconds: the ESP32 scans every
+ * channel for the network, then asks the router's DHCP server for an IP
+ * address. Once connected, we save the router's BSSID (its MAC address),
+ * the channel and the IP settings in NVS (flash that keeps its contents
+ * without power). The next attempt - after a reboot or a dropout - asks
+ * for that router on that channel, which skips the scan. After a dropout
+ * it also sets the IP address directly, which skips DHCP - but only for a
+ * while: the router lends us the address for a limited time (the lease),
+ * and only DHCP renews it. After a restart we cannot tell how long the
+ * ESP32 was off, so the first attempt asks DHCP again.
+ *
+ * If a fast attempt does not work within 3 seconds, either the router is
+ * switched off or it moved to another channel. Right after boot a move is
+ * likely (the ticker may have been in a drawer for weeks), so the next
+ * attempt scans right away and every other attempt after that scans too.
+ * After a dropout the router is almost always the same one coming back, so
+ * we keep trying it and only every sixth attempt scans: a scan that is
+ * running when the router comes back costs several seconds.
+ *
+ * With several networks (or one network with several routers), a scan
+ * lists every router in range and we pick the best one ourselves. "Best"
+ * is the strongest signal, minus a penalty for routers through which the
+ * APIs answered slowly or not at all: the firmware reports every request
+ * with wifiManagerRequestStarted() and wifiManagerRequestFinished(), and we
+ * keep an average for each router. While connected, we check the link
+ * every 2 seconds. When it is bad (weak signal, slow or failing requests),
+ * we scan in the background - the connection stays up while scanning - and
+ * switch to a router that is clearly better, but only once no request has
+ * run for a few seconds, so a switch never cuts a fetch in half.
+ *
+ * Times are millis() values. Differences between them are taken as
+ * uint32_t, the width of millis() on the ESP32, so they stay right when
+ * millis() wraps to 0 after 49.7 days, in host builds as well.
  */
 
 #include "wifi_manager.h"
+#include <Preferences.h> // NVS storage for the remembered network
 #include <WiFi.h>
+#include <atomic>
+#include <string.h>
 
 namespace {
 // Time to wait between reconnection attempts (5 seconds)
@@ -18,92 +61,881 @@ const unsigned long WIFI_RETRY_INTERVAL_MS = 5000;
 // If connection takes longer than this, we assume it failed and retry
 const unsigned long WIFI_CONNECT_TIMEOUT_MS = 12000;
 
+// A fast attempt normally connects in well under a second, so after 3
+// seconds we give up on it. Asking DHCP adds one or two seconds.
+const unsigned long WIFI_FAST_CONNECT_TIMEOUT_MS = 3000;
+const unsigned long WIFI_FAST_DHCP_TIMEOUT_MS = 5000;
+
+// How long after DHCP last had our address we may keep using it without
+// asking. Routers lend addresses for 1 to 24 hours and the ESP32 renews at
+// half time, so at least 30 minutes are left when we stop renewing. After
+// that a connection on the reused address connects again with DHCP.
+const unsigned long WIFI_LEASE_REUSE_MS = 1800000; // 30 minutes
+
+// After a dropout, every this many failed attempts, the next one scans
+const int WIFI_SCAN_EVERY_ATTEMPTS = 6;
+
+// How often the link is checked while connected
+const unsigned long WIFI_QUALITY_INTERVAL_MS = 2000;
+
+// The link is bad with a weaker signal (dBm), slower answers (average, ms)
+// or more requests without an answer (percent) than this
+const int WIFI_WEAK_RSSI_DBM = -72;
+const unsigned long WIFI_SLOW_RESPONSE_MS = 1500;
+const int WIFI_FAILING_PERCENT = 15;
+
+// While the link is bad, scan for a better router at most this often. Each
+// scan that finds nothing better doubles the wait, up to the maximum.
+const unsigned long WIFI_ROAM_SCAN_INTERVAL_MS = 30000;
+const unsigned long WIFI_ROAM_SCAN_MAX_INTERVAL_MS = 480000; // 8 minutes
+
+// Only switch routers when no request finished for this long (a fetch of
+// several requests in a row is over)
+const unsigned long WIFI_ROAM_QUIET_MS = 2000;
+
+// Another router must score this much better (in dB) to switch to it, so
+// two similar routers don't make us switch back and forth
+const int WIFI_ROAM_MARGIN_DB = 8;
+
+// Each 50 ms of slower answers than the fastest router costs 1 dB of score
+const unsigned long WIFI_RESPONSE_MS_PER_DB = 50;
+
+// What we measured through a router is forgotten this long after we left
+// it: by then the device may have moved, or the router's load changed
+const unsigned long WIFI_ROUTER_STATS_MAX_AGE_MS = 600000; // 10 minutes
+
+// Where the remembered network is stored in NVS
+const char *CACHE_NAMESPACE = "wifimgr";
+const char *CACHE_KEY = "network";
+const uint8_t CACHE_VERSION = 1;
+
+// The network we last connected to, as stored in NVS (one 28-byte entry)
+struct NetworkCache {
+  uint8_t version;   // CACHE_VERSION
+  uint8_t channel;   // WiFi channel of the router (1-14)
+  uint8_t bssid[6];  // MAC address of the router
+  uint32_t ssidHash; // Credentials it belongs to (new ones ignore it)
+  uint32_t ip;       // IP settings the router gave us
+  uint32_t gateway;
+  uint32_t subnet;
+  uint32_t dns;
+};
+
+// A router we have seen in a scan or been connected to
+struct Router {
+  bool used;                // This entry is taken
+  bool inLastScan;          // Seen by the latest scan
+  uint8_t bssid[6];         // MAC address of the router
+  uint8_t channel;          // WiFi channel (1-14)
+  int network;              // Index in networks[]
+  int rssi;                 // Signal strength last seen (dBm)
+  unsigned long seenMs;     // When rssi was seen
+  unsigned long responseMs; // Average answer time through it, 0 = unknown
+  int failurePercent;       // Average share of requests without answer
+  unsigned long usedMs;     // When we were last connected through it
+};
+
 // Stored WiFi credentials (set by wifiManagerSetup)
-const char *storedSsid = nullptr;
-const char *storedPassword = nullptr;
+WifiNetwork networks[WIFI_MAX_NETWORKS];
+int networkCount = 0;
 
 // Timestamp of the last connection attempt
 // Used to implement retry intervals and connection timeouts
 unsigned long lastAttemptMs = 0;
 
+// The remembered network, valid if haveCache
+NetworkCache cache;
+bool haveCache = false;
+int cacheNetwork = 0;     // Index in networks[] the cache belongs to
+bool fastAttempt = false; // The current attempt uses the cache
+bool staticIp = false;    // The current attempt or link reuses cache.ip
+
+// DHCP gave or renewed our address at leaseSeenMs, this boot. The ESP32's
+// clock does not run while it is off, so a lease from before a restart has
+// an unknown age and is not reused.
+bool leaseKnown = false;
+unsigned long leaseSeenMs = 0;
+int failedAttempts = 0;   // Attempts that timed out since the last connect
+bool connectedSinceSetup = false;
+
+// The routers we know, and the one in use
+Router routers[WIFI_MAX_ROUTERS];
+int attemptNetwork = -1; // Network of the current attempt
+int currentRouter = -1;  // Index in routers[] while connected
+bool connectScanning = false; // A full attempt is waiting for its scan
+bool unknownHidden = false;   // The last scan saw a hidden router we don't know
+
+// Link quality and roaming (only used from loop())
+bool roamingEnabled = true;
+bool roamScanning = false;      // Looking for a better router
+unsigned long lastQualityMs = 0;
+unsigned long lastRoamScanMs = 0;
+bool roamScanDone = false; // lastRoamScanMs is valid
+unsigned long roamScanIntervalMs = WIFI_ROAM_SCAN_INTERVAL_MS;
+int rssiAverage = 0;       // Of the current router, 0 = no sample yet
+
+// Written by the event handler (ESP32 event task), read by loop()
+std::atomic<bool> eventHasIp(false);     // Latest "got IP" or "lost it"
+std::atomic<uint32_t> eventLostCount(0); // Bumped every time it is lost
+uint32_t handledLostCount = 0;           // eventLostCount loop() has seen
+
+// Written by whichever task makes a request, read by loop()
+std::atomic<int> requestsRunning(0);
+std::atomic<uint32_t> reportedRequests(0);
+std::atomic<uint32_t> reportedFailures(0);
+std::atomic<uint32_t> reportedAnswerMs(0); // Added up, answered ones only
+std::atomic<unsigned long> lastRequestEndMs(0);
+
+// Only used from loop()
+WifiState state = WIFI_STATE_IDLE;
+WifiLinkCallback subscribers[WIFI_MAX_SUBSCRIBERS] = {};
+int subscriberCount = 0;
+WifiStats stats;
+unsigned long setupMs = 0;    // When wifiManagerSetup() was called
+unsigned long linkLostMs = 0; // When the current outage started
+bool eventsRegistered = false;
+
+/**
+ * WiFi event handler
+ *
+ * Runs in the ESP32's event task, not in loop(): it must be quick and must
+ * not touch anything loop() uses, except the atomic variables above.
+ */
+void onWifiEvent(arduino_event_id_t event) {
+  switch (event) {
+  case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+    eventHasIp.store(true);
+    break;
+  case ARDUINO_EVENT_WIFI_STA_LOST_IP:
+  case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+    eventHasIp.store(false);
+    eventLostCount.fetch_add(1);
+    break;
+  default:
+    break;
+  }
+}
+
+// FNV-1a hash of a network's credentials, to tell whether the cache is
+// theirs
+uint32_t credentialsHash(const WifiNetwork &network) {
+  uint32_t hash = 2166136261UL;
+  for (const char *text : {network.ssid, "\n", network.password}) {
+    for (const char *c = text; c != nullptr && *c != '\0'; c++) {
+      hash = (hash ^ (uint8_t)*c) * 16777619UL;
+    }
+  }
+  return hash;
+}
+
+// Read the remembered network from NVS
+void loadCache() {
+  Preferences preferences;
+  preferences.begin(CACHE_NAMESPACE, true); // Read-only
+  NetworkCache stored;
+  const size_t length =
+      preferences.getBytes(CACHE_KEY, &stored, sizeof(stored));
+  preferences.end();
+  haveCache = false;
+  if (length != sizeof(stored) || stored.version != CACHE_VERSION ||
+      stored.channel < 1 || stored.channel > 14 || stored.ip == 0) {
+    return;
+  }
+  for (int i = 0; i < networkCount; i++) {
+    if (stored.ssidHash == credentialsHash(networks[i])) {
+      cache = stored;
+      cacheNetwork = i;
+      haveCache = true;
+    }
+  }
+}
+
+// Remember the network we are connected to. Flash wears out with writes,
+// so NVS is only written when something changed.
+void saveCache() {
+  NetworkCache current;
+  memset(&current, 0, sizeof(current)); // No random bytes in the padding
+  current.version = CACHE_VERSION;
+  current.channel = (uint8_t)WiFi.channel();
+  const uint8_t *bssid = WiFi.BSSID();
+  if (bssid == nullptr || attemptNetwork < 0) {
+    return;
+  }
+  memcpy(current.bssid, bssid, sizeof(current.bssid));
+  current.ssidHash = credentialsHash(networks[attemptNetwork]);
+  current.ip = (uint32_t)WiFi.localIP();
+  current.gateway = (uint32_t)WiFi.gatewayIP();
+  current.subnet = (uint32_t)WiFi.subnetMask();
+  current.dns = (uint32_t)WiFi.dnsIP();
+  if (haveCache && memcmp(&current, &cache, sizeof(cache)) == 0) {
+    return; // Same router, same address
+  }
+
+  Preferences preferences;
+  preferences.begin(CACHE_NAMESPACE, false);
+  preferences.putBytes(CACHE_KEY, &current, sizeof(current));
+  preferences.end();
+  cache = current;
+  cacheNetwork = attemptNetwork;
+  haveCache = true;
+  Serial.print("WiFi: remembered router on channel ");
+  Serial.println(current.channel);
+}
+
+// Histogram bucket for a time to connect (see WIFI_CONNECT_BUCKETS)
+int connectBucket(unsigned long ms) {
+  const unsigned long limits[WIFI_CONNECT_BUCKETS - 1] = {250,  500,  1000,
+                                                          2000, 5000, 10000};
+  int bucket = 0;
+  while (bucket < WIFI_CONNECT_BUCKETS - 1 && ms > limits[bucket]) {
+    bucket++;
+  }
+  return bucket;
+}
+
+// Find a router in the table, or add it (replacing the one seen longest
+// ago when the table is full). Returns its index.
+int routerEntry(const uint8_t *bssid, int channel, int network,
+                unsigned long now) {
+  for (int i = 0; i < WIFI_MAX_ROUTERS; i++) {
+    const Router &router = routers[i];
+    if (router.used && router.channel == channel &&
+        router.network == network && memcmp(router.bssid, bssid, 6) == 0) {
+      return i;
+    }
+  }
+  int free = -1;
+  for (int i = 0; i < WIFI_MAX_ROUTERS; i++) {
+    if (i == currentRouter) {
+      continue; // Never the one we are using
+    }
+    if (!routers[i].used) {
+      free = i;
+      break;
+    }
+    if (free < 0 || routers[i].seenMs < routers[free].seenMs) {
+      free = i;
+    }
+  }
+  Router &router = routers[free];
+  memset(&router, 0, sizeof(router));
+  router.used = true;
+  memcpy(router.bssid, bssid, 6);
+  router.channel = (uint8_t)channel;
+  router.network = network;
+  router.seenMs = now;
+  return free;
+}
+
+// Which configured network has this SSID, or -1
+int networkIndex(const String &ssid) {
+  for (int i = 0; i < networkCount; i++) {
+    if (ssid == networks[i].ssid) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// The router in the table with this BSSID and channel, or -1
+int knownRouter(const uint8_t *bssid, int channel) {
+  for (int i = 0; i < WIFI_MAX_ROUTERS; i++) {
+    const Router &router = routers[i];
+    if (router.used && router.channel == channel &&
+        memcmp(router.bssid, bssid, 6) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// Put the routers of the finished scan into the table. A hidden router
+// (empty SSID) is ours if we were connected to it before.
+void recordScan(int count, unsigned long now) {
+  for (int i = 0; i < WIFI_MAX_ROUTERS; i++) {
+    Router &router = routers[i];
+    router.inLastScan = false;
+    if (i != currentRouter &&
+        (uint32_t)(now - router.usedMs) >= WIFI_ROUTER_STATS_MAX_AGE_MS) {
+      router.responseMs = 0; // Unknown again
+      router.failurePercent = 0;
+    }
+  }
+  unknownHidden = false;
+  for (int i = 0; i < count; i++) {
+    const String ssid = WiFi.SSID(i);
+    const uint8_t *bssid = WiFi.BSSID(i);
+    if (bssid == nullptr) {
+      continue;
+    }
+    int network = networkIndex(ssid);
+    if (ssid.length() == 0) {
+      const int known = knownRouter(bssid, WiFi.channel(i));
+      network = known >= 0 ? routers[known].network : -1;
+      unknownHidden = unknownHidden || known < 0;
+    }
+    if (network < 0) {
+      continue; // Not one of ours
+    }
+    Router &router = routers[routerEntry(bssid, WiFi.channel(i), network, now)];
+    router.rssi = WiFi.RSSI(i);
+    router.seenMs = now;
+    router.inLastScan = true;
+  }
+  WiFi.scanDelete(); // Free the scan results
+}
+
+// How good a router is, in dB: its signal, minus penalties for slow and
+// unanswered requests through it
+int routerScore(const Router &router) {
+  unsigned long fastest = 0;
+  for (int i = 0; i < WIFI_MAX_ROUTERS; i++) {
+    const unsigned long ms = routers[i].used ? routers[i].responseMs : 0;
+    if (ms > 0 && (fastest == 0 || ms < fastest)) {
+      fastest = ms;
+    }
+  }
+  int score = router.rssi - router.failurePercent / 2;
+  if (router.responseMs > fastest) {
+    score -= (int)((router.responseMs - fastest) / WIFI_RESPONSE_MS_PER_DB);
+  }
+  return score;
+}
+
+// The best router of the last scan, or -1
+int bestRouter() {
+  int best = -1;
+  for (int i = 0; i < WIFI_MAX_ROUTERS; i++) {
+    if (routers[i].used && routers[i].inLastScan &&
+        (best < 0 || routerScore(routers[i]) > routerScore(routers[best]))) {
+      best = i;
+    }
+  }
+  return best;
+}
+
+// May the next attempt reuse the remembered address instead of asking DHCP?
+bool leaseFresh(unsigned long now) {
+  return leaseKnown && (uint32_t)(now - leaseSeenMs) < WIFI_LEASE_REUSE_MS;
+}
+
+// Take in the requests reported since the last check. Without a current
+// router (during an outage) they only count in the statistics.
+void collectReports() {
+  const uint32_t requests = reportedRequests.exchange(0);
+  const uint32_t failures = reportedFailures.exchange(0);
+  const uint32_t answerMs = reportedAnswerMs.exchange(0);
+  if (requests == 0) {
+    return;
+  }
+  stats.requests += requests;
+  stats.requestFailures += failures;
+  if (currentRouter < 0) {
+    return;
+  }
+  // Averages that follow changes within a few requests: 7/8 old, 1/8 new
+  Router &router = routers[currentRouter];
+  if (requests > failures) {
+    const unsigned long average = answerMs / (requests - failures);
+    router.responseMs = router.responseMs == 0
+                            ? average
+                            : (7 * router.responseMs + average) / 8;
+  }
+  for (uint32_t i = 0; i < requests; i++) {
+    const int failed = i < failures ? 100 : 0;
+    router.failurePercent = (7 * router.failurePercent + failed) / 8;
+  }
+}
+
+// Tell every subscriber about a change
+void notifySubscribers(bool connected) {
+  for (int i = 0; i < subscriberCount; i++) {
+    subscribers[i](connected);
+  }
+}
+
+// The connection is up: update the statistics and tell the subscribers
+void linkUp(unsigned long now) {
+  state = WIFI_STATE_CONNECTED;
+  stats.connects++;
+  stats.lastConnectMs = (uint32_t)(now - lastAttemptMs);
+  stats.connectTimeHistogram[connectBucket(stats.lastConnectMs)]++;
+  if (fastAttempt) {
+    stats.fastConnects++;
+  } else {
+    stats.fullConnects++;
+  }
+  Serial.print(fastAttempt ? "WiFi: fast connect took "
+                            : "WiFi: connect took ");
+  Serial.print(stats.lastConnectMs);
+  Serial.println(" ms");
+  failedAttempts = 0;
+  connectedSinceSetup = true;
+  if (!staticIp) {
+    leaseKnown = true; // DHCP just gave us the address
+    leaseSeenMs = now;
+  }
+  saveCache();
+
+  // Start judging the link of this router afresh
+  collectReports(); // Made during the outage
+  const uint8_t *bssid = WiFi.BSSID();
+  currentRouter = bssid != nullptr && attemptNetwork >= 0
+                      ? routerEntry(bssid, WiFi.channel(), attemptNetwork, now)
+                      : -1;
+  rssiAverage = 0;
+  roamScanIntervalMs = WIFI_ROAM_SCAN_INTERVAL_MS;
+  lastQualityMs = now;
+
+  if (stats.connects == 1) {
+    stats.firstConnectMs = (uint32_t)(now - setupMs);
+    Serial.print("WiFi: connected after ");
+    Serial.print(stats.firstConnectMs);
+    Serial.println(" ms");
+  } else {
+    const unsigned long outage = (uint32_t)(now - linkLostMs);
+    stats.lastOutageMs = outage;
+    stats.totalOutageMs += outage;
+    if (outage > stats.longestOutageMs) {
+      stats.longestOutageMs = outage;
+    }
+    Serial.print("WiFi: reconnected after ");
+    Serial.print(outage);
+    Serial.println(" ms offline");
+  }
+  notifySubscribers(true);
+}
+
+// The connection is gone: start timing the outage and tell the subscribers
+void linkDown(unsigned long now) {
+  state = WIFI_STATE_WAITING;
+  stats.disconnects++;
+  linkLostMs = now;
+  currentRouter = -1;
+  if (!staticIp) {
+    leaseSeenMs = now; // DHCP kept renewing it until now
+  }
+  if (roamScanning) {
+    WiFi.scanDelete();
+    roamScanning = false;
+  }
+  Serial.println("WiFi: connection lost");
+  notifySubscribers(false);
+}
+
+// Connect to one router on its channel (no scan), or without a BSSID to
+// the strongest router of the network (the ESP32 scans for it). With
+// staticIp, reuse the remembered IP settings (no DHCP).
+void beginRouter(int network, int channel, const uint8_t *bssid,
+                 bool useStaticIp) {
+  attemptNetwork = network;
+  staticIp = useStaticIp;
+  if (staticIp) {
+    // The same IP settings as last time
+    WiFi.config(IPAddress(cache.ip), IPAddress(cache.gateway),
+                IPAddress(cache.subnet), IPAddress(cache.dns));
+  } else {
+    // Ask DHCP for an address (0.0.0.0 = DHCP)
+    WiFi.config(IPAddress(), IPAddress(), IPAddress());
+  }
+  WiFi.begin(networks[network].ssid, networks[network].password, channel,
+             bssid);
+}
+
+// A full attempt's scan finished: connect to the best router in range
+void connectAfterScan(int count, unsigned long now) {
+  connectScanning = false;
+  recordScan(count, now);
+  const int best = bestRouter();
+  if (best < 0 && !unknownHidden) {
+    // Nothing of ours in range: this attempt failed, retry later
+    Serial.println("WiFi: no configured network in range");
+    failedAttempts++;
+    state = WIFI_STATE_WAITING;
+    return;
+  }
+  if (best < 0) {
+    // A hidden router (no SSID in its beacons) may be one of ours. Ask for
+    // a configured network by name: the ESP32 then probes for it on every
+    // channel. Each failed attempt asks for the next one.
+    const int network = failedAttempts % networkCount;
+    Serial.print("WiFi: none in the scan, looking for hidden network ");
+    Serial.println(networks[network].ssid);
+    beginRouter(network, 0, nullptr, false);
+    return;
+  }
+  const Router &router = routers[best];
+  Serial.print("WiFi: connecting to ");
+  Serial.print(networks[router.network].ssid);
+  Serial.print(" on channel ");
+  Serial.print(router.channel);
+  Serial.print(" (");
+  Serial.print(router.rssi);
+  Serial.println(" dBm)");
+  beginRouter(router.network, router.channel, router.bssid, false);
+}
+
+// Should the next attempt scan instead of using the remembered router?
+bool scanDue() {
+  if (!haveCache) {
+    return true; // Nothing remembered yet
+  }
+  if (failedAttempts == 0) {
+    return false;
+  }
+  if (!connectedSinceSetup) {
+    return failedAttempts % 2 == 1; // Booting: scan, fast, scan, ...
+  }
+  return failedAttempts % WIFI_SCAN_EVERY_ATTEMPTS == 0;
+}
+
+/**
+ * Disconnect from the current router
+ *
+ * The "got IP" of the old link is forgotten here: until the "disconnected"
+ * event comes in, loop() would otherwise see it and report the new attempt
+ * as connected. Losses seen so far belong to the old link too.
+ */
+void disconnectRouter() {
+  eventHasIp.store(false);
+  handledLostCount = eventLostCount.load();
+  WiFi.disconnect();
+}
+
 /**
  * Attempt to connect to WiFi
  *
- * Disconnects any existing connection, sets WiFi to station mode,
- * and begins connection with stored credentials.
+ * Disconnects any existing connection, sets WiFi to station mode, and
+ * connects to the remembered router with the remembered IP settings if
+ * there are any - unless scanDue() says to scan. A scan is started in the
+ * background, and wifiManagerLoop() connects to the best router it finds,
+ * or asks for a network by name if it only finds hidden ones.
  *
  * @param force If true, attempts connection immediately regardless of retry
  * interval
  */
 void attemptConnection(bool force) {
-  // Don't attempt connection if SSID is not set or empty
-  if (storedSsid == nullptr || storedSsid[0] == '\0') {
+  // Don't attempt connection if no network is set
+  if (networkCount == 0) {
     return;
   }
 
   const unsigned long now = millis();
   // Respect retry interval unless forced (e.g., initial setup)
-  if (!force && (now - lastAttemptMs) < WIFI_RETRY_INTERVAL_MS) {
+  if (!force && (uint32_t)(now - lastAttemptMs) < WIFI_RETRY_INTERVAL_MS) {
     return;
   }
 
   lastAttemptMs = now;
+  state = WIFI_STATE_CONNECTING;
+  fastAttempt = !scanDue();
 
-  Serial.print("WiFi: connecting to ");
-  Serial.println(storedSsid);
-
-  // Disconnect any existing connection and clear stored credentials
-  WiFi.disconnect(true, true);
+  // Disconnect any existing connection, but keep the WiFi settings
+  // (the "disconnected" event this causes is ignored while connecting)
+  disconnectRouter();
   // Set WiFi to station mode (client mode, not access point)
   WiFi.mode(WIFI_STA);
-  // Begin connection attempt
-  WiFi.begin(storedSsid, storedPassword);
+  if (fastAttempt) {
+    const bool reuseIp = leaseFresh(now);
+    Serial.print("WiFi: fast connect to ");
+    Serial.print(networks[cacheNetwork].ssid);
+    Serial.println(reuseIp ? "" : " (asking DHCP)");
+    beginRouter(cacheNetwork, cache.channel, cache.bssid, reuseIp);
+  } else {
+    Serial.println("WiFi: scanning for networks");
+    WiFi.scanNetworks(true, true); // In the background, with hidden ones
+    connectScanning = true;
+  }
+}
+
+// True if no request is running and none finished in the last moments
+bool requestsQuiet(unsigned long now) {
+  return requestsRunning.load() == 0 &&
+         (uint32_t)(now - lastRequestEndMs.load()) >= WIFI_ROAM_QUIET_MS;
+}
+
+bool linkIsBad() {
+  if (currentRouter < 0) {
+    return false;
+  }
+  const Router &router = routers[currentRouter];
+  return router.rssi < WIFI_WEAK_RSSI_DBM ||
+         router.responseMs > WIFI_SLOW_RESPONSE_MS ||
+         router.failurePercent > WIFI_FAILING_PERCENT;
+}
+
+// Drop the current router and connect to a better one
+void roamTo(int index, unsigned long now) {
+  const Router &from = routers[currentRouter];
+  const Router &to = routers[index];
+  Serial.print("WiFi: switching from channel ");
+  Serial.print(from.channel);
+  Serial.print(" (");
+  Serial.print(from.rssi);
+  Serial.print(" dBm) to ");
+  Serial.print(networks[to.network].ssid);
+  Serial.print(" on channel ");
+  Serial.print(to.channel);
+  Serial.print(" (");
+  Serial.print(to.rssi);
+  Serial.println(" dBm)");
+  stats.roams++;
+  linkDown(now); // Every open connection breaks, so subscribers must know
+
+  lastAttemptMs = now;
+  state = WIFI_STATE_CONNECTING;
+  fastAttempt = true; // Directed, so it gets the short timeout
+  disconnectRouter();
+  // Within one network (same SSID) the IP settings stay valid
+  beginRouter(to.network, to.channel, to.bssid,
+              haveCache && to.network == cacheNetwork && leaseFresh(now));
+}
+
+// Connect to the same router again, asking DHCP this time: the address we
+// reuse has not been renewed for WIFI_LEASE_REUSE_MS, and the router may
+// soon lend it to someone else
+void renewAddress(unsigned long now) {
+  const Router &router = routers[currentRouter];
+  Serial.println("WiFi: renewing the reused address with DHCP");
+  stats.dhcpRenewals++;
+  linkDown(now); // Every open connection breaks, so subscribers must know
+
+  lastAttemptMs = now;
+  state = WIFI_STATE_CONNECTING;
+  fastAttempt = true;
+  disconnectRouter();
+  beginRouter(router.network, router.channel, router.bssid, false);
+}
+
+// While connected: check the link and look for a better router if it is bad
+void checkLink(unsigned long now) {
+  if (roamScanning) {
+    const int count = WiFi.scanComplete();
+    if (count == WIFI_SCAN_RUNNING) {
+      return;
+    }
+    roamScanning = false;
+    if (count < 0) {
+      return; // Scan failed, try again next interval
+    }
+    recordScan(count, now);
+    if (rssiAverage != 0) {
+      routers[currentRouter].rssi = rssiAverage; // Steadier than one sample
+    }
+    const int best = bestRouter();
+    if (best >= 0 && best != currentRouter && requestsQuiet(now) &&
+        routerScore(routers[best]) >=
+            routerScore(routers[currentRouter]) + WIFI_ROAM_MARGIN_DB) {
+      roamTo(best, now);
+    } else if (roamScanIntervalMs < WIFI_ROAM_SCAN_MAX_INTERVAL_MS) {
+      roamScanIntervalMs *= 2; // Nothing better around here
+    }
+    return;
+  }
+
+  if ((uint32_t)(now - lastQualityMs) < WIFI_QUALITY_INTERVAL_MS) {
+    return;
+  }
+  lastQualityMs = now;
+  const int rssi = WiFi.RSSI();
+  rssiAverage = rssiAverage == 0 ? rssi : (3 * rssiAverage + rssi) / 4;
+  collectReports();
+  if (currentRouter < 0) {
+    return;
+  }
+  routers[currentRouter].rssi = rssiAverage;
+  routers[currentRouter].seenMs = now;
+  routers[currentRouter].usedMs = now;
+
+  if (!staticIp) {
+    leaseSeenMs = now; // The ESP32's DHCP client renews it
+  } else if (!leaseFresh(now) && requestsQuiet(now)) {
+    renewAddress(now);
+    return;
+  }
+
+  if (roamingEnabled && linkIsBad() && requestsQuiet(now) &&
+      (!roamScanDone ||
+       (uint32_t)(now - lastRoamScanMs) >= roamScanIntervalMs)) {
+    const Router &router = routers[currentRouter];
+    Serial.print("WiFi: link is bad (");
+    Serial.print(router.rssi);
+    Serial.print(" dBm, ");
+    Serial.print(router.responseMs);
+    Serial.print(" ms, ");
+    Serial.print(router.failurePercent);
+    Serial.println("% failed), looking for a better router");
+    stats.roamScans++;
+    lastRoamScanMs = now;
+    roamScanDone = true;
+    roamScanning = WiFi.scanNetworks(true, true) == WIFI_SCAN_RUNNING;
+  }
 }
 } // namespace
 
 /**
  * Initialize WiFi manager with credentials
  *
- * Stores the WiFi credentials and immediately attempts to connect.
+ * A list with just this network.
  *
  * @param ssid The WiFi network name (SSID)
  * @param password The WiFi network password
  */
 void wifiManagerSetup(const char *ssid, const char *password) {
-  storedSsid = ssid;
-  storedPassword = password;
+  const WifiNetwork network = {ssid, password};
+  wifiManagerSetup(&network, 1);
+}
+
+/**
+ * Initialize WiFi manager with several networks
+ *
+ * Stores the credentials, reads the remembered network from NVS, registers
+ * the event handler and immediately attempts to connect.
+ *
+ * @param list The networks
+ * @param count Number of networks in list
+ */
+void wifiManagerSetup(const WifiNetwork *list, int count) {
+  networkCount = 0;
+  for (int i = 0; i < count && networkCount < WIFI_MAX_NETWORKS; i++) {
+    if (list[i].ssid != nullptr && list[i].ssid[0] != '\0') {
+      networks[networkCount++] = list[i];
+    }
+  }
+  setupMs = millis();
+  linkLostMs = setupMs; // Offline since power-on
+  connectedSinceSetup = false;
+  failedAttempts = 0;
+  leaseKnown = false; // Off for an unknown time
+  memset(routers, 0, sizeof(routers));
+  currentRouter = -1;
+  // We keep our own copy of the network in NVS; without this the WiFi
+  // library would also write the credentials to flash on every attempt
+  WiFi.persistent(false);
+  loadCache();
+  if (!eventsRegistered) {
+    WiFi.onEvent(onWifiEvent);
+    eventsRegistered = true;
+  }
   // Force immediate connection attempt on setup
   attemptConnection(true);
 }
 
+void wifiManagerSetRoaming(bool enabled) { roamingEnabled = enabled; }
+
+unsigned long wifiManagerRequestStarted() {
+  requestsRunning.fetch_add(1);
+  return millis();
+}
+
+void wifiManagerRequestFinished(unsigned long startedMs, bool answered) {
+  const unsigned long now = millis();
+  reportedRequests.fetch_add(1);
+  if (answered) {
+    reportedAnswerMs.fetch_add((uint32_t)(now - startedMs));
+  } else {
+    reportedFailures.fetch_add(1);
+  }
+  lastRequestEndMs.store(now);
+  requestsRunning.fetch_sub(1);
+}
+
 /**
  * Monitor and maintain WiFi connection
  *
- * Checks connection status and automatically attempts to reconnect
- * if disconnected. Uses timeout mechanism to detect failed connections.
+ * Handles the events received since the last call, then retries if
+ * disconnected, or checks the link if connected. Uses timeout mechanism to
+ * detect failed connections.
  * Should be called repeatedly in the main loop().
  */
 void wifiManagerLoop() {
-  // If already connected, no action needed
-  if (WiFi.status() == WL_CONNECTED) {
+  const unsigned long now = millis();
+
+  // Read the lost count before the IP state, so a loss that happens in
+  // between is seen on the next call at the latest
+  const uint32_t lostCount = eventLostCount.load();
+  const bool hasIp = eventHasIp.load();
+
+  // Lost while connected - even if it is already back, the subscribers'
+  // connections (HTTP, MQTT) broke, so they hear about both
+  if (state == WIFI_STATE_CONNECTED &&
+      (lostCount != handledLostCount || !hasIp)) {
+    linkDown(now);
+  }
+  // While connecting, "disconnected" events come from our own
+  // WiFi.disconnect() or a failed attempt; the timeout below handles those
+  handledLostCount = lostCount;
+
+  if (hasIp && state != WIFI_STATE_CONNECTED && !connectScanning) {
+    linkUp(now);
+  }
+  if (state == WIFI_STATE_CONNECTED) {
+    checkLink(now);
     return;
   }
 
-  const unsigned long now = millis();
-  // Check if connection attempt has timed out
-  // Also handles case where no attempt has been made yet (lastAttemptMs == 0)
-  const bool timedOut =
-      (now - lastAttemptMs) > WIFI_CONNECT_TIMEOUT_MS || lastAttemptMs == 0;
+  // A full attempt connects once its scan is done
+  if (state == WIFI_STATE_CONNECTING && connectScanning) {
+    const int count = WiFi.scanComplete();
+    if (count >= 0) {
+      connectAfterScan(count, now);
+    } else if (count == WIFI_SCAN_FAILED) {
+      WiFi.scanNetworks(true, true); // Try the scan again
+    }
+  }
 
-  if (timedOut) {
-    // Retry connection (respects retry interval)
-    attemptConnection(false);
+  // Check if connection attempt has timed out
+  unsigned long timeout = WIFI_CONNECT_TIMEOUT_MS;
+  if (fastAttempt) {
+    timeout =
+        staticIp ? WIFI_FAST_CONNECT_TIMEOUT_MS : WIFI_FAST_DHCP_TIMEOUT_MS;
+  }
+  if (state == WIFI_STATE_CONNECTING &&
+      (uint32_t)(now - lastAttemptMs) <= timeout) {
+    return;
+  }
+  if (state == WIFI_STATE_CONNECTING) {
+    failedAttempts++;
+    if (fastAttempt) {
+      stats.fastFailures++;
+    }
+    if (connectScanning) {
+      WiFi.scanDelete();
+      connectScanning = false;
+    }
+    state = WIFI_STATE_WAITING;
+    if (fastAttempt && !connectedSinceSetup && failedAttempts == 1) {
+      // Booting and the router may have moved to another channel or been
+      // replaced: scan right away instead of waiting for the retry interval
+      Serial.println("WiFi: fast connect failed, scanning");
+      attemptConnection(true);
+      return;
+    }
   }
+  // Retry connection (respects retry interval)
+  attemptConnection(false);
 }
 
 /**
  * Check if WiFi is currently connected
  *
- * @return true if WiFi status is WL_CONNECTED, false otherwise
+ * @return true if the last wifiManagerLoop() saw an IP address
  */
-bool wifiManagerIsConnected() { return WiFi.status() == WL_CONNECTED; }
+bool wifiManagerIsConnected() { return state == WIFI_STATE_CONNECTED; }
+
+WifiState wifiManagerState() { return state; }
+
+bool wifiManagerSubscribe(WifiLinkCallback callback) {
+  for (int i = 0; i < subscriberCount; i++) {
+    if (subscribers[i] == callback) {
+      return true; // Already subscribed
+    }
+  }
+  if (callback == nullptr || subscriberCount == WIFI_MAX_SUBSCRIBERS) {
+    return false;
+  }
+  subscribers[subscriberCount++] = callback;
+  return true;
+}
+
+WifiStats wifiManagerGetStats() { return stats; }
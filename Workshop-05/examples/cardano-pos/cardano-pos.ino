@@ -3,14 +3,71 @@
 #include <TFT_eSPI.h>
 
 // Include our custom header files
+#include "heap_profiler.h"   // Free heap, fragmentation and who allocates
+#include "invoice_address.h" // Per-invoice payment addresses
+#include "logger.h"          // Log messages written in the background
+#include "loop_profiler.h"   // What loop() spends its time on
+#include "payment_watcher.h" // Background payment checks
+#include "price_service.h"  // Cached ADA price for fiat invoices
 #include "secrets.h"        // WiFi credentials (not in git)
 #include "transaction_qr.h" // Transaction QR code display
 #include "web_server.h"     // HTTP web server for serving files
 #include "wifi_manager.h"   // WiFi connection management
 
+// More WiFi networks (optional, see secrets.h.example). Older secrets.h
+// files don't have them, so they default to empty (not used).
+#ifndef WIFI_SSID_2
+#define WIFI_SSID_2 ""
+#define WIFI_PASSWORD_2 ""
+#endif
+#ifndef WIFI_SSID_3
+#define WIFI_SSID_3 ""
+#define WIFI_PASSWORD_3 ""
+#endif
+
+// The networks the device may use; it picks the best router in range
+const WifiNetwork wifiNetworks[] = {{WIFI_SSID, WIFI_PASSWORD},
+                                    {WIFI_SSID_2, WIFI_PASSWORD_2},
+                                    {WIFI_SSID_3, WIFI_PASSWORD_3}};
+
 // Display object - handles communication with the TFT screen
 TFT_eSPI display = TFT_eSPI();
 
+// The calls loop() makes, timed by the loop profiler (see loop_profiler.h)
+// and logged once a minute. The stats are also served at /api/loop.
+enum LoopSection {
+  SECTION_WIFI,     // wifiManagerLoop()
+  SECTION_WEB,      // webServerLoop(): answering HTTP requests
+  SECTION_QR,       // transactionQRUpdate(): drawing the payment status
+  SECTION_PAYMENTS, // paymentWatcherLoop() (host builds only)
+  SECTION_PRICE,    // priceServiceLoop() (host builds only)
+  SECTION_INVOICE,  // invoiceAddressLoop(): deriving the next address
+  SECTION_COUNT
+};
+const char *const SECTION_NAMES[SECTION_COUNT] = {
+    "wifi", "web", "qr", "payments", "price", "invoice"};
+
+// Nothing in loop() waits for the network, so an iteration should stay in
+// the low milliseconds. One that takes longer is logged as a stall.
+const unsigned long LOOP_BUDGET_MS = 100UL;
+
+// How often the heap profiler logs free heap and fragmentation (10 minutes).
+// The samples are also served at /api/heap.
+const unsigned long HEAP_SAMPLE_INTERVAL_MS = 600000UL;
+
+// Called by the WiFi manager the moment WiFi comes back or goes away
+void onWifiChange(bool connected) {
+  if (!connected) {
+    return;
+  }
+  // If WiFi connected after setup() gave up waiting, start the server now
+  if (!webServerIsRunning()) {
+    webServerSetup();
+  }
+  // Check the open invoice now: a payment may have arrived while offline
+  paymentWatchCheckNow();
+}
+
 void setup() {
   // Initialize serial communication for debugging
   // Serial communication lets us send messages to the computer via USB
@@ -19,12 +76,22 @@ void setup() {
   Serial.begin(115200);
   delay(1000); // Give serial monitor time to connect
 
+  // Log messages go through a ring buffer and are written in the
+  // background, so request handlers don't wait for the slow UART
+  loggerBegin();
+
+  // Time every call in loop() and log the ones that hold it up
+  loopProfilerBegin(SECTION_NAMES, SECTION_COUNT, LOOP_BUDGET_MS);
+
+  // Log free heap and fragmentation, to see it creep over days of use
+  heapProfilerBegin(HEAP_SAMPLE_INTERVAL_MS);
+
   // Set up WiFi connection
   // WIFI_SSID is your WiFi network name
   // WIFI_PASSWORD is your WiFi password
   // These are defined in secrets.h (which you should create from
-  // secrets.h.example)
-  wifiManagerSetup(WIFI_SSID, WIFI_PASSWORD);
+  // secrets.h.example), together with up to two more networks
+  wifiManagerSetup(wifiNetworks, 3);
 
   // Wait for WiFi connection (with timeout)
   // We need WiFi to serve web pages, so we wait here
@@ -47,6 +114,9 @@ void setup() {
     Serial.println("WiFi connection failed - web server not started");
   }
 
+  // From now on, react to WiFi coming back instead of checking every loop()
+  wifiManagerSubscribe(onWifiChange);
+
   // Initialize the display
   display.begin();
 
@@ -80,21 +150,41 @@ void setup() {
 
   // Register callback to display QR code when new transaction is created
   setTransactionCreatedCallback(displayNewTransactionQR, &display);
+
+  // Keep the ADA price fresh in the background for fiat invoices
+  // It waits for WiFi by itself, so this works even if WiFi is still down
+  priceServiceSetup();
 }
 
 void loop() {
+  loggerLoop();
+  heapProfilerLoop();
+  loopProfilerStart();
+
   // Keep WiFi connection alive and check for reconnection if needed
   // This needs to be called regularly to maintain the connection
   wifiManagerLoop();
+  loopProfilerDone(SECTION_WIFI);
 
   // Handle web server requests (runs asynchronously, but we call loop for
-  // consistency)
-  if (wifiManagerIsConnected() && !webServerIsRunning()) {
-    // If WiFi just reconnected, start the server
-    webServerSetup();
-  }
+  // consistency). onWifiChange() starts the server when WiFi comes back.
   webServerLoop();
+  loopProfilerDone(SECTION_WEB);
 
-  // Update transaction QR display and check on-chain status
+  // Update transaction QR display with the results of payment checks
+  // The checks themselves run in the payment watcher task
   transactionQRUpdate(display);
+  loopProfilerDone(SECTION_QR);
+
+  // Check for payments (only needed in host builds, the ESP32 uses a task)
+  paymentWatcherLoop();
+  loopProfilerDone(SECTION_PAYMENTS);
+
+  // Refresh the ADA price (only needed in host builds, the ESP32 uses a task)
+  priceServiceLoop();
+  loopProfilerDone(SECTION_PRICE);
+
+  // Derive the next invoice address while nothing else is going on
+  invoiceAddressLoop();
+  loopProfilerDone(SECTION_INVOICE);
 }
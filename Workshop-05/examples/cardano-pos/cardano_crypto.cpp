@@ -0,0 +1,780 @@
+#include "cardano_crypto.h"
+#include <string.h>
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// SHA-512 (FIPS 180-4)
+// ---------------------------------------------------------------------------
+
+const uint64_t SHA512_K[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL,
+};
+
+// Initial hash values of SHA-512, also the BLAKE2b IV
+const uint64_t SHA512_IV[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL,
+    0xa54ff53a5f1d36f1ULL, 0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL,
+    0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL,
+};
+
+inline uint64_t rotr64(uint64_t x, int n) { return (x >> n) | (x << (64 - n)); }
+
+struct Sha512 {
+  uint64_t state[8];
+  uint8_t block[128];
+  size_t blockLength;
+  uint64_t totalLength;
+};
+
+void sha512Compress(uint64_t state[8], const uint8_t block[128]) {
+  uint64_t w[80];
+  for (int i = 0; i < 16; i++) {
+    w[i] = 0;
+    for (int j = 0; j < 8; j++) {
+      w[i] = (w[i] << 8) | block[i * 8 + j];
+    }
+  }
+  for (int i = 16; i < 80; i++) {
+    uint64_t s0 = rotr64(w[i - 15], 1) ^ rotr64(w[i - 15], 8) ^ (w[i - 15] >> 7);
+    uint64_t s1 = rotr64(w[i - 2], 19) ^ rotr64(w[i - 2], 61) ^ (w[i - 2] >> 6);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  uint64_t a = state[0], b = state[1], c = state[2], d = state[3];
+  uint64_t e = state[4], f = state[5], g = state[6], h = state[7];
+  for (int i = 0; i < 80; i++) {
+    uint64_t s1 = rotr64(e, 14) ^ rotr64(e, 18) ^ rotr64(e, 41);
+    uint64_t ch = (e & f) ^ (~e & g);
+    uint64_t t1 = h + s1 + ch + SHA512_K[i] + w[i];
+    uint64_t s0 = rotr64(a, 28) ^ rotr64(a, 34) ^ rotr64(a, 39);
+    uint64_t maj = (a & b) ^ (a & c) ^ (b & c);
+    uint64_t t2 = s0 + maj;
+    h = g;
+    g = f;
+    f = e;
+    e = d + t1;
+    d = c;
+    c = b;
+    b = a;
+    a = t1 + t2;
+  }
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+  state[5] += f;
+  state[6] += g;
+  state[7] += h;
+}
+
+void sha512Init(Sha512 &ctx) {
+  memcpy(ctx.state, SHA512_IV, sizeof(ctx.state));
+  ctx.blockLength = 0;
+  ctx.totalLength = 0;
+}
+
+void sha512Update(Sha512 &ctx, const uint8_t *data, size_t length) {
+  ctx.totalLength += length;
+  while (length > 0) {
+    size_t take = 128 - ctx.blockLength;
+    if (take > length) {
+      take = length;
+    }
+    memcpy(ctx.block + ctx.blockLength, data, take);
+    ctx.blockLength += take;
+    data += take;
+    length -= take;
+    if (ctx.blockLength == 128) {
+      sha512Compress(ctx.state, ctx.block);
+      ctx.blockLength = 0;
+    }
+  }
+}
+
+void sha512Final(Sha512 &ctx, uint8_t out[SHA512_SIZE]) {
+  uint64_t bitLength = ctx.totalLength * 8;
+  uint8_t pad = 0x80;
+  sha512Update(ctx, &pad, 1);
+  pad = 0;
+  // Leave room for the 128-bit length (upper 64 bits are always zero here)
+  while (ctx.blockLength != 112) {
+    sha512Update(ctx, &pad, 1);
+  }
+  uint8_t lengthBytes[16] = {0};
+  for (int i = 0; i < 8; i++) {
+    lengthBytes[15 - i] = (uint8_t)(bitLength >> (i * 8));
+  }
+  sha512Update(ctx, lengthBytes, sizeof(lengthBytes));
+
+  for (int i = 0; i < 8; i++) {
+    for (int j = 0; j < 8; j++) {
+      out[i * 8 + j] = (uint8_t)(ctx.state[i] >> (56 - j * 8));
+    }
+  }
+}
+
+// ---------------------------------------------------------------------------
+// BLAKE2b (RFC 7693), unkeyed
+// ---------------------------------------------------------------------------
+
+const uint8_t BLAKE2B_SIGMA[12][16] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+    {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4},
+    {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
+    {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13},
+    {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
+    {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11},
+    {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
+    {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5},
+    {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0},
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+};
+
+inline void blake2bMix(uint64_t v[16], int a, int b, int c, int d, uint64_t x,
+                       uint64_t y) {
+  v[a] = v[a] + v[b] + x;
+  v[d] = rotr64(v[d] ^ v[a], 32);
+  v[c] = v[c] + v[d];
+  v[b] = rotr64(v[b] ^ v[c], 24);
+  v[a] = v[a] + v[b] + y;
+  v[d] = rotr64(v[d] ^ v[a], 16);
+  v[c] = v[c] + v[d];
+  v[b] = rotr64(v[b] ^ v[c], 63);
+}
+
+void blake2bCompress(uint64_t h[8], const uint8_t block[128], uint64_t counter,
+                     bool last) {
+  uint64_t m[16];
+  for (int i = 0; i < 16; i++) {
+    m[i] = 0;
+    for (int j = 7; j >= 0; j--) {
+      m[i] = (m[i] << 8) | block[i * 8 + j];
+    }
+  }
+
+  uint64_t v[16];
+  for (int i = 0; i < 8; i++) {
+    v[i] = h[i];
+    v[i + 8] = SHA512_IV[i];
+  }
+  v[12] ^= counter;
+  if (last) {
+    v[14] = ~v[14];
+  }
+
+  for (int round = 0; round < 12; round++) {
+    const uint8_t *s = BLAKE2B_SIGMA[round];
+    blake2bMix(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+    blake2bMix(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+    blake2bMix(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+    blake2bMix(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+    blake2bMix(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+    blake2bMix(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+    blake2bMix(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+    blake2bMix(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+  }
+
+  for (int i = 0; i < 8; i++) {
+    h[i] ^= v[i] ^ v[i + 8];
+  }
+}
+
+// ---------------------------------------------------------------------------
+// Ed25519 point arithmetic
+//
+// Field elements mod 2^255-19 are 16 limbs of 16 bits in int64_t, which
+// leaves room for the products without 128-bit integers (the ESP32 has none).
+// Points are in extended coordinates (X, Y, Z, T) with x = X/Z, y = Y/Z.
+// Only public keys go through here, so nothing has to run in constant time.
+// ---------------------------------------------------------------------------
+
+typedef int64_t Fe[16];
+
+const Fe FE_ZERO = {0};
+const Fe FE_ONE = {1};
+// Curve constant d, 2*d and sqrt(-1)
+const Fe FE_D = {0x78a3, 0x1359, 0x4dca, 0x75eb, 0xd8ab, 0x4141, 0x0a4d, 0x0070,
+                 0xe898, 0x7779, 0x4079, 0x8cc7, 0xfe73, 0x2b6f, 0x6cee, 0x5203};
+const Fe FE_D2 = {0xf159, 0x26b2, 0x9b94, 0xebd6, 0xb156, 0x8283, 0x149a, 0x00e0,
+                  0xd130, 0xeef3, 0x80f2, 0x198e, 0xfce7, 0x56df, 0xd9dc, 0x2406};
+const Fe FE_SQRT_M1 = {0xa0b0, 0x4a0e, 0x1b27, 0xc4ee, 0xe478, 0xad2f,
+                       0x1806, 0x2f43, 0xd7a7, 0x3dfb, 0x0099, 0x2b4d,
+                       0xdf0b, 0x4fc1, 0x2480, 0x2b83};
+// Base point
+const Fe BASE_X = {0xd51a, 0x8f25, 0x2d60, 0xc956, 0xa7b2, 0x9525, 0xc760, 0x692c,
+                   0xdc5c, 0xfdd6, 0xe231, 0xc0a4, 0x53fe, 0xcd6e, 0x36d3, 0x2169};
+const Fe BASE_Y = {0x6658, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666,
+                   0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666};
+
+struct Point {
+  Fe x, y, z, t;
+};
+
+void feCopy(Fe out, const Fe a) { memcpy(out, a, sizeof(Fe)); }
+
+void feCarry(Fe o) {
+  for (int i = 0; i < 16; i++) {
+    o[i] += (int64_t)1 << 16;
+    int64_t carry = o[i] >> 16;
+    if (i < 15) {
+      o[i + 1] += carry - 1;
+    } else {
+      // 2^256 = 38 mod p
+      o[0] += 38 * (carry - 1);
+    }
+    o[i] -= carry * 65536;
+  }
+}
+
+// Swap p and q if swap is 1, without branching
+void feSwap(Fe p, Fe q, int swap) {
+  int64_t mask = ~((int64_t)swap - 1);
+  for (int i = 0; i < 16; i++) {
+    int64_t t = mask & (p[i] ^ q[i]);
+    p[i] ^= t;
+    q[i] ^= t;
+  }
+}
+
+void fePack(uint8_t out[32], const Fe n) {
+  Fe t, m;
+  feCopy(t, n);
+  feCarry(t);
+  feCarry(t);
+  feCarry(t);
+  // Subtract p up to twice to get the canonical value
+  for (int j = 0; j < 2; j++) {
+    m[0] = t[0] - 0xffed;
+    for (int i = 1; i < 15; i++) {
+      m[i] = t[i] - 0xffff - ((m[i - 1] >> 16) & 1);
+      m[i - 1] &= 0xffff;
+    }
+    m[15] = t[15] - 0x7fff - ((m[14] >> 16) & 1);
+    int borrow = (int)((m[15] >> 16) & 1);
+    m[14] &= 0xffff;
+    feSwap(t, m, 1 - borrow);
+  }
+  for (int i = 0; i < 16; i++) {
+    out[2 * i] = (uint8_t)(t[i] & 0xff);
+    out[2 * i + 1] = (uint8_t)(t[i] >> 8);
+  }
+}
+
+void feUnpack(Fe out, const uint8_t in[32]) {
+  for (int i = 0; i < 16; i++) {
+    out[i] = in[2 * i] + ((int64_t)in[2 * i + 1] << 8);
+  }
+  out[15] &= 0x7fff;
+}
+
+bool feEqual(const Fe a, const Fe b) {
+  uint8_t packedA[32], packedB[32];
+  fePack(packedA, a);
+  fePack(packedB, b);
+  return memcmp(packedA, packedB, 32) == 0;
+}
+
+int feParity(const Fe a) {
+  uint8_t packed[32];
+  fePack(packed, a);
+  return packed[0] & 1;
+}
+
+void feAdd(Fe out, const Fe a, const Fe b) {
+  for (int i = 0; i < 16; i++) {
+    out[i] = a[i] + b[i];
+  }
+}
+
+void feSub(Fe out, const Fe a, const Fe b) {
+  for (int i = 0; i < 16; i++) {
+    out[i] = a[i] - b[i];
+  }
+}
+
+void feMul(Fe out, const Fe a, const Fe b) {
+  int64_t t[31] = {0};
+  for (int i = 0; i < 16; i++) {
+    for (int j = 0; j < 16; j++) {
+      t[i + j] += a[i] * b[j];
+    }
+  }
+  for (int i = 0; i < 15; i++) {
+    t[i] += 38 * t[i + 16];
+  }
+  for (int i = 0; i < 16; i++) {
+    out[i] = t[i];
+  }
+  feCarry(out);
+  feCarry(out);
+}
+
+void feSquare(Fe out, const Fe a) { feMul(out, a, a); }
+
+// a^(p-2) = 1/a
+void feInvert(Fe out, const Fe a) {
+  Fe c;
+  feCopy(c, a);
+  for (int i = 253; i >= 0; i--) {
+    feSquare(c, c);
+    if (i != 2 && i != 4) {
+      feMul(c, c, a);
+    }
+  }
+  feCopy(out, c);
+}
+
+// a^((p-5)/8), used for the square root when decompressing
+void fePow2523(Fe out, const Fe a) {
+  Fe c;
+  feCopy(c, a);
+  for (int i = 250; i >= 0; i--) {
+    feSquare(c, c);
+    if (i != 1) {
+      feMul(c, c, a);
+    }
+  }
+  feCopy(out, c);
+}
+
+void pointAdd(Point &p, const Point &q) {
+  Fe a, b, c, d, e, f, g, h, t;
+  feSub(a, p.y, p.x);
+  feSub(t, q.y, q.x);
+  feMul(a, a, t);
+  feAdd(b, p.x, p.y);
+  feAdd(t, q.x, q.y);
+  feMul(b, b, t);
+  feMul(c, p.t, q.t);
+  feMul(c, c, FE_D2);
+  feMul(d, p.z, q.z);
+  feAdd(d, d, d);
+  feSub(e, b, a);
+  feSub(f, d, c);
+  feAdd(g, d, c);
+  feAdd(h, b, a);
+  feMul(p.x, e, f);
+  feMul(p.y, h, g);
+  feMul(p.z, g, f);
+  feMul(p.t, e, h);
+}
+
+// p = 2 * p, 4 squarings and 4 multiplications instead of the 9
+// multiplications of pointAdd()
+void pointDouble(Point &p) {
+  Fe a, b, c, e, f, g, h;
+  feSquare(a, p.x);
+  feSquare(b, p.y);
+  feSquare(c, p.z);
+  feAdd(c, c, c);
+  feAdd(e, p.x, p.y);
+  feSquare(e, e);
+  feSub(e, e, a);
+  feSub(e, e, b);
+  feSub(g, b, a); // -a + b (the curve has a = -1)
+  feSub(f, g, c);
+  feSub(h, FE_ZERO, a);
+  feSub(h, h, b);
+  feMul(p.x, e, f);
+  feMul(p.y, g, h);
+  feMul(p.t, e, h);
+  feMul(p.z, f, g);
+}
+
+// out = scalar * base point (scalar is 32 bytes, little endian)
+// Plain double-and-add from the highest set bit. Child key scalars have at
+// most 231 bits, so this skips the top of the 256-bit range.
+void scalarMultBase(Point &out, const uint8_t scalar[32]) {
+  Point base;
+  feCopy(base.x, BASE_X);
+  feCopy(base.y, BASE_Y);
+  feCopy(base.z, FE_ONE);
+  feMul(base.t, BASE_X, BASE_Y);
+
+  // Neutral element (0, 1)
+  feCopy(out.x, FE_ZERO);
+  feCopy(out.y, FE_ONE);
+  feCopy(out.z, FE_ONE);
+  feCopy(out.t, FE_ZERO);
+
+  int top = 255;
+  while (top >= 0 && ((scalar[top / 8] >> (top & 7)) & 1) == 0) {
+    top--;
+  }
+  for (int i = top; i >= 0; i--) {
+    pointDouble(out);
+    if ((scalar[i / 8] >> (i & 7)) & 1) {
+      pointAdd(out, base);
+    }
+  }
+}
+
+void pointPack(uint8_t out[32], const Point &p) {
+  Fe zInverse, x, y;
+  feInvert(zInverse, p.z);
+  feMul(x, p.x, zInverse);
+  feMul(y, p.y, zInverse);
+  fePack(out, y);
+  out[31] ^= feParity(x) << 7;
+}
+
+// Decompress a public key. Returns false if it is not on the curve.
+bool pointUnpack(Point &out, const uint8_t in[32]) {
+  Fe num, den, den2, den4, den6, t, check;
+  feCopy(out.z, FE_ONE);
+  feUnpack(out.y, in);
+
+  // x^2 = (y^2 - 1) / (d*y^2 + 1)
+  feSquare(num, out.y);
+  feMul(den, num, FE_D);
+  feSub(num, num, out.z);
+  feAdd(den, out.z, den);
+
+  feSquare(den2, den);
+  feSquare(den4, den2);
+  feMul(den6, den4, den2);
+  feMul(t, den6, num);
+  feMul(t, t, den);
+
+  fePow2523(t, t);
+  feMul(t, t, num);
+  feMul(t, t, den);
+  feMul(t, t, den);
+  feMul(out.x, t, den);
+
+  feSquare(check, out.x);
+  feMul(check, check, den);
+  if (!feEqual(check, num)) {
+    feMul(out.x, out.x, FE_SQRT_M1);
+  }
+  feSquare(check, out.x);
+  feMul(check, check, den);
+  if (!feEqual(check, num)) {
+    return false;
+  }
+
+  if (feParity(out.x) != (in[31] >> 7)) {
+    feSub(out.x, FE_ZERO, out.x);
+  }
+  feMul(out.t, out.x, out.y);
+  return true;
+}
+
+// ---------------------------------------------------------------------------
+// Bech32 (BIP-173)
+// ---------------------------------------------------------------------------
+
+const char BECH32_CHARSET[] = "qpzry9x8gf2tvdw0s3jn54khce6mua7l";
+
+uint32_t bech32Polymod(uint32_t checksum, uint8_t value) {
+  static const uint32_t GENERATOR[5] = {0x3b6a57b2, 0x26508e6d, 0x1ea119fa,
+                                        0x3d4233dd, 0x2a1462b3};
+  uint8_t top = checksum >> 25;
+  checksum = ((checksum & 0x1ffffff) << 5) ^ value;
+  for (int i = 0; i < 5; i++) {
+    if ((top >> i) & 1) {
+      checksum ^= GENERATOR[i];
+    }
+  }
+  return checksum;
+}
+
+uint32_t bech32HrpChecksum(const char *hrp, size_t hrpLength) {
+  uint32_t checksum = 1;
+  for (size_t i = 0; i < hrpLength; i++) {
+    checksum = bech32Polymod(checksum, (uint8_t)hrp[i] >> 5);
+  }
+  checksum = bech32Polymod(checksum, 0);
+  for (size_t i = 0; i < hrpLength; i++) {
+    checksum = bech32Polymod(checksum, (uint8_t)hrp[i] & 31);
+  }
+  return checksum;
+}
+
+int hexValue(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+} // namespace
+
+void sha512(const uint8_t *data, size_t length, uint8_t out[SHA512_SIZE]) {
+  Sha512 ctx;
+  sha512Init(ctx);
+  sha512Update(ctx, data, length);
+  sha512Final(ctx, out);
+}
+
+void hmacSha512(const uint8_t *key, size_t keyLength, const uint8_t *data,
+                size_t length, uint8_t out[SHA512_SIZE]) {
+  uint8_t keyBlock[128] = {0};
+  if (keyLength > sizeof(keyBlock)) {
+    sha512(key, keyLength, keyBlock);
+  } else {
+    memcpy(keyBlock, key, keyLength);
+  }
+
+  uint8_t pad[128];
+  for (int i = 0; i < 128; i++) {
+    pad[i] = keyBlock[i] ^ 0x36;
+  }
+  uint8_t innerHash[SHA512_SIZE];
+  Sha512 ctx;
+  sha512Init(ctx);
+  sha512Update(ctx, pad, sizeof(pad));
+  sha512Update(ctx, data, length);
+  sha512Final(ctx, innerHash);
+
+  for (int i = 0; i < 128; i++) {
+    pad[i] = keyBlock[i] ^ 0x5c;
+  }
+  sha512Init(ctx);
+  sha512Update(ctx, pad, sizeof(pad));
+  sha512Update(ctx, innerHash, sizeof(innerHash));
+  sha512Final(ctx, out);
+}
+
+void blake2b(const uint8_t *data, size_t length, uint8_t *out,
+             size_t outLength) {
+  uint64_t h[8];
+  memcpy(h, SHA512_IV, sizeof(h));
+  // Parameter block: digest length, no key, fanout 1, depth 1
+  h[0] ^= 0x01010000ULL ^ (uint64_t)outLength;
+
+  uint8_t block[128];
+  uint64_t counter = 0;
+  // Full blocks, always keeping the last (possibly full) block for the end
+  while (length > 128) {
+    counter += 128;
+    blake2bCompress(h, data, counter, false);
+    data += 128;
+    length -= 128;
+  }
+  memset(block, 0, sizeof(block));
+  memcpy(block, data, length);
+  counter += length;
+  blake2bCompress(h, block, counter, true);
+
+  for (size_t i = 0; i < outLength; i++) {
+    out[i] = (uint8_t)(h[i / 8] >> (8 * (i % 8)));
+  }
+}
+
+bool parseExtendedPublicKey(const char *text, ExtendedPublicKey &out) {
+  uint8_t raw[64];
+  size_t textLength = strlen(text);
+
+  if (textLength == 128) {
+    for (int i = 0; i < 64; i++) {
+      int high = hexValue(text[2 * i]);
+      int low = hexValue(text[2 * i + 1]);
+      if (high < 0 || low < 0) {
+        return false;
+      }
+      raw[i] = (uint8_t)(high << 4 | low);
+    }
+  } else {
+    char hrp[16];
+    size_t length = 0;
+    if (!bech32Decode(text, hrp, sizeof(hrp), raw, sizeof(raw), length) ||
+        length != sizeof(raw)) {
+      return false;
+    }
+  }
+
+  memcpy(out.key, raw, 32);
+  memcpy(out.chainCode, raw + 32, 32);
+  // Reject keys that are not curve points now rather than on first use
+  Point check;
+  return pointUnpack(check, out.key);
+}
+
+bool deriveChildKey(const ExtendedPublicKey &parent, uint32_t index,
+                    ExtendedPublicKey &child) {
+  if (index >= 0x80000000UL) {
+    return false; // Hardened keys need the private key
+  }
+
+  // 0x02 || key || index (little endian) for the key,
+  // 0x03 || key || index for the chain code
+  uint8_t data[1 + 32 + 4];
+  memcpy(data + 1, parent.key, 32);
+  for (int i = 0; i < 4; i++) {
+    data[33 + i] = (uint8_t)(index >> (8 * i));
+  }
+
+  uint8_t z[SHA512_SIZE];
+  data[0] = 0x02;
+  hmacSha512(parent.chainCode, 32, data, sizeof(data), z);
+
+  // child key = parent key + 8 * zL * G, with zL the first 28 bytes of z
+  uint8_t scalar[32] = {0};
+  unsigned carry = 0;
+  for (int i = 0; i < 28; i++) {
+    unsigned value = z[i] * 8u + carry;
+    scalar[i] = (uint8_t)value;
+    carry = value >> 8;
+  }
+  scalar[28] = (uint8_t)carry;
+
+  Point parentPoint, offset;
+  if (!pointUnpack(parentPoint, parent.key)) {
+    return false;
+  }
+  scalarMultBase(offset, scalar);
+  pointAdd(parentPoint, offset);
+  pointPack(child.key, parentPoint);
+
+  uint8_t chain[SHA512_SIZE];
+  data[0] = 0x03;
+  hmacSha512(parent.chainCode, 32, data, sizeof(data), chain);
+  memcpy(child.chainCode, chain + 32, 32);
+  return true;
+}
+
+void publicKeyHash(const uint8_t key[32], uint8_t out[KEY_HASH_SIZE]) {
+  blake2b(key, 32, out, KEY_HASH_SIZE);
+}
+
+bool encodeBaseAddress(uint8_t networkId,
+                       const uint8_t paymentKeyHash[KEY_HASH_SIZE],
+                       const uint8_t stakeKeyHash[KEY_HASH_SIZE], char *out,
+                       size_t outSize) {
+  // Header: address type 0 (key hash + key hash) in the upper 4 bits,
+  // network in the lower 4 bits
+  uint8_t address[1 + 2 * KEY_HASH_SIZE];
+  address[0] = networkId & 0x0f;
+  memcpy(address + 1, paymentKeyHash, KEY_HASH_SIZE);
+  memcpy(address + 1 + KEY_HASH_SIZE, stakeKeyHash, KEY_HASH_SIZE);
+  return bech32Encode(networkId == 1 ? "addr" : "addr_test", address,
+                      sizeof(address), out, outSize);
+}
+
+bool bech32Encode(const char *hrp, const uint8_t *data, size_t length,
+                  char *out, size_t outSize) {
+  size_t hrpLength = strlen(hrp);
+  size_t dataChars = (length * 8 + 4) / 5;
+  if (hrpLength + 1 + dataChars + 6 + 1 > outSize) {
+    return false;
+  }
+
+  uint32_t checksum = bech32HrpChecksum(hrp, hrpLength);
+  memcpy(out, hrp, hrpLength);
+  char *p = out + hrpLength;
+  *p++ = '1';
+
+  // Regroup 8-bit bytes into 5-bit characters
+  uint32_t accumulator = 0;
+  int bits = 0;
+  for (size_t i = 0; i < length; i++) {
+    accumulator = (accumulator << 8) | data[i];
+    bits += 8;
+    while (bits >= 5) {
+      bits -= 5;
+      uint8_t value = (accumulator >> bits) & 31;
+      checksum = bech32Polymod(checksum, value);
+      *p++ = BECH32_CHARSET[value];
+    }
+  }
+  if (bits > 0) {
+    uint8_t value = (accumulator << (5 - bits)) & 31;
+    checksum = bech32Polymod(checksum, value);
+    *p++ = BECH32_CHARSET[value];
+  }
+
+  for (int i = 0; i < 6; i++) {
+    checksum = bech32Polymod(checksum, 0);
+  }
+  checksum ^= 1;
+  for (int i = 0; i < 6; i++) {
+    *p++ = BECH32_CHARSET[(checksum >> (5 * (5 - i))) & 31];
+  }
+  *p = '\0';
+  return true;
+}
+
+bool bech32Decode(const char *text, char *hrp, size_t hrpSize, uint8_t *data,
+                  size_t dataSize, size_t &dataLength) {
+  const char *separator = strrchr(text, '1');
+  if (separator == nullptr || separator == text) {
+    return false;
+  }
+  size_t hrpLength = separator - text;
+  size_t textLength = strlen(text);
+  if (hrpLength + 1 > hrpSize || textLength - hrpLength - 1 < 6) {
+    return false;
+  }
+  for (size_t i = 0; i < hrpLength; i++) {
+    char c = text[i];
+    hrp[i] = (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c;
+  }
+  hrp[hrpLength] = '\0';
+
+  uint32_t checksum = bech32HrpChecksum(hrp, hrpLength);
+  size_t dataChars = textLength - hrpLength - 1 - 6;
+  uint32_t accumulator = 0;
+  int bits = 0;
+  dataLength = 0;
+
+  for (size_t i = hrpLength + 1; i < textLength; i++) {
+    char c = text[i];
+    if (c >= 'A' && c <= 'Z') {
+      c = c - 'A' + 'a';
+    }
+    const char *found = strchr(BECH32_CHARSET, c);
+    if (c == '\0' || found == nullptr) {
+      return false;
+    }
+    uint8_t value = (uint8_t)(found - BECH32_CHARSET);
+    checksum = bech32Polymod(checksum, value);
+
+    // Only the characters before the checksum carry data
+    if (i - hrpLength - 1 < dataChars) {
+      accumulator = (accumulator << 5) | value;
+      bits += 5;
+      if (bits >= 8) {
+        bits -= 8;
+        if (dataLength >= dataSize) {
+          return false;
+        }
+        data[dataLength++] = (uint8_t)(accumulator >> bits);
+      }
+    }
+  }
+
+  // Leftover padding bits must be zero and fewer than 5
+  if (bits >= 5 || (accumulator & ((1u << bits) - 1)) != 0) {
+    return false;
+  }
+  return checksum == 1;
+}
@@ -0,0 +1,65 @@
+#ifndef CARDANO_CRYPTO_H
+#define CARDANO_CRYPTO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Hashes, key derivation and address encoding needed to make Cardano payment
+// addresses on the device. Only public keys are handled: nothing in here can
+// spend funds, so a stolen POS never exposes the shop's wallet.
+
+#define SHA512_SIZE 64
+#define KEY_HASH_SIZE 28 // Blake2b-224 of a public key
+
+// Longest bech32 base address (addr_test1 + 57 bytes + checksum) plus '\0'
+#define CARDANO_ADDRESS_MAX_LENGTH 112
+
+// Ed25519 public key with its BIP32 chain code, as exported by wallets
+// (acct_xvk1... for an account)
+struct ExtendedPublicKey {
+  uint8_t key[32];
+  uint8_t chainCode[32];
+};
+
+void sha512(const uint8_t *data, size_t length, uint8_t out[SHA512_SIZE]);
+
+void hmacSha512(const uint8_t *key, size_t keyLength, const uint8_t *data,
+                size_t length, uint8_t out[SHA512_SIZE]);
+
+// BLAKE2b with an output of 1 to 64 bytes (28 for key hashes, 32 for
+// transaction hashes)
+void blake2b(const uint8_t *data, size_t length, uint8_t *out,
+             size_t outLength);
+
+// Parse an extended public key given as bech32 (acct_xvk1..., xpub1...) or as
+// 128 hex characters. Returns false if the text is not a valid key.
+bool parseExtendedPublicKey(const char *text, ExtendedPublicKey &out);
+
+// BIP32-Ed25519 soft (non-hardened) child key derivation, as used by Cardano
+// wallets. Only indexes below 2^31 can be derived from a public key.
+// Returns false for hardened indexes or a parent key that is not a curve point.
+bool deriveChildKey(const ExtendedPublicKey &parent, uint32_t index,
+                    ExtendedPublicKey &child);
+
+// Blake2b-224 hash of a public key, as used in addresses
+void publicKeyHash(const uint8_t key[32], uint8_t out[KEY_HASH_SIZE]);
+
+// Bech32 base address (payment key hash + stake key hash)
+// networkId: 0 for testnets (addr_test1...), 1 for mainnet (addr1...)
+// out must hold CARDANO_ADDRESS_MAX_LENGTH bytes
+bool encodeBaseAddress(uint8_t networkId,
+                       const uint8_t paymentKeyHash[KEY_HASH_SIZE],
+                       const uint8_t stakeKeyHash[KEY_HASH_SIZE], char *out,
+                       size_t outSize);
+
+// Bech32 encoding without the 90 character limit (Cardano addresses and keys
+// are longer). Returns false if out is too small.
+bool bech32Encode(const char *hrp, const uint8_t *data, size_t length,
+                  char *out, size_t outSize);
+
+// Decode bech32 text into hrp and data. Returns false on a bad checksum,
+// invalid characters or buffers that are too small.
+bool bech32Decode(const char *text, char *hrp, size_t hrpSize, uint8_t *data,
+                  size_t dataSize, size_t &dataLength);
+
+#endif
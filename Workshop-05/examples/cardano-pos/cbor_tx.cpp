@@ -0,0 +1,352 @@
+#include "cbor_tx.h"
+#include "cardano_crypto.h"
+#include <string.h>
+
+namespace {
+// Nesting limit when skipping items (Plutus data can nest, but not this deep)
+const int MAX_DEPTH = 64;
+
+enum CborMajor {
+  CBOR_UINT = 0,
+  CBOR_NEGINT = 1,
+  CBOR_BYTES = 2,
+  CBOR_TEXT = 3,
+  CBOR_ARRAY = 4,
+  CBOR_MAP = 5,
+  CBOR_TAG = 6,
+  CBOR_SIMPLE = 7,
+};
+
+// Transaction body keys
+const uint64_t BODY_OUTPUTS = 1;
+
+// Simple values (major type 7)
+const uint64_t CBOR_TRUE = 21; // 0xf5
+
+// Babbage map-style output keys
+const uint64_t OUTPUT_ADDRESS = 0;
+const uint64_t OUTPUT_VALUE = 1;
+
+// Header of one CBOR data item. For byte and text strings of definite
+// length, data points at the content inside the input buffer.
+struct CborItem {
+  uint8_t major;
+  uint64_t value; // Integer, length, count, tag or simple value
+  bool indefinite;
+  const uint8_t *data;
+};
+
+// Forward-only reader over a CBOR buffer
+class CborReader {
+public:
+  CborReader(const uint8_t *data, size_t length)
+      : data_(data), length_(length), position_(0) {}
+
+  size_t position() const { return position_; }
+  bool atEnd() const { return position_ == length_; }
+
+  // Next byte is the "break" that ends an indefinite-length item
+  bool atBreak() const {
+    return position_ < length_ && data_[position_] == 0xff;
+  }
+
+  bool readBreak() {
+    if (!atBreak()) {
+      return false;
+    }
+    position_++;
+    return true;
+  }
+
+  // Read an item header. String contents are stepped over (see item.data).
+  bool next(CborItem &item) {
+    if (position_ >= length_) {
+      return false;
+    }
+    uint8_t initial = data_[position_++];
+    item.major = initial >> 5;
+    uint8_t info = initial & 0x1f;
+    item.indefinite = false;
+    item.data = nullptr;
+
+    if (info < 24) {
+      item.value = info;
+    } else if (info <= 27) {
+      size_t size = (size_t)1 << (info - 24);
+      if (length_ - position_ < size) {
+        return false;
+      }
+      item.value = 0;
+      for (size_t i = 0; i < size; i++) {
+        item.value = (item.value << 8) | data_[position_++];
+      }
+    } else if (info == 31 && item.major >= CBOR_BYTES &&
+               item.major <= CBOR_MAP) {
+      item.indefinite = true;
+      item.value = 0;
+      return true;
+    } else {
+      return false; // Reserved values, or a stray break
+    }
+
+    if (item.major == CBOR_BYTES || item.major == CBOR_TEXT) {
+      if (item.value > length_ - position_) {
+        return false;
+      }
+      item.data = data_ + position_;
+      position_ += (size_t)item.value;
+    }
+    return true;
+  }
+
+  bool readUnsigned(uint64_t &value) {
+    CborItem item;
+    if (!next(item) || item.major != CBOR_UINT) {
+      return false;
+    }
+    value = item.value;
+    return true;
+  }
+
+  // Skip one complete item, including everything nested in it
+  bool skip(int depth = 0) {
+    if (depth > MAX_DEPTH) {
+      return false;
+    }
+    CborItem item;
+    if (!next(item)) {
+      return false;
+    }
+    return skipContent(item, depth);
+  }
+
+  // Skip what follows an item header that was already read
+  bool skipContent(const CborItem &item, int depth) {
+    switch (item.major) {
+    case CBOR_BYTES:
+    case CBOR_TEXT:
+      if (item.indefinite) {
+        // Chunks of the same type, until break
+        while (!atBreak()) {
+          CborItem chunk;
+          if (!next(chunk) || chunk.major != item.major || chunk.indefinite) {
+            return false;
+          }
+        }
+        return readBreak();
+      }
+      return true;
+    case CBOR_ARRAY:
+    case CBOR_MAP: {
+      if (item.indefinite) {
+        while (!atBreak()) {
+          if (!skip(depth + 1) ||
+              (item.major == CBOR_MAP && !skip(depth + 1))) {
+            return false;
+          }
+        }
+        return readBreak();
+      }
+      uint64_t count = item.major == CBOR_MAP ? item.value * 2 : item.value;
+      // Every item takes at least one byte, so a bigger count is malformed
+      if (count > length_ - position_) {
+        return false;
+      }
+      for (uint64_t i = 0; i < count; i++) {
+        if (!skip(depth + 1)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    case CBOR_TAG:
+      return skip(depth + 1);
+    default:
+      return true; // Integers and simple values have no content
+    }
+  }
+
+  // Call body for every element of an array, or every key/value of a map,
+  // whether definite or indefinite length
+  template <typename Body> bool forEach(const CborItem &container, Body body) {
+    uint64_t remaining = container.value;
+    while (container.indefinite ? !atBreak() : remaining > 0) {
+      if (!body()) {
+        return false;
+      }
+      remaining--;
+    }
+    return container.indefinite ? readBreak() : true;
+  }
+
+private:
+  const uint8_t *data_;
+  size_t length_;
+  size_t position_;
+};
+
+struct OutputTarget {
+  const uint8_t *address;
+  size_t addressLength;
+  uint64_t expectedLovelace;
+};
+
+// value = coin / [coin, multiasset]
+bool readCoin(CborReader &reader, uint64_t &coin) {
+  CborItem item;
+  if (!reader.next(item)) {
+    return false;
+  }
+  if (item.major == CBOR_UINT) {
+    coin = item.value;
+    return true;
+  }
+  if (item.major != CBOR_ARRAY || item.indefinite || item.value != 2 ||
+      !reader.readUnsigned(coin)) {
+    return false;
+  }
+  return reader.skip(); // Native tokens are not counted
+}
+
+// Legacy output [address, value, datum hash?] or
+// Babbage output {0: address, 1: value, 2: datum, 3: script ref}
+bool readOutput(CborReader &reader, const OutputTarget &target,
+                TxPayment &out) {
+  CborItem output;
+  if (!reader.next(output)) {
+    return false;
+  }
+
+  CborItem address = {};
+  uint64_t coin = 0;
+  bool haveAddress = false;
+  bool haveCoin = false;
+
+  if (output.major == CBOR_ARRAY) {
+    uint64_t index = 0;
+    bool ok = reader.forEach(output, [&]() {
+      bool result;
+      if (index == 0) {
+        result = reader.next(address) && address.major == CBOR_BYTES &&
+                 !address.indefinite;
+        haveAddress = result;
+      } else if (index == 1) {
+        result = readCoin(reader, coin);
+        haveCoin = result;
+      } else {
+        result = reader.skip();
+      }
+      index++;
+      return result;
+    });
+    if (!ok) {
+      return false;
+    }
+  } else if (output.major == CBOR_MAP) {
+    bool ok = reader.forEach(output, [&]() {
+      uint64_t key;
+      if (!reader.readUnsigned(key)) {
+        return false;
+      }
+      if (key == OUTPUT_ADDRESS) {
+        haveAddress = reader.next(address) && address.major == CBOR_BYTES &&
+                      !address.indefinite;
+        return haveAddress;
+      }
+      if (key == OUTPUT_VALUE) {
+        haveCoin = readCoin(reader, coin);
+        return haveCoin;
+      }
+      return reader.skip();
+    });
+    if (!ok) {
+      return false;
+    }
+  } else {
+    return false;
+  }
+
+  if (!haveAddress || !haveCoin) {
+    return false;
+  }
+
+  out.outputCount++;
+  if (address.value == target.addressLength &&
+      memcmp(address.data, target.address, target.addressLength) == 0) {
+    out.outputsToAddress++;
+    out.lovelaceToAddress += coin;
+    if (coin == target.expectedLovelace) {
+      out.exactOutput = true;
+    }
+  }
+  return true;
+}
+
+bool readOutputs(CborReader &reader, const OutputTarget &target,
+                 TxPayment &out) {
+  CborItem outputs;
+  if (!reader.next(outputs) || outputs.major != CBOR_ARRAY) {
+    return false;
+  }
+  return reader.forEach(outputs,
+                        [&]() { return readOutput(reader, target, out); });
+}
+} // namespace
+
+bool txFindPayment(const uint8_t *cbor, size_t length, const uint8_t *address,
+                   size_t addressLength, uint64_t expectedLovelace,
+                   TxPayment &out) {
+  memset(&out, 0, sizeof(out));
+  OutputTarget target = {address, addressLength, expectedLovelace};
+  CborReader reader(cbor, length);
+
+  // transaction = [body, witness set, is_valid?, auxiliary data]
+  CborItem tx;
+  if (!reader.next(tx) || tx.major != CBOR_ARRAY || tx.indefinite ||
+      tx.value < 3 || tx.value > 4) {
+    return false;
+  }
+
+  size_t bodyStart = reader.position();
+  CborItem body;
+  if (!reader.next(body) || body.major != CBOR_MAP) {
+    return false;
+  }
+  bool haveOutputs = false;
+  bool ok = reader.forEach(body, [&]() {
+    uint64_t key;
+    if (!reader.readUnsigned(key)) {
+      return false;
+    }
+    if (key == BODY_OUTPUTS) {
+      haveOutputs = true;
+      return readOutputs(reader, target, out);
+    }
+    return reader.skip();
+  });
+  if (!ok || !haveOutputs) {
+    return false;
+  }
+  size_t bodyEnd = reader.position();
+
+  // The ID is the hash of the body exactly as encoded in the transaction
+  blake2b(cbor + bodyStart, bodyEnd - bodyStart, out.txId, TX_ID_SIZE);
+
+  // The rest only has to be well-formed, except is_valid (Alonzo and later,
+  // element 2 of 4). A transaction whose scripts failed still goes on chain,
+  // but only to take its collateral: none of its outputs (key 1) are
+  // created, only the collateral return (key 16), which can pay any address.
+  // Its outputs must not count as a payment.
+  for (uint64_t i = 1; i < tx.value; i++) {
+    if (i == 2 && tx.value == 4) {
+      CborItem isValid;
+      if (!reader.next(isValid) || isValid.major != CBOR_SIMPLE ||
+          isValid.value != CBOR_TRUE) {
+        return false;
+      }
+    } else if (!reader.skip()) {
+      return false;
+    }
+  }
+  return reader.atEnd();
+}
@@ -0,0 +1,32 @@
+#ifndef CBOR_TX_H
+#define CBOR_TX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Reads a Cardano transaction straight from its CBOR bytes, without building
+// a tree or copying anything: outputs are looked at in place and the
+// transaction ID is hashed over the body bytes as they are.
+
+#define TX_ID_SIZE 32
+#define MAX_TX_SIZE 16384 // Protocol limit for the size of a transaction
+
+// What a transaction pays to one address
+struct TxPayment {
+  uint8_t txId[TX_ID_SIZE];   // Blake2b-256 of the transaction body
+  int outputCount;            // All outputs of the transaction
+  int outputsToAddress;       // Outputs paying the address
+  uint64_t lovelaceToAddress; // Sum of the lovelace in those outputs
+  bool exactOutput;           // One of them has exactly the expected amount
+};
+
+// Walk a transaction (Shelley to Conway era) and find its outputs to an
+// address. address is the raw address (header byte + hashes), not bech32.
+// Returns false if the bytes are not a well-formed transaction, or if the
+// transaction failed script validation (is_valid false): on chain, such a
+// transaction creates none of its outputs.
+bool txFindPayment(const uint8_t *cbor, size_t length, const uint8_t *address,
+                   size_t addressLength, uint64_t expectedLovelace,
+                   TxPayment &out);
+
+#endif
@@ -2,8 +2,9 @@
  * Payment Request Handler
  * 
  * This module handles the creation of new payment requests through a modal dialog.
- * It converts ADA amounts to lovelace, sends POST requests to the API, and
- * triggers the transaction list refresh.
+ * Amounts can be entered in ADA (converted to lovelace here) or in the shop's
+ * currency (converted by the ESP32 with its cached ADA price). It sends POST
+ * requests to the API and triggers the transaction list refresh.
  */
 
 // Get references to DOM elements
@@ -12,45 +13,87 @@ const openBtn = document.getElementById('openPaymentModal');
 const cancelBtn = document.getElementById('cancelBtn');
 const form = document.getElementById('paymentForm');
 const amountInput = document.getElementById('adaAmount');
+const currencySelect = document.getElementById('amountCurrency');
+const priceHint = document.getElementById('priceHint');
 const submitBtn = form.querySelector('button[type="submit"]');
 
+// Load the cached ADA price from the ESP32 and offer the shop's currency
+// The ESP32 answers from memory, so this is fast and never calls the price API
+async function loadPrice() {
+    try {
+        const response = await fetch('/api/price');
+        const price = await response.json();
+        const code = price.currency.toUpperCase();
+        let option = currencySelect.querySelector(`option[value="${price.currency}"]`);
+
+        if (price.available) {
+            if (!option) {
+                option = document.createElement('option');
+                option.value = price.currency;
+                option.textContent = code;
+                currencySelect.appendChild(option);
+            }
+            priceHint.textContent = `1 ADA = ${price.rate} ${code} (${price.ageSeconds}s ago)`;
+        } else {
+            if (option) {
+                option.remove();
+            }
+            priceHint.textContent = `No current ADA price, ${code} amounts are unavailable`;
+        }
+    } catch (error) {
+        priceHint.textContent = '';
+        console.error('Error loading ADA price:', error.message);
+    }
+}
+
 // Open modal when "New Payment Request" button is clicked
 openBtn.addEventListener('click', () => {
     modal.showModal(); // Show the native <dialog> element
     amountInput.focus(); // Automatically focus the amount input field
+    loadPrice();
 });
 
 // Close modal when cancel button is clicked
 cancelBtn.addEventListener('click', () => modal.close());
 
 // Reset form when dialog closes (handles both cancel and successful submission)
-modal.addEventListener('close', () => form.reset());
+// The chosen currency is kept, cashiers usually stick to one
+modal.addEventListener('close', () => {
+    const currency = currencySelect.value;
+    form.reset();
+    currencySelect.value = currency;
+});
 
 // Handle form submission - creates a new payment request
 form.addEventListener('submit', async (e) => {
     e.preventDefault(); // Prevent default form submission behavior
 
-    // Validate and parse the ADA amount input
-    const adaAmount = parseFloat(amountInput.value);
-    if (isNaN(adaAmount) || adaAmount <= 0) {
-        console.log('Please enter a valid ADA amount greater than 0');
+    // Validate and parse the amount input
+    const enteredAmount = parseFloat(amountInput.value);
+    if (isNaN(enteredAmount) || enteredAmount <= 0) {
+        console.log('Please enter a valid amount greater than 0');
         return; // Exit early if validation fails
     }
 
-    // Convert ADA to lovelace (1 ADA = 1,000,000 lovelace)
-    // Math.round() ensures we get an integer value
-    const lovelaceAmount = Math.round(adaAmount * 1000000);
-
     // Get current timestamp in milliseconds (Unix timestamp)
     const timestamp = Date.now();
 
+    let requestData;
+    if (currencySelect.value === 'ada') {
+        // Convert ADA to lovelace (1 ADA = 1,000,000 lovelace)
+        // Math.round() ensures we get an integer value
+        const lovelaceAmount = Math.round(enteredAmount * 1000000);
+        requestData = { amount: lovelaceAmount, timestamp: timestamp };
+    } else {
+        // Fiat amounts are converted to lovelace by the ESP32
+        requestData = { fiat_amount: enteredAmount, timestamp: timestamp };
+    }
+
     // Disable submit button and show processing state
     submitBtn.disabled = true;
     submitBtn.textContent = 'Processing...';
 
     try {
-        // Prepare request data with amount in lovelace and timestamp
-        const requestData = { amount: lovelaceAmount, timestamp: timestamp };
         console.log('Sending request:', requestData);
 
         // Send POST request to create new transaction
@@ -2,13 +2,19 @@
  * Transaction List Handler
  * 
  * This module handles fetching and displaying transactions from the API.
- * It creates a table view of all transactions, automatically refreshes every
- * 30 seconds, and provides a manual refresh function for other modules.
+ * It creates a table view of all transactions, keeps it up to date through
+ * the /api/events Server-Sent Events stream (falling back to polling every
+ * 30 seconds while the stream is unavailable), and provides a manual refresh
+ * function for other modules. The sales summary above the table is refreshed
+ * together with the list.
  */
 
 // Get reference to the container element where transactions will be displayed
 const transactionsContainer = document.getElementById('transactionsContainer');
 
+// The transactions shown, as loaded from the API and updated by events
+let transactions = [];
+
 /**
  * Format timestamp to readable date string
  * Converts Unix timestamp (milliseconds) to localized date/time string
@@ -37,10 +43,11 @@ async function loadTransactions() {
         }
 
         // Parse JSON response
-        const transactions = await response.json();
+        transactions = await response.json();
 
         // Display transactions in the table
         displayTransactions(transactions);
+        loadStats();
     } catch (error) {
         // Log error and show error message in container
         console.error('Error loading transactions:', error);
@@ -48,6 +55,32 @@ async function loadTransactions() {
     }
 }
 
+/**
+ * Load the sales summary from GET /api/stats
+ * The ESP32 keeps these totals up to date as invoices are created and paid,
+ * so this is a small, fixed-size response however long the history gets.
+ */
+async function loadStats() {
+    try {
+        const response = await fetch('/api/stats');
+        if (!response.ok) {
+            throw new Error('Failed to fetch stats');
+        }
+        const stats = await response.json();
+
+        // Days are newest first and use UTC dates, like the device
+        const today = new Date().toISOString().slice(0, 10);
+        const todayStats = stats.days.find(day => day.date === today);
+
+        document.getElementById('statToday').textContent = todayStats ? todayStats.invoices : 0;
+        document.getElementById('statPaid').textContent = stats.paid;
+        document.getElementById('statUnpaid').textContent = stats.unpaid;
+        document.getElementById('statReceived').textContent = (stats.paidLovelace / 1000000).toFixed(2);
+    } catch (error) {
+        console.error('Error loading stats:', error);
+    }
+}
+
 /**
  * Display transactions in a table format
  * Creates a table with columns: ID, Amount (ADA), Timestamp, Transaction Hash
@@ -154,16 +187,108 @@ function stopTransactionPolling() {
     }
 }
 
-// Load transactions immediately when page loads
-loadTransactions();
+// Event stream connection (null while not connected)
+let eventSource = null;
 
-// Start automatic polling to keep transaction list updated
-startTransactionPolling();
+/**
+ * Apply an event from the device to the list shown
+ * Events carry what changed, so the list is updated in place instead of
+ * downloading all transactions again:
+ * - invoice-created: the new transaction object
+ * - payment-detected, hash-recorded: {"id": ..., "txHash": "..."}
+ * The sales summary is small, so it is reloaded when the totals change (new
+ * invoice, hash saved). A payment for a transaction we don't have means we
+ * missed events, and only then is the whole list loaded again.
+ *
+ * @param {string} type - Event name
+ * @param {Object} data - Event payload
+ */
+function applyEvent(type, data) {
+    if (type === 'invoice-created') {
+        if (!transactions.some(transaction => transaction.id === data.id)) {
+            transactions.push(data);
+            displayTransactions(transactions);
+        }
+        loadStats();
+        return;
+    }
+
+    const transaction = transactions.find(item => item.id === data.id);
+    if (!transaction) {
+        loadTransactions();
+        return;
+    }
+    if (transaction.txHash !== data.txHash) {
+        transaction.txHash = data.txHash;
+        displayTransactions(transactions);
+    }
+    if (type === 'hash-recorded') {
+        loadStats();
+    }
+}
+
+/**
+ * Subscribe to live updates from the device
+ * The device pushes an event whenever an invoice is created, a payment is
+ * detected on-chain, or the transaction hash is saved. Each event updates the
+ * list in place (applyEvent()), so updates show up immediately instead of on
+ * the next poll. The whole list is only loaded when the stream (re)opens, to
+ * catch up on what happened while it was down. Polling is only used as a
+ * fallback while the stream is disconnected.
+ */
+function startEventStream() {
+    // Older browsers without EventSource keep using polling
+    if (!window.EventSource) {
+        loadTransactions();
+        startTransactionPolling();
+        return;
+    }
+
+    eventSource = new EventSource('/api/events');
+
+    // Stream is up - no need to poll anymore
+    eventSource.addEventListener('open', () => {
+        console.log('Event stream connected');
+        stopTransactionPolling();
+        // Catch up on anything that happened while disconnected
+        loadTransactions();
+    });
+
+    // Stream lost (or never opened) - poll until the browser reconnects it
+    eventSource.addEventListener('error', () => {
+        console.log('Event stream disconnected, polling until it comes back');
+        if (!pollingInterval) {
+            startTransactionPolling();
+            loadTransactions();
+        }
+    });
+
+    ['invoice-created', 'payment-detected', 'hash-recorded'].forEach(type => {
+        eventSource.addEventListener(type, event => {
+            console.log(`Event ${type}:`, event.data);
+            try {
+                applyEvent(type, JSON.parse(event.data));
+            } catch (error) {
+                console.error('Bad event data:', error);
+                loadTransactions();
+            }
+        });
+    });
+}
+
+// Load the transactions as soon as the event stream opens (or fails to),
+// and keep the list updated through it
+startEventStream();
 
 /**
  * Expose refresh function globally for other modules
  * This allows requestPayment.js to manually refresh the transaction list
- * after creating a new payment request, providing immediate feedback
+ * after creating a new payment request, providing immediate feedback.
+ * While the event stream is open, its invoice-created event already added
+ * the new transaction, so nothing is loaded.
  */
-window.refreshTransactions = loadTransactions;
-
+window.refreshTransactions = () => {
+    if (!eventSource || eventSource.readyState !== EventSource.OPEN) {
+        loadTransactions();
+    }
+};
@@ -0,0 +1,220 @@
+#include "event_stream.h"
+
+// Host builds write through the in-memory WiFiClient, which never waits
+#ifndef HOST_SIM
+#include <errno.h>
+#include <lwip/sockets.h>
+#endif
+
+namespace {
+// Maximum number of browsers that can listen at the same time
+const int MAX_CLIENTS = 4;
+
+// Bytes of unsent events kept per client. A client whose backlog does not
+// fit in here is too slow to keep up and gets disconnected.
+const size_t CLIENT_BUFFER_SIZE = 1024;
+
+// Maximum bytes written to one client per loop() call
+// Keeps a single client from holding up the rest of the loop
+const size_t MAX_WRITE_PER_LOOP = 512;
+
+// Send a comment line this often so dead connections are noticed
+const unsigned long KEEPALIVE_INTERVAL = 15000; // 15 seconds
+
+// A client whose socket takes no bytes for this long has stopped reading
+const unsigned long STALL_TIMEOUT = 10000; // 10 seconds
+
+struct EventClient {
+  WiFiClient client;
+  bool active;
+  char buffer[CLIENT_BUFFER_SIZE];
+  size_t length;              // Bytes waiting in buffer
+  bool stalled;               // The socket took nothing on the last try
+  unsigned long stalledSince; // millis() of the first try it took nothing
+};
+
+EventClient clients[MAX_CLIENTS];
+unsigned long lastKeepaliveTime = 0;
+unsigned long nextEventId = 1;
+
+void dropClient(EventClient &slot, const char *reason) {
+  slot.client.stop();
+  slot.active = false;
+  slot.length = 0;
+  slot.stalled = false;
+  Serial.print("[Events] Client dropped: ");
+  Serial.println(reason);
+}
+
+// Append raw bytes to a client's buffer, false if they don't fit
+bool enqueue(EventClient &slot, const char *data, size_t length) {
+  if (slot.length + length > CLIENT_BUFFER_SIZE) {
+    return false;
+  }
+  memcpy(slot.buffer + slot.length, data, length);
+  slot.length += length;
+  return true;
+}
+
+// Queue the same bytes for every client, dropping the ones that are full
+void enqueueAll(const char *data, size_t length) {
+  for (int i = 0; i < MAX_CLIENTS; i++) {
+    if (clients[i].active && !enqueue(clients[i], data, length)) {
+      dropClient(clients[i], "buffer full (slow client)");
+    }
+  }
+}
+
+// Hand bytes to the socket without waiting for room. Returns how many it
+// took (0 if it has no room now), or -1 if the connection failed.
+// WiFiClient::write() is no use here: on the ESP32 it waits up to seconds
+// for lwIP to take the bytes, and a browser that stops reading would hold
+// up the whole loop() (web requests, payment checks, the display).
+int sendNow(WiFiClient &client, const uint8_t *data, size_t length) {
+#ifndef HOST_SIM
+  const int sent = send(client.fd(), data, length, MSG_DONTWAIT);
+  if (sent < 0) {
+    return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+  }
+  return sent;
+#else
+  return client.connected() ? (int)client.write(data, length) : -1;
+#endif
+}
+
+// Write up to MAX_WRITE_PER_LOOP bytes of the buffer to the socket, as much
+// as it takes now. A client whose socket takes nothing while its buffer is
+// full, or for STALL_TIMEOUT, is not reading and is dropped.
+void flushClient(EventClient &slot) {
+  if (!slot.client.connected()) {
+    dropClient(slot, "disconnected");
+    return;
+  }
+  if (slot.length == 0) {
+    return;
+  }
+
+  size_t chunk = slot.length;
+  if (chunk > MAX_WRITE_PER_LOOP) {
+    chunk = MAX_WRITE_PER_LOOP;
+  }
+  const int written = sendNow(slot.client, (const uint8_t *)slot.buffer, chunk);
+  if (written < 0) {
+    dropClient(slot, "send failed");
+    return;
+  }
+  if (written == 0) {
+    const unsigned long now = millis();
+    if (!slot.stalled) {
+      slot.stalled = true;
+      slot.stalledSince = now;
+    }
+    if (slot.length == CLIENT_BUFFER_SIZE) {
+      dropClient(slot, "buffer full (not reading)");
+    } else if ((uint32_t)(now - slot.stalledSince) >= STALL_TIMEOUT) {
+      dropClient(slot, "not reading");
+    }
+    return;
+  }
+  slot.stalled = false;
+  // Shift remaining bytes to the front of the buffer
+  memmove(slot.buffer, slot.buffer + written, slot.length - written);
+  slot.length -= written;
+}
+} // namespace
+
+bool eventStreamHasCapacity() {
+  for (int i = 0; i < MAX_CLIENTS; i++) {
+    if (!clients[i].active) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool eventStreamAccept(WiFiClient client) {
+  for (int i = 0; i < MAX_CLIENTS; i++) {
+    EventClient &slot = clients[i];
+    if (slot.active) {
+      continue;
+    }
+
+    slot.client = client;
+    slot.client.setNoDelay(true);
+    slot.active = true;
+    slot.length = 0;
+    slot.stalled = false;
+
+    // Response headers are written by hand because the connection stays
+    // open after the request handler returns
+    const char *headers = "HTTP/1.1 200 OK\r\n"
+                          "Content-Type: text/event-stream\r\n"
+                          "Cache-Control: no-cache\r\n"
+                          "Connection: keep-alive\r\n"
+                          "Access-Control-Allow-Origin: *\r\n"
+                          "\r\n"
+                          "retry: 3000\n\n";
+    enqueue(slot, headers, strlen(headers));
+    flushClient(slot);
+
+    Serial.print("[Events] Client connected from ");
+    Serial.print(client.remoteIP());
+    Serial.print(" (");
+    Serial.print(eventStreamClientCount());
+    Serial.println(" listening)");
+    return true;
+  }
+  return false;
+}
+
+void eventStreamPublish(const char *event, const String &jsonData) {
+  if (eventStreamClientCount() == 0) {
+    return;
+  }
+
+  // Server-Sent Events frame:
+  //   event: <name>
+  //   id: <sequence number>
+  //   data: <json>
+  //   <blank line>
+  String frame = "event: ";
+  frame += event;
+  frame += "\nid: ";
+  frame += String(nextEventId++);
+  frame += "\ndata: ";
+  frame += jsonData;
+  frame += "\n\n";
+
+  enqueueAll(frame.c_str(), frame.length());
+
+  Serial.print("[Events] Published ");
+  Serial.print(event);
+  Serial.print(" to ");
+  Serial.print(eventStreamClientCount());
+  Serial.println(" client(s)");
+}
+
+void eventStreamLoop() {
+  unsigned long currentTime = millis();
+  if ((uint32_t)(currentTime - lastKeepaliveTime) >= KEEPALIVE_INTERVAL) {
+    lastKeepaliveTime = currentTime;
+    const char *keepalive = ": keepalive\n\n";
+    enqueueAll(keepalive, strlen(keepalive));
+  }
+
+  for (int i = 0; i < MAX_CLIENTS; i++) {
+    if (clients[i].active) {
+      flushClient(clients[i]);
+    }
+  }
+}
+
+int eventStreamClientCount() {
+  int count = 0;
+  for (int i = 0; i < MAX_CLIENTS; i++) {
+    if (clients[i].active) {
+      count++;
+    }
+  }
+  return count;
+}
@@ -0,0 +1,31 @@
+#ifndef EVENT_STREAM_H
+#define EVENT_STREAM_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+// Event names pushed to connected browsers
+#define EVENT_INVOICE_CREATED "invoice-created"
+#define EVENT_PAYMENT_DETECTED "payment-detected"
+#define EVENT_HASH_RECORDED "hash-recorded"
+
+// Check if there is a free slot for another event stream client
+bool eventStreamHasCapacity();
+
+// Take over a client connection and start streaming events to it
+// Sends the text/event-stream response headers, returns false if no slot is
+// free
+bool eventStreamAccept(WiFiClient client);
+
+// Queue an event for every connected client
+// event: Event name (e.g. EVENT_INVOICE_CREATED)
+// jsonData: Event payload, a single-line JSON string
+void eventStreamPublish(const char *event, const String &jsonData);
+
+// Flush queued events and drop dead or slow clients (call in loop())
+void eventStreamLoop();
+
+// Number of currently connected clients
+int eventStreamClientCount();
+
+#endif
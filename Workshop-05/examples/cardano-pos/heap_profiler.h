@@ -0,0 +1,143 @@
+/**
+ * heap_profiler.h - Header file for watching the heap and who uses it
+ *
+ * The ESP32 has about 300 KB of heap, shared by WiFi, TLS, ArduinoJson
+ * documents, Strings and sprites. Running out is not the only problem: the
+ * free memory can be split into many small holes between blocks still in
+ * use. Then a 16 KB TLS buffer cannot be allocated although 60 KB are free,
+ * and the fetch fails after days of running fine. This module keeps an eye
+ * on both.
+ *
+ * Every few minutes it takes a sample: free bytes, the largest block that
+ * can still be allocated, the lowest free heap since boot and the number of
+ * holes. From free bytes and largest block it computes the fragmentation:
+ *
+ *   fragmentation = 100% - largest block / free bytes
+ *
+ * 0% is one free area, 50% means the largest allocation possible is half of
+ * what is free. Each sample is printed to Serial:
+ *
+ *   [Heap] free 142.3 KB, largest 98.1 KB, min 61.4 KB, 12 holes, frag 31%
+ *
+ * Code that allocates marks itself with a tag (what part of the firmware it
+ * belongs to) and a name:
+ *
+ *   void fetchMinswapData() {
+ *     HEAP_SCOPE(HEAP_FETCHER, "minswap");
+ *     ...
+ *   }
+ *
+ * For each site the profiler counts the calls, the bytes it kept (free heap
+ * before the call minus after) and how far it pushed the lowest free heap
+ * down. heapProfilerReport() ranks the sites by that. In host builds (see
+ * host-sim) the simulated heap counts every allocation made in a site, so
+ * the report also shows allocations, bytes allocated and peak per site.
+ *
+ * A scope reads the free heap twice, which takes well under a microsecond.
+ * Scopes are for the Arduino loop task only.
+ */
+
+#ifndef HEAP_PROFILER_H
+#define HEAP_PROFILER_H
+
+#include <Arduino.h>
+
+// The parts of the firmware an allocation site belongs to
+enum HeapTag {
+  HEAP_FETCHER, // API requests and parsing their responses
+  HEAP_TICKER,  // The scrolling ticker
+  HEAP_SCREENS, // Drawing the data screens
+  HEAP_WEB,     // The web server
+  HEAP_POS,     // Invoices, QR codes, payments
+  HEAP_OTHER,
+  HEAP_TAG_COUNT
+};
+
+// Samples kept for heapProfilerToJson(): 144 at 10 minutes is a day
+#define HEAP_PROFILER_HISTORY 144
+
+// One place that allocates, declared by HEAP_SCOPE
+struct HeapSite {
+  const char *name;
+  HeapTag tag;
+  uint32_t calls;
+  int32_t retainedBytes;  // Free heap before minus after, summed up
+  uint32_t lowWaterBytes; // How far the lowest free heap fell inside it
+  HeapSite *next;         // All sites, for the report
+
+  HeapSite(const char *siteName, HeapTag siteTag);
+};
+
+// The heap at one moment
+struct HeapSample {
+  unsigned long atMs = 0;
+  uint32_t freeBytes = 0;
+  uint32_t largestBlock = 0; // Largest allocation that would succeed
+  uint32_t minFreeBytes = 0; // Lowest since boot
+  uint32_t freeBlocks = 0;   // Holes the free bytes are split into
+  uint8_t fragmentation = 0; // Percent, see above
+  uint32_t allocations = 0;  // Since the previous sample (host builds only)
+};
+
+/**
+ * Start sampling (call once in setup())
+ *
+ * @param intervalMs Time between two samples
+ */
+void heapProfilerBegin(unsigned long intervalMs = 600000UL);
+
+/**
+ * Take a sample when one is due (call in loop())
+ */
+void heapProfilerLoop();
+
+/**
+ * Take a sample now (also kept in the history)
+ */
+HeapSample heapProfilerSample();
+
+/**
+ * The most recent sample
+ */
+HeapSample heapProfilerLast();
+
+/**
+ * Oldest and most recent fragmentation in the history, in percent
+ *
+ * The difference tells whether fragmentation keeps growing.
+ */
+void heapProfilerFragmentationTrend(uint8_t &first, uint8_t &last);
+
+/**
+ * Print the sites ranked by how much heap they took, with totals per tag
+ *
+ * @param out Where to write, e.g. Serial
+ * @param maxSites Sites to list
+ */
+void heapProfilerReport(Print &out, int maxSites = 10);
+
+/**
+ * The samples and the sites as JSON (for GET /api/heap)
+ */
+String heapProfilerToJson();
+
+// Counts one call of a site (HEAP_SCOPE)
+class HeapScope {
+public:
+  explicit HeapScope(HeapSite &site);
+  ~HeapScope();
+
+private:
+  HeapSite &site_;
+  uint32_t freeBefore_;
+  uint32_t minFreeBefore_;
+  const void *previousSite_; // Host builds: the enclosing site
+};
+
+#define HEAP_CONCAT2(a, b) a##b
+#define HEAP_CONCAT(a, b) HEAP_CONCAT2(a, b)
+#define HEAP_SCOPE(tag, name)                                                  \
+  static HeapSite HEAP_CONCAT(heapSite, __LINE__)(name, tag);                  \
+  HeapScope HEAP_CONCAT(heapScope, __LINE__)(HEAP_CONCAT(heapSite, __LINE__))
+
+#endif
@@ -0,0 +1,180 @@
+#include "invoice_address.h"
+#include "cardano_crypto.h"
+#include "secrets.h"
+#include <ArduinoJson.h>
+#include <LittleFS.h>
+
+// Network of the derived addresses: 0 = preprod/preview, 1 = mainnet
+#ifndef CARDANO_NETWORK_ID
+#define CARDANO_NETWORK_ID 0
+#endif
+
+namespace {
+const char *INDEX_FILE = "/address_index.bin";
+const char *TRANSACTIONS_FILE = "/transactions.json";
+
+// CIP-1852 roles below the account key
+const uint32_t ROLE_EXTERNAL = 0; // Receive addresses
+const uint32_t ROLE_STAKING = 2;  // Stake key
+
+bool enabled = false;
+ExtendedPublicKey externalChain;    // account/0, parent of every address
+uint8_t stakeKeyHash[KEY_HASH_SIZE]; // account/2/0, same for all addresses
+uint32_t nextIndex = 0;
+
+// Address of nextIndex, derived by invoiceAddressLoop() before it is needed
+char preparedAddress[INVOICE_ADDRESS_SIZE];
+bool addressPrepared = false;
+
+bool saveNextIndex() {
+  File file = LittleFS.open(INDEX_FILE, "w");
+  if (!file) {
+    return false;
+  }
+  uint8_t bytes[4];
+  for (int i = 0; i < 4; i++) {
+    bytes[i] = (uint8_t)(nextIndex >> (8 * i));
+  }
+  bool written = file.write(bytes, sizeof(bytes)) == sizeof(bytes);
+  file.close();
+  return written;
+}
+
+bool loadNextIndex() {
+  File file = LittleFS.open(INDEX_FILE, "r");
+  if (!file) {
+    return false;
+  }
+  uint8_t bytes[4];
+  bool complete = file.read(bytes, sizeof(bytes)) == sizeof(bytes);
+  file.close();
+  if (!complete) {
+    return false;
+  }
+  nextIndex = 0;
+  for (int i = 3; i >= 0; i--) {
+    nextIndex = (nextIndex << 8) | bytes[i];
+  }
+  return true;
+}
+
+// Without a saved index (first start, or LittleFS was erased), continue after
+// the highest index in transactions.json so no address is used twice
+void recoverNextIndex() {
+  nextIndex = 0;
+  File file = LittleFS.open(TRANSACTIONS_FILE, "r");
+  if (!file) {
+    return;
+  }
+  DynamicJsonDocument doc(4096);
+  DeserializationError error = deserializeJson(doc, file);
+  file.close();
+  if (error) {
+    Serial.print("[Address] Could not read transactions: ");
+    Serial.println(error.c_str());
+    return;
+  }
+  for (JsonObject tx : doc.as<JsonArray>()) {
+    if (tx.containsKey("addressIndex")) {
+      uint32_t index = tx["addressIndex"].as<uint32_t>();
+      if (index >= nextIndex) {
+        nextIndex = index + 1;
+      }
+    }
+  }
+}
+} // namespace
+
+bool invoiceAddressSetup() {
+#ifdef ACCOUNT_XPUB
+  ExtendedPublicKey account;
+  ExtendedPublicKey stakingChain;
+  ExtendedPublicKey stakeKey;
+  if (!parseExtendedPublicKey(ACCOUNT_XPUB, account)) {
+    Serial.println("[Address] ACCOUNT_XPUB is not a valid account public key");
+    enabled = false;
+    return false;
+  }
+
+  // Derive the two keys shared by all invoices once, so each invoice only
+  // needs one more derivation
+  if (!deriveChildKey(account, ROLE_EXTERNAL, externalChain) ||
+      !deriveChildKey(account, ROLE_STAKING, stakingChain) ||
+      !deriveChildKey(stakingChain, 0, stakeKey)) {
+    Serial.println("[Address] Key derivation failed");
+    enabled = false;
+    return false;
+  }
+  publicKeyHash(stakeKey.key, stakeKeyHash);
+
+  if (!loadNextIndex()) {
+    recoverNextIndex();
+    saveNextIndex();
+  }
+  enabled = true;
+  addressPrepared = false;
+  invoiceAddressLoop();
+
+  Serial.print("[Address] Per-invoice addresses enabled, next index ");
+  Serial.println(nextIndex);
+  return true;
+#else
+  enabled = false;
+  return false;
+#endif
+}
+
+void invoiceAddressLoop() {
+  if (!enabled || addressPrepared) {
+    return;
+  }
+  unsigned long start = micros();
+  addressPrepared = invoiceAddressForIndex(nextIndex, preparedAddress,
+                                           sizeof(preparedAddress));
+  Serial.print("[Address] Prepared address ");
+  Serial.print(nextIndex);
+  Serial.print(" in ");
+  Serial.print(micros() - start);
+  Serial.println(" us");
+}
+
+bool invoiceAddressEnabled() { return enabled; }
+
+bool invoiceAddressNext(uint32_t &index, char *address, size_t addressSize) {
+  if (!enabled) {
+    return false;
+  }
+  // Normally prepared already, unless invoices come faster than loop() runs
+  if (!addressPrepared) {
+    invoiceAddressLoop();
+  }
+  if (!addressPrepared || strlen(preparedAddress) >= addressSize) {
+    return false;
+  }
+
+  index = nextIndex;
+  nextIndex++;
+  if (!saveNextIndex()) {
+    Serial.println("[Address] Error saving address index");
+    nextIndex--;
+    return false;
+  }
+  strcpy(address, preparedAddress);
+  addressPrepared = false;
+  return true;
+}
+
+bool invoiceAddressForIndex(uint32_t index, char *address,
+                            size_t addressSize) {
+  if (!enabled) {
+    return false;
+  }
+  ExtendedPublicKey paymentKey;
+  if (!deriveChildKey(externalChain, index, paymentKey)) {
+    return false;
+  }
+  uint8_t paymentKeyHash[KEY_HASH_SIZE];
+  publicKeyHash(paymentKey.key, paymentKeyHash);
+  return encodeBaseAddress(CARDANO_NETWORK_ID, paymentKeyHash, stakeKeyHash,
+                           address, addressSize);
+}
@@ -0,0 +1,28 @@
+#ifndef INVOICE_ADDRESS_H
+#define INVOICE_ADDRESS_H
+
+#include <Arduino.h>
+
+// Buffer size for an invoice address (bech32 base address plus '\0')
+#define INVOICE_ADDRESS_SIZE 112
+
+// Set up per-invoice payment addresses from ACCOUNT_XPUB in secrets.h
+// (call after LittleFS is mounted). Returns true if they are in use; without
+// ACCOUNT_XPUB every invoice is paid to PAYMENT_ADDRESS as before.
+bool invoiceAddressSetup();
+
+// Derive the next address ahead of time (call in loop())
+// Keeps the key derivation out of the POST /api/transactions handler.
+void invoiceAddressLoop();
+
+// Check if invoices get their own payment address
+bool invoiceAddressEnabled();
+
+// Hand out the next unused address index and its address
+// The index is saved before returning, so it is never handed out twice.
+bool invoiceAddressNext(uint32_t &index, char *address, size_t addressSize);
+
+// Derive the address of an index that was handed out before
+bool invoiceAddressForIndex(uint32_t index, char *address, size_t addressSize);
+
+#endif
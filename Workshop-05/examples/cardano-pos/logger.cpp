@@ -0,0 +1,227 @@
+/**
+ * logger.cpp - Implementation of the logger
+ *
+ * The ring is a bounded queue with a sequence number per slot (after
+ * Dmitry Vyukov): a task that logs claims the next slot with one
+ * compare-and-swap, formats its message into it and then marks it done by
+ * setting the slot's sequence number. Several tasks can log at the same
+ * time without a lock, and none of them ever waits: when the slot is still
+ * taken by an unwritten message, the ring is full and the message is
+ * dropped. Only the background task reads, in order, and hands each slot
+ * back once its message is on the wire.
+ *
+ * Messages are formatted by the caller, so %s arguments may point to
+ * temporary Strings.
+ */
+
+#include "logger.h"
+
+#include <atomic>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+// Host builds have no FreeRTOS; loggerLoop() writes the ring there
+#ifndef HOST_SIM
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+namespace {
+
+static_assert((LOG_RING_MESSAGES & (LOG_RING_MESSAGES - 1)) == 0,
+              "LOG_RING_MESSAGES must be a power of two");
+
+// When the ring is empty, the background task looks again after this long
+const uint32_t DRAIN_INTERVAL_MS = 10;
+
+// Longest line written to Serial: time, level, module, message, newline
+const size_t LINE_SIZE = LOG_MESSAGE_SIZE + 40;
+
+struct Slot {
+  // For the message at position pos: pos while the slot is free for it,
+  // pos + 1 once it is written, pos + LOG_RING_MESSAGES once it was read.
+  // Stored minus the slot's index, so the zeroed static memory is already
+  // the right start (slot i free for position i) and no setup is needed
+  // before the first message.
+  std::atomic<uint32_t> sequence;
+  uint32_t ms;
+  uint8_t level;
+  const char *module;
+  char text[LOG_MESSAGE_SIZE];
+};
+
+Slot slots[LOG_RING_MESSAGES];
+std::atomic<uint32_t> writePosition{0}; // Next slot to claim
+std::atomic<uint32_t> readPosition{0};  // Next slot to read
+
+std::atomic<uint32_t> messageCount{0};
+std::atomic<uint32_t> droppedCount{0};
+std::atomic<uint32_t> truncatedCount{0};
+uint32_t droppedReported = 0; // Background task only
+uint32_t bytesWritten = 0;
+
+const char LEVEL_LETTERS[] = {'-', 'E', 'W', 'I', 'D', 'V'};
+
+uint32_t indexOf(uint32_t position) {
+  return position & (LOG_RING_MESSAGES - 1);
+}
+
+uint32_t loadSequence(uint32_t index) {
+  return slots[index].sequence.load(std::memory_order_acquire) + index;
+}
+
+void storeSequence(uint32_t index, uint32_t sequence) {
+  slots[index].sequence.store(sequence - index, std::memory_order_release);
+}
+
+// One line as it goes to Serial
+size_t formatLine(char *line, uint32_t ms, uint8_t level, const char *module,
+                  const char *text) {
+  const char letter = level < sizeof(LEVEL_LETTERS) ? LEVEL_LETTERS[level]
+                                                    : '?';
+  int length = snprintf(line, LINE_SIZE, "%lu.%03lu %c %s: %s\n",
+                        (unsigned long)(ms / 1000), (unsigned long)(ms % 1000),
+                        letter, module, text);
+  if (length < 0) {
+    return 0;
+  }
+  return (size_t)length < LINE_SIZE ? (size_t)length : LINE_SIZE - 1;
+}
+
+// Serial takes the line without waiting, or waiting is fine
+bool fits(size_t length, bool wait) {
+  return wait || Serial.availableForWrite() >= (int)length;
+}
+
+// Write messages until the ring is empty, or until Serial would have to
+// wait (when wait is false). Dropped messages are reported in front of the
+// next message.
+void drain(bool wait) {
+  char line[LINE_SIZE];
+  for (;;) {
+    const uint32_t dropped = droppedCount.load(std::memory_order_relaxed);
+    if (dropped != droppedReported) {
+      char text[40];
+      snprintf(text, sizeof(text), "%lu messages dropped",
+               (unsigned long)(dropped - droppedReported));
+      const size_t length =
+          formatLine(line, millis(), LOG_LEVEL_WARN, "log", text);
+      if (!fits(length, wait)) {
+        return;
+      }
+      Serial.write((const uint8_t *)line, length);
+      bytesWritten += length;
+      droppedReported = dropped;
+    }
+
+    const uint32_t position = readPosition.load(std::memory_order_relaxed);
+    const uint32_t index = indexOf(position);
+    const Slot &slot = slots[index];
+    if (loadSequence(index) != position + 1) {
+      return; // Empty, or the next message is still being written
+    }
+    const size_t length =
+        formatLine(line, slot.ms, slot.level, slot.module, slot.text);
+    if (!fits(length, wait)) {
+      return;
+    }
+    Serial.write((const uint8_t *)line, length);
+    bytesWritten += length;
+    // Hand the slot back for the message LOG_RING_MESSAGES positions later
+    storeSequence(index, position + LOG_RING_MESSAGES);
+    readPosition.store(position + 1, std::memory_order_release);
+  }
+}
+
+#ifndef HOST_SIM
+TaskHandle_t drainTaskHandle = nullptr;
+
+void drainTask(void *) {
+  for (;;) {
+    drain(true);
+    vTaskDelay(pdMS_TO_TICKS(DRAIN_INTERVAL_MS));
+  }
+}
+#endif
+
+} // namespace
+
+void logWrite(uint8_t level, const char *module, const char *format, ...) {
+  uint32_t position = writePosition.load(std::memory_order_relaxed);
+  uint32_t index;
+  for (;;) {
+    index = indexOf(position);
+    const int32_t difference = (int32_t)(loadSequence(index) - position);
+    if (difference == 0) {
+      // Free: claim it (on failure position is reloaded, try again)
+      if (writePosition.compare_exchange_weak(position, position + 1,
+                                              std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (difference < 0) {
+      // Still holds a message LOG_RING_MESSAGES positions back: full
+      droppedCount.fetch_add(1, std::memory_order_relaxed);
+      return;
+    } else {
+      // Another task claimed it first
+      position = writePosition.load(std::memory_order_relaxed);
+    }
+  }
+
+  Slot *slot = &slots[index];
+  slot->ms = millis();
+  slot->level = level;
+  slot->module = module;
+  va_list arguments;
+  va_start(arguments, format);
+  const int length =
+      vsnprintf(slot->text, LOG_MESSAGE_SIZE, format, arguments);
+  va_end(arguments);
+  if (length >= LOG_MESSAGE_SIZE) {
+    memcpy(slot->text + LOG_MESSAGE_SIZE - 4, "...", 4);
+    truncatedCount.fetch_add(1, std::memory_order_relaxed);
+  }
+  messageCount.fetch_add(1, std::memory_order_relaxed);
+  storeSequence(index, position + 1);
+}
+
+void loggerBegin() {
+#ifndef HOST_SIM
+  // Lowest priority above idle: it only runs when nothing else has to
+  if (drainTaskHandle == nullptr) {
+    xTaskCreatePinnedToCore(drainTask, "logger", 3072, nullptr, 1,
+                            &drainTaskHandle, 0);
+  }
+#endif
+}
+
+void loggerLoop() {
+#ifdef HOST_SIM
+  drain(false);
+#endif
+}
+
+void loggerFlush() {
+#ifndef HOST_SIM
+  if (drainTaskHandle != nullptr) {
+    // The background task is the only reader: wait until it wrote what is
+    // in the ring now
+    const uint32_t end = writePosition.load(std::memory_order_relaxed);
+    while ((int32_t)(readPosition.load(std::memory_order_acquire) - end) < 0) {
+      delay(1);
+    }
+    return;
+  }
+#endif
+  drain(true);
+}
+
+LoggerStats loggerStats() {
+  LoggerStats stats;
+  stats.messages = messageCount.load(std::memory_order_relaxed);
+  stats.dropped = droppedCount.load(std::memory_order_relaxed);
+  stats.truncated = truncatedCount.load(std::memory_order_relaxed);
+  stats.bytes = bytesWritten;
+  return stats;
+}
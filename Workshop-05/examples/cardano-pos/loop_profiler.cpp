@@ -0,0 +1,354 @@
+/**
+ * loop_profiler.cpp - Implementation of the loop() profiler
+ *
+ * Times are taken from the CPU's cycle counter (ESP.getCycleCount()), which
+ * counts at the CPU clock (240 MHz) and is read in a few cycles. It wraps
+ * around every 17.9 s, so for anything longer millis() is used instead.
+ *
+ * Percentiles come from a histogram per section instead of a list of all
+ * times: 4 buckets per doubling (0, 1, 2, 3, 4, 5, 6, 7, 8-9, 10-11, 12-13,
+ * 14-15, 16-19 us ...) up to 33 s, 96 counters in all. A percentile is the top of
+ * its bucket, so it is at most 25% too high.
+ *
+ * Everything runs in the Arduino loop task, so no locking is needed.
+ */
+
+#include "loop_profiler.h"
+
+#include <string.h>
+
+namespace {
+
+// Past this, the cycle counter may have wrapped around (it does every
+// 17.9 s at 240 MHz), so millis() is used
+const unsigned long CYCLE_COUNTER_MAX_MS = 10000UL;
+
+// At most one stall line per second, so a budget that is too tight does
+// not flood Serial (the stalls are still counted)
+const unsigned long STALL_LOG_INTERVAL_MS = 1000UL;
+
+// Sections in a stall line are left out when shorter than this
+const uint32_t STALL_LOG_MIN_MICROS = 100;
+
+const int BUCKETS = 96;
+
+// Time of one section, summed up over a window
+struct Window {
+  uint32_t calls;
+  uint32_t maxMicros;
+  uint64_t totalMicros;
+  uint32_t buckets[BUCKETS];
+};
+
+// Index sectionCount is "other", sectionCount + 1 is loop() as a whole
+const char *sectionNames[LOOP_PROFILER_MAX_SECTIONS + 2];
+int sectionCount = 0;
+Window windows[LOOP_PROFILER_MAX_SECTIONS + 2];
+LoopSectionStats published[LOOP_PROFILER_MAX_SECTIONS + 2];
+
+uint32_t budgetMicros = 0;
+uint32_t cyclesPerMicro = 240;
+
+bool running = false;             // loopProfilerStart() was called before
+uint32_t loopStartCycles = 0;     // At loopProfilerStart()
+unsigned long loopStartMs = 0;
+uint32_t markCycles = 0;          // At the last mark
+unsigned long markMs = 0;
+uint32_t loopMicros[LOOP_PROFILER_MAX_SECTIONS + 1]; // This loop(), "other"
+                                                     // included
+unsigned long windowStartMs = 0;
+
+uint32_t stallCount = 0;   // Since loopProfilerBegin()
+uint32_t windowStalls = 0; // In this window
+LoopStall lastStall;
+unsigned long stallLoggedMs = 0;
+bool stallLogged = false;
+uint32_t stallsNotLogged = 0;
+
+// Microseconds between two marks
+uint32_t elapsedMicros(uint32_t fromCycles, unsigned long fromMs,
+                       uint32_t toCycles, unsigned long toMs) {
+  // 32 bits like millis(): right across its wrap-around after 49.7 days
+  // (also in host builds, where unsigned long is 64 bits)
+  const unsigned long ms = (uint32_t)(toMs - fromMs);
+  if (ms >= CYCLE_COUNTER_MAX_MS) {
+    return ms < 4294967UL ? ms * 1000UL : 0xFFFFFFFFUL;
+  }
+  return (toCycles - fromCycles) / cyclesPerMicro;
+}
+
+int bucketOf(uint32_t micros) {
+  if (micros < 4) {
+    return micros;
+  }
+  const int octave = 31 - __builtin_clz(micros); // 2 for 4-7 us
+  const int bucket = 4 * (octave - 1) + ((micros >> (octave - 2)) & 3);
+  return bucket < BUCKETS ? bucket : BUCKETS - 1;
+}
+
+// Longest time that falls into a bucket
+uint32_t bucketTop(int bucket) {
+  if (bucket < 4) {
+    return bucket;
+  }
+  const int octave = bucket / 4 + 1;
+  return ((uint32_t)(5 + bucket % 4) << (octave - 2)) - 1;
+}
+
+void record(int index, uint32_t micros) {
+  Window &window = windows[index];
+  window.calls++;
+  window.totalMicros += micros;
+  if (micros > window.maxMicros) {
+    window.maxMicros = micros;
+  }
+  window.buckets[bucketOf(micros)]++;
+}
+
+uint32_t percentile99(const Window &window) {
+  if (window.calls == 0) {
+    return 0;
+  }
+  // Rank of the 99th percentile, rounded up
+  const uint32_t rank = window.calls - window.calls / 100;
+  uint32_t seen = 0;
+  for (int bucket = 0; bucket < BUCKETS; bucket++) {
+    seen += window.buckets[bucket];
+    if (seen >= rank) {
+      const uint32_t top = bucketTop(bucket);
+      return top < window.maxMicros ? top : window.maxMicros;
+    }
+  }
+  return window.maxMicros;
+}
+
+void printRow(const LoopSectionStats &stats) {
+  Serial.printf("[Loop]   %-10s max %7.1f ms  p99 %7.1f ms  %5.1f%%\n",
+                stats.name, stats.maxMicros / 1000.0, stats.p99Micros / 1000.0,
+                stats.sharePercent);
+}
+
+// Publish the window's statistics, print them and start the next window
+void finishWindow(unsigned long nowMs) {
+  const uint32_t windowMs = (uint32_t)(nowMs - windowStartMs);
+  const uint64_t windowMicros = (uint64_t)windowMs * 1000ULL;
+  for (int i = 0; i < sectionCount + 2; i++) {
+    const Window &window = windows[i];
+    LoopSectionStats &stats = published[i];
+    stats.name = sectionNames[i];
+    stats.calls = window.calls;
+    stats.maxMicros = window.maxMicros;
+    stats.p99Micros = percentile99(window);
+    stats.sharePercent =
+        windowMicros > 0 ? (float)(window.totalMicros * 100.0 / windowMicros)
+                         : 0.0f;
+  }
+
+  const LoopSectionStats &loop = published[sectionCount + 1];
+  const uint32_t stalls = windowStalls;
+  Serial.printf("[Loop] last %lu s: %lu loops, max %.1f ms, p99 %.1f ms, "
+                "%lu stall%s\n",
+                (unsigned long)(windowMs / 1000UL), (unsigned long)loop.calls,
+                loop.maxMicros / 1000.0, loop.p99Micros / 1000.0,
+                (unsigned long)stalls, stalls == 1 ? "" : "s");
+  for (int i = 0; i <= sectionCount; i++) {
+    printRow(published[i]);
+  }
+
+  memset(windows, 0, sizeof(windows));
+  windowStalls = 0;
+  windowStartMs = nowMs;
+}
+
+void logStall(unsigned long nowMs, uint32_t micros) {
+  if (stallLogged &&
+      (uint32_t)(nowMs - stallLoggedMs) < STALL_LOG_INTERVAL_MS) {
+    stallsNotLogged++;
+    return;
+  }
+  Serial.printf("[Loop] Stall: %.1f ms (budget %lu ms):", micros / 1000.0,
+                (unsigned long)(budgetMicros / 1000UL));
+  const char *separator = " ";
+  for (int i = 0; i <= sectionCount; i++) {
+    if (loopMicros[i] >= STALL_LOG_MIN_MICROS) {
+      Serial.printf("%s%s %.1f ms", separator, sectionNames[i],
+                    loopMicros[i] / 1000.0);
+      separator = ", ";
+    }
+  }
+  if (stallsNotLogged > 0) {
+    Serial.printf(" (%lu more stalls not logged)",
+                  (unsigned long)stallsNotLogged);
+  }
+  Serial.println();
+  stallLogged = true;
+  stallLoggedMs = nowMs;
+  stallsNotLogged = 0;
+}
+
+// Check the loop() that just ended against the budget
+void checkBudget(unsigned long nowMs, uint32_t micros) {
+  if (budgetMicros == 0 || micros <= budgetMicros) {
+    return;
+  }
+  stallCount++;
+  windowStalls++;
+  int slowest = 0;
+  for (int i = 1; i <= sectionCount; i++) {
+    if (loopMicros[i] > loopMicros[slowest]) {
+      slowest = i;
+    }
+  }
+  lastStall.atMs = nowMs;
+  lastStall.loopMicros = micros;
+  lastStall.section = sectionNames[slowest];
+  lastStall.sectionMicros = loopMicros[slowest];
+  logStall(nowMs, micros);
+}
+
+String sectionJson(const LoopSectionStats &stats) {
+  String json = "{\"name\":\"";
+  json += stats.name;
+  json += "\",\"calls\":";
+  json += String(stats.calls);
+  json += ",\"maxUs\":";
+  json += String(stats.maxMicros);
+  json += ",\"p99Us\":";
+  json += String(stats.p99Micros);
+  json += ",\"sharePercent\":";
+  json += String(stats.sharePercent, 1);
+  json += "}";
+  return json;
+}
+
+} // namespace
+
+void loopProfilerBegin(const char *const names[], int count,
+                       unsigned long budgetMs) {
+  sectionCount = count < LOOP_PROFILER_MAX_SECTIONS ? count
+                                                    : LOOP_PROFILER_MAX_SECTIONS;
+  for (int i = 0; i < sectionCount; i++) {
+    sectionNames[i] = names[i];
+  }
+  sectionNames[sectionCount] = "other";
+  sectionNames[sectionCount + 1] = "loop";
+  for (int i = 0; i < sectionCount + 2; i++) {
+    published[i] = LoopSectionStats();
+    published[i].name = sectionNames[i];
+  }
+  memset(windows, 0, sizeof(windows));
+  budgetMicros = budgetMs * 1000UL;
+  cyclesPerMicro = ESP.getCpuFreqMHz();
+  running = false;
+  stallCount = 0;
+  windowStalls = 0;
+  lastStall = LoopStall();
+  stallLogged = false;
+  stallsNotLogged = 0;
+}
+
+void loopProfilerStart() {
+  const uint32_t nowCycles = ESP.getCycleCount();
+  const unsigned long nowMs = millis();
+
+  if (running) {
+    // Everything after the last mark of the loop() before
+    const int other = sectionCount;
+    const uint32_t otherMicros =
+        elapsedMicros(markCycles, markMs, nowCycles, nowMs);
+    loopMicros[other] += otherMicros;
+    record(other, otherMicros);
+
+    const uint32_t micros =
+        elapsedMicros(loopStartCycles, loopStartMs, nowCycles, nowMs);
+    record(sectionCount + 1, micros);
+    checkBudget(nowMs, micros);
+    if ((uint32_t)(nowMs - windowStartMs) >= LOOP_PROFILER_WINDOW_MS) {
+      finishWindow(nowMs);
+    }
+  } else {
+    running = true;
+    windowStartMs = nowMs;
+  }
+
+  for (int i = 0; i <= sectionCount; i++) {
+    loopMicros[i] = 0;
+  }
+  // Read the clock again: printing above is not counted for anything
+  loopStartCycles = markCycles = ESP.getCycleCount();
+  loopStartMs = markMs = millis();
+}
+
+void loopProfilerDone(int section) {
+  const uint32_t nowCycles = ESP.getCycleCount();
+  const unsigned long nowMs = millis();
+  if (section < 0 || section >= sectionCount || !running) {
+    return;
+  }
+  const uint32_t micros = elapsedMicros(markCycles, markMs, nowCycles, nowMs);
+  loopMicros[section] += micros;
+  record(section, micros);
+  markCycles = nowCycles;
+  markMs = nowMs;
+}
+
+int loopProfilerSectionCount() { return sectionCount; }
+
+LoopSectionStats loopProfilerSection(int section) {
+  if (section < 0 || section > sectionCount) {
+    return LoopSectionStats();
+  }
+  return published[section];
+}
+
+LoopSectionStats loopProfilerLoop() { return published[sectionCount + 1]; }
+
+LoopSectionStats loopProfilerSlowest() {
+  int slowest = 0;
+  for (int i = 1; i <= sectionCount; i++) {
+    if (published[i].maxMicros > published[slowest].maxMicros) {
+      slowest = i;
+    }
+  }
+  return published[slowest];
+}
+
+uint32_t loopProfilerStallCount() { return stallCount; }
+
+LoopStall loopProfilerLastStall() { return lastStall; }
+
+unsigned long loopProfilerBudgetMs() { return budgetMicros / 1000UL; }
+
+String loopProfilerToJson() {
+  String json = "{\"budgetMs\":";
+  json += String(loopProfilerBudgetMs());
+  json += ",\"windowMs\":";
+  json += String(LOOP_PROFILER_WINDOW_MS);
+  json += ",\"stalls\":";
+  json += String(stallCount);
+  json += ",\"lastStall\":";
+  if (stallCount == 0) {
+    json += "null";
+  } else {
+    json += "{\"agoMs\":";
+    json += String((uint32_t)(millis() - lastStall.atMs));
+    json += ",\"loopUs\":";
+    json += String(lastStall.loopMicros);
+    json += ",\"section\":\"";
+    json += lastStall.section;
+    json += "\",\"sectionUs\":";
+    json += String(lastStall.sectionMicros);
+    json += "}";
+  }
+  json += ",\"loop\":";
+  json += sectionJson(published[sectionCount + 1]);
+  json += ",\"sections\":[";
+  for (int i = 0; i <= sectionCount; i++) {
+    if (i > 0) {
+      json += ",";
+    }
+    json += sectionJson(published[i]);
+  }
+  json += "]}";
+  return json;
+}
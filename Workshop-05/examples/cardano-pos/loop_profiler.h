@@ -0,0 +1,146 @@
+/**
+ * loop_profiler.h - Header file for timing what loop() spends its time on
+ *
+ * loop() calls one module after the other (WiFi, web server, data fetch,
+ * screen drawing...). When one of them takes long, everything else waits:
+ * the ticker stops scrolling, a web request is answered late. This module
+ * measures each of those calls, so a slow loop() can be blamed on the call
+ * that caused it.
+ *
+ * loop() marks where it starts and where each call ends:
+ *
+ *   void loop() {
+ *     loopProfilerStart();
+ *     wifiManagerLoop();
+ *     loopProfilerDone(SECTION_WIFI);
+ *     updateDataStep();
+ *     loopProfilerDone(SECTION_FETCH);
+ *   }
+ *
+ * The time since the previous mark is counted for the call just done. Time
+ * after the last mark (delay(), and the Arduino core between two loop()
+ * calls) is counted as "other". A mark reads the CPU's cycle counter, which
+ * takes a few cycles, so the profiler can stay on in normal use.
+ *
+ * For every call it keeps the longest time, the 99th percentile and its
+ * share of the time, per minute. Each minute these are printed to Serial:
+ *
+ *   [Loop] last 60 s: 5122 loops, max 912.4 ms, p99 33.0 ms, 1 stall
+ *   [Loop]   wifi        max   0.1 ms  p99   0.0 ms   0.1%
+ *   [Loop]   fetch       max 905.1 ms  p99   1.0 ms   6.3%
+ *   ...
+ *
+ * A loop() that takes longer than the budget is a stall. It is logged at
+ * once, with what each call took in that loop():
+ *
+ *   [Loop] Stall: 5031.6 ms (budget 1000 ms): fetch 5012.3 ms, screen 17.9 ms
+ */
+
+#ifndef LOOP_PROFILER_H
+#define LOOP_PROFILER_H
+
+#include <Arduino.h>
+
+// Most calls loopProfilerBegin() takes ("other" comes on top)
+#define LOOP_PROFILER_MAX_SECTIONS 8
+
+// The statistics cover one window: the last full minute
+#define LOOP_PROFILER_WINDOW_MS 60000UL
+
+// One call of loop() (or "other", or loop() as a whole) in the last window
+struct LoopSectionStats {
+  const char *name = "";
+  uint32_t calls = 0;         // How often it ran
+  uint32_t maxMicros = 0;     // Longest time
+  uint32_t p99Micros = 0;     // 99% of the times were this long or shorter
+                              // (rounded up by at most 25%)
+  float sharePercent = 0.0f;  // Of the window's time
+};
+
+// The last loop() that took longer than the budget
+struct LoopStall {
+  unsigned long atMs = 0;       // millis() when it ended
+  uint32_t loopMicros = 0;      // How long it took
+  const char *section = "";     // The call that took longest in it
+  uint32_t sectionMicros = 0;   // How long that call took
+};
+
+/**
+ * Set up the profiler (call once in setup())
+ *
+ * @param names Names of the calls to time, used in the Serial output and on
+ *              the status screen. Index i is the section loopProfilerDone(i)
+ *              counts for.
+ * @param count Number of names (at most LOOP_PROFILER_MAX_SECTIONS)
+ * @param budgetMs A loop() that takes longer is logged as a stall
+ */
+void loopProfilerBegin(const char *const names[], int count,
+                       unsigned long budgetMs);
+
+/**
+ * Mark the start of loop() (call first thing in loop())
+ *
+ * Also ends the loop() before: checks it against the budget and, once a
+ * minute, prints the statistics.
+ */
+void loopProfilerStart();
+
+/**
+ * Mark the end of a call in loop()
+ *
+ * @param section Index into the names given to loopProfilerBegin(). The time
+ *                since the previous mark is counted for it.
+ */
+void loopProfilerDone(int section);
+
+/**
+ * Number of sections given to loopProfilerBegin()
+ */
+int loopProfilerSectionCount();
+
+/**
+ * Statistics of one section in the last full minute
+ *
+ * @param section Index into the names given to loopProfilerBegin(), or
+ *                loopProfilerSectionCount() for "other"
+ * @return The statistics (all zero during the first minute)
+ */
+LoopSectionStats loopProfilerSection(int section);
+
+/**
+ * Statistics of loop() as a whole in the last full minute
+ */
+LoopSectionStats loopProfilerLoop();
+
+/**
+ * The section with the largest maxMicros in the last full minute
+ *
+ * @return Its statistics, or all zero during the first minute
+ */
+LoopSectionStats loopProfilerSlowest();
+
+/**
+ * Number of stalls since loopProfilerBegin()
+ */
+uint32_t loopProfilerStallCount();
+
+/**
+ * The last stall (all zero if there was none)
+ */
+LoopStall loopProfilerLastStall();
+
+/**
+ * The budget given to loopProfilerBegin(), in milliseconds
+ */
+unsigned long loopProfilerBudgetMs();
+
+/**
+ * The statistics as JSON, for a web API
+ *
+ * @return {"budgetMs":..,"stalls":..,"lastStall":{..} or null,
+ *         "loop":{..},"sections":[{"name":..,"calls":..,"maxUs":..,
+ *         "p99Us":..,"sharePercent":..},..]}
+ */
+String loopProfilerToJson();
+
+#endif
@@ -0,0 +1,179 @@
+#include "payment_verifier.h"
+#include "cardano_crypto.h"
+#include "logger.h"
+#include "secrets.h"
+#include <HTTPClient.h>
+
+namespace {
+const char *const LOG_MODULE = "verify"; // Module name in log messages
+const uint16_t HTTP_TIMEOUT = 10000; // 10 seconds, a 16 KB tx is 32 KB of hex
+
+// Key of the hex transaction in the response
+const char CBOR_KEY[] = "\"cbor\"";
+
+// Receives the Koios tx_cbor response, [{"tx_hash":"...",...,"cbor":"84a4..."}],
+// as HTTPClient hands it over and hex-decodes the "cbor" value straight into
+// the transaction buffer. The 32 KB of JSON is never held in memory.
+class TxCborSink : public Stream {
+public:
+  TxCborSink(uint8_t *buffer, size_t capacity)
+      : buffer_(buffer), capacity_(capacity) {}
+
+  size_t length() const { return length_; }
+  bool complete() const { return state_ == DONE; }
+
+  size_t write(uint8_t c) override {
+    switch (state_) {
+    case KEY:
+      // Look for the "cbor" key, quotes included
+      keyMatched_ = c == CBOR_KEY[keyMatched_] ? keyMatched_ + 1
+                    : c == CBOR_KEY[0]         ? 1
+                                               : 0;
+      if (CBOR_KEY[keyMatched_] == '\0') {
+        state_ = COLON;
+      }
+      break;
+    case COLON:
+      if (c == '"') {
+        state_ = VALUE;
+      } else if (c != ':' && c != ' ') {
+        state_ = FAILED; // null when Koios does not know the transaction
+      }
+      break;
+    case VALUE: {
+      if (c == '"') {
+        state_ = highNibble_ ? FAILED : DONE;
+        break;
+      }
+      int nibble = hexValue(c);
+      if (nibble < 0 || length_ >= capacity_) {
+        state_ = FAILED;
+      } else if (!highNibble_) {
+        buffer_[length_] = (uint8_t)(nibble << 4);
+        highNibble_ = true;
+      } else {
+        buffer_[length_++] |= (uint8_t)nibble;
+        highNibble_ = false;
+      }
+      break;
+    }
+    default:
+      break; // The rest of the response is ignored
+    }
+    return 1;
+  }
+
+  size_t write(const uint8_t *data, size_t size) override {
+    for (size_t i = 0; i < size; i++) {
+      write(data[i]);
+    }
+    return size;
+  }
+
+  // Nothing to read, this stream only receives
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+
+private:
+  enum State { KEY, COLON, VALUE, DONE, FAILED };
+
+  static int hexValue(uint8_t c) {
+    if (c >= '0' && c <= '9') {
+      return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+      return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+      return c - 'A' + 10;
+    }
+    return -1;
+  }
+
+  uint8_t *buffer_;
+  size_t capacity_;
+  size_t length_ = 0;
+  State state_ = KEY;
+  size_t keyMatched_ = 0;
+  bool highNibble_ = false;
+};
+
+// Koios endpoint for raw transactions, next to the address_utxos one
+String txCborUrl() {
+#ifdef KOIOS_TX_CBOR_URL
+  return String(KOIOS_TX_CBOR_URL);
+#else
+  String url = String(KOIOS_API_URL);
+  url.replace("address_utxos", "tx_cbor");
+  return url;
+#endif
+}
+
+bool hashMatches(const uint8_t txId[TX_ID_SIZE], const String &txHash) {
+  if (txHash.length() != TX_ID_SIZE * 2) {
+    return false;
+  }
+  const char *hex = "0123456789abcdef";
+  for (int i = 0; i < TX_ID_SIZE; i++) {
+    char high = txHash[i * 2] | 0x20; // Lowercase
+    char low = txHash[i * 2 + 1] | 0x20;
+    if (high != hex[txId[i] >> 4] || low != hex[txId[i] & 0x0f]) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+bool verifyPayment(const String &txHash, const char *paymentAddress,
+                   uint64_t expectedLovelace, TxPayment &payment) {
+  // Outputs hold addresses as raw bytes
+  char hrp[16];
+  uint8_t address[64];
+  size_t addressLength;
+  if (!bech32Decode(paymentAddress, hrp, sizeof(hrp), address,
+                    sizeof(address), addressLength)) {
+    LOG_E(LOG_MODULE, "Payment address is not valid bech32");
+    return false;
+  }
+
+  uint8_t *cbor = (uint8_t *)malloc(MAX_TX_SIZE);
+  if (!cbor) {
+    LOG_E(LOG_MODULE, "Not enough memory for the transaction");
+    return false;
+  }
+
+  HTTPClient http;
+  http.setTimeout(HTTP_TIMEOUT);
+  http.begin(txCborUrl());
+  http.addHeader("Content-Type", "application/json");
+  int httpCode = http.POST("{\"_tx_hashes\":[\"" + txHash + "\"]}");
+
+  TxCborSink sink(cbor, MAX_TX_SIZE);
+  if (httpCode == 200) {
+    http.writeToStream(&sink);
+  }
+  http.end();
+
+  bool verified = false;
+  if (httpCode != 200) {
+    LOG_E(LOG_MODULE, "tx_cbor request failed (response code %d)", httpCode);
+  } else if (!sink.complete()) {
+    LOG_E(LOG_MODULE, "No transaction CBOR in the response");
+  } else if (!txFindPayment(cbor, sink.length(), address, addressLength,
+                            expectedLovelace, payment)) {
+    LOG_W(LOG_MODULE, "Transaction CBOR is malformed, or the transaction "
+          "failed script validation");
+  } else if (!hashMatches(payment.txId, txHash)) {
+    LOG_W(LOG_MODULE, "Transaction body does not match its hash");
+  } else {
+    LOG_I(LOG_MODULE, "%.16s... pays %llu lovelace in %d of %d outputs",
+          txHash.c_str(), (unsigned long long)payment.lovelaceToAddress,
+          payment.outputsToAddress, payment.outputCount);
+    verified = true;
+  }
+
+  free(cbor);
+  return verified;
+}
@@ -0,0 +1,15 @@
+#ifndef PAYMENT_VERIFIER_H
+#define PAYMENT_VERIFIER_H
+
+#include "cbor_tx.h"
+#include <Arduino.h>
+
+// Fetch a transaction's CBOR from Koios and check it locally: the body must
+// hash to txHash and the outputs to paymentAddress are added up in payment.
+// expectedLovelace sets payment.exactOutput.
+// Returns false if the transaction could not be fetched or is not valid CBOR
+// for that hash. Uses a buffer of up to MAX_TX_SIZE bytes while it runs.
+bool verifyPayment(const String &txHash, const char *paymentAddress,
+                   uint64_t expectedLovelace, TxPayment &payment);
+
+#endif
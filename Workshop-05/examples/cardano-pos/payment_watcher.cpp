@@ -0,0 +1,326 @@
+#include "payment_watcher.h"
+#include "invoice_address.h"
+#include "logger.h"
+#include "payment_verifier.h"
+#include "secrets.h"
+#include "spsc_ring.h"
+#include "wifi_manager.h"
+#include <ArduinoJson.h>
+#include <HTTPClient.h>
+#include <WiFi.h>
+
+// Host builds have no FreeRTOS, checks run from paymentWatcherLoop() there
+#ifndef HOST_SIM
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+namespace {
+const char *const LOG_MODULE = "watcher"; // Module name in log messages
+const unsigned long CHECK_INTERVAL = 10000; // Check every 10 seconds
+
+// Transactions fetched and verified per check, each is a Koios request
+const int MAX_VERIFIED_TRANSACTIONS = 4;
+
+// Longest the worker sleeps with nothing to do. A new request wakes it
+// up earlier.
+const unsigned long IDLE_WAIT = 60000;
+
+struct WatchRequest {
+  uint32_t generation;
+  int transactionId;
+  uint64_t lovelaceAmount;
+  char address[INVOICE_ADDRESS_SIZE]; // "" for PAYMENT_ADDRESS
+};
+
+struct WatchResult {
+  uint32_t generation;
+  PaymentWatchResult result;
+};
+
+// loop() -> worker: new invoices to watch (bounded, usually 0 or 1 waiting)
+SpscRing<WatchRequest, 4> requests;
+// Worker -> loop(): one entry per check
+SpscRing<WatchResult, 8> results;
+
+// Bumped by loop() for every new watch and on cancel. Requests and results
+// carry the generation they belong to, anything older is stale.
+std::atomic<uint32_t> currentGeneration(0);
+
+// Set by loop() to have the worker check now instead of at nextCheckTime
+std::atomic<bool> checkNow(false);
+
+bool started = false;
+
+// Worker state, only touched by the worker
+WatchRequest watching;
+bool isWatching = false;
+unsigned long nextCheckTime = 0;
+
+#ifndef HOST_SIM
+TaskHandle_t workerTask = nullptr;
+#else
+unsigned long nextStepTime = 0;
+#endif
+
+// Check for transaction using Koios API
+// transactionId: ID of the transaction
+// lovelaceAmount: Amount in lovelace to pay
+// paymentAddress: The invoice's own address, or "" for PAYMENT_ADDRESS
+// Returns transaction hash if payment received, empty string otherwise
+String checkForTransaction(int transactionId, uint64_t lovelaceAmount,
+                           const char *paymentAddress) {
+  // An invoice address only ever receives this invoice's payment, so any
+  // UTxO there counts. The shared address needs the exact amount (with ID).
+  bool ownAddress = paymentAddress[0] != '\0';
+  if (!WiFi.isConnected()) {
+    LOG_W(LOG_MODULE, "WiFi not connected, skipping check");
+    return "";
+  }
+
+  LOG_I(LOG_MODULE, "Checking for payment of transaction %d (%llu lovelace)",
+        transactionId, (unsigned long long)lovelaceAmount);
+
+  // Build API URL, with an amount filter for the shared address
+  String url = String(KOIOS_API_URL);
+  if (!ownAddress) {
+    url += "?value=eq.";
+    url += String(lovelaceAmount);
+  }
+
+  // Make POST request
+  HTTPClient http;
+  http.begin(url);
+  http.addHeader("Content-Type", "application/json");
+
+  // Build JSON request body
+  DynamicJsonDocument requestDoc(512);
+  JsonArray addresses = requestDoc.createNestedArray("_addresses");
+  addresses.add(ownAddress ? paymentAddress : PAYMENT_ADDRESS);
+
+  String requestBody;
+  serializeJson(requestDoc, requestBody);
+
+  LOG_D(LOG_MODULE, "Requesting %s", url.c_str());
+  LOG_V(LOG_MODULE, "Request body: %s", requestBody.c_str());
+
+  // Tell the WiFi manager how the request went, so it can judge the link
+  const unsigned long requestStart = wifiManagerRequestStarted();
+  int httpCode = http.POST(requestBody);
+  wifiManagerRequestFinished(requestStart, httpCode > 0);
+  LOG_D(LOG_MODULE, "HTTP response code: %d", httpCode);
+
+  if (httpCode == 200) {
+    String payload = http.getString();
+    LOG_V(LOG_MODULE, "Payload: %s", payload.c_str());
+    DynamicJsonDocument responseDoc(2048);
+    DeserializationError error = deserializeJson(responseDoc, payload);
+    http.end();
+
+    if (!error && responseDoc.is<JsonArray>()) {
+      JsonArray utxos = responseDoc.as<JsonArray>();
+      LOG_D(LOG_MODULE, "Found %u UTxO(s)", (unsigned)utxos.size());
+
+      // Koios only reports UTxOs. Each transaction is fetched as CBOR and
+      // checked here before the invoice counts as paid: it must hash to
+      // its tx_hash and its outputs must really pay the address.
+      const char *address = ownAddress ? paymentAddress : PAYMENT_ADDRESS;
+      String verifiedHashes[MAX_VERIFIED_TRANSACTIONS];
+      int verifiedCount = 0;
+      uint64_t received = 0;
+      for (JsonObject utxo : utxos) {
+        String txHash = utxo["tx_hash"] | "";
+        bool seen = txHash.length() == 0;
+        for (int i = 0; i < verifiedCount && !seen; i++) {
+          seen = verifiedHashes[i] == txHash;
+        }
+        if (seen) {
+          continue; // Several outputs of one transaction
+        }
+        if (verifiedCount == MAX_VERIFIED_TRANSACTIONS) {
+          break;
+        }
+        verifiedHashes[verifiedCount++] = txHash;
+
+        TxPayment payment;
+        if (!verifyPayment(txHash, address, lovelaceAmount, payment)) {
+          continue; // Checked again next time
+        }
+        // The shared address needs one output with exactly the amount (with
+        // ID). An invoice address may be paid in more than one transaction.
+        received += payment.lovelaceToAddress;
+        if (ownAddress ? received >= lovelaceAmount : payment.exactOutput) {
+          String paidHash = ownAddress ? verifiedHashes[0] : txHash;
+          LOG_I(LOG_MODULE, "Payment verified! Transaction hash: %s",
+                paidHash.c_str());
+          return paidHash;
+        }
+      }
+      if (ownAddress && received > 0) {
+        LOG_I(LOG_MODULE, "Partial payment: %llu lovelace so far",
+              (unsigned long long)received);
+      }
+    } else {
+      LOG_E(LOG_MODULE, "Koios: JSON parsing failed: %s", error.c_str());
+    }
+  } else {
+    if (httpCode > 0) {
+      LOG_E(LOG_MODULE, "Koios: HTTP request failed (response code %d)",
+            httpCode);
+      LOG_V(LOG_MODULE, "Payload: %s", http.getString().c_str());
+    } else {
+      LOG_E(LOG_MODULE, "Koios: connection failed");
+    }
+  }
+
+  http.end();
+  LOG_D(LOG_MODULE, "No payment found yet");
+  return "";
+}
+
+// Take new requests and run a check if one is due
+// Returns ms until the worker has something to do again
+unsigned long workerStep() {
+  WatchRequest request;
+  while (requests.pop(request)) {
+    if (isWatching && watching.transactionId != request.transactionId) {
+      LOG_I(LOG_MODULE, "Transaction %d replaced by a new invoice",
+            watching.transactionId);
+    }
+    watching = request; // Only the newest one matters
+    isWatching = true;
+    nextCheckTime = millis() + CHECK_INTERVAL;
+  }
+  if (isWatching && watching.generation != currentGeneration.load()) {
+    LOG_I(LOG_MODULE, "Stopped watching transaction %d",
+          watching.transactionId);
+    isWatching = false;
+  }
+  if (!isWatching) {
+    checkNow.store(false); // Nothing to check
+    return IDLE_WAIT;
+  }
+  if (checkNow.exchange(false)) {
+    nextCheckTime = millis();
+  }
+  // int32_t: millis() is 32 bits on the ESP32 and wraps after 49.7 days.
+  // A signed 32 bit difference is right across the wrap, also in host
+  // builds, where long has 64 bits.
+  const int32_t wait = (int32_t)(nextCheckTime - millis());
+  if (wait > 0) {
+    return (unsigned long)wait;
+  }
+
+  unsigned long checkStart = millis();
+  String txHash = checkForTransaction(
+      watching.transactionId, watching.lovelaceAmount, watching.address);
+
+  WatchResult entry;
+  entry.generation = watching.generation;
+  entry.result.transactionId = watching.transactionId;
+  entry.result.paid = txHash.length() > 0;
+  snprintf(entry.result.txHash, sizeof(entry.result.txHash), "%s",
+           txHash.c_str());
+  entry.result.checkMs = (uint32_t)(millis() - checkStart);
+
+  if (watching.generation != currentGeneration.load()) {
+    LOG_D(LOG_MODULE, "Invoice replaced during the check, result dropped");
+  } else if (!results.push(entry)) {
+    // loop() is not keeping up; a missed "not paid" is harmless, a missed
+    // payment is found again by the next check
+    LOG_W(LOG_MODULE, "Result queue full, result dropped");
+    entry.result.paid = false;
+  }
+
+  if (entry.result.paid) {
+    isWatching = false;
+    return IDLE_WAIT;
+  }
+  nextCheckTime = millis() + CHECK_INTERVAL;
+  return CHECK_INTERVAL;
+}
+
+#ifndef HOST_SIM
+void watcherTask(void *parameter) {
+  (void)parameter;
+  while (true) {
+    unsigned long wait = workerStep();
+    // Sleep until the next check, or until loop() sends a request
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait));
+  }
+}
+#endif
+
+void wakeWorker() {
+#ifndef HOST_SIM
+  if (workerTask != nullptr) {
+    xTaskNotifyGive(workerTask);
+  }
+#else
+  nextStepTime = millis();
+#endif
+}
+} // namespace
+
+void paymentWatcherSetup() {
+  if (started) {
+    return;
+  }
+  started = true;
+
+#ifndef HOST_SIM
+  // Same core and stack size as the price task: HTTPClient with TLS, plus
+  // the UTxO JSON document (on the heap)
+  xTaskCreatePinnedToCore(watcherTask, "watcher", 8192, nullptr, 1,
+                          &workerTask, 0);
+#endif
+  LOG_I(LOG_MODULE, "Payment watcher started");
+}
+
+void paymentWatcherLoop() {
+#ifdef HOST_SIM
+  if (started && (int32_t)(millis() - nextStepTime) >= 0) {
+    nextStepTime = millis() + workerStep();
+  }
+#endif
+}
+
+bool paymentWatchStart(int transactionId, uint64_t lovelaceAmount,
+                       const char *paymentAddress) {
+  WatchRequest request;
+  request.generation = currentGeneration.load() + 1;
+  request.transactionId = transactionId;
+  request.lovelaceAmount = lovelaceAmount;
+  snprintf(request.address, sizeof(request.address), "%s", paymentAddress);
+
+  // Published before the request, so the worker never drops a request as
+  // stale. The old watch is cancelled even if the queue is full.
+  currentGeneration.store(request.generation);
+  if (!requests.push(request)) {
+    LOG_W(LOG_MODULE, "Request queue full");
+    return false;
+  }
+  wakeWorker();
+  return true;
+}
+
+void paymentWatchCancel() {
+  currentGeneration.fetch_add(1);
+  wakeWorker();
+}
+
+void paymentWatchCheckNow() {
+  checkNow.store(true);
+  wakeWorker();
+}
+
+bool paymentWatchPoll(PaymentWatchResult &result) {
+  WatchResult entry;
+  while (results.pop(entry)) {
+    if (entry.generation == currentGeneration.load()) {
+      result = entry.result;
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,43 @@
+#ifndef PAYMENT_WATCHER_H
+#define PAYMENT_WATCHER_H
+
+#include <Arduino.h>
+
+// 64 hex characters plus '\0'
+#define TX_HASH_SIZE 65
+
+// Outcome of one payment check, handed back to loop()
+struct PaymentWatchResult {
+  int transactionId;
+  bool paid;
+  char txHash[TX_HASH_SIZE]; // Set if paid
+  unsigned long checkMs;     // How long the Koios requests took
+};
+
+// Start the payment watcher. On the ESP32 this starts a FreeRTOS task on the
+// other core, so Koios requests never block loop().
+void paymentWatcherSetup();
+
+// Call in loop(). Only does work in host builds, which have no FreeRTOS and
+// run the checks from here instead.
+void paymentWatcherLoop();
+
+// Watch for the payment of an invoice, checked every 10 seconds until paid.
+// Replaces (cancels) the invoice watched so far.
+// paymentAddress: The invoice's own address, or "" for PAYMENT_ADDRESS
+// Returns false if the request queue is full; try again later.
+bool paymentWatchStart(int transactionId, uint64_t lovelaceAmount,
+                       const char *paymentAddress);
+
+// Stop watching. A check already running finishes, its result is dropped.
+void paymentWatchCancel();
+
+// Check the watched invoice right away instead of at the next 10 second
+// mark, for example when WiFi is back after an outage
+void paymentWatchCheckNow();
+
+// Take the next result for the watched invoice, without waiting
+// Results of cancelled watches are skipped.
+bool paymentWatchPoll(PaymentWatchResult &result);
+
+#endif
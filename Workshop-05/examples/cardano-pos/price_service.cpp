@@ -0,0 +1,178 @@
+#include "price_service.h"
+#include "secrets.h"
+#include "wifi_manager.h"
+#include <ArduinoJson.h>
+#include <HTTPClient.h>
+#include <WiFi.h>
+
+// Currency and price API can be set in secrets.h, these are the defaults
+#ifndef FIAT_CURRENCY
+#define FIAT_CURRENCY "usd"
+#endif
+
+#ifndef PRICE_API_URL
+#define PRICE_API_URL                                                          \
+  "https://api.coingecko.com/api/v3/simple/price?ids=cardano&vs_currencies="
+#endif
+
+// Host builds have no FreeRTOS, the price is refreshed from loop() there
+#ifndef HOST_SIM
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#define PRICE_LOCK() portENTER_CRITICAL(&priceLock)
+#define PRICE_UNLOCK() portEXIT_CRITICAL(&priceLock)
+#else
+#define PRICE_LOCK()
+#define PRICE_UNLOCK()
+#endif
+
+namespace {
+// Fetch a new price this often while the last fetch worked
+const unsigned long REFRESH_INTERVAL = 60000; // 1 minute
+
+// Retry sooner after a failed fetch
+const unsigned long RETRY_INTERVAL = 15000; // 15 seconds
+
+// Never convert with a price older than this. The last good price keeps
+// being used while fetches fail, up to this age.
+const unsigned long MAX_PRICE_AGE = 900000; // 15 minutes
+
+const uint16_t HTTP_TIMEOUT = 5000; // 5 seconds
+
+// Shared between the price task (writer) and loop() (reader)
+uint64_t cachedMicroFiatPerAda = 0; // 0 = no price yet
+unsigned long cachedAt = 0;         // millis() when the price was fetched
+
+bool started = false;
+
+#ifndef HOST_SIM
+portMUX_TYPE priceLock = portMUX_INITIALIZER_UNLOCKED;
+#else
+unsigned long nextFetchTime = 0;
+#endif
+
+// Fetch the current price, returns 0 on failure
+uint64_t fetchPrice() {
+  if (!WiFi.isConnected()) {
+    return 0;
+  }
+
+  String url = PRICE_API_URL;
+  url += FIAT_CURRENCY;
+
+  HTTPClient http;
+  http.setTimeout(HTTP_TIMEOUT);
+  http.begin(url);
+  // Tell the WiFi manager how the request went, so it can judge the link
+  const unsigned long requestStart = wifiManagerRequestStarted();
+  int httpCode = http.GET();
+  wifiManagerRequestFinished(requestStart, httpCode > 0);
+
+  if (httpCode != 200) {
+    http.end();
+    Serial.print("[Price] HTTP error: ");
+    Serial.println(httpCode);
+    return 0;
+  }
+
+  // Response: {"cardano":{"usd":0.4123}}
+  StaticJsonDocument<256> doc;
+  DeserializationError error = deserializeJson(doc, http.getString());
+  http.end();
+  if (error) {
+    Serial.print("[Price] JSON parsing error: ");
+    Serial.println(error.c_str());
+    return 0;
+  }
+
+  double price = doc["cardano"][FIAT_CURRENCY] | 0.0;
+  if (price <= 0) {
+    Serial.println("[Price] No price in response");
+    return 0;
+  }
+  return (uint64_t)(price * 1000000.0 + 0.5);
+}
+
+// Fetch once and store the result, returns ms until the next fetch
+unsigned long refreshPrice() {
+  uint64_t price = fetchPrice();
+  if (price == 0) {
+    return RETRY_INTERVAL;
+  }
+
+  PRICE_LOCK();
+  cachedMicroFiatPerAda = price;
+  cachedAt = millis();
+  PRICE_UNLOCK();
+
+  Serial.print("[Price] 1 ADA = ");
+  Serial.print((double)price / 1000000.0, 6);
+  Serial.print(" ");
+  Serial.println(FIAT_CURRENCY);
+  return REFRESH_INTERVAL;
+}
+
+#ifndef HOST_SIM
+void priceTask(void *parameter) {
+  (void)parameter;
+  while (true) {
+    unsigned long wait = refreshPrice();
+    vTaskDelay(pdMS_TO_TICKS(wait));
+  }
+}
+#endif
+} // namespace
+
+void priceServiceSetup() {
+  if (started) {
+    return;
+  }
+  started = true;
+
+#ifndef HOST_SIM
+  // Core 0 runs WiFi; loop() runs on core 1 and is never blocked by the
+  // HTTPS request. 8 KB of stack is enough for HTTPClient with TLS.
+  xTaskCreatePinnedToCore(priceTask, "price", 8192, nullptr, 1, nullptr, 0);
+#endif
+  Serial.print("[Price] Price service started (");
+  Serial.print(FIAT_CURRENCY);
+  Serial.println(")");
+}
+
+void priceServiceLoop() {
+#ifdef HOST_SIM
+  // 32 bit difference, right when millis() wraps (see payment_watcher.cpp)
+  if (started && (int32_t)(millis() - nextFetchTime) >= 0) {
+    nextFetchTime = millis() + refreshPrice();
+  }
+#endif
+}
+
+const char *priceServiceCurrency() { return FIAT_CURRENCY; }
+
+PriceQuote priceServiceGetQuote() {
+  PRICE_LOCK();
+  uint64_t price = cachedMicroFiatPerAda;
+  unsigned long fetchedAt = cachedAt;
+  PRICE_UNLOCK();
+
+  PriceQuote quote;
+  quote.microFiatPerAda = price;
+  quote.ageMs = price > 0 ? (uint32_t)(millis() - fetchedAt) : 0;
+  quote.available = price > 0 && quote.ageMs <= MAX_PRICE_AGE;
+  return quote;
+}
+
+bool priceServiceFiatToLovelace(uint64_t fiatMicros, uint64_t &lovelace) {
+  PriceQuote quote = priceServiceGetQuote();
+  if (!quote.available) {
+    return false;
+  }
+
+  // lovelace = fiat / (fiat per ADA) * 1,000,000, rounded to the nearest
+  // lovelace. Integer math only; fiatMicros is limited by the caller so the
+  // product fits into 64 bits.
+  lovelace = (fiatMicros * 1000000ULL + quote.microFiatPerAda / 2) /
+             quote.microFiatPerAda;
+  return true;
+}
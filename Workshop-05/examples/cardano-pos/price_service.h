@@ -0,0 +1,33 @@
+#ifndef PRICE_SERVICE_H
+#define PRICE_SERVICE_H
+
+#include <Arduino.h>
+
+// Cached ADA price in the shop's currency
+struct PriceQuote {
+  bool available;           // False if there is no rate or it is too old
+  uint64_t microFiatPerAda; // Price of 1 ADA in millionths of the currency
+  unsigned long ageMs;      // Time since the rate was fetched
+};
+
+// Start refreshing the ADA price in the background (call after WiFi is
+// connected). On the ESP32 this starts a FreeRTOS task on the other core, so
+// price requests never block loop().
+void priceServiceSetup();
+
+// Call in loop(). Only does work in host builds, which have no FreeRTOS and
+// refresh the price from here instead.
+void priceServiceLoop();
+
+// Currency code prices are quoted in (lower case, e.g. "eur")
+const char *priceServiceCurrency();
+
+// Get the cached price without any network access
+PriceQuote priceServiceGetQuote();
+
+// Convert a fiat amount to lovelace using the cached price
+// fiatMicros: Amount in millionths of the currency (12.50 EUR = 12500000)
+// Returns false if no price younger than the staleness limit is available
+bool priceServiceFiatToLovelace(uint64_t fiatMicros, uint64_t &lovelace);
+
+#endif
@@ -0,0 +1,556 @@
+#include "qr_matrix.h"
+#include <string.h>
+
+// QR code encoder (byte mode only), following the structure of the
+// ISO/IEC 18004 reference algorithm as used by Project Nayuki's qrcodegen.
+// Everything works on packed bit arrays so no full-colour buffer is needed.
+
+namespace {
+// Error correction codewords per block, indexed [ecc][version]
+const int8_t ECC_CODEWORDS_PER_BLOCK[4][41] = {
+    {-1, 7,  10, 15, 20, 26, 18, 20, 24, 30, 18, 20, 24, 26,
+     30, 22, 24, 28, 30, 28, 28, 28, 28, 30, 30, 26, 28, 30,
+     30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30},
+    {-1, 10, 16, 26, 18, 24, 16, 18, 22, 22, 26, 30, 22, 22,
+     24, 24, 28, 28, 26, 26, 26, 26, 28, 28, 28, 28, 28, 28,
+     28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28},
+    {-1, 13, 22, 18, 26, 18, 24, 18, 22, 20, 24, 28, 26, 24,
+     20, 30, 24, 28, 28, 26, 30, 28, 30, 30, 30, 30, 28, 30,
+     30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30},
+    {-1, 17, 28, 22, 16, 22, 28, 26, 26, 24, 28, 24, 28, 22,
+     24, 24, 30, 28, 28, 26, 28, 30, 24, 30, 30, 30, 30, 30,
+     30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30},
+};
+
+// Number of error correction blocks, indexed [ecc][version]
+const int8_t NUM_ERROR_CORRECTION_BLOCKS[4][41] = {
+    {-1, 1, 1, 1, 1,  1,  2,  2,  2,  2,  4,  4,  4,  4,
+     4,  6, 6, 6, 6,  7,  8,  8,  9,  9,  10, 12, 12, 12,
+     13, 14, 15, 16, 17, 18, 19, 19, 20, 21, 22, 24, 25},
+    {-1, 1,  1,  1,  2,  2,  4,  4,  4,  5,  5,  5,  8,  9,
+     9,  10, 10, 11, 13, 14, 16, 17, 17, 18, 20, 21, 23, 25,
+     26, 28, 29, 31, 33, 35, 37, 38, 40, 43, 45, 47, 49},
+    {-1, 1,  1,  2,  2,  4,  4,  6,  6,  8,  8,  8,  10, 12,
+     16, 12, 17, 16, 18, 21, 20, 23, 23, 25, 27, 29, 34, 34,
+     35, 38, 40, 43, 45, 48, 51, 53, 56, 59, 62, 65, 68},
+    {-1, 1,  1,  2,  4,  4,  4,  5,  6,  8,  8,  11, 11, 16,
+     16, 18, 16, 19, 21, 25, 25, 25, 34, 30, 32, 35, 37, 40,
+     42, 45, 48, 51, 54, 57, 60, 63, 66, 70, 74, 77, 81},
+};
+
+// Format information bits for each level (L=01, M=00, Q=11, H=10)
+const uint8_t ECC_FORMAT_BITS[4] = {1, 0, 3, 2};
+
+const int PENALTY_N1 = 3;
+const int PENALTY_N2 = 3;
+const int PENALTY_N3 = 40;
+const int PENALTY_N4 = 10;
+
+// Largest codeword count and ECC block length we can meet up to version 15
+const int MAX_RAW_CODEWORDS = 655;
+const int MAX_ECC_PER_BLOCK = 30;
+
+// Scratch buffers shared by all encodes (encoding is not re-entrant)
+uint8_t codewords[MAX_RAW_CODEWORDS];
+uint8_t interleaved[MAX_RAW_CODEWORDS];
+uint8_t functionMask[QR_MATRIX_BYTES]; // 1 = module belongs to a pattern
+
+QrMatrix *current = nullptr; // Matrix being built
+
+inline bool getBit(uint32_t value, int index) {
+  return ((value >> index) & 1) != 0;
+}
+
+inline void setPacked(uint8_t *bits, int index, bool value) {
+  if (value) {
+    bits[index >> 3] |= (uint8_t)(1 << (index & 7));
+  } else {
+    bits[index >> 3] &= (uint8_t)~(1 << (index & 7));
+  }
+}
+
+inline bool getPacked(const uint8_t *bits, int index) {
+  return (bits[index >> 3] >> (index & 7)) & 1;
+}
+
+inline bool module(int x, int y) { return current->get(x, y); }
+
+inline bool isFunction(int x, int y) {
+  return getPacked(functionMask, y * current->size + x);
+}
+
+inline void setModule(int x, int y, bool dark) {
+  setPacked(current->modules, y * current->size + x, dark);
+}
+
+// Set a module that belongs to a function pattern (finder, timing, ...)
+inline void setFunctionModule(int x, int y, bool dark) {
+  setModule(x, y, dark);
+  setPacked(functionMask, y * current->size + x, true);
+}
+
+int numRawDataModules(int version) {
+  int result = (16 * version + 128) * version + 64;
+  if (version >= 2) {
+    int numAlign = version / 7 + 2;
+    result -= (25 * numAlign - 10) * numAlign - 55;
+    if (version >= 7) {
+      result -= 36;
+    }
+  }
+  return result;
+}
+
+int numDataCodewords(int version, int ecc) {
+  return numRawDataModules(version) / 8 -
+         ECC_CODEWORDS_PER_BLOCK[ecc][version] *
+             NUM_ERROR_CORRECTION_BLOCKS[ecc][version];
+}
+
+// Bits used by a byte mode segment of the given length
+int segmentBits(int version, size_t length) {
+  int countBits = version <= 9 ? 8 : 16;
+  return 4 + countBits + (int)length * 8;
+}
+
+// --- Reed-Solomon error correction over GF(2^8/0x11D) ---
+
+uint8_t gfMultiply(uint8_t x, uint8_t y) {
+  int z = 0;
+  for (int i = 7; i >= 0; i--) {
+    z = (z << 1) ^ ((z >> 7) * 0x11D);
+    z ^= ((y >> i) & 1) * x;
+  }
+  return (uint8_t)z;
+}
+
+void rsDivisor(int degree, uint8_t *result) {
+  memset(result, 0, degree);
+  result[degree - 1] = 1;
+  uint8_t root = 1;
+  for (int i = 0; i < degree; i++) {
+    for (int j = 0; j < degree; j++) {
+      result[j] = gfMultiply(result[j], root);
+      if (j + 1 < degree) {
+        result[j] ^= result[j + 1];
+      }
+    }
+    root = gfMultiply(root, 0x02);
+  }
+}
+
+void rsRemainder(const uint8_t *data, int dataLength, const uint8_t *divisor,
+                 int degree, uint8_t *result) {
+  memset(result, 0, degree);
+  for (int i = 0; i < dataLength; i++) {
+    uint8_t factor = data[i] ^ result[0];
+    memmove(result, result + 1, degree - 1);
+    result[degree - 1] = 0;
+    for (int j = 0; j < degree; j++) {
+      result[j] ^= gfMultiply(divisor[j], factor);
+    }
+  }
+}
+
+// Split data into blocks, append ECC to each and interleave into the final
+// codeword sequence
+void addEccAndInterleave(int version, int ecc) {
+  int numBlocks = NUM_ERROR_CORRECTION_BLOCKS[ecc][version];
+  int blockEccLength = ECC_CODEWORDS_PER_BLOCK[ecc][version];
+  int rawCodewords = numRawDataModules(version) / 8;
+  int dataLength = numDataCodewords(version, ecc);
+  int numShortBlocks = numBlocks - rawCodewords % numBlocks;
+  int shortBlockDataLength = rawCodewords / numBlocks - blockEccLength;
+
+  uint8_t divisor[MAX_ECC_PER_BLOCK];
+  uint8_t blockEcc[MAX_ECC_PER_BLOCK];
+  rsDivisor(blockEccLength, divisor);
+
+  const uint8_t *block = codewords;
+  for (int i = 0; i < numBlocks; i++) {
+    int blockLength = shortBlockDataLength + (i < numShortBlocks ? 0 : 1);
+    rsRemainder(block, blockLength, divisor, blockEccLength, blockEcc);
+    for (int j = 0, k = i; j < blockLength; j++, k += numBlocks) {
+      if (j == shortBlockDataLength) {
+        k -= numShortBlocks;
+      }
+      interleaved[k] = block[j];
+    }
+    for (int j = 0, k = dataLength + i; j < blockEccLength;
+         j++, k += numBlocks) {
+      interleaved[k] = blockEcc[j];
+    }
+    block += blockLength;
+  }
+}
+
+// --- Function patterns ---
+
+void drawFinderPattern(int x, int y) {
+  int size = current->size;
+  for (int dy = -4; dy <= 4; dy++) {
+    for (int dx = -4; dx <= 4; dx++) {
+      int adx = dx < 0 ? -dx : dx;
+      int ady = dy < 0 ? -dy : dy;
+      int distance = adx > ady ? adx : ady;
+      int xx = x + dx;
+      int yy = y + dy;
+      if (xx >= 0 && xx < size && yy >= 0 && yy < size) {
+        setFunctionModule(xx, yy, distance != 2 && distance != 4);
+      }
+    }
+  }
+}
+
+void drawAlignmentPattern(int x, int y) {
+  for (int dy = -2; dy <= 2; dy++) {
+    for (int dx = -2; dx <= 2; dx++) {
+      int adx = dx < 0 ? -dx : dx;
+      int ady = dy < 0 ? -dy : dy;
+      setFunctionModule(x + dx, y + dy, (adx > ady ? adx : ady) != 1);
+    }
+  }
+}
+
+void drawFormatBits(int ecc, int mask) {
+  int size = current->size;
+  int data = ECC_FORMAT_BITS[ecc] << 3 | mask;
+  int remainder = data;
+  for (int i = 0; i < 10; i++) {
+    remainder = (remainder << 1) ^ ((remainder >> 9) * 0x537);
+  }
+  uint32_t bits = (uint32_t)((data << 10 | remainder) ^ 0x5412);
+
+  // First copy, around the top left finder
+  for (int i = 0; i <= 5; i++) {
+    setFunctionModule(8, i, getBit(bits, i));
+  }
+  setFunctionModule(8, 7, getBit(bits, 6));
+  setFunctionModule(8, 8, getBit(bits, 7));
+  setFunctionModule(7, 8, getBit(bits, 8));
+  for (int i = 9; i < 15; i++) {
+    setFunctionModule(14 - i, 8, getBit(bits, i));
+  }
+
+  // Second copy, split between the other two finders
+  for (int i = 0; i < 8; i++) {
+    setFunctionModule(size - 1 - i, 8, getBit(bits, i));
+  }
+  for (int i = 8; i < 15; i++) {
+    setFunctionModule(8, size - 15 + i, getBit(bits, i));
+  }
+  setFunctionModule(8, size - 8, true); // Always dark
+}
+
+void drawVersionBits() {
+  int version = current->version;
+  if (version < 7) {
+    return;
+  }
+  int remainder = version;
+  for (int i = 0; i < 12; i++) {
+    remainder = (remainder << 1) ^ ((remainder >> 11) * 0x1F25);
+  }
+  uint32_t bits = (uint32_t)(version << 12 | remainder);
+  for (int i = 0; i < 18; i++) {
+    bool bit = getBit(bits, i);
+    int a = current->size - 11 + i % 3;
+    int b = i / 3;
+    setFunctionModule(a, b, bit);
+    setFunctionModule(b, a, bit);
+  }
+}
+
+void drawFunctionPatterns(int ecc) {
+  int size = current->size;
+  int version = current->version;
+
+  // Timing patterns
+  for (int i = 0; i < size; i++) {
+    setFunctionModule(6, i, i % 2 == 0);
+    setFunctionModule(i, 6, i % 2 == 0);
+  }
+
+  // Finder patterns in three corners (overwrite the timing patterns)
+  drawFinderPattern(3, 3);
+  drawFinderPattern(size - 4, 3);
+  drawFinderPattern(3, size - 4);
+
+  // Alignment patterns
+  if (version > 1) {
+    int numAlign = version / 7 + 2;
+    int step = (version * 8 + numAlign * 3 + 5) / (numAlign * 4 - 4) * 2;
+    int positions[7];
+    positions[0] = 6;
+    for (int i = numAlign - 1, pos = size - 7; i >= 1; i--, pos -= step) {
+      positions[i] = pos;
+    }
+    for (int i = 0; i < numAlign; i++) {
+      for (int j = 0; j < numAlign; j++) {
+        // Skip the three corners that hold finder patterns
+        if ((i == 0 && j == 0) || (i == 0 && j == numAlign - 1) ||
+            (i == numAlign - 1 && j == 0)) {
+          continue;
+        }
+        drawAlignmentPattern(positions[i], positions[j]);
+      }
+    }
+  }
+
+  // Reserve the format area (real bits are written once the mask is known)
+  drawFormatBits(ecc, 0);
+  drawVersionBits();
+}
+
+// Place codeword bits in the zigzag order, skipping function modules
+void drawCodewords(int length) {
+  int size = current->size;
+  int bitIndex = 0;
+  int totalBits = length * 8;
+  for (int right = size - 1; right >= 1; right -= 2) {
+    if (right == 6) {
+      right = 5; // Skip the vertical timing pattern column
+    }
+    bool upward = ((right + 1) & 2) == 0;
+    for (int vert = 0; vert < size; vert++) {
+      int y = upward ? size - 1 - vert : vert;
+      for (int j = 0; j < 2; j++) {
+        int x = right - j;
+        if (!isFunction(x, y) && bitIndex < totalBits) {
+          setModule(x, y,
+                    getBit(interleaved[bitIndex >> 3], 7 - (bitIndex & 7)));
+          bitIndex++;
+        }
+      }
+    }
+  }
+}
+
+// XOR a mask pattern onto all data modules (applying twice undoes it)
+void applyMask(int mask) {
+  int size = current->size;
+  for (int y = 0; y < size; y++) {
+    for (int x = 0; x < size; x++) {
+      if (isFunction(x, y)) {
+        continue;
+      }
+      bool invert;
+      switch (mask) {
+      case 0:
+        invert = (x + y) % 2 == 0;
+        break;
+      case 1:
+        invert = y % 2 == 0;
+        break;
+      case 2:
+        invert = x % 3 == 0;
+        break;
+      case 3:
+        invert = (x + y) % 3 == 0;
+        break;
+      case 4:
+        invert = (x / 3 + y / 2) % 2 == 0;
+        break;
+      case 5:
+        invert = x * y % 2 + x * y % 3 == 0;
+        break;
+      case 6:
+        invert = (x * y % 2 + x * y % 3) % 2 == 0;
+        break;
+      default:
+        invert = ((x + y) % 2 + x * y % 3) % 2 == 0;
+        break;
+      }
+      if (invert) {
+        setModule(x, y, !module(x, y));
+      }
+    }
+  }
+}
+
+// --- Mask penalty scoring ---
+
+void addRunHistory(int runLength, int *history) {
+  if (history[0] == 0) {
+    runLength += current->size; // Light border before the first run
+  }
+  memmove(history + 1, history, 6 * sizeof(int));
+  history[0] = runLength;
+}
+
+int countFinderLikePatterns(const int *history) {
+  int n = history[1];
+  bool core = n > 0 && history[2] == n && history[3] == n * 3 &&
+              history[4] == n && history[5] == n;
+  return (core && history[0] >= n * 4 && history[6] >= n ? 1 : 0) +
+         (core && history[6] >= n * 4 && history[0] >= n ? 1 : 0);
+}
+
+int terminateRunHistory(bool runDark, int runLength, int *history) {
+  if (runDark) {
+    addRunHistory(runLength, history);
+    runLength = 0;
+  }
+  runLength += current->size; // Light border after the last run
+  addRunHistory(runLength, history);
+  return countFinderLikePatterns(history);
+}
+
+// Penalty along one line; horizontal scans rows, otherwise columns
+long linePenalty(int line, bool horizontal) {
+  int size = current->size;
+  long result = 0;
+  bool runDark = false;
+  int runLength = 0;
+  int history[7] = {0};
+  for (int i = 0; i < size; i++) {
+    bool dark = horizontal ? module(i, line) : module(line, i);
+    if (dark == runDark) {
+      runLength++;
+      if (runLength == 5) {
+        result += PENALTY_N1;
+      } else if (runLength > 5) {
+        result++;
+      }
+    } else {
+      addRunHistory(runLength, history);
+      if (!runDark) {
+        result += countFinderLikePatterns(history) * PENALTY_N3;
+      }
+      runDark = dark;
+      runLength = 1;
+    }
+  }
+  result += terminateRunHistory(runDark, runLength, history) * PENALTY_N3;
+  return result;
+}
+
+long penaltyScore() {
+  int size = current->size;
+  long result = 0;
+
+  for (int i = 0; i < size; i++) {
+    result += linePenalty(i, true);
+    result += linePenalty(i, false);
+  }
+
+  // 2x2 blocks of the same colour
+  for (int y = 0; y < size - 1; y++) {
+    for (int x = 0; x < size - 1; x++) {
+      bool dark = module(x, y);
+      if (dark == module(x + 1, y) && dark == module(x, y + 1) &&
+          dark == module(x + 1, y + 1)) {
+        result += PENALTY_N2;
+      }
+    }
+  }
+
+  // Balance of dark and light modules
+  long dark = 0;
+  int total = size * size;
+  for (int i = 0; i < total; i++) {
+    dark += getPacked(current->modules, i);
+  }
+  long deviation = dark * 20 - (long)total * 10;
+  if (deviation < 0) {
+    deviation = -deviation;
+  }
+  long k = (deviation + total - 1) / total - 1;
+  result += k * PENALTY_N4;
+  return result;
+}
+} // namespace
+
+bool qrEncode(const char *text, size_t length, QrMatrix &out) {
+  // Find the smallest version that fits at the lowest ECC level
+  int version = 0;
+  for (int v = 1; v <= QR_MAX_VERSION; v++) {
+    int countBits = v <= 9 ? 8 : 16;
+    if (length < (1UL << countBits) &&
+        segmentBits(v, length) <= numDataCodewords(v, QR_ECC_LOW) * 8) {
+      version = v;
+      break;
+    }
+  }
+  if (version == 0) {
+    return false;
+  }
+
+  // Raise the ECC level while the data still fits in this version
+  int ecc = QR_ECC_LOW;
+  while (ecc < QR_ECC_HIGH &&
+         segmentBits(version, length) <= numDataCodewords(version, ecc + 1) * 8) {
+    ecc++;
+  }
+
+  // Build the data codewords: mode, length, bytes, terminator and padding
+  int capacityBits = numDataCodewords(version, ecc) * 8;
+  memset(codewords, 0, sizeof(codewords));
+  int bitLength = 0;
+  auto appendBits = [&](uint32_t value, int count) {
+    for (int i = count - 1; i >= 0; i--, bitLength++) {
+      codewords[bitLength >> 3] |= ((value >> i) & 1) << (7 - (bitLength & 7));
+    }
+  };
+  appendBits(0x4, 4); // Byte mode
+  appendBits((uint32_t)length, version <= 9 ? 8 : 16);
+  for (size_t i = 0; i < length; i++) {
+    appendBits((uint8_t)text[i], 8);
+  }
+  int terminator = capacityBits - bitLength;
+  appendBits(0, terminator < 4 ? terminator : 4);
+  appendBits(0, (8 - bitLength % 8) % 8);
+  for (uint8_t pad = 0xEC; bitLength < capacityBits; pad ^= 0xEC ^ 0x11) {
+    appendBits(pad, 8);
+  }
+
+  addEccAndInterleave(version, ecc);
+
+  // Draw everything into the packed matrix
+  current = &out;
+  out.version = (uint8_t)version;
+  out.size = (uint8_t)(version * 4 + 17);
+  out.ecc = (uint8_t)ecc;
+  memset(out.modules, 0, sizeof(out.modules));
+  memset(functionMask, 0, sizeof(functionMask));
+
+  drawFunctionPatterns(ecc);
+  drawCodewords(numRawDataModules(version) / 8);
+
+  // Try all eight masks and keep the one with the lowest penalty
+  int bestMask = 0;
+  long bestPenalty = -1;
+  for (int mask = 0; mask < 8; mask++) {
+    applyMask(mask);
+    drawFormatBits(ecc, mask);
+    long penalty = penaltyScore();
+    if (bestPenalty < 0 || penalty < bestPenalty) {
+      bestMask = mask;
+      bestPenalty = penalty;
+    }
+    applyMask(mask); // Undo
+  }
+  applyMask(bestMask);
+  drawFormatBits(ecc, bestMask);
+  out.mask = (uint8_t)bestMask;
+
+  current = nullptr;
+  return true;
+}
+
+bool qrNextDarkRun(const QrMatrix &matrix, int y, int fromX, int &runStart,
+                   int &runLength) {
+  int x = fromX;
+  while (x < matrix.size && !matrix.get(x, y)) {
+    x++;
+  }
+  if (x >= matrix.size) {
+    return false;
+  }
+  runStart = x;
+  while (x < matrix.size && matrix.get(x, y)) {
+    x++;
+  }
+  runLength = x - runStart;
+  return true;
+}
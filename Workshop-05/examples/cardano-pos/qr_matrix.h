@@ -0,0 +1,44 @@
+#ifndef QR_MATRIX_H
+#define QR_MATRIX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Largest QR version we encode. Version 15 is 77x77 modules and holds 412
+// bytes at the lowest error correction level, far more than a web+cardano:
+// payment URI needs.
+#define QR_MAX_VERSION 15
+#define QR_MAX_SIZE (QR_MAX_VERSION * 4 + 17)
+#define QR_MATRIX_BYTES ((QR_MAX_SIZE * QR_MAX_SIZE + 7) / 8)
+
+// Error correction levels (roughly 7%, 15%, 25% and 30% recovery)
+enum QrEcc { QR_ECC_LOW = 0, QR_ECC_MEDIUM, QR_ECC_QUARTILE, QR_ECC_HIGH };
+
+// Encoded QR code as a packed 1-bit module matrix (1 = dark module)
+// Modules are stored row by row, one bit each, without padding between rows.
+struct QrMatrix {
+  uint8_t version; // 1 to QR_MAX_VERSION
+  uint8_t size;    // Modules per side (version * 4 + 17)
+  uint8_t ecc;     // QrEcc level that was used
+  uint8_t mask;    // Mask pattern 0-7
+  uint8_t modules[QR_MATRIX_BYTES];
+
+  bool get(int x, int y) const {
+    int index = y * size + x;
+    return (modules[index >> 3] >> (index & 7)) & 1;
+  }
+};
+
+// Encode text in byte mode into the smallest QR version that fits.
+// Once the version is fixed, the error correction level is raised as far as
+// it goes without needing a bigger version (the extra robustness is free).
+// Returns false if the text does not fit into QR_MAX_VERSION.
+bool qrEncode(const char *text, size_t length, QrMatrix &out);
+
+// Find the next run of dark modules in a row, starting at column fromX.
+// Returns false when the row has no more dark modules. Used to draw the
+// matrix as one filled rectangle per run instead of one per module.
+bool qrNextDarkRun(const QrMatrix &matrix, int y, int fromX, int &runStart,
+                   int &runLength);
+
+#endif
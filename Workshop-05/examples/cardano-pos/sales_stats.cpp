@@ -0,0 +1,269 @@
+#include "sales_stats.h"
+#include <ArduinoJson.h>
+#include <LittleFS.h>
+
+namespace {
+const char *STATS_FILE = "/stats.bin";
+const char *TRANSACTIONS_FILE = "/transactions.json";
+
+const uint32_t STATS_MAGIC = 0x53544153; // "SATS"
+const uint16_t STATS_VERSION = 1;
+
+const uint64_t MS_PER_DAY = 86400000ULL;
+
+// Upper bounds (in ADA) of the amount histogram buckets
+// The last bucket holds everything from 1000 ADA up
+const uint32_t BUCKET_LIMITS_ADA[] = {1, 5, 10, 25, 50, 100, 250, 500, 1000};
+const int BUCKET_COUNT =
+    sizeof(BUCKET_LIMITS_ADA) / sizeof(BUCKET_LIMITS_ADA[0]) + 1;
+
+struct DayTotals {
+  uint32_t day; // Days since 1970-01-01 (UTC), 0 = empty slot
+  uint32_t invoices;
+  uint32_t paid;
+  uint32_t reserved;
+  uint64_t invoicedLovelace;
+  uint64_t paidLovelace;
+};
+
+// Everything that is stored in STATS_FILE
+struct StatsData {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t size; // sizeof(StatsData), catches layout changes
+  uint32_t invoices;
+  uint32_t paid;
+  uint64_t invoicedLovelace;
+  uint64_t paidLovelace;
+  uint32_t invoiceHistogram[BUCKET_COUNT];
+  uint32_t paidHistogram[BUCKET_COUNT];
+  DayTotals days[SALES_STATS_DAYS]; // Ring buffer, slot = day % DAYS
+};
+
+StatsData stats;
+
+void resetStats() {
+  memset(&stats, 0, sizeof(stats));
+  stats.magic = STATS_MAGIC;
+  stats.version = STATS_VERSION;
+  stats.size = sizeof(StatsData);
+}
+
+bool loadStats() {
+  File file = LittleFS.open(STATS_FILE, "r");
+  if (!file) {
+    return false;
+  }
+  size_t length = file.read((uint8_t *)&stats, sizeof(stats));
+  file.close();
+  return length == sizeof(stats) && stats.magic == STATS_MAGIC &&
+         stats.version == STATS_VERSION && stats.size == sizeof(StatsData);
+}
+
+void saveStats() {
+  File file = LittleFS.open(STATS_FILE, "w");
+  if (!file) {
+    Serial.println("[Stats] Error writing stats file");
+    return;
+  }
+  file.write((const uint8_t *)&stats, sizeof(stats));
+  file.close();
+}
+
+int bucketFor(uint64_t lovelaceAmount) {
+  uint64_t ada = lovelaceAmount / 1000000;
+  for (int i = 0; i < BUCKET_COUNT - 1; i++) {
+    if (ada < BUCKET_LIMITS_ADA[i]) {
+      return i;
+    }
+  }
+  return BUCKET_COUNT - 1;
+}
+
+// Totals for the day of a timestamp, reusing the ring slot of an older day.
+// nullptr if the slot already holds a newer day: a sale recorded late, or
+// stamped before an NTP correction, must not wipe that day's totals. Such a
+// sale only counts in the all-time totals.
+DayTotals *dayFor(uint64_t timestamp) {
+  uint32_t day = (uint32_t)(timestamp / MS_PER_DAY);
+  DayTotals &slot = stats.days[day % SALES_STATS_DAYS];
+  if (day < slot.day) {
+    return nullptr;
+  }
+  if (day > slot.day) {
+    memset(&slot, 0, sizeof(slot));
+    slot.day = day;
+  }
+  return &slot;
+}
+
+// Add an invoice (and its payment, if paid) without saving
+void addInvoice(uint64_t timestamp, uint64_t lovelaceAmount) {
+  stats.invoices++;
+  stats.invoicedLovelace += lovelaceAmount;
+  stats.invoiceHistogram[bucketFor(lovelaceAmount)]++;
+
+  DayTotals *day = dayFor(timestamp);
+  if (day != nullptr) {
+    day->invoices++;
+    day->invoicedLovelace += lovelaceAmount;
+  }
+}
+
+void addPayment(uint64_t timestamp, uint64_t lovelaceAmount) {
+  stats.paid++;
+  stats.paidLovelace += lovelaceAmount;
+  stats.paidHistogram[bucketFor(lovelaceAmount)]++;
+
+  DayTotals *day = dayFor(timestamp);
+  if (day != nullptr) {
+    day->paid++;
+    day->paidLovelace += lovelaceAmount;
+  }
+}
+
+// Count the invoices already in transactions.json (first start with stats)
+void rebuildFromTransactions() {
+  if (!LittleFS.exists(TRANSACTIONS_FILE)) {
+    return;
+  }
+  File file = LittleFS.open(TRANSACTIONS_FILE, "r");
+  if (!file) {
+    return;
+  }
+
+  DynamicJsonDocument doc(4096);
+  DeserializationError error = deserializeJson(doc, file);
+  file.close();
+  if (error) {
+    Serial.print("[Stats] Could not read existing transactions: ");
+    Serial.println(error.c_str());
+    return;
+  }
+
+  for (JsonObject tx : doc.as<JsonArray>()) {
+    uint64_t timestamp = tx["timestamp"].as<uint64_t>();
+    uint64_t amount = tx["amount"].as<uint64_t>();
+    addInvoice(timestamp, amount);
+    const char *txHash = tx["txHash"] | "";
+    if (txHash[0] != '\0') {
+      addPayment(timestamp, amount);
+    }
+  }
+}
+
+// Days since 1970-01-01 to "YYYY-MM-DD" (proleptic Gregorian calendar)
+void formatDate(uint32_t daysSinceEpoch, char *out, size_t outSize) {
+  long z = (long)daysSinceEpoch + 719468;
+  long era = z / 146097;
+  long dayOfEra = z - era * 146097;
+  long yearOfEra =
+      (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) /
+      365;
+  long dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 -
+                               yearOfEra / 100);
+  long monthIndex = (5 * dayOfYear + 2) / 153;
+  int day = (int)(dayOfYear - (153 * monthIndex + 2) / 5 + 1);
+  int month = (int)(monthIndex < 10 ? monthIndex + 3 : monthIndex - 9);
+  long year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+  snprintf(out, outSize, "%04ld-%02d-%02d", year, month, day);
+}
+
+void appendHistogram(String &json, const uint32_t *counts) {
+  json += "[";
+  for (int i = 0; i < BUCKET_COUNT; i++) {
+    if (i > 0) {
+      json += ",";
+    }
+    json += String(counts[i]);
+  }
+  json += "]";
+}
+} // namespace
+
+void salesStatsInit() {
+  if (loadStats()) {
+    Serial.print("[Stats] Loaded sales stats (");
+    Serial.print(stats.invoices);
+    Serial.println(" invoices)");
+    return;
+  }
+
+  resetStats();
+  rebuildFromTransactions();
+  saveStats();
+  Serial.print("[Stats] Built sales stats from transactions (");
+  Serial.print(stats.invoices);
+  Serial.println(" invoices)");
+}
+
+void salesStatsRecordInvoice(uint64_t timestamp, uint64_t lovelaceAmount) {
+  addInvoice(timestamp, lovelaceAmount);
+  saveStats();
+}
+
+void salesStatsRecordPayment(uint64_t timestamp, uint64_t lovelaceAmount) {
+  addPayment(timestamp, lovelaceAmount);
+  saveStats();
+}
+
+String salesStatsToJson() {
+  String json;
+  json.reserve(2048);
+
+  json += "{\"invoices\":";
+  json += String(stats.invoices);
+  json += ",\"paid\":";
+  json += String(stats.paid);
+  json += ",\"unpaid\":";
+  json += String(stats.invoices - stats.paid);
+  json += ",\"invoicedLovelace\":";
+  json += String(stats.invoicedLovelace);
+  json += ",\"paidLovelace\":";
+  json += String(stats.paidLovelace);
+  json += ",\"averageTicketLovelace\":";
+  json += String(stats.paid > 0 ? stats.paidLovelace / stats.paid : 0);
+
+  // Days, newest first. Walk back from the most recent day in the ring.
+  uint32_t newestDay = 0;
+  for (int i = 0; i < SALES_STATS_DAYS; i++) {
+    newestDay = max(newestDay, stats.days[i].day);
+  }
+  json += ",\"days\":[";
+  bool first = true;
+  for (int i = 0; i < SALES_STATS_DAYS && newestDay >= (uint32_t)i; i++) {
+    const DayTotals &day = stats.days[(newestDay - i) % SALES_STATS_DAYS];
+    if (day.day != newestDay - i || day.invoices == 0) {
+      continue;
+    }
+    char date[32];
+    formatDate(day.day, date, sizeof(date));
+    json += first ? "{\"date\":\"" : ",{\"date\":\"";
+    json += date;
+    json += "\",\"invoices\":";
+    json += String(day.invoices);
+    json += ",\"paid\":";
+    json += String(day.paid);
+    json += ",\"invoicedLovelace\":";
+    json += String(day.invoicedLovelace);
+    json += ",\"paidLovelace\":";
+    json += String(day.paidLovelace);
+    json += "}";
+    first = false;
+  }
+  json += "]";
+
+  json += ",\"histogram\":{\"limitsAda\":[";
+  for (int i = 0; i < BUCKET_COUNT - 1; i++) {
+    if (i > 0) {
+      json += ",";
+    }
+    json += String(BUCKET_LIMITS_ADA[i]);
+  }
+  json += "],\"invoices\":";
+  appendHistogram(json, stats.invoiceHistogram);
+  json += ",\"paid\":";
+  appendHistogram(json, stats.paidHistogram);
+  json += "}}";
+  return json;
+}
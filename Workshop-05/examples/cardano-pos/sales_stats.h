@@ -0,0 +1,25 @@
+#ifndef SALES_STATS_H
+#define SALES_STATS_H
+
+#include <Arduino.h>
+
+// Number of days kept for per-day totals (older days are dropped)
+#define SALES_STATS_DAYS 32
+
+// Load the aggregates from LittleFS, or rebuild them from transactions.json
+// if there is no stats file yet (call after LittleFS is mounted)
+void salesStatsInit();
+
+// Count a new invoice
+// timestamp: Invoice time in milliseconds since epoch (from the browser)
+// lovelaceAmount: Amount in lovelace (with ID already added)
+void salesStatsRecordInvoice(uint64_t timestamp, uint64_t lovelaceAmount);
+
+// Count an invoice as paid (call once per invoice, when its hash is stored)
+void salesStatsRecordPayment(uint64_t timestamp, uint64_t lovelaceAmount);
+
+// Build the /api/stats JSON. Size only depends on SALES_STATS_DAYS and the
+// histogram, not on how many invoices were recorded.
+String salesStatsToJson();
+
+#endif
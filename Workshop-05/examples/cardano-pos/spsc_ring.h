@@ -0,0 +1,51 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+// Fixed-size ring for passing items from exactly one producer task to exactly
+// one consumer task without locks. Capacity must be a power of two.
+// Indexes only ever grow (wrapping at 2^32), so full and empty are told
+// apart without a wasted slot.
+template <typename T, uint32_t Capacity> class SpscRing {
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of two");
+
+public:
+  // Producer side. Returns false if the ring is full.
+  bool push(const T &item) {
+    uint32_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) == Capacity) {
+      return false;
+    }
+    items_[head & (Capacity - 1)] = item;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side. Returns false if the ring is empty.
+  bool pop(T &item) {
+    uint32_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail == head_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    item = items_[tail & (Capacity - 1)];
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Items waiting, exact from either side for its own end
+  uint32_t size() const {
+    return head_.load(std::memory_order_acquire) -
+           tail_.load(std::memory_order_acquire);
+  }
+
+private:
+  T items_[Capacity];
+  std::atomic<uint32_t> head_{0}; // Next slot to write (producer)
+  std::atomic<uint32_t> tail_{0}; // Next slot to read (consumer)
+};
+
+#endif
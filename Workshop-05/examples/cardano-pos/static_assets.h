@@ -0,0 +1,649 @@
+// static_assets.h - Web interface files compressed into the firmware
+//
+// GENERATED by Workshop-05/tools/embed_assets.py from data/ - do not edit.
+// Run the script again after changing anything in data/.
+
+#ifndef STATIC_ASSETS_H
+#define STATIC_ASSETS_H
+
+#include <Arduino.h>
+
+struct StaticAsset {
+  const char *path;         // URL path, e.g. "/index.html"
+  const char *contentType;  // MIME type of the uncompressed file
+  const char *etag;         // Quoted hash of the file contents
+  const char *cacheControl; // Cache-Control header value
+  const uint8_t *data;      // Gzip-compressed file
+  size_t length;            // Compressed size in bytes
+  size_t originalLength;    // Uncompressed size in bytes
+};
+
+// /favicon.ico: 15406 bytes, 2404 gzipped
+static const uint8_t ASSET_FAVICON_ICO[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xed, 0x1a, 0x69, 0x6c, 0x14, 0x55,
+    0xf8, 0x7d, 0x1c, 0x8a, 0x1c, 0xd2, 0x46, 0x0b, 0x2a, 0x0a, 0x45, 0x69, 0xa9, 0x90, 0x00, 0x89,
+    0x94, 0xf8, 0x43, 0x23, 0xd1, 0x1f, 0x5e, 0x18, 0xaf, 0xa1, 0x8b, 0x3d, 0xb4, 0x96, 0x02, 0x6d,
+    0xa1, 0x2d, 0x28, 0xa2, 0x35, 0x50, 0xc1, 0x40, 0x04, 0x05, 0xa5, 0x46, 0xb0, 0x02, 0x25, 0x0a,
+    0xe2, 0x45, 0x50, 0x44, 0x89, 0x80, 0xa0, 0x88, 0xb8, 0x05, 0x01, 0x6d, 0x15, 0x82, 0xe5, 0xac,
+    0x0a, 0x2c, 0x72, 0xb4, 0x48, 0x5b, 0xda, 0x6d, 0x4b, 0x3f, 0xdf, 0xf7, 0x76, 0x77, 0x76, 0x66,
+    0x77, 0x66, 0x67, 0x76, 0x77, 0x76, 0x5b, 0xa3, 0x2f, 0x79, 0x99, 0xdd, 0x99, 0x77, 0x7c, 0xd7,
+    0xfb, 0xce, 0xc7, 0x18, 0xb0, 0xce, 0x2c, 0x26, 0x86, 0xf1, 0x67, 0x3c, 0xcb, 0xe9, 0xc2, 0xd8,
+    0x28, 0xc6, 0x58, 0x7c, 0xbc, 0xeb, 0x7f, 0x52, 0x2c, 0x63, 0x2b, 0xf9, 0xbb, 0x11, 0x23, 0xdc,
+    0xdf, 0x13, 0x19, 0xb3, 0xc7, 0x31, 0x96, 0xc4, 0xc7, 0xc4, 0xd0, 0x38, 0xe6, 0x7a, 0xaf, 0xd7,
+    0x6c, 0x8c, 0x15, 0x8f, 0x65, 0xcc, 0xc9, 0x3b, 0x52, 0x97, 0xc0, 0xf5, 0x94, 0xff, 0xcb, 0x4f,
+    0xf0, 0xbe, 0x07, 0xf1, 0xde, 0x69, 0x03, 0x56, 0x2c, 0x89, 0xb9, 0xfc, 0x1b, 0xb8, 0xbf, 0xf3,
+    0xa7, 0x6b, 0xac, 0x67, 0xbc, 0xe2, 0x09, 0xea, 0x35, 0xf9, 0x7f, 0xa7, 0x67, 0x3d, 0x79, 0x1e,
+    0x80, 0x67, 0x7d, 0xc5, 0x38, 0xf0, 0xfe, 0x76, 0xc3, 0x28, 0xc3, 0x09, 0x4c, 0xf5, 0xcd, 0xb5,
+    0x07, 0xe0, 0xb4, 0x21, 0x43, 0x70, 0xc3, 0xc2, 0x85, 0xb8, 0x6f, 0xe3, 0x46, 0xb4, 0xaf, 0x5b,
+    0x87, 0x65, 0x93, 0xf3, 0x30, 0xed, 0xaa, 0xab, 0x7c, 0x60, 0xf2, 0xec, 0xed, 0xdd, 0x4f, 0xe2,
+    0x7b, 0x2d, 0xcb, 0xc9, 0xc5, 0xd6, 0x96, 0x16, 0xac, 0x3b, 0x77, 0x0e, 0x2b, 0x36, 0x6f, 0xc6,
+    0x43, 0xbb, 0x76, 0x61, 0xeb, 0xe5, 0xcb, 0xf8, 0x4d, 0x59, 0x99, 0x77, 0x2e, 0x30, 0x19, 0x1f,
+    0x6f, 0x07, 0x7c, 0xf1, 0xf6, 0xdb, 0xf1, 0x32, 0x1f, 0xbb, 0x63, 0xcd, 0xfb, 0x98, 0xd1, 0xa3,
+    0xbb, 0x8c, 0x53, 0xd1, 0xc8, 0x64, 0xcc, 0x8a, 0x8b, 0x53, 0xd1, 0x55, 0xf2, 0xa5, 0x0f, 0x7f,
+    0x7e, 0xbf, 0x7a, 0x35, 0xd6, 0x9e, 0x72, 0x60, 0x6a, 0x37, 0x0d, 0x58, 0x95, 0x74, 0x05, 0x6d,
+    0xfe, 0x54, 0x57, 0x54, 0xe2, 0x2e, 0x8e, 0xaf, 0xa4, 0xa0, 0x85, 0x17, 0x56, 0x05, 0x0f, 0xc0,
+    0xbb, 0xb6, 0x92, 0x7e, 0xd5, 0x95, 0x95, 0xb8, 0xfb, 0xd3, 0xcf, 0xfc, 0xf0, 0xd2, 0xc4, 0x1b,
+    0x98, 0x0a, 0x46, 0x5a, 0x67, 0xfb, 0xaa, 0x55, 0x78, 0xe1, 0xf4, 0x69, 0x4e, 0xeb, 0x6e, 0xa8,
+    0xe2, 0xad, 0x92, 0x56, 0xa0, 0x94, 0x17, 0xb5, 0xac, 0x15, 0x8d, 0x1a, 0x85, 0x97, 0x5b, 0x5b,
+    0xf1, 0x87, 0x0f, 0x3f, 0xc4, 0x8c, 0x5e, 0x3d, 0xe5, 0xf5, 0x8b, 0x92, 0x93, 0xf1, 0xe9, 0x98,
+    0x58, 0x6d, 0x39, 0x52, 0xd1, 0x88, 0x61, 0xe9, 0x84, 0x09, 0xd8, 0xd2, 0xdc, 0x8c, 0x0d, 0x35,
+    0xb5, 0xf8, 0xeb, 0xb6, 0x6d, 0x78, 0x74, 0xef, 0x5e, 0xe4, 0x8b, 0xe2, 0x57, 0x6f, 0xbd, 0xa5,
+    0x01, 0xbb, 0x92, 0x36, 0x5e, 0x98, 0x0a, 0x07, 0x27, 0xe2, 0xfa, 0xf9, 0xf3, 0xf1, 0xc7, 0xcf,
+    0x3f, 0xc7, 0x1f, 0x3e, 0xfe, 0x08, 0x97, 0x4d, 0x9a, 0x88, 0x69, 0xdd, 0xba, 0xc9, 0xb4, 0x96,
+    0x98, 0xcf, 0x3a, 0xe0, 0x2b, 0xeb, 0xa0, 0xe6, 0x2f, 0x30, 0x59, 0xb6, 0x95, 0xfc, 0xe7, 0xf2,
+    0xe6, 0xf4, 0xe2, 0xa4, 0x98, 0x23, 0xcb, 0x24, 0xa8, 0xcf, 0x9e, 0x02, 0x7f, 0x3a, 0xb7, 0x29,
+    0x74, 0x06, 0xe9, 0x1c, 0x81, 0x42, 0x0e, 0x40, 0xc1, 0x27, 0x00, 0x1f, 0x99, 0x03, 0xcf, 0xde,
+    0x4e, 0x1b, 0x83, 0x62, 0x16, 0x66, 0x4b, 0x72, 0xeb, 0x98, 0xd1, 0x06, 0x7a, 0x66, 0x36, 0x63,
+    0x9d, 0x52, 0x18, 0x9b, 0xc9, 0x61, 0x72, 0x68, 0xf1, 0xcc, 0x4b, 0x3f, 0x50, 0x9f, 0x7d, 0x9d,
+    0x2e, 0x81, 0xd6, 0x7b, 0xf0, 0x7d, 0xe7, 0xe0, 0x38, 0xce, 0x9c, 0x0d, 0xae, 0xbd, 0x8d, 0xd6,
+    0xf4, 0x95, 0x45, 0xe3, 0x71, 0xa0, 0x39, 0xd7, 0xf7, 0x9d, 0x7b, 0x6f, 0x87, 0xfe, 0xde, 0x6a,
+    0xfe, 0x1a, 0xc2, 0xa9, 0xb7, 0x9f, 0x06, 0x0e, 0xee, 0xb5, 0x1c, 0x7e, 0xb2, 0x0a, 0x01, 0xd6,
+    0x03, 0x03, 0xda, 0x9b, 0x81, 0x2f, 0x82, 0x5d, 0x32, 0x01, 0xa3, 0x39, 0x98, 0x41, 0x57, 0x76,
+    0x24, 0x53, 0x63, 0x21, 0x6c, 0x7a, 0x48, 0xa0, 0xbf, 0x0f, 0xad, 0xfb, 0xc4, 0x15, 0x57, 0xe0,
+    0xac, 0x3b, 0xee, 0xc0, 0xb7, 0xb3, 0xb3, 0xf1, 0xbd, 0x67, 0x9f, 0xc1, 0xe5, 0x79, 0x79, 0x38,
+    0xf7, 0xde, 0x7b, 0xf1, 0xc9, 0xab, 0xaf, 0xd6, 0x9c, 0x27, 0x05, 0x94, 0x31, 0xf0, 0x5b, 0x5f,
+    0x0f, 0xae, 0x09, 0xd7, 0x5d, 0x87, 0x1b, 0x4b, 0x4a, 0xb0, 0xa1, 0xb6, 0x16, 0xa9, 0xb5, 0xb5,
+    0xa1, 0xaa, 0x35, 0x37, 0x35, 0xe1, 0xf7, 0x6b, 0xd6, 0x60, 0x61, 0x42, 0x82, 0xde, 0xd9, 0x0b,
+    0x78, 0x26, 0x02, 0xf1, 0x67, 0xc1, 0xc3, 0x0f, 0x63, 0x7d, 0x4d, 0x8d, 0xbc, 0x57, 0x1b, 0xfa,
+    0x6c, 0xae, 0x68, 0xce, 0x4b, 0x97, 0x70, 0xf1, 0xb8, 0x71, 0xda, 0xfb, 0x9b, 0xc4, 0x55, 0xd9,
+    0xdf, 0xe0, 0x6b, 0x91, 0xfd, 0xf1, 0x34, 0xfa, 0x4d, 0x3e, 0xc0, 0x47, 0xb3, 0x66, 0xe1, 0xf2,
+    0x9c, 0x1c, 0x5c, 0x3d, 0x63, 0x06, 0x96, 0xaf, 0x5d, 0x8b, 0xce, 0xc6, 0x46, 0xf1, 0xbd, 0xa9,
+    0xa1, 0x01, 0x9f, 0xbf, 0xed, 0x36, 0x73, 0xfc, 0x36, 0xc0, 0x7d, 0xea, 0xad, 0xb7, 0x0a, 0x7c,
+    0xd0, 0x8d, 0x6f, 0x55, 0x79, 0x39, 0x16, 0x24, 0x25, 0x69, 0xce, 0x99, 0xd8, 0xaf, 0x1f, 0xfe,
+    0xc4, 0x7d, 0x9b, 0x45, 0x63, 0xc7, 0x9a, 0x93, 0xf5, 0x00, 0xfa, 0xc2, 0x33, 0x9e, 0xd6, 0xf3,
+    0x50, 0xfa, 0xe0, 0x8e, 0x1d, 0x2e, 0x7b, 0x67, 0x96, 0x87, 0xa0, 0x4f, 0x63, 0xc9, 0x50, 0x3e,
+    0x00, 0xf3, 0x07, 0x25, 0x70, 0x19, 0x6b, 0x93, 0x65, 0x2b, 0x2f, 0x3e, 0x3e, 0x04, 0x7a, 0x82,
+    0x79, 0xbc, 0x7d, 0xbe, 0xaf, 0xcc, 0xcf, 0x97, 0x79, 0xbe, 0x93, 0xfb, 0x1e, 0x5e, 0xbb, 0x09,
+    0x41, 0xea, 0x40, 0x08, 0x49, 0x0f, 0x7c, 0xfd, 0x4e, 0xa9, 0xbc, 0xff, 0x32, 0x2e, 0x67, 0x3e,
+    0x76, 0x5e, 0xdf, 0xee, 0x98, 0xdc, 0x5f, 0xd2, 0xb3, 0x2d, 0xee, 0x35, 0x49, 0xa6, 0x5d, 0x72,
+    0xd7, 0x86, 0xaf, 0xf2, 0xf3, 0xa7, 0x47, 0x3b, 0xbd, 0xf9, 0x52, 0x30, 0x34, 0xd7, 0xe8, 0xb4,
+    0xbf, 0x47, 0xf6, 0x5e, 0x7d, 0xe4, 0x11, 0xff, 0xfd, 0x34, 0x6c, 0x96, 0x2e, 0x0f, 0x00, 0x34,
+    0xfc, 0x43, 0xd0, 0xf0, 0xd7, 0xbc, 0x7d, 0x4b, 0xe9, 0x3b, 0x32, 0xfd, 0x97, 0xe7, 0xe6, 0x9a,
+    0x92, 0xbd, 0xc0, 0x3a, 0x45, 0xcf, 0x37, 0xd0, 0x96, 0xab, 0x15, 0x3c, 0x3e, 0xf1, 0x34, 0xfb,
+    0x27, 0x9f, 0x84, 0x29, 0x57, 0x41, 0x8c, 0x75, 0xc3, 0x36, 0x79, 0x60, 0xbc, 0x7c, 0xfe, 0x5a,
+    0x9c, 0x4e, 0x9c, 0x72, 0xcb, 0x2d, 0x01, 0xfc, 0x2c, 0x73, 0x7e, 0x4c, 0xb0, 0x67, 0x61, 0xcf,
+    0xfa, 0xf5, 0xb2, 0x0c, 0x1c, 0xe2, 0xba, 0x2f, 0xbd, 0x47, 0x0f, 0x53, 0xfc, 0x96, 0xc2, 0xa4,
+    0x85, 0x67, 0x7e, 0x41, 0x62, 0x22, 0x36, 0xd5, 0xd7, 0xcb, 0x7c, 0xa0, 0xb8, 0x61, 0xfa, 0xf0,
+    0xe1, 0x9a, 0xeb, 0xe5, 0x0d, 0x18, 0x80, 0xfb, 0xbe, 0xfc, 0x12, 0x5f, 0xba, 0xeb, 0x2e, 0x53,
+    0xbe, 0x98, 0xd9, 0x33, 0xfb, 0xda, 0x63, 0x8f, 0x89, 0xd8, 0x53, 0xb6, 0x7d, 0x3c, 0x96, 0x3c,
+    0xf0, 0xdd, 0x77, 0xf8, 0xe9, 0xbc, 0x79, 0xf8, 0xee, 0xd4, 0xa9, 0xf8, 0x71, 0x71, 0x31, 0xee,
+    0xdd, 0xf0, 0x85, 0xe0, 0x11, 0xb5, 0x8b, 0x3c, 0x46, 0xcd, 0x1f, 0x34, 0xc8, 0x98, 0xc7, 0x2a,
+    0xbf, 0x10, 0xfc, 0x61, 0x53, 0xfc, 0x9f, 0x77, 0xdf, 0xfd, 0xf8, 0xf7, 0x99, 0x33, 0x01, 0xac,
+    0x2e, 0xca, 0x36, 0xea, 0x52, 0x5d, 0x1d, 0xce, 0x1f, 0x33, 0xc6, 0x84, 0x0f, 0x05, 0x41, 0xf9,
+    0x69, 0x59, 0xd7, 0x5c, 0x83, 0xeb, 0x17, 0x2c, 0xc0, 0x0b, 0x1c, 0x0e, 0xff, 0x5d, 0x5d, 0x76,
+    0xf7, 0x9b, 0x95, 0x2b, 0x65, 0x3b, 0x21, 0xe9, 0x9d, 0x4f, 0xd0, 0x3b, 0xf3, 0xfa, 0xfe, 0x92,
+    0xf2, 0xdd, 0xb8, 0x2e, 0x5d, 0xf1, 0x85, 0x91, 0x23, 0xf1, 0xcd, 0xf4, 0x74, 0x7e, 0x46, 0x27,
+    0xe3, 0xd2, 0xac, 0x2c, 0x9c, 0x3d, 0x7a, 0x34, 0xa6, 0x77, 0xef, 0x6e, 0x42, 0xce, 0xc0, 0x02,
+    0x1f, 0x35, 0x90, 0xff, 0x1b, 0xfc, 0x39, 0x8f, 0x94, 0x4e, 0x91, 0x42, 0x89, 0x55, 0xc2, 0x81,
+    0x2d, 0x20, 0xfe, 0xa0, 0x15, 0xcb, 0x39, 0xcc, 0xc2, 0x1c, 0xba, 0x3f, 0xaf, 0x0b, 0xb3, 0x43,
+    0xc4, 0xbe, 0x06, 0x36, 0xd4, 0x5c, 0x1c, 0x12, 0x78, 0x6f, 0xad, 0x33, 0x47, 0x7b, 0x53, 0xfc,
+    0x6d, 0x73, 0xc1, 0xe0, 0x90, 0x75, 0x33, 0xa8, 0xed, 0xa5, 0x32, 0x0f, 0xa1, 0xb6, 0xeb, 0xe0,
+    0x63, 0xf3, 0x40, 0x9d, 0x13, 0x04, 0x5d, 0x18, 0x38, 0xde, 0x30, 0x73, 0x0e, 0xdf, 0x9b, 0xfd,
+    0xc7, 0x1b, 0xe5, 0x49, 0x46, 0xf0, 0x9e, 0x69, 0x90, 0x27, 0xa1, 0xc6, 0xe9, 0xd6, 0x9b, 0xf3,
+    0x2c, 0x9d, 0x3f, 0xed, 0xfc, 0xd9, 0x28, 0x85, 0x21, 0x8b, 0x12, 0x63, 0x46, 0x3c, 0x0a, 0x39,
+    0x6e, 0x21, 0xd8, 0xf8, 0xb3, 0xdc, 0x0d, 0x6b, 0x6f, 0x05, 0xec, 0x4b, 0xf8, 0xb3, 0xc9, 0xba,
+    0x98, 0x1f, 0xc2, 0x9b, 0x6f, 0xe0, 0x37, 0x12, 0x1e, 0x6e, 0x98, 0x05, 0xdd, 0xdd, 0x78, 0x99,
+    0x87, 0x0d, 0xac, 0xe0, 0x4b, 0xd8, 0xbd, 0xc9, 0xe6, 0xe2, 0x43, 0x79, 0xfb, 0xe4, 0x65, 0xc0,
+    0x8a, 0x75, 0xec, 0xfa, 0xb4, 0x87, 0xc8, 0xc0, 0x0d, 0xd6, 0xe1, 0xa5, 0x84, 0xbd, 0xbd, 0x73,
+    0x64, 0x2a, 0xdd, 0x0d, 0x66, 0xed, 0x45, 0xa4, 0x60, 0x68, 0xaf, 0x0e, 0xff, 0x1e, 0x98, 0xa1,
+    0x3d, 0x64, 0xc3, 0x24, 0xdd, 0xc0, 0x22, 0x98, 0x21, 0x98, 0x7c, 0x91, 0xf7, 0x77, 0x0a, 0xf7,
+    0x4f, 0xc8, 0xdf, 0xce, 0xee, 0xdb, 0x57, 0xf8, 0xfb, 0x05, 0x83, 0x12, 0xb0, 0x70, 0xf0, 0x60,
+    0xcc, 0x4f, 0x48, 0xc0, 0xbc, 0xfe, 0x03, 0x70, 0x7c, 0x5c, 0x1c, 0xa6, 0xba, 0x6b, 0x33, 0x1d,
+    0x89, 0x17, 0x29, 0x9d, 0x3a, 0x61, 0x61, 0x52, 0x92, 0xc8, 0x27, 0x6c, 0x2b, 0x5b, 0x81, 0xbf,
+    0xed, 0xdc, 0x89, 0x7f, 0x1d, 0x3f, 0x8e, 0x75, 0x35, 0x35, 0x22, 0x6e, 0xaa, 0x3b, 0x7f, 0x0e,
+    0x1d, 0x87, 0x0f, 0xe3, 0xfe, 0x6f, 0xbf, 0x15, 0xb5, 0xa9, 0x92, 0xb4, 0x34, 0xcc, 0xee, 0xd3,
+    0xc7, 0x64, 0xde, 0x21, 0xb2, 0xfa, 0x90, 0xf2, 0xcb, 0xeb, 0xe6, 0xce, 0xc5, 0xd3, 0x47, 0x8f,
+    0xca, 0xb9, 0xce, 0x40, 0x91, 0x20, 0xa5, 0x0e, 0x1a, 0x2f, 0x5e, 0xc4, 0x3f, 0x0f, 0x1c, 0xc0,
+    0x25, 0x99, 0x99, 0x38, 0xae, 0x6b, 0x57, 0x4b, 0x63, 0x74, 0xb3, 0xfc, 0xa2, 0x7d, 0x5f, 0x48,
+    0x4e, 0xc6, 0xea, 0x8a, 0x0a, 0x0c, 0xb5, 0xb5, 0x36, 0x37, 0xe3, 0xd6, 0x15, 0x2b, 0x8c, 0x79,
+    0x61, 0xf1, 0x19, 0x7c, 0x82, 0xc3, 0x4e, 0x32, 0x70, 0xfe, 0xc4, 0x09, 0x5d, 0xd8, 0xa8, 0xb6,
+    0x4c, 0xf2, 0x53, 0xeb, 0x70, 0x88, 0xdc, 0x3c, 0xe5, 0x07, 0x94, 0x8c, 0xf0, 0xc4, 0xc7, 0x17,
+    0xcf, 0x9e, 0x15, 0x75, 0x03, 0xab, 0x75, 0x66, 0x20, 0x3e, 0xbe, 0x7c, 0xcf, 0xdd, 0xa2, 0xf6,
+    0xeb, 0x27, 0x1b, 0x1c, 0xc6, 0xea, 0xca, 0x0a, 0x5c, 0x35, 0x7d, 0xba, 0xa8, 0xe3, 0x16, 0xf0,
+    0x73, 0x4b, 0xf9, 0xa5, 0xc2, 0xc4, 0x44, 0x11, 0x4b, 0x53, 0x9d, 0x55, 0x39, 0x8f, 0x72, 0x1b,
+    0x94, 0xef, 0xf0, 0x3f, 0xd3, 0x10, 0x19, 0x5b, 0xc0, 0xe5, 0x27, 0xb7, 0x7f, 0x7f, 0xac, 0xe1,
+    0x34, 0x55, 0x26, 0x3d, 0x08, 0xee, 0x33, 0xd5, 0xd5, 0xf8, 0xf6, 0xf8, 0xf1, 0x86, 0xfa, 0xe5,
+    0xe9, 0xd8, 0x58, 0xdc, 0xb8, 0x78, 0x31, 0xd6, 0x73, 0x9e, 0xec, 0xdd, 0xb0, 0x01, 0x9f, 0xea,
+    0xdd, 0x3b, 0x6a, 0x76, 0x2d, 0xa3, 0x67, 0x4f, 0x77, 0xfe, 0x56, 0x2d, 0x27, 0x95, 0x5b, 0xb6,
+    0x68, 0xe4, 0xaf, 0xf4, 0x3b, 0xe1, 0xf8, 0x86, 0xcd, 0x86, 0x93, 0xfa, 0xf5, 0xb3, 0x3e, 0x07,
+    0x10, 0xa0, 0xbf, 0xf2, 0xe0, 0x83, 0x5c, 0x17, 0x9e, 0x57, 0xc1, 0x7f, 0xfa, 0xc8, 0x11, 0x71,
+    0x87, 0xc3, 0x06, 0xd0, 0x71, 0xec, 0xac, 0xc6, 0xdc, 0xd4, 0x2b, 0xaf, 0x14, 0xba, 0x5b, 0xa5,
+    0x3f, 0x5a, 0x5a, 0x70, 0x91, 0x24, 0x59, 0xa7, 0xf7, 0xc0, 0x4c, 0xae, 0x35, 0x34, 0x9c, 0x26,
+    0xde, 0x70, 0x03, 0x1e, 0xd9, 0xb3, 0xc7, 0x2b, 0xf6, 0xfc, 0xc7, 0x2f, 0x5b, 0xb7, 0xa2, 0xad,
+    0x73, 0xe7, 0x10, 0x6a, 0x0f, 0xd1, 0xa5, 0x3f, 0xd1, 0x96, 0x64, 0x84, 0x72, 0x81, 0x4a, 0x85,
+    0xf3, 0x7a, 0x4a, 0x4a, 0xc8, 0xfb, 0x4a, 0x61, 0xc6, 0x92, 0xc1, 0xd2, 0x67, 0xfe, 0x43, 0x0f,
+    0xa9, 0x64, 0x87, 0xf4, 0x47, 0x81, 0x5c, 0x53, 0xed, 0xf8, 0x9d, 0xea, 0xd1, 0xca, 0x76, 0xe2,
+    0xe0, 0x41, 0xcc, 0xbd, 0xe9, 0xa6, 0x08, 0xc5, 0x6e, 0x60, 0xb9, 0x8c, 0xbd, 0x3f, 0x63, 0x86,
+    0x0a, 0xfe, 0x63, 0xfb, 0xf6, 0xe1, 0x24, 0x7e, 0x26, 0xcc, 0xd5, 0x78, 0x8c, 0x7d, 0xd7, 0x50,
+    0xf3, 0x06, 0x66, 0xf7, 0x5d, 0xad, 0x01, 0xff, 0x44, 0x0f, 0xfc, 0x21, 0xd7, 0xae, 0x22, 0x1d,
+    0x43, 0x79, 0x71, 0x27, 0xdf, 0x58, 0xd9, 0x4e, 0x56, 0xfd, 0x26, 0x6c, 0x71, 0x14, 0x73, 0x0e,
+    0x21, 0xd7, 0xcd, 0x5d, 0xb6, 0xeb, 0x01, 0x55, 0x5d, 0xa2, 0xe1, 0xc2, 0x05, 0xe1, 0xd7, 0x68,
+    0xe9, 0x67, 0x29, 0x0a, 0xf2, 0x1c, 0xec, 0xf8, 0xa9, 0x3c, 0x3e, 0x69, 0xac, 0xaf, 0x57, 0xd5,
+    0x7a, 0x4a, 0x52, 0x53, 0x2d, 0xd1, 0x8d, 0xd1, 0xf0, 0x7f, 0x26, 0x5c, 0x7f, 0x3d, 0x1e, 0xde,
+    0xbd, 0x5b, 0x25, 0x43, 0x07, 0xb6, 0x6f, 0xf7, 0x8b, 0x3f, 0xac, 0xf4, 0x1f, 0xac, 0xac, 0x1b,
+    0xd0, 0xfd, 0x1e, 0xf2, 0x1b, 0xdb, 0x14, 0x17, 0x6c, 0x5a, 0x5b, 0x5b, 0xb1, 0x24, 0x3d, 0xa3,
+    0xc3, 0xe4, 0x10, 0x8c, 0xf0, 0xa2, 0xfb, 0x48, 0x14, 0x6f, 0x28, 0xdb, 0x19, 0x1e, 0xe7, 0x3e,
+    0x37, 0x6c, 0xb8, 0x88, 0xdd, 0x83, 0x39, 0xbf, 0x52, 0x04, 0xf2, 0x30, 0x46, 0xe7, 0x9a, 0x72,
+    0x0b, 0x3b, 0x3f, 0xf8, 0x40, 0x1d, 0xb7, 0x50, 0xdd, 0x95, 0xcb, 0x11, 0xc5, 0x2b, 0x66, 0x69,
+    0x9e, 0xc6, 0xd7, 0x79, 0xed, 0xd1, 0x47, 0x31, 0xa3, 0x57, 0xaf, 0xa8, 0xdb, 0x61, 0xf2, 0xd9,
+    0xcf, 0xfe, 0xfe, 0xbb, 0x1f, 0x0e, 0xe7, 0x78, 0x2c, 0xf9, 0xee, 0xb4, 0x69, 0x22, 0x46, 0x08,
+    0x24, 0x27, 0xd9, 0x7d, 0xfa, 0xe2, 0x96, 0xd2, 0x52, 0x11, 0x5b, 0x6e, 0x5e, 0xba, 0x54, 0xd4,
+    0x3d, 0xa3, 0x2d, 0x4b, 0xb3, 0xee, 0xbc, 0x13, 0x6b, 0x4e, 0x9e, 0xf4, 0xbb, 0x6c, 0x46, 0x67,
+    0xe3, 0xd4, 0xa1, 0x43, 0xb8, 0x76, 0xce, 0x1c, 0x11, 0x2f, 0x92, 0xce, 0x22, 0x1f, 0x69, 0xda,
+    0x90, 0xa1, 0xf8, 0xca, 0x98, 0x31, 0xb8, 0x79, 0xc9, 0x12, 0xf9, 0x9e, 0x9a, 0xa8, 0x0d, 0x73,
+    0x7d, 0x56, 0x96, 0x3f, 0x85, 0xe3, 0xd0, 0xc5, 0x24, 0xef, 0xc2, 0xf1, 0xa5, 0x41, 0x51, 0x2b,
+    0xee, 0x22, 0xfc, 0xfe, 0xb3, 0x5c, 0xf6, 0x75, 0x73, 0x25, 0x1c, 0x17, 0x27, 0xf7, 0x57, 0xc9,
+    0xcf, 0x6b, 0xd6, 0xc8, 0xab, 0x78, 0x30, 0xff, 0xeb, 0xd8, 0x31, 0x7c, 0x76, 0xe8, 0xd0, 0xa8,
+    0xcb, 0x11, 0xe1, 0x30, 0x7d, 0xd8, 0x30, 0xac, 0xb2, 0xdb, 0x4d, 0xe7, 0x4b, 0x7c, 0xef, 0x09,
+    0xd0, 0xfd, 0x2d, 0xd2, 0x69, 0x99, 0x31, 0x31, 0xd6, 0xe6, 0x9c, 0x4d, 0xfa, 0x2d, 0x34, 0x26,
+    0xbd, 0x47, 0x77, 0x5c, 0x53, 0x54, 0x84, 0xa7, 0xaa, 0xaa, 0x5c, 0x77, 0x3a, 0xda, 0x0c, 0x6e,
+    0x33, 0xf0, 0xef, 0x64, 0xbb, 0x8f, 0x57, 0x54, 0x08, 0x1e, 0xfa, 0xc5, 0x3f, 0x51, 0x8f, 0x7d,
+    0x40, 0xe8, 0xce, 0xc9, 0x03, 0x07, 0x8a, 0x7c, 0xda, 0x26, 0x1e, 0x63, 0x52, 0x5c, 0x46, 0xfe,
+    0x75, 0x8d, 0xe3, 0x14, 0xfe, 0xcd, 0xf5, 0xed, 0x79, 0x7e, 0x56, 0xfe, 0xd8, 0xbf, 0x1f, 0x7f,
+    0xde, 0xb4, 0x09, 0xbf, 0x58, 0xb4, 0x08, 0x17, 0x3e, 0xfe, 0x38, 0x66, 0xc6, 0xc6, 0xb6, 0x63,
+    0xad, 0x41, 0x1f, 0x17, 0xca, 0x2d, 0x64, 0x5d, 0x7b, 0xad, 0x88, 0x0d, 0xa6, 0xdc, 0x7c, 0xb3,
+    0xb8, 0xb3, 0x42, 0xcf, 0x9c, 0x1b, 0x6f, 0x14, 0x77, 0x3d, 0xc8, 0x0e, 0x5a, 0x19, 0xaf, 0x49,
+    0x91, 0xb4, 0x89, 0x10, 0xa4, 0xaf, 0xc8, 0xc2, 0xf0, 0xb7, 0xa1, 0x63, 0xf8, 0x00, 0x11, 0xad,
+    0xc1, 0x75, 0xa8, 0xfa, 0x08, 0x58, 0xe7, 0x9f, 0xb7, 0x43, 0xce, 0x44, 0xd4, 0x20, 0xa1, 0x63,
+    0xf0, 0x37, 0x58, 0x3d, 0x6f, 0x73, 0xd5, 0x4f, 0xed, 0x11, 0xa9, 0xcd, 0x85, 0x53, 0xe7, 0x05,
+    0xfd, 0x18, 0xd6, 0x07, 0x1e, 0xcf, 0x5d, 0x88, 0xa6, 0x8e, 0x50, 0xe3, 0x0b, 0x86, 0x6e, 0x24,
+    0x37, 0xee, 0xfb, 0x03, 0xe2, 0xfe, 0x46, 0x70, 0x77, 0x20, 0xac, 0xc8, 0x87, 0x84, 0x55, 0x27,
+    0x6a, 0xf2, 0xdc, 0xdf, 0xf0, 0xb9, 0x3f, 0x53, 0x1e, 0xf4, 0x5d, 0x8e, 0x28, 0xd6, 0x82, 0xdd,
+    0xb0, 0xd9, 0x95, 0xf7, 0x67, 0xfe, 0x6f, 0xff, 0xb7, 0x70, 0xda, 0x3f, 0xdf, 0x78, 0x54, 0x18,
+    0x2e, 0x3c, 0x00, 0x00,
+};
+
+// /index.html: 3167 bytes, 866 gzipped
+static const uint8_t ASSET_INDEX_HTML[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xc5, 0x57, 0xdf, 0x6f, 0xd3, 0x30,
+    0x10, 0x7e, 0xef, 0x5f, 0x61, 0xfc, 0x80, 0x98, 0x44, 0x96, 0xb1, 0x27, 0x04, 0x49, 0xa4, 0xd1,
+    0x6d, 0x42, 0x88, 0x1f, 0x13, 0x1d, 0x0f, 0x3c, 0xba, 0xc9, 0x6d, 0x31, 0x38, 0x76, 0xb0, 0x9d,
+    0x4e, 0xfd, 0xef, 0x39, 0xdb, 0x29, 0x75, 0xd3, 0xb4, 0xa9, 0x04, 0x12, 0x79, 0x49, 0xe3, 0xfb,
+    0x7c, 0xf7, 0xdd, 0xd9, 0xf7, 0xd9, 0xcd, 0x9e, 0x5d, 0x7f, 0x99, 0xdf, 0x7f, 0xbf, 0xbb, 0x21,
+    0xb5, 0x6d, 0x44, 0x31, 0xcb, 0xdc, 0x8b, 0x08, 0x26, 0x1f, 0x73, 0x0a, 0x92, 0x16, 0x33, 0x1c,
+    0x01, 0x56, 0x15, 0x33, 0x82, 0x4f, 0xd6, 0x80, 0x65, 0xa4, 0xac, 0x99, 0x36, 0x60, 0x73, 0xfa,
+    0xed, 0xfe, 0x36, 0x79, 0x4d, 0x63, 0x93, 0x64, 0x0d, 0xe4, 0x74, 0xc5, 0xe1, 0xa9, 0x55, 0xda,
+    0x52, 0x6f, 0x09, 0x4f, 0xa9, 0xa4, 0x05, 0x89, 0x93, 0x9e, 0x78, 0x65, 0xeb, 0xbc, 0x82, 0x15,
+    0x2f, 0x21, 0xf1, 0x1f, 0x2f, 0x09, 0x97, 0xdc, 0x72, 0x26, 0x12, 0x53, 0x32, 0x01, 0xf9, 0xab,
+    0xf3, 0x8b, 0x8d, 0x53, 0xcb, 0xad, 0x80, 0x62, 0xce, 0x74, 0xc5, 0xa4, 0x22, 0x77, 0x5f, 0x16,
+    0x59, 0x1a, 0x86, 0x82, 0x59, 0x70, 0xf9, 0x93, 0x68, 0x10, 0x39, 0x35, 0x76, 0x2d, 0xc0, 0xd4,
+    0x00, 0x3b, 0x41, 0x6b, 0x0d, 0x0f, 0x1b, 0xdb, 0x79, 0x69, 0x0c, 0xba, 0xcd, 0xd2, 0x90, 0xce,
+    0x2c, 0x5b, 0xaa, 0x6a, 0x8d, 0x6f, 0xef, 0xe8, 0x59, 0x92, 0x90, 0xcf, 0xf0, 0x44, 0xee, 0xd8,
+    0xba, 0x41, 0x96, 0xe4, 0x2b, 0xfc, 0xea, 0xc0, 0x58, 0xf2, 0xae, 0xb3, 0x56, 0x49, 0x92, 0x24,
+    0x7d, 0xc0, 0x65, 0xf8, 0xe6, 0x55, 0x4e, 0x55, 0x0b, 0xb2, 0x87, 0x7f, 0x52, 0x15, 0x13, 0x71,
+    0x5c, 0x4c, 0x57, 0x30, 0x63, 0x72, 0xba, 0xb4, 0x32, 0x69, 0x35, 0x6f, 0x98, 0x5e, 0xd3, 0x62,
+    0x24, 0x40, 0x96, 0x06, 0x8f, 0x31, 0x8f, 0x05, 0xd6, 0xc0, 0x90, 0x45, 0xd7, 0xb8, 0x59, 0xe4,
+    0xc5, 0x83, 0x56, 0x0d, 0x49, 0x59, 0xcb, 0x53, 0x63, 0x99, 0x35, 0x67, 0x5b, 0x32, 0x06, 0x4a,
+    0xcb, 0x7b, 0x36, 0xde, 0xb6, 0x08, 0x03, 0xbb, 0x4c, 0x36, 0x54, 0x3c, 0x22, 0xe9, 0xe7, 0xf4,
+    0xf5, 0xf5, 0x6e, 0x2a, 0xbe, 0x8a, 0x31, 0x91, 0x29, 0x44, 0x69, 0x99, 0x8c, 0xed, 0x89, 0x60,
+    0x4b, 0x10, 0xb4, 0xb8, 0xc7, 0xa4, 0xd7, 0x59, 0xea, 0xcc, 0x63, 0x33, 0x36, 0xa4, 0x3c, 0x6c,
+    0xc0, 0x68, 0x48, 0x2b, 0x59, 0x31, 0xd1, 0x01, 0x2d, 0x92, 0xa1, 0xbb, 0x2c, 0x45, 0x72, 0x7f,
+    0x4f, 0xf5, 0x8e, 0xf1, 0x6a, 0x9a, 0xa9, 0x43, 0xfd, 0x67, 0xa2, 0xdf, 0x64, 0x7b, 0x12, 0xd5,
+    0x80, 0xfb, 0xcf, 0x64, 0xbf, 0x42, 0x09, 0x7c, 0x05, 0x15, 0x79, 0x71, 0x75, 0x7d, 0x75, 0x36,
+    0x4d, 0x7a, 0x83, 0xff, 0x07, 0xb4, 0xd1, 0x14, 0xf6, 0x71, 0xdc, 0x37, 0xf7, 0x9a, 0x49, 0xc3,
+    0xfc, 0x30, 0xb6, 0x4f, 0xdf, 0x1b, 0xa3, 0xcd, 0x62, 0x23, 0xe4, 0xd1, 0x9e, 0x89, 0x81, 0x63,
+    0xad, 0x53, 0x5f, 0x16, 0x71, 0x54, 0xd4, 0x96, 0xcb, 0x41, 0x5d, 0x87, 0xe1, 0xe6, 0x28, 0x83,
+    0x8c, 0x4b, 0xd0, 0xb4, 0x98, 0xca, 0x67, 0x23, 0x15, 0x5e, 0x5d, 0xb6, 0x89, 0x54, 0x28, 0x94,
+    0xea, 0xd1, 0x3b, 0x6e, 0x63, 0xf9, 0x19, 0x5f, 0xd0, 0xc6, 0xd9, 0x92, 0x5e, 0x7c, 0x87, 0x2b,
+    0xbb, 0x87, 0x73, 0xd2, 0xe8, 0xa8, 0xed, 0xad, 0x90, 0xcb, 0x74, 0xae, 0x81, 0x59, 0xd8, 0x57,
+    0xb0, 0x38, 0xe7, 0x3f, 0xf8, 0x07, 0xa5, 0x1b, 0x82, 0x47, 0x42, 0xad, 0x90, 0x67, 0xa0, 0x3c,
+    0xe2, 0x36, 0xd6, 0xd4, 0x9e, 0x48, 0x29, 0x94, 0xc1, 0xd5, 0x7f, 0x6e, 0x79, 0x03, 0xe6, 0xed,
+    0x56, 0x1f, 0xf7, 0xa6, 0xa5, 0x2e, 0xc4, 0x20, 0xa1, 0xdd, 0x8d, 0xbd, 0x25, 0x12, 0x15, 0xeb,
+    0x16, 0xbf, 0x8f, 0xec, 0xc0, 0x50, 0x07, 0x77, 0x34, 0x8c, 0x55, 0x21, 0x2a, 0x98, 0xf3, 0x9b,
+    0x3c, 0x6a, 0xd5, 0xb5, 0x87, 0xf2, 0xf2, 0x6d, 0x42, 0x10, 0x97, 0x53, 0x56, 0xb1, 0xab, 0x46,
+    0x75, 0x6e, 0x05, 0xc2, 0xfb, 0x4d, 0x96, 0x7a, 0xf3, 0x81, 0xa9, 0x51, 0x1c, 0xe6, 0xf1, 0x09,
+    0x97, 0x6d, 0x67, 0x0f, 0x44, 0xf2, 0x53, 0x3c, 0x80, 0xd8, 0x75, 0x8b, 0xe7, 0xaf, 0xec, 0x9a,
+    0x25, 0x2e, 0xe3, 0x41, 0x70, 0xff, 0xb8, 0xaa, 0x6c, 0x99, 0x4d, 0xa1, 0xc3, 0xd1, 0x7e, 0x3a,
+    0xde, 0x58, 0x68, 0x73, 0x7a, 0x71, 0x7e, 0xf1, 0x6a, 0x12, 0xda, 0x70, 0x79, 0x22, 0xb2, 0x15,
+    0xac, 0x84, 0x5a, 0x09, 0xdc, 0xa5, 0x39, 0xbd, 0xc1, 0x4d, 0xad, 0x09, 0x3b, 0x8d, 0x8e, 0xc6,
+    0xed, 0xca, 0x35, 0x54, 0x47, 0x4a, 0x68, 0x40, 0x60, 0x17, 0x86, 0xb2, 0x78, 0xa7, 0xf3, 0x4e,
+    0x6b, 0x90, 0xe5, 0x7a, 0xd2, 0xf9, 0xa6, 0x38, 0xbb, 0xb3, 0x8a, 0xa3, 0xd3, 0x32, 0xd5, 0x7a,
+    0x41, 0xf2, 0x72, 0xe7, 0x0b, 0x8b, 0x9b, 0xe3, 0xfa, 0x2a, 0x4b, 0xc3, 0xf8, 0x11, 0x9e, 0x69,
+    0x20, 0x7a, 0x60, 0xef, 0xec, 0xf7, 0xc0, 0x36, 0xc1, 0x86, 0x09, 0x11, 0x9a, 0x41, 0xe3, 0xed,
+    0xeb, 0x3d, 0x9f, 0xa8, 0x5b, 0xbf, 0x05, 0x3d, 0x38, 0xa9, 0x1d, 0x1a, 0x45, 0xcb, 0x3b, 0x19,
+    0xeb, 0xc7, 0xd1, 0xb8, 0x7b, 0x2d, 0xd3, 0xeb, 0xe0, 0x84, 0x18, 0x84, 0x7d, 0x1c, 0x3e, 0x8e,
+    0x57, 0x3f, 0xba, 0x68, 0xa1, 0x86, 0x2a, 0x59, 0xb9, 0xab, 0xd6, 0x6c, 0x6a, 0xdb, 0x97, 0x4c,
+    0x96, 0x20, 0xde, 0x59, 0x54, 0xf3, 0xb9, 0xff, 0x79, 0x58, 0x68, 0xf6, 0x69, 0x99, 0x6e, 0xd9,
+    0x70, 0x7b, 0x32, 0xad, 0x3f, 0xf7, 0xbf, 0x43, 0x02, 0x7a, 0x58, 0xe2, 0xf6, 0xe5, 0x6c, 0xa0,
+    0x7a, 0x3b, 0x67, 0x48, 0x90, 0xd9, 0xf8, 0x08, 0xf9, 0xc0, 0x56, 0x6c, 0x51, 0x6a, 0xde, 0x5a,
+    0xf2, 0xc0, 0xdd, 0xad, 0x72, 0x7b, 0x1c, 0x86, 0x51, 0xa3, 0xcb, 0x9c, 0xea, 0x40, 0xa4, 0xe7,
+    0x75, 0xfe, 0xc3, 0xf8, 0x65, 0xf6, 0x80, 0x11, 0x74, 0x74, 0x9a, 0x7d, 0xe4, 0x66, 0x08, 0xc7,
+    0x6c, 0xc2, 0xb5, 0x1a, 0xcf, 0x05, 0xf7, 0x7f, 0xe2, 0x37, 0x34, 0x1a, 0x33, 0x91, 0x5f, 0x0c,
+    0x00, 0x00,
+};
+
+// /requestPayment.js: 5479 bytes, 1955 gzipped
+static const uint8_t ASSET_REQUESTPAYMENT_JS[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x58, 0x6d, 0x6f, 0xe3, 0x36,
+    0x12, 0xfe, 0xee, 0x5f, 0xc1, 0x0d, 0x0e, 0x90, 0xbc, 0xc8, 0x2a, 0xd9, 0x3b, 0xe0, 0x3e, 0x64,
+    0xeb, 0x02, 0x69, 0x5e, 0xae, 0x39, 0x74, 0xb3, 0xc6, 0x26, 0xed, 0x97, 0xa2, 0xb8, 0x30, 0xd2,
+    0xc8, 0xe2, 0xad, 0x4c, 0xba, 0x24, 0x65, 0xaf, 0xb1, 0xf5, 0x7f, 0xef, 0x0c, 0x49, 0x49, 0x94,
+    0x6c, 0x27, 0xad, 0xb1, 0xc1, 0xda, 0xe2, 0xcc, 0x70, 0xe6, 0x99, 0xe1, 0x33, 0x43, 0x9d, 0xbd,
+    0x7d, 0x3b, 0x61, 0x6f, 0xd9, 0x9c, 0x6f, 0x97, 0x20, 0x2d, 0xfb, 0x0c, 0xbf, 0x37, 0x60, 0x2c,
+    0xfb, 0x91, 0xcb, 0xa2, 0x06, 0x4d, 0x4b, 0xf4, 0xf7, 0x58, 0x09, 0xc3, 0x96, 0xaa, 0x68, 0x6a,
+    0x60, 0x95, 0x5b, 0x32, 0xcc, 0x56, 0xc0, 0x72, 0x0d, 0xdc, 0x0a, 0x25, 0x99, 0x2a, 0x99, 0x84,
+    0x0d, 0x5b, 0x05, 0x33, 0xda, 0x9b, 0x21, 0x21, 0xad, 0x9a, 0x45, 0xc5, 0x38, 0x69, 0xf3, 0x9a,
+    0x15, 0x82, 0xd7, 0x6a, 0x91, 0x91, 0xcd, 0xcb, 0xa5, 0x6a, 0x24, 0x8a, 0xe4, 0x5c, 0xb2, 0x67,
+    0x60, 0xa8, 0x06, 0x1a, 0x0a, 0x26, 0x24, 0xbb, 0xbc, 0xbe, 0x64, 0x69, 0xae, 0xe4, 0x1a, 0xb4,
+    0xc5, 0x27, 0x56, 0xb1, 0x5a, 0xad, 0xa1, 0xe6, 0x39, 0x6e, 0x8e, 0x32, 0x53, 0xa6, 0x34, 0x89,
+    0x91, 0x03, 0xa6, 0x52, 0xab, 0xc4, 0x90, 0xb9, 0xbc, 0xd1, 0x1a, 0x64, 0xbe, 0x8d, 0x35, 0x9f,
+    0xb7, 0x4e, 0xe8, 0xe6, 0x61, 0xfe, 0xaf, 0x7f, 0xb2, 0x8d, 0xb0, 0x15, 0x13, 0x6e, 0xc3, 0xbc,
+    0xc2, 0x45, 0xda, 0x65, 0xa5, 0x45, 0x0e, 0xd3, 0x8c, 0xdd, 0x59, 0x66, 0x40, 0x16, 0x86, 0xcd,
+    0x3f, 0x3d, 0x3c, 0x92, 0xb5, 0x3e, 0x00, 0xe5, 0x4c, 0x5c, 0xce, 0xef, 0x18, 0xc6, 0xcd, 0xac,
+    0x16, 0x8b, 0x05, 0x68, 0x1f, 0xbd, 0xd5, 0x5c, 0x1a, 0x9e, 0x3b, 0x00, 0x6a, 0x61, 0x28, 0xec,
+    0x52, 0x83, 0xa9, 0x28, 0xbc, 0xb3, 0xc9, 0xe4, 0xec, 0x8c, 0xfd, 0x07, 0xdc, 0x43, 0x20, 0xcf,
+    0xc0, 0x19, 0xbb, 0xfe, 0xf4, 0x91, 0x41, 0x0d, 0x84, 0x92, 0x99, 0xa0, 0xa7, 0xa8, 0xe5, 0x91,
+    0x99, 0xb1, 0x42, 0xe5, 0x0d, 0x3d, 0xcf, 0x16, 0x60, 0x6f, 0xbc, 0xc8, 0x0f, 0xdb, 0xbb, 0x22,
+    0x4d, 0x02, 0xaa, 0x1f, 0x49, 0x2e, 0x99, 0x7e, 0x08, 0x6a, 0x6a, 0x05, 0xf2, 0x07, 0x2b, 0x5f,
+    0x52, 0x24, 0x91, 0xf9, 0x41, 0x65, 0x04, 0x3d, 0x87, 0xfa, 0x15, 0xf5, 0x4e, 0xa8, 0xd7, 0x2b,
+    0x95, 0x5e, 0xfe, 0x05, 0x57, 0x6f, 0x51, 0xac, 0x57, 0xe2, 0x2e, 0xd3, 0x77, 0x72, 0xd5, 0xd8,
+    0x97, 0x74, 0x79, 0xc1, 0x7d, 0x4d, 0x44, 0x6e, 0x86, 0xa4, 0x3e, 0x20, 0x64, 0xf9, 0xcb, 0xca,
+    0x4e, 0xf3, 0x2a, 0xc8, 0xf7, 0x16, 0x5c, 0x86, 0x7f, 0x14, 0xf2, 0x45, 0xe5, 0x4e, 0xa8, 0xd7,
+    0x33, 0xcd, 0xf3, 0x52, 0x58, 0x0f, 0x10, 0x05, 0x9d, 0x61, 0x3d, 0xe8, 0xe0, 0x87, 0xd2, 0x69,
+    0xf2, 0xdc, 0x58, 0xab, 0xe4, 0xaf, 0x76, 0xbb, 0x82, 0xd9, 0x89, 0x17, 0x3e, 0xf9, 0x8d, 0xd4,
+    0x29, 0xed, 0x3f, 0x29, 0x5e, 0xf8, 0xf3, 0x31, 0x2a, 0x35, 0x56, 0x6a, 0xb5, 0x8c, 0x6a, 0x92,
+    0x4a, 0x4a, 0x95, 0x58, 0x1f, 0x51, 0x31, 0x77, 0x41, 0x93, 0xa5, 0xc7, 0x48, 0xd4, 0x6c, 0xa8,
+    0xf0, 0x9c, 0x85, 0x25, 0x2c, 0x95, 0xde, 0x9e, 0x32, 0x43, 0xd5, 0x89, 0x47, 0x13, 0xff, 0x95,
+    0x9c, 0x90, 0x46, 0x7b, 0x12, 0xb0, 0xfa, 0x71, 0xe7, 0xba, 0xf6, 0x55, 0xea, 0x37, 0xc6, 0x02,
+    0x9e, 0x70, 0xb3, 0x95, 0x39, 0x2b, 0x1b, 0x19, 0x4a, 0x16, 0xbd, 0x9c, 0xd3, 0x62, 0x3a, 0x65,
+    0xdf, 0x26, 0x0c, 0x3f, 0x56, 0x6f, 0xc3, 0x37, 0xfa, 0x78, 0x20, 0xb0, 0xa0, 0x57, 0xf8, 0x05,
+    0x10, 0x07, 0xbe, 0xe1, 0x02, 0x4b, 0x00, 0x6c, 0x5e, 0xa5, 0xc9, 0x19, 0x5f, 0x89, 0x33, 0x67,
+    0x9b, 0xa2, 0x1e, 0xea, 0xf8, 0x2d, 0x5b, 0x85, 0xd6, 0x42, 0xf6, 0x7f, 0xa3, 0x64, 0xba, 0x27,
+    0x9c, 0xab, 0x82, 0x64, 0x9d, 0x4e, 0xd6, 0xc6, 0x9e, 0x59, 0xf5, 0xf3, 0x6a, 0x05, 0xfa, 0x8a,
+    0x1b, 0x88, 0x55, 0x6a, 0xa0, 0xc2, 0x77, 0xee, 0xcf, 0x46, 0xd5, 0x31, 0xca, 0xd0, 0x93, 0x17,
+    0xfb, 0x75, 0xcd, 0xeb, 0x06, 0x53, 0xf4, 0x8f, 0x6f, 0xc3, 0x0d, 0x76, 0x27, 0xbf, 0x3d, 0x51,
+    0xb6, 0x5a, 0xc3, 0xa2, 0x64, 0xa9, 0x97, 0xe0, 0x6b, 0x2e, 0x6a, 0xfe, 0x5c, 0xc3, 0x34, 0xc2,
+    0xa2, 0x15, 0x79, 0xe3, 0xad, 0x8e, 0x97, 0xe8, 0xd3, 0xb9, 0xd5, 0x95, 0x99, 0x63, 0x47, 0x08,
+    0x95, 0x46, 0xa7, 0x91, 0x04, 0x62, 0xb4, 0x86, 0xaa, 0x99, 0x73, 0x75, 0x0f, 0x8a, 0xa3, 0xe2,
+    0x16, 0xbe, 0xda, 0x2b, 0x85, 0xb4, 0xe9, 0x8a, 0x9b, 0x60, 0xdc, 0x17, 0x1d, 0x41, 0xc4, 0x11,
+    0x53, 0x59, 0x5c, 0x55, 0xa2, 0x2e, 0xd2, 0x10, 0xc9, 0x50, 0x67, 0x37, 0xf8, 0xd5, 0x9d, 0x8b,
+    0xd1, 0x5e, 0x4f, 0xef, 0x5d, 0x49, 0xcf, 0x58, 0x8b, 0xaa, 0xc6, 0x38, 0x77, 0xf8, 0x8b, 0x9c,
+    0xd8, 0xb1, 0xb4, 0x7d, 0xcc, 0x17, 0xf0, 0x00, 0x98, 0xe5, 0xc2, 0xec, 0x0c, 0xe3, 0x0b, 0x35,
+    0x7d, 0xea, 0x77, 0xdb, 0x21, 0x0d, 0x62, 0x55, 0xed, 0x43, 0xfc, 0x1a, 0xc2, 0x99, 0xc6, 0xe2,
+    0x5f, 0x0f, 0xaa, 0xe2, 0x6f, 0x78, 0x7e, 0xaf, 0x02, 0x26, 0xb6, 0x3f, 0x95, 0xa7, 0x9d, 0xe7,
+    0x3c, 0xf4, 0x24, 0xae, 0x81, 0x35, 0xb2, 0xab, 0x84, 0xd8, 0xed, 0x89, 0x77, 0x3e, 0xe7, 0x78,
+    0x0a, 0x58, 0x0a, 0x5a, 0x2b, 0x1d, 0xfb, 0x7a, 0x6c, 0xe3, 0x24, 0x19, 0xd6, 0xbd, 0xaa, 0x21,
+    0x73, 0xca, 0x69, 0x72, 0x43, 0xff, 0xb9, 0xd3, 0x28, 0xe4, 0xa2, 0xf7, 0xea, 0x22, 0x39, 0x65,
+    0x4e, 0x22, 0x5b, 0x82, 0x31, 0x08, 0x65, 0x08, 0x78, 0x37, 0xd9, 0x39, 0x92, 0xf9, 0x84, 0xa9,
+    0x0c, 0xbd, 0x63, 0x53, 0xe1, 0xd7, 0x93, 0x7b, 0x6c, 0xc0, 0xa3, 0x3e, 0x7e, 0xc2, 0x3c, 0x4f,
+    0x11, 0x41, 0xe4, 0xb5, 0xc8, 0xbf, 0x40, 0x31, 0x09, 0x7d, 0x23, 0xe3, 0x45, 0x71, 0xb3, 0x46,
+    0xd9, 0x9f, 0xb0, 0x73, 0x81, 0x04, 0x74, 0xc4, 0x49, 0xe0, 0xae, 0xc8, 0x07, 0xb3, 0xef, 0x43,
+    0x4c, 0x6e, 0x83, 0x0c, 0x99, 0x69, 0xe3, 0x3a, 0x08, 0xa2, 0xce, 0x70, 0xef, 0x07, 0xfc, 0xed,
+    0xc8, 0x45, 0x62, 0xfb, 0x5f, 0x03, 0xfb, 0xce, 0xf7, 0xf5, 0xef, 0xdb, 0xd6, 0xe6, 0x54, 0x23,
+    0xda, 0xcf, 0x4a, 0x3c, 0x13, 0x26, 0x28, 0x5f, 0x36, 0x56, 0x2d, 0x51, 0x8f, 0x28, 0x6a, 0xcb,
+    0xdc, 0x8a, 0xb3, 0xe5, 0xe5, 0xb1, 0xb3, 0x53, 0x9f, 0x28, 0x05, 0xd4, 0x85, 0x33, 0x13, 0xd1,
+    0xd4, 0x87, 0xc9, 0x2e, 0x30, 0xec, 0x55, 0xad, 0xb0, 0x78, 0xa2, 0xe8, 0x7d, 0xaf, 0x3a, 0x10,
+    0x6e, 0xd7, 0xc4, 0x5e, 0x0d, 0xd8, 0x87, 0x9a, 0x93, 0xe5, 0x74, 0x1a, 0xf6, 0xf9, 0x0c, 0x06,
+    0x42, 0xd7, 0x73, 0xdb, 0xf8, 0x38, 0x99, 0x13, 0x32, 0x2c, 0x6d, 0x67, 0xa1, 0x67, 0x85, 0xb3,
+    0x45, 0x70, 0x81, 0x38, 0xd8, 0x34, 0x39, 0xf6, 0x7b, 0x53, 0x36, 0xb5, 0x6f, 0x24, 0xc6, 0x50,
+    0x49, 0xb7, 0x84, 0x9e, 0x57, 0xa8, 0x2d, 0xfb, 0x89, 0x05, 0xbd, 0xfd, 0x02, 0x2b, 0x7b, 0x8a,
+    0x16, 0x4c, 0x25, 0x88, 0xe4, 0x1b, 0xd3, 0x38, 0x70, 0x0c, 0xa2, 0xf4, 0x85, 0xc6, 0x06, 0x25,
+    0x61, 0xe2, 0xfd, 0x3b, 0x14, 0x05, 0x9a, 0x1b, 0xa5, 0x6d, 0xd8, 0x3e, 0xf7, 0xb9, 0xd2, 0x51,
+    0x8d, 0xaf, 0x27, 0xd7, 0xdd, 0x34, 0xc5, 0xd9, 0x1e, 0xa9, 0x43, 0xb2, 0x91, 0x89, 0x3e, 0x0b,
+    0x7e, 0x4a, 0xf4, 0xf0, 0xf4, 0x71, 0xb2, 0x77, 0x7e, 0x2e, 0x44, 0x5c, 0xf8, 0xa1, 0xa9, 0x70,
+    0xe2, 0x76, 0xdc, 0x8f, 0xc3, 0x77, 0x51, 0x0c, 0xc4, 0xf7, 0xa9, 0x14, 0xa2, 0x78, 0x20, 0x5b,
+    0x69, 0x20, 0xf1, 0x6b, 0x28, 0x79, 0x53, 0xdb, 0x50, 0x4a, 0x73, 0xff, 0x90, 0x15, 0xfe, 0xe9,
+    0x9e, 0x27, 0xcf, 0x50, 0xf1, 0xb5, 0x50, 0xda, 0xf3, 0x3c, 0x2a, 0xfc, 0xc2, 0x6b, 0x51, 0xa0,
+    0x6b, 0x2e, 0x4b, 0x2b, 0xae, 0xb1, 0x88, 0xc6, 0xa5, 0x17, 0xe1, 0x17, 0x66, 0x52, 0x3f, 0x95,
+    0x10, 0x31, 0x93, 0xc2, 0x2d, 0x16, 0xa4, 0x4d, 0xe3, 0xe2, 0x76, 0x00, 0x05, 0xec, 0x88, 0xc1,
+    0x84, 0xb9, 0xe7, 0xf7, 0xe9, 0x40, 0x79, 0xca, 0xfe, 0xf8, 0x63, 0x64, 0xee, 0xbb, 0x19, 0x3b,
+    0x9f, 0x8e, 0xda, 0x2d, 0xb1, 0x02, 0xd6, 0x57, 0x9a, 0xcc, 0x6b, 0xc0, 0xce, 0xe7, 0x35, 0x10,
+    0xc5, 0x35, 0xb9, 0xdd, 0x7a, 0xb9, 0x70, 0xe0, 0xd2, 0xc8, 0x80, 0x93, 0xf3, 0x79, 0xdc, 0x4f,
+    0x34, 0xd8, 0x46, 0x4b, 0x87, 0xcc, 0xcd, 0x57, 0xec, 0xbc, 0xc0, 0x35, 0x16, 0x11, 0xba, 0xb4,
+    0xf6, 0x61, 0x13, 0x24, 0x25, 0x72, 0x9a, 0x09, 0x44, 0xd2, 0xa2, 0x42, 0x63, 0x6a, 0xcb, 0x8a,
+    0x56, 0x20, 0xdd, 0x58, 0xbe, 0x5c, 0xd1, 0x88, 0xbd, 0x14, 0x35, 0x0e, 0xb6, 0x9e, 0xc2, 0x59,
+    0xfa, 0xb3, 0x14, 0x5f, 0xfb, 0xf5, 0x69, 0x04, 0x54, 0xaf, 0x34, 0x63, 0xd7, 0xe8, 0x5c, 0x26,
+    0xd5, 0x26, 0x6d, 0xdb, 0x6b, 0x0d, 0x5d, 0xea, 0x71, 0x8d, 0xf7, 0x38, 0x1d, 0xae, 0xb3, 0x19,
+    0x92, 0x25, 0x8e, 0x82, 0x49, 0x8c, 0x0d, 0x9d, 0x78, 0x3f, 0xd5, 0x3b, 0x7e, 0x8c, 0x6f, 0x04,
+    0x69, 0xdb, 0x8b, 0xde, 0x9f, 0x9e, 0x9f, 0x9f, 0xd3, 0x5f, 0xb7, 0x36, 0x8d, 0xf5, 0x3f, 0x72,
+    0x5b, 0x65, 0x78, 0x19, 0x91, 0x05, 0x9e, 0x13, 0x90, 0xa6, 0xc1, 0x92, 0x67, 0x1b, 0x60, 0x38,
+    0x0b, 0x62, 0x31, 0x60, 0xb0, 0x16, 0x70, 0xb0, 0x67, 0xce, 0x89, 0xd1, 0x84, 0xd2, 0xda, 0xeb,
+    0xea, 0x20, 0xb2, 0x35, 0xcc, 0xe9, 0x5b, 0xf6, 0xfe, 0xdc, 0x7d, 0x06, 0x49, 0xe9, 0x42, 0x47,
+    0xd5, 0x6f, 0x21, 0x8b, 0x17, 0x23, 0xab, 0xa7, 0x3d, 0x86, 0x17, 0x11, 0x9c, 0xbb, 0xc0, 0xf9,
+    0xe3, 0x66, 0x89, 0x01, 0xdd, 0x0a, 0x6e, 0x07, 0x0d, 0xeb, 0xf0, 0x8d, 0x29, 0xbe, 0x03, 0x1d,
+    0xf5, 0xa9, 0x44, 0x5b, 0xff, 0x6b, 0x1d, 0x1b, 0x84, 0xf4, 0x8a, 0x5f, 0x5d, 0x09, 0x5d, 0x0b,
+    0x43, 0x9d, 0x32, 0xcc, 0xcd, 0x2d, 0x0f, 0x3b, 0x2e, 0xa4, 0x5e, 0xb1, 0xd2, 0x8a, 0x08, 0x91,
+    0x1a, 0x1c, 0x1a, 0xb0, 0x1e, 0xe1, 0x6e, 0xc6, 0xce, 0x0a, 0xaf, 0x5d, 0xa0, 0x33, 0x56, 0xb7,
+    0xc4, 0xd4, 0x2f, 0x8f, 0x5a, 0xe9, 0xbc, 0x33, 0x96, 0x65, 0x59, 0x12, 0xaa, 0x6c, 0x7f, 0x76,
+    0xed, 0x0e, 0xd3, 0x03, 0xce, 0x3c, 0xb4, 0x73, 0x88, 0x9a, 0x1a, 0x6b, 0x04, 0x40, 0x3c, 0x05,
+    0x52, 0x6b, 0x43, 0x61, 0x77, 0x0d, 0x6c, 0x65, 0x08, 0x4d, 0xcf, 0x67, 0x8e, 0xcc, 0xa2, 0x4b,
+    0xdf, 0xdf, 0x99, 0x94, 0x23, 0x35, 0x83, 0xfb, 0x0f, 0x87, 0x9b, 0x25, 0xd8, 0x4a, 0x15, 0x17,
+    0x18, 0x19, 0xee, 0x9b, 0x9c, 0x0e, 0xd6, 0x2a, 0xe0, 0x05, 0xb6, 0x84, 0x0b, 0xcc, 0x52, 0x12,
+    0x30, 0x78, 0xf7, 0x88, 0xb7, 0x8e, 0x04, 0xc5, 0x71, 0x9c, 0xc3, 0x0e, 0xe6, 0xce, 0xf5, 0x19,
+    0x0d, 0xd7, 0x09, 0xdb, 0x0d, 0x95, 0x9f, 0x55, 0xb1, 0xbd, 0x60, 0xff, 0x7d, 0xf8, 0x74, 0x9f,
+    0x19, 0xbc, 0xba, 0xca, 0x85, 0x28, 0xb7, 0x69, 0x1c, 0x7b, 0x3f, 0xd7, 0x8c, 0x60, 0xb8, 0xaa,
+    0x00, 0x3b, 0x0f, 0x9e, 0xd2, 0x16, 0x85, 0x0d, 0x37, 0x51, 0x5b, 0x1b, 0xcc, 0xcd, 0x6f, 0xba,
+    0x09, 0x5f, 0x7d, 0x19, 0xcf, 0x6d, 0x44, 0xd2, 0x8e, 0x66, 0xdd, 0x28, 0xd3, 0x63, 0xe4, 0x2e,
+    0xd3, 0x95, 0xc6, 0xd2, 0x70, 0x0b, 0x03, 0x9d, 0x40, 0xbe, 0x4e, 0xe1, 0xd5, 0x4b, 0x84, 0xcb,
+    0xbd, 0x33, 0x44, 0xd9, 0x71, 0xb3, 0x94, 0x9f, 0xca, 0xfc, 0x78, 0x45, 0xbc, 0x9b, 0xdc, 0x22,
+    0xe7, 0xf9, 0x63, 0x11, 0x12, 0x39, 0xea, 0x48, 0x31, 0x87, 0xee, 0x06, 0x30, 0x78, 0xdf, 0xa3,
+    0x76, 0xde, 0xfa, 0x31, 0xca, 0x7d, 0xfc, 0x2a, 0xe0, 0xa8, 0xcb, 0x03, 0x7c, 0xa3, 0x01, 0x86,
+    0x97, 0x44, 0xe7, 0xd1, 0x26, 0xed, 0x6b, 0x95, 0x4e, 0x61, 0x30, 0x9a, 0x8c, 0x0c, 0x05, 0x5e,
+    0xec, 0x0f, 0x3c, 0xf7, 0x23, 0x03, 0xb1, 0x22, 0xf6, 0x43, 0x1c, 0x59, 0xcc, 0xaa, 0xe6, 0x5b,
+    0xa2, 0xf3, 0x70, 0x2a, 0x50, 0x76, 0x11, 0x9b, 0xb8, 0x57, 0x16, 0x2e, 0xe2, 0x10, 0xb2, 0xae,
+    0x1f, 0xe6, 0x75, 0x53, 0xc0, 0xfe, 0xdb, 0x8e, 0xbb, 0xeb, 0xe1, 0xdd, 0x33, 0xda, 0x46, 0xc9,
+    0x7a, 0x3b, 0x02, 0x07, 0xd9, 0xfc, 0x3a, 0xac, 0xce, 0x58, 0x7a, 0x60, 0x9f, 0xb3, 0x8e, 0x36,
+    0xf1, 0xde, 0x77, 0x2b, 0xbe, 0x42, 0x91, 0xfe, 0x7b, 0xfa, 0xe1, 0xe0, 0x61, 0x7e, 0x9a, 0x0f,
+    0x53, 0x17, 0x32, 0x5a, 0xbc, 0x41, 0x9f, 0x2e, 0x70, 0x8e, 0x8f, 0xad, 0x8b, 0x62, 0x77, 0x1a,
+    0x5e, 0x33, 0xd1, 0x52, 0xef, 0xc6, 0xce, 0xbf, 0x62, 0x1a, 0x4a, 0x7b, 0x5f, 0x76, 0x7d, 0xf7,
+    0x78, 0x1a, 0x21, 0xfd, 0xd9, 0xbf, 0xdd, 0xd9, 0x7f, 0xed, 0x83, 0x60, 0x9b, 0x6e, 0x20, 0x3e,
+    0x42, 0x11, 0xa8, 0xbf, 0x11, 0xb2, 0x50, 0x9b, 0x2c, 0xbc, 0x24, 0x7a, 0x8c, 0x08, 0x81, 0x30,
+    0xc4, 0x11, 0x46, 0x48, 0xff, 0xfe, 0x2b, 0xd2, 0xa7, 0xe9, 0x08, 0xeb, 0x67, 0x70, 0xdc, 0x8e,
+    0xdb, 0x19, 0x1f, 0xbe, 0xe3, 0x92, 0xe9, 0xf4, 0xaf, 0x5f, 0x69, 0xdc, 0x0b, 0x8d, 0x45, 0x38,
+    0x8f, 0x74, 0x86, 0x42, 0x15, 0xa5, 0x52, 0x31, 0x5e, 0x53, 0xed, 0x51, 0xf4, 0x92, 0x96, 0x1a,
+    0x03, 0x7a, 0xfa, 0xf2, 0x3d, 0xc7, 0xd7, 0x36, 0xb2, 0xf1, 0xe8, 0x0c, 0x1e, 0xbd, 0xee, 0x60,
+    0x73, 0x92, 0x6e, 0x18, 0x1e, 0x78, 0x74, 0x59, 0x6f, 0xf8, 0xd6, 0xa0, 0xf2, 0x3b, 0x90, 0x47,
+    0x1a, 0x8f, 0x9b, 0x69, 0x19, 0xf5, 0x0e, 0xb4, 0x8c, 0x63, 0x62, 0xcc, 0x66, 0xa5, 0x63, 0x84,
+    0xce, 0xe0, 0xc1, 0x4e, 0x54, 0x72, 0xec, 0xb9, 0x1f, 0x0e, 0xc8, 0x8c, 0xda, 0xd1, 0x95, 0xe7,
+    0x94, 0xd1, 0xd5, 0x2b, 0xe9, 0x6e, 0x6b, 0x54, 0x46, 0x7f, 0x02, 0x1a, 0x0a, 0x3d, 0x04, 0x67,
+    0x15, 0x00, 0x00,
+};
+
+// /styles.css: 3385 bytes, 983 gzipped
+static const uint8_t ASSET_STYLES_CSS[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xcd, 0x56, 0x4d, 0x8f, 0xdb, 0x38,
+    0x0c, 0x3d, 0x4f, 0x7e, 0x85, 0x80, 0x62, 0x81, 0xed, 0x60, 0x9c, 0x71, 0x9c, 0x89, 0x27, 0xf1,
+    0x9c, 0xb6, 0xf7, 0x3d, 0xb5, 0x7f, 0x40, 0xb6, 0xe8, 0x58, 0x5b, 0xd9, 0x32, 0x2c, 0xb9, 0x49,
+    0x5a, 0xf4, 0xbf, 0x97, 0x92, 0xbf, 0xe4, 0xaf, 0x74, 0x80, 0xdd, 0xc3, 0x22, 0x73, 0x98, 0x28,
+    0x14, 0xf5, 0xf8, 0x48, 0x3e, 0xf2, 0xf9, 0x91, 0x7c, 0xa2, 0x8a, 0x27, 0x44, 0xe9, 0x9b, 0xe0,
+    0xc5, 0x99, 0x3c, 0x3e, 0x6f, 0x62, 0xc9, 0x6e, 0xe4, 0xc7, 0xe6, 0x21, 0x95, 0x85, 0xf6, 0x52,
+    0x9a, 0x73, 0x71, 0x8b, 0xc8, 0x5f, 0x15, 0xa7, 0xe2, 0x89, 0x28, 0x5a, 0x28, 0x4f, 0x41, 0xc5,
+    0xd3, 0xb7, 0xcd, 0x43, 0x4e, 0xaf, 0xde, 0x85, 0x33, 0x9d, 0x45, 0x64, 0x17, 0xf8, 0x7e, 0x79,
+    0xb5, 0x67, 0xd5, 0x99, 0x17, 0x11, 0xf1, 0x09, 0xad, 0xb5, 0xc4, 0x83, 0x92, 0x32, 0x86, 0x8e,
+    0x23, 0x12, 0x34, 0x06, 0x31, 0x4d, 0xbe, 0x9e, 0x2b, 0x59, 0x17, 0xcc, 0x4b, 0xa4, 0x90, 0x55,
+    0x44, 0x3e, 0xa4, 0x07, 0xf3, 0x79, 0xdb, 0xfc, 0xdc, 0x6c, 0xb2, 0x9d, 0x79, 0xb9, 0xfb, 0x61,
+    0xbf, 0xdf, 0xe3, 0x0d, 0x0d, 0x57, 0xed, 0x51, 0xc1, 0xcf, 0xe8, 0x36, 0x81, 0x42, 0x43, 0x65,
+    0x4d, 0x9f, 0x11, 0x7a, 0xad, 0xb5, 0x2c, 0x2c, 0x76, 0x50, 0x06, 0xfa, 0x36, 0xd6, 0x85, 0x57,
+    0x56, 0x1c, 0x51, 0xd8, 0x10, 0x16, 0x1e, 0xf3, 0xfd, 0xd7, 0x38, 0x35, 0xe8, 0xdb, 0x83, 0x4b,
+    0xc6, 0x35, 0x18, 0x5c, 0xb2, 0x62, 0x80, 0xdf, 0x0b, 0x59, 0x80, 0x0b, 0x7b, 0x17, 0x94, 0x57,
+    0x12, 0xbc, 0x58, 0xec, 0x96, 0x11, 0xc5, 0xbf, 0x03, 0x1e, 0x87, 0x4d, 0x34, 0xf6, 0x96, 0x57,
+    0x51, 0xc6, 0x6b, 0x15, 0x91, 0xc6, 0x2c, 0xa9, 0x2b, 0x65, 0x5c, 0x97, 0x92, 0x37, 0x68, 0x1f,
+    0x74, 0x85, 0xbc, 0x71, 0xcd, 0x25, 0x86, 0x30, 0xc5, 0x44, 0xfc, 0xed, 0x5e, 0xd9, 0x88, 0x5c,
+    0xf4, 0x51, 0x26, 0xbf, 0x41, 0xb5, 0x1a, 0xc3, 0x21, 0x8c, 0xf7, 0xf3, 0x3b, 0x8c, 0x2b, 0x1a,
+    0x0b, 0x60, 0x2b, 0xd7, 0xc2, 0xe4, 0xf5, 0xf0, 0xca, 0x1c, 0x80, 0x85, 0x34, 0xc4, 0x0a, 0x79,
+    0x01, 0x36, 0x38, 0x53, 0x90, 0xc8, 0x82, 0xad, 0x13, 0x38, 0x78, 0xf9, 0x7f, 0x12, 0xd8, 0xe3,
+    0xbf, 0x4b, 0xe1, 0x81, 0x86, 0x41, 0x78, 0xec, 0x0a, 0xe9, 0x6f, 0xc9, 0xa8, 0xe8, 0xea, 0xa8,
+    0x56, 0xa6, 0x11, 0xa2, 0xdc, 0x9e, 0x95, 0x0a, 0x6a, 0x26, 0xbd, 0x44, 0x50, 0x65, 0x2b, 0xac,
+    0x3d, 0xfe, 0x31, 0xc4, 0xbb, 0xc3, 0xf0, 0x94, 0x14, 0x9c, 0x91, 0x0f, 0xc7, 0xe3, 0x71, 0x1e,
+    0xd2, 0xd1, 0x86, 0xd4, 0xf6, 0xc9, 0xc9, 0xff, 0x63, 0xdc, 0x38, 0x87, 0xb6, 0x6f, 0x62, 0x79,
+    0xf5, 0x54, 0x46, 0x99, 0xbc, 0x98, 0xde, 0x41, 0x1a, 0x08, 0xf2, 0x43, 0xaa, 0x73, 0x4c, 0xff,
+    0xf4, 0x9f, 0x48, 0xfb, 0xb7, 0xdd, 0x7d, 0x74, 0x99, 0xf5, 0xfb, 0x3e, 0xc0, 0xf8, 0x58, 0x25,
+    0x4b, 0xb7, 0x8b, 0xa3, 0x28, 0xee, 0x4e, 0x17, 0x19, 0x98, 0xba, 0x3e, 0x7c, 0x6c, 0x28, 0xb4,
+    0xf1, 0xa1, 0x11, 0x12, 0x5f, 0xe8, 0x15, 0xf2, 0x52, 0x30, 0x9f, 0x39, 0x94, 0xf6, 0x72, 0x06,
+    0x94, 0x35, 0xc4, 0x63, 0x41, 0x96, 0x82, 0xa2, 0x7c, 0xa4, 0x02, 0x4c, 0x94, 0xff, 0xd4, 0x4a,
+    0xf3, 0xf4, 0xd6, 0xb9, 0x8f, 0x88, 0x2a, 0x69, 0x02, 0x5e, 0x0c, 0xfa, 0x02, 0x50, 0xa0, 0x81,
+    0x6d, 0x73, 0x0f, 0x0b, 0x2a, 0x57, 0x43, 0xb3, 0xcf, 0x35, 0xa4, 0x61, 0x38, 0x96, 0xd8, 0xfe,
+    0xf9, 0x28, 0x03, 0x8c, 0xb1, 0x05, 0x24, 0x59, 0x60, 0xc0, 0xf4, 0xd2, 0xf4, 0x36, 0x51, 0x98,
+    0x99, 0x7d, 0x2a, 0xab, 0x7c, 0x72, 0xc3, 0xd8, 0x24, 0x42, 0x2a, 0x18, 0x53, 0xd2, 0x97, 0xfb,
+    0xa4, 0xfa, 0x3b, 0xff, 0x94, 0xd2, 0x71, 0xd9, 0x07, 0xc7, 0xa1, 0x11, 0x2e, 0xc0, 0xcf, 0x19,
+    0x92, 0x10, 0x4b, 0xc1, 0x16, 0xab, 0x1e, 0x73, 0x09, 0x88, 0xa9, 0xb1, 0x6a, 0x63, 0x77, 0x29,
+    0x5f, 0x04, 0xd8, 0x94, 0xfd, 0x53, 0xf7, 0x2d, 0x95, 0x49, 0xad, 0x5c, 0x51, 0xf5, 0xfd, 0x51,
+    0xb2, 0x3a, 0xb5, 0x9f, 0x70, 0x6c, 0x0c, 0x0c, 0x0d, 0x9e, 0x89, 0xb3, 0x1c, 0xc8, 0xe8, 0x49,
+    0x5f, 0x34, 0x13, 0x34, 0x06, 0x31, 0x4a, 0x7c, 0x2c, 0x64, 0xf2, 0xf5, 0x6d, 0x76, 0xbb, 0x61,
+    0x61, 0xac, 0xf3, 0x0b, 0x9c, 0x4c, 0xdc, 0xf3, 0xa2, 0xac, 0x6d, 0x4d, 0x76, 0x53, 0xc7, 0xb7,
+    0xed, 0x34, 0x48, 0x8d, 0x5b, 0x1e, 0xf3, 0xba, 0x58, 0x16, 0x9b, 0x25, 0x4d, 0xba, 0x9a, 0x03,
+    0xeb, 0xb2, 0x2f, 0xb5, 0xeb, 0x32, 0x9a, 0x81, 0x5f, 0x59, 0x6b, 0x93, 0xaf, 0x49, 0x45, 0xcc,
+    0xe6, 0x8e, 0x71, 0x42, 0x73, 0xac, 0x1d, 0xed, 0xf5, 0xe1, 0x4c, 0xdb, 0xe4, 0x4c, 0xcb, 0x96,
+    0xa2, 0x99, 0xb5, 0x02, 0x01, 0x89, 0x1e, 0x25, 0xec, 0xbf, 0x8a, 0xda, 0x29, 0xea, 0x56, 0xd3,
+    0xcd, 0xeb, 0x38, 0x5b, 0xb0, 0x43, 0x33, 0x5e, 0xe8, 0x7b, 0x79, 0xd5, 0x12, 0x11, 0x87, 0xa3,
+    0xa4, 0x86, 0x61, 0xe8, 0x50, 0x46, 0x13, 0x23, 0xde, 0xea, 0x5d, 0xa2, 0x60, 0xce, 0x3d, 0x28,
+    0x58, 0xc7, 0xc4, 0xce, 0x5d, 0x2d, 0x9a, 0xa7, 0xfa, 0xea, 0x43, 0xf5, 0xfb, 0x4c, 0x8d, 0x6a,
+    0xab, 0x3a, 0xb7, 0x53, 0xdf, 0x6c, 0x01, 0x4a, 0x53, 0x6d, 0xd6, 0x14, 0xfb, 0xe6, 0x2a, 0xc1,
+    0xf7, 0xdc, 0x5a, 0x17, 0x76, 0x09, 0xc2, 0x0b, 0x68, 0xba, 0xb8, 0xb8, 0x74, 0x93, 0x6f, 0x34,
+    0xea, 0xd6, 0x06, 0xc0, 0x58, 0xe0, 0xcd, 0x4c, 0x7c, 0x59, 0x11, 0xf8, 0xee, 0x79, 0x6f, 0xbd,
+    0x9b, 0x9c, 0xec, 0xf9, 0xdb, 0xe3, 0x01, 0xf2, 0x25, 0xde, 0xad, 0x8f, 0x6f, 0x54, 0xd4, 0xd0,
+    0x6f, 0x73, 0x6d, 0xc2, 0xb7, 0x2f, 0xf6, 0xc6, 0xa2, 0x08, 0x4d, 0x84, 0x11, 0xf9, 0xfd, 0x62,
+    0x66, 0x6f, 0x97, 0xbf, 0x8e, 0x54, 0x43, 0xb3, 0x76, 0x7e, 0x70, 0xd9, 0x9e, 0x33, 0xfa, 0x1e,
+    0xf2, 0xc6, 0xda, 0xfe, 0x6f, 0xc8, 0x5b, 0xc4, 0xe5, 0xce, 0x80, 0x06, 0xda, 0x6c, 0x0e, 0x4c,
+    0xe7, 0x4a, 0x30, 0x74, 0x52, 0xbf, 0x35, 0xb6, 0x70, 0x87, 0xd9, 0xd3, 0x57, 0xcc, 0xe8, 0x55,
+    0x6d, 0xf6, 0xb0, 0xb9, 0x52, 0x0d, 0x9a, 0x20, 0x28, 0x6e, 0x16, 0x38, 0xe2, 0xda, 0xff, 0x56,
+    0xeb, 0x70, 0xc1, 0xab, 0x36, 0x53, 0x6a, 0x6d, 0x32, 0x1f, 0xd3, 0x53, 0x4a, 0xef, 0x5c, 0x1d,
+    0x2b, 0x47, 0x53, 0xaf, 0xee, 0x82, 0x2d, 0x20, 0xd5, 0xef, 0x29, 0x8d, 0x3b, 0x5c, 0x31, 0x80,
+    0x00, 0xc2, 0x75, 0x0c, 0x6c, 0x09, 0xc3, 0x9d, 0x91, 0xfe, 0x1b, 0x77, 0x76, 0x80, 0xe9, 0xea,
+    0xee, 0xb6, 0xf7, 0x1b, 0x5a, 0xb6, 0x90, 0x97, 0xfa, 0xe6, 0x65, 0x54, 0x65, 0xee, 0xa4, 0x3c,
+    0x9d, 0x4e, 0x7d, 0xaf, 0x99, 0xd5, 0x30, 0x22, 0x5c, 0x23, 0x4d, 0x89, 0xf1, 0xf3, 0x0b, 0x1f,
+    0x88, 0x0b, 0x9e, 0x39, 0x0d, 0x00, 0x00,
+};
+
+// /transactionList.js: 10348 bytes, 3294 gzipped
+static const uint8_t ASSET_TRANSACTIONLIST_JS[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x5a, 0x5b, 0x73, 0xdb, 0x36,
+    0x16, 0x7e, 0xf7, 0xaf, 0x40, 0x3d, 0x3b, 0x43, 0x2a, 0x23, 0xd1, 0xb9, 0x6c, 0x5f, 0xec, 0xba,
+    0x5d, 0xd7, 0x76, 0x5b, 0xef, 0xa4, 0x89, 0xa7, 0x72, 0x66, 0x1f, 0x3a, 0x9d, 0x29, 0x4c, 0x42,
+    0x16, 0x1b, 0x8a, 0xe0, 0x12, 0xa4, 0x15, 0x6d, 0xa2, 0xff, 0xbe, 0xdf, 0x39, 0x00, 0x29, 0x80,
+    0xba, 0xc4, 0x9e, 0x5d, 0xcf, 0x38, 0xb1, 0x28, 0xe0, 0xe0, 0x5c, 0xbf, 0x73, 0x01, 0x4f, 0x5e,
+    0xbc, 0x38, 0x12, 0x2f, 0xc4, 0x5d, 0x2d, 0x4b, 0x23, 0xd3, 0x26, 0xd7, 0xa5, 0x78, 0x9b, 0x9b,
+    0x46, 0xfc, 0x22, 0xcb, 0xac, 0x50, 0x35, 0x7d, 0xc7, 0xdf, 0xcf, 0x73, 0x23, 0x16, 0x3a, 0x6b,
+    0x0b, 0x25, 0xe6, 0xfc, 0x95, 0x11, 0x33, 0xd5, 0xa4, 0xf3, 0xbc, 0x7c, 0x10, 0xf8, 0x2c, 0xb2,
+    0xdc, 0x54, 0x85, 0x5c, 0xd1, 0xc7, 0x66, 0x43, 0x0b, 0x8b, 0x6a, 0xbd, 0x10, 0xcd, 0x5c, 0x89,
+    0x8b, 0xdb, 0x9b, 0x84, 0x28, 0xdd, 0x34, 0x22, 0xad, 0x95, 0x6c, 0x40, 0x40, 0x8a, 0x46, 0xde,
+    0x83, 0xe0, 0x63, 0xae, 0x96, 0x42, 0xcf, 0x84, 0x2c, 0x8a, 0x60, 0xf3, 0x58, 0x7c, 0x54, 0xaa,
+    0x32, 0x22, 0x6f, 0x44, 0x5b, 0x89, 0x46, 0x8b, 0x0c, 0xdb, 0x40, 0xac, 0xd6, 0xed, 0xc3, 0x9c,
+    0x68, 0x11, 0xdd, 0x13, 0x59, 0xe5, 0x27, 0xea, 0x51, 0x95, 0x8d, 0x11, 0x53, 0x55, 0x3f, 0xaa,
+    0x7a, 0x32, 0xc5, 0x07, 0x71, 0x6d, 0x1f, 0x99, 0x06, 0x87, 0x2d, 0x44, 0x3c, 0x03, 0x71, 0x62,
+    0xee, 0x5e, 0xa6, 0x1f, 0x89, 0x54, 0xa5, 0xed, 0x67, 0xec, 0xac, 0x57, 0x44, 0xeb, 0xcd, 0x4b,
+    0x61, 0x54, 0xaa, 0xcb, 0xcc, 0x88, 0xe5, 0x3c, 0x2f, 0x14, 0x13, 0x77, 0xbb, 0x21, 0x7b, 0x5b,
+    0xca, 0x47, 0x99, 0x17, 0xc4, 0xef, 0x68, 0xcc, 0x12, 0x57, 0xb5, 0x7e, 0xcc, 0x33, 0x16, 0x63,
+    0x21, 0xcb, 0x56, 0x16, 0xa2, 0x56, 0xb3, 0x5a, 0x19, 0xe6, 0x6c, 0xd6, 0x96, 0x56, 0x99, 0x33,
+    0x5d, 0x0b, 0x0d, 0x52, 0xb5, 0xd3, 0x9e, 0x49, 0xa0, 0x4b, 0x10, 0x96, 0xa4, 0x41, 0xd3, 0x2e,
+    0x16, 0xb2, 0x5e, 0x09, 0x79, 0xaf, 0x1f, 0xed, 0x81, 0x56, 0x21, 0x38, 0xcf, 0xd1, 0x52, 0x19,
+    0xcb, 0xa9, 0x1f, 0x14, 0xd3, 0x58, 0xe6, 0xcd, 0x9c, 0xd7, 0x15, 0xb0, 0x11, 0xa9, 0xf3, 0xe4,
+    0xe8, 0xe8, 0xe4, 0x44, 0xfc, 0xac, 0x1a, 0xda, 0xa0, 0x6a, 0x55, 0xa6, 0x8a, 0xa4, 0xa3, 0x25,
+    0x90, 0xa5, 0x91, 0x79, 0x89, 0x5d, 0xaa, 0x50, 0x0b, 0x52, 0xc9, 0x12, 0x24, 0x54, 0x68, 0x9e,
+    0x65, 0x0e, 0x9d, 0xdf, 0xab, 0xce, 0x7c, 0x38, 0x0e, 0xdb, 0x60, 0x7e, 0x7f, 0xd1, 0x65, 0x4f,
+    0xe8, 0x5c, 0x64, 0x3a, 0x6d, 0x89, 0x56, 0x02, 0x86, 0xae, 0x2d, 0xd9, 0x1f, 0x57, 0x37, 0x59,
+    0x1c, 0xed, 0xdc, 0x10, 0x8d, 0xce, 0x98, 0x3f, 0x92, 0x38, 0x38, 0xd6, 0xcc, 0xf5, 0xb2, 0x84,
+    0x1a, 0x8d, 0x28, 0xb4, 0xcc, 0x54, 0x16, 0xb8, 0x09, 0x6b, 0xb7, 0xad, 0xc8, 0xd8, 0x99, 0xb8,
+    0x5f, 0x09, 0x6b, 0xdc, 0xa3, 0x42, 0x85, 0x6c, 0x81, 0x9b, 0xdf, 0xff, 0x20, 0xfa, 0xd6, 0x83,
+    0x7f, 0xd2, 0xf5, 0x42, 0x62, 0x45, 0xbe, 0x50, 0xa6, 0x91, 0x0b, 0xf6, 0x17, 0x18, 0x2f, 0x63,
+    0x85, 0xb2, 0xe3, 0xc0, 0x98, 0xb0, 0x38, 0xad, 0x05, 0x83, 0x30, 0x3b, 0xbc, 0xe3, 0x43, 0x99,
+    0x7f, 0xf2, 0xb6, 0xc4, 0x0b, 0xa8, 0x23, 0x77, 0x6e, 0x30, 0x22, 0x0a, 0x85, 0x4e, 0x65, 0x91,
+    0xff, 0x07, 0x8c, 0x10, 0x89, 0x13, 0x5a, 0xea, 0xd1, 0xa1, 0xdf, 0x7f, 0x54, 0xb2, 0x86, 0x8b,
+    0x7c, 0x2e, 0xdb, 0xc5, 0xbd, 0xaa, 0xd7, 0x1e, 0xb5, 0xc9, 0x90, 0x7c, 0x5e, 0x0a, 0xff, 0x00,
+    0xde, 0x5d, 0xab, 0xa6, 0xad, 0x21, 0xcc, 0x67, 0x4b, 0x75, 0xed, 0xe4, 0x68, 0x76, 0x9c, 0x28,
+    0x62, 0x95, 0x3c, 0x24, 0x63, 0x71, 0xfc, 0xea, 0xf5, 0xc9, 0xeb, 0x6f, 0x4f, 0x5e, 0xbf, 0x7c,
+    0xfd, 0x66, 0x2c, 0xde, 0x9c, 0xfe, 0xfd, 0xdb, 0x53, 0xf8, 0xee, 0xed, 0xaf, 0xc7, 0x23, 0xf6,
+    0x07, 0xdf, 0xf3, 0x40, 0xe8, 0xae, 0x3b, 0x3d, 0xee, 0xf9, 0x18, 0x89, 0xcf, 0x47, 0x02, 0x3f,
+    0xd6, 0xd2, 0xac, 0x9a, 0x73, 0x51, 0x22, 0x04, 0xaf, 0xf0, 0xa7, 0xb7, 0xec, 0x8c, 0x57, 0x59,
+    0x06, 0x79, 0x59, 0xd2, 0xe8, 0xb7, 0xa4, 0x0f, 0x35, 0x65, 0x7e, 0x62, 0xac, 0x58, 0xf7, 0xfa,
+    0x7f, 0x0b, 0x43, 0xee, 0x08, 0xfd, 0xce, 0x9e, 0xce, 0xc1, 0xc8, 0xc6, 0x0b, 0x36, 0x17, 0x81,
+    0x07, 0x05, 0xcf, 0x20, 0xe6, 0x37, 0x9e, 0xf0, 0xf3, 0xf5, 0x9d, 0x0d, 0xee, 0xe0, 0x6b, 0x55,
+    0x66, 0x95, 0xce, 0xcb, 0x86, 0x68, 0x10, 0x5d, 0xb0, 0x53, 0x98, 0x8e, 0xba, 0x87, 0x62, 0x26,
+    0x1e, 0x59, 0x0f, 0x28, 0x33, 0x38, 0xae, 0x3b, 0xf5, 0xe4, 0x48, 0x9a, 0x55, 0x99, 0x6e, 0xa2,
+    0x93, 0xbc, 0x6f, 0xb0, 0xc9, 0xea, 0xa6, 0x41, 0x54, 0xda, 0xbf, 0xe8, 0x07, 0x2e, 0xcc, 0xfc,
+    0xee, 0x96, 0xaf, 0x5f, 0x66, 0x15, 0x8a, 0xb0, 0xad, 0xf0, 0x07, 0x29, 0x55, 0x2e, 0x25, 0xb0,
+    0x8b, 0x71, 0x32, 0x8e, 0xb6, 0x64, 0xe1, 0xe8, 0xf0, 0x8e, 0xb8, 0x9c, 0x2b, 0x60, 0x53, 0x3e,
+    0x03, 0x85, 0x7f, 0xb7, 0xb0, 0x81, 0x58, 0x4a, 0x82, 0x88, 0x34, 0x55, 0xc6, 0xcc, 0xda, 0xa2,
+    0x5f, 0x8a, 0x15, 0xf1, 0x37, 0xdd, 0x29, 0x89, 0xfe, 0x38, 0xf2, 0x38, 0x65, 0xde, 0x01, 0x90,
+    0x4b, 0x36, 0xe8, 0x75, 0x5d, 0xeb, 0x3a, 0x8e, 0x7e, 0x02, 0x70, 0xc1, 0x9f, 0xa0, 0x8e, 0xd9,
+    0x96, 0x14, 0x91, 0x33, 0x33, 0xfd, 0xac, 0x03, 0x76, 0x6e, 0x65, 0x0d, 0x21, 0xfe, 0x39, 0x7d,
+    0xff, 0xae, 0x17, 0xa9, 0xff, 0x7a, 0x10, 0x87, 0x56, 0xce, 0x9e, 0xa5, 0xbf, 0x8c, 0x2e, 0xe3,
+    0x81, 0x70, 0x57, 0x9d, 0xfd, 0xfd, 0x9d, 0x08, 0x88, 0x1e, 0xf4, 0xfa, 0xc5, 0xbb, 0x6c, 0xe9,
+    0xef, 0xf2, 0x18, 0x26, 0xf3, 0x4d, 0x1b, 0xd9, 0x98, 0xd8, 0x3d, 0x5c, 0xc3, 0x1f, 0x48, 0xc2,
+    0x58, 0x91, 0xe4, 0xa3, 0xd0, 0x84, 0x6f, 0x35, 0xe0, 0x9e, 0x9e, 0xb3, 0xe3, 0x10, 0x04, 0xb9,
+    0x8f, 0x70, 0x78, 0x23, 0x1f, 0x14, 0xb1, 0xd3, 0x83, 0x66, 0x60, 0x54, 0x5d, 0xa8, 0x44, 0x59,
+    0x5d, 0xb2, 0x4a, 0xf9, 0xe0, 0x61, 0xaa, 0x3b, 0x8d, 0xc6, 0x96, 0x9e, 0xc7, 0xe0, 0x4e, 0x54,
+    0x4c, 0xf2, 0x12, 0xff, 0xfe, 0x72, 0xf7, 0xeb, 0x5b, 0xa8, 0x2e, 0xfa, 0xae, 0xfa, 0x7e, 0x3f,
+    0xcd, 0xef, 0x4e, 0xaa, 0xef, 0x23, 0x27, 0xda, 0x56, 0xac, 0x6d, 0xa5, 0x11, 0x76, 0xc8, 0x3e,
+    0x6c, 0x0c, 0x29, 0xc6, 0xe6, 0x6e, 0x25, 0xae, 0xa7, 0xb7, 0x6f, 0x5e, 0xbb, 0x74, 0x8a, 0x8d,
+    0x86, 0xb2, 0x44, 0x23, 0x11, 0x39, 0x5e, 0x62, 0x95, 0x64, 0x90, 0x47, 0x9d, 0xa7, 0x14, 0x96,
+    0x48, 0x14, 0x36, 0x4d, 0x67, 0x36, 0xd9, 0xc9, 0x3c, 0x1b, 0x13, 0x31, 0x43, 0xc9, 0x05, 0xf9,
+    0x29, 0xa7, 0xbc, 0x67, 0x16, 0x88, 0xbe, 0xb1, 0x98, 0xe5, 0x9f, 0x54, 0x36, 0x31, 0x80, 0xc9,
+    0x8d, 0xf3, 0x43, 0xbb, 0x94, 0x5a, 0x21, 0x15, 0x89, 0x04, 0x0e, 0xb0, 0xa9, 0xd1, 0x60, 0x12,
+    0x89, 0xc3, 0x24, 0xfb, 0x62, 0xd1, 0x19, 0x73, 0x67, 0x10, 0x3e, 0x21, 0xba, 0x58, 0x64, 0xdf,
+    0xa3, 0xff, 0xe7, 0x50, 0xd9, 0xa2, 0xb8, 0x1e, 0xf0, 0xc3, 0x0b, 0x9e, 0x18, 0x02, 0x72, 0x65,
+    0x15, 0x8b, 0xf3, 0x28, 0xbc, 0x67, 0x79, 0x8d, 0x7f, 0x39, 0xd9, 0x41, 0x9e, 0x0f, 0x77, 0x97,
+    0x6c, 0x06, 0x54, 0x3d, 0x45, 0xfe, 0xd1, 0x56, 0x03, 0x99, 0x7a, 0x84, 0x35, 0x06, 0x27, 0x36,
+    0x3a, 0x43, 0x1c, 0x79, 0x88, 0x3d, 0x02, 0x2e, 0xdf, 0x4c, 0xdf, 0x77, 0xa0, 0x9c, 0x98, 0x02,
+    0x9b, 0xe2, 0x97, 0x63, 0xf1, 0xea, 0xa5, 0xc7, 0xb8, 0xb7, 0x79, 0xea, 0x78, 0x66, 0xde, 0x13,
+    0x3c, 0x30, 0xc9, 0x2c, 0x2f, 0xb3, 0x98, 0xe9, 0x7e, 0x0f, 0x2e, 0x56, 0x89, 0xcd, 0x0a, 0xe7,
+    0xe7, 0x76, 0x83, 0x2f, 0xc8, 0xde, 0x0a, 0x80, 0xa8, 0xdd, 0xd1, 0xea, 0x08, 0x0c, 0xa9, 0x4f,
+    0x0d, 0xf9, 0x3b, 0x55, 0x1d, 0xe7, 0xfe, 0xa1, 0x3f, 0x78, 0x1f, 0x92, 0xde, 0xdb, 0x4e, 0xc5,
+    0xcb, 0xb3, 0xa7, 0x1d, 0x70, 0x0b, 0x3f, 0xdc, 0xa2, 0x6f, 0xe5, 0x20, 0x17, 0x7d, 0x22, 0x95,
+    0x0f, 0x65, 0xb5, 0x9f, 0x4e, 0x5b, 0x3e, 0x83, 0xd2, 0x6f, 0x2a, 0x55, 0xf9, 0xa3, 0xda, 0xa6,
+    0x15, 0x6f, 0x98, 0x7a, 0x8b, 0xe2, 0xae, 0x90, 0x28, 0xcc, 0x4e, 0x60, 0x11, 0xfe, 0x21, 0x8b,
+    0xfd, 0x44, 0x41, 0x13, 0xbf, 0xfe, 0x2a, 0x70, 0x1d, 0xc4, 0x1f, 0x3e, 0x64, 0x08, 0x3c, 0x3e,
+    0x52, 0xec, 0x83, 0xdd, 0xae, 0xf4, 0xb6, 0x45, 0x02, 0xd7, 0x44, 0x83, 0xa2, 0x9c, 0x4b, 0xcd,
+    0x54, 0x17, 0xed, 0x02, 0xd0, 0x26, 0x6e, 0xae, 0xc6, 0xe2, 0x62, 0xa1, 0x5b, 0xc8, 0x16, 0x5f,
+    0x5c, 0x5d, 0xa0, 0x04, 0xee, 0x0b, 0x8b, 0x71, 0xd0, 0x3c, 0xfc, 0x22, 0x6d, 0x01, 0xec, 0x97,
+    0x46, 0x17, 0x75, 0x2d, 0x57, 0xeb, 0x90, 0x87, 0x89, 0xe0, 0xa7, 0x54, 0xf6, 0x7b, 0xcf, 0x85,
+    0xbe, 0xff, 0x4b, 0xa5, 0x8d, 0x9f, 0x5b, 0xfd, 0x92, 0xe6, 0xab, 0xa9, 0xc1, 0xe9, 0x0d, 0xc1,
+    0x66, 0xfb, 0x17, 0xa1, 0x16, 0x55, 0x13, 0x48, 0xcf, 0x95, 0xf3, 0x51, 0x87, 0x0d, 0xfe, 0xe6,
+    0xa4, 0x50, 0xe5, 0x03, 0x64, 0x26, 0xaf, 0x7f, 0xe9, 0x5b, 0xe0, 0x69, 0x20, 0xfe, 0x4e, 0x87,
+    0x02, 0xae, 0x54, 0xe3, 0xa1, 0xf7, 0xa6, 0x92, 0xea, 0x6c, 0xd4, 0x31, 0x6a, 0xf5, 0xee, 0x94,
+    0xee, 0x2a, 0x75, 0xaf, 0x3c, 0xb3, 0xcf, 0xbd, 0xc2, 0xdb, 0xa2, 0xb2, 0x73, 0x44, 0xd4, 0xdd,
+    0xf4, 0x7d, 0x07, 0x50, 0xfc, 0x21, 0x49, 0x0b, 0x69, 0xcc, 0x3b, 0xb9, 0xa0, 0x6d, 0x41, 0x5d,
+    0x3e, 0xb1, 0x8b, 0xcf, 0x76, 0x9f, 0x3d, 0x47, 0xb1, 0xec, 0xf2, 0x9e, 0x3b, 0x9a, 0x9e, 0x1c,
+    0x3a, 0x9a, 0xbe, 0xef, 0x8e, 0xb6, 0x5b, 0x2c, 0x8d, 0xdf, 0x80, 0xa9, 0x07, 0xb6, 0xd5, 0x7d,
+    0xe1, 0xb3, 0x61, 0xc1, 0x6e, 0x14, 0xa9, 0xa2, 0x6a, 0x8e, 0x7a, 0x26, 0x25, 0xd3, 0xce, 0xfd,
+    0x78, 0xe9, 0xef, 0xd1, 0xcd, 0x15, 0xfc, 0x3c, 0xf2, 0x9d, 0x90, 0x3e, 0xf7, 0x6e, 0xc8, 0x1f,
+    0x06, 0x8e, 0x18, 0xfd, 0x91, 0x80, 0xd6, 0x35, 0x48, 0xc5, 0xee, 0x00, 0xc0, 0xdb, 0x30, 0xa3,
+    0x90, 0xc9, 0x0f, 0xc8, 0xe8, 0x83, 0x7f, 0x33, 0x1f, 0x44, 0xb9, 0xa5, 0xba, 0x59, 0xd0, 0xcb,
+    0x9f, 0xc8, 0xaa, 0x42, 0xe9, 0x79, 0x89, 0x4e, 0x32, 0x8b, 0x9b, 0x79, 0x17, 0x99, 0x9d, 0x9d,
+    0x68, 0x5d, 0xb0, 0xa4, 0xdf, 0x18, 0x58, 0x32, 0x24, 0x82, 0x25, 0xa3, 0x3d, 0xb6, 0xbb, 0xd7,
+    0xd9, 0xca, 0xb7, 0x1c, 0x7d, 0x3e, 0x24, 0x15, 0x7d, 0xbf, 0xc3, 0x0a, 0x52, 0x50, 0x3a, 0xec,
+    0xd5, 0xef, 0xf9, 0xce, 0xd1, 0x30, 0x10, 0x7a, 0xc5, 0xfa, 0xb1, 0xb5, 0x43, 0xbb, 0xf5, 0x53,
+    0x7d, 0xc1, 0x71, 0xe2, 0x9b, 0xf0, 0xe6, 0x8a, 0x1d, 0x62, 0x40, 0x31, 0xcf, 0x2e, 0xf1, 0xf0,
+    0x10, 0xd1, 0x2c, 0x28, 0x01, 0x78, 0xf9, 0x30, 0x23, 0x6d, 0x4e, 0x49, 0x7c, 0xac, 0xaf, 0x07,
+    0x96, 0xb3, 0x9b, 0x07, 0x2c, 0x3a, 0x17, 0x24, 0xd6, 0x00, 0x63, 0xa9, 0xed, 0x25, 0x01, 0xc9,
+    0x0e, 0xe5, 0x51, 0x3b, 0xc0, 0x39, 0x59, 0x8b, 0x0e, 0xaf, 0x06, 0x02, 0x48, 0xde, 0xff, 0x2c,
+    0x21, 0x70, 0xea, 0x3b, 0xdd, 0xa8, 0xd3, 0x80, 0x71, 0x4b, 0x07, 0x68, 0x9e, 0x16, 0x2d, 0xcd,
+    0x21, 0x9a, 0xb0, 0xcb, 0x66, 0xcc, 0xee, 0xca, 0x35, 0xc7, 0x89, 0xf1, 0x29, 0xd2, 0x7a, 0xf4,
+    0x15, 0x85, 0x08, 0x08, 0x51, 0x5a, 0xb9, 0xb9, 0x4a, 0xa8, 0x0f, 0xed, 0x9b, 0xb6, 0xaa, 0xad,
+    0x2b, 0x6d, 0xa8, 0x34, 0x59, 0x2a, 0x5b, 0x38, 0xa3, 0xd6, 0x41, 0xb9, 0x08, 0x39, 0x13, 0x9f,
+    0xe2, 0x2b, 0x96, 0xfc, 0x5c, 0xbc, 0x1a, 0x23, 0xc9, 0xd1, 0x6f, 0xaf, 0x95, 0xa1, 0x0a, 0x32,
+    0xe9, 0xb4, 0x78, 0x1e, 0x80, 0x70, 0x27, 0xd3, 0x81, 0x4c, 0x49, 0x3f, 0x1b, 0x0d, 0x0e, 0xec,
+    0xda, 0xd3, 0xdd, 0x6f, 0xd2, 0xcd, 0xde, 0xa1, 0xe7, 0xf5, 0x7d, 0xba, 0xb3, 0xec, 0xcc, 0x4d,
+    0x14, 0x06, 0x73, 0x84, 0x21, 0x7c, 0x74, 0xdb, 0x9e, 0x65, 0xd0, 0x60, 0xd7, 0x40, 0x88, 0xad,
+    0xc6, 0xdd, 0xd3, 0xcf, 0xb0, 0x3b, 0xdf, 0x25, 0x61, 0x40, 0xfb, 0x40, 0x78, 0xcd, 0x81, 0x90,
+    0xbb, 0x02, 0x8c, 0x9e, 0x3f, 0xd7, 0x3b, 0xa7, 0xe4, 0x14, 0xc7, 0x93, 0x63, 0xca, 0xaa, 0x4c,
+    0x17, 0x3e, 0x67, 0x73, 0x6f, 0x5c, 0xc9, 0x15, 0x4f, 0x9f, 0x4a, 0xdd, 0x50, 0x52, 0xa4, 0x43,
+    0x50, 0xf9, 0x2e, 0x54, 0x36, 0xda, 0xc0, 0xa6, 0x3b, 0xf1, 0x40, 0x94, 0x36, 0x9f, 0x08, 0xd0,
+    0xc5, 0x97, 0x2f, 0x22, 0x9a, 0x44, 0xc1, 0xd1, 0x17, 0x59, 0x26, 0x2e, 0xa7, 0x53, 0xc1, 0x69,
+    0x8f, 0xc3, 0xce, 0x34, 0x2b, 0x3b, 0xdb, 0x63, 0x06, 0x88, 0x38, 0xa2, 0x23, 0x7e, 0xa8, 0x69,
+    0xbe, 0x25, 0x74, 0xdb, 0xec, 0x38, 0xd8, 0xcf, 0x99, 0x3b, 0x8e, 0xfd, 0x41, 0x44, 0x11, 0xaa,
+    0xd4, 0x88, 0x29, 0x4e, 0x68, 0x57, 0xb4, 0x5f, 0xff, 0x1d, 0xd1, 0x21, 0x6c, 0x80, 0x4f, 0x42,
+    0x43, 0x1a, 0xcf, 0x85, 0xa0, 0xcd, 0x0e, 0x41, 0x9f, 0x02, 0x32, 0x75, 0x9f, 0x0c, 0xd6, 0xfb,
+    0x93, 0x02, 0xed, 0xf2, 0x71, 0xbc, 0x50, 0xb2, 0xf6, 0x26, 0x7f, 0xd4, 0x5c, 0xc8, 0xcc, 0xf6,
+    0x8a, 0xd4, 0x2f, 0x6c, 0x3a, 0xed, 0x27, 0x14, 0x35, 0x4e, 0xc4, 0xdd, 0x2b, 0x03, 0x2e, 0x78,
+    0x2a, 0x6a, 0x87, 0x41, 0x27, 0xe2, 0xd6, 0x4d, 0x56, 0x73, 0x98, 0xb1, 0x7e, 0x94, 0x05, 0xc1,
+    0x78, 0x4c, 0xbd, 0x1f, 0x94, 0x0f, 0x38, 0x02, 0x72, 0xa4, 0xb2, 0xa4, 0x99, 0x63, 0x4a, 0xcc,
+    0xe2, 0x21, 0x5c, 0xa6, 0x54, 0x2a, 0x23, 0x87, 0xa0, 0x19, 0x9f, 0x9b, 0xcc, 0xde, 0x74, 0xdb,
+    0xd1, 0xe9, 0x00, 0xa4, 0x36, 0x83, 0x3e, 0xf4, 0x0e, 0x80, 0x5b, 0xd9, 0x36, 0x1a, 0x51, 0x92,
+    0xa7, 0xfd, 0x24, 0x97, 0x2c, 0xef, 0xf3, 0xea, 0x4f, 0x99, 0x76, 0xcf, 0xa5, 0x78, 0xf6, 0xeb,
+    0x0f, 0x7e, 0x61, 0x1a, 0x6a, 0x91, 0xfb, 0x09, 0x2b, 0xba, 0xe3, 0x49, 0xa3, 0x27, 0x36, 0xea,
+    0xdd, 0x10, 0x5c, 0x95, 0xa6, 0x45, 0x9b, 0x67, 0xd5, 0xe9, 0x93, 0xf5, 0xa7, 0x96, 0xce, 0xe7,
+    0xa8, 0xd9, 0xeb, 0x27, 0xab, 0x1b, 0x96, 0xd1, 0x34, 0xaf, 0xc2, 0xc2, 0xd6, 0x90, 0x4c, 0x5e,
+    0x6c, 0x3a, 0x1d, 0xc6, 0x5e, 0x41, 0x6b, 0x4d, 0x2b, 0xcb, 0x95, 0x50, 0x9f, 0xc0, 0x5a, 0xa0,
+    0x61, 0x9a, 0x67, 0xd7, 0x3c, 0x26, 0x15, 0x8b, 0xb6, 0x68, 0xf2, 0x0a, 0xde, 0x55, 0xf5, 0x66,
+    0x00, 0xf1, 0x12, 0x5d, 0x56, 0x5f, 0xf4, 0x0e, 0x14, 0x1c, 0x34, 0x1b, 0x74, 0x48, 0xf7, 0xc5,
+    0xd6, 0xc2, 0x61, 0xe9, 0x3a, 0x55, 0x3c, 0x98, 0xf7, 0xd9, 0xd8, 0x1e, 0x30, 0x6d, 0x69, 0x99,
+    0x77, 0x6f, 0x1b, 0xd9, 0xa8, 0xa6, 0x3f, 0x18, 0x72, 0x6f, 0x95, 0x12, 0xd4, 0x03, 0x15, 0xfa,
+    0x21, 0x8e, 0x6e, 0xf7, 0xd8, 0x3b, 0x49, 0x92, 0x68, 0x30, 0x1b, 0x0a, 0x47, 0x7b, 0x8e, 0xfd,
+    0x31, 0x78, 0xa1, 0xcc, 0x72, 0x46, 0x22, 0x78, 0xc6, 0x3f, 0xb7, 0xcf, 0xc3, 0x11, 0xed, 0xda,
+    0x73, 0x3b, 0x5d, 0x6d, 0x7b, 0x1d, 0x7d, 0xf3, 0xc1, 0x28, 0xa4, 0x51, 0xe6, 0x87, 0xf4, 0x57,
+    0x42, 0x25, 0xf8, 0x13, 0x9a, 0xee, 0x4c, 0x40, 0xde, 0xcd, 0xce, 0x65, 0x07, 0xed, 0x14, 0x2d,
+    0xd9, 0xd0, 0xfe, 0xba, 0x3a, 0x60, 0xfe, 0xff, 0x83, 0xd5, 0x76, 0x2b, 0xdd, 0x46, 0xd6, 0xa6,
+    0x69, 0x3c, 0xb1, 0xd7, 0x26, 0xdd, 0xbd, 0x07, 0x74, 0x50, 0x2a, 0xcb, 0x61, 0x4c, 0x4b, 0xdd,
+    0xcd, 0x08, 0x21, 0xb9, 0xfb, 0xaa, 0x0b, 0x5a, 0x76, 0xbe, 0xa9, 0x6e, 0xeb, 0x54, 0x6d, 0x05,
+    0xec, 0x45, 0x55, 0x15, 0x2b, 0x78, 0xae, 0x5d, 0xb4, 0x19, 0xf0, 0xda, 0xe9, 0x46, 0x77, 0x5d,
+    0xc1, 0xf1, 0xc6, 0xf7, 0x02, 0xb4, 0xc7, 0xdd, 0xde, 0xa4, 0xb2, 0x86, 0xef, 0x2c, 0xe7, 0x48,
+    0xc3, 0xe9, 0x5c, 0x96, 0x0f, 0x2a, 0x73, 0x25, 0x8d, 0x5b, 0x4f, 0x17, 0x33, 0x2e, 0xe4, 0xd0,
+    0xd4, 0x56, 0x5c, 0x7f, 0x91, 0xc3, 0x53, 0xe3, 0xa2, 0x67, 0x44, 0x28, 0x03, 0xc1, 0xae, 0x5b,
+    0xde, 0x9a, 0x35, 0xcb, 0x07, 0x80, 0xd9, 0x29, 0x2d, 0x9b, 0x74, 0xa3, 0xaf, 0x89, 0x9b, 0x7a,
+    0x9d, 0x6e, 0x30, 0x73, 0xab, 0x3d, 0xb5, 0x1b, 0x5c, 0x5e, 0x9b, 0x64, 0xaa, 0x61, 0x45, 0x8c,
+    0x39, 0xea, 0x27, 0x35, 0x3c, 0xa7, 0xce, 0x88, 0xc0, 0xe7, 0xe3, 0x3c, 0x3b, 0x3e, 0x15, 0xf0,
+    0xcb, 0xb1, 0x38, 0xb6, 0x89, 0x04, 0x1f, 0x8f, 0xf1, 0xf9, 0x78, 0xdd, 0xcd, 0xe5, 0xc2, 0x01,
+    0x1e, 0xc4, 0x71, 0x23, 0x35, 0x0b, 0x94, 0x7c, 0x0f, 0xe4, 0x6e, 0x48, 0x96, 0x73, 0xe5, 0xa6,
+    0xa5, 0x76, 0x70, 0x67, 0xf5, 0x01, 0xbb, 0xa8, 0x25, 0x11, 0x73, 0xec, 0x5b, 0x26, 0x40, 0xf6,
+    0x11, 0x96, 0x49, 0xc4, 0x45, 0xc7, 0x25, 0x7b, 0xa7, 0x0c, 0x64, 0x41, 0x29, 0x97, 0xe9, 0x32,
+    0xa2, 0x7c, 0xff, 0xa8, 0xc4, 0x02, 0x8e, 0x6b, 0xf0, 0x8c, 0x68, 0x2d, 0x72, 0x63, 0x70, 0xa2,
+    0xbd, 0x77, 0xb1, 0x97, 0x5d, 0xba, 0x2c, 0x78, 0x76, 0x5f, 0x12, 0x4f, 0xc4, 0xc5, 0x72, 0x8e,
+    0x80, 0xb4, 0x46, 0x70, 0x0c, 0xb2, 0x32, 0x69, 0xb2, 0xe7, 0xb7, 0xfe, 0xdd, 0xad, 0x46, 0xb3,
+    0xaa, 0x14, 0x74, 0x66, 0xbd, 0xab, 0x44, 0x9e, 0xf5, 0x17, 0xbd, 0x67, 0xad, 0xae, 0xa9, 0xba,
+    0x92, 0xfd, 0x22, 0x30, 0x4e, 0x84, 0xc3, 0x38, 0x91, 0xe4, 0x4a, 0xfc, 0x7d, 0x4c, 0x14, 0xc7,
+    0xbc, 0xc5, 0x8f, 0x12, 0x3e, 0x87, 0x3a, 0xf8, 0x68, 0x60, 0xcf, 0xc8, 0x0f, 0x18, 0x1e, 0x0b,
+    0x06, 0xd8, 0x61, 0xf4, 0x42, 0x0d, 0x5b, 0x99, 0xb0, 0x49, 0x60, 0xaa, 0x74, 0x1c, 0xfe, 0x1e,
+    0x6d, 0xcd, 0x11, 0x7d, 0x5a, 0x55, 0x6b, 0xe6, 0x31, 0x33, 0x76, 0x16, 0x2c, 0x7a, 0xc6, 0x60,
+    0x7b, 0xbd, 0x7f, 0xc4, 0xbd, 0x67, 0x92, 0xb0, 0x75, 0x6d, 0x17, 0x16, 0x32, 0x6e, 0xc2, 0x97,
+    0x37, 0x6a, 0x41, 0xa2, 0xd1, 0xff, 0x43, 0x99, 0xce, 0x8e, 0x76, 0xa9, 0xc6, 0x97, 0x74, 0x1f,
+    0xa4, 0x6e, 0xb3, 0xb4, 0x63, 0xbe, 0xd2, 0x95, 0x52, 0xdf, 0x74, 0x47, 0xda, 0xcf, 0x7b, 0x06,
+    0x2d, 0xdd, 0xea, 0x60, 0xed, 0xd9, 0x73, 0xef, 0x08, 0xd6, 0x3b, 0xfc, 0x22, 0x08, 0xd2, 0x68,
+    0x28, 0x5e, 0x78, 0x9b, 0xe0, 0xc3, 0x7f, 0x7b, 0x6f, 0xd2, 0x3a, 0xbf, 0x67, 0xbc, 0x2a, 0x72,
+    0x44, 0x8c, 0x05, 0x1e, 0x33, 0xc4, 0xb3, 0x2e, 0xb2, 0x1d, 0xba, 0x91, 0x33, 0x50, 0x25, 0xd0,
+    0xa1, 0x1f, 0x85, 0x31, 0x0f, 0xc6, 0xf1, 0xc4, 0xb9, 0x28, 0x85, 0x94, 0xf3, 0x52, 0x04, 0x5b,
+    0x1f, 0xb1, 0x39, 0x57, 0x30, 0x1d, 0xba, 0x20, 0x02, 0x27, 0x08, 0xf9, 0xbc, 0x1c, 0x53, 0x72,
+    0x19, 0xb6, 0x7a, 0x5d, 0xc9, 0xcd, 0x71, 0x9f, 0x08, 0x6a, 0xcc, 0xdd, 0x79, 0x1d, 0x97, 0xd8,
+    0x41, 0xe4, 0x2c, 0x6a, 0x76, 0x50, 0x19, 0x7b, 0xf1, 0x34, 0x1a, 0x31, 0xea, 0x74, 0xeb, 0xb9,
+    0xcb, 0xa3, 0xe4, 0xbe, 0x40, 0xa5, 0x9e, 0xe3, 0x11, 0xe2, 0x7f, 0x83, 0xac, 0x42, 0x97, 0xdd,
+    0xfd, 0x7b, 0x89, 0x92, 0x9d, 0x33, 0x8b, 0xbd, 0xd8, 0xf6, 0x70, 0x01, 0xfc, 0x30, 0x6c, 0x0c,
+    0x01, 0xac, 0xbb, 0x92, 0xaf, 0xd5, 0x48, 0xa3, 0x88, 0x04, 0xc2, 0x34, 0x9a, 0xa8, 0xd9, 0x09,
+    0x28, 0x65, 0xcf, 0xd2, 0x42, 0xfe, 0x9c, 0x8b, 0x4c, 0xde, 0x4a, 0x69, 0x27, 0xb7, 0x37, 0x62,
+    0x84, 0xe8, 0xc9, 0xa6, 0xca, 0x74, 0x87, 0xb4, 0x84, 0x58, 0xf8, 0x56, 0xf2, 0xed, 0x3b, 0x30,
+    0x94, 0x2f, 0xfa, 0x77, 0xdd, 0xe4, 0xc3, 0x77, 0xfa, 0xe4, 0x95, 0xec, 0x28, 0xc3, 0x58, 0x1d,
+    0x53, 0x5e, 0xee, 0xd7, 0x5f, 0xef, 0x0b, 0x9a, 0x1f, 0xdd, 0xa3, 0x2a, 0x37, 0xaa, 0x36, 0x3c,
+    0x1e, 0x45, 0x2b, 0x61, 0xc1, 0xca, 0x25, 0x3e, 0xae, 0x1d, 0x5b, 0x43, 0x6c, 0xf5, 0xe5, 0x41,
+    0x17, 0x52, 0x4b, 0x84, 0x1f, 0xfa, 0x04, 0x6f, 0xf9, 0x53, 0x23, 0x6b, 0x6f, 0x6d, 0x78, 0x10,
+    0x0f, 0x06, 0x09, 0x99, 0x6e, 0x38, 0x36, 0x4f, 0xdc, 0x75, 0x89, 0x05, 0x78, 0x7f, 0x0e, 0x34,
+    0xdd, 0xbc, 0xef, 0x40, 0xf7, 0xd7, 0xa5, 0xe6, 0xda, 0xa5, 0x7b, 0x5f, 0x82, 0xaa, 0xcf, 0x05,
+    0xea, 0xf8, 0xe1, 0x01, 0x09, 0x5a, 0x0c, 0xa6, 0x4e, 0x6f, 0x8e, 0xc0, 0x60, 0x75, 0x1c, 0x91,
+    0x61, 0xa3, 0xb1, 0x38, 0x58, 0xc8, 0xed, 0x2a, 0x35, 0x54, 0xd0, 0x58, 0xee, 0x2b, 0x8b, 0x82,
+    0xfe, 0xef, 0xd2, 0x73, 0x1b, 0x30, 0xd8, 0xf0, 0x2b, 0x29, 0xcd, 0x0e, 0xff, 0xf1, 0x0d, 0xff,
+    0xf5, 0x32, 0x71, 0x5b, 0x2b, 0x85, 0x86, 0x53, 0xc7, 0x88, 0x3e, 0x1b, 0xc0, 0x9a, 0x69, 0x8f,
+    0xa8, 0x12, 0x20, 0xdd, 0xb4, 0x65, 0x93, 0x17, 0xec, 0x6a, 0xce, 0x47, 0x04, 0x81, 0x0c, 0x1f,
+    0x47, 0x6f, 0xb0, 0x3c, 0x41, 0x67, 0x3c, 0xc3, 0x7f, 0x96, 0xd2, 0x7c, 0x89, 0xc6, 0x7d, 0xb9,
+    0x69, 0x39, 0xa1, 0x3e, 0x0b, 0x49, 0xcd, 0xf0, 0x1b, 0x2f, 0x5b, 0x77, 0x62, 0x07, 0xaa, 0xc9,
+    0x27, 0xfa, 0xdc, 0xd7, 0xdc, 0x76, 0x1d, 0xaa, 0xf1, 0xf7, 0xad, 0x84, 0x3c, 0x16, 0xd1, 0xb0,
+    0x84, 0xa2, 0x67, 0x21, 0x3e, 0x6f, 0x06, 0xb8, 0x16, 0xc1, 0x7d, 0xbd, 0x1c, 0xd4, 0xa6, 0x2d,
+    0x0f, 0x2c, 0x06, 0x06, 0xbb, 0x86, 0x1a, 0xfd, 0xd3, 0x6a, 0xf4, 0x6f, 0x9f, 0x69, 0xc7, 0xfa,
+    0xf4, 0x4f, 0xb7, 0x29, 0xd9, 0x91, 0xc0, 0xc3, 0xfb, 0xc8, 0x7e, 0x18, 0x35, 0xac, 0x49, 0xe8,
+    0xca, 0x3c, 0xa9, 0xe8, 0xf6, 0x3c, 0xf6, 0x48, 0x0d, 0x68, 0xed, 0xbf, 0xf0, 0xd9, 0x73, 0xf1,
+    0xf3, 0xa3, 0x74, 0x15, 0x19, 0x67, 0xc4, 0x5d, 0x97, 0xcd, 0x4f, 0xb1, 0x4a, 0x58, 0x5c, 0xac,
+    0x3d, 0x67, 0xb7, 0xe5, 0x7f, 0x7f, 0xb3, 0x1c, 0xd6, 0xc9, 0xc8, 0x07, 0x9a, 0xc2, 0xcb, 0xd6,
+    0x7e, 0xca, 0xf7, 0x41, 0x86, 0x70, 0x0e, 0x8b, 0x99, 0xcc, 0x0b, 0x6a, 0x73, 0x46, 0x63, 0xa2,
+    0x44, 0x55, 0xe3, 0xb0, 0x99, 0xb6, 0x95, 0xba, 0x7b, 0x81, 0x8b, 0x82, 0x62, 0x1b, 0x70, 0x37,
+    0x6d, 0xc3, 0xf5, 0x27, 0x9a, 0x39, 0x76, 0x2f, 0x42, 0x6d, 0xee, 0x89, 0x1f, 0x0a, 0x7d, 0x4f,
+    0x1d, 0xf4, 0xf6, 0xab, 0x55, 0x7d, 0x8f, 0x8e, 0xaf, 0x11, 0x82, 0xdd, 0x7b, 0x14, 0xb7, 0xd6,
+    0xcb, 0x92, 0xbf, 0xb8, 0x07, 0xb3, 0xef, 0x6a, 0x61, 0x7b, 0x47, 0x78, 0x98, 0x4b, 0xed, 0x05,
+    0xd1, 0x0b, 0x21, 0x67, 0x0d, 0xdd, 0x48, 0x90, 0xb7, 0x72, 0xf3, 0xc0, 0x20, 0xda, 0x25, 0x67,
+    0x47, 0x7a, 0xec, 0xde, 0x02, 0xe3, 0x4c, 0xd4, 0x65, 0x4a, 0x34, 0xc1, 0x2a, 0xa3, 0xa8, 0xe3,
+    0xf7, 0xdd, 0xfe, 0xd5, 0xa7, 0xa0, 0x40, 0x6d, 0x94, 0xb7, 0xa0, 0xb9, 0x31, 0xb4, 0x60, 0x86,
+    0xbd, 0x87, 0x5b, 0x29, 0x0b, 0x9a, 0x3b, 0xae, 0x68, 0x80, 0xe3, 0x5e, 0x03, 0xdb, 0xee, 0x48,
+    0x38, 0x67, 0xa3, 0x1f, 0x9b, 0xbb, 0x5c, 0x68, 0x73, 0xad, 0x4d, 0x6b, 0x2e, 0xe5, 0x38, 0x39,
+    0xef, 0xc2, 0x57, 0x36, 0x7c, 0x90, 0x61, 0x44, 0xf0, 0x13, 0xc6, 0x97, 0x2f, 0x41, 0x70, 0x31,
+    0x1b, 0x54, 0x19, 0x29, 0xae, 0xde, 0xbc, 0x44, 0x92, 0xbc, 0xbf, 0xbd, 0x7e, 0xf7, 0x94, 0x44,
+    0x86, 0x52, 0xea, 0xec, 0xe8, 0xbf, 0x7a, 0xb7, 0xf4, 0x5a, 0x6c, 0x28, 0x00, 0x00,
+};
+
+static const StaticAsset STATIC_ASSETS[] = {
+    {"/favicon.ico", "image/x-icon", "\"c3e6e1830f3bba2c\"", "no-cache", ASSET_FAVICON_ICO, 2404, 15406},
+    {"/index.html", "text/html", "\"030d6bf08064c5dd\"", "no-cache", ASSET_INDEX_HTML, 866, 3167},
+    {"/requestPayment.js", "application/javascript", "\"634cc3450edad9ce\"", "no-cache", ASSET_REQUESTPAYMENT_JS, 1955, 5479},
+    {"/styles.css", "text/css", "\"f06c0e1b782bf8b2\"", "no-cache", ASSET_STYLES_CSS, 983, 3385},
+    {"/transactionList.js", "application/javascript", "\"f78e5c61faf891ae\"", "no-cache", ASSET_TRANSACTIONLIST_JS, 3294, 10348},
+};
+
+static const size_t STATIC_ASSET_COUNT =
+    sizeof(STATIC_ASSETS) / sizeof(STATIC_ASSETS[0]);
+
+#endif
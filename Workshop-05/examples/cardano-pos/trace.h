@@ -0,0 +1,150 @@
+/**
+ * trace.h - Header file for recording a timeline of what the firmware does
+ *
+ * The loop profiler (loop_profiler.h) tells how long each call takes on
+ * average and at worst. A trace shows when things happen, one after the
+ * other: a fetch, the JSON parsing in it, every ticker frame, a screen
+ * change. Modules mark the start and end of what they do:
+ *
+ *   TRACE_BEGIN("koios");
+ *   int code = http.POST(payload);
+ *   TRACE_END("koios");
+ *
+ * or for a whole function, ended automatically on every return:
+ *
+ *   void drawWalletScreen() {
+ *     TRACE_SCOPE("wallet screen");
+ *     ...
+ *   }
+ *
+ * Numbers that change over time (free heap, response size) are recorded
+ * with TRACE_COUNTER("free heap", ESP.getFreeHeap()), single moments with
+ * TRACE_INSTANT("screen change").
+ *
+ * Nothing is recorded until traceStart() is called. Until then a trace
+ * point only checks a flag. With TRACE_ENABLED set to 0 (before including
+ * this file, or as a compiler flag) the trace points are removed entirely.
+ *
+ * traceDump() writes the events as Chrome trace-event JSON. Save it to a
+ * .json file and open it at https://ui.perfetto.dev or chrome://tracing.
+ *
+ * Names must be string literals (only the pointer is stored) without
+ * quotes or backslashes. Trace points are for the Arduino loop task only;
+ * FreeRTOS tasks of their own (price service, payment watcher) must not
+ * record.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <Arduino.h>
+
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 1
+#endif
+
+// Events traceStart() makes room for when not told otherwise. An event
+// takes 16 bytes, so this is 32 KB, taken from the heap only while tracing.
+#define TRACE_DEFAULT_EVENTS 2000
+
+/**
+ * Start recording
+ *
+ * @param maxEvents Events to make room for
+ * @param stopWhenFull true: record the first maxEvents events and stop (to
+ *                     capture what follows, e.g. one refresh cycle). false:
+ *                     keep the last maxEvents events, dropping older ones.
+ * @return false if there is not enough memory
+ */
+bool traceStart(size_t maxEvents = TRACE_DEFAULT_EVENTS,
+                bool stopWhenFull = true);
+
+/**
+ * Stop recording (the events are kept for traceDump())
+ */
+void traceStop();
+
+/**
+ * Is an event recorded right now?
+ */
+bool traceIsRecording();
+
+/**
+ * Number of events recorded
+ */
+size_t traceEventCount();
+
+/**
+ * Write the events as Chrome trace-event JSON and stop recording
+ *
+ * Writes piece by piece, so no copy of the whole trace is made.
+ *
+ * @param out Where to write, e.g. Serial
+ * @return Number of events written
+ */
+size_t traceDump(Print &out);
+
+/**
+ * Free the event memory (after the trace was dumped)
+ */
+void traceFree();
+
+// Used by the macros below
+extern bool traceRecording;
+void traceRecord(char phase, const char *name, int32_t value);
+
+// Ends a span when it goes out of scope (TRACE_SCOPE)
+class TraceScope {
+public:
+  explicit TraceScope(const char *name) : name_(name) {
+    if (traceRecording) {
+      traceRecord('B', name_, 0);
+    }
+  }
+  ~TraceScope() {
+    if (traceRecording) {
+      traceRecord('E', name_, 0);
+    }
+  }
+
+private:
+  const char *name_;
+};
+
+#if TRACE_ENABLED
+#define TRACE_BEGIN(name)                                                      \
+  do {                                                                         \
+    if (traceRecording) {                                                      \
+      traceRecord('B', name, 0);                                               \
+    }                                                                          \
+  } while (0)
+#define TRACE_END(name)                                                        \
+  do {                                                                         \
+    if (traceRecording) {                                                      \
+      traceRecord('E', name, 0);                                               \
+    }                                                                          \
+  } while (0)
+#define TRACE_COUNTER(name, value)                                             \
+  do {                                                                         \
+    if (traceRecording) {                                                      \
+      traceRecord('C', name, (int32_t)(value));                                \
+    }                                                                          \
+  } while (0)
+#define TRACE_INSTANT(name)                                                    \
+  do {                                                                         \
+    if (traceRecording) {                                                      \
+      traceRecord('i', name, 0);                                               \
+    }                                                                          \
+  } while (0)
+#define TRACE_CONCAT2(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT2(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name)
+#else
+#define TRACE_BEGIN(name) ((void)0)
+#define TRACE_END(name) ((void)0)
+#define TRACE_COUNTER(name, value) ((void)0)
+#define TRACE_INSTANT(name) ((void)0)
+#define TRACE_SCOPE(name) ((void)0)
+#endif
+
+#endif
@@ -1,42 +1,49 @@
 #include "transaction_qr.h"
+#include "event_stream.h"
+#include "heap_profiler.h"
+#include "invoice_address.h"
+#include "logger.h"
+#include "payment_watcher.h"
+#include "qr_matrix.h"
+#include "sales_stats.h"
 #include "secrets.h"
+#include "trace.h"
 #include <ArduinoJson.h>
-#include <HTTPClient.h>
 #include <LittleFS.h>
 #include <TFT_eSPI.h>
-#include <WiFi.h>
-#include <qrcode_espi.h>
 
 namespace {
-TFT_eSprite *qrSprite = nullptr;
-QRcode_eSPI *qrcode = nullptr;
+const char *const LOG_MODULE = "qr"; // Module name in log messages
+QrMatrix qrMatrix; // Packed 1-bit QR modules (about 750 bytes)
+int qrBoxSize = 0; // Side length of the square area reserved for the QR code
 const char *TRANSACTIONS_FILE = "/transactions.json";
-unsigned long lastCheckTime = 0;
-const unsigned long CHECK_INTERVAL = 10000; // Check every 10 seconds
 unsigned long waitingStartTime = 0;
 bool isWaitingForPayment = false;
+bool watchRequested = false; // Handed to the payment watcher
 int waitingTransactionId = -1;
 uint64_t waitingLovelaceAmount = 0;
+// Address of the invoice being waited for, "" for the shared PAYMENT_ADDRESS
+char waitingAddress[INVOICE_ADDRESS_SIZE] = "";
 unsigned long successStartTime = 0;
 bool isShowingSuccess = false;
 const unsigned long SUCCESS_DISPLAY_TIME = 10000; // 10 seconds
 } // namespace
 
 void transactionQRInit(TFT_eSPI &display) {
-  int qrSize = min(display.width(), display.height()) - 20;
-  qrSprite = new TFT_eSprite(&display);
-  qrSprite->createSprite(qrSize, qrSize);
-  qrSprite->fillSprite(TFT_WHITE);
-  qrcode = new QRcode_eSPI(qrSprite);
-  qrcode->init();
-
-  lastCheckTime = 0;
+  // The QR code is drawn straight to the panel, so no sprite is allocated
+  qrBoxSize = min(display.width(), display.height()) - 20;
+
   waitingStartTime = 0;
   isWaitingForPayment = false;
+  watchRequested = false;
   waitingTransactionId = -1;
   waitingLovelaceAmount = 0;
+  waitingAddress[0] = '\0';
   successStartTime = 0;
   isShowingSuccess = false;
+
+  // Payments are checked by the watcher, loop() only picks up the results
+  paymentWatcherSetup();
 }
 
 // Helper: Update transaction hash in LittleFS
@@ -60,9 +67,16 @@ bool updateTransactionHash(int transactionId, const String &txHash) {
 
   JsonArray transactions = doc.as<JsonArray>();
   bool updated = false;
+  bool newlyPaid = false;
+  uint64_t timestamp = 0;
+  uint64_t amount = 0;
 
   for (JsonObject tx : transactions) {
     if (tx.containsKey("id") && tx["id"] == transactionId) {
+      const char *oldHash = tx["txHash"] | "";
+      newlyPaid = oldHash[0] == '\0';
+      timestamp = tx["timestamp"].as<uint64_t>();
+      amount = tx["amount"].as<uint64_t>();
       tx["txHash"] = txHash;
       updated = true;
       break;
@@ -74,6 +88,10 @@ bool updateTransactionHash(int transactionId, const String &txHash) {
     if (file) {
       serializeJson(doc, file);
       file.close();
+      // Count each invoice as paid only once
+      if (newlyPaid) {
+        salesStatsRecordPayment(timestamp, amount);
+      }
       return true;
     }
   }
@@ -110,93 +128,35 @@ String formatLovelaceToADA(uint64_t lovelaceAmount) {
   return result;
 }
 
-// Check for transaction using Koios API
-// transactionId: ID of the transaction
-// lovelaceAmount: Amount in lovelace (with ID already added)
-// Returns transaction hash if payment received, empty string otherwise
-String checkForTransaction(int transactionId, uint64_t lovelaceAmount) {
-  if (!WiFi.isConnected()) {
-    Serial.println("[Transaction Check] WiFi not connected, skipping check");
-    return "";
-  }
-
-  Serial.print("[Transaction Check] Checking for payment - TX ID: ");
-  Serial.print(transactionId);
-  Serial.print(lovelaceAmount);
-  Serial.println(" lovelace)");
-
-  // Build API URL with amount filter
-  String url = String(KOIOS_API_URL);
-  url += "?value=eq.";
-  url += String(lovelaceAmount);
-
-  // Make POST request
-  HTTPClient http;
-  http.begin(url);
-  http.addHeader("Content-Type", "application/json");
-
-  // Build JSON request body
-  DynamicJsonDocument requestDoc(512);
-  JsonArray addresses = requestDoc.createNestedArray("_addresses");
-  addresses.add(PAYMENT_ADDRESS);
-
-  String requestBody;
-  serializeJson(requestDoc, requestBody);
-
-  Serial.print("[Transaction Check] Sending request to: ");
-  Serial.println(url);
-  Serial.print("[Transaction Check] Request body: ");
-  Serial.println(requestBody);
-
-  int httpCode = http.POST(requestBody);
-  Serial.print("[Transaction Check] HTTP response code: ");
-  Serial.println(httpCode);
-
-  if (httpCode == 200) {
-    String payload = http.getString();
-    DynamicJsonDocument responseDoc(2048);
-    DeserializationError error = deserializeJson(responseDoc, payload);
-    http.end();
-
-    if (!error && responseDoc.is<JsonArray>()) {
-      JsonArray utxos = responseDoc.as<JsonArray>();
-      Serial.print("[Transaction Check] Found ");
-      Serial.print(utxos.size());
-      Serial.println(" UTXO(s)");
-
-      if (utxos.size() > 0 && utxos[0].containsKey("tx_hash")) {
-        String txHash = utxos[0]["tx_hash"].as<String>();
-        Serial.print("[Transaction Check] Payment found! Transaction hash: ");
-        Serial.println(txHash);
-        return txHash;
-      } else {
-        Serial.println(
-            "[Transaction Check] No transaction hash in UTXO response");
-      }
-    } else {
-      Serial.print("[Transaction Check] JSON parsing error: ");
-      Serial.println(error.c_str());
-    }
-  } else {
-    Serial.print("[Transaction Check] HTTP error, response: ");
-    if (httpCode > 0) {
-      String payload = http.getString();
-      Serial.println(payload);
-    } else {
-      Serial.println("Connection failed");
-    }
-  }
-
-  http.end();
-  Serial.println("[Transaction Check] No payment found yet");
-  return "";
+// Build the JSON payload for payment events: {"id":1,"txHash":"..."}
+String buildPaymentEventJson(int transactionId, const String &txHash) {
+  String json = "{\"id\":";
+  json += String(transactionId);
+  json += ",\"txHash\":\"";
+  json += txHash;
+  json += "\"}";
+  return json;
 }
 
 // Display success message and update transaction JSON with hash
 void displaySuccessAndUpdateHash(TFT_eSPI &display, int transactionId,
                                  const String &txHash) {
+  TRACE_SCOPE("payment received");
+  HEAP_SCOPE(HEAP_POS, "payment received");
+  String eventJson = buildPaymentEventJson(transactionId, txHash);
+
+  // Tell listening browsers right away, before touching the file system
+  eventStreamPublish(EVENT_PAYMENT_DETECTED, eventJson);
+
   // Update transaction with hash
-  updateTransactionHash(transactionId, txHash);
+  TRACE_BEGIN("record hash");
+  const bool recorded = updateTransactionHash(transactionId, txHash);
+  TRACE_END("record hash");
+  if (recorded) {
+    eventStreamPublish(EVENT_HASH_RECORDED, eventJson);
+  } else {
+    LOG_E(LOG_MODULE, "Failed to record transaction hash");
+  }
 
   // Display success message
   display.fillScreen(TFT_BLACK);
@@ -210,72 +170,114 @@ void displaySuccessAndUpdateHash(TFT_eSPI &display, int transactionId,
   isShowingSuccess = true;
   successStartTime = millis();
 
-  Serial.print("Payment received! Transaction hash: ");
-  Serial.println(txHash);
-  Serial.println("Success message will be shown for 10 seconds");
+  LOG_I(LOG_MODULE, "Payment received! Transaction hash: %s", txHash.c_str());
+}
+
+// Draw a QR module matrix scaled up to fit a boxSize x boxSize square
+// Each horizontal run of dark modules becomes a single fillRect(), so a QR
+// code takes a few hundred small SPI writes instead of a full-screen sprite.
+void drawQRMatrix(TFT_eSPI &display, const QrMatrix &matrix, int boxX,
+                  int boxY, int boxSize) {
+  TRACE_SCOPE("qr draw");
+  // Whole pixels per module, leaving room for a quiet zone of 2 modules
+  int scale = boxSize / (matrix.size + 4);
+  if (scale < 1) {
+    scale = 1;
+  }
+  int offset = (boxSize - matrix.size * scale) / 2;
+  int originX = boxX + offset;
+  int originY = boxY + offset;
+
+  for (int y = 0; y < matrix.size; y++) {
+    int runStart = 0;
+    int runLength = 0;
+    int x = 0;
+    while (qrNextDarkRun(matrix, y, x, runStart, runLength)) {
+      display.fillRect(originX + runStart * scale, originY + y * scale,
+                       runLength * scale, scale, TFT_BLACK);
+      x = runStart + runLength;
+    }
+  }
 }
 
 // Display QR code with call to action
 void displayWaitingMessage(TFT_eSPI &display, int transactionId,
-                           uint64_t lovelaceAmount, bool initialDraw) {
-  // Calculate original amount (subtract ID) for display
-  uint64_t originalAmount = lovelaceAmount - transactionId;
+                           uint64_t lovelaceAmount, const char *paymentAddress,
+                           bool initialDraw) {
+  // Calculate original amount (subtract ID on the shared address) for display
+  bool ownAddress = paymentAddress[0] != '\0';
+  uint64_t originalAmount =
+      ownAddress ? lovelaceAmount : lovelaceAmount - transactionId;
   float adaAmountForDisplay = (float)originalAmount / 1000000.0;
 
-  // For QR code, use full amount including ID (lovelaceAmount already has ID
-  // added)
+  // For QR code, use the full amount to pay (including the ID on the shared
+  // address)
   // Format using integer arithmetic to avoid floating point precision issues
   String adaAmountForQR = formatLovelaceToADA(lovelaceAmount);
 
   // Only draw static elements on initial draw
   if (initialDraw) {
+    TRACE_SCOPE("qr screen");
+    HEAP_SCOPE(HEAP_POS, "qr screen");
     // White background
     display.fillScreen(TFT_WHITE);
 
-    // Build QR code URL (use amount with ID included)
+    // Build QR code URL
     String qrContent = "web+cardano:";
-    qrContent += PAYMENT_ADDRESS;
+    qrContent += ownAddress ? paymentAddress : PAYMENT_ADDRESS;
     qrContent += "?amount=";
     qrContent += adaAmountForQR;
 
-    Serial.print("[Transaction Check] QR content: ");
-    Serial.println(qrContent);
+    LOG_D(LOG_MODULE, "QR content: %s", qrContent.c_str());
 
-    // Generate QR code on sprite (white background, black QR code)
-    qrSprite->fillSprite(TFT_WHITE);
-    qrcode->create(qrContent);
+    // Encode into a 1-bit module matrix and draw it centered in the QR box
+    // (screen is already white, so only dark modules need drawing)
+    unsigned long encodeStart = micros();
+    TRACE_BEGIN("qr encode");
+    bool encoded = qrEncode(qrContent.c_str(), qrContent.length(), qrMatrix);
+    TRACE_END("qr encode");
+    unsigned long drawStart = micros();
+    TRACE_COUNTER("qr version", qrMatrix.version);
 
-    // Center QR code horizontally and position vertically
-    int spriteX = (display.width() - qrSprite->width()) / 2;
+    int qrX = (display.width() - qrBoxSize) / 2;
     // Center QR code vertically, accounting for text above and info below
-    int spriteY = (display.height() - qrSprite->height()) / 2;
-    qrSprite->pushSprite(spriteX, spriteY);
+    int qrY = (display.height() - qrBoxSize) / 2;
+    if (encoded) {
+      drawQRMatrix(display, qrMatrix, qrX, qrY, qrBoxSize);
+    } else {
+      LOG_E(LOG_MODULE, "QR content too long to encode");
+    }
+
+    LOG_I(LOG_MODULE, "QR version %u, encode %lu us, draw %lu us",
+          (unsigned)qrMatrix.version, drawStart - encodeStart,
+          micros() - drawStart);
 
     // Display "PLEASE PAY NOW!" text 20px above QR code
     display.setTextColor(TFT_BLACK);
     display.setTextSize(2);
     display.setTextDatum(TC_DATUM);
-    display.drawString("PLEASE PAY NOW!", display.width() / 2, spriteY - 20);
+    display.drawString("PLEASE PAY NOW!", display.width() / 2, qrY - 20);
 
     // Display transaction ID and ADA amount 20px below QR code
-    int infoY = spriteY + qrSprite->height();
+    int infoY = qrY + qrBoxSize;
     display.setTextSize(1);
     display.setTextColor(TFT_BLACK);
 
     // TX ID left-aligned with 25px padding from left edge of QR code
     display.setTextDatum(TL_DATUM); // Top Left datum
     String txInfo = "TX ID: " + String(transactionId);
-    display.drawString(txInfo, spriteX + 25, infoY);
+    display.drawString(txInfo, qrX + 25, infoY);
 
     // ADA amount right-aligned with 25px padding from right edge of QR code
     display.setTextDatum(TR_DATUM); // Top Right datum
     String adaInfo = String(adaAmountForDisplay, 2) + " ADA";
-    display.drawString(adaInfo, spriteX + qrSprite->width() - 25, infoY);
+    display.drawString(adaInfo, qrX + qrBoxSize - 25, infoY);
   }
 }
 
 void displayNewTransactionQR(TFT_eSPI *display, int transactionId,
-                             uint64_t lovelaceAmount) {
+                             uint64_t lovelaceAmount,
+                             const char *paymentAddress) {
   if (display == nullptr) {
     return;
   }
@@ -283,29 +285,25 @@ void displayNewTransactionQR(TFT_eSPI *display, int transactionId,
   isWaitingForPayment = true;
   waitingTransactionId = transactionId;
   waitingLovelaceAmount = lovelaceAmount;
-  lastCheckTime = millis();
-
-  uint64_t originalAmount = lovelaceAmount - transactionId;
+  snprintf(waitingAddress, sizeof(waitingAddress), "%s", paymentAddress);
+  // Replaces the previous invoice, if it was still being watched
+  watchRequested =
+      paymentWatchStart(transactionId, lovelaceAmount, waitingAddress);
+
+  bool ownAddress = waitingAddress[0] != '\0';
+  uint64_t originalAmount =
+      ownAddress ? lovelaceAmount : lovelaceAmount - transactionId;
   float adaAmount = (float)originalAmount / 1000000.0;
 
-  Serial.println("========================================");
-  Serial.println("[Transaction Listener] Starting to listen for payment");
-  Serial.print("  Transaction ID: ");
-  Serial.println(transactionId);
-  Serial.print("  Amount: ");
-  Serial.print(adaAmount, 6);
-  Serial.print(" ADA (");
-  Serial.print(originalAmount);
-  Serial.println(" lovelace)");
-  Serial.print("  Payment Address: ");
-  Serial.println(PAYMENT_ADDRESS);
-  Serial.print("  Check interval: ");
-  Serial.print(CHECK_INTERVAL / 1000);
-  Serial.println(" seconds");
-  Serial.println("========================================");
+  LOG_I(LOG_MODULE, "Waiting for payment of transaction %d: %.6f ADA "
+        "(%llu lovelace)",
+        transactionId, adaAmount, (unsigned long long)originalAmount);
+  LOG_D(LOG_MODULE, "Pay to %s",
+        ownAddress ? waitingAddress : PAYMENT_ADDRESS);
 
   // Draw initial waiting screen
-  displayWaitingMessage(*display, transactionId, lovelaceAmount, true);
+  displayWaitingMessage(*display, transactionId, lovelaceAmount, waitingAddress,
+                        true);
 }
 
 void transactionQRUpdate(TFT_eSPI &display) {
@@ -313,38 +311,48 @@ void transactionQRUpdate(TFT_eSPI &display) {
 
   // Check if success message should be cleared (after 10 seconds)
   if (isShowingSuccess) {
-    if (currentTime - successStartTime >= SUCCESS_DISPLAY_TIME) {
+    // In 32 bits, like millis() on the ESP32: right when it wraps
+    if ((uint32_t)(currentTime - successStartTime) >= SUCCESS_DISPLAY_TIME) {
       // Clear screen to blank
+      TRACE_INSTANT("success cleared");
       display.fillScreen(TFT_BLACK);
       isShowingSuccess = false;
-      Serial.println("Success message cleared, returning to blank screen");
+      LOG_D(LOG_MODULE, "Success message cleared");
     }
     return; // Don't check for payments while showing success
   }
 
-  // If waiting for payment, check for payment
-  if (isWaitingForPayment && waitingTransactionId != -1) {
-    // Check for payment every CHECK_INTERVAL
-    if (currentTime - lastCheckTime >= CHECK_INTERVAL) {
-      lastCheckTime = currentTime;
-      unsigned long waitTimeSeconds = (currentTime - waitingStartTime) / 1000;
-      Serial.print("[Transaction Listener] Checking payment (waiting for ");
-      Serial.print(waitTimeSeconds);
-      Serial.println(" seconds)...");
-
-      String txHash =
-          checkForTransaction(waitingTransactionId, waitingLovelaceAmount);
-      if (txHash.length() > 0) {
-        Serial.println(
-            "[Transaction Listener] Payment confirmed! Stopping listener.");
-        displaySuccessAndUpdateHash(display, waitingTransactionId, txHash);
-        isWaitingForPayment = false;
-        waitingTransactionId = -1;
-        waitingLovelaceAmount = 0;
-      } else {
-        Serial.println("[Transaction Listener] Payment not found, will check "
-                       "again in 10 seconds");
-      }
+  if (!isWaitingForPayment || waitingTransactionId == -1) {
+    return;
+  }
+
+  // The watcher's queue was full when the invoice was created
+  if (!watchRequested) {
+    watchRequested = paymentWatchStart(
+        waitingTransactionId, waitingLovelaceAmount, waitingAddress);
+  }
+
+  // Results of the checks running in the background
+  PaymentWatchResult result;
+  while (paymentWatchPoll(result)) {
+    if (result.transactionId != waitingTransactionId) {
+      continue;
+    }
+    LOG_D(LOG_MODULE, "Check took %lu ms (waiting for %lu seconds)",
+          result.checkMs,
+          (unsigned long)((uint32_t)(currentTime - waitingStartTime) / 1000));
+
+    if (result.paid) {
+      LOG_I(LOG_MODULE, "Payment confirmed, stopped waiting");
+      displaySuccessAndUpdateHash(display, waitingTransactionId,
+                                  String(result.txHash));
+      isWaitingForPayment = false;
+      watchRequested = false;
+      waitingTransactionId = -1;
+      waitingLovelaceAmount = 0;
+      waitingAddress[0] = '\0';
+      return;
     }
+    LOG_D(LOG_MODULE, "Payment not found, checking again in 10 seconds");
   }
 }
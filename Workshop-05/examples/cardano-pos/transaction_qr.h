@@ -12,9 +12,12 @@ void transactionQRInit(TFT_eSPI &display);
 // Display QR code for newly created transaction (called immediately after
 // creation)
 // transactionId: ID of the transaction
-// lovelaceAmount: Amount in lovelace (with ID already added)
+// lovelaceAmount: Amount in lovelace to pay
+// paymentAddress: The invoice's own address, or "" to use PAYMENT_ADDRESS
+//                 (lovelaceAmount then has the ID added)
 void displayNewTransactionQR(TFT_eSPI *display, int transactionId,
-                             uint64_t lovelaceAmount);
+                             uint64_t lovelaceAmount,
+                             const char *paymentAddress);
 
 // Update function to be called in loop() - checks on-chain status and manages
 // display states
@@ -1,19 +1,36 @@
 #include "web_server.h"
+#include "event_stream.h"
+#include "heap_profiler.h"
+#include "invoice_address.h"
+#include "logger.h"
+#include "loop_profiler.h"
+#include "price_service.h"
+#include "sales_stats.h"
+#include "static_assets.h"
+#include "trace.h"
 #include <ArduinoJson.h>
 #include <LittleFS.h>
 #include <WebServer.h>
 #include <WiFi.h>
 
 namespace {
+const char *const LOG_MODULE = "web"; // Module name in log messages
 WebServer server(80);       // Web server on port 80
 bool serverStarted = false; // Flag to check if server is started
 const char *TRANSACTIONS_FILE = "/transactions.json";
 
+// Largest fiat_amount accepted, keeps the lovelace conversion in 64 bits
+const double MAX_FIAT_AMOUNT = 1000000.0;
+
+// Most events POST /api/trace makes room for (16 bytes each)
+const long MAX_TRACE_EVENTS = 4000;
+
 // Callback for new transaction notifications
 TransactionCallback transactionCallback = nullptr;
 TFT_eSPI* displayPtr = nullptr;
 
 // Get MIME type based on file extension
+// Only used for files that are not embedded in static_assets.h
 String getContentType(String filename) {
   if (filename.endsWith(".html") || filename.endsWith("/")) {
     return "text/html";
@@ -23,20 +40,51 @@ String getContentType(String filename) {
     return "application/javascript";
   } else if (filename.endsWith(".json")) {
     return "application/json";
+  } else if (filename.endsWith(".ico")) {
+    return "image/x-icon";
   } else {
     return "text/plain";
   }
 }
 
+// Find the embedded web interface file for a URL path
+// Returns nullptr if the path is not in static_assets.h
+const StaticAsset *findStaticAsset(const String &path) {
+  for (size_t i = 0; i < STATIC_ASSET_COUNT; i++) {
+    if (path == STATIC_ASSETS[i].path) {
+      return &STATIC_ASSETS[i];
+    }
+  }
+  return nullptr;
+}
+
+// Send an embedded file, already gzipped, straight from flash
+// If the browser sends the ETag of the copy it has cached, only a 304 Not
+// Modified goes back and the file is not sent again.
+void sendStaticAsset(const StaticAsset &asset) {
+  server.sendHeader("ETag", asset.etag);
+  server.sendHeader("Cache-Control", asset.cacheControl);
+
+  if (server.header("If-None-Match") == asset.etag) {
+    server.send(304);
+    return;
+  }
+
+  server.sendHeader("Content-Encoding", "gzip");
+  server.send_P(200, asset.contentType, (PGM_P)asset.data, asset.length);
+}
+
 // Handle GET /api/transactions - serve transactions JSON file
 void handleGetTransactions() {
-  Serial.println("GET /api/transactions");
+  TRACE_SCOPE("GET transactions");
+  HEAP_SCOPE(HEAP_WEB, "GET transactions");
+  LOG_D(LOG_MODULE, "GET /api/transactions");
 
   // Check if transactions file exists
   if (!LittleFS.exists(TRANSACTIONS_FILE)) {
     // Return empty array if file doesn't exist
     server.send(200, "application/json", "[]");
-    Serial.println("Transactions file not found, returning empty array");
+    LOG_D(LOG_MODULE, "Transactions file not found, returning empty array");
     return;
   }
 
@@ -45,29 +93,30 @@ void handleGetTransactions() {
   if (file) {
     server.streamFile(file, "application/json");
     file.close();
-    Serial.println("Served transactions.json");
+    LOG_D(LOG_MODULE, "Served transactions.json");
   } else {
     server.send(500, "application/json",
                 "{\"error\":\"Error opening transactions file\"}");
-    Serial.println("Error opening transactions file");
+    LOG_E(LOG_MODULE, "Error opening transactions file");
   }
 }
 
 // Handle POST /api/transactions - add a new transaction
 void handlePostTransactions() {
-  Serial.println("POST /api/transactions");
+  TRACE_SCOPE("POST transactions");
+  HEAP_SCOPE(HEAP_WEB, "POST transactions");
+  LOG_D(LOG_MODULE, "POST /api/transactions");
 
   // Check if request has body
   if (!server.hasArg("plain")) {
     server.send(400, "application/json",
                 "{\"error\":\"Missing request body\"}");
-    Serial.println("POST request missing body");
+    LOG_W(LOG_MODULE, "POST request missing body");
     return;
   }
 
   String body = server.arg("plain");
-  Serial.print("Request body: ");
-  Serial.println(body);
+  LOG_V(LOG_MODULE, "Request body: %s", body.c_str());
 
   // Parse the request body to get amount
   DynamicJsonDocument requestDoc(1024);
@@ -76,28 +125,51 @@ void handlePostTransactions() {
   if (error) {
     server.send(400, "application/json",
                 "{\"error\":\"Invalid JSON in request body\"}");
-    Serial.print("JSON parse error: ");
-    Serial.println(error.c_str());
+    LOG_W(LOG_MODULE, "JSON parse error: %s", error.c_str());
     return;
   }
 
-  if (!requestDoc.containsKey("amount")) {
+  // Amount is either in lovelace ("amount") or in the shop's currency
+  // ("fiat_amount", converted with the cached ADA price)
+  bool isFiat = requestDoc.containsKey("fiat_amount");
+  if (!requestDoc.containsKey("amount") && !isFiat) {
     server.send(400, "application/json",
-                "{\"error\":\"Missing 'amount' field\"}");
-    Serial.println("Missing 'amount' field");
+                "{\"error\":\"Missing 'amount' or 'fiat_amount' field\"}");
+    LOG_W(LOG_MODULE, "Missing 'amount' or 'fiat_amount' field");
     return;
   }
 
   if (!requestDoc.containsKey("timestamp")) {
     server.send(400, "application/json",
                 "{\"error\":\"Missing 'timestamp' field\"}");
-    Serial.println("Missing 'timestamp' field");
+    LOG_W(LOG_MODULE, "Missing 'timestamp' field");
     return;
   }
 
   // Use uint64_t to handle large lovelace amounts (e.g., 15000 ADA = 15 billion
   // lovelace)
-  uint64_t amount = requestDoc["amount"].as<uint64_t>();
+  uint64_t amount = 0;
+  double fiatAmount = 0;
+  if (isFiat) {
+    fiatAmount = requestDoc["fiat_amount"].as<double>();
+    if (!(fiatAmount > 0) || fiatAmount > MAX_FIAT_AMOUNT) {
+      server.send(400, "application/json",
+                  "{\"error\":\"Invalid 'fiat_amount'\"}");
+      LOG_W(LOG_MODULE, "Invalid 'fiat_amount'");
+      return;
+    }
+
+    // Converted locally from the cached price, no network access here
+    uint64_t fiatMicros = (uint64_t)(fiatAmount * 1000000.0 + 0.5);
+    if (!priceServiceFiatToLovelace(fiatMicros, amount)) {
+      server.send(503, "application/json",
+                  "{\"error\":\"No current ADA price available\"}");
+      LOG_W(LOG_MODULE, "Fiat invoice refused: no current ADA price");
+      return;
+    }
+  } else {
+    amount = requestDoc["amount"].as<uint64_t>();
+  }
   // Use uint64_t to handle large JavaScript timestamps (milliseconds since
   // epoch)
   uint64_t timestamp = requestDoc["timestamp"].as<uint64_t>();
@@ -109,12 +181,14 @@ void handlePostTransactions() {
   if (LittleFS.exists(TRANSACTIONS_FILE)) {
     File file = LittleFS.open(TRANSACTIONS_FILE, "r");
     if (file) {
+      TRACE_BEGIN("read transactions");
       DeserializationError error = deserializeJson(transactionsDoc, file);
       file.close();
+      TRACE_END("read transactions");
 
       if (error) {
-        Serial.print("Error parsing existing transactions: ");
-        Serial.println(error.c_str());
+        LOG_E(LOG_MODULE, "Error parsing existing transactions: %s",
+              error.c_str());
         // Continue with empty array if parse fails
         transactions = transactionsDoc.to<JsonArray>();
       } else {
@@ -137,42 +211,207 @@ void handlePostTransactions() {
   // Calculate new transaction ID
   int newId = maxId + 1;
 
+  // With per-invoice addresses the address tells invoices apart and the
+  // amount stays exact. Otherwise all invoices share PAYMENT_ADDRESS and the
+  // transaction ID is added to the amount (amount + id).
+  char address[INVOICE_ADDRESS_SIZE] = "";
+  uint32_t addressIndex = 0;
+  uint64_t invoiceAmount = amount + newId;
+  if (invoiceAddressEnabled()) {
+    if (!invoiceAddressNext(addressIndex, address, sizeof(address))) {
+      server.send(500, "application/json",
+                  "{\"error\":\"Error creating payment address\"}");
+      LOG_E(LOG_MODULE, "Error creating payment address");
+      return;
+    }
+    invoiceAmount = amount;
+  }
+
   // Create new transaction
   JsonObject newTransaction = transactions.createNestedObject();
   newTransaction["id"] = newId;
   newTransaction["timestamp"] = timestamp;
-  // Add the transaction ID to the amount (amount + id)
-  newTransaction["amount"] = amount + newId;
+  newTransaction["amount"] = invoiceAmount;
   newTransaction["txHash"] = ""; // Empty transaction hash field
+  if (address[0] != '\0') {
+    // Only the index is stored, the address is derived again when needed
+    newTransaction["addressIndex"] = addressIndex;
+  }
+  if (isFiat) {
+    // Keep what the customer was asked to pay in the shop's currency
+    newTransaction["fiatAmount"] = fiatAmount;
+    newTransaction["currency"] = priceServiceCurrency();
+  }
 
   // Write back to file
+  TRACE_BEGIN("write transactions");
   File file = LittleFS.open(TRANSACTIONS_FILE, "w");
   if (file) {
     serializeJson(transactionsDoc, file);
     file.close();
+    TRACE_END("write transactions");
+    salesStatsRecordInvoice(timestamp, invoiceAmount);
 
-    // Return the new transaction
+    // Return the new transaction, with the address for the browser
+    if (address[0] != '\0') {
+      newTransaction["address"] = address;
+    }
     String response;
     serializeJson(newTransaction, response);
     server.send(201, "application/json", response);
-    Serial.print("Added transaction with ID: ");
-    Serial.print(newId);
-    Serial.print(", Amount (with ID): ");
-    Serial.println(amount + newId);
-    
+    LOG_I(LOG_MODULE, "Added transaction with ID %d, amount %llu lovelace",
+          newId, (unsigned long long)invoiceAmount);
+
+    // Push the new invoice to browsers listening on /api/events
+    eventStreamPublish(EVENT_INVOICE_CREATED, response);
+
     // Notify callback about new transaction (if set)
     if (transactionCallback != nullptr && displayPtr != nullptr) {
-      transactionCallback(displayPtr, newId, amount + newId);
+      transactionCallback(displayPtr, newId, invoiceAmount, address);
     }
   } else {
+    TRACE_END("write transactions");
     server.send(500, "application/json",
                 "{\"error\":\"Error writing transactions file\"}");
-    Serial.println("Error writing transactions file");
+    LOG_E(LOG_MODULE, "Error writing transactions file");
   }
 }
 
+// Handle GET /api/price - cached ADA price for the payment form
+// Answers from memory, the price is fetched in the background
+void handleGetPrice() {
+  PriceQuote quote = priceServiceGetQuote();
+
+  // Format the price with integer math: 412300 -> "0.412300"
+  char rate[32];
+  snprintf(rate, sizeof(rate), "%llu.%06llu",
+           (unsigned long long)(quote.microFiatPerAda / 1000000),
+           (unsigned long long)(quote.microFiatPerAda % 1000000));
+
+  String json = "{\"currency\":\"";
+  json += priceServiceCurrency();
+  json += "\",\"available\":";
+  json += quote.available ? "true" : "false";
+  json += ",\"rate\":";
+  json += rate;
+  json += ",\"ageSeconds\":";
+  json += String(quote.ageMs / 1000);
+  json += "}";
+  server.send(200, "application/json", json);
+}
+
+// Handle GET /api/stats - sales totals kept up to date by sales_stats, so
+// this never reads transactions.json
+void handleGetStats() {
+  server.send(200, "application/json", salesStatsToJson());
+}
+
+// Handle GET /api/loop - how long loop() and each call in it took in the
+// last minute, and the last stall (see loop_profiler.h)
+void handleGetLoop() {
+  server.send(200, "application/json", loopProfilerToJson());
+}
+
+// Handle GET /api/heap - free heap and fragmentation over the last day, and
+// the allocation sites (see heap_profiler.h)
+void handleGetHeap() {
+  heapProfilerSample();
+  server.send(200, "application/json", heapProfilerToJson());
+}
+
+// Sends what is written to it as chunks of 1 KB of a response started with
+// CONTENT_LENGTH_UNKNOWN, so a trace (about 100 bytes of JSON per event) is
+// never held in RAM as a whole
+class ChunkedResponse : public Print {
+public:
+  size_t write(uint8_t c) override {
+    buffer_[length_++] = (char)c;
+    if (length_ == sizeof(buffer_)) {
+      sendPending();
+    }
+    return 1;
+  }
+  using Print::write;
+
+  // Send what is still in the buffer
+  void sendPending() {
+    if (length_ > 0) {
+      server.sendContent(buffer_, length_);
+      length_ = 0;
+    }
+  }
+
+private:
+  char buffer_[1024];
+  size_t length_ = 0;
+};
+
+// Handle POST /api/trace - start recording a trace (see trace.h)
+// ?events=N makes room for N events (default 2000), ?mode=ring keeps the
+// last N events instead of stopping when the buffer is full
+void handlePostTrace() {
+  long events = TRACE_DEFAULT_EVENTS;
+  if (server.hasArg("events")) {
+    events = server.arg("events").toInt();
+    if (events <= 0 || events > MAX_TRACE_EVENTS) {
+      server.send(400, "application/json",
+                  "{\"error\":\"'events' must be 1 to 4000\"}");
+      return;
+    }
+  }
+  bool ring = server.arg("mode") == "ring";
+
+  if (!traceStart((size_t)events, !ring)) {
+    server.send(503, "application/json",
+                "{\"error\":\"Not enough memory for the trace\"}");
+    return;
+  }
+  String json = "{\"recording\":true,\"events\":";
+  json += String(events);
+  json += ",\"mode\":\"";
+  json += ring ? "ring" : "once";
+  json += "\"}";
+  server.send(200, "application/json", json);
+  LOG_I(LOG_MODULE, "Trace: recording %ld events, GET /api/trace to download",
+        events);
+}
+
+// Handle GET /api/trace - stop recording and send the trace as Chrome
+// trace-event JSON, to open at https://ui.perfetto.dev
+void handleGetTrace() {
+  server.sendHeader("Content-Disposition",
+                    "attachment; filename=\"pos-trace.json\"");
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "application/json", "");
+
+  ChunkedResponse response;
+  size_t events = traceDump(response);
+  response.sendPending();
+  server.sendContent(""); // Ends the chunked response
+
+  LOG_I(LOG_MODULE, "Trace: sent %lu events", (unsigned long)events);
+}
+
+// Handle GET /api/events - keep the connection open as a Server-Sent Events
+// stream. The client is handed over to the event stream module, which pushes
+// invoice and payment updates as they happen.
+void handleGetEvents() {
+  LOG_D(LOG_MODULE, "GET /api/events");
+
+  if (!eventStreamHasCapacity()) {
+    server.send(503, "application/json",
+                "{\"error\":\"Too many event stream clients\"}");
+    LOG_W(LOG_MODULE, "No free event stream slot");
+    return;
+  }
+
+  eventStreamAccept(server.client());
+}
+
 // Handle file requests
 void handleFileRequest() {
+  TRACE_SCOPE("GET file");
+  HEAP_SCOPE(HEAP_WEB, "GET file");
   String path = server.uri();
 
   // Default to index.html for root path
@@ -185,38 +424,39 @@ void handleFileRequest() {
     path = "/" + path;
   }
 
-  // Check if file exists in LittleFS
+  // Web interface files compiled into the firmware (see static_assets.h)
+  const StaticAsset *asset = findStaticAsset(path);
+  if (asset != nullptr) {
+    sendStaticAsset(*asset);
+    LOG_D(LOG_MODULE, "Served asset: %s", path.c_str());
+    return;
+  }
+
+  // Any other file uploaded to LittleFS
   if (LittleFS.exists(path)) {
     String contentType = getContentType(path);
     File file = LittleFS.open(path, "r");
     if (file) {
       server.streamFile(file, contentType);
       file.close();
-      Serial.print("Served file: ");
-      Serial.println(path);
+      LOG_D(LOG_MODULE, "Served file: %s", path.c_str());
     } else {
       server.send(500, "text/plain", "Error opening file");
-      Serial.print("Error opening file: ");
-      Serial.println(path);
+      LOG_E(LOG_MODULE, "Error opening file: %s", path.c_str());
     }
+    return;
+  }
+
+  // File not found - serve index.html as fallback
+  const StaticAsset *index = findStaticAsset("/index.html");
+  if (index != nullptr) {
+    sendStaticAsset(*index);
+    LOG_D(LOG_MODULE, "File not found, serving index.html: %s",
+          path.c_str());
   } else {
-    // File not found - try index.html as fallback
-    if (path != "/index.html" && LittleFS.exists("/index.html")) {
-      File file = LittleFS.open("/index.html", "r");
-      if (file) {
-        server.streamFile(file, "text/html");
-        file.close();
-        Serial.print("File not found, serving index.html: ");
-        Serial.println(path);
-      } else {
-        server.send(404, "text/plain", "File not found");
-      }
-    } else {
-      // 404 Not Found
-      server.send(404, "text/plain", "File not found");
-      Serial.print("404 - File not found: ");
-      Serial.println(path);
-    }
+    // 404 Not Found
+    server.send(404, "text/plain", "File not found");
+    LOG_W(LOG_MODULE, "404 - File not found: %s", path.c_str());
   }
 }
 } // namespace
@@ -229,38 +469,51 @@ void setTransactionCreatedCallback(TransactionCallback callback, TFT_eSPI* displ
 void webServerSetup() {
   // Initialize LittleFS file system
   if (!LittleFS.begin(true)) {
-    Serial.println("ERROR: LittleFS Mount Failed");
+    LOG_E(LOG_MODULE, "LittleFS mount failed");
     return;
   }
-  Serial.println("LittleFS mounted successfully");
+  LOG_D(LOG_MODULE, "LittleFS mounted");
 
   // List all files in LittleFS (for debugging)
   File root = LittleFS.open("/");
   File file = root.openNextFile();
-  Serial.println("Files in LittleFS:");
   while (file) {
-    Serial.print("  ");
-    Serial.print(file.name());
-    Serial.print(" (");
-    Serial.print(file.size());
-    Serial.println(" bytes)");
+    LOG_D(LOG_MODULE, "LittleFS: %s (%u bytes)", file.name(),
+          (unsigned)file.size());
     file = root.openNextFile();
   }
 
+  // Load the sales totals (built from transactions.json on first start)
+  salesStatsInit();
+
+  // Per-invoice payment addresses, if ACCOUNT_XPUB is configured
+  invoiceAddressSetup();
+
   // Register API endpoints
   server.on("/api/transactions", HTTP_GET, handleGetTransactions);
   server.on("/api/transactions", HTTP_POST, handlePostTransactions);
+  server.on("/api/events", HTTP_GET, handleGetEvents);
+  server.on("/api/price", HTTP_GET, handleGetPrice);
+  server.on("/api/stats", HTTP_GET, handleGetStats);
+  server.on("/api/loop", HTTP_GET, handleGetLoop);
+  server.on("/api/heap", HTTP_GET, handleGetHeap);
+  server.on("/api/trace", HTTP_GET, handleGetTrace);
+  server.on("/api/trace", HTTP_POST, handlePostTrace);
 
   // Serve files from root and all subdirectories (must be last)
   server.onNotFound(handleFileRequest);
 
+  // Keep the header browsers use to ask if their cached copy is still current
+  const char *headerKeys[] = {"If-None-Match"};
+  server.collectHeaders(headerKeys, 1);
+
   // Start the server
   server.begin();
   serverStarted = true;
 
   // Print the server's IP address
-  Serial.print("Web server started on http://");
-  Serial.println(WiFi.localIP());
+  LOG_I(LOG_MODULE, "Web server started on http://%s",
+        WiFi.localIP().toString().c_str());
 }
 
 // Function to handle incoming client requests
@@ -268,6 +521,7 @@ void webServerLoop() {
   // If the server is started, handle incoming client requests
   if (serverStarted) {
     server.handleClient();
+    eventStreamLoop(); // Send queued events to connected browsers
   }
 }
 
@@ -8,8 +8,10 @@ class TFT_eSPI;
 
 // Callback function type for new transaction notifications
 // transactionId: ID of the transaction
-// lovelaceAmount: Amount in lovelace (with ID already added)
-typedef void (*TransactionCallback)(TFT_eSPI* display, int transactionId, uint64_t lovelaceAmount);
+// lovelaceAmount: Amount in lovelace to pay
+// paymentAddress: The invoice's own address, or "" if it is paid to
+//                 PAYMENT_ADDRESS (lovelaceAmount then has the ID added)
+typedef void (*TransactionCallback)(TFT_eSPI* display, int transactionId, uint64_t lovelaceAmount, const char* paymentAddress);
 
 // Set callback for when a new transaction is created
 void setTransactionCreatedCallback(TransactionCallback callback, TFT_eSPI* display);
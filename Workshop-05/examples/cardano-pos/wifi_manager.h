@@ -4,6 +4,22 @@
  * This file declares functions for managing WiFi connectivity on the ESP32.
  * It handles connection setup, connection monitoring, and provides status
  * information about the WiFi connection state.
+ *
+ * The manager listens to the ESP32's WiFi events instead of asking
+ * WiFi.status() over and over. Other modules can subscribe to be told the
+ * moment the connection comes back or goes away.
+ *
+ * After the first connection it remembers the router (BSSID), its channel
+ * and the IP settings in flash (NVS). Later connections - after a reboot
+ * or a dropout - go straight to that router with that IP address, which
+ * takes a fraction of a second instead of several seconds for a channel
+ * scan and DHCP.
+ *
+ * It can be given several networks (for example the shop floor and the back
+ * office). It connects to the best router it can see, judged by signal
+ * strength and by how fast and how reliably the APIs answered through it.
+ * When the link gets bad, it looks for a better router and switches while
+ * no request is running.
  */
 
 #ifndef WIFI_MANAGER_H
@@ -11,6 +27,67 @@
 
 #include <Arduino.h>
 
+// Most modules that can subscribe with wifiManagerSubscribe()
+#define WIFI_MAX_SUBSCRIBERS 4
+
+// Most networks wifiManagerSetup() takes, and most routers (access points)
+// it keeps link statistics for
+#define WIFI_MAX_NETWORKS 4
+#define WIFI_MAX_ROUTERS 8
+
+// A network the device may use. Several routers can have the same SSID.
+struct WifiNetwork {
+  const char *ssid;     // Empty or nullptr: skipped
+  const char *password;
+};
+
+// Where the connection stands
+enum WifiState {
+  WIFI_STATE_IDLE,       // No SSID set (wifiManagerSetup() not called yet)
+  WIFI_STATE_CONNECTING, // Waiting for the router to give us an IP address
+  WIFI_STATE_CONNECTED,  // Connected with an IP address
+  WIFI_STATE_WAITING     // Not connected, waiting before the next attempt
+};
+
+// Time-to-connect histogram buckets: up to 250 ms, 500 ms, 1 s, 2 s, 5 s,
+// 10 s, and longer
+#define WIFI_CONNECT_BUCKETS 7
+
+// Reconnect statistics, for the status screen and Serial output
+struct WifiStats {
+  uint32_t connects = 0;             // Times we got an IP address
+  uint32_t disconnects = 0;          // Times we lost it
+  unsigned long firstConnectMs = 0;  // From wifiManagerSetup() to the first IP
+  unsigned long lastOutageMs = 0;    // Length of the last outage
+  unsigned long longestOutageMs = 0; // Longest outage so far
+  unsigned long totalOutageMs = 0;   // All finished outages added up
+
+  // Connection attempts: fast ones use the remembered router (and IP, if
+  // DHCP had it recently), full ones scan all channels and ask DHCP
+  uint32_t fastConnects = 0;  // Fast attempts that worked
+  uint32_t fastFailures = 0;  // Fast attempts that timed out
+  uint32_t fullConnects = 0;  // Full attempts that worked
+  uint32_t dhcpRenewals = 0;  // Reconnects to renew a reused address
+  unsigned long lastConnectMs = 0; // Attempt start to IP, last connection
+  // Attempt start to IP for every connection, see WIFI_CONNECT_BUCKETS
+  uint32_t connectTimeHistogram[WIFI_CONNECT_BUCKETS] = {};
+
+  // Roaming (see wifiManagerSetRoaming())
+  uint32_t roamScans = 0; // Scans made because the link got bad
+  uint32_t roams = 0;     // Switches to a better router
+  // Requests reported with wifiManagerRequestFinished()
+  uint32_t requests = 0;
+  uint32_t requestFailures = 0; // No answer at all
+};
+
+/**
+ * Called when the connection comes back (connected = true) or goes away
+ *
+ * Subscribers are called from wifiManagerLoop(), so they run in loop() like
+ * any other code and may make HTTP requests.
+ */
+typedef void (*WifiLinkCallback)(bool connected);
+
 /**
  * Initialize WiFi connection
  *
@@ -22,10 +99,55 @@
  */
 void wifiManagerSetup(const char *ssid, const char *password);
 
+/**
+ * Initialize WiFi with several networks
+ *
+ * Like wifiManagerSetup(ssid, password), but the device uses whichever of
+ * the networks has the best router in range. The array is copied, but the
+ * SSID and password strings must stay valid (string literals or #defines
+ * from secrets.h are fine).
+ *
+ * @param networks The networks, at most WIFI_MAX_NETWORKS
+ * @param count Number of entries in networks
+ */
+void wifiManagerSetup(const WifiNetwork *networks, int count);
+
+/**
+ * Switch routers when the link gets bad (on by default)
+ *
+ * The link is bad when the signal is weak or the requests reported below
+ * are slow or get no answer. The manager then scans, and switches if
+ * another router of the configured networks is clearly better - but only
+ * when no request has been running for a few seconds.
+ *
+ * @param enabled false to stay on a router for as long as it is in range
+ */
+void wifiManagerSetRoaming(bool enabled);
+
+/**
+ * Report an HTTP request, so the manager can judge the link
+ *
+ * Call wifiManagerRequestStarted() right before http.GET() or http.POST()
+ * and wifiManagerRequestFinished() with what it returned right after.
+ * While a request is running the manager does not switch routers. Both may
+ * be called from any task.
+ *
+ * @return The start time, to pass to wifiManagerRequestFinished()
+ */
+unsigned long wifiManagerRequestStarted();
+
+/**
+ * @param startedMs What wifiManagerRequestStarted() returned
+ * @param answered true if the server answered (any HTTP status code),
+ *                 false on a connection error or timeout
+ */
+void wifiManagerRequestFinished(unsigned long startedMs, bool answered);
+
 /**
  * Update WiFi connection status
  *
- * Monitors the WiFi connection and attempts to reconnect if disconnected.
+ * Handles the WiFi events received since the last call, tells the
+ * subscribers and attempts to reconnect if disconnected.
  * Call this repeatedly in loop() to maintain connection.
  */
 void wifiManagerLoop();
@@ -33,8 +155,36 @@ void wifiManagerLoop();
 /**
  * Check if WiFi is currently connected
  *
+ * Cheap enough to call as often as needed: it returns the state the last
+ * wifiManagerLoop() saw instead of asking the WiFi hardware.
+ *
  * @return true if connected to WiFi, false otherwise
  */
 bool wifiManagerIsConnected();
 
+/**
+ * Get the connection state
+ *
+ * @return One of the WifiState values
+ */
+WifiState wifiManagerState();
+
+/**
+ * Be told when the connection comes back or goes away
+ *
+ * Subscribing the same function twice has no effect. A subscriber is not
+ * called for the current state, only for changes after it subscribed.
+ *
+ * @param callback Function to call
+ * @return false if WIFI_MAX_SUBSCRIBERS are already subscribed
+ */
+bool wifiManagerSubscribe(WifiLinkCallback callback);
+
+/**
+ * Get reconnect statistics
+ *
+ * @return Counters and outage times since wifiManagerSetup()
+ */
+WifiStats wifiManagerGetStats();
+
 #endif
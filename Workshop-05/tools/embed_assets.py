@@ -0,0 +1,174 @@
+#!/usr/bin/env python3
+"""
+embed_assets.py - Compress a sketch's web interface into its firmware
+
+Reads every file in <sketch>/data, gzips it and writes <sketch>/static_assets.h
+with one byte array per file plus a route table:
+
+    path           URL the file is served at ("/index.html" is also "/")
+    content type   worked out once here instead of on every request
+    ETag           hash of the file, lets browsers revalidate with a 304
+    Cache-Control  "no-cache": browsers ask every time, and get a 304
+                   with no body while their ETag still matches
+
+The arrays are const, so they stay in flash and are read through the ESP32's
+memory-mapped flash cache. Serving them needs no LittleFS access, no file
+handle and no heap copy.
+
+Files that hold data the firmware changes at runtime (*.json) and README files
+are left to LittleFS.
+
+Usage:
+    python3 Workshop-05/tools/embed_assets.py Workshop-05/examples/cardano-pos
+
+Run it again every time something in data/ changes.
+"""
+
+import gzip
+import hashlib
+import os
+import re
+import sys
+
+CONTENT_TYPES = {
+    ".html": "text/html",
+    ".css": "text/css",
+    ".js": "application/javascript",
+    ".ico": "image/x-icon",
+    ".png": "image/png",
+    ".svg": "image/svg+xml",
+    ".txt": "text/plain",
+}
+
+# Every file revalidates, so a new firmware shows up on the next page load.
+# The URLs carry no version: with a max-age, a phone could run old scripts
+# against the new HTML and API until its copy expired. A 304 is a few
+# hundred bytes.
+CACHE_CONTROL = "no-cache"
+
+SKIPPED_EXTENSIONS = (".json", ".md")
+
+BYTES_PER_LINE = 16
+
+
+def symbol_for(path):
+    return "ASSET_" + re.sub(r"[^A-Za-z0-9]", "_", path.strip("/")).upper()
+
+
+def format_bytes(data):
+    lines = []
+    for start in range(0, len(data), BYTES_PER_LINE):
+        chunk = data[start:start + BYTES_PER_LINE]
+        lines.append("    " + ", ".join("0x%02x" % b for b in chunk) + ",")
+    return "\n".join(lines)
+
+
+def collect_assets(data_dir):
+    assets = []
+    for root, _, files in os.walk(data_dir):
+        for name in sorted(files):
+            if name.lower().endswith(SKIPPED_EXTENSIONS):
+                continue
+            extension = os.path.splitext(name)[1].lower()
+            if extension not in CONTENT_TYPES:
+                print("  skipping %s (unknown content type)" % name)
+                continue
+
+            full_path = os.path.join(root, name)
+            relative = os.path.relpath(full_path, data_dir).replace(os.sep, "/")
+            with open(full_path, "rb") as source:
+                raw = source.read()
+
+            # mtime=0 keeps the output identical between runs
+            compressed = gzip.compress(raw, compresslevel=9, mtime=0)
+            content_type = CONTENT_TYPES[extension]
+            assets.append({
+                "path": "/" + relative,
+                "symbol": symbol_for(relative),
+                "content_type": content_type,
+                "etag": '"%s"' % hashlib.sha1(raw).hexdigest()[:16],
+                "cache_control": CACHE_CONTROL,
+                "data": compressed,
+                "original_length": len(raw),
+            })
+    return sorted(assets, key=lambda asset: asset["path"])
+
+
+def write_header(sketch_dir, assets):
+    lines = [
+        "// static_assets.h - Web interface files compressed into the firmware",
+        "//",
+        "// GENERATED by Workshop-05/tools/embed_assets.py from data/ - do not edit.",
+        "// Run the script again after changing anything in data/.",
+        "",
+        "#ifndef STATIC_ASSETS_H",
+        "#define STATIC_ASSETS_H",
+        "",
+        "#include <Arduino.h>",
+        "",
+        "struct StaticAsset {",
+        "  const char *path;         // URL path, e.g. \"/index.html\"",
+        "  const char *contentType;  // MIME type of the uncompressed file",
+        "  const char *etag;         // Quoted hash of the file contents",
+        "  const char *cacheControl; // Cache-Control header value",
+        "  const uint8_t *data;      // Gzip-compressed file",
+        "  size_t length;            // Compressed size in bytes",
+        "  size_t originalLength;    // Uncompressed size in bytes",
+        "};",
+        "",
+    ]
+
+    for asset in assets:
+        lines.append("// %s: %d bytes, %d gzipped" % (
+            asset["path"], asset["original_length"], len(asset["data"])))
+        lines.append("static const uint8_t %s[] PROGMEM = {" % asset["symbol"])
+        lines.append(format_bytes(asset["data"]))
+        lines.append("};")
+        lines.append("")
+
+    lines.append("static const StaticAsset STATIC_ASSETS[] = {")
+    for asset in assets:
+        lines.append('    {"%s", "%s", "%s", "%s", %s, %d, %d},' % (
+            asset["path"], asset["content_type"],
+            asset["etag"].replace('"', '\\"'), asset["cache_control"],
+            asset["symbol"], len(asset["data"]), asset["original_length"]))
+    lines.append("};")
+    lines.append("")
+    lines.append("static const size_t STATIC_ASSET_COUNT =")
+    lines.append("    sizeof(STATIC_ASSETS) / sizeof(STATIC_ASSETS[0]);")
+    lines.append("")
+    lines.append("#endif")
+
+    with open(os.path.join(sketch_dir, "static_assets.h"), "w") as header:
+        header.write("\n".join(lines) + "\n")
+
+
+def main():
+    if len(sys.argv) != 2:
+        print(__doc__)
+        return 1
+
+    sketch_dir = sys.argv[1]
+    data_dir = os.path.join(sketch_dir, "data")
+    if not os.path.isdir(data_dir):
+        print("No data/ folder in %s" % sketch_dir)
+        return 1
+
+    assets = collect_assets(data_dir)
+    if not assets:
+        print("No files to embed in %s" % data_dir)
+        return 1
+    write_header(sketch_dir, assets)
+
+    original = sum(asset["original_length"] for asset in assets)
+    compressed = sum(len(asset["data"]) for asset in assets)
+    for asset in assets:
+        print("  %-24s %6d -> %6d bytes" % (
+            asset["path"], asset["original_length"], len(asset["data"])))
+    print("Wrote static_assets.h: %d file(s), %d -> %d bytes (%.0f%%)" % (
+        len(assets), original, compressed, 100.0 * compressed / original))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,165 @@
+/**
+ * fleet_bench.cpp - Device fleet against the gateway core
+ *
+ * Simulates a fleet of tickers, each polling account_info for its wallet,
+ * the ADA price and the chain tip, through Gateway::handle() with a stub
+ * upstream that answers after a fixed latency and counts what it is asked.
+ * Several wallets are shared between devices, as they are in a shop with
+ * more than one ticker on the counter.
+ *
+ * The numbers to look at are upstream requests per device request, and how
+ * they change with the number of devices (should stay flat) and wallets
+ * (should grow).
+ *
+ * Usage: ./bin/fleet_bench [devices] [wallets] [seconds] [latency_ms]
+ */
+
+#include "gateway.h"
+#include "json_scan.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace gateway;
+
+namespace {
+// Answers like the real APIs would, after latency_ms
+class StubUpstream : public Upstream {
+public:
+  explicit StubUpstream(int latencyMs) : latencyMs_(latencyMs) {}
+
+  UpstreamResponse fetch(const UpstreamRequest &request) override {
+    std::this_thread::sleep_for(std::chrono::milliseconds(latencyMs_));
+    requests++;
+    UpstreamResponse response;
+    response.status = 200;
+    response.contentType = "application/json";
+    if (request.url.find("/account_info") != std::string::npos) {
+      accountRequests++;
+      std::vector<std::string> addresses;
+      stringArrayField(request.body, "_stake_addresses", addresses);
+      response.body = "[";
+      for (const std::string &address : addresses) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        walletsSeen.insert(address);
+        if (response.body.size() > 1) {
+          response.body += ",";
+        }
+        response.body += "{\"stake_address\":" + quote(address) +
+                         ",\"status\":\"registered\",\"total_balance\":\"" +
+                         std::to_string(address.size() * 1000003) + "\"}";
+      }
+      response.body += "]";
+    } else if (request.url.find("/simple/price") != std::string::npos) {
+      response.body = "{\"cardano\":{\"usd\":0.42}}";
+    } else {
+      response.body = "[{\"block_no\":11000000,\"epoch_no\":540}]";
+    }
+    return response;
+  }
+
+  std::atomic<uint64_t> requests{0};
+  std::atomic<uint64_t> accountRequests{0};
+  std::set<std::string> walletsSeen;
+
+private:
+  int latencyMs_;
+  std::mutex mutex_;
+};
+
+std::string stakeAddress(int wallet) {
+  char address[64];
+  snprintf(address, sizeof(address), "stake1u%050d", wallet);
+  return address;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  int devices = argc > 1 ? atoi(argv[1]) : 50;
+  int wallets = argc > 2 ? atoi(argv[2]) : 20;
+  double seconds = argc > 3 ? atof(argv[3]) : 5;
+  int latencyMs = argc > 4 ? atoi(argv[4]) : 150;
+
+  Config config;
+  config.batchWindowMs = 50;
+  config.defaultTtlSeconds = 30;
+  config.ttlSeconds["/koios/account_info"] = 2;
+  config.ttlSeconds["/koios/tip"] = 1;
+  UpstreamConfig koios;
+  koios.name = "koios";
+  koios.baseUrl = "https://koios.invalid/api/v1";
+  koios.batchAccounts = true;
+  config.upstreams["koios"] = koios;
+  UpstreamConfig coingecko;
+  coingecko.name = "coingecko";
+  coingecko.baseUrl = "https://coingecko.invalid/api/v3";
+  config.upstreams["coingecko"] = coingecko;
+
+  StubUpstream upstream(latencyMs);
+  Gateway gateway(config, upstream);
+
+  // Each device polls its wallet, the price and the tip about every 500 ms
+  std::atomic<uint64_t> deviceRequests{0}, failures{0};
+  std::atomic<bool> running{true};
+  std::vector<std::thread> fleet;
+  for (int device = 0; device < devices; device++) {
+    fleet.emplace_back([&, device] {
+      std::mt19937 random(device);
+      std::uniform_int_distribution<int> jitter(400, 600);
+      Request account{"POST", "/koios/account_info",
+                      "{\"_stake_addresses\":[" +
+                          quote(stakeAddress(device % wallets)) + "]}", ""};
+      Request price{"GET",
+                    "/coingecko/simple/price?ids=cardano&vs_currencies=usd",
+                    "", ""};
+      Request tip{"GET", "/koios/tip", "", ""};
+      while (running) {
+        for (const Request *request : {&account, &price, &tip}) {
+          Response response = gateway.handle(*request);
+          deviceRequests++;
+          if (response.status != 200) {
+            failures++;
+          }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(jitter(random)));
+      }
+    });
+  }
+  std::this_thread::sleep_for(
+      std::chrono::milliseconds((int)(seconds * 1000)));
+  running = false;
+  for (std::thread &device : fleet) {
+    device.join();
+  }
+
+  Metrics &metrics = gateway.metrics();
+  printf("chain-gateway fleet benchmark: %d devices, %d wallets, %.0f s, "
+         "%d ms upstream latency\n\n",
+         devices, wallets, seconds, latencyMs);
+  printf("Device requests:        %llu (%llu failed)\n",
+         (unsigned long long)deviceRequests.load(),
+         (unsigned long long)failures.load());
+  printf("Hit ratio:              %.1f%% (hits %llu, coalesced %llu, "
+         "misses %llu)\n",
+         metrics.hitRatio() * 100, (unsigned long long)metrics.hits.load(),
+         (unsigned long long)metrics.coalesced.load(),
+         (unsigned long long)metrics.misses.load());
+  printf("Upstream requests:      %llu (%.3f per device request)\n",
+         (unsigned long long)upstream.requests.load(),
+         deviceRequests ? (double)upstream.requests / deviceRequests : 0.0);
+  printf("  account_info batches: %llu for %llu addresses (%zu wallets)\n",
+         (unsigned long long)metrics.accountBatches.load(),
+         (unsigned long long)metrics.accountBatchAddresses.load(),
+         upstream.walletsSeen.size());
+  printf("Without the gateway:    %llu upstream requests\n",
+         (unsigned long long)deviceRequests.load());
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+#include "account_batcher.h"
+#include "json_scan.h"
+
+#include <thread>
+
+namespace gateway {
+
+AccountBatcher::AccountBatcher(Upstream &upstream, ResponseCache &cache,
+                               Metrics &metrics,
+                               std::chrono::milliseconds window,
+                               size_t maxBatchSize)
+    : upstream_(upstream), cache_(cache), metrics_(metrics), window_(window),
+      maxBatchSize_(maxBatchSize) {}
+
+std::string AccountBatcher::cacheKey(const std::string &url,
+                                     const std::string &address) {
+  return "ACCOUNT " + url + " " + address;
+}
+
+UpstreamResponse
+AccountBatcher::lookup(const std::string &url,
+                       const std::vector<std::string> &headers,
+                       const std::vector<std::string> &stakeAddresses,
+                       std::chrono::seconds ttl, bool &allCached) {
+  metrics_.accountLookups += stakeAddresses.size();
+
+  // Addresses not in the cache join the batch that is collecting. The
+  // request that opens a batch sends it when the window is over.
+  std::vector<std::shared_ptr<Batch>> waitFor;
+  std::vector<std::shared_ptr<Batch>> opened;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const std::string &address : stakeAddresses) {
+      if (cache_.peek(cacheKey(url, address))) {
+        metrics_.accountHits++;
+        continue;
+      }
+      std::string key = cacheKey(url, address);
+      auto pending = pending_.find(key);
+      if (pending != pending_.end()) {
+        waitFor.push_back(pending->second); // Already asked for
+        continue;
+      }
+      std::shared_ptr<Batch> &batch = collecting_[url];
+      if (!batch || batch->addresses.size() >= maxBatchSize_) {
+        batch = std::make_shared<Batch>();
+        batch->url = url;
+        batch->headers = headers;
+        opened.push_back(batch); // Sent by whoever opened it, even if full
+      }
+      batch->addresses.insert(address);
+      pending_[key] = batch;
+      waitFor.push_back(batch);
+    }
+  }
+  allCached = waitFor.empty();
+
+  if (!opened.empty()) {
+    std::this_thread::sleep_for(window_);
+    for (const auto &batch : opened) {
+      sendBatch(batch, ttl);
+    }
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (const auto &batch : waitFor) {
+      batchDone_.wait(lock, [&] { return batch->done; });
+    }
+  }
+
+  // Answer in the order asked for, from the cache
+  UpstreamResponse response;
+  response.status = 200;
+  response.contentType = "application/json";
+  response.body = "[";
+  bool first = true;
+  for (const std::string &address : stakeAddresses) {
+    ResponsePtr account = cache_.peek(cacheKey(url, address), true);
+    if (!account) {
+      metrics_.errors++;
+      response.status = 502;
+      response.body = "{\"error\":\"account lookup failed\"}";
+      return response;
+    }
+    if (account->body.empty()) {
+      continue; // Unknown to Koios
+    }
+    if (!first) {
+      response.body += ",";
+    }
+    response.body += account->body;
+    first = false;
+  }
+  response.body += "]";
+  return response;
+}
+
+void AccountBatcher::sendBatch(const std::shared_ptr<Batch> &batch,
+                               std::chrono::seconds ttl) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto collecting = collecting_.find(batch->url);
+    if (collecting != collecting_.end() && collecting->second == batch) {
+      collecting_.erase(collecting);
+    }
+  }
+
+  UpstreamRequest request;
+  request.method = "POST";
+  request.url = batch->url;
+  request.headers = batch->headers;
+  request.headers.push_back("Content-Type: application/json");
+  request.body = "{\"_stake_addresses\":[";
+  for (const std::string &address : batch->addresses) {
+    if (request.body.back() != '[') {
+      request.body += ",";
+    }
+    request.body += quote(address);
+  }
+  request.body += "]}";
+
+  metrics_.accountBatches++;
+  metrics_.accountBatchAddresses += batch->addresses.size();
+  metrics_.upstreamRequests++;
+  Clock::time_point start = Clock::now();
+  UpstreamResponse response = upstream_.fetch(request);
+  metrics_.upstreamMicros += std::chrono::duration_cast<std::chrono::microseconds>(
+                                 Clock::now() - start)
+                                 .count();
+
+  std::vector<std::string> accounts;
+  if (response.status == 200 && splitArray(response.body, accounts)) {
+    std::set<std::string> unknown = batch->addresses;
+    for (const std::string &account : accounts) {
+      std::string address;
+      if (stringField(account, "stake_address", address) &&
+          unknown.erase(address)) {
+        UpstreamResponse entry;
+        entry.status = 200;
+        entry.body = account;
+        cache_.put(cacheKey(batch->url, address), entry, ttl);
+      }
+    }
+    // Koios leaves out addresses it does not know; remember that too
+    for (const std::string &address : unknown) {
+      UpstreamResponse entry;
+      entry.status = 200;
+      cache_.put(cacheKey(batch->url, address), entry, ttl);
+    }
+  } else {
+    metrics_.upstreamErrors++;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const std::string &address : batch->addresses) {
+      auto pending = pending_.find(cacheKey(batch->url, address));
+      if (pending != pending_.end() && pending->second == batch) {
+        pending_.erase(pending);
+      }
+    }
+    batch->done = true;
+  }
+  batchDone_.notify_all();
+}
+
+} // namespace gateway
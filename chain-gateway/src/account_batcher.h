@@ -0,0 +1,73 @@
+/**
+ * account_batcher.h - Batched Koios account_info lookups
+ *
+ * Koios account_info takes a list of stake addresses. Devices each ask for
+ * their own one or two, so the request bodies differ and the response cache
+ * alone cannot share them. The batcher caches each address on its own,
+ * collects the addresses that are missing for a short window and asks Koios
+ * for all of them in one request. Upstream traffic then follows the number
+ * of distinct wallets, not the number of devices asking.
+ */
+
+#ifndef GATEWAY_ACCOUNT_BATCHER_H
+#define GATEWAY_ACCOUNT_BATCHER_H
+
+#include "metrics.h"
+#include "response_cache.h"
+#include "upstream.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace gateway {
+
+class AccountBatcher {
+public:
+  AccountBatcher(Upstream &upstream, ResponseCache &cache, Metrics &metrics,
+                 std::chrono::milliseconds window, size_t maxBatchSize);
+
+  // Look up stake addresses with POST url {"_stake_addresses":[...]}.
+  // The answer is Koios' array of account objects in the requested order
+  // (unknown addresses are left out, like Koios does). status is 502 if an
+  // address could not be looked up and has no stale entry either.
+  UpstreamResponse lookup(const std::string &url,
+                          const std::vector<std::string> &headers,
+                          const std::vector<std::string> &stakeAddresses,
+                          std::chrono::seconds ttl, bool &allCached);
+
+private:
+  struct Batch {
+    std::string url;
+    std::vector<std::string> headers;
+    std::set<std::string> addresses;
+    bool done = false;
+  };
+
+  void sendBatch(const std::shared_ptr<Batch> &batch, std::chrono::seconds ttl);
+
+  static std::string cacheKey(const std::string &url,
+                              const std::string &address);
+
+  Upstream &upstream_;
+  ResponseCache &cache_;
+  Metrics &metrics_;
+  std::chrono::milliseconds window_;
+  size_t maxBatchSize_;
+
+  std::mutex mutex_;
+  std::condition_variable batchDone_;
+  // Batch still collecting addresses, per upstream URL
+  std::unordered_map<std::string, std::shared_ptr<Batch>> collecting_;
+  // Batch each address (cache key) is waiting for, collecting or sent
+  std::unordered_map<std::string, std::shared_ptr<Batch>> pending_;
+};
+
+} // namespace gateway
+
+#endif
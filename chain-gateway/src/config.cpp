@@ -0,0 +1,104 @@
+#include "config.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace gateway {
+
+int Config::ttlFor(const std::string &path) const {
+  int ttl = defaultTtlSeconds;
+  size_t longest = 0;
+  for (const auto &entry : ttlSeconds) {
+    const std::string &prefix = entry.first;
+    if (prefix.size() >= longest && path.compare(0, prefix.size(), prefix) == 0) {
+      ttl = entry.second;
+      longest = prefix.size();
+    }
+  }
+  return ttl;
+}
+
+bool loadConfig(const std::string &path, Config &config, std::string &error) {
+  std::ifstream file(path);
+  if (!file) {
+    error = "cannot open " + path;
+    return false;
+  }
+
+  std::string line;
+  int lineNumber = 0;
+  while (std::getline(file, line)) {
+    lineNumber++;
+    size_t comment = line.find('#');
+    if (comment != std::string::npos) {
+      line.erase(comment);
+    }
+    std::istringstream words(line);
+    std::string keyword;
+    if (!(words >> keyword)) {
+      continue;
+    }
+
+    bool ok = true;
+    if (keyword == "listen") {
+      ok = bool(words >> config.port);
+    } else if (keyword == "cache_mb") {
+      size_t megabytes = 0;
+      ok = bool(words >> megabytes);
+      config.cacheBytes = megabytes * 1024 * 1024;
+    } else if (keyword == "batch_window_ms") {
+      ok = bool(words >> config.batchWindowMs);
+    } else if (keyword == "max_batch") {
+      ok = bool(words >> config.maxBatchSize) && config.maxBatchSize > 0;
+    } else if (keyword == "stale_seconds") {
+      ok = bool(words >> config.staleSeconds);
+    } else if (keyword == "max_connections") {
+      ok = bool(words >> config.maxConnections);
+    } else if (keyword == "upstream") {
+      UpstreamConfig upstream;
+      ok = bool(words >> upstream.name >> upstream.baseUrl);
+      while (ok && !upstream.baseUrl.empty() && upstream.baseUrl.back() == '/') {
+        upstream.baseUrl.pop_back();
+      }
+      if (ok) {
+        config.upstreams[upstream.name] = upstream;
+      }
+    } else if (keyword == "header") {
+      std::string name, header, value;
+      ok = bool(words >> name >> header) && config.upstreams.count(name);
+      std::getline(words >> std::ws, value);
+      if (ok) {
+        config.upstreams[name].headers.push_back(header + ": " + value);
+      }
+    } else if (keyword == "ttl") {
+      std::string prefix;
+      int seconds = 0;
+      ok = bool(words >> prefix >> seconds);
+      if (ok && prefix == "/") {
+        config.defaultTtlSeconds = seconds;
+      } else if (ok) {
+        config.ttlSeconds[prefix] = seconds;
+      }
+    } else if (keyword == "batch_accounts") {
+      std::string name;
+      ok = bool(words >> name) && config.upstreams.count(name);
+      if (ok) {
+        config.upstreams[name].batchAccounts = true;
+      }
+    } else if (keyword == "snapshot") {
+      ok = bool(words >> config.snapshotMinswap >> config.snapshotCexplorer) &&
+           config.upstreams.count(config.snapshotMinswap) &&
+           config.upstreams.count(config.snapshotCexplorer);
+    } else {
+      ok = false;
+    }
+
+    if (!ok) {
+      error = path + ":" + std::to_string(lineNumber) + ": bad line: " + line;
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace gateway
@@ -0,0 +1,59 @@
+/**
+ * config.h - Gateway configuration file
+ *
+ * One setting per line, '#' starts a comment:
+ *
+ *   listen 8080
+ *   cache_mb 32
+ *   batch_window_ms 50
+ *   upstream koios https://api.koios.rest/api/v1
+ *   header cexplorer api-key 0123456789
+ *   ttl /koios/account_info 60
+ *   batch_accounts koios
+ *   snapshot minswap cexplorer
+ *
+ * See gateway.conf.example for the full list.
+ */
+
+#ifndef GATEWAY_CONFIG_H
+#define GATEWAY_CONFIG_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace gateway {
+
+struct UpstreamConfig {
+  std::string name;    // First path segment devices use (/koios/...)
+  std::string baseUrl; // Path after the name is appended to this
+  std::vector<std::string> headers; // Sent with every request ("Name: value")
+  bool batchAccounts = false; // Merge account_info lookups (Koios only)
+};
+
+struct Config {
+  int port = 8080;
+  size_t cacheBytes = 32 * 1024 * 1024;
+  int batchWindowMs = 50;  // How long account lookups wait for company
+  int maxBatchSize = 50;   // Stake addresses per upstream request
+  int staleSeconds = 600;  // Serve expired entries this long if upstream fails
+  int defaultTtlSeconds = 30;
+  int maxConnections = 256;
+  std::map<std::string, UpstreamConfig> upstreams; // By name
+  std::map<std::string, int> ttlSeconds;           // By path prefix
+
+  // Upstreams ticker snapshots are built from (/snapshot/ticker), empty
+  // when snapshots are off
+  std::string snapshotMinswap;
+  std::string snapshotCexplorer;
+
+  // TTL for a device path (/koios/account_info), longest prefix wins
+  int ttlFor(const std::string &path) const;
+};
+
+// Read a configuration file. Returns false and sets error on a bad line.
+bool loadConfig(const std::string &path, Config &config, std::string &error);
+
+} // namespace gateway
+
+#endif
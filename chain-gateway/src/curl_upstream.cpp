@@ -0,0 +1,63 @@
+#include "curl_upstream.h"
+
+#include <cstdio>
+#include <curl/curl.h>
+
+namespace gateway {
+namespace {
+size_t appendBody(char *data, size_t size, size_t count, void *user) {
+  static_cast<std::string *>(user)->append(data, size * count);
+  return size * count;
+}
+
+struct EasyHandle {
+  CURL *curl = curl_easy_init();
+  ~EasyHandle() { curl_easy_cleanup(curl); }
+};
+} // namespace
+
+UpstreamResponse CurlUpstream::fetch(const UpstreamRequest &request) {
+  thread_local EasyHandle handle;
+  CURL *curl = handle.curl;
+  UpstreamResponse response;
+  if (!curl) {
+    return response;
+  }
+  curl_easy_reset(curl);
+
+  curl_slist *headers = nullptr;
+  for (const std::string &header : request.headers) {
+    headers = curl_slist_append(headers, header.c_str());
+  }
+  curl_easy_setopt(curl, CURLOPT_URL, request.url.c_str());
+  curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+  curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, ""); // Any curl supports
+  curl_easy_setopt(curl, CURLOPT_TIMEOUT, timeoutSeconds_);
+  curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, appendBody);
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response.body);
+  if (request.method == "POST") {
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.body.c_str());
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, (long)request.body.size());
+  }
+
+  CURLcode result = curl_easy_perform(curl);
+  if (result == CURLE_OK) {
+    long status = 0;
+    char *contentType = nullptr;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status);
+    curl_easy_getinfo(curl, CURLINFO_CONTENT_TYPE, &contentType);
+    response.status = (int)status;
+    if (contentType) {
+      response.contentType = contentType;
+    }
+  } else {
+    fprintf(stderr, "[Upstream] %s: %s\n", request.url.c_str(),
+            curl_easy_strerror(result));
+    response.body.clear();
+  }
+  curl_slist_free_all(headers);
+  return response;
+}
+
+} // namespace gateway
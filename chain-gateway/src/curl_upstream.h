@@ -0,0 +1,28 @@
+/**
+ * curl_upstream.h - Upstream requests with libcurl
+ *
+ * Each server thread keeps its own easy handle, so connections (and TLS
+ * sessions) to an API are reused between requests instead of reopened.
+ */
+
+#ifndef GATEWAY_CURL_UPSTREAM_H
+#define GATEWAY_CURL_UPSTREAM_H
+
+#include "upstream.h"
+
+namespace gateway {
+
+class CurlUpstream : public Upstream {
+public:
+  explicit CurlUpstream(long timeoutSeconds = 15)
+      : timeoutSeconds_(timeoutSeconds) {}
+
+  UpstreamResponse fetch(const UpstreamRequest &request) override;
+
+private:
+  long timeoutSeconds_;
+};
+
+} // namespace gateway
+
+#endif
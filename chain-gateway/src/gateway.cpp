@@ -0,0 +1,374 @@
+#include "gateway.h"
+#include "json_scan.h"
+#include "ticker_snapshot.h"
+
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <future>
+
+namespace gateway {
+namespace {
+// What the ticker shows of one NFT collection
+struct Collection {
+  std::string policyId;
+  std::string name;
+  uint32_t count = 0;
+  uint64_t floorLovelace = 0;
+};
+
+std::string queryParam(const std::string &query, const std::string &name) {
+  size_t pos = 0;
+  while ((pos = query.find(name + "=", pos)) != std::string::npos) {
+    if (pos > 0 && query[pos - 1] != '?' && query[pos - 1] != '&') {
+      pos++;
+      continue;
+    }
+    size_t start = pos + name.size() + 1;
+    return query.substr(start, query.find('&', start) - start);
+  }
+  return "";
+}
+
+int64_t toMicro(double value) {
+  double micro = std::round(value * 1e6);
+  return std::fabs(micro) < 9e18 ? (int64_t)micro : 0;
+}
+
+// The fields the ticker reads from a MinSwap portfolio (data_fetcher.cpp
+// fetchMinSwapData()): tokens as they come, NFTs grouped by policy ID
+bool readPortfolio(const std::string &json, SnapshotWriter &snapshot,
+                   std::vector<Collection> &collections) {
+  std::string positions, list, asset, metadata;
+  std::vector<std::string> items;
+  if (!objectField(json, "positions", positions)) {
+    return false;
+  }
+
+  if (objectField(positions, "nft_positions", list) && splitArray(list, items)) {
+    for (const std::string &item : items) {
+      std::string policyId, name;
+      if (!stringField(item, "currency_symbol", policyId)) {
+        continue;
+      }
+      if (!objectField(item, "asset", asset) ||
+          !objectField(asset, "metadata", metadata) ||
+          !stringField(metadata, "name", name)) {
+        name = "Unknown NFT";
+      }
+      Collection *existing = nullptr;
+      for (Collection &collection : collections) {
+        if (collection.policyId == policyId) {
+          existing = &collection;
+        }
+      }
+      if (existing) {
+        existing->count++;
+      } else if (collections.size() < SNAPSHOT_MAX_ITEMS) {
+        collections.push_back({policyId, name, 1, 0});
+      }
+    }
+  }
+
+  if (objectField(positions, "asset_positions", list) &&
+      splitArray(list, items)) {
+    for (const std::string &item : items) {
+      std::string ticker;
+      double price = 0, amount = 0, change = 0;
+      if (!objectField(item, "asset", asset) ||
+          !objectField(asset, "metadata", metadata) ||
+          !stringField(metadata, "ticker", ticker)) {
+        ticker = "UNKNOWN";
+      }
+      numberField(item, "price_usd", price);
+      numberField(item, "amount", amount);
+      numberField(item, "pnl_24h_percent", change);
+      if (!snapshot.addToken(ticker.c_str(), toMicro(amount),
+                             toMicro(price * amount),
+                             (int32_t)std::lround(change * 100))) {
+        break;
+      }
+    }
+  }
+  return true;
+}
+
+// Name and floor price from a Cexplorer policy/detail answer
+// (data_fetcher.cpp fetchCexplorerData())
+void readCollection(const std::string &json, Collection &collection) {
+  std::string data, details, stats;
+  double floor = 0;
+  if (!objectField(json, "data", data) ||
+      !objectField(data, "collection", details)) {
+    return;
+  }
+  if (!stringField(details, "name", collection.name)) {
+    collection.name = "Unknown";
+  }
+  if (objectField(details, "stats", stats) &&
+      numberField(stats, "floor", floor) && floor > 0) {
+    collection.floorLovelace = (uint64_t)floor;
+  }
+}
+
+const char *cacheStatus(CacheOutcome outcome) {
+  switch (outcome) {
+  case CacheOutcome::Hit:
+    return "HIT";
+  case CacheOutcome::Coalesced:
+    return "COALESCED";
+  case CacheOutcome::Stale:
+    return "STALE";
+  default:
+    return "MISS";
+  }
+}
+
+bool upstreamFailed(const UpstreamResponse &response) {
+  return response.status == 0 || response.status == 429 ||
+         response.status >= 500;
+}
+} // namespace
+
+Response errorResponse(int status, const std::string &message) {
+  Response response;
+  response.status = status;
+  response.body = "{\"error\":" + quote(message) + "}";
+  return response;
+}
+
+Gateway::Gateway(const Config &config, Upstream &upstream)
+    : config_(config), upstream_(upstream),
+      cache_(config.cacheBytes, std::chrono::seconds(config.staleSeconds)),
+      accounts_(upstream, cache_, metrics_,
+                std::chrono::milliseconds(config.batchWindowMs),
+                (size_t)config.maxBatchSize) {}
+
+Response Gateway::handle(const Request &request) {
+  if (request.method == "GET" && request.target == "/metrics") {
+    Response response;
+    response.contentType = "text/plain; version=0.0.4";
+    response.body = metrics_.toPrometheus(cache_.entries(), cache_.bytes());
+    return response;
+  }
+  if (request.method == "GET" && request.target == "/health") {
+    Response response;
+    response.body = "{\"status\":\"ok\"}";
+    return response;
+  }
+  if (request.method != "GET" && request.method != "POST") {
+    return errorResponse(405, "only GET and POST are supported");
+  }
+
+  // /<upstream>/<path>?<query>
+  size_t queryStart = request.target.find('?');
+  std::string path = request.target.substr(0, queryStart);
+  std::string query = queryStart == std::string::npos
+                          ? ""
+                          : request.target.substr(queryStart);
+  if (request.method == "GET" && path == "/snapshot/ticker") {
+    metrics_.requests++;
+    return tickerSnapshot(request, query);
+  }
+  size_t nameEnd = path.find('/', 1);
+  std::string name = path.substr(1, nameEnd == std::string::npos
+                                        ? std::string::npos
+                                        : nameEnd - 1);
+  auto upstream = config_.upstreams.find(name);
+  if (path.size() < 2 || upstream == config_.upstreams.end()) {
+    return errorResponse(404, "unknown upstream");
+  }
+
+  metrics_.requests++;
+  if (upstream->second.batchAccounts && request.method == "POST" &&
+      path == "/" + name + "/account_info" && query.empty()) {
+    return lookupAccounts(upstream->second, request, path);
+  }
+  return proxy(upstream->second, request, path, query);
+}
+
+CacheResult Gateway::fetchCached(const UpstreamConfig &upstream,
+                                const std::string &method,
+                                const std::string &rest,
+                                const std::string &body) {
+  UpstreamRequest upstreamRequest;
+  upstreamRequest.method = method;
+  upstreamRequest.url = upstream.baseUrl + rest;
+  upstreamRequest.body = body;
+  upstreamRequest.headers = upstream.headers;
+  if (method == "POST") {
+    upstreamRequest.headers.push_back("Content-Type: application/json");
+  }
+
+  std::string key = method + " " + upstreamRequest.url + "\n" + body;
+  std::string path = "/" + upstream.name + rest.substr(0, rest.find('?'));
+  return cache_.get(key, std::chrono::seconds(config_.ttlFor(path)),
+                    [&] { return fetchUpstream(upstreamRequest); });
+}
+
+void Gateway::countOutcome(CacheOutcome outcome) {
+  switch (outcome) {
+  case CacheOutcome::Hit:
+    metrics_.hits++;
+    break;
+  case CacheOutcome::Coalesced:
+    metrics_.coalesced++;
+    break;
+  case CacheOutcome::Stale:
+    metrics_.stale++;
+    break;
+  case CacheOutcome::Miss:
+    metrics_.misses++;
+    break;
+  }
+}
+
+Response Gateway::proxy(const UpstreamConfig &upstream, const Request &request,
+                        const std::string &path, const std::string &query) {
+  CacheResult result =
+      fetchCached(upstream, request.method,
+                  path.substr(upstream.name.size() + 1) + query, request.body);
+  countOutcome(result.outcome);
+
+  const UpstreamResponse &upstreamResponse = *result.response;
+  if (upstreamResponse.status == 0) {
+    metrics_.errors++;
+    return errorResponse(502, "upstream did not answer");
+  }
+  if (upstreamFailed(upstreamResponse)) {
+    metrics_.errors++;
+  }
+  Response response;
+  response.status = upstreamResponse.status;
+  if (!upstreamResponse.contentType.empty()) {
+    response.contentType = upstreamResponse.contentType;
+  }
+  response.body = upstreamResponse.body;
+  response.headers.emplace_back("X-Cache", cacheStatus(result.outcome));
+  return response;
+}
+
+Response Gateway::lookupAccounts(const UpstreamConfig &upstream,
+                                 const Request &request,
+                                 const std::string &path) {
+  std::vector<std::string> addresses;
+  if (!stringArrayField(request.body, "_stake_addresses", addresses) ||
+      addresses.empty()) {
+    metrics_.errors++;
+    return errorResponse(400, "expected {\"_stake_addresses\":[...]}");
+  }
+
+  bool allCached = false;
+  UpstreamResponse accounts = accounts_.lookup(
+      upstream.baseUrl + "/account_info", upstream.headers, addresses,
+      std::chrono::seconds(config_.ttlFor(path)), allCached);
+  // A request whose addresses were all cached is a hit; otherwise it shared
+  // an upstream request with every other device in the batch
+  if (accounts.status != 200) {
+    metrics_.misses++; // The batcher counted the error
+  } else if (allCached) {
+    metrics_.hits++;
+  } else {
+    metrics_.coalesced++;
+  }
+
+  Response response;
+  response.status = accounts.status;
+  response.body = accounts.body;
+  if (accounts.status == 200) {
+    response.headers.emplace_back("X-Cache", allCached ? "HIT" : "BATCHED");
+  }
+  return response;
+}
+
+Response Gateway::tickerSnapshot(const Request &request,
+                                 const std::string &query) {
+  auto minswap = config_.upstreams.find(config_.snapshotMinswap);
+  auto cexplorer = config_.upstreams.find(config_.snapshotCexplorer);
+  if (minswap == config_.upstreams.end() ||
+      cexplorer == config_.upstreams.end()) {
+    return errorResponse(404, "snapshots are not configured");
+  }
+  std::string address = queryParam(query, "address");
+  std::string version = queryParam(query, "v");
+  if (address.empty() ||
+      (!version.empty() && version != std::to_string(SNAPSHOT_VERSION))) {
+    metrics_.errors++;
+    return errorResponse(400, "expected ?v=1&address=addr1...");
+  }
+
+  // The same URL the ticker asks without snapshots, so both share the entry
+  CacheResult portfolio = fetchCached(
+      minswap->second, "GET",
+      "/portfolio/tokens?address=" + address +
+          "&only_minswap=true&filter_small_value=false",
+      "");
+  bool allCached = portfolio.outcome == CacheOutcome::Hit;
+  SnapshotWriter snapshot;
+  std::vector<Collection> collections;
+  if (portfolio.response->status != 200 ||
+      !readPortfolio(portfolio.response->body, snapshot, collections)) {
+    countOutcome(portfolio.outcome);
+    metrics_.errors++;
+    return errorResponse(502, "portfolio lookup failed");
+  }
+
+  // Floor prices, one Cexplorer request per collection, all at once
+  std::vector<std::future<CacheResult>> details;
+  for (const Collection &collection : collections) {
+    details.push_back(std::async(std::launch::async, [&, collection] {
+      return fetchCached(cexplorer->second, "GET",
+                         "/policy/detail?id=" + collection.policyId, "");
+    }));
+  }
+  for (size_t i = 0; i < collections.size(); i++) {
+    CacheResult detail = details[i].get();
+    allCached = allCached && detail.outcome == CacheOutcome::Hit;
+    if (detail.response->status == 200) {
+      readCollection(detail.response->body, collections[i]);
+    }
+    snapshot.addNft(collections[i].name.c_str(), collections[i].count,
+                    collections[i].floorLovelace);
+  }
+  if (allCached) {
+    countOutcome(CacheOutcome::Hit);
+  } else {
+    countOutcome(portfolio.outcome == CacheOutcome::Hit ? CacheOutcome::Miss
+                                                        : portfolio.outcome);
+  }
+
+  uint8_t buffer[SNAPSHOT_MAX_SIZE];
+  size_t length = snapshot.finish((uint32_t)time(nullptr), buffer,
+                                  sizeof(buffer));
+  char etag[16];
+  snprintf(etag, sizeof(etag), "\"%08x\"",
+           (unsigned)snapshotHash(buffer + SNAPSHOT_HEADER_SIZE,
+                                  length - SNAPSHOT_HEADER_SIZE));
+
+  Response response;
+  response.contentType = "application/octet-stream";
+  response.headers.emplace_back("ETag", etag);
+  response.headers.emplace_back("X-Cache", allCached ? "HIT" : "MISS");
+  if (request.ifNoneMatch == etag) {
+    response.status = 304; // The device already shows this
+  } else {
+    response.body.assign((const char *)buffer, length);
+  }
+  return response;
+}
+
+UpstreamResponse Gateway::fetchUpstream(const UpstreamRequest &request) {
+  metrics_.upstreamRequests++;
+  Clock::time_point start = Clock::now();
+  UpstreamResponse response = upstream_.fetch(request);
+  metrics_.upstreamMicros +=
+      std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() -
+                                                            start)
+          .count();
+  if (upstreamFailed(response)) {
+    metrics_.upstreamErrors++;
+  }
+  return response;
+}
+
+} // namespace gateway
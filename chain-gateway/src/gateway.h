@@ -0,0 +1,73 @@
+/**
+ * gateway.h - Request handling, independent of sockets
+ *
+ * Maps device requests (/koios/account_info, /minswap/portfolio/tokens?...)
+ * to upstream URLs and answers them from the cache, the account batcher or
+ * the upstream API. /snapshot/ticker turns the MinSwap and Cexplorer
+ * answers a ticker needs into one small binary snapshot (ticker_snapshot.h). http_server.cpp feeds it requests from the network;
+ * the fleet benchmark calls it directly.
+ */
+
+#ifndef GATEWAY_GATEWAY_H
+#define GATEWAY_GATEWAY_H
+
+#include "account_batcher.h"
+#include "config.h"
+#include "metrics.h"
+#include "response_cache.h"
+#include "upstream.h"
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gateway {
+
+struct Request {
+  std::string method;
+  std::string target; // Path and query as sent (/koios/tip?x=1)
+  std::string body;
+  std::string ifNoneMatch; // ETag the device already has
+};
+
+struct Response {
+  int status = 200;
+  std::string contentType = "application/json";
+  std::string body;
+  std::vector<std::pair<std::string, std::string>> headers;
+};
+
+class Gateway {
+public:
+  Gateway(const Config &config, Upstream &upstream);
+
+  Response handle(const Request &request);
+
+  Metrics &metrics() { return metrics_; }
+  ResponseCache &cache() { return cache_; }
+
+private:
+  CacheResult fetchCached(const UpstreamConfig &upstream,
+                          const std::string &method, const std::string &rest,
+                          const std::string &body);
+  void countOutcome(CacheOutcome outcome);
+  Response proxy(const UpstreamConfig &upstream, const Request &request,
+                 const std::string &path, const std::string &query);
+  Response lookupAccounts(const UpstreamConfig &upstream,
+                          const Request &request, const std::string &path);
+  Response tickerSnapshot(const Request &request, const std::string &query);
+  UpstreamResponse fetchUpstream(const UpstreamRequest &request);
+
+  const Config &config_;
+  Upstream &upstream_;
+  Metrics metrics_;
+  ResponseCache cache_;
+  AccountBatcher accounts_;
+};
+
+Response errorResponse(int status, const std::string &message);
+
+} // namespace gateway
+
+#endif
@@ -0,0 +1,213 @@
+#include "http_server.h"
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+namespace gateway {
+namespace {
+const size_t MAX_HEADER_SIZE = 16 * 1024;
+const size_t MAX_BODY_SIZE = 1024 * 1024;
+const int IDLE_TIMEOUT_SECONDS = 15;
+
+const char *reason(int status) {
+  switch (status) {
+  case 200:
+    return "OK";
+  case 304:
+    return "Not Modified";
+  case 400:
+    return "Bad Request";
+  case 404:
+    return "Not Found";
+  case 405:
+    return "Method Not Allowed";
+  case 413:
+    return "Payload Too Large";
+  case 429:
+    return "Too Many Requests";
+  case 502:
+    return "Bad Gateway";
+  case 503:
+    return "Service Unavailable";
+  default:
+    return "Status";
+  }
+}
+
+bool sendAll(int socket, const std::string &data) {
+  size_t sent = 0;
+  while (sent < data.size()) {
+    ssize_t n = send(socket, data.data() + sent, data.size() - sent,
+                     MSG_NOSIGNAL);
+    if (n <= 0) {
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    sent += (size_t)n;
+  }
+  return true;
+}
+
+bool sendResponse(int socket, const Response &response, bool keepAlive) {
+  std::string out = "HTTP/1.1 " + std::to_string(response.status) + " " +
+                    reason(response.status) + "\r\n";
+  out += "Content-Type: " + response.contentType + "\r\n";
+  out += "Content-Length: " + std::to_string(response.body.size()) + "\r\n";
+  for (const auto &header : response.headers) {
+    out += header.first + ": " + header.second + "\r\n";
+  }
+  out += keepAlive ? "Connection: keep-alive\r\n\r\n"
+                   : "Connection: close\r\n\r\n";
+  out += response.body;
+  return sendAll(socket, out);
+}
+
+// Case-insensitive header lookup in the raw header block
+std::string headerValue(const std::string &head, const char *name) {
+  size_t nameLength = strlen(name);
+  size_t line = head.find("\r\n");
+  while (line != std::string::npos && line + 2 < head.size()) {
+    size_t start = line + 2;
+    if (strncasecmp(head.c_str() + start, name, nameLength) == 0 &&
+        head[start + nameLength] == ':') {
+      size_t value = head.find_first_not_of(" \t", start + nameLength + 1);
+      size_t end = head.find("\r\n", start);
+      if (value == std::string::npos || value > end) {
+        return "";
+      }
+      return head.substr(value, end - value);
+    }
+    line = head.find("\r\n", start);
+  }
+  return "";
+}
+} // namespace
+
+HttpServer::HttpServer(Gateway &gateway, int maxConnections)
+    : gateway_(gateway), maxConnections_(maxConnections) {}
+
+bool HttpServer::run(int port) {
+  int listener = socket(AF_INET, SOCK_STREAM, 0);
+  if (listener < 0) {
+    perror("[Server] socket");
+    return false;
+  }
+  int yes = 1;
+  setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+
+  sockaddr_in address = {};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_ANY);
+  address.sin_port = htons((uint16_t)port);
+  if (bind(listener, (sockaddr *)&address, sizeof(address)) < 0 ||
+      listen(listener, 128) < 0) {
+    perror("[Server] bind");
+    close(listener);
+    return false;
+  }
+  printf("[Server] Listening on port %d\n", port);
+
+  while (running_) {
+    int client = accept(listener, nullptr, nullptr);
+    if (client < 0) {
+      if (errno != EINTR) {
+        perror("[Server] accept");
+      }
+      continue;
+    }
+    if (connections_ >= maxConnections_) {
+      gateway_.metrics().rejected++;
+      sendResponse(client, errorResponse(503, "too many connections"), false);
+      close(client);
+      continue;
+    }
+    connections_++;
+    std::thread([this, client] {
+      serveConnection(client);
+      close(client);
+      connections_--;
+    }).detach();
+  }
+  close(listener);
+  return true;
+}
+
+void HttpServer::serveConnection(int socket) {
+  timeval timeout = {IDLE_TIMEOUT_SECONDS, 0};
+  setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  int yes = 1;
+  setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+
+  std::string buffer;
+  char chunk[4096];
+  while (running_) {
+    // Read until the end of the headers
+    size_t headEnd;
+    while ((headEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+      if (buffer.size() > MAX_HEADER_SIZE) {
+        sendResponse(socket, errorResponse(400, "headers too large"), false);
+        return;
+      }
+      ssize_t n = recv(socket, chunk, sizeof(chunk), 0);
+      if (n <= 0) {
+        return; // Closed, idle or failed
+      }
+      buffer.append(chunk, (size_t)n);
+    }
+    std::string head = buffer.substr(0, headEnd);
+
+    Request request;
+    size_t methodEnd = head.find(' ');
+    size_t targetEnd = head.find(' ', methodEnd + 1);
+    if (methodEnd == std::string::npos || targetEnd == std::string::npos) {
+      sendResponse(socket, errorResponse(400, "bad request line"), false);
+      return;
+    }
+    request.method = head.substr(0, methodEnd);
+    request.target = head.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+    std::string version = head.substr(targetEnd + 1, head.find("\r\n") -
+                                                         targetEnd - 1);
+
+    std::string lengthText = headerValue(head, "Content-Length");
+    size_t length = lengthText.empty() ? 0 : strtoul(lengthText.c_str(),
+                                                      nullptr, 10);
+    if (length > MAX_BODY_SIZE ||
+        !headerValue(head, "Transfer-Encoding").empty()) {
+      sendResponse(socket, errorResponse(413, "body too large or chunked"),
+                   false);
+      return;
+    }
+    size_t bodyStart = headEnd + 4;
+    while (buffer.size() < bodyStart + length) {
+      ssize_t n = recv(socket, chunk, sizeof(chunk), 0);
+      if (n <= 0) {
+        return;
+      }
+      buffer.append(chunk, (size_t)n);
+    }
+    request.body = buffer.substr(bodyStart, length);
+    request.ifNoneMatch = headerValue(head, "If-None-Match");
+    buffer.erase(0, bodyStart + length);
+
+    std::string connection = headerValue(head, "Connection");
+    bool keepAlive = version == "HTTP/1.1"
+                         ? strcasecmp(connection.c_str(), "close") != 0
+                         : strcasecmp(connection.c_str(), "keep-alive") == 0;
+
+    Response response = gateway_.handle(request);
+    if (!sendResponse(socket, response, keepAlive) || !keepAlive) {
+      return;
+    }
+  }
+}
+
+} // namespace gateway
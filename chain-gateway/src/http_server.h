@@ -0,0 +1,38 @@
+/**
+ * http_server.h - Minimal HTTP/1.1 server for the gateway
+ *
+ * One thread per connection with keep-alive, which is plenty for a fleet of
+ * a few hundred devices that each ask every few seconds at most. Only what
+ * the firmware sends is supported: GET and POST with Content-Length bodies.
+ */
+
+#ifndef GATEWAY_HTTP_SERVER_H
+#define GATEWAY_HTTP_SERVER_H
+
+#include "gateway.h"
+
+#include <atomic>
+
+namespace gateway {
+
+class HttpServer {
+public:
+  HttpServer(Gateway &gateway, int maxConnections);
+
+  // Listen on port and serve until stop() is called. Returns false if the
+  // port could not be opened.
+  bool run(int port);
+  void stop() { running_ = false; }
+
+private:
+  void serveConnection(int socket);
+
+  Gateway &gateway_;
+  int maxConnections_;
+  std::atomic<int> connections_{0};
+  std::atomic<bool> running_{true};
+};
+
+} // namespace gateway
+
+#endif
@@ -0,0 +1,219 @@
+#include "json_scan.h"
+
+#include <cctype>
+#include <cstdlib>
+
+namespace gateway {
+namespace {
+
+void skipSpace(const std::string &json, size_t &pos) {
+  while (pos < json.size() && isspace((unsigned char)json[pos])) {
+    pos++;
+  }
+}
+
+// Step over a string starting at the opening quote, optionally decoding it
+// (escapes other than \" and \\ are kept as they are, addresses never use
+// them)
+bool scanString(const std::string &json, size_t &pos, std::string *out) {
+  if (pos >= json.size() || json[pos] != '"') {
+    return false;
+  }
+  pos++;
+  while (pos < json.size()) {
+    char c = json[pos++];
+    if (c == '"') {
+      return true;
+    }
+    if (c == '\\') {
+      if (pos >= json.size()) {
+        return false;
+      }
+      c = json[pos++];
+      if (out && c != '"' && c != '\\') {
+        *out += '\\';
+      }
+    }
+    if (out) {
+      *out += c;
+    }
+  }
+  return false;
+}
+
+// Step over any value (string, number, literal, object, array)
+bool scanValue(const std::string &json, size_t &pos) {
+  skipSpace(json, pos);
+  if (pos >= json.size()) {
+    return false;
+  }
+  if (json[pos] == '"') {
+    return scanString(json, pos, nullptr);
+  }
+  if (json[pos] != '{' && json[pos] != '[') {
+    while (pos < json.size() && json[pos] != ',' && json[pos] != '}' &&
+           json[pos] != ']' && !isspace((unsigned char)json[pos])) {
+      pos++;
+    }
+    return true;
+  }
+  int depth = 0;
+  while (pos < json.size()) {
+    char c = json[pos];
+    if (c == '"') {
+      if (!scanString(json, pos, nullptr)) {
+        return false;
+      }
+      continue;
+    }
+    pos++;
+    if (c == '{' || c == '[') {
+      depth++;
+    } else if (c == '}' || c == ']') {
+      if (--depth == 0) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Find key in a top-level object and leave pos at its value
+bool findField(const std::string &object, const std::string &key,
+               size_t &pos) {
+  pos = 0;
+  skipSpace(object, pos);
+  if (pos >= object.size() || object[pos] != '{') {
+    return false;
+  }
+  pos++;
+  while (true) {
+    skipSpace(object, pos);
+    if (pos < object.size() && object[pos] == '}') {
+      return false;
+    }
+    std::string name;
+    if (!scanString(object, pos, &name)) {
+      return false;
+    }
+    skipSpace(object, pos);
+    if (pos >= object.size() || object[pos] != ':') {
+      return false;
+    }
+    pos++;
+    skipSpace(object, pos);
+    if (name == key) {
+      return true;
+    }
+    if (!scanValue(object, pos)) {
+      return false;
+    }
+    skipSpace(object, pos);
+    if (pos < object.size() && object[pos] == ',') {
+      pos++;
+    }
+  }
+}
+} // namespace
+
+bool splitArray(const std::string &json, std::vector<std::string> &elements) {
+  elements.clear();
+  size_t pos = 0;
+  skipSpace(json, pos);
+  if (pos >= json.size() || json[pos] != '[') {
+    return false;
+  }
+  pos++;
+  skipSpace(json, pos);
+  if (pos < json.size() && json[pos] == ']') {
+    return true;
+  }
+  while (pos < json.size()) {
+    skipSpace(json, pos);
+    size_t start = pos;
+    if (!scanValue(json, pos)) {
+      return false;
+    }
+    elements.push_back(json.substr(start, pos - start));
+    skipSpace(json, pos);
+    if (pos < json.size() && json[pos] == ',') {
+      pos++;
+    } else {
+      return pos < json.size() && json[pos] == ']';
+    }
+  }
+  return false;
+}
+
+bool stringField(const std::string &object, const std::string &key,
+                 std::string &value) {
+  size_t pos;
+  value.clear();
+  return findField(object, key, pos) && scanString(object, pos, &value);
+}
+
+bool objectField(const std::string &object, const std::string &key,
+                 std::string &value) {
+  size_t pos;
+  value.clear();
+  if (!findField(object, key, pos)) {
+    return false;
+  }
+  size_t end = pos;
+  if (!scanValue(object, end)) {
+    return false;
+  }
+  value = object.substr(pos, end - pos);
+  return true;
+}
+
+bool numberField(const std::string &object, const std::string &key,
+                 double &value) {
+  std::string text;
+  if (!objectField(object, key, text) || text.empty() || text == "null") {
+    return false;
+  }
+  if (text[0] == '"') {
+    text = text.substr(1, text.size() - 2);
+  }
+  char *end;
+  value = strtod(text.c_str(), &end);
+  return end != text.c_str() && *end == '\0';
+}
+
+bool stringArrayField(const std::string &object, const std::string &key,
+                      std::vector<std::string> &values) {
+  size_t pos;
+  values.clear();
+  if (!findField(object, key, pos)) {
+    return false;
+  }
+  std::vector<std::string> elements;
+  size_t end = pos;
+  if (!scanValue(object, end) ||
+      !splitArray(object.substr(pos, end - pos), elements)) {
+    return false;
+  }
+  for (const std::string &element : elements) {
+    std::string value;
+    size_t start = 0;
+    if (!scanString(element, start, &value)) {
+      return false;
+    }
+    values.push_back(value);
+  }
+  return true;
+}
+
+std::string quote(const std::string &text) {
+  std::string out = "\"";
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+    }
+    out += c;
+  }
+  return out + "\"";
+}
+
+} // namespace gateway
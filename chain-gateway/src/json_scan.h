@@ -0,0 +1,42 @@
+/**
+ * json_scan.h - Just enough JSON for the gateway
+ *
+ * The gateway passes JSON through unchanged. It only needs to pull the
+ * stake addresses out of an account_info request, split Koios' answer into
+ * one object per address and read a few fields for ticker snapshots, so
+ * these helpers scan the text instead of building a document.
+ */
+
+#ifndef GATEWAY_JSON_SCAN_H
+#define GATEWAY_JSON_SCAN_H
+
+#include <string>
+#include <vector>
+
+namespace gateway {
+
+// Split a top-level JSON array into the raw text of its elements
+bool splitArray(const std::string &json, std::vector<std::string> &elements);
+
+// Value of a string field of a top-level object ({"key":"value",...})
+bool stringField(const std::string &object, const std::string &key,
+                 std::string &value);
+
+// Raw text of any field of a top-level object (an object, array, ...)
+bool objectField(const std::string &object, const std::string &key,
+                 std::string &value);
+
+// A number field, also accepted as a string ("12.5" or 12.5)
+bool numberField(const std::string &object, const std::string &key,
+                 double &value);
+
+// Values of a field holding an array of strings ({"key":["a","b"]})
+bool stringArrayField(const std::string &object, const std::string &key,
+                      std::vector<std::string> &values);
+
+// Quote and escape text as a JSON string
+std::string quote(const std::string &text);
+
+} // namespace gateway
+
+#endif
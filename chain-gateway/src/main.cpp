@@ -0,0 +1,60 @@
+/**
+ * main.cpp - chain-gateway entry point
+ *
+ * Usage: chain-gateway gateway.conf [port]
+ */
+
+#include "config.h"
+#include "curl_upstream.h"
+#include "gateway.h"
+#include "http_server.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <curl/curl.h>
+#include <thread>
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s gateway.conf [port]\n", argv[0]);
+    return 1;
+  }
+
+  gateway::Config config;
+  std::string error;
+  if (!gateway::loadConfig(argv[1], config, error)) {
+    fprintf(stderr, "%s: %s\n", argv[1], error.c_str());
+    return 1;
+  }
+  if (argc > 2) {
+    config.port = atoi(argv[2]);
+  }
+  if (config.upstreams.empty()) {
+    fprintf(stderr, "%s: no upstream configured\n", argv[1]);
+    return 1;
+  }
+
+  curl_global_init(CURL_GLOBAL_DEFAULT);
+  gateway::CurlUpstream upstream;
+  gateway::Gateway gateway(config, upstream);
+  for (const auto &entry : config.upstreams) {
+    printf("[Gateway] /%s/ -> %s%s\n", entry.first.c_str(),
+           entry.second.baseUrl.c_str(),
+           entry.second.batchAccounts ? " (batched account_info)" : "");
+  }
+
+  // One summary line a minute, enough to see the hit ratio in journalctl
+  std::thread([&gateway] {
+    while (true) {
+      std::this_thread::sleep_for(std::chrono::minutes(1));
+      printf("[Gateway] %s\n", gateway.metrics().summary().c_str());
+      fflush(stdout);
+    }
+  }).detach();
+
+  gateway::HttpServer server(gateway, config.maxConnections);
+  bool ok = server.run(config.port);
+  curl_global_cleanup();
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+#include "metrics.h"
+
+#include <cstdio>
+
+namespace gateway {
+namespace {
+void appendMetric(std::string &out, const char *name, const char *type,
+                  const char *help, double value) {
+  char line[256];
+  snprintf(line, sizeof(line), "# HELP %s %s\n# TYPE %s %s\n%s %.15g\n", name,
+           help, name, type, name, value);
+  out += line;
+}
+} // namespace
+
+double Metrics::hitRatio() const {
+  uint64_t total = requests.load();
+  if (total == 0) {
+    return 0;
+  }
+  return (double)(hits.load() + coalesced.load()) / total;
+}
+
+std::string Metrics::toPrometheus(size_t cacheEntries,
+                                  size_t cacheBytes) const {
+  std::string out;
+  appendMetric(out, "gateway_requests_total", "counter",
+               "Device requests proxied", requests.load());
+  appendMetric(out, "gateway_cache_hits_total", "counter",
+               "Requests answered from a fresh cache entry", hits.load());
+  appendMetric(out, "gateway_cache_coalesced_total", "counter",
+               "Requests that waited for an identical in-flight request",
+               coalesced.load());
+  appendMetric(out, "gateway_cache_misses_total", "counter",
+               "Requests that needed an upstream request", misses.load());
+  appendMetric(out, "gateway_cache_stale_total", "counter",
+               "Requests answered from an expired entry after an upstream "
+               "failure",
+               stale.load());
+  appendMetric(out, "gateway_errors_total", "counter",
+               "Requests answered with an error", errors.load());
+  appendMetric(out, "gateway_rejected_total", "counter",
+               "Connections turned away at the connection limit",
+               rejected.load());
+  appendMetric(out, "gateway_hit_ratio", "gauge",
+               "Share of requests answered without their own upstream "
+               "request",
+               hitRatio());
+  appendMetric(out, "gateway_account_lookups_total", "counter",
+               "Stake addresses looked up through account_info",
+               accountLookups.load());
+  appendMetric(out, "gateway_account_hits_total", "counter",
+               "Stake addresses answered from the cache", accountHits.load());
+  appendMetric(out, "gateway_upstream_requests_total", "counter",
+               "Requests sent to upstream APIs", upstreamRequests.load());
+  appendMetric(out, "gateway_upstream_errors_total", "counter",
+               "Upstream requests without a usable answer (no response, 429, "
+               "5xx)",
+               upstreamErrors.load());
+  appendMetric(out, "gateway_upstream_seconds_total", "counter",
+               "Time spent waiting for upstream APIs",
+               upstreamMicros.load() / 1e6);
+  appendMetric(out, "gateway_account_batches_total", "counter",
+               "Batched account_info requests sent upstream",
+               accountBatches.load());
+  appendMetric(out, "gateway_account_batch_addresses_total", "counter",
+               "Stake addresses in batched account_info requests",
+               accountBatchAddresses.load());
+  appendMetric(out, "gateway_cache_entries", "gauge", "Entries in the cache",
+               cacheEntries);
+  appendMetric(out, "gateway_cache_bytes", "gauge",
+               "Response bytes held in the cache", cacheBytes);
+  return out;
+}
+
+std::string Metrics::summary() const {
+  char line[256];
+  snprintf(line, sizeof(line),
+           "requests %llu, hit ratio %.1f%% (hits %llu, coalesced %llu, "
+           "stale %llu), upstream %llu (%llu errors), errors %llu",
+           (unsigned long long)requests.load(), hitRatio() * 100,
+           (unsigned long long)hits.load(),
+           (unsigned long long)coalesced.load(),
+           (unsigned long long)stale.load(),
+           (unsigned long long)upstreamRequests.load(),
+           (unsigned long long)upstreamErrors.load(),
+           (unsigned long long)errors.load());
+  return line;
+}
+
+} // namespace gateway
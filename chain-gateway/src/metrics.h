@@ -0,0 +1,51 @@
+/**
+ * metrics.h - Counters behind /metrics
+ *
+ * Plain atomics, updated on the request path without locks and read by
+ * the /metrics handler and the periodic log line.
+ */
+
+#ifndef GATEWAY_METRICS_H
+#define GATEWAY_METRICS_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace gateway {
+
+struct Metrics {
+  // Device side
+  std::atomic<uint64_t> requests{0};   // Proxied requests (not /metrics)
+  std::atomic<uint64_t> hits{0};       // Answered from a fresh cache entry
+  std::atomic<uint64_t> coalesced{0};  // Waited for an identical request
+  std::atomic<uint64_t> misses{0};     // Needed an upstream request
+  std::atomic<uint64_t> stale{0};      // Upstream failed, old entry served
+  std::atomic<uint64_t> errors{0};     // Answered with an error
+  std::atomic<uint64_t> rejected{0};   // Turned away, too many connections
+
+  // Account lookups, counted per stake address
+  std::atomic<uint64_t> accountLookups{0};
+  std::atomic<uint64_t> accountHits{0};
+
+  // Upstream side
+  std::atomic<uint64_t> upstreamRequests{0};
+  std::atomic<uint64_t> upstreamErrors{0}; // No response, 429 or 5xx
+  std::atomic<uint64_t> accountBatches{0};
+  std::atomic<uint64_t> accountBatchAddresses{0};
+  std::atomic<uint64_t> upstreamMicros{0}; // Total upstream wait
+
+  // Share of device requests answered without an upstream request of
+  // their own
+  double hitRatio() const;
+
+  // Prometheus text exposition format
+  std::string toPrometheus(size_t cacheEntries, size_t cacheBytes) const;
+
+  // One-line summary for the log
+  std::string summary() const;
+};
+
+} // namespace gateway
+
+#endif
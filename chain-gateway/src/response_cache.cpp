@@ -0,0 +1,135 @@
+#include "response_cache.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace gateway {
+namespace {
+size_t sizeOf(const std::string &key, const ResponsePtr &response) {
+  return key.size() +
+         (response ? response->body.size() + response->contentType.size() : 0);
+}
+} // namespace
+
+ResponseCache::ResponseCache(size_t maxBytes, std::chrono::seconds staleFor)
+    : maxBytes_(maxBytes), staleFor_(staleFor) {}
+
+bool ResponseCache::cacheable(const UpstreamResponse &response) {
+  return (response.status >= 200 && response.status < 300) ||
+         response.status == 404;
+}
+
+CacheResult ResponseCache::get(const std::string &key,
+                               std::chrono::seconds ttl,
+                               const std::function<UpstreamResponse()> &fetch) {
+  std::promise<ResponsePtr> promise;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    Entry &entry = entries_[key];
+    if (entry.response && Clock::now() < entry.expires) {
+      return {entry.response, CacheOutcome::Hit};
+    }
+    if (entry.inFlight.valid()) {
+      std::shared_future<ResponsePtr> inFlight = entry.inFlight;
+      lock.unlock();
+      ResponsePtr response = inFlight.get();
+      return {response, CacheOutcome::Coalesced};
+    }
+    entry.inFlight = promise.get_future().share();
+  }
+
+  // This request fetches, everyone else for the key waits for it
+  ResponsePtr fetched = std::make_shared<UpstreamResponse>(fetch());
+  CacheResult result = {fetched, CacheOutcome::Miss};
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry &entry = entries_[key];
+    entry.inFlight = std::shared_future<ResponsePtr>();
+    if (cacheable(*fetched)) {
+      storeLocked(key, entry, fetched, ttl);
+    } else if (entry.response && Clock::now() < entry.staleUntil) {
+      result = {entry.response, CacheOutcome::Stale};
+    } else if (!entry.response) {
+      entries_.erase(key);
+    }
+    evictLocked();
+  }
+  promise.set_value(result.response);
+  return result;
+}
+
+void ResponseCache::put(const std::string &key,
+                        const UpstreamResponse &response,
+                        std::chrono::seconds ttl) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  storeLocked(key, entries_[key], std::make_shared<UpstreamResponse>(response),
+              ttl);
+  evictLocked();
+}
+
+ResponsePtr ResponseCache::peek(const std::string &key, bool allowStale) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto found = entries_.find(key);
+  if (found == entries_.end() || !found->second.response) {
+    return nullptr;
+  }
+  Clock::time_point now = Clock::now();
+  const Entry &entry = found->second;
+  if (now < entry.expires || (allowStale && now < entry.staleUntil)) {
+    return entry.response;
+  }
+  return nullptr;
+}
+
+size_t ResponseCache::entries() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+size_t ResponseCache::bytes() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return bytes_;
+}
+
+void ResponseCache::storeLocked(const std::string &key, Entry &entry,
+                                ResponsePtr response,
+                                std::chrono::seconds ttl) {
+  bytes_ -= sizeOf(key, entry.response);
+  entry.response = response;
+  entry.expires = Clock::now() + ttl;
+  entry.staleUntil = entry.expires + staleFor_;
+  bytes_ += sizeOf(key, entry.response);
+}
+
+// Over the limit: drop entries past their stale time, then the ones that
+// expire soonest. Entries being fetched are never dropped.
+void ResponseCache::evictLocked() {
+  if (bytes_ <= maxBytes_) {
+    return;
+  }
+  Clock::time_point now = Clock::now();
+  std::vector<std::pair<Clock::time_point, std::string>> candidates;
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    Entry &entry = it->second;
+    if (entry.inFlight.valid()) {
+      ++it;
+    } else if (now >= entry.staleUntil) {
+      bytes_ -= sizeOf(it->first, entry.response);
+      it = entries_.erase(it);
+    } else {
+      candidates.emplace_back(entry.expires, it->first);
+      ++it;
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+  for (const auto &candidate : candidates) {
+    if (bytes_ <= maxBytes_) {
+      break;
+    }
+    auto it = entries_.find(candidate.second);
+    bytes_ -= sizeOf(it->first, it->second.response);
+    entries_.erase(it);
+  }
+}
+
+} // namespace gateway
@@ -0,0 +1,84 @@
+/**
+ * response_cache.h - TTL cache that coalesces identical requests
+ *
+ * Every response is stored under a key (method, URL and body). The first
+ * request for a key that is missing or expired fetches it; requests for the
+ * same key arriving meanwhile wait for that fetch instead of sending their
+ * own. Expired entries are kept a while longer and served if the upstream
+ * fails, so a rate-limited API does not take every device down with it.
+ */
+
+#ifndef GATEWAY_RESPONSE_CACHE_H
+#define GATEWAY_RESPONSE_CACHE_H
+
+#include "upstream.h"
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace gateway {
+
+typedef std::chrono::steady_clock Clock;
+typedef std::shared_ptr<const UpstreamResponse> ResponsePtr;
+
+enum class CacheOutcome {
+  Hit,       // Fresh entry
+  Coalesced, // Waited for another request's fetch
+  Miss,      // Fetched
+  Stale,     // Fetch failed, expired entry served
+};
+
+struct CacheResult {
+  ResponsePtr response;
+  CacheOutcome outcome;
+};
+
+class ResponseCache {
+public:
+  ResponseCache(size_t maxBytes, std::chrono::seconds staleFor);
+
+  // Fresh response for key, fetched with fetch() if needed. The response is
+  // kept for ttl if it can be cached (2xx and 404).
+  CacheResult get(const std::string &key, std::chrono::seconds ttl,
+                  const std::function<UpstreamResponse()> &fetch);
+
+  // Store a response fetched elsewhere (batched account lookups)
+  void put(const std::string &key, const UpstreamResponse &response,
+           std::chrono::seconds ttl);
+
+  // Entry for key without fetching. With allowStale, expired entries that
+  // are still kept for upstream failures count too.
+  ResponsePtr peek(const std::string &key, bool allowStale = false);
+
+  size_t entries();
+  size_t bytes();
+
+  static bool cacheable(const UpstreamResponse &response);
+
+private:
+  struct Entry {
+    ResponsePtr response; // Null while the first fetch is running
+    Clock::time_point expires;
+    Clock::time_point staleUntil;
+    std::shared_future<ResponsePtr> inFlight; // Valid while fetching
+  };
+
+  void storeLocked(const std::string &key, Entry &entry, ResponsePtr response,
+                   std::chrono::seconds ttl);
+  void evictLocked();
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  size_t bytes_ = 0;
+  size_t maxBytes_;
+  std::chrono::seconds staleFor_;
+};
+
+} // namespace gateway
+
+#endif
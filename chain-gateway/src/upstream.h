@@ -0,0 +1,38 @@
+/**
+ * upstream.h - Requests the gateway sends to the real APIs
+ *
+ * The gateway core only talks to this interface. curl_upstream.cpp
+ * implements it with libcurl; the fleet benchmark uses a stub that counts
+ * requests instead of going to the network.
+ */
+
+#ifndef GATEWAY_UPSTREAM_H
+#define GATEWAY_UPSTREAM_H
+
+#include <string>
+#include <vector>
+
+namespace gateway {
+
+struct UpstreamRequest {
+  std::string method; // "GET" or "POST"
+  std::string url;
+  std::string body;
+  std::vector<std::string> headers; // "Name: value"
+};
+
+struct UpstreamResponse {
+  int status = 0; // 0 = no response (connection error, timeout)
+  std::string contentType;
+  std::string body;
+};
+
+class Upstream {
+public:
+  virtual ~Upstream() {}
+  virtual UpstreamResponse fetch(const UpstreamRequest &request) = 0;
+};
+
+} // namespace gateway
+
+#endif
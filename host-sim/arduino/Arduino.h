@@ -0,0 +1,76 @@
+/**
+ * Arduino.h - Minimal ESP32 Arduino core for host builds
+ *
+ * Provides the timing functions, Serial and basic types the workshop
+ * firmware uses. Time comes from the simulated clock in hostsim.h.
+ */
+
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "IPAddress.h"
+#include "Print.h"
+#include "Stream.h"
+#include "WString.h"
+
+#define HOST_SIM 1
+
+#define PROGMEM
+#define PGM_P const char *
+#define F(text) (text)
+
+using std::max;
+using std::min;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+class HardwareSerial : public Stream {
+public:
+  void begin(unsigned long baud) { (void)baud; }
+  void end() {}
+  operator bool() const { return true; }
+
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t *buffer, size_t size) override;
+  using Print::write;
+  int availableForWrite() override;
+
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+};
+
+extern HardwareSerial Serial;
+
+// ESP object (chip information and heap statistics)
+class EspClass {
+public:
+  uint32_t getFreeHeap();
+  uint32_t getHeapSize();
+  uint32_t getMaxAllocHeap();
+  uint32_t getMinFreeHeap();
+  uint32_t getCycleCount();
+  uint32_t getCpuFreqMHz() { return 240; }
+  void restart();
+};
+
+extern EspClass ESP;
+
+#endif
@@ -0,0 +1,262 @@
+/**
+ * FS.cpp - Host implementation of File, FS and LittleFS
+ */
+
+#include "LittleFS.h"
+#include "hostsim.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+namespace stdfs = std::filesystem;
+
+namespace {
+// Size of the LittleFS partition reported by totalBytes() (default ESP32
+// partition table)
+const size_t PARTITION_SIZE = 1408 * 1024;
+
+std::string fsRoot = "littlefs";
+hostsim::FsStats stats;
+
+std::string hostPath(const char *path) {
+  std::string relative = path ? path : "";
+  while (!relative.empty() && relative[0] == '/') {
+    relative.erase(0, 1);
+  }
+  return (stdfs::path(fsRoot) / relative).string();
+}
+} // namespace
+
+namespace hostsim {
+void setFsRoot(const std::string &directory) { fsRoot = directory; }
+FsStats fsStats() { return stats; }
+void resetFsStats() { stats = FsStats(); }
+} // namespace hostsim
+
+fs::LittleFSFS LittleFS;
+
+namespace fs {
+
+class FileImpl {
+public:
+  std::string path; // Path as the firmware sees it, e.g. "/index.html"
+  std::string name; // Last path component
+  FILE *handle = nullptr;
+  bool directory = false;
+  std::vector<std::string> entries; // Directory listing
+  size_t nextEntry = 0;
+
+  ~FileImpl() {
+    if (handle) {
+      fclose(handle);
+    }
+  }
+};
+
+size_t File::write(const uint8_t *buffer, size_t size) {
+  if (!impl_ || !impl_->handle) {
+    return 0;
+  }
+  size_t written = fwrite(buffer, 1, size, impl_->handle);
+  stats.bytesWritten += written;
+  return written;
+}
+
+int File::available() {
+  if (!impl_ || !impl_->handle) {
+    return 0;
+  }
+  return (int)(size() - position());
+}
+
+int File::read() {
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+int File::peek() {
+  if (!impl_ || !impl_->handle) {
+    return -1;
+  }
+  int c = fgetc(impl_->handle);
+  if (c != EOF) {
+    ungetc(c, impl_->handle);
+  }
+  return c == EOF ? -1 : c;
+}
+
+size_t File::read(uint8_t *buffer, size_t size) {
+  if (!impl_ || !impl_->handle) {
+    return 0;
+  }
+  size_t count = fread(buffer, 1, size, impl_->handle);
+  stats.bytesRead += count;
+  return count;
+}
+
+void File::flush() {
+  if (impl_ && impl_->handle) {
+    fflush(impl_->handle);
+  }
+}
+
+bool File::seek(uint32_t position, SeekMode mode) {
+  if (!impl_ || !impl_->handle) {
+    return false;
+  }
+  int whence = mode == SeekCur ? SEEK_CUR : mode == SeekEnd ? SEEK_END
+                                                              : SEEK_SET;
+  return fseek(impl_->handle, position, whence) == 0;
+}
+
+size_t File::position() const {
+  if (!impl_ || !impl_->handle) {
+    return 0;
+  }
+  long position = ftell(impl_->handle);
+  return position < 0 ? 0 : (size_t)position;
+}
+
+size_t File::size() const {
+  if (!impl_ || !impl_->handle) {
+    return 0;
+  }
+  long current = ftell(impl_->handle);
+  fseek(impl_->handle, 0, SEEK_END);
+  long end = ftell(impl_->handle);
+  fseek(impl_->handle, current, SEEK_SET);
+  return end < 0 ? 0 : (size_t)end;
+}
+
+void File::close() { impl_.reset(); }
+
+File::operator bool() const { return impl_ != nullptr; }
+
+const char *File::path() const { return impl_ ? impl_->path.c_str() : ""; }
+
+const char *File::name() const { return impl_ ? impl_->name.c_str() : ""; }
+
+bool File::isDirectory() const { return impl_ && impl_->directory; }
+
+File File::openNextFile(const char *mode) {
+  if (!impl_ || !impl_->directory ||
+      impl_->nextEntry >= impl_->entries.size()) {
+    return File();
+  }
+  std::string child = impl_->path;
+  if (child.empty() || child.back() != '/') {
+    child += '/';
+  }
+  child += impl_->entries[impl_->nextEntry++];
+  return LittleFS.open(child.c_str(), mode);
+}
+
+void File::rewindDirectory() {
+  if (impl_) {
+    impl_->nextEntry = 0;
+  }
+}
+
+File FS::open(const char *path, const char *mode, bool create) {
+  (void)create;
+  if (!mounted_ || !path) {
+    return File();
+  }
+  stats.opens++;
+
+  std::string host = hostPath(path);
+  auto impl = std::make_shared<FileImpl>();
+  impl->path = path;
+  impl->name = stdfs::path(impl->path).filename().string();
+
+  std::error_code error;
+  if (stdfs::is_directory(host, error)) {
+    impl->directory = true;
+    for (const auto &entry : stdfs::directory_iterator(host, error)) {
+      impl->entries.push_back(entry.path().filename().string());
+    }
+    std::sort(impl->entries.begin(), impl->entries.end());
+    return File(impl);
+  }
+
+  std::string hostMode = mode ? mode : "r";
+  if (hostMode.find('b') == std::string::npos) {
+    hostMode += 'b';
+  }
+  if (hostMode[0] != 'r') {
+    // LittleFS creates missing parent directories when writing
+    stdfs::create_directories(stdfs::path(host).parent_path(), error);
+  }
+  impl->handle = fopen(host.c_str(), hostMode.c_str());
+  if (!impl->handle) {
+    return File();
+  }
+  return File(impl);
+}
+
+bool FS::exists(const char *path) {
+  stats.existsCalls++;
+  std::error_code error;
+  return mounted_ && stdfs::exists(hostPath(path), error);
+}
+
+bool FS::remove(const char *path) {
+  std::error_code error;
+  return mounted_ && stdfs::is_regular_file(hostPath(path), error) &&
+         stdfs::remove(hostPath(path), error);
+}
+
+bool FS::rename(const char *from, const char *to) {
+  std::error_code error;
+  stdfs::rename(hostPath(from), hostPath(to), error);
+  return mounted_ && !error;
+}
+
+bool FS::mkdir(const char *path) {
+  std::error_code error;
+  stdfs::create_directories(hostPath(path), error);
+  return mounted_ && !error;
+}
+
+bool FS::rmdir(const char *path) {
+  std::error_code error;
+  return mounted_ && stdfs::remove(hostPath(path), error);
+}
+
+bool LittleFSFS::begin(bool formatOnFail, const char *basePath,
+                       uint8_t maxOpenFiles, const char *partitionLabel) {
+  (void)formatOnFail;
+  (void)basePath;
+  (void)maxOpenFiles;
+  (void)partitionLabel;
+  std::error_code error;
+  stdfs::create_directories(fsRoot, error);
+  mounted_ = stdfs::is_directory(fsRoot, error);
+  return mounted_;
+}
+
+bool LittleFSFS::format() {
+  std::error_code error;
+  stdfs::remove_all(fsRoot, error);
+  stdfs::create_directories(fsRoot, error);
+  return !error;
+}
+
+size_t LittleFSFS::totalBytes() { return PARTITION_SIZE; }
+
+size_t LittleFSFS::usedBytes() {
+  size_t used = 0;
+  std::error_code error;
+  for (const auto &entry :
+       stdfs::recursive_directory_iterator(fsRoot, error)) {
+    if (entry.is_regular_file(error)) {
+      // LittleFS stores data in 4 KB blocks
+      used += (entry.file_size(error) + 4095) / 4096 * 4096;
+    }
+  }
+  return used;
+}
+
+} // namespace fs
@@ -0,0 +1,90 @@
+/**
+ * FS.h - Arduino File and FS for host builds
+ *
+ * Files live in a directory on the host (see hostsim::setFsRoot()). Every
+ * read, write and open is counted so harnesses can report flash traffic.
+ */
+
+#ifndef FS_H
+#define FS_H
+
+#include "Arduino.h"
+
+#include <memory>
+#include <string>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+namespace fs {
+
+class FileImpl;
+
+class File : public Stream {
+public:
+  File() {}
+  explicit File(std::shared_ptr<FileImpl> impl) : impl_(impl) {}
+
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t *buffer, size_t size) override;
+  using Print::write;
+
+  int available() override;
+  int read() override;
+  int peek() override;
+  size_t read(uint8_t *buffer, size_t size);
+  size_t readBytes(char *buffer, size_t length) override {
+    return read((uint8_t *)buffer, length);
+  }
+  void flush() override;
+
+  bool seek(uint32_t position, SeekMode mode = SeekSet);
+  size_t position() const;
+  size_t size() const;
+  void close();
+  operator bool() const;
+
+  const char *path() const;
+  const char *name() const;
+  bool isDirectory() const;
+  File openNextFile(const char *mode = FILE_READ);
+  void rewindDirectory();
+
+private:
+  std::shared_ptr<FileImpl> impl_;
+};
+
+class FS {
+public:
+  File open(const char *path, const char *mode = FILE_READ,
+            bool create = false);
+  File open(const String &path, const char *mode = FILE_READ,
+            bool create = false) {
+    return open(path.c_str(), mode, create);
+  }
+  bool exists(const char *path);
+  bool exists(const String &path) { return exists(path.c_str()); }
+  bool remove(const char *path);
+  bool remove(const String &path) { return remove(path.c_str()); }
+  bool rename(const char *from, const char *to);
+  bool rename(const String &from, const String &to) {
+    return rename(from.c_str(), to.c_str());
+  }
+  bool mkdir(const char *path);
+  bool mkdir(const String &path) { return mkdir(path.c_str()); }
+  bool rmdir(const char *path);
+  bool rmdir(const String &path) { return rmdir(path.c_str()); }
+
+protected:
+  bool mounted_ = false;
+};
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
+
+#endif
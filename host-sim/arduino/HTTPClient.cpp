@@ -0,0 +1,178 @@
+/**
+ * HTTPClient.cpp - Host implementation of the ESP32 HTTPClient
+ */
+
+#include "HTTPClient.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <strings.h>
+
+namespace {
+hostsim::HttpHandler httpHandler;
+hostsim::HttpStats stats;
+uint32_t lossState = 12345; // Which requests a lossy link drops
+
+// Record buffers mbedTLS takes from the heap for an https connection, until
+// end() (CONFIG_MBEDTLS_SSL_IN_CONTENT_LEN and OUT_CONTENT_LEN of the ESP32
+// Arduino core)
+const size_t TLS_IN_BUFFER = 16384;
+const size_t TLS_OUT_BUFFER = 4096;
+
+// Does the link drop this request? Deterministic, so runs can be compared
+bool dropped(uint32_t failurePercent) {
+  lossState = lossState * 1103515245u + 12345u;
+  return (lossState >> 16) % 100 < failurePercent;
+}
+} // namespace
+
+namespace hostsim {
+void setHttpHandler(HttpHandler handler) { httpHandler = handler; }
+HttpStats httpStats() { return stats; }
+} // namespace hostsim
+
+bool HTTPClient::begin(const String &url) {
+  hostsim::HeapModelPause pause;
+  request_ = hostsim::HttpRequest();
+  request_.url = url.str();
+  response_ = hostsim::HttpResponse();
+  return true;
+}
+
+void HTTPClient::end() {
+  free(tlsBuffers_[0]);
+  free(tlsBuffers_[1]);
+  tlsBuffers_[0] = tlsBuffers_[1] = nullptr;
+  hostsim::HeapModelPause pause;
+  request_ = hostsim::HttpRequest();
+  stream_ = WiFiClient();
+}
+
+void HTTPClient::addHeader(const String &name, const String &value) {
+  hostsim::HeapModelPause pause;
+  request_.headers[name.str()] = value.str();
+}
+
+void HTTPClient::collectHeaders(const char *headerKeys[], size_t count) {
+  collectedHeaders_.assign(headerKeys, headerKeys + count);
+}
+
+String HTTPClient::header(const char *name) {
+  for (const std::string &key : collectedHeaders_) {
+    if (strcasecmp(key.c_str(), name) != 0) {
+      continue;
+    }
+    for (const auto &entry : response_.headers) {
+      if (strcasecmp(entry.first.c_str(), name) == 0) {
+        return String(entry.second);
+      }
+    }
+  }
+  return String("");
+}
+
+int HTTPClient::GET() { return sendRequest("GET"); }
+
+int HTTPClient::POST(const String &payload) {
+  return sendRequest("POST", payload);
+}
+
+int HTTPClient::sendRequest(const char *method, const String &payload) {
+  // Connecting over TLS takes its buffers from the heap until end()
+  if (request_.url.compare(0, 8, "https://") == 0 &&
+      tlsBuffers_[0] == nullptr && WiFi.isConnected()) {
+    tlsBuffers_[0] = malloc(TLS_IN_BUFFER);
+    tlsBuffers_[1] = malloc(TLS_OUT_BUFFER);
+  }
+
+  // The response is in the network stack's buffers on the board, only what
+  // the firmware copies out of it counts for the heap model
+  hostsim::HeapModelPause pause;
+  request_.method = method;
+  request_.body = payload.str();
+  stats.requests++;
+
+  const hostsim::WiFiAccessPoint *link = hostsim::connectedAccessPoint();
+  if (!WiFi.isConnected() || !httpHandler) {
+    response_ = hostsim::HttpResponse();
+    response_.code = HTTPC_ERROR_CONNECTION_REFUSED;
+  } else if (link && dropped(link->failurePercent)) {
+    response_ = hostsim::HttpResponse(); // Never answered
+    response_.latencyMs = timeoutMs_ + 1;
+  } else {
+    response_ = httpHandler(request_);
+    if (link) {
+      response_.latencyMs += link->latencyMs;
+    }
+  }
+
+  // Connecting comes first and has no read timeout (a failed connection
+  // ends here)
+  hostsim::advanceClock(response_.connectMs);
+
+  // A response slower than the client timeout is a read timeout, and the
+  // firmware is blocked for the whole timeout
+  if (response_.latencyMs > timeoutMs_) {
+    hostsim::advanceClock(timeoutMs_);
+    response_ = hostsim::HttpResponse();
+    response_.code = HTTPC_ERROR_READ_TIMEOUT;
+  } else {
+    hostsim::advanceClock(response_.latencyMs);
+  }
+
+  // A body that trickles in: the timeout is per wait for the next byte, so
+  // the firmware waits for all of it unless a byte takes longer than that
+  if (response_.code > 0 && response_.bytesPerSecond > 0 &&
+      !response_.body.empty()) {
+    if (1000 / response_.bytesPerSecond > timeoutMs_) {
+      hostsim::advanceClock(timeoutMs_);
+      response_ = hostsim::HttpResponse();
+      response_.code = HTTPC_ERROR_READ_TIMEOUT;
+    } else {
+      hostsim::advanceClock((uint64_t)response_.body.size() * 1000 /
+                            response_.bytesPerSecond);
+    }
+  }
+
+  if (response_.code < 0) {
+    stats.failures++;
+    response_.body.clear();
+  }
+  stats.bytesReceived += response_.body.size();
+
+  auto connection = std::make_shared<WiFiClient::Connection>();
+  connection->received = response_.body;
+  stream_ = WiFiClient(connection);
+  return response_.code;
+}
+
+// Like the ESP32, the body is handed over in pieces of one TCP buffer, so
+// streaming parsers see the same chunk boundaries
+int HTTPClient::writeToStream(Stream *stream) {
+  if (!stream) {
+    return HTTPC_ERROR_NO_STREAM;
+  }
+  const size_t chunkSize = 1436; // HTTP_TCP_BUFFER_SIZE
+  const std::string &body = response_.body;
+  for (size_t offset = 0; offset < body.size(); offset += chunkSize) {
+    size_t length = std::min(chunkSize, body.size() - offset);
+    if (stream->write((const uint8_t *)body.data() + offset, length) !=
+        length) {
+      return HTTPC_ERROR_STREAM_WRITE;
+    }
+  }
+  return (int)body.size();
+}
+
+String HTTPClient::errorToString(int error) {
+  switch (error) {
+  case HTTPC_ERROR_CONNECTION_REFUSED:
+    return String("connection refused");
+  case HTTPC_ERROR_CONNECTION_LOST:
+    return String("connection lost");
+  case HTTPC_ERROR_READ_TIMEOUT:
+    return String("read Timeout");
+  default:
+    return String("");
+  }
+}
@@ -0,0 +1,82 @@
+/**
+ * HTTPClient.h - ESP32 HTTPClient for host builds
+ *
+ * Requests are answered by the handler installed with
+ * hostsim::setHttpHandler(), which plays the role of the remote API
+ * (Koios, CoinGecko, ...). The handler's latency is added to the clock,
+ * and so are the time to connect and the time a slow body takes to arrive
+ * (hostsim::HttpResponse).
+ */
+
+#ifndef HTTPCLIENT_H
+#define HTTPCLIENT_H
+
+#include "Arduino.h"
+#include "WiFi.h"
+#include "hostsim.h"
+
+#include <map>
+#include <vector>
+#include <string>
+
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED (-2)
+#define HTTPC_ERROR_SEND_PAYLOAD_FAILED (-3)
+#define HTTPC_ERROR_NOT_CONNECTED (-4)
+#define HTTPC_ERROR_CONNECTION_LOST (-5)
+#define HTTPC_ERROR_NO_STREAM (-6)
+#define HTTPC_ERROR_NO_HTTP_SERVER (-7)
+#define HTTPC_ERROR_TOO_LESS_RAM (-8)
+#define HTTPC_ERROR_ENCODING (-9)
+#define HTTPC_ERROR_STREAM_WRITE (-10)
+#define HTTPC_ERROR_READ_TIMEOUT (-11)
+
+#define HTTP_CODE_OK 200
+#define HTTP_CODE_TOO_MANY_REQUESTS 429
+
+class HTTPClient {
+public:
+  HTTPClient() = default;
+  ~HTTPClient() { end(); }
+  HTTPClient(const HTTPClient &) = delete;
+  HTTPClient &operator=(const HTTPClient &) = delete;
+
+  bool begin(const String &url);
+  bool begin(WiFiClient &client, const String &url) {
+    (void)client;
+    return begin(url);
+  }
+  void end();
+
+  void addHeader(const String &name, const String &value);
+  void setTimeout(uint16_t timeoutMs) { timeoutMs_ = timeoutMs; }
+  void setConnectTimeout(int32_t timeoutMs) { (void)timeoutMs; }
+  void setReuse(bool reuse) { (void)reuse; }
+  void collectHeaders(const char *headerKeys[], size_t count);
+  String header(const char *name);
+
+  int GET();
+  int POST(const String &payload);
+  int POST(const uint8_t *payload, size_t size) {
+    return POST(String((const char *)payload, size));
+  }
+  int sendRequest(const char *method, const String &payload = String(""));
+
+  int getSize() const { return (int)response_.body.size(); }
+  String getString() { return String(response_.body); }
+  WiFiClient *getStreamPtr() { return &stream_; }
+  WiFiClient &getStream() { return stream_; }
+  int writeToStream(Stream *stream);
+
+  static String errorToString(int error);
+
+private:
+  hostsim::HttpRequest request_;
+  hostsim::HttpResponse response_;
+  std::vector<std::string> collectedHeaders_;
+  uint16_t timeoutMs_ = 5000;
+  WiFiClient stream_;
+  void *tlsBuffers_[2] = {nullptr, nullptr}; // mbedTLS in and out, https
+};
+
+#endif
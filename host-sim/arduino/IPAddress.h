@@ -0,0 +1,44 @@
+/**
+ * IPAddress.h - IPv4 address for host builds
+ */
+
+#ifndef IPADDRESS_H
+#define IPADDRESS_H
+
+#include "Print.h"
+#include <cstdint>
+
+class IPAddress : public Printable {
+public:
+  IPAddress() : IPAddress(0, 0, 0, 0) {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+    bytes_[0] = a;
+    bytes_[1] = b;
+    bytes_[2] = c;
+    bytes_[3] = d;
+  }
+  explicit IPAddress(uint32_t address) {
+    for (int i = 0; i < 4; i++) {
+      bytes_[i] = (uint8_t)(address >> (8 * i));
+    }
+  }
+
+  operator uint32_t() const {
+    return (uint32_t)bytes_[0] | (uint32_t)bytes_[1] << 8 |
+           (uint32_t)bytes_[2] << 16 | (uint32_t)bytes_[3] << 24;
+  }
+  uint8_t operator[](int index) const { return bytes_[index]; }
+  uint8_t &operator[](int index) { return bytes_[index]; }
+  bool operator==(const IPAddress &other) const {
+    return (uint32_t)*this == (uint32_t)other;
+  }
+
+  bool fromString(const char *text);
+  String toString() const;
+  size_t printTo(Print &p) const override { return p.print(toString()); }
+
+private:
+  uint8_t bytes_[4];
+};
+
+#endif
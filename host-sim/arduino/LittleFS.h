@@ -0,0 +1,26 @@
+/**
+ * LittleFS.h - LittleFS for host builds (backed by a host directory)
+ */
+
+#ifndef LITTLEFS_H
+#define LITTLEFS_H
+
+#include "FS.h"
+
+namespace fs {
+
+class LittleFSFS : public FS {
+public:
+  bool begin(bool formatOnFail = false, const char *basePath = "/littlefs",
+             uint8_t maxOpenFiles = 10, const char *partitionLabel = "spiffs");
+  void end() { mounted_ = false; }
+  bool format();
+  size_t totalBytes();
+  size_t usedBytes();
+};
+
+} // namespace fs
+
+extern fs::LittleFSFS LittleFS;
+
+#endif
@@ -0,0 +1,154 @@
+/**
+ * Preferences.cpp - Host NVS: namespaces of key-value pairs in memory
+ */
+
+#include "Preferences.h"
+
+#include <cstring>
+#include <map>
+
+namespace {
+// Namespace -> key -> value bytes. Values are stored as bytes whatever
+// their type, which is enough for the get...() calls matching the put...().
+std::map<std::string, std::map<std::string, std::string>> storage;
+hostsim::NvsStats stats;
+} // namespace
+
+namespace hostsim {
+NvsStats nvsStats() { return stats; }
+
+void clearNvs() {
+  storage.clear();
+  stats = NvsStats();
+}
+} // namespace hostsim
+
+bool Preferences::begin(const char *name, bool readOnly,
+                        const char *partitionLabel) {
+  (void)partitionLabel;
+  // NVS namespace names are limited to 15 characters
+  if (open_ || name == nullptr || strlen(name) > 15) {
+    return false;
+  }
+  open_ = true;
+  readOnly_ = readOnly;
+  name_ = name;
+  return true;
+}
+
+void Preferences::end() { open_ = false; }
+
+bool Preferences::clear() {
+  if (!open_ || readOnly_) {
+    return false;
+  }
+  storage.erase(name_);
+  return true;
+}
+
+bool Preferences::remove(const char *key) {
+  if (!open_ || readOnly_) {
+    return false;
+  }
+  return storage[name_].erase(key) > 0;
+}
+
+bool Preferences::isKey(const char *key) {
+  std::string value;
+  return get(key, value);
+}
+
+bool Preferences::put(const char *key, const std::string &value) {
+  hostsim::HeapModelPause pause; // NVS is flash on the board
+  if (!open_ || readOnly_ || key == nullptr || strlen(key) > 15) {
+    return false;
+  }
+  std::string &stored = storage[name_][key];
+  // The real NVS does not write an unchanged value either
+  if (stored != value) {
+    stored = value;
+    stats.writes++;
+    stats.bytesWritten += value.size();
+  }
+  return true;
+}
+
+bool Preferences::get(const char *key, std::string &value) {
+  if (!open_ || key == nullptr) {
+    return false;
+  }
+  auto space = storage.find(name_);
+  if (space == storage.end()) {
+    return false;
+  }
+  auto entry = space->second.find(key);
+  if (entry == space->second.end()) {
+    return false;
+  }
+  value = entry->second;
+  return true;
+}
+
+size_t Preferences::putUChar(const char *key, uint8_t value) {
+  return put(key, std::string((const char *)&value, 1)) ? 1 : 0;
+}
+
+size_t Preferences::putUInt(const char *key, uint32_t value) {
+  return put(key, std::string((const char *)&value, 4)) ? 4 : 0;
+}
+
+size_t Preferences::putFloat(const char *key, float value) {
+  return put(key, std::string((const char *)&value, sizeof(value)))
+             ? sizeof(value)
+             : 0;
+}
+
+size_t Preferences::putBytes(const char *key, const void *value,
+                             size_t length) {
+  if (value == nullptr || length == 0) {
+    return 0;
+  }
+  return put(key, std::string((const char *)value, length)) ? length : 0;
+}
+
+uint8_t Preferences::getUChar(const char *key, uint8_t defaultValue) {
+  std::string value;
+  return get(key, value) && value.size() == 1 ? (uint8_t)value[0]
+                                              : defaultValue;
+}
+
+uint32_t Preferences::getUInt(const char *key, uint32_t defaultValue) {
+  std::string value;
+  if (!get(key, value) || value.size() != 4) {
+    return defaultValue;
+  }
+  uint32_t result;
+  memcpy(&result, value.data(), 4);
+  return result;
+}
+
+float Preferences::getFloat(const char *key, float defaultValue) {
+  std::string value;
+  if (!get(key, value) || value.size() != sizeof(float)) {
+    return defaultValue;
+  }
+  float result;
+  memcpy(&result, value.data(), sizeof(result));
+  return result;
+}
+
+size_t Preferences::getBytesLength(const char *key) {
+  std::string value;
+  return get(key, value) ? value.size() : 0;
+}
+
+size_t Preferences::getBytes(const char *key, void *buffer,
+                             size_t maxLength) {
+  std::string value;
+  // Like the ESP32, a value larger than the buffer is not read at all
+  if (buffer == nullptr || !get(key, value) || value.size() > maxLength) {
+    return 0;
+  }
+  memcpy(buffer, value.data(), value.size());
+  return value.size();
+}
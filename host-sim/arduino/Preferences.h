@@ -0,0 +1,49 @@
+/**
+ * Preferences.h - ESP32 Preferences (NVS key-value storage) for host builds
+ *
+ * Namespaces live in memory for as long as the harness runs, so they
+ * survive simulated reboots like NVS survives power cycles.
+ * hostsim::clearNvs() erases them, hostsim::nvsStats() counts the writes.
+ */
+
+#ifndef PREFERENCES_H
+#define PREFERENCES_H
+
+#include "Arduino.h"
+#include "hostsim.h"
+
+#include <string>
+
+class Preferences {
+public:
+  ~Preferences() { end(); }
+
+  bool begin(const char *name, bool readOnly = false,
+             const char *partitionLabel = nullptr);
+  void end();
+
+  bool clear();
+  bool remove(const char *key);
+  bool isKey(const char *key);
+
+  size_t putUChar(const char *key, uint8_t value);
+  size_t putUInt(const char *key, uint32_t value);
+  size_t putFloat(const char *key, float value);
+  size_t putBytes(const char *key, const void *value, size_t length);
+
+  uint8_t getUChar(const char *key, uint8_t defaultValue = 0);
+  uint32_t getUInt(const char *key, uint32_t defaultValue = 0);
+  float getFloat(const char *key, float defaultValue = 0.0f);
+  size_t getBytesLength(const char *key);
+  size_t getBytes(const char *key, void *buffer, size_t maxLength);
+
+private:
+  bool put(const char *key, const std::string &value);
+  bool get(const char *key, std::string &value);
+
+  bool open_ = false;
+  bool readOnly_ = false;
+  std::string name_;
+};
+
+#endif
@@ -0,0 +1,290 @@
+/**
+ * PubSubClient.cpp - Host PubSubClient and the in-process MQTT broker
+ */
+
+#include "PubSubClient.h"
+
+#include <cstring>
+#include <deque>
+#include <map>
+#include <vector>
+
+namespace hostsim {
+
+struct MqttMessage {
+  std::string topic;
+  std::string payload;
+};
+
+struct MqttSession {
+  std::string id;
+  bool open = true;
+  uint64_t keepAliveUs = 0;
+  uint64_t lastSeenUs = 0;
+  bool hasWill = false;
+  MqttMessage will;
+  bool willRetain = false;
+  std::vector<std::string> filters;
+  std::deque<MqttMessage> inbox; // Delivered by loop()
+};
+
+} // namespace hostsim
+
+namespace {
+bool brokerUp = true;
+std::vector<std::shared_ptr<hostsim::MqttSession>> sessions;
+std::map<std::string, std::string> retained;
+hostsim::MqttStats stats;
+
+// MQTT topic filter matching: + is one level, # is the rest
+bool topicMatches(const std::string &filter, const std::string &topic) {
+  size_t f = 0;
+  size_t t = 0;
+  while (f < filter.size()) {
+    if (filter[f] == '#') {
+      return true;
+    }
+    if (filter[f] == '+') {
+      while (t < topic.size() && topic[t] != '/') {
+        t++;
+      }
+      f++;
+    } else {
+      if (t >= topic.size() || filter[f] != topic[t]) {
+        return false;
+      }
+      f++;
+      t++;
+    }
+  }
+  return t == topic.size();
+}
+
+void deliver(hostsim::MqttSession &session, const std::string &topic,
+             const std::string &payload) {
+  for (const std::string &filter : session.filters) {
+    if (topicMatches(filter, topic)) {
+      session.inbox.push_back({topic, payload});
+      stats.messagesDelivered++;
+      stats.bytesDelivered += payload.size();
+      return; // Once per client, even if several filters match
+    }
+  }
+}
+
+void route(const std::string &topic, const std::string &payload,
+           bool retain) {
+  if (retain) {
+    // An empty retained message deletes the retained one
+    if (payload.empty()) {
+      retained.erase(topic);
+    } else {
+      retained[topic] = payload;
+    }
+  }
+  for (const auto &session : sessions) {
+    if (session->open) {
+      deliver(*session, topic, payload);
+    }
+  }
+}
+
+void closeSession(hostsim::MqttSession &session, bool publishWill) {
+  session.open = false;
+  session.inbox.clear();
+  if (publishWill && session.hasWill) {
+    stats.willsPublished++;
+    route(session.will.topic, session.will.payload, session.willRetain);
+  }
+}
+
+// Drop clients whose keep-alive ran out, publishing their last wills
+void expireSessions() {
+  uint64_t now = hostsim::clockMicros();
+  bool expired = false;
+  for (const auto &session : sessions) {
+    if (session->open && session->keepAliveUs > 0 &&
+        now - session->lastSeenUs > session->keepAliveUs * 3 / 2) {
+      closeSession(*session, true);
+      expired = true;
+    }
+  }
+  if (!expired) {
+    return;
+  }
+  std::vector<std::shared_ptr<hostsim::MqttSession>> open;
+  for (const auto &session : sessions) {
+    if (session->open) {
+      open.push_back(session);
+    }
+  }
+  sessions.swap(open);
+}
+} // namespace
+
+namespace hostsim {
+void setMqttBrokerUp(bool up) {
+  brokerUp = up;
+  if (!up) {
+    for (const auto &session : sessions) {
+      closeSession(*session, false);
+    }
+    sessions.clear();
+  }
+}
+
+MqttStats mqttStats() { return stats; }
+
+void resetMqttBroker() {
+  for (const auto &session : sessions) {
+    session->open = false;
+  }
+  sessions.clear();
+  retained.clear();
+  stats = MqttStats();
+  brokerUp = true;
+}
+} // namespace hostsim
+
+PubSubClient::~PubSubClient() {
+  if (session_) {
+    session_->open = false;
+  }
+}
+
+PubSubClient &PubSubClient::setServer(const char *domain, uint16_t port) {
+  (void)domain;
+  (void)port;
+  return *this;
+}
+
+bool PubSubClient::connect(const char *id, const char *willTopic,
+                           uint8_t willQos, bool willRetain,
+                           const char *willMessage) {
+  (void)willQos;
+  expireSessions();
+  if (session_ && session_->open) {
+    return true;
+  }
+  if (!brokerUp) {
+    state_ = MQTT_CONNECT_FAILED;
+    return false;
+  }
+  // A second client with the same id takes over, the first one is dropped
+  for (const auto &session : sessions) {
+    if (session->open && session->id == id) {
+      closeSession(*session, true);
+    }
+  }
+  session_ = std::make_shared<hostsim::MqttSession>();
+  session_->id = id;
+  session_->keepAliveUs = keepAliveSeconds_ * 1000000ULL;
+  session_->lastSeenUs = hostsim::clockMicros();
+  if (willTopic != nullptr) {
+    session_->hasWill = true;
+    session_->will = {willTopic, willMessage ? willMessage : ""};
+    session_->willRetain = willRetain;
+  }
+  sessions.push_back(session_);
+  stats.connects++;
+  state_ = MQTT_CONNECTED;
+  return true;
+}
+
+void PubSubClient::disconnect() {
+  // Without WiFi the DISCONNECT packet never arrives: the broker keeps the
+  // session until its keep-alive runs out, then publishes the last will
+  if (session_ && session_->open && WiFi.status() == WL_CONNECTED) {
+    closeSession(*session_, false); // A clean disconnect sends no last will
+  }
+  session_.reset();
+  state_ = MQTT_DISCONNECTED;
+}
+
+bool PubSubClient::connected() {
+  expireSessions();
+  if (session_ && !session_->open) {
+    session_.reset();
+    state_ = MQTT_CONNECTION_TIMEOUT;
+  }
+  return session_ != nullptr;
+}
+
+int PubSubClient::state() { return state_; }
+
+bool PubSubClient::fits(const char *topic, size_t length) const {
+  // Fixed header (up to 5 bytes), topic length (2), topic, payload
+  return 5 + 2 + strlen(topic) + length <= bufferSize_;
+}
+
+bool PubSubClient::publish(const char *topic, const char *payload,
+                           bool retained) {
+  return publish(topic, (const uint8_t *)payload,
+                 payload ? strlen(payload) : 0, retained);
+}
+
+bool PubSubClient::publish(const char *topic, const uint8_t *payload,
+                           unsigned int length, bool retain) {
+  if (!connected() || !fits(topic, length)) {
+    return false;
+  }
+  session_->lastSeenUs = hostsim::clockMicros();
+  stats.publishes++;
+  stats.bytesPublished += length;
+  route(topic, std::string((const char *)payload, payload ? length : 0),
+        retain);
+  return true;
+}
+
+bool PubSubClient::subscribe(const char *topic, uint8_t qos) {
+  (void)qos;
+  if (!connected()) {
+    return false;
+  }
+  session_->lastSeenUs = hostsim::clockMicros();
+  session_->filters.push_back(topic);
+  // Retained messages go to new subscribers
+  for (const auto &entry : retained) {
+    if (topicMatches(topic, entry.first)) {
+      session_->inbox.push_back({entry.first, entry.second});
+      stats.messagesDelivered++;
+      stats.bytesDelivered += entry.second.size();
+    }
+  }
+  return true;
+}
+
+bool PubSubClient::unsubscribe(const char *topic) {
+  if (!connected()) {
+    return false;
+  }
+  std::vector<std::string> &filters = session_->filters;
+  for (size_t i = 0; i < filters.size(); i++) {
+    if (filters[i] == topic) {
+      filters.erase(filters.begin() + i);
+      break;
+    }
+  }
+  return true;
+}
+
+bool PubSubClient::loop() {
+  if (!connected()) {
+    return false;
+  }
+  session_->lastSeenUs = hostsim::clockMicros(); // Keep-alive ping
+  // The callback may publish, which can add to this inbox
+  while (session_ && !session_->inbox.empty()) {
+    hostsim::MqttMessage message = session_->inbox.front();
+    session_->inbox.pop_front();
+    if (!callback_ || !fits(message.topic.c_str(), message.payload.size())) {
+      continue; // Too large for the buffer: the real library drops it too
+    }
+    std::vector<char> topic(message.topic.begin(), message.topic.end());
+    topic.push_back('\0');
+    std::vector<uint8_t> payload(message.payload.begin(),
+                                 message.payload.end());
+    callback_(topic.data(), payload.data(), (unsigned int)payload.size());
+  }
+  return true;
+}
@@ -0,0 +1,85 @@
+/**
+ * PubSubClient.h - PubSubClient (MQTT client library) for host builds
+ *
+ * Same interface as the Arduino library by Nick O'Leary, connected to the
+ * in-process broker described in hostsim.h instead of a network broker.
+ * Messages are delivered by loop(), as with the real library. Like it,
+ * messages larger than the buffer (setBufferSize(), default 256 bytes
+ * including topic and header) are not sent or received.
+ */
+
+#ifndef PUBSUBCLIENT_H
+#define PUBSUBCLIENT_H
+
+#include "Arduino.h"
+#include "WiFi.h"
+#include "hostsim.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#define MQTT_CONNECTION_TIMEOUT (-4)
+#define MQTT_CONNECTION_LOST (-3)
+#define MQTT_CONNECT_FAILED (-2)
+#define MQTT_DISCONNECTED (-1)
+#define MQTT_CONNECTED 0
+
+#define MQTT_MAX_PACKET_SIZE 256
+#define MQTT_KEEPALIVE 15
+
+namespace hostsim {
+struct MqttSession;
+}
+
+class PubSubClient {
+public:
+  typedef std::function<void(char *, uint8_t *, unsigned int)> Callback;
+
+  PubSubClient() {}
+  explicit PubSubClient(WiFiClient &client) { (void)client; }
+  ~PubSubClient();
+
+  PubSubClient &setServer(const char *domain, uint16_t port);
+  PubSubClient &setCallback(Callback callback) {
+    callback_ = callback;
+    return *this;
+  }
+  PubSubClient &setKeepAlive(uint16_t seconds) {
+    keepAliveSeconds_ = seconds;
+    return *this;
+  }
+  bool setBufferSize(uint16_t size) {
+    bufferSize_ = size;
+    return true;
+  }
+  uint16_t getBufferSize() const { return bufferSize_; }
+
+  bool connect(const char *id) {
+    return connect(id, nullptr, 0, false, nullptr);
+  }
+  bool connect(const char *id, const char *willTopic, uint8_t willQos,
+               bool willRetain, const char *willMessage);
+  void disconnect();
+
+  bool publish(const char *topic, const char *payload, bool retained = false);
+  bool publish(const char *topic, const uint8_t *payload, unsigned int length,
+               bool retained = false);
+  bool subscribe(const char *topic, uint8_t qos = 0);
+  bool unsubscribe(const char *topic);
+
+  bool loop();
+  bool connected();
+  int state();
+
+private:
+  bool fits(const char *topic, size_t length) const;
+
+  Callback callback_;
+  uint16_t bufferSize_ = MQTT_MAX_PACKET_SIZE;
+  uint16_t keepAliveSeconds_ = MQTT_KEEPALIVE;
+  std::shared_ptr<hostsim::MqttSession> session_;
+  int state_ = MQTT_DISCONNECTED;
+};
+
+#endif
@@ -0,0 +1,13 @@
+/**
+ * SPI.h - SPI for host builds
+ *
+ * Only here so sketches that include it compile. The display stand-in
+ * (TFT_eSPI.h) models the time the SPI bus takes by itself.
+ */
+
+#ifndef SPI_H
+#define SPI_H
+
+#include "Arduino.h"
+
+#endif
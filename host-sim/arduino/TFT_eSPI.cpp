@@ -0,0 +1,573 @@
+/**
+ * TFT_eSPI.cpp - Host implementation of TFT_eSPI.h: the framebuffer, font 1,
+ * the SPI bytes of each call and PNG output
+ */
+
+#include "TFT_eSPI.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace {
+// What TFT_eSPI's ILI9341 driver sends: an address window is CASET and
+// RASET with 4 bytes of coordinates each, then RAMWR; then the pixels
+const uint64_t WINDOW_BYTES = 11;
+const uint64_t COORDINATE_BYTES = 5; // CASET or RASET with its coordinates
+const uint64_t RAMWR_BYTES = 1;
+const uint64_t PIXEL_BYTES = 2; // RGB565
+
+// Built-in font 1 (glcdfont.c in TFT_eSPI) from ' ' to '~': 5 columns per
+// character, bit 0 at the top. The 6th column is the gap.
+const uint8_t FONT[95][5] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00},
+    {0x00, 0x07, 0x00, 0x07, 0x00}, {0x14, 0x7F, 0x14, 0x7F, 0x14},
+    {0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62},
+    {0x36, 0x49, 0x56, 0x20, 0x50}, {0x00, 0x08, 0x07, 0x03, 0x00},
+    {0x00, 0x1C, 0x22, 0x41, 0x00}, {0x00, 0x41, 0x22, 0x1C, 0x00},
+    {0x2A, 0x1C, 0x7F, 0x1C, 0x2A}, {0x08, 0x08, 0x3E, 0x08, 0x08},
+    {0x00, 0x80, 0x70, 0x30, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08},
+    {0x00, 0x00, 0x60, 0x60, 0x00}, {0x20, 0x10, 0x08, 0x04, 0x02},
+    {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00},
+    {0x72, 0x49, 0x49, 0x49, 0x46}, {0x21, 0x41, 0x49, 0x4D, 0x33},
+    {0x18, 0x14, 0x12, 0x7F, 0x10}, {0x27, 0x45, 0x45, 0x45, 0x39},
+    {0x3C, 0x4A, 0x49, 0x49, 0x31}, {0x41, 0x21, 0x11, 0x09, 0x07},
+    {0x36, 0x49, 0x49, 0x49, 0x36}, {0x46, 0x49, 0x49, 0x29, 0x1E},
+    {0x00, 0x00, 0x14, 0x00, 0x00}, {0x00, 0x40, 0x34, 0x00, 0x00},
+    {0x00, 0x08, 0x14, 0x22, 0x41}, {0x14, 0x14, 0x14, 0x14, 0x14},
+    {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x59, 0x09, 0x06},
+    {0x3E, 0x41, 0x5D, 0x59, 0x4E}, {0x7C, 0x12, 0x11, 0x12, 0x7C},
+    {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22},
+    {0x7F, 0x41, 0x41, 0x41, 0x3E}, {0x7F, 0x49, 0x49, 0x49, 0x41},
+    {0x7F, 0x09, 0x09, 0x09, 0x01}, {0x3E, 0x41, 0x41, 0x51, 0x73},
+    {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00},
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41},
+    {0x7F, 0x40, 0x40, 0x40, 0x40}, {0x7F, 0x02, 0x1C, 0x02, 0x7F},
+    {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E},
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E},
+    {0x7F, 0x09, 0x19, 0x29, 0x46}, {0x26, 0x49, 0x49, 0x49, 0x32},
+    {0x03, 0x01, 0x7F, 0x01, 0x03}, {0x3F, 0x40, 0x40, 0x40, 0x3F},
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x3F, 0x40, 0x38, 0x40, 0x3F},
+    {0x63, 0x14, 0x08, 0x14, 0x63}, {0x03, 0x04, 0x78, 0x04, 0x03},
+    {0x61, 0x59, 0x49, 0x4D, 0x43}, {0x00, 0x7F, 0x41, 0x41, 0x41},
+    {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x41, 0x7F},
+    {0x04, 0x02, 0x01, 0x02, 0x04}, {0x40, 0x40, 0x40, 0x40, 0x40},
+    {0x00, 0x03, 0x07, 0x08, 0x00}, {0x20, 0x54, 0x54, 0x78, 0x40},
+    {0x7F, 0x28, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x28},
+    {0x38, 0x44, 0x44, 0x28, 0x7F}, {0x38, 0x54, 0x54, 0x54, 0x18},
+    {0x00, 0x08, 0x7E, 0x09, 0x02}, {0x18, 0xA4, 0xA4, 0x9C, 0x78},
+    {0x7F, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7D, 0x40, 0x00},
+    {0x20, 0x40, 0x40, 0x3D, 0x00}, {0x7F, 0x10, 0x28, 0x44, 0x00},
+    {0x00, 0x41, 0x7F, 0x40, 0x00}, {0x7C, 0x04, 0x78, 0x04, 0x78},
+    {0x7C, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38},
+    {0xFC, 0x18, 0x24, 0x24, 0x18}, {0x18, 0x24, 0x24, 0x18, 0xFC},
+    {0x7C, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x24},
+    {0x04, 0x04, 0x3F, 0x44, 0x24}, {0x3C, 0x40, 0x40, 0x20, 0x7C},
+    {0x1C, 0x20, 0x40, 0x20, 0x1C}, {0x3C, 0x40, 0x30, 0x40, 0x3C},
+    {0x44, 0x28, 0x10, 0x28, 0x44}, {0x4C, 0x90, 0x90, 0x90, 0x7C},
+    {0x44, 0x64, 0x54, 0x4C, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00},
+    {0x00, 0x00, 0x77, 0x00, 0x00}, {0x00, 0x41, 0x36, 0x08, 0x00},
+    {0x02, 0x01, 0x02, 0x04, 0x02},
+};
+
+// Any other character (UTF-8 bytes of a token name...) shows as a box
+const uint8_t NO_GLYPH[5] = {0x7F, 0x41, 0x41, 0x41, 0x7F};
+
+const char *const CALL_NAMES[TFT_CALL_COUNT] = {
+    "fill", "line", "pixel", "circle", "text", "push sprite",
+};
+
+uint8_t toRgb332(uint16_t color) {
+  return (uint8_t)(((color >> 8) & 0xE0) | ((color >> 6) & 0x1C) |
+                   ((color >> 3) & 0x03));
+}
+
+uint16_t fromRgb332(uint8_t color) {
+  const uint16_t r = (color >> 5) & 7;
+  const uint16_t g = (color >> 2) & 7;
+  const uint16_t b = color & 3;
+  return (uint16_t)(((r * 31 / 7) << 11) | ((g * 63 / 7) << 5) | (b * 31 / 3));
+}
+
+// CRC-32 as in PNG and zlib
+uint32_t crc32(uint32_t crc, const uint8_t *data, size_t size) {
+  static uint32_t table[256];
+  static bool tableReady = false;
+  if (!tableReady) {
+    for (uint32_t n = 0; n < 256; n++) {
+      uint32_t c = n;
+      for (int k = 0; k < 8; k++) {
+        c = c & 1 ? 0xEDB88320U ^ (c >> 1) : c >> 1;
+      }
+      table[n] = c;
+    }
+    tableReady = true;
+  }
+  crc = ~crc;
+  for (size_t i = 0; i < size; i++) {
+    crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+void appendBigEndian(std::string &out, uint32_t value) {
+  out.push_back((char)(value >> 24));
+  out.push_back((char)(value >> 16));
+  out.push_back((char)(value >> 8));
+  out.push_back((char)value);
+}
+
+void appendChunk(std::string &png, const char *type, const std::string &data) {
+  appendBigEndian(png, (uint32_t)data.size());
+  const std::string typed = type + data;
+  png += typed;
+  appendBigEndian(png, crc32(0, (const uint8_t *)typed.data(), typed.size()));
+}
+} // namespace
+
+TFT_eSPI::CallScope::CallScope(TFT_eSPI &tft, TftCall call) : tft_(tft) {
+  if (tft_.callDepth_++ == 0) {
+    tft_.call_ = call;
+    tft_.stats_.drawCalls++;
+    tft_.stats_.byCall[call].calls++;
+  }
+}
+
+uint8_t *TFT_eSPI::frame() {
+  if (!hostsim::displayDrawing()) {
+    return nullptr;
+  }
+  const size_t size = (size_t)baseWidth_ * baseHeight_;
+  if (frame_.size() != size) {
+    hostsim::HeapModelPause pause; // The display's memory, not the heap
+    frame_.assign(size, TFT_BLACK);
+  }
+  return frame_.empty() ? nullptr : (uint8_t *)frame_.data();
+}
+
+const uint8_t *TFT_eSPI::pixels() const {
+  return frame_.empty() ? nullptr : (const uint8_t *)frame_.data();
+}
+
+uint16_t TFT_eSPI::pixel(int32_t x, int32_t y) const {
+  const uint8_t *data = pixels();
+  if (data == nullptr || x < 0 || y < 0 || x >= width() || y >= height()) {
+    return 0;
+  }
+  const size_t index = (size_t)y * width() + x;
+  return bitsPerPixel() == 16 ? ((const uint16_t *)data)[index]
+                              : fromRgb332(data[index]);
+}
+
+void TFT_eSPI::storePixel(uint8_t *frame, int32_t x, int32_t y,
+                          uint16_t color) {
+  const size_t index = (size_t)y * width() + x;
+  if (bitsPerPixel() == 16) {
+    ((uint16_t *)frame)[index] = color;
+  } else {
+    frame[index] = toRgb332(color);
+  }
+}
+
+bool TFT_eSPI::clip(int32_t &x, int32_t &y, int32_t &w, int32_t &h) const {
+  if (x < 0) {
+    w += x;
+    x = 0;
+  }
+  if (y < 0) {
+    h += y;
+    y = 0;
+  }
+  w = std::min<int32_t>(w, width() - x);
+  h = std::min<int32_t>(h, height() - y);
+  return w > 0 && h > 0;
+}
+
+void TFT_eSPI::setWindow() {
+  if (inRam_) {
+    return;
+  }
+  stats_.windows++;
+  spiSend(WINDOW_BYTES);
+  pixelColumn_ = -1;
+  pixelRow_ = -1;
+}
+
+void TFT_eSPI::spiSend(uint64_t bytes) {
+  stats_.spiBytes += bytes;
+  stats_.byCall[call_].spiBytes += bytes;
+  hostsim::displayBytesSent(bytes);
+}
+
+void TFT_eSPI::pixelsWritten(uint64_t pixels) {
+  stats_.pixelsFilled += pixels;
+  stats_.byCall[call_].pixels += pixels;
+}
+
+void TFT_eSPI::fillPixels(uint8_t *frame, int32_t x, int32_t y, int32_t w,
+                          int32_t h, uint16_t color) {
+  for (int32_t row = y; row < y + h; row++) {
+    const size_t start = (size_t)row * width() + x;
+    if (bitsPerPixel() == 16) {
+      std::fill_n((uint16_t *)frame + start, w, color);
+    } else {
+      memset(frame + start, toRgb332(color), w);
+    }
+  }
+}
+
+void TFT_eSPI::fillArea(int32_t x, int32_t y, int32_t w, int32_t h,
+                        uint16_t color) {
+  uint8_t *data = frame();
+  if (data == nullptr || !clip(x, y, w, h)) {
+    return;
+  }
+  fillPixels(data, x, y, w, h, color);
+  const uint64_t area = (uint64_t)w * h;
+  pixelsWritten(area);
+  if (!inRam_) {
+    setWindow();
+    spiSend(area * PIXEL_BYTES);
+  }
+}
+
+void TFT_eSPI::plotPixel(int32_t x, int32_t y, uint16_t color) {
+  uint8_t *data = frame();
+  if (data == nullptr || x < 0 || y < 0 || x >= width() || y >= height()) {
+    return;
+  }
+  storePixel(data, x, y, color);
+  pixelsWritten(1);
+  if (inRam_) {
+    return;
+  }
+  uint64_t bytes = RAMWR_BYTES + PIXEL_BYTES;
+  if (x != pixelColumn_) {
+    bytes += COORDINATE_BYTES;
+    pixelColumn_ = x;
+  }
+  if (y != pixelRow_) {
+    bytes += COORDINATE_BYTES;
+    pixelRow_ = y;
+  }
+  spiSend(bytes);
+}
+
+void TFT_eSPI::fillRect(int32_t x, int32_t y, int32_t w, int32_t h,
+                        uint32_t color) {
+  CallScope scope(*this, TFT_CALL_FILL);
+  fillArea(x, y, w, h, (uint16_t)color);
+}
+
+void TFT_eSPI::drawRect(int32_t x, int32_t y, int32_t w, int32_t h,
+                        uint32_t color) {
+  CallScope scope(*this, TFT_CALL_LINE);
+  fillArea(x, y, w, 1, (uint16_t)color);
+  fillArea(x, y + h - 1, w, 1, (uint16_t)color);
+  fillArea(x, y + 1, 1, h - 2, (uint16_t)color);
+  fillArea(x + w - 1, y + 1, 1, h - 2, (uint16_t)color);
+}
+
+void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color) {
+  CallScope scope(*this, TFT_CALL_PIXEL);
+  plotPixel(x, y, (uint16_t)color);
+}
+
+void TFT_eSPI::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) {
+  CallScope scope(*this, TFT_CALL_LINE);
+  fillArea(x, y, w, 1, (uint16_t)color);
+}
+
+void TFT_eSPI::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) {
+  CallScope scope(*this, TFT_CALL_LINE);
+  fillArea(x, y, 1, h, (uint16_t)color);
+}
+
+void TFT_eSPI::drawCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color) {
+  CallScope scope(*this, TFT_CALL_CIRCLE);
+  const uint16_t c = (uint16_t)color;
+  for (int32_t x = 0, y = r; x <= y; x++) {
+    while (x * x + y * y > r * r + r) {
+      y--;
+    }
+    plotPixel(x0 + x, y0 + y, c);
+    plotPixel(x0 - x, y0 + y, c);
+    plotPixel(x0 + x, y0 - y, c);
+    plotPixel(x0 - x, y0 - y, c);
+    plotPixel(x0 + y, y0 + x, c);
+    plotPixel(x0 - y, y0 + x, c);
+    plotPixel(x0 + y, y0 - x, c);
+    plotPixel(x0 - y, y0 - x, c);
+  }
+}
+
+void TFT_eSPI::fillCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color) {
+  CallScope scope(*this, TFT_CALL_CIRCLE);
+  for (int32_t y = -r; y <= r; y++) {
+    int32_t x = 0;
+    while ((x + 1) * (x + 1) + y * y <= r * r + r) {
+      x++;
+    }
+    fillArea(x0 - x, y0 + y, 2 * x + 1, 1, (uint16_t)color);
+  }
+}
+
+uint16_t TFT_eSPI::readPixel(int32_t x, int32_t y) { return pixel(x, y); }
+
+void TFT_eSPI::drawChar(int32_t x, int32_t y, uint8_t c) {
+  const int32_t size = textSize_;
+  if (x >= width() || y >= height() || x + 6 * size <= 0 ||
+      y + 8 * size <= 0) {
+    return;
+  }
+  const uint8_t *glyph = c >= ' ' && c <= '~' ? FONT[c - ' '] : NO_GLYPH;
+  const bool background = textBackground_ != textColor_;
+
+  // Size 1 on a background: the whole 6 x 8 cell in one window
+  if (size == 1 && background) {
+    uint8_t *data = frame();
+    if (data == nullptr) {
+      return;
+    }
+    uint64_t written = 0;
+    for (int32_t i = 0; i < 6; i++) {
+      uint8_t line = i < 5 ? glyph[i] : 0;
+      for (int32_t j = 0; j < 8; j++, line >>= 1) {
+        if (x + i >= 0 && x + i < width() && y + j >= 0 && y + j < height()) {
+          storePixel(data, x + i, y + j,
+                     line & 1 ? textColor_ : textBackground_);
+          written++;
+        }
+      }
+    }
+    pixelsWritten(written);
+    if (!inRam_) {
+      setWindow();
+      spiSend(48 * PIXEL_BYTES);
+    }
+    return;
+  }
+
+  // Otherwise every dot on its own (and every background dot, if any): a
+  // pixel at size 1, a size x size rectangle with its own window above
+  uint8_t *data = frame();
+  if (data == nullptr) {
+    return;
+  }
+  // (written here rather than with fillArea(): long simulations draw
+  // millions of characters)
+  const int32_t screenW = width();
+  const int32_t screenH = height();
+  const bool rgb565 = bitsPerPixel() == 16;
+  uint64_t written = 0;
+  uint64_t windows = 0;
+  for (int32_t i = 0; i < 6; i++) {
+    const int32_t left = std::max<int32_t>(x + i * size, 0);
+    const int32_t right = std::min<int32_t>(x + (i + 1) * size, screenW);
+    uint8_t line = i < 5 ? glyph[i] : 0;
+    for (int32_t j = 0; j < 8; j++, line >>= 1) {
+      if (!(line & 1) && !background) {
+        continue;
+      }
+      const uint16_t color = line & 1 ? textColor_ : textBackground_;
+      if (size == 1) {
+        plotPixel(x + i, y + j, color);
+        continue;
+      }
+      const int32_t top = std::max<int32_t>(y + j * size, 0);
+      const int32_t bottom = std::min<int32_t>(y + (j + 1) * size, screenH);
+      if (left >= right || top >= bottom) {
+        continue;
+      }
+      for (int32_t row = top; row < bottom; row++) {
+        const size_t start = (size_t)row * screenW;
+        for (int32_t column = left; column < right; column++) {
+          if (rgb565) {
+            ((uint16_t *)data)[start + column] = color;
+          } else {
+            data[start + column] = toRgb332(color);
+          }
+        }
+      }
+      written += (uint64_t)(right - left) * (bottom - top);
+      windows++;
+    }
+  }
+  // Counted once per character, the same bytes as a fillRect() per dot
+  pixelsWritten(written);
+  if (!inRam_ && windows > 0) {
+    stats_.windows += windows;
+    spiSend(windows * WINDOW_BYTES + written * PIXEL_BYTES);
+    pixelColumn_ = -1;
+    pixelRow_ = -1;
+  }
+}
+
+int16_t TFT_eSPI::drawString(const String &text, int32_t x, int32_t y) {
+  CallScope scope(*this, TFT_CALL_TEXT);
+  const int32_t w = textWidth(text);
+  const int32_t h = fontHeight();
+  if (frame() == nullptr) {
+    return (int16_t)w;
+  }
+  switch (textDatum_) {
+  case TC_DATUM:
+  case MC_DATUM:
+  case BC_DATUM:
+    x -= w / 2;
+    break;
+  case TR_DATUM:
+  case MR_DATUM:
+  case BR_DATUM:
+    x -= w;
+    break;
+  }
+  switch (textDatum_) {
+  case ML_DATUM:
+  case MC_DATUM:
+  case MR_DATUM:
+    y -= h / 2;
+    break;
+  case BL_DATUM:
+  case BC_DATUM:
+  case BR_DATUM:
+    y -= h;
+    break;
+  }
+  for (size_t i = 0; i < text.length(); i++) {
+    drawChar(x + (int32_t)i * 6 * textSize_, y, (uint8_t)text[i]);
+  }
+  return (int16_t)w;
+}
+
+void TFT_eSPI::writeChar(uint8_t c) {
+  if (c == '\n') {
+    cursorX_ = 0;
+    cursorY_ += 8 * textSize_;
+    return;
+  }
+  if (c == '\r') {
+    return;
+  }
+  if (cursorX_ + 6 * textSize_ > width()) {
+    cursorX_ = 0;
+    cursorY_ += 8 * textSize_;
+  }
+  drawChar(cursorX_, cursorY_, c);
+  cursorX_ += 6 * textSize_;
+}
+
+size_t TFT_eSPI::write(uint8_t c) {
+  CallScope scope(*this, TFT_CALL_TEXT);
+  writeChar(c);
+  return 1;
+}
+
+size_t TFT_eSPI::write(const uint8_t *buffer, size_t size) {
+  CallScope scope(*this, TFT_CALL_TEXT);
+  for (size_t i = 0; i < size; i++) {
+    writeChar(buffer[i]);
+  }
+  return size;
+}
+
+void TFT_eSPI::pushFromSprite(int32_t x, int32_t y, const TFT_eSPI &sprite) {
+  CallScope scope(*this, TFT_CALL_PUSH);
+  int32_t w = sprite.width();
+  int32_t h = sprite.height();
+  const int32_t left = x;
+  const int32_t top = y;
+  uint8_t *data = frame();
+  if (data == nullptr || sprite.pixels() == nullptr || !clip(x, y, w, h)) {
+    return;
+  }
+  const uint8_t *source = sprite.pixels();
+  for (int32_t row = 0; row < h; row++) {
+    const size_t from = (size_t)(y - top + row) * sprite.width() + (x - left);
+    uint16_t *to = (uint16_t *)data + (size_t)(y + row) * width() + x;
+    if (sprite.bitsPerPixel() == 16) {
+      memcpy(to, (const uint16_t *)source + from, w * sizeof(uint16_t));
+    } else {
+      for (int32_t column = 0; column < w; column++) {
+        to[column] = fromRgb332(source[from + column]);
+      }
+    }
+  }
+  const uint64_t area = (uint64_t)w * h;
+  pixelsWritten(area);
+  setWindow();
+  spiSend(area * PIXEL_BYTES);
+}
+
+const char *TFT_eSPI::callName(TftCall call) {
+  return call >= 0 && call < TFT_CALL_COUNT ? CALL_NAMES[call] : "?";
+}
+
+uint32_t TFT_eSPI::frameCrc() const {
+  const uint8_t *data = pixels();
+  if (data == nullptr) {
+    return 0;
+  }
+  return crc32(0, data, (size_t)width() * height() * (bitsPerPixel() / 8));
+}
+
+bool TFT_eSPI::savePng(const char *path) const {
+  const int32_t w = width();
+  const int32_t h = height();
+  if (pixels() == nullptr || w <= 0 || h <= 0) {
+    return false;
+  }
+
+  // Rows of RGB, each after a filter byte of 0 (none)
+  std::string raw;
+  raw.reserve((size_t)h * (1 + w * 3));
+  for (int32_t y = 0; y < h; y++) {
+    raw.push_back(0);
+    for (int32_t x = 0; x < w; x++) {
+      const uint16_t c = pixel(x, y);
+      const uint8_t r = (c >> 11) & 0x1F;
+      const uint8_t g = (c >> 5) & 0x3F;
+      const uint8_t b = c & 0x1F;
+      raw.push_back((char)((r << 3) | (r >> 2)));
+      raw.push_back((char)((g << 2) | (g >> 4)));
+      raw.push_back((char)((b << 3) | (b >> 2)));
+    }
+  }
+
+  // zlib stream of stored (uncompressed) deflate blocks
+  std::string zlib = "\x78\x01";
+  for (size_t offset = 0; offset < raw.size(); offset += 65535) {
+    const size_t length = std::min<size_t>(65535, raw.size() - offset);
+    zlib.push_back(offset + length == raw.size() ? 1 : 0); // Last block
+    zlib.push_back((char)(length & 0xFF));
+    zlib.push_back((char)(length >> 8));
+    zlib.push_back((char)(~length & 0xFF));
+    zlib.push_back((char)((~length >> 8) & 0xFF));
+    zlib.append(raw, offset, length);
+  }
+  uint32_t a = 1;
+  uint32_t b = 0;
+  for (unsigned char byte : raw) {
+    a = (a + byte) % 65521;
+    b = (b + a) % 65521;
+  }
+  appendBigEndian(zlib, (b << 16) | a);
+
+  std::string header;
+  appendBigEndian(header, (uint32_t)w);
+  appendBigEndian(header, (uint32_t)h);
+  header += std::string("\x08\x02\x00\x00\x00", 5); // 8 bit RGB
+
+  std::string png = "\x89PNG\r\n\x1a\n";
+  appendChunk(png, "IHDR", header);
+  appendChunk(png, "IDAT", zlib);
+  appendChunk(png, "IEND", "");
+
+  FILE *file = fopen(path, "wb");
+  if (file == nullptr) {
+    return false;
+  }
+  const bool written = fwrite(png.data(), 1, png.size(), file) == png.size();
+  return fclose(file) == 0 && written;
+}
@@ -0,0 +1,264 @@
+/**
+ * TFT_eSPI.h - Display stand-in for host builds
+ *
+ * Keeps the TFT_eSPI drawing API the firmware calls and draws into a
+ * framebuffer in memory (RGB565, like the CYD's ILI9341), so a harness can
+ * read pixels back, compare frames and save them as PNG (TFT_eSPI.cpp).
+ *
+ * Every call also counts the bytes TFT_eSPI's ILI9341 driver would send over
+ * SPI for it: an address window (the CASET, RASET and RAMWR commands with
+ * their coordinates, 11 bytes) and 2 bytes per pixel. drawPixel() leaves out
+ * the column or row command when it is the same as the last pixel's, as
+ * TFT_eSPI does. Text is built-in font 1 (5 x 7 glyphs in 6 x 8 cells, times
+ * the text size), drawn the way TFT_eSPI draws it: one window per character
+ * at size 1 with a background color, otherwise a pixel or a size x size
+ * rectangle per dot. With hostsim::setDisplaySpiClock() those bytes take
+ * time on the virtual clock.
+ *
+ * TFT_eSprite draws into its buffer in RAM and sends nothing until
+ * pushSprite() sends its pixels to the display.
+ */
+
+#ifndef TFT_ESPI_H
+#define TFT_ESPI_H
+
+#include "Arduino.h"
+#include "hostsim.h"
+
+#include <vector>
+
+// Colors (RGB565)
+#define TFT_BLACK 0x0000
+#define TFT_NAVY 0x000F
+#define TFT_DARKGREEN 0x03E0
+#define TFT_MAROON 0x7800
+#define TFT_PURPLE 0x780F
+#define TFT_OLIVE 0x7BE0
+#define TFT_LIGHTGREY 0xD69A
+#define TFT_DARKGREY 0x7BEF
+#define TFT_GRAY TFT_DARKGREY
+#define TFT_BLUE 0x001F
+#define TFT_GREEN 0x07E0
+#define TFT_CYAN 0x07FF
+#define TFT_RED 0xF800
+#define TFT_MAGENTA 0xF81F
+#define TFT_YELLOW 0xFFE0
+#define TFT_WHITE 0xFFFF
+#define TFT_ORANGE 0xFDA0
+
+// Text datums
+#define TL_DATUM 0
+#define TC_DATUM 1
+#define TR_DATUM 2
+#define ML_DATUM 3
+#define MC_DATUM 4
+#define MR_DATUM 5
+#define BL_DATUM 6
+#define BC_DATUM 7
+#define BR_DATUM 8
+
+// The drawing calls the statistics are kept for. Calls made by another call
+// (the rectangles of a character, the lines of a circle) count for the one
+// the firmware made.
+enum TftCall {
+  TFT_CALL_FILL,   // fillScreen(), fillRect(), fillSprite()
+  TFT_CALL_LINE,   // drawFastHLine(), drawFastVLine(), drawRect()
+  TFT_CALL_PIXEL,  // drawPixel()
+  TFT_CALL_CIRCLE, // drawCircle(), fillCircle()
+  TFT_CALL_TEXT,   // drawString(), print()
+  TFT_CALL_PUSH,   // pushSprite(), counted by the display it sends to
+  TFT_CALL_COUNT
+};
+
+class TFT_eSPI : public Print {
+public:
+  struct CallStats {
+    uint64_t calls = 0;
+    uint64_t pixels = 0;   // Written to the framebuffer (clipped)
+    uint64_t spiBytes = 0; // Commands, coordinates and pixels
+  };
+
+  struct Stats {
+    uint64_t drawCalls = 0;
+    uint64_t pixelsFilled = 0; // In RAM for a sprite
+    uint64_t spiBytes = 0;     // Always 0 for a sprite
+    uint64_t windows = 0;      // Address windows set
+    CallStats byCall[TFT_CALL_COUNT];
+  };
+
+  TFT_eSPI(int16_t width = 240, int16_t height = 320)
+      : baseWidth_(width), baseHeight_(height) {}
+
+  void init() { frame(); }
+  void begin() { init(); }
+  void setRotation(uint8_t rotation) { rotation_ = rotation & 3; }
+  uint8_t getRotation() const { return rotation_; }
+  void invertDisplay(bool invert) { (void)invert; }
+
+  int16_t width() const { return rotation_ & 1 ? baseHeight_ : baseWidth_; }
+  int16_t height() const { return rotation_ & 1 ? baseWidth_ : baseHeight_; }
+
+  void fillScreen(uint32_t color) { fillRect(0, 0, width(), height(), color); }
+  void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+  void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+  void drawPixel(int32_t x, int32_t y, uint32_t color);
+  void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color);
+  void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color);
+  // Circles the way TFT_eSPI draws them: a pixel per point of the outline,
+  // a horizontal line per row of the filled circle
+  void drawCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color);
+  void fillCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color);
+  uint16_t readPixel(int32_t x, int32_t y);
+
+  void setCursor(int16_t x, int16_t y) {
+    cursorX_ = x;
+    cursorY_ = y;
+  }
+  // Without a background color text is transparent: only its dots are drawn
+  void setTextColor(uint16_t color) {
+    textColor_ = color;
+    textBackground_ = color;
+  }
+  void setTextColor(uint16_t color, uint16_t background) {
+    textColor_ = color;
+    textBackground_ = background;
+  }
+  void setTextSize(uint8_t size) { textSize_ = size ? size : 1; }
+  void setTextDatum(uint8_t datum) { textDatum_ = datum; }
+  void setTextFont(uint8_t font) { (void)font; } // Always font 1
+
+  // Built-in font 1 is 6 pixels wide per character at size 1
+  int16_t textWidth(const String &text) const {
+    return (int16_t)(text.length() * 6 * textSize_);
+  }
+  int16_t fontHeight() const { return (int16_t)(8 * textSize_); }
+  int16_t drawString(const String &text, int32_t x, int32_t y);
+
+  // At the cursor, wrapping at the right edge like TFT_eSPI
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t *buffer, size_t size) override;
+  using Print::write;
+
+  // Pixels of a sprite, sent by TFT_eSprite::pushSprite()
+  void pushFromSprite(int32_t x, int32_t y, const TFT_eSPI &sprite);
+
+  // Harness access
+  const Stats &stats() const { return stats_; }
+  void resetStats() { stats_ = Stats(); }
+  static const char *callName(TftCall call);
+  // CRC-32 of the pixels, to compare a frame with a known one
+  uint32_t frameCrc() const;
+  // 24 bit RGB PNG of the framebuffer (uncompressed, a few hundred KB)
+  bool savePng(const char *path) const;
+
+protected:
+  // Sets the call the statistics go to while the firmware's call runs
+  class CallScope {
+  public:
+    CallScope(TFT_eSPI &tft, TftCall call);
+    ~CallScope() { tft_.callDepth_--; }
+
+  private:
+    TFT_eSPI &tft_;
+  };
+
+  // The framebuffer, RGB565 on the display and 16 bit sprites, RGB332 on
+  // 8 bit sprites. The display allocates it on first use, outside the heap
+  // model: on the board it is the display's own memory. nullptr (nothing
+  // is drawn) with hostsim::setDisplayDrawing(false).
+  virtual uint8_t *frame();
+  // The framebuffer as it is, nullptr before anything was drawn
+  virtual const uint8_t *pixels() const;
+  uint8_t bitsPerPixel() const { return colorDepth_ > 8 ? 16 : 8; }
+  // RGB565 of a pixel on the screen (0 before anything was drawn)
+  uint16_t pixel(int32_t x, int32_t y) const;
+  void storePixel(uint8_t *frame, int32_t x, int32_t y, uint16_t color);
+  // Clipped to the screen, in place; false when nothing is left
+  bool clip(int32_t &x, int32_t &y, int32_t &w, int32_t &h) const;
+  // Pixels of a rectangle that is on the screen, nothing counted
+  void fillPixels(uint8_t *frame, int32_t x, int32_t y, int32_t w, int32_t h,
+                  uint16_t color);
+  // Window, pixels and SPI bytes of a rectangle
+  void fillArea(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color);
+  // A pixel and its SPI bytes, as TFT_eSPI's drawPixel() sends them
+  void plotPixel(int32_t x, int32_t y, uint16_t color);
+  void drawChar(int32_t x, int32_t y, uint8_t c);
+  void writeChar(uint8_t c);
+  void setWindow();
+  void spiSend(uint64_t bytes);
+  void pixelsWritten(uint64_t pixels);
+
+  int16_t baseWidth_;
+  int16_t baseHeight_;
+  uint8_t rotation_ = 0;
+  int8_t colorDepth_ = 16;
+  uint8_t textSize_ = 1;
+  uint8_t textDatum_ = TL_DATUM;
+  uint16_t textColor_ = TFT_WHITE;
+  uint16_t textBackground_ = TFT_WHITE; // Same as the color: transparent
+  int32_t cursorX_ = 0;
+  int32_t cursorY_ = 0;
+  bool inRam_ = false; // A sprite: drawing does not touch the display
+  Stats stats_;
+
+private:
+  std::vector<uint16_t> frame_;
+  TftCall call_ = TFT_CALL_FILL;
+  int callDepth_ = 0;
+  // Column and row drawPixel() last sent, -1 after any other window
+  int32_t pixelColumn_ = -1;
+  int32_t pixelRow_ = -1;
+};
+
+// Off-screen buffer with the same drawing API; pushSprite() copies it to the
+// display it was created for
+class TFT_eSprite : public TFT_eSPI {
+public:
+  explicit TFT_eSprite(TFT_eSPI *display) : TFT_eSPI(0, 0), display_(display) {
+    inRam_ = true;
+  }
+
+  void setColorDepth(int8_t bits) { colorDepth_ = bits; }
+
+  // Takes the buffer from the heap like the real sprite (2 bytes per pixel
+  // at 16 bit color depth)
+  void *createSprite(int16_t width, int16_t height) {
+    deleteSprite();
+    if (width <= 0 || height <= 0) {
+      return nullptr;
+    }
+    buffer_.assign((size_t)width * height * (bitsPerPixel() / 8), 0);
+    baseWidth_ = width;
+    baseHeight_ = height;
+    return buffer_.data();
+  }
+  void deleteSprite() {
+    std::vector<uint8_t>().swap(buffer_);
+    baseWidth_ = 0;
+    baseHeight_ = 0;
+  }
+  bool created() const { return !buffer_.empty(); }
+
+  void fillSprite(uint32_t color) { fillRect(0, 0, width(), height(), color); }
+
+  void pushSprite(int32_t x, int32_t y) {
+    if (display_ != nullptr && created()) {
+      display_->pushFromSprite(x, y, *this);
+    }
+  }
+
+protected:
+  uint8_t *frame() override {
+    return buffer_.empty() || !hostsim::displayDrawing() ? nullptr
+                                                         : buffer_.data();
+  }
+  const uint8_t *pixels() const override {
+    return buffer_.empty() ? nullptr : buffer_.data();
+  }
+
+private:
+  TFT_eSPI *display_;
+  std::vector<uint8_t> buffer_;
+};
+
+#endif
@@ -0,0 +1,177 @@
+#include "WString.h"
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+std::string formatUnsigned(unsigned long long value, unsigned char base) {
+  if (base < 2 || base > 36) {
+    base = 10;
+  }
+  if (value == 0) {
+    return "0";
+  }
+  std::string digits;
+  while (value > 0) {
+    int digit = (int)(value % base);
+    digits.insert(digits.begin(),
+                  (char)(digit < 10 ? '0' + digit : 'a' + digit - 10));
+    value /= base;
+  }
+  return digits;
+}
+
+std::string formatSigned(long long value, unsigned char base) {
+  if (value < 0 && base == 10) {
+    return "-" + formatUnsigned((unsigned long long)(-(value + 1)) + 1, base);
+  }
+  return formatUnsigned((unsigned long long)value, base);
+}
+
+std::string formatFloat(double value, unsigned int decimals) {
+  char buffer[64];
+  snprintf(buffer, sizeof(buffer), "%.*f", (int)decimals, value);
+  return buffer;
+}
+} // namespace
+
+String::String(unsigned char value, unsigned char base)
+    : value_(formatUnsigned(value, base)) {}
+String::String(int value, unsigned char base)
+    : value_(formatSigned(value, base)) {}
+String::String(unsigned int value, unsigned char base)
+    : value_(formatUnsigned(value, base)) {}
+String::String(long value, unsigned char base)
+    : value_(formatSigned(value, base)) {}
+String::String(unsigned long value, unsigned char base)
+    : value_(formatUnsigned(value, base)) {}
+String::String(long long value, unsigned char base)
+    : value_(formatSigned(value, base)) {}
+String::String(unsigned long long value, unsigned char base)
+    : value_(formatUnsigned(value, base)) {}
+String::String(float value, unsigned int decimals)
+    : value_(formatFloat(value, decimals)) {}
+String::String(double value, unsigned int decimals)
+    : value_(formatFloat(value, decimals)) {}
+
+bool String::equalsIgnoreCase(const String &other) const {
+  if (value_.size() != other.value_.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < value_.size(); i++) {
+    if (tolower((unsigned char)value_[i]) !=
+        tolower((unsigned char)other.value_[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int String::indexOf(char c, unsigned int from) const {
+  size_t pos = value_.find(c, from);
+  return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::indexOf(const String &text, unsigned int from) const {
+  size_t pos = value_.find(text.value_, from);
+  return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::lastIndexOf(char c) const {
+  size_t pos = value_.rfind(c);
+  return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::lastIndexOf(const String &text) const {
+  size_t pos = value_.rfind(text.value_);
+  return pos == std::string::npos ? -1 : (int)pos;
+}
+
+String String::substring(unsigned int from) const {
+  return substring(from, length());
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+  if (from > to) {
+    unsigned int swap = from;
+    from = to;
+    to = swap;
+  }
+  if (from >= value_.size()) {
+    return String();
+  }
+  if (to > value_.size()) {
+    to = (unsigned int)value_.size();
+  }
+  return String(value_.substr(from, to - from));
+}
+
+void String::replace(const String &find, const String &replacement) {
+  if (find.value_.empty()) {
+    return;
+  }
+  size_t pos = 0;
+  while ((pos = value_.find(find.value_, pos)) != std::string::npos) {
+    value_.replace(pos, find.value_.size(), replacement.value_);
+    pos += replacement.value_.size();
+  }
+}
+
+void String::remove(unsigned int index) {
+  if (index < value_.size()) {
+    value_.erase(index);
+  }
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+  if (index < value_.size()) {
+    value_.erase(index, count);
+  }
+}
+
+void String::toLowerCase() {
+  for (char &c : value_) {
+    c = (char)tolower((unsigned char)c);
+  }
+}
+
+void String::toUpperCase() {
+  for (char &c : value_) {
+    c = (char)toupper((unsigned char)c);
+  }
+}
+
+void String::trim() {
+  size_t start = 0;
+  while (start < value_.size() && isspace((unsigned char)value_[start])) {
+    start++;
+  }
+  size_t end = value_.size();
+  while (end > start && isspace((unsigned char)value_[end - 1])) {
+    end--;
+  }
+  value_ = value_.substr(start, end - start);
+}
+
+long String::toInt() const { return strtol(value_.c_str(), nullptr, 10); }
+float String::toFloat() const { return strtof(value_.c_str(), nullptr); }
+double String::toDouble() const { return strtod(value_.c_str(), nullptr); }
+
+void String::getBytes(unsigned char *buffer, unsigned int size,
+                      unsigned int index) const {
+  if (size == 0 || buffer == nullptr) {
+    return;
+  }
+  if (index >= value_.size()) {
+    buffer[0] = 0;
+    return;
+  }
+  unsigned int count = (unsigned int)value_.size() - index;
+  if (count > size - 1) {
+    count = size - 1;
+  }
+  memcpy(buffer, value_.data() + index, count);
+  buffer[count] = 0;
+}
@@ -0,0 +1,186 @@
+/**
+ * WString.h - Arduino String class for host builds
+ *
+ * Backed by std::string. Covers the parts of the Arduino/ESP32 String API
+ * the workshop firmware uses.
+ */
+
+#ifndef WSTRING_H
+#define WSTRING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class __FlashStringHelper;
+
+class String {
+public:
+  String() {}
+  String(const char *text) {
+    if (text != nullptr) {
+      value_ = text;
+    }
+  }
+  String(const char *text, size_t length) : value_(text, length) {}
+  String(const std::string &text) : value_(text) {}
+  String(const String &other) = default;
+  String(String &&other) = default;
+  explicit String(char c) : value_(1, c) {}
+  explicit String(unsigned char value, unsigned char base = 10);
+  explicit String(int value, unsigned char base = 10);
+  explicit String(unsigned int value, unsigned char base = 10);
+  explicit String(long value, unsigned char base = 10);
+  explicit String(unsigned long value, unsigned char base = 10);
+  explicit String(long long value, unsigned char base = 10);
+  explicit String(unsigned long long value, unsigned char base = 10);
+  explicit String(float value, unsigned int decimals = 2);
+  explicit String(double value, unsigned int decimals = 2);
+
+  String &operator=(const String &other) = default;
+  String &operator=(String &&other) = default;
+  String &operator=(const char *text) {
+    if (text != nullptr) {
+      value_ = text;
+    } else {
+      value_.clear();
+    }
+    return *this;
+  }
+
+  bool reserve(unsigned int size) {
+    value_.reserve(size);
+    return true;
+  }
+  unsigned int length() const { return (unsigned int)value_.size(); }
+  bool isEmpty() const { return value_.empty(); }
+  const char *c_str() const { return value_.c_str(); }
+  const std::string &str() const { return value_; }
+
+  bool concat(const String &other) {
+    value_ += other.value_;
+    return true;
+  }
+  bool concat(const char *text) {
+    if (text == nullptr) {
+      return false;
+    }
+    value_ += text;
+    return true;
+  }
+  bool concat(const char *text, unsigned int length) {
+    value_.append(text, length);
+    return true;
+  }
+  bool concat(char c) {
+    value_ += c;
+    return true;
+  }
+  template <typename T> bool concat(T value) { return concat(String(value)); }
+
+  String &operator+=(const String &other) {
+    concat(other);
+    return *this;
+  }
+  String &operator+=(const char *text) {
+    concat(text);
+    return *this;
+  }
+  String &operator+=(char c) {
+    concat(c);
+    return *this;
+  }
+  template <typename T> String &operator+=(T value) {
+    concat(String(value));
+    return *this;
+  }
+
+  bool equals(const String &other) const { return value_ == other.value_; }
+  bool equals(const char *text) const { return value_ == (text ? text : ""); }
+  bool equalsIgnoreCase(const String &other) const;
+  bool operator==(const String &other) const { return equals(other); }
+  bool operator==(const char *text) const { return equals(text); }
+  bool operator!=(const String &other) const { return !equals(other); }
+  bool operator!=(const char *text) const { return !equals(text); }
+  bool operator<(const String &other) const { return value_ < other.value_; }
+  int compareTo(const String &other) const {
+    return value_.compare(other.value_);
+  }
+
+  bool startsWith(const String &prefix) const {
+    return value_.compare(0, prefix.value_.size(), prefix.value_) == 0;
+  }
+  bool endsWith(const String &suffix) const {
+    return value_.size() >= suffix.value_.size() &&
+           value_.compare(value_.size() - suffix.value_.size(),
+                          suffix.value_.size(), suffix.value_) == 0;
+  }
+
+  char charAt(unsigned int index) const {
+    return index < value_.size() ? value_[index] : 0;
+  }
+  char operator[](unsigned int index) const { return charAt(index); }
+  char &operator[](unsigned int index) { return value_[index]; }
+  void setCharAt(unsigned int index, char c) {
+    if (index < value_.size()) {
+      value_[index] = c;
+    }
+  }
+
+  int indexOf(char c, unsigned int from = 0) const;
+  int indexOf(const String &text, unsigned int from = 0) const;
+  int lastIndexOf(char c) const;
+  int lastIndexOf(const String &text) const;
+
+  String substring(unsigned int from) const;
+  String substring(unsigned int from, unsigned int to) const;
+
+  void replace(const String &find, const String &replacement);
+  void remove(unsigned int index);
+  void remove(unsigned int index, unsigned int count);
+  void toLowerCase();
+  void toUpperCase();
+  void trim();
+
+  long toInt() const;
+  float toFloat() const;
+  double toDouble() const;
+
+  void getBytes(unsigned char *buffer, unsigned int size,
+                unsigned int index = 0) const;
+  void toCharArray(char *buffer, unsigned int size,
+                   unsigned int index = 0) const {
+    getBytes((unsigned char *)buffer, size, index);
+  }
+
+private:
+  std::string value_;
+};
+
+inline String operator+(const String &left, const String &right) {
+  String result(left);
+  result += right;
+  return result;
+}
+inline String operator+(const String &left, const char *right) {
+  String result(left);
+  result += right;
+  return result;
+}
+inline String operator+(const char *left, const String &right) {
+  String result(left);
+  result += right;
+  return result;
+}
+inline String operator+(const String &left, char right) {
+  String result(left);
+  result += right;
+  return result;
+}
+template <typename T> String operator+(const String &left, T right) {
+  String result(left);
+  result += String(right);
+  return result;
+}
+
+#endif
@@ -0,0 +1,263 @@
+/**
+ * WebServer.cpp - Host implementation of the ESP32 WebServer
+ */
+
+#include "WebServer.h"
+
+#include <cctype>
+#include <cstdio>
+
+namespace {
+WebServer *currentInstance = nullptr;
+
+bool equalsIgnoreCase(const std::string &a, const std::string &b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); i++) {
+    if (tolower((unsigned char)a[i]) != tolower((unsigned char)b[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string urlDecode(const std::string &text) {
+  std::string decoded;
+  for (size_t i = 0; i < text.size(); i++) {
+    if (text[i] == '+') {
+      decoded += ' ';
+    } else if (text[i] == '%' && i + 2 < text.size()) {
+      decoded += (char)strtol(text.substr(i + 1, 2).c_str(), nullptr, 16);
+      i += 2;
+    } else {
+      decoded += text[i];
+    }
+  }
+  return decoded;
+}
+
+const char *statusText(int code) {
+  switch (code) {
+  case 200:
+    return "OK";
+  case 201:
+    return "Created";
+  case 204:
+    return "No Content";
+  case 304:
+    return "Not Modified";
+  case 400:
+    return "Bad Request";
+  case 404:
+    return "Not Found";
+  case 429:
+    return "Too Many Requests";
+  case 500:
+    return "Internal Server Error";
+  case 503:
+    return "Service Unavailable";
+  default:
+    return "";
+  }
+}
+} // namespace
+
+std::string WebServer::Response::header(const std::string &name) const {
+  for (const auto &entry : headers) {
+    if (equalsIgnoreCase(entry.first, name)) {
+      return entry.second;
+    }
+  }
+  return "";
+}
+
+WebServer::WebServer(int port) {
+  (void)port;
+  currentInstance = this;
+}
+
+WebServer::~WebServer() {
+  if (currentInstance == this) {
+    currentInstance = nullptr;
+  }
+}
+
+WebServer *WebServer::instance() { return currentInstance; }
+
+void WebServer::on(const String &uri, HTTPMethod method,
+                   THandlerFunction handler) {
+  routes_.push_back({uri.str(), method, handler});
+}
+
+void WebServer::inject(HTTPMethod method, const std::string &uri,
+                       const std::string &body) {
+  Request request;
+  request.method = method;
+  request.uri = uri;
+  request.body = body;
+  inject(request);
+}
+
+void WebServer::handleClient() {
+  if (!started_ || queue_.empty()) {
+    return;
+  }
+
+  request_ = queue_.front();
+  queue_.pop_front();
+
+  response_ = Response();
+  response_.connection = std::make_shared<WiFiClient::Connection>();
+  client_ = WiFiClient(response_.connection);
+  pendingHeaders_.clear();
+  contentLength_ = CONTENT_LENGTH_UNKNOWN;
+  args_.clear();
+
+  size_t question = request_.uri.find('?');
+  uri_ = request_.uri.substr(0, question);
+  if (question != std::string::npos) {
+    parseArguments(request_.uri.substr(question + 1));
+  }
+  if (!request_.body.empty()) {
+    args_.push_back({"plain", request_.body});
+  }
+
+  for (const Route &route : routes_) {
+    if (route.uri == uri_ &&
+        (route.method == HTTP_ANY || route.method == request_.method)) {
+      route.handler();
+      return;
+    }
+  }
+
+  if (notFoundHandler_) {
+    notFoundHandler_();
+  } else {
+    send(404, "text/plain", "Not found: " + String(uri_));
+  }
+}
+
+void WebServer::parseArguments(const std::string &query) {
+  size_t start = 0;
+  while (start <= query.size()) {
+    size_t end = query.find('&', start);
+    if (end == std::string::npos) {
+      end = query.size();
+    }
+    std::string pair = query.substr(start, end - start);
+    if (!pair.empty()) {
+      size_t equals = pair.find('=');
+      std::string name = urlDecode(pair.substr(0, equals));
+      std::string value =
+          equals == std::string::npos ? "" : urlDecode(pair.substr(equals + 1));
+      args_.push_back({name, value});
+    }
+    start = end + 1;
+  }
+}
+
+String WebServer::arg(const String &name) const {
+  for (const auto &entry : args_) {
+    if (entry.first == name.str()) {
+      return String(entry.second);
+    }
+  }
+  return String("");
+}
+
+String WebServer::arg(int index) const {
+  return index >= 0 && index < args() ? String(args_[index].second)
+                                      : String("");
+}
+
+String WebServer::argName(int index) const {
+  return index >= 0 && index < args() ? String(args_[index].first)
+                                      : String("");
+}
+
+bool WebServer::hasArg(const String &name) const {
+  for (const auto &entry : args_) {
+    if (entry.first == name.str()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void WebServer::collectHeaders(const char *headerKeys[], size_t count) {
+  collectedHeaders_.clear();
+  for (size_t i = 0; i < count; i++) {
+    collectedHeaders_.push_back(headerKeys[i]);
+  }
+}
+
+String WebServer::header(const String &name) const {
+  // Like the ESP32 server, only headers named in collectHeaders() are kept
+  for (const std::string &key : collectedHeaders_) {
+    if (!equalsIgnoreCase(key, name.str())) {
+      continue;
+    }
+    for (const auto &entry : request_.headers) {
+      if (equalsIgnoreCase(entry.first, key)) {
+        return String(entry.second);
+      }
+    }
+  }
+  return String("");
+}
+
+bool WebServer::hasHeader(const String &name) const {
+  return header(name).length() > 0;
+}
+
+void WebServer::sendHeader(const String &name, const String &value,
+                           bool first) {
+  auto entry = std::make_pair(name.str(), value.str());
+  if (first) {
+    pendingHeaders_.insert(pendingHeaders_.begin(), entry);
+  } else {
+    pendingHeaders_.push_back(entry);
+  }
+}
+
+void WebServer::send(int code, const char *contentType,
+                     const String &content) {
+  sendBody(code, contentType, (const uint8_t *)content.c_str(),
+           content.length());
+}
+
+void WebServer::sendBody(int code, const char *contentType,
+                         const uint8_t *data, size_t length) {
+  response_.code = code;
+  response_.contentType = contentType ? contentType : "text/html";
+  response_.headers = pendingHeaders_;
+  pendingHeaders_.clear();
+
+  // Count the bytes the real server would put on the wire
+  char statusLine[64];
+  snprintf(statusLine, sizeof(statusLine), "HTTP/1.1 %d %s\r\n", code,
+           statusText(code));
+  size_t headerBytes = strlen(statusLine);
+  headerBytes += strlen("Content-Type: \r\n") + response_.contentType.size();
+  headerBytes += strlen("Content-Length: \r\nConnection: close\r\n\r\n") +
+                 std::to_string(length).size();
+  for (const auto &entry : response_.headers) {
+    headerBytes += entry.first.size() + entry.second.size() + 4;
+  }
+
+  response_.body.assign((const char *)data, length);
+  response_.bytesSent = headerBytes + length;
+  if (client_.connection()) {
+    client_.connection()->sent.append(response_.body);
+  }
+}
+
+void WebServer::sendContent(const String &content) {
+  sendContent(content.c_str(), content.length());
+}
+
+void WebServer::sendContent(const char *content, size_t length) {
+  response_.body.append(content, length);
+  response_.bytesSent += length;
+}
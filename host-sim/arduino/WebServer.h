@@ -0,0 +1,160 @@
+/**
+ * WebServer.h - ESP32 WebServer for host builds
+ *
+ * Same handler API as the ESP32 core (on(), onNotFound(), arg(), send(),
+ * streamFile(), ...), but requests do not come from a socket. The harness
+ * queues them with inject() and each handleClient() call serves one, the
+ * same way the real server handles one client per call. The response is
+ * captured and can be read back with lastResponse().
+ */
+
+#ifndef WEBSERVER_H
+#define WEBSERVER_H
+
+#include "Arduino.h"
+#include "WiFi.h"
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+typedef enum {
+  HTTP_ANY = 0,
+  HTTP_GET = 1,
+  HTTP_HEAD = 2,
+  HTTP_POST = 3,
+  HTTP_PUT = 4,
+  HTTP_PATCH = 5,
+  HTTP_DELETE = 6,
+  HTTP_OPTIONS = 7
+} HTTPMethod;
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+
+class WebServer {
+public:
+  typedef std::function<void(void)> THandlerFunction;
+
+  struct Request {
+    HTTPMethod method = HTTP_GET;
+    std::string uri; // May include a query string
+    std::string body;
+    std::map<std::string, std::string> headers;
+  };
+
+  struct Response {
+    int code = 0; // 0 = handler sent nothing (connection taken over)
+    std::string contentType;
+    std::string body;
+    std::vector<std::pair<std::string, std::string>> headers;
+    size_t bytesSent = 0; // Status line, headers and body
+    std::shared_ptr<WiFiClient::Connection> connection;
+
+    std::string header(const std::string &name) const;
+  };
+
+  explicit WebServer(int port = 80);
+  ~WebServer();
+
+  void begin() { started_ = true; }
+  void stop() { started_ = false; }
+  void handleClient();
+
+  void on(const String &uri, THandlerFunction handler) {
+    on(uri, HTTP_ANY, handler);
+  }
+  void on(const String &uri, HTTPMethod method, THandlerFunction handler);
+  void onNotFound(THandlerFunction handler) { notFoundHandler_ = handler; }
+
+  String uri() const { return String(uri_); }
+  HTTPMethod method() const { return request_.method; }
+  WiFiClient client() { return client_; }
+
+  String arg(const String &name) const;
+  String arg(int index) const;
+  String argName(int index) const;
+  int args() const { return (int)args_.size(); }
+  bool hasArg(const String &name) const;
+
+  void collectHeaders(const char *headerKeys[], size_t count);
+  String header(const String &name) const;
+  bool hasHeader(const String &name) const;
+
+  void sendHeader(const String &name, const String &value, bool first = false);
+  void setContentLength(size_t length) { contentLength_ = length; }
+  void send(int code, const char *contentType = nullptr,
+            const String &content = String(""));
+  void send(int code, const String &contentType, const String &content) {
+    send(code, contentType.c_str(), content);
+  }
+  void send_P(int code, PGM_P contentType, PGM_P content) {
+    send(code, contentType, String(content));
+  }
+  void send_P(int code, PGM_P contentType, PGM_P content, size_t length) {
+    sendBody(code, contentType, (const uint8_t *)content, length);
+  }
+  void sendContent(const String &content);
+  void sendContent(const char *content, size_t length);
+
+  template <typename T>
+  size_t streamFile(T &file, const String &contentType, int code = 200) {
+    std::string data;
+    uint8_t buffer[512];
+    int count;
+    while ((count = file.read(buffer, sizeof(buffer))) > 0) {
+      data.append((const char *)buffer, count);
+    }
+    if (String(file.name()).endsWith(".gz") &&
+        contentType != "application/x-gzip" &&
+        contentType != "application/octet-stream") {
+      sendHeader("Content-Encoding", "gzip");
+    }
+    sendBody(code, contentType.c_str(), (const uint8_t *)data.data(),
+             data.size());
+    return data.size();
+  }
+
+  // --- Harness interface (not part of the ESP32 API) ---
+
+  // Queue a request; it is served by the next handleClient() call
+  void inject(const Request &request) { queue_.push_back(request); }
+  void inject(HTTPMethod method, const std::string &uri,
+              const std::string &body = "");
+  size_t pending() const { return queue_.size(); }
+
+  // Response to the request served by the last handleClient() call
+  const Response &lastResponse() const { return response_; }
+
+  // The most recently constructed server (the firmware keeps its instance in
+  // an anonymous namespace)
+  static WebServer *instance();
+
+private:
+  struct Route {
+    std::string uri;
+    HTTPMethod method;
+    THandlerFunction handler;
+  };
+
+  void sendBody(int code, const char *contentType, const uint8_t *data,
+                size_t length);
+  void parseArguments(const std::string &query);
+
+  bool started_ = false;
+  std::vector<Route> routes_;
+  THandlerFunction notFoundHandler_;
+  std::deque<Request> queue_;
+
+  Request request_;
+  std::string uri_;
+  std::vector<std::pair<std::string, std::string>> args_;
+  std::vector<std::string> collectedHeaders_;
+  std::vector<std::pair<std::string, std::string>> pendingHeaders_;
+  size_t contentLength_ = CONTENT_LENGTH_UNKNOWN;
+  WiFiClient client_;
+  Response response_;
+};
+
+#endif
@@ -0,0 +1,386 @@
+/**
+ * WiFi.cpp - Host implementation of the ESP32 WiFi object
+ */
+
+#include "WiFi.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace {
+const int OUT_OF_RANGE_DBM = -90;
+
+bool linkUp = true;
+std::string mac = "24:0A:C4:00:00:01";
+std::vector<hostsim::WiFiAccessPoint> accessPoints(1);
+
+bool begun = false;      // WiFi.begin() was called
+bool wanted = false;     // begin() or reconnect() since the last disconnect()
+bool associated = false; // Connected to the network right now
+int current = -1;        // accessPoints index while associated
+
+// The connection asked for by the last begin() and config()
+std::string requestedSsid;
+bool directed = false; // With a channel and BSSID
+int32_t requestedChannel = 0;
+uint8_t requestedBssid[6] = {};
+IPAddress staticIp; // 0.0.0.0: DHCP
+IPAddress staticGateway;
+IPAddress staticSubnet;
+IPAddress staticDns;
+
+// When "got IP" is due, and from which router, if pending
+bool pending = false;
+int target = -1;
+uint64_t dueUs = 0;
+bool listening = false;
+
+// scanNetworks(): results are ready at scanDueUs
+bool scanning = false;
+bool scanShowsHidden = false;
+uint64_t scanDueUs = 0;
+std::vector<hostsim::WiFiAccessPoint> scanResults;
+bool haveScanResults = false;
+
+std::vector<std::pair<WiFiEventCb, arduino_event_id_t>> handlers;
+
+void sendEvent(arduino_event_id_t event) {
+  // A handler may register another one, so iterate over a copy
+  std::vector<std::pair<WiFiEventCb, arduino_event_id_t>> registered =
+      handlers;
+  for (const auto &handler : registered) {
+    if (handler.second == ARDUINO_EVENT_MAX || handler.second == event) {
+      handler.first(event);
+    }
+  }
+}
+
+bool dhcp() { return (uint32_t)staticIp == 0; }
+
+bool inRange(const hostsim::WiFiAccessPoint &accessPoint) {
+  return linkUp && accessPoint.rssi > OUT_OF_RANGE_DBM;
+}
+
+uint32_t scanTimeMs() {
+  uint32_t ms = 0;
+  for (const hostsim::WiFiAccessPoint &accessPoint : accessPoints) {
+    ms = std::max(ms, accessPoint.scanMs);
+  }
+  return ms;
+}
+
+bool sameRouter(const hostsim::WiFiAccessPoint &a,
+                const hostsim::WiFiAccessPoint &b) {
+  return a.channel == b.channel && memcmp(a.bssid, b.bssid, 6) == 0;
+}
+
+void associate() {
+  if (associated || target < 0 || !inRange(accessPoints[target])) {
+    return;
+  }
+  associated = true;
+  current = target;
+  sendEvent(ARDUINO_EVENT_WIFI_STA_CONNECTED);
+  sendEvent(ARDUINO_EVENT_WIFI_STA_GOT_IP);
+}
+
+void dissociate() {
+  pending = false;
+  if (!associated) {
+    return;
+  }
+  associated = false;
+  current = -1;
+  sendEvent(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+}
+
+// Send the events that are due by now
+void tick() {
+  if (pending && hostsim::clockMicros() >= dueUs) {
+    pending = false;
+    associate();
+  }
+}
+
+// The router a begin() with these settings connects to, or -1
+int chooseRouter() {
+  int best = -1;
+  for (size_t i = 0; i < accessPoints.size(); i++) {
+    const hostsim::WiFiAccessPoint &accessPoint = accessPoints[i];
+    if (accessPoint.ssid != requestedSsid || !inRange(accessPoint)) {
+      continue;
+    }
+    if (directed) {
+      if (accessPoint.channel == requestedChannel &&
+          memcmp(accessPoint.bssid, requestedBssid, 6) == 0) {
+        return (int)i;
+      }
+    } else if (best < 0 || accessPoint.rssi > accessPoints[best].rssi) {
+      best = (int)i;
+    }
+  }
+  return best;
+}
+
+// Start connecting in the background, if the station wants to and can
+void schedule() {
+  if (!listening) {
+    hostsim::addClockListener(tick);
+    listening = true;
+  }
+  pending = false;
+  if (!wanted || associated || !linkUp) {
+    return;
+  }
+  target = chooseRouter();
+  if (target < 0) {
+    return; // The ESP32 keeps looking and never connects
+  }
+  uint64_t ms = accessPoints[target].associateMs;
+  if (!directed) {
+    ms += scanTimeMs();
+  }
+  if (dhcp()) {
+    ms += accessPoints[target].dhcpMs;
+  }
+  pending = true;
+  dueUs = hostsim::clockMicros() + ms * 1000ULL;
+}
+
+const hostsim::WiFiAccessPoint *connected() {
+  return associated && linkUp ? &accessPoints[current] : nullptr;
+}
+
+const hostsim::WiFiAccessPoint *scanResult(uint8_t networkItem) {
+  return haveScanResults && networkItem < scanResults.size()
+             ? &scanResults[networkItem]
+             : nullptr;
+}
+} // namespace
+
+namespace hostsim {
+void setWiFiConnected(bool connected) {
+  linkUp = connected;
+  if (!connected) {
+    dissociate();
+  } else {
+    schedule(); // The ESP32 keeps trying (auto-reconnect)
+  }
+}
+
+void setMacAddress(const std::string &address) { mac = address; }
+
+void setWiFiAccessPoint(const WiFiAccessPoint &accessPoint) {
+  setWiFiAccessPoints({accessPoint});
+}
+
+void setWiFiAccessPoints(const std::vector<WiFiAccessPoint> &newAccessPoints) {
+  // The router in use (connected or connecting), if any
+  bool inUse = associated || pending;
+  WiFiAccessPoint used = inUse ? accessPoints[associated ? current : target]
+                               : WiFiAccessPoint();
+  accessPoints = newAccessPoints;
+  int stillThere = -1;
+  for (size_t i = 0; inUse && i < accessPoints.size(); i++) {
+    if (sameRouter(accessPoints[i], used) && accessPoints[i].ssid == used.ssid &&
+        inRange(accessPoints[i])) {
+      stillThere = (int)i;
+    }
+  }
+  if (stillThere >= 0) {
+    // Only the signal changed
+    (associated ? current : target) = stillThere;
+    return;
+  }
+  // Out of range or replaced: everyone connected to it drops, and a station
+  // that is still connecting may find a router now
+  dissociate();
+  schedule();
+}
+
+const WiFiAccessPoint *connectedAccessPoint() { return connected(); }
+} // namespace hostsim
+
+WiFiClass WiFi;
+
+// The link is up unless the harness takes it down, so harnesses that never
+// call WiFi.begin() still get a working connection
+wl_status_t WiFiClass::status() {
+  tick();
+  if (!linkUp || (begun && !associated)) {
+    return WL_DISCONNECTED;
+  }
+  return WL_CONNECTED;
+}
+
+wl_status_t WiFiClass::begin(const char *ssid, const char *password,
+                             int32_t channel, const uint8_t *bssid,
+                             bool connect) {
+  (void)password;
+  ssid_ = ssid ? ssid : "";
+  requestedSsid = ssid_;
+  begun = true;
+  directed = channel > 0 && bssid != nullptr;
+  requestedChannel = channel;
+  if (directed) {
+    memcpy(requestedBssid, bssid, 6);
+  }
+  dissociate();
+  wanted = connect;
+  schedule();
+  return status();
+}
+
+bool WiFiClass::reconnect() {
+  wanted = true;
+  if (!associated && !pending) {
+    schedule();
+  }
+  return true;
+}
+
+bool WiFiClass::disconnect(bool wifiOff, bool eraseAp) {
+  (void)wifiOff;
+  (void)eraseAp;
+  wanted = false;
+  dissociate();
+  return true;
+}
+
+bool WiFiClass::config(IPAddress localIp, IPAddress gateway, IPAddress subnet,
+                       IPAddress dns1, IPAddress dns2) {
+  (void)dns2;
+  staticIp = localIp;
+  staticGateway = gateway;
+  staticSubnet = subnet;
+  staticDns = dns1;
+  return true;
+}
+
+wifi_event_id_t WiFiClass::onEvent(WiFiEventCb callback,
+                                   arduino_event_id_t event) {
+  handlers.push_back({callback, event});
+  return (wifi_event_id_t)handlers.size();
+}
+
+String WiFiClass::macAddress() const { return String(mac); }
+
+IPAddress WiFiClass::localIP() {
+  if (!isConnected()) {
+    return IPAddress();
+  }
+  return dhcp() ? IPAddress(192, 168, 1, 50) : staticIp;
+}
+
+IPAddress WiFiClass::gatewayIP() {
+  if (!isConnected()) {
+    return IPAddress();
+  }
+  return dhcp() ? IPAddress(192, 168, 1, 1) : staticGateway;
+}
+
+IPAddress WiFiClass::subnetMask() {
+  if (!isConnected()) {
+    return IPAddress();
+  }
+  return dhcp() ? IPAddress(255, 255, 255, 0) : staticSubnet;
+}
+
+IPAddress WiFiClass::dnsIP(uint8_t dnsNumber) {
+  if (!isConnected() || dnsNumber > 0) {
+    return IPAddress();
+  }
+  return dhcp() ? IPAddress(192, 168, 1, 1) : staticDns;
+}
+
+uint8_t *WiFiClass::BSSID() {
+  return isConnected() && connected() ? accessPoints[current].bssid : nullptr;
+}
+
+int32_t WiFiClass::channel() {
+  return isConnected() && connected() ? accessPoints[current].channel : 0;
+}
+
+// Harnesses that never call begin() see a good signal
+int8_t WiFiClass::RSSI() {
+  if (!isConnected()) {
+    return 0;
+  }
+  return connected() ? (int8_t)accessPoints[current].rssi : -55;
+}
+
+int16_t WiFiClass::scanNetworks(bool async, bool showHidden, bool passive,
+                                uint32_t maxMsPerChannel, uint8_t channel,
+                                const char *ssid, const uint8_t *bssid) {
+  (void)passive;
+  (void)maxMsPerChannel;
+  (void)channel;
+  (void)ssid;
+  (void)bssid;
+  scanDelete();
+  scanning = true;
+  scanShowsHidden = showHidden;
+  scanDueUs = hostsim::clockMicros() + scanTimeMs() * 1000ULL;
+  if (async) {
+    return WIFI_SCAN_RUNNING;
+  }
+  delay(scanTimeMs());
+  return scanComplete();
+}
+
+// The routers in range when the scan ends, strongest first like the ESP32
+int16_t WiFiClass::scanComplete() {
+  if (scanning && hostsim::clockMicros() >= scanDueUs) {
+    scanning = false;
+    scanResults.clear();
+    for (const hostsim::WiFiAccessPoint &accessPoint : accessPoints) {
+      if (!inRange(accessPoint) || (accessPoint.hidden && !scanShowsHidden)) {
+        continue;
+      }
+      scanResults.push_back(accessPoint);
+      if (accessPoint.hidden) {
+        scanResults.back().ssid.clear(); // The ESP32 reports an empty SSID
+      }
+    }
+    std::stable_sort(scanResults.begin(), scanResults.end(),
+                     [](const hostsim::WiFiAccessPoint &a,
+                        const hostsim::WiFiAccessPoint &b) {
+                       return a.rssi > b.rssi;
+                     });
+    haveScanResults = true;
+  }
+  if (scanning) {
+    return WIFI_SCAN_RUNNING;
+  }
+  return haveScanResults ? (int16_t)scanResults.size() : WIFI_SCAN_FAILED;
+}
+
+void WiFiClass::scanDelete() {
+  scanning = false;
+  haveScanResults = false;
+  scanResults.clear();
+}
+
+String WiFiClass::SSID(uint8_t networkItem) {
+  const hostsim::WiFiAccessPoint *result = scanResult(networkItem);
+  return String(result ? result->ssid : std::string());
+}
+
+int32_t WiFiClass::RSSI(uint8_t networkItem) {
+  const hostsim::WiFiAccessPoint *result = scanResult(networkItem);
+  return result ? result->rssi : 0;
+}
+
+uint8_t *WiFiClass::BSSID(uint8_t networkItem) {
+  if (!haveScanResults || networkItem >= scanResults.size()) {
+    return nullptr;
+  }
+  return scanResults[networkItem].bssid;
+}
+
+int32_t WiFiClass::channel(uint8_t networkItem) {
+  const hostsim::WiFiAccessPoint *result = scanResult(networkItem);
+  return result ? result->channel : 0;
+}
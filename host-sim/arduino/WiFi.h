@@ -0,0 +1,195 @@
+/**
+ * WiFi.h - ESP32 WiFi and WiFiClient for host builds
+ *
+ * The link state is set by the harness with hostsim::setWiFiConnected().
+ * Once the firmware calls WiFi.begin(), it connects in the background like
+ * a real station: "got IP" comes after the scan, association and DHCP times
+ * of the routers set with hostsim::setWiFiAccessPoints(), on the simulated
+ * clock. It stays connected while the link is up, the router is in range
+ * and it has not called disconnect(). The handlers registered with onEvent()
+ * get the ESP32's "got IP" and "disconnected" events. scanNetworks() lists
+ * the routers in range.
+ * WiFiClient is an in-memory connection: bytes the firmware writes are
+ * collected in a buffer the harness can read, and bytes the harness puts in
+ * the receive buffer are returned by read().
+ */
+
+#ifndef WIFI_H
+#define WIFI_H
+
+#include "Arduino.h"
+#include "hostsim.h"
+
+#include <memory>
+#include <string>
+
+typedef enum {
+  WL_IDLE_STATUS = 0,
+  WL_NO_SSID_AVAIL = 1,
+  WL_SCAN_COMPLETED = 2,
+  WL_CONNECTED = 3,
+  WL_CONNECT_FAILED = 4,
+  WL_CONNECTION_LOST = 5,
+  WL_DISCONNECTED = 6,
+  WL_NO_SHIELD = 255
+} wl_status_t;
+
+// scanNetworks() and scanComplete() results that are not a network count
+#define WIFI_SCAN_RUNNING (-1)
+#define WIFI_SCAN_FAILED (-2)
+
+typedef enum {
+  WIFI_OFF = 0,
+  WIFI_STA = 1,
+  WIFI_AP = 2,
+  WIFI_AP_STA = 3
+} wifi_mode_t;
+
+typedef enum {
+  WIFI_POWER_19_5dBm = 78,
+  WIFI_POWER_15dBm = 60,
+  WIFI_POWER_8_5dBm = 34,
+} wifi_power_t;
+
+// The ESP32 WiFi events the host sends (arduino-esp32 2.x names)
+typedef enum {
+  ARDUINO_EVENT_WIFI_STA_CONNECTED = 4,
+  ARDUINO_EVENT_WIFI_STA_DISCONNECTED = 5,
+  ARDUINO_EVENT_WIFI_STA_GOT_IP = 7,
+  ARDUINO_EVENT_WIFI_STA_LOST_IP = 8,
+  ARDUINO_EVENT_MAX = 40
+} arduino_event_id_t;
+
+typedef void (*WiFiEventCb)(arduino_event_id_t event);
+typedef int wifi_event_id_t;
+
+class WiFiClient : public Stream {
+public:
+  // Connection state shared by all copies of a client, like the ESP32
+  // WiFiClient which copies share the same socket
+  struct Connection {
+    bool open = true;
+    std::string sent;     // Bytes written by the firmware
+    std::string received; // Bytes waiting to be read by the firmware
+    size_t readPosition = 0;
+    size_t writeLimit = 0; // Max bytes accepted per write(), 0 = unlimited
+    IPAddress remote = IPAddress(192, 168, 1, 100);
+  };
+
+  WiFiClient() {}
+  explicit WiFiClient(std::shared_ptr<Connection> connection)
+      : connection_(connection) {}
+
+  uint8_t connected() { return connection_ && connection_->open; }
+  operator bool() { return connection_ != nullptr; }
+  void stop() {
+    if (connection_) {
+      connection_->open = false;
+    }
+  }
+  void setNoDelay(bool noDelay) { (void)noDelay; }
+  IPAddress remoteIP() const {
+    return connection_ ? connection_->remote : IPAddress();
+  }
+
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t *buffer, size_t size) override {
+    if (!connected()) {
+      return 0;
+    }
+    if (connection_->writeLimit > 0 && size > connection_->writeLimit) {
+      size = connection_->writeLimit;
+    }
+    connection_->sent.append((const char *)buffer, size);
+    return size;
+  }
+  using Print::write;
+
+  int available() override {
+    return connection_ ? (int)(connection_->received.size() -
+                               connection_->readPosition)
+                       : 0;
+  }
+  int read() override {
+    if (available() <= 0) {
+      return -1;
+    }
+    return (uint8_t)connection_->received[connection_->readPosition++];
+  }
+  int peek() override {
+    if (available() <= 0) {
+      return -1;
+    }
+    return (uint8_t)connection_->received[connection_->readPosition];
+  }
+
+  // Harness access to the underlying connection
+  std::shared_ptr<Connection> connection() const { return connection_; }
+
+private:
+  std::shared_ptr<Connection> connection_;
+};
+
+class WiFiClass {
+public:
+  bool mode(wifi_mode_t mode) {
+    mode_ = mode;
+    return true;
+  }
+  wifi_mode_t getMode() const { return mode_; }
+
+  // With a channel and BSSID, only that router is tried (no scan)
+  wl_status_t begin(const char *ssid, const char *password = nullptr,
+                    int32_t channel = 0, const uint8_t *bssid = nullptr,
+                    bool connect = true);
+  bool reconnect();
+  bool disconnect(bool wifiOff = false, bool eraseAp = false);
+  // A static address skips DHCP; all zeros switches back to DHCP
+  bool config(IPAddress localIp, IPAddress gateway, IPAddress subnet,
+              IPAddress dns1 = IPAddress(), IPAddress dns2 = IPAddress());
+  void persistent(bool persistent) { (void)persistent; }
+
+  // Handlers are called straight from begin(), disconnect() and
+  // hostsim::setWiFiConnected(), in place of the ESP32's event task
+  wifi_event_id_t onEvent(WiFiEventCb callback,
+                          arduino_event_id_t event = ARDUINO_EVENT_MAX);
+  bool setTxPower(wifi_power_t power) {
+    (void)power;
+    return true;
+  }
+
+  wl_status_t status();
+  bool isConnected() { return status() == WL_CONNECTED; }
+
+  IPAddress localIP();
+  IPAddress gatewayIP();
+  IPAddress subnetMask();
+  IPAddress dnsIP(uint8_t dnsNumber = 0);
+  uint8_t *BSSID();
+  int32_t channel();
+  String SSID() const { return String(ssid_); }
+  int8_t RSSI();
+  String macAddress() const;
+
+  // Scanning works while connected, like on the ESP32. With async the
+  // results are ready scanMs later (scanComplete() returns the count);
+  // without it, scanNetworks() waits for them with delay().
+  int16_t scanNetworks(bool async = false, bool showHidden = false,
+                       bool passive = false, uint32_t maxMsPerChannel = 300,
+                       uint8_t channel = 0, const char *ssid = nullptr,
+                       const uint8_t *bssid = nullptr);
+  int16_t scanComplete();
+  void scanDelete();
+  String SSID(uint8_t networkItem);
+  int32_t RSSI(uint8_t networkItem);
+  uint8_t *BSSID(uint8_t networkItem);
+  int32_t channel(uint8_t networkItem);
+
+private:
+  wifi_mode_t mode_ = WIFI_OFF;
+  std::string ssid_;
+};
+
+extern WiFiClass WiFi;
+
+#endif
@@ -0,0 +1,355 @@
+/**
+ * arduino_core.cpp - Host implementation of Arduino.h, Print, Stream,
+ * IPAddress and the simulated clock
+ */
+
+#include "Arduino.h"
+#include "hostsim.h"
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+// Heap size reported through ESP.getHeapSize() (typical ESP32 with WiFi up)
+const uint32_t SIMULATED_HEAP_SIZE = 320 * 1024;
+
+bool virtualClock = false;
+uint64_t clockOffsetUs = 0; // Added to the real clock, or the whole virtual one
+const auto clockStart = std::chrono::steady_clock::now();
+
+bool serialEcho = true;
+uint64_t serialBytes = 0;
+
+// UART model (setSerialBaud()): the FIFO is sending until serialBusyUntilNs
+const uint32_t SERIAL_FIFO_BYTES = 128;
+uint32_t serialBaud = 0;
+uint64_t serialBusyUntilNs = 0;
+uint64_t serialWaitUs = 0;
+
+// 10 bits per byte: start bit, 8 data bits, stop bit
+uint64_t serialByteNs() { return 10000000000ULL / serialBaud; }
+
+// Bytes still in the transmit FIFO
+uint32_t serialFifoBytes() {
+  const uint64_t nowNs = hostsim::clockMicros() * 1000ULL;
+  if (serialBaud == 0 || serialBusyUntilNs <= nowNs) {
+    return 0;
+  }
+  const uint64_t byteNs = serialByteNs();
+  return (uint32_t)((serialBusyUntilNs - nowNs + byteNs - 1) / byteNs);
+}
+
+std::mt19937 randomEngine(1);
+
+uint32_t displaySpiHz = 0;
+uint64_t displaySpiBits = 0; // Sent, but not yet a whole microsecond
+bool displayDrawingEnabled = true;
+
+std::vector<std::function<void()>> clockListeners;
+
+void notifyClockListeners() {
+  for (const auto &listener : clockListeners) {
+    listener();
+  }
+}
+
+std::string formatUnsigned(unsigned long long value, int base) {
+  return String(value, (unsigned char)base).str();
+}
+} // namespace
+
+namespace hostsim {
+void useVirtualClock(bool enabled) {
+  if (enabled == virtualClock) {
+    return;
+  }
+  // Keep the current time so switching does not jump backwards
+  uint64_t now = clockMicros();
+  virtualClock = enabled;
+  if (virtualClock) {
+    clockOffsetUs = now;
+  } else {
+    uint64_t real = std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - clockStart)
+                        .count();
+    clockOffsetUs = now > real ? now - real : 0;
+  }
+}
+
+void advanceClock(uint64_t ms) {
+  clockOffsetUs += ms * 1000ULL;
+  notifyClockListeners();
+}
+
+uint64_t clockMicros() {
+  if (virtualClock) {
+    return clockOffsetUs;
+  }
+  return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - clockStart)
+             .count() +
+         clockOffsetUs;
+}
+
+void addClockListener(std::function<void()> listener) {
+  clockListeners.push_back(listener);
+}
+
+void setDisplaySpiClock(uint32_t hz) {
+  displaySpiHz = hz;
+  displaySpiBits = 0;
+}
+
+void displayBytesSent(uint64_t bytes) {
+  if (displaySpiHz == 0 || !virtualClock) {
+    return;
+  }
+  displaySpiBits += bytes * 8;
+  const uint64_t us = displaySpiBits * 1000000ULL / displaySpiHz;
+  displaySpiBits -= us * displaySpiHz / 1000000ULL;
+  clockOffsetUs += us;
+  notifyClockListeners();
+}
+
+void setDisplayDrawing(bool enabled) { displayDrawingEnabled = enabled; }
+bool displayDrawing() { return displayDrawingEnabled; }
+
+void setSerialEcho(bool enabled) { serialEcho = enabled; }
+uint64_t serialBytesWritten() { return serialBytes; }
+
+void setSerialBaud(uint32_t baud) {
+  serialBaud = baud;
+  serialBusyUntilNs = 0;
+}
+
+uint64_t serialWaitMicros() { return serialWaitUs; }
+} // namespace hostsim
+
+// --- Time ---
+
+unsigned long millis() {
+  // Truncated to 32 bits like on the ESP32, so it wraps after 49.7 days
+  return (unsigned long)(uint32_t)(hostsim::clockMicros() / 1000ULL);
+}
+
+unsigned long micros() {
+  return (unsigned long)(uint32_t)hostsim::clockMicros();
+}
+
+void delay(unsigned long ms) {
+  if (virtualClock) {
+    hostsim::advanceClock(ms);
+  } else {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    notifyClockListeners();
+  }
+}
+
+void delayMicroseconds(unsigned int us) {
+  if (virtualClock) {
+    clockOffsetUs += us;
+  } else {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+  }
+  notifyClockListeners();
+}
+
+void yield() {}
+
+long random(long max) { return max > 0 ? (long)(randomEngine() % max) : 0; }
+
+long random(long min, long max) {
+  return max > min ? min + random(max - min) : min;
+}
+
+void randomSeed(unsigned long seed) { randomEngine.seed(seed); }
+
+// --- Serial ---
+
+HardwareSerial Serial;
+
+size_t HardwareSerial::write(uint8_t c) { return write(&c, 1); }
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+  serialBytes += size;
+  if (serialBaud != 0 && virtualClock) {
+    // The bytes join the FIFO; what does not fit waits until enough has
+    // been sent to make room
+    const uint64_t nowNs = hostsim::clockMicros() * 1000ULL;
+    const uint64_t byteNs = serialByteNs();
+    serialBusyUntilNs =
+        std::max(serialBusyUntilNs, nowNs) + size * byteNs;
+    const uint64_t fifoNs = SERIAL_FIFO_BYTES * byteNs;
+    if (serialBusyUntilNs > nowNs + fifoNs) {
+      const uint64_t waitUs = (serialBusyUntilNs - fifoNs - nowNs + 999) / 1000;
+      clockOffsetUs += waitUs;
+      serialWaitUs += waitUs;
+      notifyClockListeners();
+    }
+  }
+  if (serialEcho) {
+    fwrite(buffer, 1, size, stdout);
+  }
+  return size;
+}
+
+int HardwareSerial::availableForWrite() {
+  return (int)(SERIAL_FIFO_BYTES - serialFifoBytes());
+}
+
+// --- ESP ---
+
+EspClass ESP;
+
+uint32_t EspClass::getHeapSize() { return SIMULATED_HEAP_SIZE; }
+
+uint32_t EspClass::getFreeHeap() {
+  if (hostsim::heapModelEnabled()) {
+    return (uint32_t)hostsim::heapModelStats().freeBytes;
+  }
+  size_t live = hostsim::heapLiveBytes();
+  return live < SIMULATED_HEAP_SIZE ? (uint32_t)(SIMULATED_HEAP_SIZE - live)
+                                    : 0;
+}
+
+uint32_t EspClass::getMaxAllocHeap() {
+  if (hostsim::heapModelEnabled()) {
+    return (uint32_t)hostsim::heapModelStats().largestFreeBlock;
+  }
+  return getFreeHeap();
+}
+
+uint32_t EspClass::getMinFreeHeap() {
+  if (hostsim::heapModelEnabled()) {
+    return (uint32_t)hostsim::heapModelStats().minFreeBytes;
+  }
+  size_t peak = hostsim::heapPeakBytes();
+  return peak < SIMULATED_HEAP_SIZE ? (uint32_t)(SIMULATED_HEAP_SIZE - peak)
+                                    : 0;
+}
+
+uint32_t EspClass::getCycleCount() {
+  // 240 MHz cycle counter derived from the simulated clock
+  return (uint32_t)(hostsim::clockMicros() * 240ULL);
+}
+
+void EspClass::restart() {
+  fprintf(stderr, "ESP.restart() called\n");
+  exit(2);
+}
+
+// --- Print ---
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+  size_t n = 0;
+  while (size--) {
+    n += write(*buffer++);
+  }
+  return n;
+}
+
+size_t Print::printf(const char *format, ...) {
+  char buffer[256];
+  va_list args;
+  va_start(args, format);
+  int length = vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  if (length < 0) {
+    return 0;
+  }
+  if ((size_t)length < sizeof(buffer)) {
+    return write((const uint8_t *)buffer, length);
+  }
+  std::string large(length + 1, '\0');
+  va_start(args, format);
+  vsnprintf(&large[0], large.size(), format, args);
+  va_end(args);
+  return write((const uint8_t *)large.data(), length);
+}
+
+size_t Print::print(unsigned char value, int base) {
+  return print((unsigned long long)value, base);
+}
+size_t Print::print(int value, int base) { return print((long long)value, base); }
+size_t Print::print(unsigned int value, int base) {
+  return print((unsigned long long)value, base);
+}
+size_t Print::print(long value, int base) { return print((long long)value, base); }
+size_t Print::print(unsigned long value, int base) {
+  return print((unsigned long long)value, base);
+}
+
+size_t Print::print(long long value, int base) {
+  if (base == 10 && value < 0) {
+    size_t n = print('-');
+    return n + print((unsigned long long)(-(value + 1)) + 1, base);
+  }
+  return print((unsigned long long)value, base);
+}
+
+size_t Print::print(unsigned long long value, int base) {
+  std::string text = formatUnsigned(value, base);
+  return write((const uint8_t *)text.data(), text.size());
+}
+
+size_t Print::print(double value, int digits) {
+  return print(String(value, (unsigned int)digits));
+}
+
+// --- Stream ---
+
+size_t Stream::readBytes(char *buffer, size_t length) {
+  size_t count = 0;
+  while (count < length) {
+    int c = read();
+    if (c < 0) {
+      break;
+    }
+    buffer[count++] = (char)c;
+  }
+  return count;
+}
+
+String Stream::readString() {
+  std::string text;
+  int c;
+  while ((c = read()) >= 0) {
+    text += (char)c;
+  }
+  return String(text);
+}
+
+String Stream::readStringUntil(char terminator) {
+  std::string text;
+  int c;
+  while ((c = read()) >= 0 && c != terminator) {
+    text += (char)c;
+  }
+  return String(text);
+}
+
+// --- IPAddress ---
+
+bool IPAddress::fromString(const char *text) {
+  unsigned a, b, c, d;
+  if (sscanf(text, "%u.%u.%u.%u", &a, &b, &c, &d) != 4 || a > 255 ||
+      b > 255 || c > 255 || d > 255) {
+    return false;
+  }
+  bytes_[0] = (uint8_t)a;
+  bytes_[1] = (uint8_t)b;
+  bytes_[2] = (uint8_t)c;
+  bytes_[3] = (uint8_t)d;
+  return true;
+}
+
+String IPAddress::toString() const {
+  char buffer[16];
+  snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u", bytes_[0], bytes_[1],
+           bytes_[2], bytes_[3]);
+  return String(buffer);
+}
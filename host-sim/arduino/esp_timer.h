@@ -0,0 +1,17 @@
+/**
+ * esp_timer.h - ESP-IDF high resolution timer for host builds
+ *
+ * Only esp_timer_get_time(): microseconds since boot in 64 bits, which
+ * (unlike millis() and micros()) never wraps.
+ */
+
+#ifndef ESP_TIMER_H
+#define ESP_TIMER_H
+
+#include "hostsim.h"
+
+#include <cstdint>
+
+inline int64_t esp_timer_get_time() { return (int64_t)hostsim::clockMicros(); }
+
+#endif
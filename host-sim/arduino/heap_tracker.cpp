@@ -0,0 +1,373 @@
+/**
+ * heap_tracker.cpp - Live and peak heap accounting for host builds
+ *
+ * Replaces malloc/free (and with them new/delete) with thin wrappers around
+ * the glibc allocator that keep a running total of allocated bytes. The
+ * totals back hostsim::heapLiveBytes() and ESP.getFreeHeap().
+ *
+ * With hostsim::useHeapModel() every allocation also takes room in a model
+ * of the ESP32's heap: one arena of the given size, best fit with
+ * coalescing of neighbouring free blocks, 4 byte alignment and an 8 byte
+ * block header. The model only keeps offsets, the memory itself still comes
+ * from glibc. Its free bytes and largest free block back ESP.getFreeHeap()
+ * and ESP.getMaxAllocHeap(), so fragmentation builds up as it would on the
+ * board. Allocations are also counted per site (hostsim::heapSetSite()).
+ */
+
+#include "hostsim.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <malloc.h>
+#include <map>
+#include <set>
+#include <unordered_map>
+
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *pointer, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+void __libc_free(void *pointer);
+}
+
+namespace {
+std::atomic<size_t> liveBytes(0);
+std::atomic<size_t> peakBytes(0);
+
+// --- Model of the ESP32 heap ---
+
+const size_t BLOCK_HEADER = 8;
+const size_t MIN_BLOCK = 16;
+
+struct ModelBlock {
+  size_t offset;
+  size_t size; // Header included
+  const void *site;
+};
+
+struct HeapModel {
+  size_t arenaBytes = 0;
+  size_t freeBytes = 0;
+  size_t minFreeBytes = 0;
+  uint64_t allocations = 0;
+  uint64_t failures = 0;
+  std::map<size_t, size_t> freeByOffset;         // Offset -> size
+  std::set<std::pair<size_t, size_t>> freeBySize; // (size, offset)
+  std::unordered_map<void *, ModelBlock> blocks;  // Live allocations
+  std::unordered_map<const void *, hostsim::HeapSiteTotals> sites;
+};
+
+// Created on first use with the model's own allocations not tracked
+HeapModel *model = nullptr;
+const void *currentSite = nullptr;
+int pauseDepth = 0;
+bool inModel = false; // The model allocating for itself
+
+size_t blockSize(size_t requested) {
+  size_t size = ((requested + 3) & ~(size_t)3) + BLOCK_HEADER;
+  return size < MIN_BLOCK ? MIN_BLOCK : size;
+}
+
+void addFree(size_t offset, size_t size) {
+  // Merge with the free neighbours on both sides
+  auto next = model->freeByOffset.lower_bound(offset);
+  if (next != model->freeByOffset.end() && offset + size == next->first) {
+    model->freeBySize.erase({next->second, next->first});
+    size += next->second;
+    next = model->freeByOffset.erase(next);
+  }
+  if (next != model->freeByOffset.begin()) {
+    auto previous = std::prev(next);
+    if (previous->first + previous->second == offset) {
+      model->freeBySize.erase({previous->second, previous->first});
+      offset = previous->first;
+      size += previous->second;
+      model->freeByOffset.erase(previous);
+    }
+  }
+  model->freeByOffset[offset] = size;
+  model->freeBySize.insert({size, offset});
+}
+
+// Take size bytes from the free block at offset, giving back the rest
+void takeFree(size_t offset, size_t blockBytes, size_t size) {
+  model->freeByOffset.erase(offset);
+  model->freeBySize.erase({blockBytes, offset});
+  if (blockBytes - size >= MIN_BLOCK) {
+    model->freeByOffset[offset + size] = blockBytes - size;
+    model->freeBySize.insert({blockBytes - size, offset + size});
+  }
+}
+
+void modelAllocate(void *pointer, size_t requested) {
+  size_t size = blockSize(requested);
+  auto fit = model->freeBySize.lower_bound({size, 0});
+  model->allocations++;
+  if (fit == model->freeBySize.end()) {
+    model->failures++; // Would have returned nullptr on the board
+    return;
+  }
+  const size_t offset = fit->second;
+  const size_t available = fit->first;
+  takeFree(offset, available, size);
+  if (available - size < MIN_BLOCK) {
+    size = available; // Too small to split off
+  }
+  model->blocks[pointer] = {offset, size, currentSite};
+  model->freeBytes -= size;
+  if (model->freeBytes < model->minFreeBytes) {
+    model->minFreeBytes = model->freeBytes;
+  }
+  if (currentSite != nullptr) {
+    hostsim::HeapSiteTotals &site = model->sites[currentSite];
+    site.allocations++;
+    site.bytesAllocated += requested;
+    site.liveBytes += size;
+    if (site.liveBytes > site.peakBytes) {
+      site.peakBytes = site.liveBytes;
+    }
+  }
+}
+
+void modelFree(void *pointer) {
+  auto block = model->blocks.find(pointer);
+  if (block == model->blocks.end()) {
+    return; // Allocated before the model, or while it was paused
+  }
+  const ModelBlock freed = block->second;
+  model->blocks.erase(block);
+  model->freeBytes += freed.size;
+  if (freed.site != nullptr) {
+    model->sites[freed.site].liveBytes -= freed.size;
+  }
+  addFree(freed.offset, freed.size);
+}
+
+// Resize in place when the block shrinks or the block after it is free,
+// like the ESP32's realloc(), otherwise move it
+void modelReallocate(void *pointer, void *resized, size_t requested) {
+  auto block = model->blocks.find(pointer);
+  if (block == model->blocks.end()) {
+    modelAllocate(resized, requested);
+    return;
+  }
+  ModelBlock moved = block->second;
+  model->blocks.erase(block);
+  const size_t oldSize = moved.size;
+  const size_t size = blockSize(requested);
+  model->allocations++;
+  auto next = model->freeByOffset.find(moved.offset + moved.size);
+  if (size <= moved.size) {
+    if (moved.size - size >= MIN_BLOCK) {
+      addFree(moved.offset + size, moved.size - size);
+      model->freeBytes += moved.size - size;
+      moved.size = size;
+    }
+  } else if (next != model->freeByOffset.end() &&
+             moved.size + next->second >= size) {
+    const size_t nextSize = next->second;
+    const size_t grow = size - moved.size;
+    takeFree(next->first, nextSize, grow);
+    const size_t taken = nextSize - grow < MIN_BLOCK ? nextSize : grow;
+    moved.size += taken;
+    model->freeBytes -= taken;
+  } else {
+    addFree(moved.offset, moved.size);
+    model->freeBytes += moved.size;
+    auto fit = model->freeBySize.lower_bound({size, 0});
+    if (fit == model->freeBySize.end()) {
+      model->failures++;
+      if (moved.site != nullptr) {
+        model->sites[moved.site].liveBytes -= oldSize;
+      }
+      return;
+    }
+    const size_t offset = fit->second;
+    const size_t available = fit->first;
+    takeFree(offset, available, size);
+    moved.offset = offset;
+    moved.size = available - size < MIN_BLOCK ? available : size;
+    model->freeBytes -= moved.size;
+  }
+  model->blocks[resized] = moved;
+  if (model->freeBytes < model->minFreeBytes) {
+    model->minFreeBytes = model->freeBytes;
+  }
+  if (moved.site != nullptr) {
+    hostsim::HeapSiteTotals &site = model->sites[moved.site];
+    site.allocations++;
+    site.bytesAllocated += requested;
+    site.liveBytes += moved.size - oldSize;
+    if (site.liveBytes > site.peakBytes) {
+      site.peakBytes = site.liveBytes;
+    }
+  }
+}
+
+bool modelActive() {
+  return model != nullptr && model->arenaBytes > 0 && pauseDepth == 0 &&
+         !inModel;
+}
+
+void recordAllocation(void *pointer, size_t requested) {
+  if (!pointer) {
+    return;
+  }
+  size_t live = liveBytes += malloc_usable_size(pointer);
+  size_t peak = peakBytes.load();
+  while (live > peak && !peakBytes.compare_exchange_weak(peak, live)) {
+  }
+  if (modelActive()) {
+    inModel = true;
+    modelAllocate(pointer, requested);
+    inModel = false;
+  }
+}
+
+void recordReallocation(void *pointer, size_t oldUsable, void *resized,
+                        size_t requested) {
+  size_t live = liveBytes += malloc_usable_size(resized) - oldUsable;
+  size_t peak = peakBytes.load();
+  while (live > peak && !peakBytes.compare_exchange_weak(peak, live)) {
+  }
+  if (model == nullptr || inModel) {
+    return;
+  }
+  inModel = true;
+  if (model->arenaBytes > 0 && pauseDepth == 0) {
+    modelReallocate(pointer, resized, requested);
+  } else {
+    modelFree(pointer); // The new block is not in the model
+  }
+  inModel = false;
+}
+
+void recordFree(void *pointer) {
+  if (!pointer) {
+    return;
+  }
+  liveBytes -= malloc_usable_size(pointer);
+  if (model != nullptr && !inModel) {
+    inModel = true;
+    modelFree(pointer);
+    inModel = false;
+  }
+}
+} // namespace
+
+namespace hostsim {
+size_t heapLiveBytes() { return liveBytes.load(); }
+size_t heapPeakBytes() { return peakBytes.load(); }
+void heapResetPeak() { peakBytes = liveBytes.load(); }
+
+void useHeapModel(size_t arenaBytes) {
+  inModel = true;
+  delete model;
+  model = nullptr;
+  if (arenaBytes > 0) {
+    model = new HeapModel();
+    model->arenaBytes = arenaBytes;
+    model->freeBytes = arenaBytes;
+    model->minFreeBytes = arenaBytes;
+    model->freeByOffset[0] = arenaBytes;
+    model->freeBySize.insert({arenaBytes, 0});
+  }
+  inModel = false;
+}
+
+bool heapModelEnabled() { return model != nullptr; }
+
+HeapModelStats heapModelStats() {
+  HeapModelStats stats;
+  if (model == nullptr) {
+    return stats;
+  }
+  stats.arenaBytes = model->arenaBytes;
+  stats.freeBytes = model->freeBytes;
+  stats.minFreeBytes = model->minFreeBytes;
+  stats.largestFreeBlock =
+      model->freeBySize.empty() ? 0 : model->freeBySize.rbegin()->first;
+  // What malloc() could still hand out from it
+  if (stats.largestFreeBlock > BLOCK_HEADER) {
+    stats.largestFreeBlock -= BLOCK_HEADER;
+  }
+  stats.freeBlocks = model->freeByOffset.size();
+  stats.allocations = model->allocations;
+  stats.failures = model->failures;
+  return stats;
+}
+
+HeapModelPause::HeapModelPause() { pauseDepth++; }
+HeapModelPause::~HeapModelPause() { pauseDepth--; }
+
+const void *heapSetSite(const void *site) {
+  const void *previous = currentSite;
+  currentSite = site;
+  return previous;
+}
+
+HeapSiteTotals heapSiteTotals(const void *site) {
+  if (model == nullptr) {
+    return HeapSiteTotals();
+  }
+  auto entry = model->sites.find(site);
+  return entry == model->sites.end() ? HeapSiteTotals() : entry->second;
+}
+} // namespace hostsim
+
+extern "C" {
+void *malloc(size_t size) {
+  void *pointer = __libc_malloc(size);
+  recordAllocation(pointer, size);
+  return pointer;
+}
+
+void *calloc(size_t count, size_t size) {
+  void *pointer = __libc_calloc(count, size);
+  recordAllocation(pointer, count * size);
+  return pointer;
+}
+
+void *realloc(void *pointer, size_t size) {
+  if (pointer == nullptr) {
+    return malloc(size);
+  }
+  if (size == 0) {
+    free(pointer);
+    return nullptr;
+  }
+  const size_t oldUsable = malloc_usable_size(pointer);
+  void *resized = __libc_realloc(pointer, size);
+  if (resized) {
+    recordReallocation(pointer, oldUsable, resized, size);
+  }
+  // A failed resize leaves the old block in place
+  return resized;
+}
+
+void *memalign(size_t alignment, size_t size) {
+  void *pointer = __libc_memalign(alignment, size);
+  recordAllocation(pointer, size);
+  return pointer;
+}
+
+void *aligned_alloc(size_t alignment, size_t size) {
+  return memalign(alignment, size);
+}
+
+int posix_memalign(void **result, size_t alignment, size_t size) {
+  void *pointer = memalign(alignment, size);
+  if (!pointer) {
+    return ENOMEM;
+  }
+  *result = pointer;
+  return 0;
+}
+
+void free(void *pointer) {
+  recordFree(pointer);
+  __libc_free(pointer);
+}
+}
@@ -0,0 +1,266 @@
+/**
+ * hostsim.h - Control interface for the host simulation layer
+ *
+ * The headers in this folder replace the ESP32 Arduino core so firmware
+ * files can be compiled and run on a computer. Harness programs use the
+ * functions below to drive the simulated world: the clock, the serial port,
+ * the WiFi link, NVS, the LittleFS directory and the remote HTTP APIs.
+ */
+
+#ifndef HOSTSIM_H
+#define HOSTSIM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace hostsim {
+
+// --- Clock ---
+
+// Switch millis()/micros()/delay() to a virtual clock that only moves when
+// advanceClock() or delay() is called. The real clock is the default.
+void useVirtualClock(bool enabled);
+
+// Move the clock forward (works for both real and virtual clock).
+// Simulated WiFi events that are due by then are sent afterwards.
+void advanceClock(uint64_t ms);
+
+// Current simulated time in microseconds (64 bit, never wraps)
+uint64_t clockMicros();
+
+// Called after every advanceClock() and delay(), for simulated hardware
+// that acts on its own schedule (WiFi connecting in the background)
+void addClockListener(std::function<void()> listener);
+
+// --- Serial ---
+
+// Echo Serial output to stdout (default true)
+void setSerialEcho(bool enabled);
+
+// Total bytes the firmware has written to Serial
+uint64_t serialBytesWritten();
+
+// Send Serial output at this baud rate (0, the default: at once). With the
+// virtual clock, Serial.write() then waits like on the ESP32 once the
+// UART's 128 byte transmit FIFO is full: the clock moves on until there is
+// room. Serial.availableForWrite() returns the room left.
+void setSerialBaud(uint32_t baud);
+
+// Microseconds Serial.write() has waited for the FIFO (virtual clock)
+uint64_t serialWaitMicros();
+
+// --- WiFi ---
+
+// Take the WiFi network away (false) or bring it back (true). Firmware that
+// called WiFi.begin() gets a "disconnected" event, and connects again when
+// the network is back (the ESP32's auto-reconnect, taking the times in
+// WiFiAccessPoint) unless it called WiFi.disconnect() in the meantime.
+void setWiFiConnected(bool connected);
+
+// What WiFi.macAddress() returns (default "24:0A:C4:00:00:01")
+void setMacAddress(const std::string &address);
+
+// The simulated routers, and how long connecting to one takes on the
+// simulated clock. "got IP" arrives that long after WiFi.begin() (or after
+// the network comes back):
+// - begin(ssid, password): a scan, then associateMs + dhcpMs of the
+//   strongest router with that SSID
+// - begin(ssid, password, channel, bssid) with a router's channel and
+//   BSSID: associateMs + dhcpMs; with none of them it never connects
+// - dhcpMs is skipped after WiFi.config() with a static address
+// A scan (also WiFi.scanNetworks()) takes the longest scanMs of the routers.
+// Routers with an RSSI of -90 dBm or less are out of range.
+struct WiFiAccessPoint {
+  std::string ssid = "hostsim";
+  uint8_t bssid[6] = {0x10, 0x7B, 0x44, 0x12, 0x34, 0x56};
+  int channel = 6;
+  int rssi = -55;             // Signal strength in dBm, as the station sees it
+  uint32_t scanMs = 2200;     // Active scan of all 13 channels
+  uint32_t associateMs = 250; // Authentication, association, WPA2 handshake
+  uint32_t dhcpMs = 1100;     // DHCP discover/offer/request/ack
+  // No SSID in the beacons: scans list it only with showHidden, and without
+  // a name. begin() with the SSID still finds it (probe requests).
+  bool hidden = false;
+  // What a weak link does to HTTP requests made through this router
+  uint32_t latencyMs = 0;      // Added to every answer (retransmissions)
+  uint32_t failurePercent = 0; // Requests that get no answer (read timeout)
+};
+
+// Replace all routers with this one (the default is one WiFiAccessPoint())
+void setWiFiAccessPoint(const WiFiAccessPoint &accessPoint);
+
+// Replace the routers, for example to move the device around. A station
+// connected to a router that is no longer in the list, or out of range,
+// drops; changing only the RSSI or the link quality does not.
+void setWiFiAccessPoints(const std::vector<WiFiAccessPoint> &accessPoints);
+
+// The router the station is connected to (nullptr if none), valid until the
+// next setWiFiAccessPoints()
+const WiFiAccessPoint *connectedAccessPoint();
+
+// --- NVS (used by Preferences) ---
+
+// Like flash, NVS keeps its contents across simulated reboots (for as long
+// as the harness runs) until cleared
+
+struct NvsStats {
+  uint64_t writes = 0; // put...() calls that changed something
+  uint64_t bytesWritten = 0;
+};
+NvsStats nvsStats();
+
+// Erase all namespaces and reset the statistics
+void clearNvs();
+
+// --- LittleFS ---
+
+// Host directory that backs LittleFS (created on LittleFS.begin())
+void setFsRoot(const std::string &directory);
+
+struct FsStats {
+  uint64_t bytesWritten = 0;
+  uint64_t bytesRead = 0;
+  uint64_t opens = 0;
+  uint64_t existsCalls = 0;
+};
+FsStats fsStats();
+void resetFsStats();
+
+// --- Remote HTTP APIs (used by HTTPClient) ---
+
+struct HttpRequest {
+  std::string method; // "GET" or "POST"
+  std::string url;
+  std::string body;
+  std::map<std::string, std::string> headers;
+};
+
+struct HttpResponse {
+  int code = -1; // Negative values are connection errors like HTTPClient's
+  std::string body;
+  std::map<std::string, std::string> headers;
+  uint32_t latencyMs = 0; // Added to the clock when the request is made
+  // Before latencyMs: the DNS lookup and the TCP and TLS handshakes. The
+  // read timeout does not cover it, so a lookup that gets no answer blocks
+  // for as long as it takes. With a negative code the connection failed
+  // after this long.
+  uint32_t connectMs = 0;
+  // The body arrives at this many bytes per second (0: all at once). Each
+  // wait for the next byte is bounded by the read timeout, the whole body
+  // is not.
+  uint32_t bytesPerSecond = 0;
+};
+
+typedef std::function<HttpResponse(const HttpRequest &)> HttpHandler;
+
+// Install the function that answers every HTTPClient request
+void setHttpHandler(HttpHandler handler);
+
+struct HttpStats {
+  uint64_t requests = 0;
+  uint64_t failures = 0; // Negative response codes
+  uint64_t bytesReceived = 0;
+};
+HttpStats httpStats();
+
+// --- MQTT broker (used by PubSubClient) ---
+
+// All PubSubClient objects talk to one in-process broker, like a Mosquitto
+// on the local network: retained messages, last wills, + and # wildcards,
+// QoS 0. A client that stops calling loop() for 1.5 times its keep-alive
+// (on the simulated clock) is dropped and its last will published.
+
+// A broker that is down refuses connections and drops every client
+// without publishing last wills (retained messages are kept)
+void setMqttBrokerUp(bool up);
+
+struct MqttStats {
+  uint64_t connects = 0;
+  uint64_t publishes = 0;
+  uint64_t bytesPublished = 0; // Payload bytes
+  uint64_t messagesDelivered = 0;
+  uint64_t bytesDelivered = 0; // Payload bytes
+  uint64_t willsPublished = 0;
+};
+MqttStats mqttStats();
+
+// Forget all clients, retained messages and statistics
+void resetMqttBroker();
+
+// --- Display (TFT_eSPI) ---
+
+// SPI clock of the simulated display, e.g. 40000000 as in TFT_eSPI's
+// SPI_FREQUENCY. Every byte sent to the display (commands, coordinates and
+// 2 bytes per pixel, see TFT_eSPI.h) is 8 bits on the bus, and on the
+// virtual clock that time passes. 0 (the default) makes drawing take no
+// time.
+void setDisplaySpiClock(uint32_t hz);
+
+// Called by TFT_eSPI.cpp for the bytes it sends to the display
+void displayBytesSent(uint64_t bytes);
+
+// Drawing into the display's framebuffer and sprites, on by default. Off,
+// drawing calls are only counted (TFT_eSPI::stats().drawCalls), with no
+// pixels and no SPI bytes: for simulations of days that never look at the
+// screen, where drawing text dot by dot would take most of the run.
+void setDisplayDrawing(bool enabled);
+bool displayDrawing();
+
+// --- Heap ---
+
+// Live and peak bytes allocated through malloc/new (counted by
+// heap_tracker.cpp, which wraps the glibc allocator)
+size_t heapLiveBytes();
+size_t heapPeakBytes();
+void heapResetPeak();
+
+// Model of the ESP32's heap, to see fragmentation build up. From this call
+// on, every allocation also takes room in an arena of arenaBytes: best fit,
+// neighbouring free blocks merged, 4 byte alignment, 8 byte block header.
+// ESP.getFreeHeap(), getMaxAllocHeap() and getMinFreeHeap() then report the
+// arena. Blocks allocated before are not in it. 0 turns the model off.
+void useHeapModel(size_t arenaBytes);
+bool heapModelEnabled();
+
+struct HeapModelStats {
+  size_t arenaBytes = 0;
+  size_t freeBytes = 0;
+  size_t minFreeBytes = 0;     // Lowest since useHeapModel()
+  size_t largestFreeBlock = 0; // Largest malloc() that would succeed
+  size_t freeBlocks = 0;       // Holes the free bytes are split into
+  uint64_t allocations = 0;
+  uint64_t failures = 0; // Allocations that would fail on the board
+};
+HeapModelStats heapModelStats();
+
+// Keeps the model out of the simulation's own allocations while it exists
+// (HTTP responses, NVS contents, test fixtures), which on the board are
+// not on the heap
+class HeapModelPause {
+public:
+  HeapModelPause();
+  ~HeapModelPause();
+  HeapModelPause(const HeapModelPause &) = delete;
+  HeapModelPause &operator=(const HeapModelPause &) = delete;
+};
+
+// Count the allocations from now on for site (any pointer that stays valid,
+// heap_profiler.cpp passes its HeapSite) and return the previous site.
+// nullptr stops counting. Needs the heap model.
+const void *heapSetSite(const void *site);
+
+struct HeapSiteTotals {
+  uint64_t allocations = 0; // malloc() and realloc() calls
+  uint64_t bytesAllocated = 0;
+  size_t liveBytes = 0; // Still allocated, block headers included
+  size_t peakBytes = 0;
+};
+HeapSiteTotals heapSiteTotals(const void *site);
+
+} // namespace hostsim
+
+#endif
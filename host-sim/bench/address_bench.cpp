@@ -0,0 +1,148 @@
+/**
+ * address_bench.cpp - Host benchmark for cardano-pos invoice addresses
+ *
+ * Derives payment addresses from a test account public key with
+ * cardano_crypto.cpp, the same way invoice_address.cpp does on the board
+ * (account/0/index for the payment key, account/2/0 for the stake key), and
+ * reports the time per address split into its steps.
+ *
+ * Before timing anything the derived addresses are compared with addresses
+ * computed independently for the same key, so a broken build fails loudly
+ * instead of printing fast numbers for wrong addresses.
+ *
+ * Usage: ./bin/address_bench [count]
+ */
+
+#include "cardano_crypto.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+// Test account key, not from any wallet holding funds
+const char *TEST_ACCOUNT_KEY =
+    "acct_xvk1rwvrkwawptwntk38khltnpk25jthdkrfzakldccq8gltpvqjn4rvx3ljq8wc3ee"
+    "hm5wkqtv2rx5jam67679p3tnzess54z5skrgnkfg3azt74";
+
+const struct {
+  uint8_t networkId;
+  uint32_t index;
+  const char *address;
+} KNOWN_ADDRESSES[] = {
+    {0, 0,
+     "addr_test1qrdvwm6cve59d250zwcar8gwv7wgpt39pq66wep8hh9j0djkgksvykkajyg8"
+     "vw5ypd3p44hwcc4qwmxxmh0ssdvzz7dsgth33e"},
+    {0, 1,
+     "addr_test1qpv2nq8zlusaxjluqzfzjn6kg8nrsnyvjg0hjsauffa2lu6kgksvykkajyg8"
+     "vw5ypd3p44hwcc4qwmxxmh0ssdvzz7dshmt8wx"},
+    {0, 1000,
+     "addr_test1qz8ujjrk4ugc9ygkeyf35pd427rp8jdvxel2a8szh844n8zkgksvykkajyg8"
+     "vw5ypd3p44hwcc4qwmxxmh0ssdvzz7dsztrxlf"},
+    {1, 2147483647,
+     "addr1q9mcpjvv6yzkme8jdsnlkesga9wh3e9azw6lxvrg3e85rwzkgksvykkajyg8vw5yp"
+     "d3p44hwcc4qwmxxmh0ssdvzz7dshq87gj"},
+};
+
+double nowUs() {
+  return std::chrono::duration<double, std::micro>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+double percentile(std::vector<double> values, double p) {
+  std::sort(values.begin(), values.end());
+  size_t index = (size_t)(p * (values.size() - 1));
+  return values[index];
+}
+
+bool deriveAddress(const ExtendedPublicKey &externalChain,
+                   const uint8_t stakeKeyHash[KEY_HASH_SIZE],
+                   uint8_t networkId, uint32_t index, char *out) {
+  ExtendedPublicKey paymentKey;
+  uint8_t paymentKeyHash[KEY_HASH_SIZE];
+  if (!deriveChildKey(externalChain, index, paymentKey)) {
+    return false;
+  }
+  publicKeyHash(paymentKey.key, paymentKeyHash);
+  return encodeBaseAddress(networkId, paymentKeyHash, stakeKeyHash, out,
+                           CARDANO_ADDRESS_MAX_LENGTH);
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  int count = argc > 1 ? atoi(argv[1]) : 1000;
+
+  // Setup: what invoiceAddressSetup() does once at boot
+  double setupStart = nowUs();
+  ExtendedPublicKey account, externalChain, stakingChain, stakeKey;
+  if (!parseExtendedPublicKey(TEST_ACCOUNT_KEY, account) ||
+      !deriveChildKey(account, 0, externalChain) ||
+      !deriveChildKey(account, 2, stakingChain) ||
+      !deriveChildKey(stakingChain, 0, stakeKey)) {
+    fprintf(stderr, "Could not set up the test account key\n");
+    return 1;
+  }
+  uint8_t stakeKeyHash[KEY_HASH_SIZE];
+  publicKeyHash(stakeKey.key, stakeKeyHash);
+  double setupUs = nowUs() - setupStart;
+
+  // Known answers
+  char address[CARDANO_ADDRESS_MAX_LENGTH];
+  for (const auto &known : KNOWN_ADDRESSES) {
+    if (!deriveAddress(externalChain, stakeKeyHash, known.networkId,
+                       known.index, address) ||
+        strcmp(address, known.address) != 0) {
+      fprintf(stderr, "Wrong address for index %u:\n  got      %s\n"
+                      "  expected %s\n",
+              (unsigned)known.index, address, known.address);
+      return 1;
+    }
+  }
+
+  // Time each step for count fresh indexes
+  std::vector<double> deriveUs, hashUs, encodeUs, totalUs;
+  for (int i = 0; i < count; i++) {
+    ExtendedPublicKey paymentKey;
+    uint8_t paymentKeyHash[KEY_HASH_SIZE];
+
+    double start = nowUs();
+    deriveChildKey(externalChain, (uint32_t)i, paymentKey);
+    double derived = nowUs();
+    publicKeyHash(paymentKey.key, paymentKeyHash);
+    double hashed = nowUs();
+    encodeBaseAddress(0, paymentKeyHash, stakeKeyHash, address,
+                      sizeof(address));
+    double encoded = nowUs();
+
+    deriveUs.push_back(derived - start);
+    hashUs.push_back(hashed - derived);
+    encodeUs.push_back(encoded - hashed);
+    totalUs.push_back(encoded - start);
+  }
+
+  printf("cardano-pos address benchmark: %d addresses\n\n", count);
+  printf("Known-answer check:  %zu addresses match\n",
+         sizeof(KNOWN_ADDRESSES) / sizeof(KNOWN_ADDRESSES[0]));
+  printf("Setup (3 keys):      %.0f us\n\n", setupUs);
+  printf("%-22s %9s %9s %9s\n", "step", "p50 us", "p95 us", "p99 us");
+  const struct {
+    const char *name;
+    const std::vector<double> &values;
+  } rows[] = {
+      {"child key derivation", deriveUs},
+      {"Blake2b-224 key hash", hashUs},
+      {"bech32 address", encodeUs},
+      {"total per address", totalUs},
+  };
+  for (const auto &row : rows) {
+    printf("%-22s %9.1f %9.1f %9.1f\n", row.name, percentile(row.values, 0.50),
+           percentile(row.values, 0.95), percentile(row.values, 0.99));
+  }
+  printf("\nLast address: %s\n", address);
+  printf("(Host CPU time. Compare versions with it; the ESP32 is much slower.)\n");
+  return 0;
+}
@@ -0,0 +1,279 @@
+/**
+ * boot_bench.cpp - Host benchmark for CardanoTicker boot
+ *
+ * Runs the ticker's data_fetcher.cpp, wifi_manager.cpp and boot_timing.cpp
+ * on the simulated clock, with the simulated router and APIs that answer
+ * after typical delays, and compares two ways of booting:
+ * - blocking, as CardanoTicker.ino used to: wait for WiFi, fetch the
+ *   balance, tokens, NFTs and every floor price, wait a second, then show
+ *   the screens
+ * - staged, as it does now: show the data saved in NVS, let WiFi connect in
+ *   the background and fetch one request per loop() pass, most important
+ *   first, showing each piece as it arrives
+ *
+ * Both boot for the first time (empty NVS), restart with the router and the
+ * data saved, and restart while the WiFi network is down for 20 s. Reported
+ * is when, after setup() started, the first pixel, the first data, the
+ * fresh balance and all fresh data are on the display.
+ *
+ * The staged boot must show data no later than the blocking one and end
+ * with the wallet on the screens, and a restart must show the saved wallet
+ * before WiFi is up.
+ *
+ * Usage: ./bin/boot_bench [tokens] [collections]
+ */
+
+#include "boot_timing.h"
+#include "config.h"
+#include "data_fetcher.h"
+#include "hostsim.h"
+#include "portfolio_json.h"
+#include "wifi_manager.h"
+
+#include <WiFi.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace {
+// How long the APIs take to answer (TLS handshake included)
+const uint32_t KOIOS_LATENCY_MS = 300;
+const uint32_t MINSWAP_LATENCY_MS = 900; // Several KB of JSON
+const uint32_t CEXPLORER_LATENCY_MS = 400;
+
+const uint64_t GIVE_UP_MS = 120000;        // Per boot
+const unsigned long WIFI_WAIT_MS = 30000;  // The blocking boot's timeout
+const unsigned long TICKER_FRAME_MS = 30;  // updateTicker() in loop()
+const uint64_t WIFI_OUTAGE_MS = 20000;
+
+double clockMs() { return hostsim::clockMicros() / 1000.0; }
+
+portfolio::Portfolio wallet;
+
+// The screens show the wallet (counts, and every NFT with its floor price)
+bool showsWallet() {
+  if (getTokenCount() != (int)std::min<size_t>(wallet.tokens.size(), 8) ||
+      getNftCount() != (int)std::min<size_t>(wallet.collections.size(), 8)) {
+    return false;
+  }
+  for (int i = 0; i < getNftCount(); i++) {
+    NFTInfo nft = getNFT(i);
+    const portfolio::Collection &expected = wallet.collections[i];
+    if (nft.name != expected.name.c_str() ||
+        std::fabs(nft.floorPrice - expected.floorLovelace / 1e6) > 1e-3) {
+      return false;
+    }
+  }
+  return true;
+}
+
+struct Boot {
+  double firstPixelMs = -1;
+  double dataMs = -1;    // Any wallet data on the display
+  double balanceMs = -1; // Fresh balance on the display
+  double freshMs = -1;   // All fresh data on the display
+  bool savedWallet = false; // The saved wallet was shown before WiFi was up
+  bool showsWallet = false; // At the end
+};
+
+double stageMs(BootStage stage) {
+  return bootStageReached(stage) ? (double)bootStageMs(stage) : -1;
+}
+
+bool networkDown = false;
+
+// Power off, then on. WiFi comes back outageMs after power-on.
+void powerOn(uint64_t outageMs) {
+  WiFi.disconnect(); // Power off
+  networkDown = outageMs > 0;
+  hostsim::setWiFiConnected(!networkDown);
+  bootTimingStart();
+  bootStageDone(BOOT_FIRST_PIXEL); // displayStartScreen()
+  wifiManagerSetup("hostsim", "secret");
+  initDataFetcher();
+}
+
+// WiFi back once the outage is over
+void network(double start, uint64_t outageMs) {
+  if (networkDown && clockMs() - start >= outageMs) {
+    networkDown = false;
+    hostsim::setWiFiConnected(true);
+  }
+}
+
+// setup() and loop() of CardanoTicker.ino before staged boot
+Boot blockingBoot(uint64_t outageMs) {
+  double start = clockMs();
+  powerOn(outageMs);
+  Boot result;
+  result.firstPixelMs = stageMs(BOOT_FIRST_PIXEL);
+
+  // setup(): wait for WiFi, fetch everything, wait a second, show screens
+  while (!wifiManagerIsConnected() && clockMs() - start < WIFI_WAIT_MS) {
+    network(start, outageMs);
+    wifiManagerLoop();
+    delay(100);
+  }
+  if (wifiManagerIsConnected()) {
+    updateKoiosData();
+    updatePortfolioData();
+  }
+  delay(1000);
+  double screensMs = clockMs() - start;
+
+  // loop(): the screens show what the fetch functions got, at the latest
+  // when they rotate
+  while (!bootStageReached(BOOT_FRESH_DATA) && clockMs() - start < GIVE_UP_MS) {
+    network(start, outageMs);
+    wifiManagerLoop();
+    updateKoiosData();
+    updatePortfolioData();
+    delay(TICKER_FRAME_MS);
+  }
+  // Data fetched in setup() only appears with the screens
+  result.dataMs =
+      bootStageReached(BOOT_BALANCE) ? std::max(screensMs, stageMs(BOOT_BALANCE))
+                                     : -1;
+  result.balanceMs = result.dataMs;
+  result.freshMs = bootStageReached(BOOT_FRESH_DATA)
+                       ? std::max(screensMs, stageMs(BOOT_FRESH_DATA))
+                       : -1;
+  result.showsWallet = showsWallet();
+  return result;
+}
+
+// setup() and loop() of CardanoTicker.ino now
+Boot stagedBoot(uint64_t outageMs) {
+  double start = clockMs();
+  powerOn(outageMs);
+  Boot result;
+  result.firstPixelMs = stageMs(BOOT_FIRST_PIXEL);
+
+  // setup(): saved data on the screens right away
+  if (loadSavedData()) {
+    bootStageDone(BOOT_SAVED_DATA);
+    result.dataMs = stageMs(BOOT_SAVED_DATA);
+    result.savedWallet = showsWallet() && !wifiManagerIsConnected();
+  }
+
+  // loop(): one request per pass, each piece is drawn when it arrives
+  while (!bootStageReached(BOOT_FRESH_DATA) && clockMs() - start < GIVE_UP_MS) {
+    network(start, outageMs);
+    wifiManagerLoop();
+    uint8_t changed = updateDataStep();
+    if (changed != 0 && result.dataMs < 0) {
+      result.dataMs = clockMs() - start; // The start screen goes away
+    }
+    delay(TICKER_FRAME_MS);
+  }
+  result.balanceMs = stageMs(BOOT_BALANCE);
+  result.freshMs = stageMs(BOOT_FRESH_DATA);
+  result.showsWallet = showsWallet();
+  return result;
+}
+
+void printRow(const char *name, const Boot &boot) {
+  printf("  %-42s %11.0f %10.0f %10.0f %11.0f\n", name, boot.firstPixelMs,
+         boot.dataMs, boot.balanceMs, boot.freshMs);
+}
+
+std::string koiosJson() {
+  return "[{\"stake_address\":\"" + std::string(stakeAddress.c_str()) +
+         "\",\"total_balance\":\"1234567890\"}]";
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  int tokenCount = argc > 1 ? atoi(argv[1]) : 6;
+  int collectionCount = argc > 2 ? atoi(argv[2]) : 4;
+  hostsim::setSerialEcho(false);
+  hostsim::useVirtualClock(true);
+  hostsim::clearNvs();
+
+  wallet = portfolio::generate(tokenCount, collectionCount, 3, 7);
+  std::string minswap = portfolio::minswapJson(wallet, 7);
+  std::string balance = koiosJson();
+  hostsim::setHttpHandler([&](const hostsim::HttpRequest &request) {
+    hostsim::HttpResponse reply;
+    reply.code = 404;
+    if (request.url.find("account_info") != std::string::npos) {
+      reply.code = 200;
+      reply.body = balance;
+      reply.latencyMs = KOIOS_LATENCY_MS;
+    } else if (request.url.find("/portfolio/tokens") != std::string::npos) {
+      reply.code = 200;
+      reply.body = minswap;
+      reply.latencyMs = MINSWAP_LATENCY_MS;
+    } else if (request.url.find("/policy/detail") != std::string::npos) {
+      reply.latencyMs = CEXPLORER_LATENCY_MS;
+      for (const portfolio::Collection &collection : wallet.collections) {
+        if (request.url.find(collection.policyId) != std::string::npos) {
+          reply.code = 200;
+          reply.body = portfolio::cexplorerJson(collection);
+        }
+      }
+    }
+    return reply;
+  });
+
+  // First start: nothing in NVS. Each way gets its own empty NVS.
+  Boot firstBlocking = blockingBoot(0);
+  hostsim::clearNvs();
+  Boot firstStaged = stagedBoot(0);
+  // Restart: router and data saved by the boot before
+  Boot restartBlocking = blockingBoot(0);
+  Boot restartStaged = stagedBoot(0);
+  Boot outageBlocking = blockingBoot(WIFI_OUTAGE_MS);
+  Boot outageStaged = stagedBoot(WIFI_OUTAGE_MS);
+
+  struct Pair {
+    const char *name;
+    const Boot &blocking;
+    const Boot &staged;
+  };
+  const Pair pairs[] = {{"first start", firstBlocking, firstStaged},
+                        {"restart", restartBlocking, restartStaged},
+                        {"restart, WiFi down 20 s", outageBlocking,
+                         outageStaged}};
+
+  bool ok = restartStaged.savedWallet && outageStaged.savedWallet;
+  if (!ok) {
+    fprintf(stderr, "Restart: the saved wallet is not shown before WiFi\n");
+  }
+  for (const Pair &pair : pairs) {
+    for (const Boot *boot : {&pair.blocking, &pair.staged}) {
+      if (boot->freshMs < 0 || !boot->showsWallet) {
+        fprintf(stderr, "%s: the ticker does not show the wallet\n",
+                pair.name);
+        ok = false;
+      }
+    }
+    if (pair.staged.dataMs > pair.blocking.dataMs ||
+        pair.staged.freshMs > pair.blocking.freshMs) {
+      fprintf(stderr, "%s: the staged boot shows data later\n", pair.name);
+      ok = false;
+    }
+  }
+
+  printf("CardanoTicker boot benchmark: %d tokens, %d NFT collections; Koios "
+         "%u ms, MinSwap %u ms, Cexplorer %u ms per collection\n\n",
+         tokenCount, collectionCount, KOIOS_LATENCY_MS, MINSWAP_LATENCY_MS,
+         CEXPLORER_LATENCY_MS);
+  printf("Checks:  every boot ends with the wallet on the screens, a restart "
+         "shows the saved wallet\n         before WiFi is up, the staged boot "
+         "is never later\n\n");
+  printf("  %-42s %11s %10s %10s %11s\n", "ms after setup() started",
+         "first pixel", "data", "balance", "fresh data");
+  for (const Pair &pair : pairs) {
+    std::string name = std::string(pair.name) + ", blocking (before)";
+    printRow(name.c_str(), pair.blocking);
+    name = std::string(pair.name) + ", staged";
+    printRow(name.c_str(), pair.staged);
+  }
+  printf("\n(Simulated clock: WiFi and API times are the stubs' above, not "
+         "measured on hardware.)\n");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,201 @@
+/**
+ * cbor_bench.cpp - Host benchmark for cardano-pos payment verification
+ *
+ * Builds synthetic transactions from 0.5 KB up to the 16 KB protocol limit
+ * (tag 258 input sets, legacy and Babbage outputs, native tokens, inline
+ * datums) and runs them through cbor_tx.cpp, the zero-copy reader the
+ * firmware uses to confirm a payment. Reports parse time and the heap used
+ * by the parser, then times the whole verifyPayment() path (Koios tx_cbor
+ * response streamed through the hex decoder, parse, Blake2b-256 tx ID)
+ * against a stubbed Koios.
+ *
+ * Before timing anything the reader is checked: payments and tx IDs must
+ * come out right, and every truncated or corrupted transaction, and every
+ * transaction that failed script validation, must be rejected.
+ *
+ * Usage: ./bin/cbor_bench [iterations]
+ */
+
+#include "cbor_tx.h"
+#include "hostsim.h"
+#include "payment_verifier.h"
+#include "tx_builder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+// Preprod test address (not holding funds)
+const char *SHOP_ADDRESS =
+    "addr_test1qz2fxv2umyhttkxyxp8x0dlpdt3k6cwng5pxj3jhsydzer3jcu5d8ps7zex2k2"
+    "xt3uqxgjqnnj83ws8lhrn648jjxtwq2ytjqp";
+const uint64_t INVOICE_LOVELACE = 12500042;
+
+const size_t SIZES[] = {512, 2048, 8192, 16384};
+
+double nowUs() {
+  return std::chrono::duration<double, std::micro>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+double percentile(std::vector<double> values, double p) {
+  std::sort(values.begin(), values.end());
+  size_t index = (size_t)(p * (values.size() - 1));
+  return values[index];
+}
+
+bool fail(const char *what, size_t size) {
+  fprintf(stderr, "Check failed for the %zu byte transaction: %s\n", size,
+          what);
+  return false;
+}
+
+bool checkTransaction(const std::vector<uint8_t> &address, size_t size) {
+  for (int payments = 1; payments <= 2; payments++) {
+    txbuilder::Transaction tx =
+        txbuilder::build(address, INVOICE_LOVELACE, size, (uint32_t)size,
+                         payments);
+    TxPayment payment;
+    if (!txFindPayment(tx.cbor.data(), tx.cbor.size(), address.data(),
+                       address.size(), INVOICE_LOVELACE, payment)) {
+      return fail("not parsed", size);
+    }
+    if (txbuilder::toHex(payment.txId, TX_ID_SIZE) != tx.hash) {
+      return fail("wrong transaction ID", size);
+    }
+    if (payment.outputCount != tx.outputCount ||
+        payment.outputsToAddress != payments || !payment.exactOutput ||
+        payment.lovelaceToAddress != INVOICE_LOVELACE * payments) {
+      return fail("wrong payment", size);
+    }
+    // Other amounts are seen, but not as an exact match
+    if (!txFindPayment(tx.cbor.data(), tx.cbor.size(), address.data(),
+                       address.size(), INVOICE_LOVELACE + 1, payment) ||
+        payment.exactOutput) {
+      return fail("exact match for another amount", size);
+    }
+
+    // A transaction whose scripts failed (is_valid false) creates none of
+    // its outputs, so it pays nothing
+    std::vector<uint8_t> failed = tx.cbor;
+    failed[tx.isValid] = 0xf4;
+    if (txFindPayment(failed.data(), failed.size(), address.data(),
+                      address.size(), INVOICE_LOVELACE, payment)) {
+      return fail("transaction with is_valid false accepted", size);
+    }
+
+    // Every truncation is malformed
+    for (size_t length = 0; length < tx.cbor.size(); length++) {
+      if (txFindPayment(tx.cbor.data(), length, address.data(),
+                        address.size(), INVOICE_LOVELACE, payment)) {
+        return fail("truncated transaction accepted", size);
+      }
+    }
+
+    // A changed byte in the body either breaks the CBOR or the tx ID
+    std::vector<uint8_t> corrupted = tx.cbor;
+    for (size_t i = 1; i < tx.bodyEnd; i += 7) {
+      corrupted[i] ^= 0x5a;
+      if (txFindPayment(corrupted.data(), corrupted.size(), address.data(),
+                        address.size(), INVOICE_LOVELACE, payment) &&
+          txbuilder::toHex(payment.txId, TX_ID_SIZE) == tx.hash) {
+        return fail("corrupted body kept its tx ID", size);
+      }
+      corrupted[i] ^= 0x5a;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  int iterations = argc > 1 ? atoi(argv[1]) : 2000;
+  hostsim::setSerialEcho(false);
+
+  std::vector<uint8_t> address = txbuilder::addressBytes(SHOP_ADDRESS);
+  if (address.empty()) {
+    fprintf(stderr, "Test address does not decode\n");
+    return 1;
+  }
+  for (size_t size : SIZES) {
+    if (!checkTransaction(address, size)) {
+      return 1;
+    }
+  }
+
+  printf("cardano-pos CBOR verification benchmark: %d iterations\n\n",
+         iterations);
+  printf("Checks:  payments, tx IDs, truncations, corruptions and failed "
+         "scripts OK\n\n");
+  printf("txFindPayment (parse + Blake2b-256 of the body)\n");
+  printf("%-10s %8s %9s %9s %9s %10s %12s\n", "tx bytes", "outputs",
+         "p50 us", "p95 us", "p99 us", "MB/s", "heap bytes");
+  for (size_t size : SIZES) {
+    txbuilder::Transaction tx =
+        txbuilder::build(address, INVOICE_LOVELACE, size, (uint32_t)size);
+    std::vector<double> parseUs;
+    parseUs.reserve(iterations);
+    size_t heapUsed = 0;
+    for (int i = 0; i < iterations; i++) {
+      TxPayment payment;
+      hostsim::heapResetPeak();
+      size_t heapBefore = hostsim::heapLiveBytes();
+      double start = nowUs();
+      txFindPayment(tx.cbor.data(), tx.cbor.size(), address.data(),
+                    address.size(), INVOICE_LOVELACE, payment);
+      double elapsed = nowUs() - start;
+      heapUsed = std::max(heapUsed, hostsim::heapPeakBytes() - heapBefore);
+      parseUs.push_back(elapsed);
+    }
+    double p50 = percentile(parseUs, 0.50);
+    printf("%-10zu %8d %9.1f %9.1f %9.1f %10.1f %12zu\n", tx.cbor.size(),
+           tx.outputCount, p50, percentile(parseUs, 0.95),
+           percentile(parseUs, 0.99), tx.cbor.size() / p50, heapUsed);
+  }
+
+  // Whole path against a stubbed Koios, with the largest transaction
+  txbuilder::Transaction tx =
+      txbuilder::build(address, INVOICE_LOVELACE, MAX_TX_SIZE, 1);
+  std::string response = "[{\"tx_hash\":\"" + tx.hash +
+                         "\",\"epoch_no\":120,\"block_height\":2512345,"
+                         "\"cbor\":\"" +
+                         txbuilder::toHex(tx.cbor.data(), tx.cbor.size()) +
+                         "\"}]";
+  hostsim::setHttpHandler([&](const hostsim::HttpRequest &request) {
+    hostsim::HttpResponse reply;
+    reply.code = request.url.find("/tx_cbor") != std::string::npos ? 200 : 404;
+    reply.body = response;
+    return reply;
+  });
+
+  std::vector<double> verifyUs;
+  for (int i = 0; i < iterations / 10 + 1; i++) {
+    TxPayment payment;
+    double start = nowUs();
+    bool verified = verifyPayment(String(tx.hash.c_str()), SHOP_ADDRESS,
+                                  INVOICE_LOVELACE, payment);
+    verifyUs.push_back(nowUs() - start);
+    if (!verified || !payment.exactOutput) {
+      fprintf(stderr, "verifyPayment() rejected a valid transaction\n");
+      return 1;
+    }
+  }
+
+  printf("\nverifyPayment (%zu byte tx, %zu byte Koios response)\n",
+         tx.cbor.size(), response.size());
+  printf("  p50 %.1f us, p95 %.1f us, p99 %.1f us (HTTP stubbed, no latency)\n",
+         percentile(verifyUs, 0.50), percentile(verifyUs, 0.95),
+         percentile(verifyUs, 0.99));
+  printf("  Firmware memory: %d byte transaction buffer, parser uses no heap\n",
+         MAX_TX_SIZE);
+  printf("  (getString() + a JSON document would hold %.1f KB of response "
+         "first)\n",
+         response.size() / 1024.0);
+  printf("\n(Host CPU time. Compare versions with it; the ESP32 is much slower.)\n");
+  return 0;
+}
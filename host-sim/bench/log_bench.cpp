@@ -0,0 +1,333 @@
+/**
+ * log_bench.cpp - Host benchmark for the logger
+ *
+ * Serial is modelled at 115200 baud (hostsim::setSerialBaud()) on the
+ * virtual clock: once the UART's 128 byte FIFO is full, Serial.write()
+ * waits, as on the ESP32. Measured:
+ * - A burst of log lines as a fetch writes them, printed directly with
+ *   Serial.printf() and logged with LOG_I(): how long the caller is held up,
+ *   and how long until the logger's lines are on the wire. loggerLoop()
+ *   every millisecond stands in for the background task, which on the
+ *   board waits for the FIFO itself.
+ *   A burst larger than the ring drops messages instead of waiting.
+ * - What a call costs on this computer, with the real clock: LOG_I() into
+ *   the ring, LOG_D() (removed at LOG_LEVEL_INFO), LOG_I() into a full ring
+ *   (dropped), and writing a line out of the ring.
+ * - A CardanoTicker fetch cycle (the ticker's data_fetcher.cpp against the
+ *   simulated APIs, one request per loop() pass): messages and bytes logged,
+ *   and how long the passes waited for Serial with loggerLoop() in loop(),
+ *   and with the ring flushed at the end of every pass instead (which waits
+ *   about as long as printing directly did).
+ *
+ * The logged burst must not wait for Serial, nothing may be dropped in the
+ * fetch cycle, and the dropped count of the large burst must be reported.
+ *
+ * Usage: ./bin/log_bench [burst messages] [tokens] [collections]
+ */
+
+#include "config.h"
+#include "data_fetcher.h"
+#include "hostsim.h"
+#include "logger.h"
+#include "portfolio_json.h"
+#include "wifi_manager.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace {
+const uint32_t BAUD = 115200;
+const unsigned long DRAIN_INTERVAL_MS = 1; // loggerLoop() for the task
+const unsigned long PASS_MS = 50;           // loop() pass, a ticker frame
+const unsigned long CYCLE_MS = 20000;       // Long enough for a fetch cycle
+
+const uint32_t KOIOS_LATENCY_MS = 300;
+const uint32_t MINSWAP_LATENCY_MS = 900;
+const uint32_t CEXPLORER_LATENCY_MS = 400;
+
+const int COST_ROUNDS = 200000;
+const int COST_BATCH = 16; // Messages logged between two drains
+
+double clockMs() { return hostsim::clockMicros() / 1000.0; }
+
+double nsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::nano>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// A line like the fetcher logs, with the logger's prefix for equal length
+void printDirect(int i, int count) {
+  const unsigned long ms = millis();
+  Serial.printf("%lu.%03lu I bench: Token %d of %d: MIN (Minswap) - price "
+                "$0.0123, amount 1500.00\n",
+                ms / 1000, ms % 1000, i + 1, count);
+}
+
+void logLine(int i, int count) {
+  LOG_I("bench", "Token %d of %d: MIN (Minswap) - price $0.0123, "
+                 "amount 1500.00",
+        i + 1, count);
+}
+
+struct Burst {
+  double callerMs = 0;  // Caller held up by Serial
+  double onWireMs = 0;  // Until the last line was sent
+  uint32_t dropped = 0;
+  uint32_t bytes = 0;
+};
+
+// Drain as the background task would, until the ring and the FIFO are empty
+double drainUntilEmpty(double start) {
+  LoggerStats before;
+  do {
+    before = loggerStats();
+    delay(DRAIN_INTERVAL_MS);
+    loggerLoop();
+  } while (loggerStats().bytes != before.bytes ||
+           Serial.availableForWrite() < 128);
+  return clockMs() - start;
+}
+
+Burst directBurst(int count) {
+  Burst result;
+  const uint64_t bytesBefore = hostsim::serialBytesWritten();
+  const double start = clockMs();
+  for (int i = 0; i < count; i++) {
+    printDirect(i, count);
+  }
+  result.callerMs = clockMs() - start;
+  while (Serial.availableForWrite() < 128) {
+    delay(1);
+  }
+  result.onWireMs = clockMs() - start;
+  result.bytes = (uint32_t)(hostsim::serialBytesWritten() - bytesBefore);
+  return result;
+}
+
+Burst loggedBurst(int count) {
+  Burst result;
+  const LoggerStats before = loggerStats();
+  const double start = clockMs();
+  for (int i = 0; i < count; i++) {
+    logLine(i, count);
+  }
+  result.callerMs = clockMs() - start;
+  result.onWireMs = drainUntilEmpty(start);
+  const LoggerStats after = loggerStats();
+  result.dropped = after.dropped - before.dropped;
+  result.bytes = after.bytes - before.bytes;
+  return result;
+}
+
+void printBurst(const char *name, const Burst &burst) {
+  printf("  %-24s %9.1f %12.1f %8u %8u\n", name, burst.callerMs,
+         burst.onWireMs, burst.bytes, burst.dropped);
+}
+
+struct Cycle {
+  uint32_t messages = 0;
+  uint32_t bytes = 0;
+  uint32_t dropped = 0;
+  double serialWaitMs = 0; // Passes waiting for Serial
+  double longestPassMs = 0;
+};
+
+// loop() of CardanoTicker for one fetch cycle. flushEveryPass: write the
+// ring at the end of every pass, waiting for Serial.
+Cycle fetchCycle(bool flushEveryPass) {
+  hostsim::clearNvs();
+  initDataFetcher();
+  while (!wifiManagerIsConnected()) {
+    wifiManagerLoop();
+    delay(PASS_MS);
+  }
+  loggerFlush();
+
+  Cycle result;
+  const LoggerStats before = loggerStats();
+  const uint64_t waitBefore = hostsim::serialWaitMicros();
+  const double start = clockMs();
+  while (clockMs() - start < CYCLE_MS) {
+    const double passStart = clockMs();
+    wifiManagerLoop();
+    updateDataStep();
+    if (flushEveryPass) {
+      loggerFlush();
+    } else {
+      loggerLoop();
+    }
+    const double passMs = clockMs() - passStart;
+    result.longestPassMs =
+        passMs > result.longestPassMs ? passMs : result.longestPassMs;
+    delay(PASS_MS);
+  }
+  result.serialWaitMs =
+      (hostsim::serialWaitMicros() - waitBefore) / 1000.0;
+  loggerFlush();
+  const LoggerStats after = loggerStats();
+  result.messages = after.messages - before.messages;
+  result.bytes = after.bytes - before.bytes;
+  result.dropped = after.dropped - before.dropped;
+  return result;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  const int burstMessages = argc > 1 ? atoi(argv[1]) : 20;
+  const int tokens = argc > 2 ? atoi(argv[2]) : 10;
+  const int collections = argc > 3 ? atoi(argv[3]) : 5;
+  if (burstMessages < 1 || burstMessages > LOG_RING_MESSAGES) {
+    fprintf(stderr, "Burst must be 1 to %d messages (the ring)\n",
+            LOG_RING_MESSAGES);
+    return 1;
+  }
+  hostsim::setSerialEcho(false);
+  hostsim::useVirtualClock(true);
+  hostsim::setSerialBaud(BAUD);
+  loggerBegin();
+
+  bool ok = true;
+
+  // --- Bursts ---
+  const int largeBurst = LOG_RING_MESSAGES * 4;
+  printf("Log bursts at %lu baud (virtual clock, ms)\n\n",
+         (unsigned long)BAUD);
+  printf("  %-24s %9s %12s %8s %8s\n", "", "caller", "on the wire", "bytes",
+         "dropped");
+  const Burst direct = directBurst(burstMessages);
+  const Burst logged = loggedBurst(burstMessages);
+  const Burst directLarge = directBurst(largeBurst);
+  const Burst loggedLarge = loggedBurst(largeBurst);
+  char name[40];
+  snprintf(name, sizeof(name), "Serial.printf() x%d", burstMessages);
+  printBurst(name, direct);
+  snprintf(name, sizeof(name), "LOG_I() x%d", burstMessages);
+  printBurst(name, logged);
+  snprintf(name, sizeof(name), "Serial.printf() x%d", largeBurst);
+  printBurst(name, directLarge);
+  snprintf(name, sizeof(name), "LOG_I() x%d", largeBurst);
+  printBurst(name, loggedLarge);
+  printf("\n");
+
+  if (logged.callerMs > 0 || loggedLarge.callerMs > 0) {
+    fprintf(stderr, "Logging waited for Serial\n");
+    ok = false;
+  }
+  if (logged.dropped != 0) {
+    fprintf(stderr, "A burst that fits the ring lost messages\n");
+    ok = false;
+  }
+  if (loggedLarge.dropped != (uint32_t)(largeBurst - LOG_RING_MESSAGES)) {
+    fprintf(stderr, "Expected %d dropped messages, counted %u\n",
+            largeBurst - LOG_RING_MESSAGES, loggedLarge.dropped);
+    ok = false;
+  }
+
+  // --- Cost per call (real clock, Serial without baud model) ---
+  hostsim::setSerialBaud(0);
+  double loggedNs = 0;
+  for (int round = 0; round < COST_ROUNDS / COST_BATCH; round++) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < COST_BATCH; i++) {
+      logLine(i, COST_BATCH);
+    }
+    loggedNs += nsSince(start);
+    loggerFlush();
+  }
+
+  volatile int sink = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < COST_ROUNDS; i++) {
+    LOG_D("bench", "Token %d", i);
+    sink = sink + 1;
+  }
+  const double strippedNs = nsSince(start);
+
+  for (int i = 0; i < LOG_RING_MESSAGES; i++) {
+    logLine(i, LOG_RING_MESSAGES); // Fill the ring
+  }
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < COST_ROUNDS; i++) {
+    logLine(i, COST_ROUNDS);
+  }
+  const double droppedNs = nsSince(start);
+
+  const uint32_t bytesBefore = loggerStats().bytes;
+  start = std::chrono::steady_clock::now();
+  loggerFlush();
+  const double drainNs = nsSince(start);
+  const uint32_t drainBytes = loggerStats().bytes - bytesBefore;
+
+  printf("Cost per call on this computer (real clock)\n\n");
+  printf("  LOG_I() into the ring       %7.1f ns\n", loggedNs / COST_ROUNDS);
+  printf("  LOG_D() at LOG_LEVEL_INFO   %7.1f ns (removed by the compiler)\n",
+         strippedNs / COST_ROUNDS);
+  printf("  LOG_I() into a full ring    %7.1f ns (dropped)\n",
+         droppedNs / COST_ROUNDS);
+  printf("  Writing a line out          %7.1f ns (%u bytes for %d lines)\n\n",
+         drainNs / LOG_RING_MESSAGES, drainBytes, LOG_RING_MESSAGES + 1);
+
+  // --- Fetch cycle ---
+  hostsim::setSerialBaud(BAUD);
+  portfolio::Portfolio wallet =
+      portfolio::generate(tokens, collections, 3, 7);
+  const std::string minswap = portfolio::minswapJson(wallet, 7);
+  hostsim::setHttpHandler([&](const hostsim::HttpRequest &request) {
+    hostsim::HttpResponse reply;
+    reply.code = 404;
+    if (request.url.find("account_info") != std::string::npos) {
+      reply.code = 200;
+      reply.body = "[{\"stake_address\":\"stake1...\","
+                   "\"total_balance\":\"1234567890\"}]";
+      reply.latencyMs = KOIOS_LATENCY_MS;
+    } else if (request.url.find("/portfolio/tokens") != std::string::npos) {
+      reply.code = 200;
+      reply.body = minswap;
+      reply.latencyMs = MINSWAP_LATENCY_MS;
+    } else if (request.url.find("/policy/detail") != std::string::npos) {
+      reply.latencyMs = CEXPLORER_LATENCY_MS;
+      for (const portfolio::Collection &collection : wallet.collections) {
+        if (request.url.find(collection.policyId) != std::string::npos) {
+          reply.code = 200;
+          reply.body = portfolio::cexplorerJson(collection);
+        }
+      }
+    }
+    return reply;
+  });
+  wifiManagerSetup("hostsim", "secret");
+
+  const Cycle background = fetchCycle(false);
+  const Cycle flushed = fetchCycle(true);
+  printf("CardanoTicker fetch cycle, %d tokens and %d collections "
+         "(%lu baud, LOG_LEVEL_INFO)\n\n",
+         tokens, collections, (unsigned long)BAUD);
+  printf("  %-26s %8s %6s %8s %14s %16s\n", "", "messages", "bytes",
+         "dropped", "Serial wait ms", "longest pass ms");
+  printf("  %-26s %8u %6u %8u %14.1f %16.1f\n", "loggerLoop() in loop()",
+         background.messages, background.bytes, background.dropped,
+         background.serialWaitMs, background.longestPassMs);
+  printf("  %-26s %8u %6u %8u %14.1f %16.1f\n", "Flushed every pass",
+         flushed.messages, flushed.bytes, flushed.dropped,
+         flushed.serialWaitMs, flushed.longestPassMs);
+  printf("\n");
+
+  if (background.messages == 0) {
+    fprintf(stderr, "The fetch cycle logged nothing\n");
+    ok = false;
+  }
+  if (background.dropped != 0) {
+    fprintf(stderr, "The fetch cycle lost %u messages\n", background.dropped);
+    ok = false;
+  }
+  if (background.serialWaitMs > 0) {
+    fprintf(stderr, "loggerLoop() waited for Serial\n");
+    ok = false;
+  }
+
+  printf(ok ? "All checks passed\n" : "Checks FAILED\n");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,281 @@
+/**
+ * loop_bench.cpp - Host benchmark for the loop() profiler
+ *
+ * Runs loop_profiler.cpp around a loop() like CardanoTicker's: the ticker's
+ * wifi_manager.cpp and data_fetcher.cpp against the simulated router and
+ * APIs, a data screen drawn every 10 s and a ticker frame drawn every pass
+ * (as delays of typical length on the virtual clock). Then two stalls are
+ * injected:
+ * - in minute 3 one Koios request takes 5 s (a read timeout)
+ * - in minute 5 one screen draw takes 20 s, longer than the cycle counter
+ *   takes to wrap around (17.9 s)
+ *
+ * Checks:
+ * - exactly those two stalls are logged, each blamed on the call that
+ *   caused it, with the right length
+ * - the ticker frame's p99 is at most 25% above the exact p99 of the frame
+ *   times drawn, and the max is exact
+ * - the shares of all sections add up to 100%
+ *
+ * It also measures what a mark (loopProfilerStart()/loopProfilerDone())
+ * costs on this computer, with the real clock.
+ *
+ * Usage: ./bin/loop_bench [minutes, >= 6]
+ */
+
+#include "config.h"
+#include "data_fetcher.h"
+#include "hostsim.h"
+#include "loop_profiler.h"
+#include "portfolio_json.h"
+#include "wifi_manager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+const uint32_t KOIOS_LATENCY_MS = 300;
+const uint32_t MINSWAP_LATENCY_MS = 900;
+const uint32_t CEXPLORER_LATENCY_MS = 400;
+const uint32_t KOIOS_TIMEOUT_MS = 5000; // The injected slow request
+
+const unsigned long BUDGET_MS = 1000;
+const unsigned long SCREEN_INTERVAL_MS = 10000;
+const unsigned int SCREEN_DRAW_US = 45000;       // A data screen
+const unsigned int SCREEN_HANG_US = 20000000;    // The injected slow draw
+const unsigned long SLOW_KOIOS_AFTER_MS = 120000;  // Minute 3
+const unsigned long SLOW_SCREEN_AFTER_MS = 240000; // Minute 5
+
+enum Section { WIFI, FETCH, SCREEN, TICKER, SECTIONS };
+const char *const NAMES[SECTIONS] = {"wifi", "fetch", "screen", "ticker"};
+
+struct WindowCheck {
+  uint32_t loops;
+  double loopMaxMs;
+  double loopP99Ms;
+  LoopSectionStats slowest;
+  uint32_t tickerP99Us;
+  uint32_t exactP99Us;
+  uint32_t tickerMaxUs;
+  uint32_t exactMaxUs;
+  double shareSum;
+};
+
+uint32_t exactP99(std::vector<uint32_t> values) {
+  std::sort(values.begin(), values.end());
+  size_t rank = values.size() - values.size() / 100; // Rounded up
+  return values[rank - 1];
+}
+
+// Ticker frame: mostly 3-6 ms, sometimes longer when the sprite is pushed
+// while WiFi is busy
+unsigned int tickerFrameUs(std::mt19937 &random) {
+  std::uniform_int_distribution<unsigned int> frame(3000, 6000);
+  std::uniform_int_distribution<int> slow(0, 99);
+  unsigned int us = frame(random);
+  if (slow(random) < 3) {
+    us += 8000 + frame(random) * 2;
+  }
+  return us;
+}
+
+// Nanoseconds per mark, with the real clock
+double markCostNs() {
+  const int loops = 200000;
+  const char *const names[1] = {"empty"};
+  loopProfilerBegin(names, 1, 0);
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < loops; i++) {
+    loopProfilerStart();
+    loopProfilerDone(0);
+  }
+  auto ns = std::chrono::duration<double, std::nano>(
+                std::chrono::steady_clock::now() - start)
+                .count();
+  return ns / (loops * 2.0);
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  const int minutes = std::max(6, argc > 1 ? atoi(argv[1]) : 6);
+  hostsim::setSerialEcho(false);
+
+  const double markNs = markCostNs();
+
+  hostsim::useVirtualClock(true);
+  hostsim::clearNvs();
+  portfolio::Portfolio wallet = portfolio::generate(6, 4, 3, 7);
+  std::string minswap = portfolio::minswapJson(wallet, 7);
+  bool slowKoios = false;
+  hostsim::setHttpHandler([&](const hostsim::HttpRequest &request) {
+    hostsim::HttpResponse reply;
+    reply.code = 404;
+    if (request.url.find("account_info") != std::string::npos) {
+      reply.code = 200;
+      reply.body = "[{\"stake_address\":\"stake1...\",\"total_balance\":"
+                   "\"1234567890\"}]";
+      reply.latencyMs = slowKoios ? KOIOS_TIMEOUT_MS : KOIOS_LATENCY_MS;
+      slowKoios = false;
+    } else if (request.url.find("/portfolio/tokens") != std::string::npos) {
+      reply.code = 200;
+      reply.body = minswap;
+      reply.latencyMs = MINSWAP_LATENCY_MS;
+    } else if (request.url.find("/policy/detail") != std::string::npos) {
+      reply.latencyMs = CEXPLORER_LATENCY_MS;
+      for (const portfolio::Collection &collection : wallet.collections) {
+        if (request.url.find(collection.policyId) != std::string::npos) {
+          reply.code = 200;
+          reply.body = portfolio::cexplorerJson(collection);
+        }
+      }
+    }
+    return reply;
+  });
+
+  // setup()
+  loopProfilerBegin(NAMES, SECTIONS, BUDGET_MS);
+  wifiManagerSetup("hostsim", "secret");
+  initDataFetcher();
+
+  std::mt19937 random(7);
+  std::vector<uint32_t> frames; // Ticker frame times of this window
+  std::vector<WindowCheck> windows;
+  std::vector<LoopStall> stalls;
+  const unsigned long setupMs = millis();
+  unsigned long windowStartMs = 0;
+  bool started = false;
+  unsigned long lastScreenMs = millis();
+  bool slowKoiosDone = false;
+  bool slowScreenDone = false;
+  uint32_t stallsSeen = 0;
+
+  while ((int)windows.size() < minutes) {
+    const unsigned long now = millis();
+    const bool windowEnds = started && now - windowStartMs >= 60000UL;
+    loopProfilerStart();
+    if (!started) {
+      started = true;
+      windowStartMs = now;
+    }
+    if (loopProfilerStallCount() != stallsSeen) {
+      stallsSeen = loopProfilerStallCount();
+      stalls.push_back(loopProfilerLastStall());
+    }
+    if (windowEnds) {
+      // The profiler published the window that just ended
+      WindowCheck check;
+      const LoopSectionStats loop = loopProfilerLoop();
+      const LoopSectionStats ticker = loopProfilerSection(TICKER);
+      check.loops = loop.calls;
+      check.loopMaxMs = loop.maxMicros / 1000.0;
+      check.loopP99Ms = loop.p99Micros / 1000.0;
+      check.slowest = loopProfilerSlowest();
+      check.tickerP99Us = ticker.p99Micros;
+      check.tickerMaxUs = ticker.maxMicros;
+      check.exactP99Us = exactP99(frames);
+      check.exactMaxUs = *std::max_element(frames.begin(), frames.end());
+      check.shareSum = 0;
+      for (int i = 0; i <= loopProfilerSectionCount(); i++) {
+        check.shareSum += loopProfilerSection(i).sharePercent;
+      }
+      windows.push_back(check);
+      frames.clear();
+      windowStartMs = now;
+    }
+
+    wifiManagerLoop();
+    loopProfilerDone(WIFI);
+
+    if (!slowKoiosDone && now - setupMs >= SLOW_KOIOS_AFTER_MS) {
+      slowKoiosDone = true;
+      slowKoios = true; // The next balance request runs into its timeout
+    }
+    updateDataStep();
+    loopProfilerDone(FETCH);
+
+    if (now - lastScreenMs >= SCREEN_INTERVAL_MS) {
+      if (!slowScreenDone && now - setupMs >= SLOW_SCREEN_AFTER_MS) {
+        slowScreenDone = true;
+        delayMicroseconds(SCREEN_HANG_US);
+      } else {
+        delayMicroseconds(SCREEN_DRAW_US);
+      }
+      lastScreenMs = now;
+    }
+    loopProfilerDone(SCREEN);
+
+    const unsigned int frameUs = tickerFrameUs(random);
+    delayMicroseconds(frameUs);
+    frames.push_back(frameUs);
+    loopProfilerDone(TICKER);
+  }
+
+  // Checks
+  bool ok = true;
+  if (stalls.size() != 2) {
+    fprintf(stderr, "%zu stalls instead of 2\n", stalls.size());
+    ok = false;
+  } else {
+    if (std::string(stalls[0].section) != "fetch" ||
+        stalls[0].sectionMicros < KOIOS_TIMEOUT_MS * 1000UL ||
+        stalls[0].sectionMicros > (KOIOS_TIMEOUT_MS + 50) * 1000UL) {
+      fprintf(stderr, "Slow Koios request: blamed on %s, %u us\n",
+              stalls[0].section, stalls[0].sectionMicros);
+      ok = false;
+    }
+    if (std::string(stalls[1].section) != "screen" ||
+        std::fabs((double)stalls[1].sectionMicros - SCREEN_HANG_US) > 2000) {
+      fprintf(stderr, "Slow screen draw: blamed on %s, %u us\n",
+              stalls[1].section, stalls[1].sectionMicros);
+      ok = false;
+    }
+  }
+  for (size_t i = 0; i < windows.size(); i++) {
+    const WindowCheck &check = windows[i];
+    if (check.tickerP99Us < check.exactP99Us ||
+        check.tickerP99Us > check.exactP99Us * 1.25 ||
+        check.tickerMaxUs != check.exactMaxUs) {
+      fprintf(stderr, "Minute %zu: ticker p99 %u us (exact %u), max %u us "
+              "(exact %u)\n", i + 1, check.tickerP99Us, check.exactP99Us,
+              check.tickerMaxUs, check.exactMaxUs);
+      ok = false;
+    }
+    if (std::fabs(check.shareSum - 100.0) > 1.0) {
+      fprintf(stderr, "Minute %zu: shares add up to %.1f%%\n", i + 1,
+              check.shareSum);
+      ok = false;
+    }
+  }
+
+  printf("loop() profiler benchmark: CardanoTicker loop() without MQTT, "
+         "budget %lu ms, %d minutes\n\n", BUDGET_MS, minutes);
+  printf("Checks:  the two injected stalls are logged and blamed on the right "
+         "call, ticker p99 within\n         25%% of exact, shares add up to "
+         "100%%\n\n");
+  printf("  %-6s %7s %10s %10s  %-8s %10s %11s %11s\n", "minute", "loops",
+         "max ms", "p99 ms", "slowest", "its max ms", "frame p99", "exact p99");
+  for (size_t i = 0; i < windows.size(); i++) {
+    const WindowCheck &check = windows[i];
+    printf("  %-6zu %7u %10.1f %10.1f  %-8s %10.1f %8.1f ms %8.1f ms\n",
+           i + 1, check.loops, check.loopMaxMs, check.loopP99Ms,
+           check.slowest.name, check.slowest.maxMicros / 1000.0,
+           check.tickerP99Us / 1000.0, check.exactP99Us / 1000.0);
+  }
+  printf("\n  Stalls logged:\n");
+  for (const LoopStall &stall : stalls) {
+    printf("    after %5.1f s: loop() %.1f ms, %s %.1f ms\n",
+           (stall.atMs - setupMs) / 1000.0, stall.loopMicros / 1000.0,
+           stall.section, stall.sectionMicros / 1000.0);
+  }
+  printf("\n  One mark (loopProfilerStart() or loopProfilerDone()): %.0f ns on "
+         "this computer\n", markNs);
+  printf("\n(Simulated clock for the loop; the mark cost is real time on the "
+         "host, not the ESP32.)\n");
+  return ok ? 0 : 1;
+}
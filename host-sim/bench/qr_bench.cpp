@@ -0,0 +1,133 @@
+/**
+ * qr_bench.cpp - Host benchmark for the cardano-pos QR pipeline
+ *
+ * Encodes 1,000 random web+cardano: invoice URIs with qr_matrix.cpp and
+ * reports encode time, chosen QR versions, and how much data the run-length
+ * drawing sends to the panel compared to the old full-colour sprite.
+ *
+ * Usage: ./bin/qr_bench [count] [seed]
+ */
+
+#include "qr_matrix.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+// CYD in portrait: 240x320, QR box is min(w, h) - 20 pixels square
+const int BOX_SIZE = 240 - 20;
+
+// Approximate bytes per fillRect() for address window and write commands
+const int RECT_COMMAND_BYTES = 11;
+
+const char *BECH32_CHARSET = "qpzry9x8gf2tvdw0s3jn54khce6mua7l";
+
+std::string randomAddress(std::mt19937 &rng) {
+  // Mix of mainnet/testnet base and enterprise addresses
+  static const struct {
+    const char *prefix;
+    int dataChars;
+  } kinds[] = {
+      {"addr1", 98}, {"addr_test1", 98}, {"addr1", 53}, {"addr_test1", 53}};
+  const auto &kind = kinds[rng() % 4];
+  std::string address = kind.prefix;
+  for (int i = 0; i < kind.dataChars; i++) {
+    address += BECH32_CHARSET[rng() % 32];
+  }
+  return address;
+}
+
+std::string randomInvoiceUri(std::mt19937 &rng) {
+  // 0.1 to 20,000 ADA, always printed with 6 decimals like the firmware
+  uint64_t lovelace = 100000 + rng() % 20000000000ULL;
+  char amount[32];
+  snprintf(amount, sizeof(amount), "%llu.%06llu",
+           (unsigned long long)(lovelace / 1000000),
+           (unsigned long long)(lovelace % 1000000));
+  return "web+cardano:" + randomAddress(rng) + "?amount=" + amount;
+}
+
+double percentile(std::vector<double> values, double p) {
+  std::sort(values.begin(), values.end());
+  size_t index = (size_t)(p * (values.size() - 1));
+  return values[index];
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  int count = argc > 1 ? atoi(argv[1]) : 1000;
+  unsigned seed = argc > 2 ? (unsigned)atoi(argv[2]) : 42;
+  std::mt19937 rng(seed);
+
+  static QrMatrix matrix;
+  std::vector<double> encodeUs;
+  std::vector<double> rectCounts;
+  std::vector<double> spiBytes;
+  int versionCount[QR_MAX_VERSION + 1] = {0};
+  int eccCount[4] = {0};
+  size_t uriLengthSum = 0;
+
+  for (int i = 0; i < count; i++) {
+    std::string uri = randomInvoiceUri(rng);
+    uriLengthSum += uri.size();
+
+    auto start = std::chrono::steady_clock::now();
+    if (!qrEncode(uri.c_str(), uri.size(), matrix)) {
+      fprintf(stderr, "encode failed for %s\n", uri.c_str());
+      return 1;
+    }
+    auto end = std::chrono::steady_clock::now();
+    encodeUs.push_back(
+        std::chrono::duration<double, std::micro>(end - start).count());
+    versionCount[matrix.version]++;
+    eccCount[matrix.ecc]++;
+
+    // Same scaling as drawQRMatrix() in transaction_qr.cpp
+    int scale = std::max(1, BOX_SIZE / (matrix.size + 4));
+    long rects = 0;
+    long bytes = 0;
+    for (int y = 0; y < matrix.size; y++) {
+      int runStart = 0, runLength = 0, x = 0;
+      while (qrNextDarkRun(matrix, y, x, runStart, runLength)) {
+        rects++;
+        bytes += RECT_COMMAND_BYTES + (long)runLength * scale * scale * 2;
+        x = runStart + runLength;
+      }
+    }
+    rectCounts.push_back((double)rects);
+    spiBytes.push_back((double)bytes);
+  }
+
+  const long spriteBytes = (long)BOX_SIZE * BOX_SIZE * 2;
+  double meanSpi = 0;
+  for (double b : spiBytes) {
+    meanSpi += b;
+  }
+  meanSpi /= spiBytes.size();
+
+  printf("QR benchmark: %d invoice URIs (seed %u), mean URI length %.1f\n",
+         count, seed, (double)uriLengthSum / count);
+  printf("Encode time (us):  p50 %.1f  p95 %.1f  p99 %.1f  max %.1f\n",
+         percentile(encodeUs, 0.50), percentile(encodeUs, 0.95),
+         percentile(encodeUs, 0.99), percentile(encodeUs, 1.0));
+  printf("Versions used:");
+  for (int v = 1; v <= QR_MAX_VERSION; v++) {
+    if (versionCount[v] > 0) {
+      printf("  v%d x%d", v, versionCount[v]);
+    }
+  }
+  printf("\nECC levels used:  L x%d  M x%d  Q x%d  H x%d\n", eccCount[0],
+         eccCount[1], eccCount[2], eccCount[3]);
+  printf("fillRect calls:    p50 %.0f  p99 %.0f\n", percentile(rectCounts, 0.5),
+         percentile(rectCounts, 0.99));
+  printf("SPI bytes per QR:  mean %.0f (old sprite push: %ld, %.1f%%)\n",
+         meanSpi, spriteBytes, 100.0 * meanSpi / spriteBytes);
+  printf("RAM: QrMatrix %zu bytes (old sprite buffer: %ld bytes)\n",
+         sizeof(QrMatrix), spriteBytes);
+  return 0;
+}
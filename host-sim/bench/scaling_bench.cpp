@@ -0,0 +1,316 @@
+/**
+ * scaling_bench.cpp - CardanoTicker portfolio parsing, small to huge wallets
+ *
+ * Generates wallets from 8 to 5,000 assets (fixtures/portfolio_json.h,
+ * generate(Shape)): tokens, NFTs spread over collections a few large and
+ * many small, metadata of a given length. For each it measures:
+ * - The ticker's MinSwap step, updateDataStep() in data_fetcher.cpp as
+ *   shipped: time, peak heap, and whether the tokens made it to the screens
+ * - Parsing and grouping the whole answer: deserializeJson() into a
+ *   document large enough, then readMinSwapPositions(), the ticker's own
+ *   code that groups the NFTs by Policy ID and reads the tokens. This is
+ *   what the ticker would do with its 8 KB document lifted; it still keeps
+ *   8 collections, and reads every NFT to count theirs.
+ * - Walking the same NFTs, reading each Policy ID without grouping: what
+ *   any pass over the document costs on this computer
+ * - The document size that needs, against the ticker's 8 KB
+ * - The MinSwap step on the model of the ESP32's heap (160 KB free):
+ *   allocations that would fail, and the lowest free heap
+ *
+ * It prints a table and writes bin/scaling_bench.csv for plotting, and
+ * fails when time grows faster than n^1.5, memory faster than n^1.2, or
+ * grouping faster than the walk by more than n^0.2, from 1,000 to 5,000
+ * NFTs, so a change that makes parsing or grouping quadratic is caught.
+ *
+ * Usage: ./bin/scaling_bench [iterations] [description length] [attributes]
+ */
+
+#include "data_fetcher.h"
+#include "hostsim.h"
+#include "portfolio_json.h"
+#include "wifi_manager.h"
+
+#include <ArduinoJson.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+const char *CSV_PATH = "bin/scaling_bench.csv";
+const size_t TICKER_DOCUMENT = 8192; // DynamicJsonDocument in data_fetcher
+const size_t HEAP_MODEL_BYTES = 160 * 1024;
+// Growth allowed from 1,000 to 5,000 NFTs (see main())
+const double MAX_TIME_SLOPE = 1.5;
+const double MAX_MEMORY_SLOPE = 1.2;
+// The document of 5,000 NFTs is many times the CPU's caches, so on the
+// computer even the walk, one read per NFT, grows faster than n. Grouping
+// is held to the walk: a linear table grows as fast, a quadratic one about
+// n^1 faster.
+const double MAX_SLOPE_OVER_WALK = 0.2;
+
+// What the ticker shows, at most (MAX_TOKENS and MAX_NFTS in data_fetcher)
+const int SHOWN = 8;
+
+volatile unsigned walkResult = 0; // So the walk's reads are not left out
+
+// Tokens, NFTs, collections
+const int SIZES[][3] = {{4, 4, 2},        {8, 16, 6},        {12, 64, 16},
+                        {20, 250, 40},    {30, 1000, 100},   {40, 2500, 200},
+                        {50, 5000, 300}};
+
+double nowUs() {
+  return std::chrono::duration<double, std::micro>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// The fastest run: the one least disturbed by the rest of the computer
+double fastest(const std::vector<double> &values) {
+  return *std::min_element(values.begin(), values.end());
+}
+
+struct Row {
+  int tokens = 0;
+  int nfts = 0;
+  int collections = 0;
+  size_t bytes = 0;       // MinSwap answer
+  double stepUs = 0;      // updateDataStep(), fastest
+  size_t stepHeap = 0;    // Its peak heap
+  bool shown = false;     // The tokens reached the screens
+  int tokensShown = 0;
+  double parseUs = 0;     // Whole answer parsed, fastest
+  double groupUs = 0;     // Its NFTs grouped, fastest
+  double walkUs = 0;      // Its NFTs walked, fastest
+  size_t document = 0;    // Document memory that needed
+  int groups = 0;         // Collections found
+  bool grouped = false;   // As many collections and tokens as it shows
+  uint64_t failures = 0;  // Allocations failing on the heap model
+  size_t minFree = 0;     // Lowest free heap on the model
+  int assets() const { return tokens + nfts; }
+};
+
+// The MinSwap step: initDataFetcher() leaves the balance and the portfolio
+// due; the balance goes first, so the next step is MinSwap's
+uint8_t minswapStep(double *us) {
+  initDataFetcher();
+  hostsim::advanceClock(1000); // millis() 0 means "never fetched"
+  updateKoiosData();
+  const double start = nowUs();
+  const uint8_t changed = updateDataStep();
+  *us = nowUs() - start;
+  return changed;
+}
+
+// Every NFT's Policy ID read, as grouping does, but nothing done with it.
+// Returns a sum of the characters, for walkResult.
+unsigned walkNfts(DynamicJsonDocument &doc) {
+  unsigned sum = 0;
+  for (JsonObject nft : doc["positions"]["nft_positions"].as<JsonArray>()) {
+    const char *hex = nft["currency_symbol"];
+    for (const char *c = hex; c != nullptr && *c != '\0'; c++) {
+      sum += (unsigned char)*c;
+    }
+  }
+  return sum;
+}
+
+Row measure(const int size[3], int iterations, size_t descriptionLength,
+            int attributes, std::string &minswap) {
+  portfolio::Shape shape;
+  shape.tokens = size[0];
+  shape.nfts = size[1];
+  shape.collections = size[2];
+  shape.descriptionLength = descriptionLength;
+  shape.attributes = attributes;
+  shape.seed = 1000 + size[1];
+  const portfolio::Portfolio wallet = portfolio::generate(shape);
+  minswap = portfolio::minswapJson(wallet, shape.seed);
+
+  Row row;
+  row.tokens = (int)wallet.tokens.size();
+  row.nfts = portfolio::nftCount(wallet);
+  row.collections = (int)wallet.collections.size();
+  row.bytes = minswap.size();
+
+  std::vector<double> times;
+  for (int i = 0; i < iterations; i++) {
+    double us = 0;
+    hostsim::heapResetPeak();
+    const size_t heapBefore = hostsim::heapLiveBytes();
+    const uint8_t changed = minswapStep(&us);
+    row.stepHeap =
+        std::max(row.stepHeap, hostsim::heapPeakBytes() - heapBefore);
+    row.shown = (changed & DATA_TOKENS) != 0;
+    times.push_back(us);
+  }
+  row.stepUs = fastest(times);
+  row.tokensShown = getTokenCount();
+
+  // A document twice the answer is always large enough
+  DynamicJsonDocument doc(std::max(TICKER_DOCUMENT, 2 * minswap.size()));
+  times.clear();
+  std::vector<double> groupTimes;
+  std::vector<double> walkTimes;
+  unsigned walked = 0;
+  for (int i = 0; i < iterations; i++) {
+    const double start = nowUs();
+    if (deserializeJson(doc, minswap)) {
+      fprintf(stderr, "%d assets: the answer does not parse\n", row.assets());
+      break;
+    }
+    const double parsed = nowUs();
+    row.groups = readMinSwapPositions(doc);
+    times.push_back(parsed - start);
+    groupTimes.push_back(nowUs() - parsed);
+
+    // Parsed again, so the walk starts where grouping did, not after it
+    deserializeJson(doc, minswap);
+    const double walkStart = nowUs();
+    walked += walkNfts(doc);
+    walkTimes.push_back(nowUs() - walkStart);
+  }
+  row.grouped = row.groups == std::min(row.collections, SHOWN) &&
+                getTokenCount() == std::min(row.tokens, SHOWN);
+  row.parseUs = times.empty() ? 0 : fastest(times);
+  row.groupUs = groupTimes.empty() ? 0 : fastest(groupTimes);
+  row.walkUs = walkTimes.empty() ? 0 : fastest(walkTimes);
+  walkResult = walked;
+  row.document = doc.memoryUsage();
+
+  hostsim::useHeapModel(HEAP_MODEL_BYTES);
+  double us = 0;
+  minswapStep(&us);
+  const hostsim::HeapModelStats heap = hostsim::heapModelStats();
+  hostsim::useHeapModel(0);
+  row.failures = heap.failures;
+  row.minFree = heap.minFreeBytes;
+  return row;
+}
+
+// Growth of value with the asset count between two wallets: 1 is linear,
+// 2 quadratic
+double slope(const Row &a, double aValue, const Row &b, double bValue) {
+  return std::log(bValue / aValue) / std::log((double)b.assets() / a.assets());
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  const int iterations = argc > 1 ? atoi(argv[1]) : 21;
+  const size_t descriptionLength = argc > 2 ? (size_t)atol(argv[2]) : 85;
+  const int attributes = argc > 3 ? atoi(argv[3]) : 2;
+  if (iterations < 1 || attributes < 0) {
+    fprintf(stderr, "Run at least 1 iteration, with 0 or more attributes\n");
+    return 1;
+  }
+  hostsim::setSerialEcho(false);
+  hostsim::useVirtualClock(true);
+  hostsim::setWiFiConnected(true);
+  wifiManagerSetup("hostsim", "");
+  while (!wifiManagerIsConnected()) { // As setup() waits for WiFi
+    delay(10);
+    wifiManagerLoop();
+  }
+
+  std::string minswap;
+  const std::string koios = portfolio::koiosJson(1234567890);
+  hostsim::setHttpHandler([&](const hostsim::HttpRequest &request) {
+    hostsim::HttpResponse reply;
+    reply.code = 404;
+    if (request.url.find("account_info") != std::string::npos) {
+      reply.code = 200;
+      reply.body = koios;
+    } else if (request.url.find("/portfolio/tokens") != std::string::npos) {
+      reply.code = 200;
+      reply.body = minswap;
+    }
+    return reply;
+  });
+
+  printf("CardanoTicker portfolio parsing by wallet size: %d iterations, "
+         "%zu character descriptions, %d NFT attributes\n\n",
+         iterations, descriptionLength, attributes);
+  printf("%6s %5s %6s %9s | %9s %9s %6s %7s %7s | %9s %9s %9s %9s %6s\n",
+         "assets", "NFTs", "colls", "answer", "step us", "heap", "shown",
+         "fails", "min free", "parse us", "group us", "walk us", "document",
+         "groups");
+
+  std::vector<Row> rows;
+  bool ok = true;
+  for (const auto &size : SIZES) {
+    const Row row =
+        measure(size, iterations, descriptionLength, attributes, minswap);
+    printf("%6d %5d %6d %8.1fK | %9.0f %8.1fK %6s %7llu %6.1fK | %9.0f "
+           "%9.1f %9.1f %8.1fK %6d\n",
+           row.assets(), row.nfts, row.collections, row.bytes / 1024.0,
+           row.stepUs, row.stepHeap / 1024.0, row.shown ? "yes" : "no",
+           (unsigned long long)row.failures, row.minFree / 1024.0,
+           row.parseUs, row.groupUs, row.walkUs, row.document / 1024.0,
+           row.groups);
+    // The ticker shows the tokens exactly when its document is large enough
+    if (row.shown != (row.document <= TICKER_DOCUMENT) ||
+        (row.shown && row.tokensShown != std::min(row.tokens, SHOWN))) {
+      fprintf(stderr, "%d assets: the ticker's result does not match the "
+              "document size needed\n", row.assets());
+      ok = false;
+    }
+    if (!row.grouped) {
+      fprintf(stderr, "%d assets: %d collections found, %d in the wallet, "
+              "or the tokens read wrong\n",
+              row.assets(), row.groups, row.collections);
+      ok = false;
+    }
+    rows.push_back(row);
+  }
+
+  FILE *csv = fopen(CSV_PATH, "w");
+  if (csv != nullptr) {
+    fprintf(csv, "assets,nfts,collections,answer_bytes,step_us,step_heap,"
+                 "shown,heap_failures,min_free_heap,parse_us,group_us,walk_us,"
+                 "document_bytes\n");
+    for (const Row &row : rows) {
+      fprintf(csv, "%d,%d,%d,%zu,%.1f,%zu,%d,%llu,%zu,%.1f,%.1f,%.1f,%zu\n",
+              row.assets(), row.nfts, row.collections, row.bytes, row.stepUs,
+              row.stepHeap, row.shown ? 1 : 0,
+              (unsigned long long)row.failures, row.minFree, row.parseUs,
+              row.groupUs, row.walkUs, row.document);
+    }
+    fclose(csv);
+    printf("\nWrote %s\n", CSV_PATH);
+  }
+
+  // How fast each grows from 1,000 to 5,000 NFTs: 1 is linear, 2 quadratic
+  const Row &a = rows[rows.size() - 3];
+  const Row &b = rows.back();
+  const double walkSlope = slope(a, a.walkUs, b, b.walkUs);
+  const struct {
+    const char *name;
+    double slope;
+    double limit;
+  } growth[] = {
+      {"step time", slope(a, a.stepUs, b, b.stepUs), MAX_TIME_SLOPE},
+      {"step heap", slope(a, a.stepHeap, b, b.stepHeap), MAX_MEMORY_SLOPE},
+      {"parse time", slope(a, a.parseUs, b, b.parseUs), MAX_TIME_SLOPE},
+      {"group time", slope(a, a.groupUs, b, b.groupUs),
+       walkSlope + MAX_SLOPE_OVER_WALK},
+      {"document", slope(a, a.document, b, b.document), MAX_MEMORY_SLOPE},
+  };
+  printf("\nGrowth from %d to %d assets (1 = linear, 2 = quadratic): "
+         "walk time %.2f",
+         a.assets(), b.assets(), walkSlope);
+  for (const auto &item : growth) {
+    printf(" %s %.2f", item.name, item.slope);
+    if (item.slope > item.limit) {
+      fprintf(stderr, "\n%s grows as n^%.2f, more than n^%.2f\n", item.name,
+              item.slope, item.limit);
+      ok = false;
+    }
+  }
+  printf("\n(Host CPU time with HTTP stubbed, no latency. Compare versions "
+         "with it; the ESP32 is much slower.)\n");
+  return ok ? 0 : 1;
+}
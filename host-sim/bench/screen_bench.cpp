@@ -0,0 +1,258 @@
+/**
+ * screen_bench.cpp - Host benchmark for CardanoTicker's drawing code
+ *
+ * Draws the ticker's screens with the firmware's own screen_helper.cpp,
+ * wallet, token, NFT and status screens and ticker.cpp into the framebuffer
+ * of the TFT_eSPI stand-in (arduino/TFT_eSPI.h), with a wallet fetched
+ * through data_fetcher.cpp from stubbed APIs. For each of renderHeader(),
+ * drawWalletScreen(), drawTokenScreen(), drawNFTScreen(), drawStatusScreen()
+ * and updateTicker() it reports per frame:
+ * - CPU time on this computer (drawing into sprites and the framebuffer;
+ *   only for comparing two versions of the code)
+ * - the bytes TFT_eSPI would send over SPI, the address windows and the
+ *   pixels, and what that takes at 40 MHz
+ * - the bytes per kind of call (fills, lines, circles, text, sprite pushes)
+ *
+ * Each is first drawn once, in the same state on every run, and the display
+ * after it is saved as PNG (bin/screens/wallet.png...) and its CRC-32
+ * compared with the one in fixtures/screens.golden; the program fails when
+ * one differs. After a change to the drawing code that
+ * is meant to change the pixels, look at the PNGs and run it with --update
+ * to write the new CRCs.
+ *
+ * Usage: ./bin/screen_bench [frames] [folder for PNGs] [--update]
+ */
+
+#include "config.h"
+#include "data_fetcher.h"
+#include "datascreens.h"
+#include "hostsim.h"
+#include "portfolio_json.h"
+#include "screen_helper.h"
+#include "ticker.h"
+#include "wifi_manager.h"
+
+#include <TFT_eSPI.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+// The display the firmware draws on (defined in CardanoTicker.ino)
+TFT_eSPI tft = TFT_eSPI();
+
+namespace {
+const uint32_t SPI_HZ = 40000000; // TFT_eSPI's usual SPI_FREQUENCY
+const int DEFAULT_FRAMES = 200;
+const char *DEFAULT_PNG_DIR = "bin/screens";
+const char *GOLDEN_PATH = "fixtures/screens.golden";
+
+struct Case {
+  const char *name; // Also the PNG file name
+  std::function<void()> draw;
+};
+
+struct Result {
+  double cpuUs = 0;
+  TFT_eSPI::Stats stats; // For all frames
+  uint32_t crc = 0;
+};
+
+// name -> CRC-32, one "name crc" per line
+std::map<std::string, uint32_t> readGolden(const char *path) {
+  std::map<std::string, uint32_t> golden;
+  FILE *file = fopen(path, "r");
+  if (file == nullptr) {
+    return golden;
+  }
+  char name[64];
+  unsigned crc;
+  while (fscanf(file, "%63s %x", name, &crc) == 2) {
+    golden[name] = crc;
+  }
+  fclose(file);
+  return golden;
+}
+
+double perFrame(uint64_t total, int frames) { return (double)total / frames; }
+} // namespace
+
+int main(int argc, char **argv) {
+  bool update = false;
+  std::vector<const char *> args;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--update") == 0) {
+      update = true;
+    } else {
+      args.push_back(argv[i]);
+    }
+  }
+  const int frames = args.size() > 0 ? atoi(args[0]) : DEFAULT_FRAMES;
+  const std::string pngDir = args.size() > 1 ? args[1] : DEFAULT_PNG_DIR;
+  if (frames < 1) {
+    fprintf(stderr, "Draw at least 1 frame\n");
+    return 1;
+  }
+  hostsim::setSerialEcho(false);
+  hostsim::useVirtualClock(true);
+  hostsim::clearNvs();
+
+  // A wallet with 6 tokens and 4 NFT collections, fetched by the firmware
+  portfolio::Portfolio wallet = portfolio::generate(6, 4, 3, 7);
+  std::string minswap = portfolio::minswapJson(wallet, 7);
+  hostsim::setHttpHandler([&](const hostsim::HttpRequest &request) {
+    hostsim::HttpResponse reply;
+    reply.code = 404;
+    if (request.url.find("account_info") != std::string::npos) {
+      reply.code = 200;
+      reply.body = "[{\"stake_address\":\"stake1...\",\"total_balance\":"
+                   "\"1234567890\"}]";
+    } else if (request.url.find("/portfolio/tokens") != std::string::npos) {
+      reply.code = 200;
+      reply.body = minswap;
+    } else if (request.url.find("/policy/detail") != std::string::npos) {
+      for (const portfolio::Collection &collection : wallet.collections) {
+        if (request.url.find(collection.policyId) != std::string::npos) {
+          reply.code = 200;
+          reply.body = portfolio::cexplorerJson(collection);
+        }
+      }
+    }
+    return reply;
+  });
+
+  tft.init();
+  tft.setRotation(1);
+  wifiManagerSetup("hostsim", "secret");
+  initDataFetcher();
+  while (millis() < 30000) {
+    wifiManagerLoop();
+    updateDataStep();
+    delay(10);
+  }
+  if (getTokenCount() == 0 || getNftCount() == 0) {
+    fprintf(stderr, "The wallet was not fetched\n");
+    return 1;
+  }
+  initTicker();
+
+  // Drawing takes SPI time from here on
+  hostsim::setDisplaySpiClock(SPI_HZ);
+  const Case cases[] = {
+      {"header", [] { renderHeader("Wallet", 0); }},
+      {"wallet", [] { drawWalletScreen(); }},
+      {"tokens", [] { drawTokenScreen(); }},
+      {"nfts", [] { drawNFTScreen(); }},
+      {"status", [] { drawStatusScreen(); }},
+      {"ticker", [] { updateTicker(); }},
+  };
+
+  printf("CardanoTicker drawing, %d frames each, %dx%d display, SPI at %u "
+         "MHz\n\n", frames, tft.width(), tft.height(), SPI_HZ / 1000000);
+  printf("  %-8s %10s %10s %8s %10s %9s\n", "frame", "CPU us", "SPI bytes",
+         "windows", "pixels", "SPI ms");
+
+  // One frame each for the PNGs and CRCs, before the clock has moved on
+  std::filesystem::create_directories(pngDir);
+  bool ok = true;
+  std::vector<Result> results;
+  for (const Case &c : cases) {
+    Result result;
+    c.draw();
+    result.crc = tft.frameCrc();
+    const std::string path = pngDir + "/" + c.name + ".png";
+    if (!tft.savePng(path.c_str())) {
+      fprintf(stderr, "Cannot write %s\n", path.c_str());
+      ok = false;
+    }
+    results.push_back(result);
+  }
+
+  for (size_t i = 0; i < results.size(); i++) {
+    const Case &c = cases[i];
+    Result &result = results[i];
+    tft.resetStats();
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; i++) {
+      c.draw();
+    }
+    result.cpuUs = std::chrono::duration<double, std::micro>(
+                       std::chrono::steady_clock::now() - start)
+                       .count() /
+                   frames;
+    result.stats = tft.stats();
+
+    const double bytes = perFrame(result.stats.spiBytes, frames);
+    printf("  %-8s %10.1f %10.0f %8.0f %10.0f %9.2f\n", c.name, result.cpuUs,
+           bytes, perFrame(result.stats.windows, frames),
+           perFrame(result.stats.pixelsFilled, frames),
+           bytes * 8 * 1000.0 / SPI_HZ);
+  }
+
+  // Where the bytes go: per kind of call, and how much of it is pixels
+  printf("\n  SPI bytes per frame, by call (calls per frame)\n");
+  printf("  %-8s", "frame");
+  for (int call = 0; call < TFT_CALL_COUNT; call++) {
+    printf(" %16s", TFT_eSPI::callName((TftCall)call));
+  }
+  printf(" %9s\n", "pixels");
+  for (size_t i = 0; i < results.size(); i++) {
+    const TFT_eSPI::Stats &stats = results[i].stats;
+    printf("  %-8s", cases[i].name);
+    for (int call = 0; call < TFT_CALL_COUNT; call++) {
+      const TFT_eSPI::CallStats &byCall = stats.byCall[call];
+      if (byCall.calls == 0) {
+        printf(" %16s", "-");
+        continue;
+      }
+      char cell[32];
+      snprintf(cell, sizeof(cell), "%.0f (%.0f)",
+               perFrame(byCall.spiBytes, frames),
+               perFrame(byCall.calls, frames));
+      printf(" %16s", cell);
+    }
+    // Share of the bytes that are pixels, not commands and coordinates
+    const double pixelBytes = 2.0 * stats.pixelsFilled;
+    printf(" %8.0f%%\n",
+           stats.spiBytes ? 100.0 * pixelBytes / stats.spiBytes : 0.0);
+  }
+
+  // The frames against the golden CRCs
+  std::map<std::string, uint32_t> golden = readGolden(GOLDEN_PATH);
+  printf("\n  Frames (PNG in %s, CRC-32 against %s)\n", pngDir.c_str(),
+         GOLDEN_PATH);
+  for (size_t i = 0; i < results.size(); i++) {
+    auto expected = golden.find(cases[i].name);
+    const char *verdict = "new";
+    if (expected != golden.end()) {
+      verdict = expected->second == results[i].crc ? "same" : "DIFFERENT";
+      if (expected->second != results[i].crc && !update) {
+        ok = false;
+      }
+    }
+    printf("  %-8s %08x  %s\n", cases[i].name, results[i].crc, verdict);
+    golden[cases[i].name] = results[i].crc;
+  }
+  if (update) {
+    FILE *file = fopen(GOLDEN_PATH, "w");
+    if (file == nullptr) {
+      fprintf(stderr, "Cannot write %s\n", GOLDEN_PATH);
+      return 1;
+    }
+    for (const auto &entry : golden) {
+      fprintf(file, "%s %08x\n", entry.first.c_str(), entry.second);
+    }
+    fclose(file);
+    printf("\n  Wrote %s\n", GOLDEN_PATH);
+  } else if (!ok) {
+    fprintf(stderr, "\nFrames differ from %s: look at the PNGs, and run with "
+                    "--update if the change is meant\n", GOLDEN_PATH);
+  }
+  return ok ? 0 : 1;
+}
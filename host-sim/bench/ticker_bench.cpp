@@ -0,0 +1,266 @@
+/**
+ * ticker_bench.cpp - Host benchmark for CardanoTicker portfolio updates
+ *
+ * Runs the ticker's data_fetcher.cpp against stubbed APIs for a synthetic
+ * wallet (fixtures/portfolio_json.h), once asking MinSwap and Cexplorer for
+ * JSON as the ticker does by default, and once asking chain-gateway for a
+ * binary snapshot (ticker_snapshot.h). Reports bytes received, time and heap
+ * per portfolio update for both, and for an unchanged snapshot (304).
+ *
+ * Before timing anything both ways must produce the wallet's tokens and NFTs,
+ * and the snapshot reader must reject every truncated or corrupted snapshot.
+ *
+ * Usage: ./bin/ticker_bench [iterations] [tokens] [collections]
+ */
+
+#include "config.h"
+#include "data_fetcher.h"
+#include "hostsim.h"
+#include "portfolio_json.h"
+#include "ticker_snapshot.h"
+#include "wifi_manager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+const char *GATEWAY_URL = "http://gateway.local:8080/snapshot/ticker";
+
+double nowUs() {
+  return std::chrono::duration<double, std::micro>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+double percentile(std::vector<double> values, double p) {
+  std::sort(values.begin(), values.end());
+  size_t index = (size_t)(p * (values.size() - 1));
+  return values[index];
+}
+
+// What chain-gateway would send for this portfolio
+std::string buildSnapshot(const portfolio::Portfolio &wallet) {
+  SnapshotWriter writer;
+  for (const portfolio::Token &token : wallet.tokens) {
+    writer.addToken(token.ticker.c_str(), llround(token.amount * 1e6),
+                    llround(token.priceUsd * token.amount * 1e6),
+                    (int32_t)lround(token.change24h * 100));
+  }
+  for (const portfolio::Collection &collection : wallet.collections) {
+    writer.addNft(collection.name.c_str(), (uint32_t)collection.count,
+                  collection.floorLovelace);
+  }
+  uint8_t buffer[SNAPSHOT_MAX_SIZE];
+  size_t length = writer.finish(1760000000, buffer, sizeof(buffer));
+  return std::string((const char *)buffer, length);
+}
+
+bool matches(float actual, double expected) {
+  return std::fabs(actual - expected) <= 1e-5 * std::max(1.0, std::fabs(expected));
+}
+
+// The arrays the screens read must hold the wallet
+bool showsWallet(const portfolio::Portfolio &wallet) {
+  size_t tokens = std::min(wallet.tokens.size(), (size_t)SNAPSHOT_MAX_ITEMS);
+  size_t nfts =
+      std::min(wallet.collections.size(), (size_t)SNAPSHOT_MAX_ITEMS);
+  bool ok = getTokenCount() == (int)tokens && getNftCount() == (int)nfts;
+  for (size_t i = 0; ok && i < tokens; i++) {
+    const portfolio::Token &expected = wallet.tokens[i];
+    TokenInfo token = getToken((int)i);
+    ok = token.ticker == expected.ticker.c_str() &&
+         matches(token.amount, expected.amount) &&
+         matches(token.value, expected.priceUsd * expected.amount) &&
+         matches(token.change24h, expected.change24h);
+  }
+  for (size_t i = 0; ok && i < nfts; i++) {
+    const portfolio::Collection &expected = wallet.collections[i];
+    NFTInfo nft = getNFT((int)i);
+    ok = nft.name == expected.name.c_str() &&
+         matches(nft.amount, expected.count) &&
+         matches(nft.floorPrice, expected.floorLovelace / 1e6);
+  }
+  return ok;
+}
+
+bool checkSnapshotReader(const std::string &snapshot) {
+  const uint8_t *data = (const uint8_t *)snapshot.data();
+  SnapshotReader reader;
+  if (!reader.open(data, snapshot.size())) {
+    fprintf(stderr, "Snapshot rejected\n");
+    return false;
+  }
+  for (size_t length = 0; length < snapshot.size(); length++) {
+    if (reader.open(data, length)) {
+      fprintf(stderr, "Truncated snapshot (%zu bytes) accepted\n", length);
+      return false;
+    }
+  }
+  // Every changed byte is caught, except in the time it was made (bytes 4-7),
+  // which the content hash leaves out so unchanged content keeps its ETag
+  std::vector<uint8_t> corrupted(snapshot.begin(), snapshot.end());
+  for (size_t i = 0; i < corrupted.size(); i++) {
+    if (i >= 4 && i < 8) {
+      continue;
+    }
+    for (uint8_t flip : {0x01, 0x80, 0xff}) {
+      corrupted[i] ^= flip;
+      bool accepted = reader.open(corrupted.data(), corrupted.size());
+      corrupted[i] ^= flip;
+      if (accepted) {
+        fprintf(stderr, "Corrupted snapshot (byte %zu) accepted\n", i);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+struct Result {
+  std::vector<double> us;
+  uint64_t requests = 0;
+  uint64_t bytes = 0;
+  size_t heapPeak = 0;
+};
+
+// One portfolio update per iteration; keepSnapshot leaves the shown snapshot
+// in place so the gateway can answer 304
+Result run(int iterations, bool keepSnapshot) {
+  Result result;
+  result.us.reserve(iterations);
+  hostsim::HttpStats before = hostsim::httpStats();
+  for (int i = 0; i < iterations; i++) {
+    if (!keepSnapshot) {
+      initDataFetcher();
+    }
+    hostsim::advanceClock(11UL * 60UL * 1000UL); // Past the 10 minute interval
+    hostsim::heapResetPeak();
+    size_t heapBefore = hostsim::heapLiveBytes();
+    double start = nowUs();
+    updatePortfolioData();
+    result.us.push_back(nowUs() - start);
+    result.heapPeak =
+        std::max(result.heapPeak, hostsim::heapPeakBytes() - heapBefore);
+  }
+  hostsim::HttpStats after = hostsim::httpStats();
+  result.requests = (after.requests - before.requests) / iterations;
+  result.bytes = (after.bytesReceived - before.bytesReceived) / iterations;
+  return result;
+}
+
+void printRow(const char *name, const Result &result) {
+  printf("%-24s %8llu %10llu %9.1f %9.1f %11zu\n", name,
+         (unsigned long long)result.requests,
+         (unsigned long long)result.bytes, percentile(result.us, 0.50),
+         percentile(result.us, 0.95), result.heapPeak);
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  int iterations = argc > 1 ? atoi(argv[1]) : 500;
+  int tokenCount = argc > 2 ? atoi(argv[2]) : 8;
+  int collectionCount = argc > 3 ? atoi(argv[3]) : 6;
+  hostsim::setSerialEcho(false);
+  hostsim::useVirtualClock(true);
+  hostsim::setWiFiConnected(true);
+  wifiManagerSetup("hostsim", "");
+  while (!wifiManagerIsConnected()) { // As setup() waits for WiFi
+    delay(10);
+    wifiManagerLoop();
+  }
+
+  portfolio::Portfolio wallet =
+      portfolio::generate(tokenCount, collectionCount, 3, 42);
+  std::string minswap = portfolio::minswapJson(wallet, 42);
+  std::vector<std::string> cexplorer;
+  for (const portfolio::Collection &collection : wallet.collections) {
+    cexplorer.push_back(portfolio::cexplorerJson(collection));
+  }
+  std::string snapshot = buildSnapshot(wallet);
+  SnapshotReader reader;
+  reader.open((const uint8_t *)snapshot.data(), snapshot.size());
+  char etag[16];
+  snprintf(etag, sizeof(etag), "\"%08x\"", (unsigned)reader.contentHash());
+
+  hostsim::setHttpHandler([&](const hostsim::HttpRequest &request) {
+    hostsim::HttpResponse reply;
+    reply.code = 404;
+    if (request.url.find("/snapshot/ticker") != std::string::npos) {
+      auto known = request.headers.find("If-None-Match");
+      reply.code = known != request.headers.end() && known->second == etag
+                       ? 304
+                       : 200;
+      if (reply.code == 200) {
+        reply.body = snapshot;
+      }
+    } else if (request.url.find("/portfolio/tokens") != std::string::npos) {
+      reply.code = 200;
+      reply.body = minswap;
+    } else if (request.url.find("/policy/detail") != std::string::npos) {
+      for (size_t i = 0; i < wallet.collections.size(); i++) {
+        if (request.url.find(wallet.collections[i].policyId) !=
+            std::string::npos) {
+          reply.code = 200;
+          reply.body = cexplorer[i];
+        }
+      }
+    }
+    return reply;
+  });
+
+  // Checks
+  if (!checkSnapshotReader(snapshot)) {
+    return 1;
+  }
+  // The JSON path can fail for large wallets (its documents are 8 KB), which
+  // is reported but not fatal
+  initDataFetcher();
+  snapshotUrl = "";
+  updatePortfolioData();
+  bool jsonShowsWallet = showsWallet(wallet);
+  initDataFetcher();
+  snapshotUrl = GATEWAY_URL;
+  updatePortfolioData();
+  if (!showsWallet(wallet)) {
+    fprintf(stderr, "Snapshot: the ticker does not show the wallet\n");
+    return 1;
+  }
+
+  snapshotUrl = "";
+  Result json = run(iterations, false);
+  snapshotUrl = GATEWAY_URL;
+  Result binary = run(iterations, false);
+  Result unchanged = run(iterations, true);
+  if (!showsWallet(wallet)) {
+    fprintf(stderr, "Unchanged snapshot: the ticker does not show the wallet\n");
+    return 1;
+  }
+
+  printf("CardanoTicker portfolio update benchmark: %d iterations, %d tokens, "
+         "%d NFT collections\n\n",
+         iterations, tokenCount, collectionCount);
+  printf("Checks:  snapshot shows the wallet, truncated and corrupted "
+         "snapshots are rejected\n");
+  printf("         JSON %s\n\n",
+         jsonShowsWallet ? "shows the wallet"
+                         : "DOES NOT show the wallet (MinSwap answer too "
+                           "large for the 8 KB document)");
+  printf("%-24s %8s %10s %9s %9s %11s\n", "updatePortfolioData()",
+         "requests", "bytes", "p50 us", "p95 us", "heap peak");
+  printRow("MinSwap + Cexplorer JSON", json);
+  printRow("Snapshot", binary);
+  printRow("Snapshot, unchanged", unchanged);
+  printf("\nSnapshot vs JSON: %.0fx fewer bytes, %.0fx less time, %.0fx less "
+         "heap\n",
+         (double)json.bytes / binary.bytes,
+         percentile(json.us, 0.50) / percentile(binary.us, 0.50),
+         (double)json.heapPeak / std::max<size_t>(binary.heapPeak, 1));
+  printf("(Host CPU time with HTTP stubbed, no latency. Compare versions with "
+         "it; the ESP32 is much slower.)\n");
+  return 0;
+}
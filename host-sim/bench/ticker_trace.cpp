@@ -0,0 +1,362 @@
+/**
+ * ticker_trace.cpp - Trace of a CardanoTicker refresh cycle on the host
+ *
+ * Runs CardanoTicker's setup() and loop() steps (without MQTT) with the
+ * firmware's data_fetcher.cpp, ticker.cpp, screen_helper.cpp and screens
+ * against the simulated router and APIs, with trace.cpp recording from the
+ * first line of setup(): a first start, the staged fetch of balance, tokens,
+ * NFTs and floor prices, and then one full rotation of the four screens.
+ *
+ * The display is simulated at 40 MHz SPI (hostsim::setDisplaySpiClock()),
+ * so pushing the ticker sprite and drawing a screen take the time they take
+ * on the board, and the API latencies are those of loop_bench.
+ *
+ * The trace is written to bin/ticker_trace.json, to open at
+ * https://ui.perfetto.dev. The program then reads it back and checks:
+ * - every span that begins also ends, in order (B/E balanced per name)
+ * - timestamps never go backwards
+ * - the buffer did not fill up (nothing is missing)
+ * and prints a summary per span, and the longest gap between two ticker
+ * frames with the spans that caused it.
+ *
+ * It also measures what a trace point costs on this computer, recording
+ * and not recording, with the real clock.
+ *
+ * Usage: ./bin/ticker_trace [output.json] [SPI clock in Hz]
+ */
+
+#include "config.h"
+#include "data_fetcher.h"
+#include "datascreens.h"
+#include "hostsim.h"
+#include "portfolio_json.h"
+#include "screen_helper.h"
+#include "startscreen.h"
+#include "ticker.h"
+#include "trace.h"
+#include "wifi_manager.h"
+
+#include <TFT_eSPI.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+// The display the firmware draws on (defined in CardanoTicker.ino)
+TFT_eSPI tft = TFT_eSPI();
+
+namespace {
+const uint32_t KOIOS_LATENCY_MS = 300;
+const uint32_t MINSWAP_LATENCY_MS = 900;
+const uint32_t CEXPLORER_LATENCY_MS = 400;
+
+const uint32_t DEFAULT_SPI_HZ = 40000000; // TFT_eSPI's usual SPI_FREQUENCY
+const size_t TRACE_EVENTS = 40000;
+const unsigned long SCREEN_DURATION_MS = 10000; // As in CardanoTicker.ino
+const uint8_t SCREENS = 4;
+
+// Collects what traceDump() writes
+class StringPrint : public Print {
+public:
+  size_t write(uint8_t c) override {
+    text.push_back((char)c);
+    return 1;
+  }
+  size_t write(const uint8_t *buffer, size_t size) override {
+    text.append((const char *)buffer, size);
+    return size;
+  }
+  std::string text;
+};
+
+struct Event {
+  std::string name;
+  char phase;
+  uint64_t ts;
+};
+
+// One event per line, as trace.cpp writes them:
+// {"name":"...","ph":"B","ts":123,"pid":1,"tid":1}
+bool parseEvent(const std::string &line, Event &event) {
+  size_t name = line.find("{\"name\":\"");
+  size_t phase = line.find("\"ph\":\"");
+  size_t ts = line.find("\"ts\":");
+  if (name == std::string::npos || phase == std::string::npos ||
+      ts == std::string::npos) {
+    return false; // The metadata line has no timestamp
+  }
+  name += 9;
+  event.name = line.substr(name, line.find('"', name) - name);
+  event.phase = line[phase + 6];
+  event.ts = strtoull(line.c_str() + ts + 5, nullptr, 10);
+  return true;
+}
+
+struct SpanSummary {
+  uint32_t count = 0;
+  uint64_t totalUs = 0;
+  uint64_t maxUs = 0;
+};
+
+int screenIndex = 0;
+
+// showCurrentScreen() of CardanoTicker.ino
+void showCurrentScreen() {
+  TRACE_SCOPE("screen");
+  switch (screenIndex) {
+  case 0:
+    drawWalletScreen();
+    break;
+  case 1:
+    drawTokenScreen();
+    break;
+  case 2:
+    drawNFTScreen();
+    break;
+  default:
+    drawStatusScreen();
+    break;
+  }
+}
+
+// Nanoseconds per trace point, with the real clock
+double tracePointNs(bool recording) {
+  const int points = 100000; // Fits the buffer when recording
+  traceStart(points, true);
+  if (!recording) {
+    traceStop();
+  }
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < points / 2; i++) {
+    // Keeps the compiler from checking the flag once for the whole loop
+    asm volatile("" ::: "memory");
+    TRACE_BEGIN("bench");
+    TRACE_END("bench");
+  }
+  auto ns = std::chrono::duration<double, std::nano>(
+                std::chrono::steady_clock::now() - start)
+                .count();
+  traceFree();
+  return ns / points;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  const char *outPath = argc > 1 ? argv[1] : "bin/ticker_trace.json";
+  const uint32_t spiHz = argc > 2 ? (uint32_t)atol(argv[2]) : DEFAULT_SPI_HZ;
+  hostsim::setSerialEcho(false);
+
+  const double idleNs = tracePointNs(false);
+  const double recordNs = tracePointNs(true);
+
+  hostsim::useVirtualClock(true);
+  hostsim::setDisplaySpiClock(spiHz);
+  hostsim::clearNvs();
+  portfolio::Portfolio wallet = portfolio::generate(6, 4, 3, 7);
+  std::string minswap = portfolio::minswapJson(wallet, 7);
+  hostsim::setHttpHandler([&](const hostsim::HttpRequest &request) {
+    hostsim::HttpResponse reply;
+    reply.code = 404;
+    if (request.url.find("account_info") != std::string::npos) {
+      reply.code = 200;
+      reply.body = "[{\"stake_address\":\"stake1...\",\"total_balance\":"
+                   "\"1234567890\"}]";
+      reply.latencyMs = KOIOS_LATENCY_MS;
+    } else if (request.url.find("/portfolio/tokens") != std::string::npos) {
+      reply.code = 200;
+      reply.body = minswap;
+      reply.latencyMs = MINSWAP_LATENCY_MS;
+    } else if (request.url.find("/policy/detail") != std::string::npos) {
+      reply.latencyMs = CEXPLORER_LATENCY_MS;
+      for (const portfolio::Collection &collection : wallet.collections) {
+        if (request.url.find(collection.policyId) != std::string::npos) {
+          reply.code = 200;
+          reply.body = portfolio::cexplorerJson(collection);
+        }
+      }
+    }
+    return reply;
+  });
+
+  // setup(): first start, no saved data
+  const uint64_t startUs = hostsim::clockMicros();
+  traceStart(TRACE_EVENTS, true);
+  tft.init();
+  tft.setRotation(1);
+  displayStartScreen();
+  wifiManagerSetup("hostsim", "secret");
+  initDataFetcher();
+
+  // loop(): the start screen stays up until the first data is in, then the
+  // screens rotate every 10 s while the rest is fetched
+  bool started = false;
+  unsigned long lastScreenChange = 0;
+  uint8_t rotations = 0;
+  while (rotations < SCREENS) {
+    wifiManagerLoop();
+    const uint8_t changed = updateDataStep();
+    const unsigned long now = millis();
+    if (!started) {
+      if (changed != 0) {
+        initTicker();
+        showCurrentScreen();
+        updateTicker();
+        lastScreenChange = now;
+        started = true;
+      } else {
+        delay(10);
+      }
+      continue;
+    }
+    if (changed & DATA_TOKENS) {
+      refreshTicker();
+    }
+    const uint8_t shown[SCREENS] = {DATA_BALANCE, DATA_TOKENS, DATA_NFTS, 0};
+    if (changed & shown[screenIndex]) {
+      showCurrentScreen();
+    }
+    if (now - lastScreenChange >= SCREEN_DURATION_MS) {
+      screenIndex = (screenIndex + 1) % SCREENS;
+      TRACE_INSTANT("screen change");
+      showCurrentScreen();
+      lastScreenChange = now;
+      rotations++;
+    }
+    updateTicker();
+  }
+  const bool bufferFilled = !traceIsRecording();
+  const double simulatedS = (hostsim::clockMicros() - startUs) / 1e6;
+
+  StringPrint dump;
+  const size_t written = traceDump(dump);
+  FILE *file = fopen(outPath, "w");
+  if (file == nullptr) {
+    fprintf(stderr, "Cannot write %s\n", outPath);
+    return 1;
+  }
+  fwrite(dump.text.data(), 1, dump.text.size(), file);
+  fclose(file);
+
+  // Read the trace back
+  std::vector<Event> events;
+  size_t lineStart = 0;
+  while (lineStart < dump.text.size()) {
+    size_t lineEnd = dump.text.find('\n', lineStart);
+    if (lineEnd == std::string::npos) {
+      lineEnd = dump.text.size();
+    }
+    Event event;
+    if (parseEvent(dump.text.substr(lineStart, lineEnd - lineStart), event)) {
+      events.push_back(event);
+    }
+    lineStart = lineEnd + 1;
+  }
+
+  bool ok = true;
+  if (bufferFilled) {
+    fprintf(stderr, "The trace buffer filled up (%zu events)\n", TRACE_EVENTS);
+    ok = false;
+  }
+  if (events.size() != written) {
+    fprintf(stderr, "Read back %zu events, %zu were written\n", events.size(),
+            written);
+    ok = false;
+  }
+
+  std::vector<std::pair<std::string, uint64_t>> open; // Name, begin ts
+  std::map<std::string, SpanSummary> spans;
+  std::map<std::string, uint32_t> instants;
+  uint64_t lastTs = 0;
+  uint64_t lastFrameEnd = 0;
+  uint64_t longestGapUs = 0;
+  uint64_t longestGapAt = 0;
+  for (const Event &event : events) {
+    if (event.ts < lastTs) {
+      fprintf(stderr, "Time goes backwards at %s (%llu < %llu)\n",
+              event.name.c_str(), (unsigned long long)event.ts,
+              (unsigned long long)lastTs);
+      ok = false;
+    }
+    lastTs = event.ts;
+    if (event.phase == 'B') {
+      open.push_back({event.name, event.ts});
+    } else if (event.phase == 'E') {
+      if (open.empty() || open.back().first != event.name) {
+        fprintf(stderr, "End of %s at %llu does not match a begin\n",
+                event.name.c_str(), (unsigned long long)event.ts);
+        ok = false;
+        continue;
+      }
+      SpanSummary &span = spans[event.name];
+      const uint64_t us = event.ts - open.back().second;
+      span.count++;
+      span.totalUs += us;
+      span.maxUs = std::max(span.maxUs, us);
+      if (event.name == "ticker frame") {
+        if (lastFrameEnd != 0 && open.back().second - lastFrameEnd >
+                                     longestGapUs) {
+          longestGapUs = open.back().second - lastFrameEnd;
+          longestGapAt = lastFrameEnd;
+        }
+        lastFrameEnd = event.ts;
+      }
+      open.pop_back();
+    } else if (event.phase == 'i') {
+      instants[event.name]++;
+    }
+  }
+  if (!open.empty()) {
+    fprintf(stderr, "%zu spans never end, the first is %s\n", open.size(),
+            open.front().first.c_str());
+    ok = false;
+  }
+
+  // What ran between the two ticker frames furthest apart: the spans that
+  // began in the gap, at the outermost level
+  std::string gapCause;
+  int depth = 0;
+  for (const Event &event : events) {
+    if (event.ts < longestGapAt || event.ts > longestGapAt + longestGapUs) {
+      continue;
+    }
+    if (event.phase == 'B') {
+      if (depth == 0 && event.name != "ticker frame") {
+        gapCause += gapCause.empty() ? "" : ", ";
+        gapCause += event.name;
+      }
+      depth++;
+    } else if (event.phase == 'E' && depth > 0) {
+      depth--;
+    }
+  }
+
+  printf("Trace of a CardanoTicker first start and one screen rotation, "
+         "display at %.0f MHz SPI\n\n", spiHz / 1e6);
+  printf("Checks:  spans balanced and nested, timestamps in order, no events "
+         "lost\n\n");
+  printf("  %zu events over %.1f s (simulated), written to %s (%zu bytes)\n\n",
+         written, simulatedS, outPath, dump.text.size());
+  printf("  %-20s %7s %10s %10s %10s\n", "span", "count", "total ms",
+         "mean ms", "max ms");
+  for (const auto &entry : spans) {
+    const SpanSummary &span = entry.second;
+    printf("  %-20s %7u %10.1f %10.2f %10.1f\n", entry.first.c_str(),
+           span.count, span.totalUs / 1000.0,
+           span.totalUs / 1000.0 / span.count, span.maxUs / 1000.0);
+  }
+  for (const auto &entry : instants) {
+    printf("  %-20s %7u   (instant)\n", entry.first.c_str(), entry.second);
+  }
+  printf("\n  Longest gap between two ticker frames: %.1f ms at %.1f s, "
+         "during: %s\n", longestGapUs / 1000.0, longestGapAt / 1e6,
+         gapCause.empty() ? "-" : gapCause.c_str());
+  printf("\n  One trace point on this computer: %.1f ns not recording, "
+         "%.1f ns recording\n", idleNs, recordNs);
+  printf("\n(Simulated clock for the trace; the trace point cost is real time "
+         "on the host, not the ESP32.)\n");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,407 @@
+/**
+ * wifi_bench.cpp - Host benchmark for CardanoTicker WiFi (re)connects
+ *
+ * Runs the ticker's wifi_manager.cpp and data_fetcher.cpp on the simulated
+ * clock against the simulated router (hostsim::WiFiAccessPoint), and measures
+ * how long the ticker is without data:
+ * - boot with empty NVS (scan + DHCP), boot with the router remembered,
+ *   boot after the router moved to another channel (stale cache), and boots
+ *   with a router that hides its SSID (no scan finds it)
+ * - WiFi dropouts of a few seconds to a few minutes: from the network coming
+ *   back to the IP address, and to the first Koios answer
+ * - 45 minutes on the address reused after a dropout: DHCP must be asked
+ *   again once the lease may be running out
+ * - A device carried from the shop floor (two routers of network "shop") to
+ *   the back office (network "office"), one hour at each place, where the
+ *   router it is on gets weak: failed fetches and fetch times with and without
+ *   roaming, and with one network or both
+ *
+ * Every boot must end up connected, also to the hidden router, and ask DHCP
+ * (nobody knows how long the ticker was off), the stale cache must be replaced, and NVS must only be
+ * written when the router or address changed. A reused address must be
+ * renewed exactly once in the 45 minutes. Roaming must not fail more
+ * fetches than staying on one router.
+ *
+ * Usage: ./bin/wifi_bench [dropouts per length] [hours per place, >= 0.25]
+ */
+
+#include "config.h"
+#include "data_fetcher.h"
+#include "hostsim.h"
+#include "wifi_manager.h"
+
+#include <WiFi.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+const uint32_t KOIOS_LATENCY_MS = 300;
+const uint64_t GIVE_UP_MS = 10UL * 60UL * 1000UL;
+
+double percentile(std::vector<double> values, double p) {
+  std::sort(values.begin(), values.end());
+  size_t index = (size_t)(p * (values.size() - 1));
+  return values[index];
+}
+
+double clockMs() { return hostsim::clockMicros() / 1000.0; }
+
+// loop() of the ticker, as far as WiFi and Koios go: returns when the first
+// Koios request after `since` was answered, or after GIVE_UP_MS.
+// ipMs is set to when wifiManagerIsConnected() became true.
+double runUntilFetched(double since, double &ipMs) {
+  ipMs = -1;
+  uint64_t requestsBefore = hostsim::httpStats().requests;
+  while (clockMs() - since < GIVE_UP_MS) {
+    wifiManagerLoop();
+    if (wifiManagerIsConnected()) {
+      if (ipMs < 0) {
+        ipMs = clockMs();
+      }
+      updateKoiosData();
+      if (hostsim::httpStats().requests > requestsBefore) {
+        return clockMs();
+      }
+    }
+    delay(10);
+  }
+  return -1;
+}
+
+struct Boot {
+  double ipMs;
+  double dataMs;
+  uint64_t nvsWrites;
+};
+
+// Power on: setup() connects, then loop() fetches
+Boot boot() {
+  WiFi.disconnect(); // Power off
+  initDataFetcher();
+  uint64_t writesBefore = hostsim::nvsStats().writes;
+  double start = clockMs();
+  wifiManagerSetup("hostsim", "secret");
+  double ipMs;
+  double dataMs = runUntilFetched(start, ipMs);
+  Boot result;
+  result.ipMs = ipMs < 0 ? -1 : ipMs - start;
+  result.dataMs = dataMs < 0 ? -1 : dataMs - start;
+  result.nvsWrites = hostsim::nvsStats().writes - writesBefore;
+  return result;
+}
+
+// Routers of the shop and the office. Where the device is decides their
+// signal, and with a weak signal requests are slow or get lost.
+hostsim::WiFiAccessPoint router(const char *ssid, uint8_t id, int channel,
+                                int rssi, uint32_t latencyMs,
+                                uint32_t failurePercent) {
+  hostsim::WiFiAccessPoint accessPoint;
+  accessPoint.ssid = ssid;
+  accessPoint.bssid[5] = id;
+  accessPoint.channel = channel;
+  accessPoint.rssi = rssi;
+  accessPoint.latencyMs = latencyMs;
+  accessPoint.failurePercent = failurePercent;
+  return accessPoint;
+}
+
+// Router A, B (both "shop") and C ("office") at three places
+std::vector<hostsim::WiFiAccessPoint> place(int where) {
+  switch (where) {
+  case 0: // Shop floor, next to A
+    return {router("shop", 0xA, 1, -55, 0, 0),
+            router("shop", 0xB, 6, -75, 150, 2),
+            router("office", 0xC, 11, -88, 600, 25)};
+  case 1: // Far end of the shop, next to B
+    return {router("shop", 0xA, 1, -80, 700, 25),
+            router("shop", 0xB, 6, -58, 0, 0),
+            router("office", 0xC, 11, -85, 400, 15)};
+  default: // Back office
+    return {router("shop", 0xA, 1, -87, 900, 35),
+            router("shop", 0xB, 6, -79, 300, 10),
+            router("office", 0xC, 11, -52, 0, 0)};
+  }
+}
+
+struct Roaming {
+  std::vector<double> fetchMs; // updateKoiosData()/updatePortfolioData()
+  int failedFetches = 0;       // With a request that got no answer
+  uint32_t roams = 0;
+};
+
+// Boot at place 0, then move on every `hours`, running the ticker's loop
+Roaming carry(const WifiNetwork *networks, int count, bool roaming,
+              double hours) {
+  Roaming result;
+  hostsim::clearNvs();
+  hostsim::setWiFiAccessPoints(place(0));
+  WiFi.disconnect(); // Power off
+  initDataFetcher();
+  wifiManagerSetRoaming(roaming);
+  wifiManagerSetup(networks, count);
+  uint32_t roamsBefore = wifiManagerGetStats().roams;
+  const uint64_t placeMs = (uint64_t)(hours * 3600000);
+  for (int where = 0; where < 3; where++) {
+    hostsim::setWiFiAccessPoints(place(where));
+    uint64_t until = hostsim::clockMicros() / 1000 + placeMs;
+    while (hostsim::clockMicros() / 1000 < until) {
+      wifiManagerLoop();
+      for (int kind = 0; kind < 2; kind++) {
+        hostsim::HttpStats before = hostsim::httpStats();
+        double start = clockMs();
+        if (kind == 0) {
+          updateKoiosData();
+        } else {
+          updatePortfolioData();
+        }
+        hostsim::HttpStats after = hostsim::httpStats();
+        if (after.requests > before.requests) {
+          result.fetchMs.push_back(clockMs() - start);
+          result.failedFetches += after.failures > before.failures;
+        }
+      }
+      delay(10);
+    }
+  }
+  result.roams = wifiManagerGetStats().roams - roamsBefore;
+  wifiManagerSetRoaming(true);
+  return result;
+}
+
+void printRoaming(const char *name, const Roaming &result) {
+  printf("  %-30s %7zu %8.1f%% %9.0f %9.0f %6u\n", name,
+         result.fetchMs.size(),
+         100.0 * result.failedFetches / result.fetchMs.size(),
+         percentile(result.fetchMs, 0.50), percentile(result.fetchMs, 0.95),
+         (unsigned)result.roams);
+}
+
+struct Dropouts {
+  std::vector<double> ipMs;   // Network back to IP address
+  std::vector<double> dataMs; // Network back to the first Koios answer
+};
+
+// The router goes away for `outageMs`, starting at a different moment of the
+// manager's retry cycle each time
+Dropouts dropouts(uint64_t outageMs, int count) {
+  Dropouts result;
+  for (int i = 0; i < count; i++) {
+    double ipMs;
+    runUntilFetched(clockMs(), ipMs); // Settle
+    hostsim::setWiFiConnected(false);
+    // Spread over a whole cycle of retries (5 fast, 1 scan: about 35 s)
+    uint64_t until = hostsim::clockMicros() / 1000 + outageMs +
+                     (uint64_t)i * 35000 / count;
+    while (hostsim::clockMicros() / 1000 < until) {
+      wifiManagerLoop();
+      delay(10);
+    }
+    hostsim::setWiFiConnected(true);
+    double back = clockMs();
+    double dataMs = runUntilFetched(back, ipMs);
+    if (dataMs < 0) {
+      return Dropouts();
+    }
+    result.ipMs.push_back(ipMs - back);
+    result.dataMs.push_back(dataMs - back);
+  }
+  return result;
+}
+
+struct Lease {
+  uint32_t renewals;      // Reconnects to renew the reused address
+  unsigned long renewMs;  // Offline while renewing
+  bool connected;         // At the end
+};
+
+// Boot, drop out for 5 s so the address is reused, then stay online for 45
+// minutes, fetching as the ticker does
+Lease stayOnReusedAddress() {
+  boot();
+  hostsim::setWiFiConnected(false);
+  const double lost = clockMs();
+  while (clockMs() - lost < 5000) {
+    wifiManagerLoop();
+    delay(10);
+  }
+  hostsim::setWiFiConnected(true);
+  double ipMs;
+  runUntilFetched(clockMs(), ipMs);
+  const WifiStats before = wifiManagerGetStats();
+  const double start = clockMs();
+  while (clockMs() - start < 45 * 60000.0) {
+    wifiManagerLoop();
+    if (wifiManagerIsConnected()) {
+      updateKoiosData();
+    }
+    delay(10);
+  }
+  const WifiStats after = wifiManagerGetStats();
+  Lease result;
+  result.renewals = after.dhcpRenewals - before.dhcpRenewals;
+  result.renewMs = after.lastOutageMs;
+  result.connected = wifiManagerIsConnected();
+  return result;
+}
+
+void printBoot(const char *name, const Boot &result) {
+  printf("  %-28s %9.0f %14.0f %11llu\n", name, result.ipMs, result.dataMs,
+         (unsigned long long)result.nvsWrites);
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  int count = argc > 1 ? atoi(argv[1]) : 20;
+  // Shorter stays make too few fetches to compare
+  double hours = std::max(argc > 2 ? atof(argv[2]) : 1, 0.25);
+  hostsim::setSerialEcho(false);
+  hostsim::useVirtualClock(true);
+  hostsim::setWiFiConnected(true);
+  hostsim::setHttpHandler([](const hostsim::HttpRequest &request) {
+    (void)request;
+    hostsim::HttpResponse reply;
+    reply.code = 200;
+    reply.body = "[]";
+    reply.latencyMs = KOIOS_LATENCY_MS;
+    return reply;
+  });
+  hostsim::WiFiAccessPoint home;
+
+  // Boots
+  hostsim::clearNvs();
+  Boot cold = boot();
+  Boot warm = boot();
+  Boot again = boot();
+  hostsim::WiFiAccessPoint moved = home;
+  moved.channel = 11;
+  hostsim::setWiFiAccessPoint(moved);
+  Boot stale = boot();
+  Boot afterStale = boot();
+  hostsim::WiFiAccessPoint hidden = home;
+  hidden.hidden = true;
+  hostsim::setWiFiAccessPoint(hidden);
+  hostsim::clearNvs();
+  Boot hiddenCold = boot();
+  Boot hiddenWarm = boot();
+  hostsim::setWiFiAccessPoint(home);
+
+  for (const Boot &result :
+       {cold, warm, again, stale, afterStale, hiddenCold, hiddenWarm}) {
+    if (result.dataMs < 0) {
+      fprintf(stderr, "A boot never got data\n");
+      return 1;
+    }
+  }
+  if (cold.nvsWrites != 1 || warm.nvsWrites != 0 || again.nvsWrites != 0 ||
+      stale.nvsWrites != 1 || afterStale.nvsWrites != 0 ||
+      hiddenCold.nvsWrites != 1 || hiddenWarm.nvsWrites != 0) {
+    fprintf(stderr, "NVS written when nothing changed, or not when it did\n");
+    return 1;
+  }
+  if (afterStale.ipMs > warm.ipMs + 10) {
+    fprintf(stderr, "The stale cache was not replaced\n");
+    return 1;
+  }
+  if (warm.ipMs + 10 < home.associateMs + home.dhcpMs) {
+    fprintf(stderr, "A boot reused the address without asking DHCP\n");
+    return 1;
+  }
+
+  // Dropouts
+  WifiStats before = wifiManagerGetStats();
+  const uint64_t lengths[] = {2000, 10000, 30000, 120000};
+  std::vector<Dropouts> results;
+  for (uint64_t length : lengths) {
+    results.push_back(dropouts(length, count));
+    if (results.back().ipMs.empty()) {
+      fprintf(stderr, "No data after a %llu ms dropout\n",
+              (unsigned long long)length);
+      return 1;
+    }
+  }
+  WifiStats after = wifiManagerGetStats();
+
+  // The reused address
+  const Lease lease = stayOnReusedAddress();
+  if (lease.renewals != 1 || !lease.connected) {
+    fprintf(stderr, "The reused address was renewed %u times in 45 minutes, "
+            "not once\n", (unsigned)lease.renewals);
+    return 1;
+  }
+
+  // Roaming
+  const WifiNetwork shop[] = {{"shop", "secret"}};
+  const WifiNetwork both[] = {{"shop", "secret"}, {"office", "secret"}};
+  Roaming stay = carry(shop, 1, false, hours);
+  Roaming shopRoaming = carry(shop, 1, true, hours);
+  Roaming bothRoaming = carry(both, 2, true, hours);
+  if (stay.fetchMs.empty() || bothRoaming.failedFetches > stay.failedFetches ||
+      shopRoaming.failedFetches > stay.failedFetches) {
+    fprintf(stderr, "Roaming fails more fetches than staying on one router\n");
+    return 1;
+  }
+
+  printf("CardanoTicker WiFi benchmark: router scan %u ms, association %u ms, "
+         "DHCP %u ms, Koios %u ms\n\n",
+         (unsigned)home.scanMs, (unsigned)home.associateMs,
+         (unsigned)home.dhcpMs, (unsigned)KOIOS_LATENCY_MS);
+  printf("Checks:  every boot gets data (also from a hidden network) and "
+         "asks DHCP, the stale\n         cache is replaced, NVS is written "
+         "only on changes, a reused address is\n         renewed, roaming "
+         "fails no more fetches than staying\n\n");
+  printf("  %-28s %9s %14s %11s\n", "Boot", "IP ms", "first data ms",
+         "NVS writes");
+  printBoot("empty NVS", cold);
+  printBoot("router remembered", warm);
+  printBoot("router remembered (again)", again);
+  printBoot("router moved to channel 11", stale);
+  printBoot("after the move", afterStale);
+  printBoot("hidden SSID, empty NVS", hiddenCold);
+  printBoot("hidden SSID, remembered", hiddenWarm);
+
+  printf("\n  %-28s %9s %9s %14s %14s\n", "Dropout (network back to)",
+         "IP p50", "IP max", "data p50 ms", "data max ms");
+  for (size_t i = 0; i < results.size(); i++) {
+    char name[64];
+    snprintf(name, sizeof(name), "%llu-%llu s, %d times",
+             (unsigned long long)(lengths[i] / 1000),
+             (unsigned long long)(lengths[i] / 1000 + 35), count);
+    printf("  %-28s %9.0f %9.0f %14.0f %14.0f\n", name,
+           percentile(results[i].ipMs, 0.5),
+           *std::max_element(results[i].ipMs.begin(), results[i].ipMs.end()),
+           percentile(results[i].dataMs, 0.5),
+           *std::max_element(results[i].dataMs.begin(),
+                             results[i].dataMs.end()));
+  }
+
+  printf("\nConnects during the dropouts: %u fast, %u full (%u fast attempts "
+         "timed out)\n",
+         (unsigned)(after.fastConnects - before.fastConnects),
+         (unsigned)(after.fullConnects - before.fullConnects),
+         (unsigned)(after.fastFailures - before.fastFailures));
+  const char *buckets[WIFI_CONNECT_BUCKETS] = {"<=250ms", "<=500ms", "<=1s",
+                                               "<=2s",    "<=5s",    "<=10s",
+                                               ">10s"};
+  printf("Attempt-to-IP histogram (all connects):");
+  for (int i = 0; i < WIFI_CONNECT_BUCKETS; i++) {
+    printf(" %s %u", buckets[i], (unsigned)after.connectTimeHistogram[i]);
+  }
+  printf("\n45 minutes on a reused address: renewed %u time(s) with DHCP, "
+         "%lu ms offline\n",
+         (unsigned)lease.renewals, lease.renewMs);
+
+  printf("\nCarried from the shop floor to the back office, %.1f h at each of "
+         "3 places:\n",
+         hours);
+  printf("  %-30s %7s %9s %9s %9s %6s\n", "Networks", "fetches", "failed",
+         "p50 ms", "p95 ms", "roams");
+  printRoaming("shop, roaming off", stay);
+  printRoaming("shop, roaming on", shopRoaming);
+  printRoaming("shop + office, roaming on", bothRoaming);
+  printf("\n(Simulated clock: WiFi timings are the router's above, not "
+         "measured on hardware.)\n");
+  return 0;
+}
@@ -0,0 +1,27 @@
+/**
+ * secrets.h - Configuration values for host builds
+ *
+ * Host simulations never touch a real network, so these are placeholders.
+ * The stubbed remote APIs answer any URL.
+ */
+
+#ifndef SECRETS_H
+#define SECRETS_H
+
+#define WIFI_SSID "host-sim"
+#define WIFI_PASSWORD "host-sim"
+
+// Preprod test address, only used to build QR codes and request bodies
+#define PAYMENT_ADDRESS                                                        \
+  "addr_test1qz2fxv2umyhttkxyxp8x0dlpdt3k6cwng5pxj3jhsydzer3jcu5d8ps7zex2k2"   \
+  "xt3uqxgjqnnj83ws8lhrn648jjxtwq2ytjqp"
+
+#define KOIOS_API_URL "https://preprod.koios.rest/api/v1/address_utxos"
+
+// Test account key (not from a wallet holding funds), so the load test gives
+// every invoice its own address like a configured POS
+#define ACCOUNT_XPUB                                                           \
+  "acct_xvk1rwvrkwawptwntk38khltnpk25jthdkrfzakldccq8gltpvqjn4rvx3ljq8wc3ee"  \
+  "hm5wkqtv2rx5jam67679p3tnzess54z5skrgnkfg3azt74"
+
+#endif
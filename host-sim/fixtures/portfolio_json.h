@@ -0,0 +1,254 @@
+/**
+ * portfolio_json.h - Synthetic wallet portfolios for host builds
+ *
+ * Generates a wallet's tokens and NFT collections and the JSON MinSwap
+ * (portfolio/tokens), Cexplorer (policy/detail) and Koios (account_info)
+ * answer for it, with the fields the ticker reads and the ones it skips
+ * (descriptions, images, attributes, statistics). The same Portfolio is
+ * what a correct decoder must end up with, so harnesses can check results,
+ * not just time them.
+ *
+ * generate(Shape) makes wallets of any size: thousands of NFTs over
+ * hundreds of collections, a few large and many small as in real wallets,
+ * with longer or shorter metadata.
+ */
+
+#ifndef PORTFOLIO_JSON_H
+#define PORTFOLIO_JSON_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace portfolio {
+
+struct Token {
+  std::string ticker;
+  std::string name;
+  double amount;
+  double priceUsd;
+  double change24h; // Percent
+};
+
+struct Collection {
+  std::string policyId;  // 56 hex characters
+  std::string mintName;  // Name in the NFT metadata (MinSwap)
+  std::string name;      // Collection name (Cexplorer)
+  int count;             // NFTs owned
+  uint64_t floorLovelace;
+};
+
+struct Portfolio {
+  std::vector<Token> tokens;
+  std::vector<Collection> collections;
+  // Metadata the ticker skips, in minswapJson()
+  size_t descriptionLength = 85; // Of each token's description
+  int attributes = 2;            // Traits of each NFT
+};
+
+// A wallet for generate(Shape)
+struct Shape {
+  int tokens = 8;
+  int collections = 6;
+  int nfts = 18; // At least one per collection
+  size_t descriptionLength = 85;
+  int attributes = 2;
+  uint32_t seed = 42;
+};
+
+inline std::string randomHex(std::mt19937 &random, size_t length) {
+  static const char digits[] = "0123456789abcdef";
+  std::string out;
+  for (size_t i = 0; i < length; i++) {
+    out += digits[random() % 16];
+  }
+  return out;
+}
+
+inline std::string number(double value) {
+  char text[32];
+  snprintf(text, sizeof(text), "%.6f", value);
+  return text;
+}
+
+// Values are rounded to what the fixed-point snapshot keeps (millionths,
+// hundredths of a percent), so decoders can be compared to it
+inline Portfolio generate(int tokens, int collections, int nftsPerCollection,
+                          uint32_t seed) {
+  static const char *TICKERS[] = {"MIN",   "HOSKY", "SNEK",  "iUSD",
+                                  "WMT",   "INDY",  "LQ",    "DJED",
+                                  "AGIX",  "COPI",  "BOOK",  "NTX"};
+  static const char *COLLECTIONS[] = {
+      "SpaceBudz",       "Clay Nation",     "Cardano Punks",
+      "Pavia",           "Yummi Universe",  "The Ape Society",
+      "Derp Birds",      "Chilled Kongs",   "Unsigned Algorithms",
+      "Boss Cat Rocket", "Mocossi Planet",  "Stag Alliance"};
+  std::mt19937 random(seed);
+  Portfolio out;
+  for (int i = 0; i < tokens; i++) {
+    Token token;
+    token.ticker = TICKERS[i % 12];
+    token.name = token.ticker + " Token";
+    token.amount = (double)(random() % 100000000) / 100; // Up to 1M
+    token.priceUsd = (double)(random() % 2000000) / 1e6;
+    token.change24h = ((double)(random() % 4001) - 2000) / 100;
+    out.tokens.push_back(token);
+  }
+  for (int i = 0; i < collections; i++) {
+    Collection collection;
+    collection.policyId = randomHex(random, 56);
+    collection.name = COLLECTIONS[i % 12];
+    collection.mintName = collection.name + " #" +
+                          std::to_string(random() % 10000);
+    collection.count = 1 + (i % nftsPerCollection);
+    collection.floorLovelace = (uint64_t)(random() % 2000 + 5) * 1000000;
+    out.collections.push_back(collection);
+  }
+  return out;
+}
+
+// A wallet of any size. The NFTs are spread over the collections as in
+// real wallets, a few large and a long tail of one or two (Zipf), and
+// tickers and collection names stay unique past the twelve built in.
+inline Portfolio generate(const Shape &shape) {
+  Portfolio out = generate(shape.tokens, shape.collections, 1, shape.seed);
+  out.descriptionLength = shape.descriptionLength;
+  out.attributes = shape.attributes;
+  for (size_t i = 12; i < out.tokens.size(); i++) {
+    out.tokens[i].ticker += std::to_string(i / 12 + 1);
+    out.tokens[i].name = out.tokens[i].ticker + " Token";
+  }
+  for (size_t i = 12; i < out.collections.size(); i++) {
+    Collection &collection = out.collections[i];
+    collection.name += " " + std::to_string(i / 12 + 1);
+    collection.mintName = collection.name +
+                          collection.mintName.substr(
+                              collection.mintName.rfind(" #"));
+  }
+  if (out.collections.empty()) {
+    return out;
+  }
+  // Collection k gets a share of 1 / (k + 1), after the one NFT each has
+  double harmonic = 0;
+  for (size_t k = 0; k < out.collections.size(); k++) {
+    harmonic += 1.0 / (k + 1);
+  }
+  const int spread = std::max(0, shape.nfts - shape.collections);
+  int given = 0;
+  for (size_t k = 0; k < out.collections.size(); k++) {
+    const int extra = (int)(spread / harmonic / (k + 1));
+    out.collections[k].count = 1 + extra;
+    given += extra;
+  }
+  out.collections[0].count += spread - given; // What rounding left over
+  return out;
+}
+
+inline int nftCount(const Portfolio &portfolio) {
+  int count = 0;
+  for (const Collection &collection : portfolio.collections) {
+    count += collection.count;
+  }
+  return count;
+}
+
+// Koios account_info, for a wallet holding lovelace
+inline std::string koiosJson(uint64_t lovelace) {
+  return "[{\"stake_address\":\"stake1u9ylzsgxaa6xctf4juup682ar3juj85n8tx3hthn"
+         "wyrvmy9ca4z6\",\"status\":\"registered\",\"delegated_drep\":"
+         "\"drep_always_abstain\",\"delegated_pool\":\"pool1z5uqdk7dzdxaae5633"
+         "fqfcu2eqzy3a3rgtuvy087fdld7yws0xt\",\"total_balance\":\"" +
+         std::to_string(lovelace) + "\",\"utxo\":\"" +
+         std::to_string(lovelace - lovelace / 50) + "\",\"rewards\":\"" +
+         std::to_string(lovelace / 40) + "\",\"withdrawals\":\"" +
+         std::to_string(lovelace / 200) + "\",\"rewards_available\":\"" +
+         std::to_string(lovelace / 50) +
+         "\",\"deposit\":\"2000000\",\"reserves\":\"0\",\"treasury\":\"0\","
+         "\"proposal_refund\":\"0\"}]";
+}
+
+// MinSwap portfolio/tokens?address=...
+inline std::string minswapJson(const Portfolio &portfolio, uint32_t seed) {
+  static const std::string SENTENCE = "The native token of a Cardano "
+                                      "project, used for governance, staking "
+                                      "rewards and fees.";
+  std::string description;
+  while (description.size() < portfolio.descriptionLength) {
+    description += description.empty() ? SENTENCE : " " + SENTENCE;
+  }
+  description.resize(portfolio.descriptionLength);
+  std::string attributes = "\"Background\":\"Blue\",\"Eyes\":\"Laser\"";
+  if (portfolio.attributes < 2) {
+    attributes = portfolio.attributes == 1 ? "\"Background\":\"Blue\"" : "";
+  }
+  for (int i = 2; i < portfolio.attributes; i++) {
+    attributes += ",\"Trait " + std::to_string(i + 1) + "\":\"Value " +
+                  std::to_string(i + 1) + "\"";
+  }
+
+  std::mt19937 random(seed);
+  std::string assets;
+  for (const Token &token : portfolio.tokens) {
+    if (!assets.empty()) {
+      assets += ",";
+    }
+    std::string unit = randomHex(random, 56);
+    assets +=
+        "{\"asset\":{\"currency_symbol\":\"" + unit +
+        "\",\"token_name\":\"" + randomHex(random, 8) +
+        "\",\"is_verified\":true,\"metadata\":{\"name\":\"" + token.name +
+        "\",\"ticker\":\"" + token.ticker +
+        "\",\"description\":\"" + description +
+        "\",\"decimals\":6,"
+        "\"url\":\"https://example.org/" +
+        token.ticker + "\"}},\"amount\":" + number(token.amount) +
+        ",\"price_usd\":" + number(token.priceUsd) +
+        ",\"price_ada\":" + number(token.priceUsd * 2.4) +
+        ",\"value_usd\":" + number(token.priceUsd * token.amount) +
+        ",\"pnl_24h_percent\":" + number(token.change24h) +
+        ",\"pnl_24h_usd\":" + number(token.change24h * 0.01) +
+        ",\"first_acquired_at\":\"2024-03-14T09:26:53Z\"}";
+  }
+  std::string nfts;
+  for (const Collection &collection : portfolio.collections) {
+    for (int i = 0; i < collection.count; i++) {
+      if (!nfts.empty()) {
+        nfts += ",";
+      }
+      std::string tokenName = randomHex(random, 20);
+      nfts += "{\"currency_symbol\":\"" + collection.policyId +
+              "\",\"token_name\":\"" + tokenName +
+              "\",\"amount\":1,\"asset\":{\"currency_symbol\":\"" +
+              collection.policyId + "\",\"token_name\":\"" + tokenName +
+              "\",\"metadata\":{\"name\":\"" + collection.mintName +
+              "\",\"image\":\"ipfs://Qm" + randomHex(random, 44) +
+              "\",\"mediaType\":\"image/png\",\"attributes\":{" +
+              attributes + "}}}}";
+    }
+  }
+  return "{\"address\":\"addr1...\",\"positions\":{\"asset_positions\":[" +
+         assets + "],\"nft_positions\":[" + nfts +
+         "],\"lp_positions\":[]},\"total_value_usd\":0}";
+}
+
+// Cexplorer policy/detail?id=...
+inline std::string cexplorerJson(const Collection &collection) {
+  return "{\"code\":200,\"data\":{\"policy\":\"" + collection.policyId +
+         "\",\"quantity\":10000,\"collection\":{\"name\":\"" +
+         collection.name +
+         "\",\"url\":\"https://example.org/collection\",\"image\":"
+         "\"ipfs://QmYv8sGd2Sb2bRq8sM3TLj6cDq1QGtKqzXqDn7dKf2xNn9\","
+         "\"description\":\"A collection of 10,000 unique NFTs on Cardano.\","
+         "\"stats\":{\"floor\":" +
+         std::to_string(collection.floorLovelace) +
+         ",\"owners\":3412,\"volume\":123456789012,\"supply\":10000,"
+         "\"listings\":321},\"socials\":{\"twitter\":\"https://x.com/example\","
+         "\"website\":\"https://example.org\"}}},\"time\":0.012}";
+}
+
+} // namespace portfolio
+
+#endif
@@ -0,0 +1,250 @@
+/**
+ * tx_builder.h - Synthetic Cardano transactions for host builds
+ *
+ * Encodes Conway-era transactions as CBOR, the way a wallet submits them:
+ * inputs as a tag 258 set, a mix of legacy (array) and Babbage (map)
+ * outputs, native tokens, inline datums, vkey witnesses and metadata.
+ * One or more outputs pay a chosen address; everything else is random
+ * filler up to the requested size. The transaction ID is computed with
+ * cardano_crypto.cpp, so stubs can serve it as Koios would.
+ */
+
+#ifndef TX_BUILDER_H
+#define TX_BUILDER_H
+
+#include "cardano_crypto.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace txbuilder {
+
+class CborWriter {
+public:
+  std::vector<uint8_t> bytes;
+
+  void head(uint8_t major, uint64_t value) {
+    uint8_t prefix = (uint8_t)(major << 5);
+    if (value < 24) {
+      bytes.push_back(prefix | (uint8_t)value);
+    } else if (value <= 0xff) {
+      bytes.push_back(prefix | 24);
+      bytes.push_back((uint8_t)value);
+    } else if (value <= 0xffff) {
+      bytes.push_back(prefix | 25);
+      appendBigEndian(value, 2);
+    } else if (value <= 0xffffffffULL) {
+      bytes.push_back(prefix | 26);
+      appendBigEndian(value, 4);
+    } else {
+      bytes.push_back(prefix | 27);
+      appendBigEndian(value, 8);
+    }
+  }
+
+  void unsignedInt(uint64_t value) { head(0, value); }
+  void byteString(const std::vector<uint8_t> &data) {
+    head(2, data.size());
+    bytes.insert(bytes.end(), data.begin(), data.end());
+  }
+  void text(const std::string &data) {
+    head(3, data.size());
+    bytes.insert(bytes.end(), data.begin(), data.end());
+  }
+  void array(uint64_t count) { head(4, count); }
+  void map(uint64_t count) { head(5, count); }
+  void tag(uint64_t number) { head(6, number); }
+  void indefiniteArray() { bytes.push_back(0x9f); }
+  void endIndefinite() { bytes.push_back(0xff); }
+  void boolean(bool value) { bytes.push_back(value ? 0xf5 : 0xf4); }
+  void append(const std::vector<uint8_t> &encoded) {
+    bytes.insert(bytes.end(), encoded.begin(), encoded.end());
+  }
+
+private:
+  void appendBigEndian(uint64_t value, int size) {
+    for (int i = size - 1; i >= 0; i--) {
+      bytes.push_back((uint8_t)(value >> (8 * i)));
+    }
+  }
+};
+
+struct Transaction {
+  std::vector<uint8_t> cbor;
+  std::string hash;   // Hex transaction ID
+  size_t bodyEnd = 0; // Body is cbor[1, bodyEnd)
+  size_t isValid = 0; // Position of the is_valid flag (0xf5)
+  int outputCount = 0;
+};
+
+inline std::vector<uint8_t> randomBytes(std::mt19937 &rng, size_t length) {
+  std::vector<uint8_t> data(length);
+  for (auto &b : data) {
+    b = (uint8_t)rng();
+  }
+  return data;
+}
+
+inline std::string toHex(const uint8_t *data, size_t length) {
+  static const char *digits = "0123456789abcdef";
+  std::string hex;
+  for (size_t i = 0; i < length; i++) {
+    hex += digits[data[i] >> 4];
+    hex += digits[data[i] & 0x0f];
+  }
+  return hex;
+}
+
+// Raw bytes of a bech32 address, empty if it does not decode
+inline std::vector<uint8_t> addressBytes(const std::string &bech32) {
+  char hrp[16];
+  uint8_t data[64];
+  size_t length = 0;
+  if (!bech32Decode(bech32.c_str(), hrp, sizeof(hrp), data, sizeof(data),
+                    length)) {
+    return {};
+  }
+  return std::vector<uint8_t>(data, data + length);
+}
+
+// One output in any of the encodings wallets produce
+inline std::vector<uint8_t> encodeOutput(std::mt19937 &rng,
+                                         const std::vector<uint8_t> &address,
+                                         uint64_t lovelace, bool withTokens) {
+  CborWriter out;
+  bool babbage = rng() % 2 == 0;
+  bool inlineDatum = babbage && rng() % 3 == 0;
+  if (babbage) {
+    out.map(inlineDatum ? 3 : 2);
+    out.unsignedInt(0);
+  } else {
+    out.array(2);
+  }
+  out.byteString(address);
+  if (babbage) {
+    out.unsignedInt(1);
+  }
+
+  if (withTokens) {
+    // [coin, {policy: {asset name: quantity}}]
+    out.array(2);
+    out.unsignedInt(lovelace);
+    int policies = 1 + rng() % 3;
+    out.map(policies);
+    for (int p = 0; p < policies; p++) {
+      out.byteString(randomBytes(rng, 28));
+      int assets = 1 + rng() % 4;
+      out.map(assets);
+      for (int a = 0; a < assets; a++) {
+        out.byteString(randomBytes(rng, 4 + rng() % 28));
+        out.unsignedInt(1 + rng() % 1000000000);
+      }
+    }
+  } else {
+    out.unsignedInt(lovelace);
+  }
+
+  if (inlineDatum) {
+    // 2: [1, #6.24(bytes .cbor plutus_data)]
+    CborWriter datum;
+    datum.tag(121);
+    datum.indefiniteArray();
+    datum.byteString(randomBytes(rng, 28));
+    datum.unsignedInt(rng() % 100000);
+    datum.endIndefinite();
+    out.unsignedInt(2);
+    out.array(2);
+    out.unsignedInt(1);
+    out.tag(24);
+    out.byteString(datum.bytes);
+  }
+  return out.bytes;
+}
+
+// Build a transaction of up to targetSize bytes with `payments` outputs of
+// lovelace to payTo among random outputs to other addresses
+inline Transaction build(const std::vector<uint8_t> &payTo, uint64_t lovelace,
+                         size_t targetSize, uint32_t seed, int payments = 1) {
+  std::mt19937 rng(seed);
+  Transaction tx;
+
+  // Inputs, witnesses and metadata take at most this much
+  const size_t overhead = 700;
+
+  std::vector<std::vector<uint8_t>> outputs;
+  size_t outputBytes = 0;
+  for (int i = 0; i < payments; i++) {
+    outputs.push_back(encodeOutput(rng, payTo, lovelace, false));
+    outputBytes += outputs.back().size();
+  }
+  while (true) {
+    std::vector<uint8_t> address = randomBytes(rng, 57);
+    address[0] = payTo.empty() ? 0x00 : payTo[0]; // Same network
+    std::vector<uint8_t> output = encodeOutput(
+        rng, address, 1000000 + rng() % 500000000, rng() % 4 == 0);
+    if (outputBytes + output.size() + overhead > targetSize) {
+      break;
+    }
+    outputs.push_back(output);
+    outputBytes += output.size();
+  }
+  std::shuffle(outputs.begin(), outputs.end(), rng);
+  tx.outputCount = (int)outputs.size();
+
+  CborWriter body;
+  body.map(5);
+  body.unsignedInt(0); // Inputs
+  body.tag(258);
+  int inputs = 1 + rng() % 3;
+  body.array(inputs);
+  for (int i = 0; i < inputs; i++) {
+    body.array(2);
+    body.byteString(randomBytes(rng, 32));
+    body.unsignedInt(rng() % 8);
+  }
+  body.unsignedInt(1); // Outputs
+  body.array(outputs.size());
+  for (const auto &output : outputs) {
+    body.append(output);
+  }
+  body.unsignedInt(2); // Fee
+  body.unsignedInt(170000 + rng() % 500000);
+  body.unsignedInt(3); // TTL
+  body.unsignedInt(70000000 + rng() % 1000000);
+  body.unsignedInt(7); // Auxiliary data hash
+  body.byteString(randomBytes(rng, 32));
+
+  uint8_t txId[32];
+  blake2b(body.bytes.data(), body.bytes.size(), txId, sizeof(txId));
+  tx.hash = toHex(txId, sizeof(txId));
+
+  CborWriter cbor;
+  cbor.array(4);
+  cbor.append(body.bytes);
+  tx.bodyEnd = cbor.bytes.size();
+  cbor.map(1); // Witness set: 0 = [[vkey, signature]]
+  cbor.unsignedInt(0);
+  cbor.array(inputs);
+  for (int i = 0; i < inputs; i++) {
+    cbor.array(2);
+    cbor.byteString(randomBytes(rng, 32));
+    cbor.byteString(randomBytes(rng, 64));
+  }
+  tx.isValid = cbor.bytes.size();
+  cbor.boolean(true);
+  cbor.map(1); // Metadata {674: {"msg": [...]}} (CIP-20 message)
+  cbor.unsignedInt(674);
+  cbor.map(1);
+  cbor.text("msg");
+  cbor.array(1);
+  cbor.text("Thanks for shopping with Cardano");
+  tx.cbor = cbor.bytes;
+  return tx;
+}
+
+} // namespace txbuilder
+
+#endif
@@ -0,0 +1,215 @@
+/**
+ * fault_server.h - Stand-in for the sketches' APIs, with scripted faults
+ *
+ * FaultServer is an HTTP handler (hostsim::setHttpHandler()) that stands in
+ * for Koios, MinSwap, Cexplorer, CoinGecko and Blockfrost. It tells the API
+ * by the request's URL, lets the harness's function for that API answer,
+ * and then breaks the answer the way the real services break when a
+ * scripted fault is on:
+ * - FAULT_SLOW_DRIP    the body trickles in at `value` bytes per second
+ * - FAULT_TRUNCATED    200 OK, but the body ends after `value` percent
+ * - FAULT_RATE_LIMIT   429 Too Many Requests, Retry-After `value` seconds
+ * - FAULT_TLS_RESET    the connection is reset in the TLS handshake,
+ *                      `value` ms after connecting
+ * - FAULT_DNS_TIMEOUT  the DNS lookup gets no answer, and the device gives
+ *                      up after `value` ms
+ *
+ * A fault has a start and a duration on the simulated clock, the APIs it
+ * hits and the share of their requests it hits. Which requests is decided
+ * by a fixed pseudo-random sequence, so runs can be compared. The server
+ * counts requests, faults and bytes per API.
+ */
+
+#ifndef FAULT_SERVER_H
+#define FAULT_SERVER_H
+
+#include "HTTPClient.h"
+#include "hostsim.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace faults {
+
+enum Api {
+  API_KOIOS,
+  API_MINSWAP,
+  API_CEXPLORER,
+  API_COINGECKO,
+  API_BLOCKFROST,
+  API_COUNT
+};
+
+const char *const API_NAMES[API_COUNT] = {"koios", "minswap", "cexplorer",
+                                          "coingecko", "blockfrost"};
+
+// How a request's URL tells the API (host names, and the path the
+// chain-gateway uses for Koios)
+const char *const API_URL_PARTS[API_COUNT] = {"koios", "minswap.org",
+                                              "cexplorer.io", "coingecko.com",
+                                              "blockfrost.io"};
+
+// Sets of APIs a fault hits
+inline uint32_t apiBit(Api api) { return 1u << api; }
+const uint32_t ALL_APIS = (1u << API_COUNT) - 1;
+
+enum FaultKind {
+  FAULT_SLOW_DRIP,
+  FAULT_TRUNCATED,
+  FAULT_RATE_LIMIT,
+  FAULT_TLS_RESET,
+  FAULT_DNS_TIMEOUT,
+};
+
+struct Fault {
+  FaultKind kind;
+  uint32_t apis;       // apiBit()s
+  uint64_t startMs;    // Simulated time (hostsim::clockMicros() / 1000)
+  uint64_t durationMs;
+  uint32_t percent;    // Of the requests made meanwhile
+  uint32_t value;      // Bytes per second, percent kept, seconds or ms
+  uint64_t endMs() const { return startMs + durationMs; }
+};
+
+struct ApiStats {
+  uint64_t requests = 0;
+  uint64_t faulted = 0;
+  uint64_t bytes = 0; // Bodies as sent, after the faults
+};
+
+class FaultServer {
+public:
+  typedef hostsim::HttpHandler Answer;
+
+  // The normal answer of an API. Requests to an API without one get 404.
+  void serve(Api api, Answer answer) { answers_[api] = answer; }
+
+  void add(const Fault &fault) { faults_.push_back(fault); }
+  void clearFaults() { faults_.clear(); }
+
+  // For hostsim::setHttpHandler()
+  hostsim::HttpHandler handler() {
+    return [this](const hostsim::HttpRequest &request) {
+      return handle(request);
+    };
+  }
+
+  hostsim::HttpResponse handle(const hostsim::HttpRequest &request) {
+    const int api = apiOf(request.url);
+    hostsim::HttpResponse reply;
+    reply.code = 404;
+    if (api < 0) {
+      return reply;
+    }
+    ApiStats &stats = stats_[api];
+    stats.requests++;
+    if (answers_[api]) {
+      reply = answers_[api](request);
+    }
+    const Fault *fault = faultFor((Api)api, hostsim::clockMicros() / 1000);
+    if (fault != nullptr) {
+      stats.faulted++;
+      apply(*fault, reply);
+    }
+    stats.bytes += reply.body.size();
+    return reply;
+  }
+
+  // Index of the API a URL is for, -1 if none
+  static int apiOf(const std::string &url) {
+    for (int api = 0; api < API_COUNT; api++) {
+      if (url.find(API_URL_PARTS[api]) != std::string::npos) {
+        return api;
+      }
+    }
+    return -1;
+  }
+
+  const ApiStats &stats(Api api) const { return stats_[api]; }
+  void resetStats() {
+    for (ApiStats &stats : stats_) {
+      stats = ApiStats();
+    }
+  }
+
+  // "slow drip, 256 B/s" (for reports)
+  static std::string describe(const Fault &fault) {
+    char text[64];
+    switch (fault.kind) {
+    case FAULT_SLOW_DRIP:
+      snprintf(text, sizeof(text), "slow drip, %u B/s", (unsigned)fault.value);
+      break;
+    case FAULT_TRUNCATED:
+      snprintf(text, sizeof(text), "truncated to %u%%", (unsigned)fault.value);
+      break;
+    case FAULT_RATE_LIMIT:
+      snprintf(text, sizeof(text), "429, retry after %u s",
+               (unsigned)fault.value);
+      break;
+    case FAULT_TLS_RESET:
+      snprintf(text, sizeof(text), "TLS reset, %u%%", (unsigned)fault.percent);
+      break;
+    default:
+      snprintf(text, sizeof(text), "DNS timeout, %u s",
+               (unsigned)(fault.value / 1000));
+      break;
+    }
+    return text;
+  }
+
+private:
+  // The fault that hits a request to api now, if any
+  const Fault *faultFor(Api api, uint64_t nowMs) {
+    for (const Fault &fault : faults_) {
+      if ((fault.apis & apiBit(api)) == 0 || nowMs < fault.startMs ||
+          nowMs >= fault.endMs()) {
+        continue;
+      }
+      // Deterministic, so runs can be compared
+      random_ = random_ * 1103515245u + 12345u;
+      if ((random_ >> 16) % 100 < fault.percent) {
+        return &fault;
+      }
+    }
+    return nullptr;
+  }
+
+  static void apply(const Fault &fault, hostsim::HttpResponse &reply) {
+    switch (fault.kind) {
+    case FAULT_SLOW_DRIP:
+      reply.bytesPerSecond = fault.value;
+      break;
+    case FAULT_TRUNCATED:
+      reply.body.resize(reply.body.size() * fault.value / 100);
+      break;
+    case FAULT_RATE_LIMIT:
+      reply.code = HTTP_CODE_TOO_MANY_REQUESTS;
+      reply.body = "{\"message\":\"Too Many Requests\"}";
+      reply.headers.clear();
+      reply.headers["Retry-After"] = std::to_string(fault.value);
+      break;
+    case FAULT_TLS_RESET:
+      reply = hostsim::HttpResponse();
+      reply.code = HTTPC_ERROR_CONNECTION_REFUSED; // What HTTPClient says
+      reply.connectMs = fault.value;
+      break;
+    case FAULT_DNS_TIMEOUT:
+      reply = hostsim::HttpResponse();
+      reply.code = HTTPC_ERROR_CONNECTION_REFUSED;
+      reply.connectMs = fault.value;
+      break;
+    }
+  }
+
+  Answer answers_[API_COUNT];
+  ApiStats stats_[API_COUNT];
+  std::vector<Fault> faults_;
+  uint32_t random_ = 12345;
+};
+
+} // namespace faults
+
+#endif
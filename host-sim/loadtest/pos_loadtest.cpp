@@ -0,0 +1,411 @@
+/**
+ * pos_loadtest.cpp - Lunch-rush load test for the cardano-pos web server
+ *
+ * Runs the real web_server.cpp, transaction_qr.cpp, price_service.cpp,
+ * sales_stats.cpp, invoice_address.cpp, payment_watcher.cpp and
+ * payment_verifier.cpp against the host WebServer, a directory-backed
+ * LittleFS and stubbed Koios and price endpoints, and fires a mix of
+ * GET/POST requests at it:
+ *
+ *   20%  POST /api/transactions   (new invoice in ADA, QR drawn, Koios
+ *                                  polling)
+ *   10%  POST /api/transactions   (new invoice in fiat, converted with the
+ *                                  cached price)
+ *   40%  GET  /api/transactions   (transaction list refresh)
+ *    5%  GET  /api/stats          (sales summary refresh)
+ *   20%  GET  static files        (index.html, styles.css, scripts, icon;
+ *                                  half from returning browsers that send
+ *                                  the ETag of their cached copy)
+ *    5%  GET  missing path        (falls back to index.html)
+ *
+ * Requests arrive at random (Poisson) times on a virtual clock. The firmware
+ * loop is simulated one iteration at a time: a request that arrives while
+ * the loop is busy (for example writing to flash) waits, just like on the
+ * board, where WebServer serves one client per loop() call.
+ *
+ * The whole run is traced (POST /api/trace in ring mode, the last 4000
+ * events), and the trace is downloaded with GET /api/trace at the end.
+ *
+ * Usage: ./bin/pos_loadtest [requests] [seed] [requests-per-second]
+ */
+
+#include "hostsim.h"
+#include "invoice_address.h"
+#include "logger.h"
+#include "payment_watcher.h"
+#include "price_service.h"
+#include "transaction_qr.h"
+#include "tx_builder.h"
+#include "web_server.h"
+
+#include <LittleFS.h>
+#include <TFT_eSPI.h>
+#include <WebServer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace stdfs = std::filesystem;
+
+namespace {
+// Source of the web interface copied into the simulated flash
+const char *DATA_DIR = "../Workshop-05/examples/cardano-pos/data";
+
+// A payment shows up on the third check
+const int CHECKS_UNTIL_PAID = 3;
+
+// Rough ESP32 LittleFS throughput, used to estimate time spent on flash
+const double FLASH_READ_KB_PER_S = 600.0;
+const double FLASH_WRITE_KB_PER_S = 60.0;
+
+const char *STATIC_FILES[] = {"/", "/styles.css", "/requestPayment.js",
+                              "/transactionList.js", "/favicon.ico"};
+
+struct RouteStats {
+  std::vector<double> serviceUs;  // Host CPU time inside handleClient()
+  std::vector<double> responseMs; // Arrival to response, virtual clock
+  std::map<int, int> statusCounts;
+  uint64_t bytesSent = 0;
+};
+
+// First string value after key in a request body, e.g. the address in
+// {"_addresses":["addr_test1..."]}
+std::string jsonStringAfter(const std::string &json, const char *key) {
+  size_t start = json.find(key);
+  if (start == std::string::npos ||
+      (start = json.find('"', start + strlen(key))) == std::string::npos) {
+    return "";
+  }
+  size_t end = json.find('"', start + 1);
+  return end == std::string::npos ? "" : json.substr(start + 1, end - start - 1);
+}
+
+double percentile(std::vector<double> values, double p) {
+  if (values.empty()) {
+    return 0;
+  }
+  std::sort(values.begin(), values.end());
+  return values[(size_t)(p * (values.size() - 1))];
+}
+
+double nowUs() {
+  return std::chrono::duration<double, std::micro>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Count the objects in the stored transaction list (number of "id" keys)
+int countStoredTransactions(const std::string &fsRoot) {
+  FILE *file = fopen((fsRoot + "/transactions.json").c_str(), "rb");
+  if (!file) {
+    return 0;
+  }
+  std::string text;
+  char buffer[4096];
+  size_t count;
+  while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    text.append(buffer, count);
+  }
+  fclose(file);
+
+  int transactions = 0;
+  for (size_t at = text.find("\"id\":"); at != std::string::npos;
+       at = text.find("\"id\":", at + 1)) {
+    transactions++;
+  }
+  return transactions;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  int requestCount = argc > 1 ? atoi(argv[1]) : 5000;
+  unsigned seed = argc > 2 ? (unsigned)atoi(argv[2]) : 42;
+  double requestsPerSecond = argc > 3 ? atof(argv[3]) : 2.0;
+  std::mt19937 rng(seed);
+
+  // Fresh simulated flash with the web interface on it
+  std::string fsRoot =
+      (stdfs::temp_directory_path() / ("pos_loadtest_" + std::to_string(seed)))
+          .string();
+  stdfs::remove_all(fsRoot);
+  stdfs::create_directories(fsRoot);
+  for (const auto &entry : stdfs::directory_iterator(DATA_DIR)) {
+    if (entry.path().filename() != "README.md") {
+      stdfs::copy(entry.path(), fsRoot / entry.path().filename());
+    }
+  }
+
+  hostsim::setFsRoot(fsRoot);
+  hostsim::useVirtualClock(true);
+  hostsim::setSerialEcho(false);
+
+  // Koios stub: no UTxO until the same address and amount were asked about a
+  // few times, then a generated transaction paying the address
+  // Price stub: a fixed ADA price
+  std::map<std::string, int> checksPerQuery;
+  std::map<std::string, std::vector<uint8_t>> paymentTransactions; // By hash
+  uint64_t koiosCalls = 0;
+  uint64_t txCborCalls = 0;
+  uint64_t priceCalls = 0;
+  hostsim::setHttpHandler([&](const hostsim::HttpRequest &request) {
+    hostsim::HttpResponse response;
+    response.code = 200;
+    if (request.url.find("simple/price") != std::string::npos) {
+      // No latency: on the board the price is fetched by its own task and
+      // does not hold up loop(), host builds just fetch it from the loop
+      priceCalls++;
+      response.body = "{\"cardano\":{\"usd\":0.4123}}";
+      return response;
+    }
+
+    // No latency either: on the board payments are checked by the payment
+    // watcher task, host builds run its checks from the loop
+    koiosCalls++;
+    if (request.url.find("/tx_cbor") != std::string::npos) {
+      // Raw transaction, checked by the firmware before it counts as paid
+      txCborCalls++;
+      std::string hash = jsonStringAfter(request.body, "\"_tx_hashes\":[");
+      auto tx = paymentTransactions.find(hash);
+      if (tx == paymentTransactions.end()) {
+        response.body = "[]";
+      } else {
+        response.body = "[{\"tx_hash\":\"" + hash + "\",\"cbor\":\"" +
+                        txbuilder::toHex(tx->second.data(), tx->second.size()) +
+                        "\"}]";
+      }
+      return response;
+    }
+
+    int checks = ++checksPerQuery[request.url + request.body];
+    if (checks >= CHECKS_UNTIL_PAID) {
+      // The shared address is paid the exact amount it asks for. Invoice
+      // addresses get more than any invoice, the firmware only checks it
+      // is enough.
+      size_t filter = request.url.find("value=eq.");
+      uint64_t lovelace =
+          filter != std::string::npos
+              ? strtoull(request.url.c_str() + filter + 9, nullptr, 10)
+              : 1000000000000ULL;
+      std::string address = jsonStringAfter(request.body, "\"_addresses\":[");
+      txbuilder::Transaction tx =
+          txbuilder::build(txbuilder::addressBytes(address), lovelace,
+                           300 + rng() % 1700, rng());
+      paymentTransactions[tx.hash] = tx.cbor;
+      response.body = "[{\"tx_hash\":\"" + tx.hash + "\",\"value\":\"" +
+                      std::to_string(lovelace) + "\"}]";
+    } else {
+      response.body = "[]";
+    }
+    return response;
+  });
+
+  TFT_eSPI display;
+  webServerSetup();
+  transactionQRInit(display);
+  setTransactionCreatedCallback(displayNewTransactionQR, &display);
+  priceServiceSetup();
+  priceServiceLoop(); // First price fetch
+
+  WebServer *server = WebServer::instance();
+  if (server == nullptr) {
+    fprintf(stderr, "Web server was not created\n");
+    return 1;
+  }
+
+  // Keep the last events of the run (see trace.h)
+  server->inject(HTTP_POST, "/api/trace?events=4000&mode=ring");
+  webServerLoop();
+  const int traceStartCode = server->lastResponse().code;
+
+  hostsim::resetFsStats();
+  hostsim::heapResetPeak();
+  size_t heapAtStart = hostsim::heapLiveBytes();
+
+  std::map<std::string, RouteStats> routes;
+  std::map<std::string, std::string> cachedEtags; // Path -> last ETag seen
+  std::exponential_distribution<double> arrivalGap(requestsPerSecond);
+  int postsCreated = 0;
+  uint64_t maxLoopBlockMs = 0;
+
+  double virtualArrivalMs = (double)millis();
+  double wallStart = nowUs();
+  double handlerUsTotal = 0;
+
+  for (int i = 0; i < requestCount; i++) {
+    virtualArrivalMs += arrivalGap(rng) * 1000.0;
+
+    // Run loop iterations until the request has arrived. Slow work in
+    // the loop moves the clock past the arrival time, and the request then
+    // has to wait for it.
+    while ((double)millis() < virtualArrivalMs) {
+      uint64_t before = millis();
+      loggerLoop();
+      transactionQRUpdate(display);
+      paymentWatcherLoop();
+      priceServiceLoop();
+      // Address derivation is CPU time, charge it to the clock
+      double deriveStart = nowUs();
+      invoiceAddressLoop();
+      hostsim::advanceClock((uint64_t)((nowUs() - deriveStart) / 1000.0));
+      uint64_t blocked = millis() - before;
+      maxLoopBlockMs = std::max(maxLoopBlockMs, blocked);
+      if (blocked == 0) {
+        uint64_t idle = (uint64_t)(virtualArrivalMs - (double)millis());
+        hostsim::advanceClock(std::min<uint64_t>(std::max<uint64_t>(idle, 1),
+                                                 10));
+      }
+    }
+
+    std::string route;
+    int pick = (int)(rng() % 100);
+    uint64_t timestamp = 1700000000000ULL + (uint64_t)virtualArrivalMs;
+    if (pick < 20) {
+      route = "POST ADA";
+      // 1 to 500 ADA in whole cents, timestamp in JS milliseconds
+      uint64_t lovelace = (1 + rng() % 50000) * 10000ULL;
+      server->inject(HTTP_POST, "/api/transactions",
+                     "{\"amount\":" + std::to_string(lovelace) +
+                         ",\"timestamp\":" + std::to_string(timestamp) + "}");
+    } else if (pick < 30) {
+      route = "POST fiat";
+      // 1.00 to 200.99 in the shop's currency
+      char fiat[16];
+      snprintf(fiat, sizeof(fiat), "%u.%02u", 1 + (unsigned)(rng() % 200),
+               (unsigned)(rng() % 100));
+      server->inject(HTTP_POST, "/api/transactions",
+                     "{\"fiat_amount\":" + std::string(fiat) +
+                         ",\"timestamp\":" + std::to_string(timestamp) + "}");
+    } else if (pick < 70) {
+      route = "GET /api/transactions";
+      server->inject(HTTP_GET, "/api/transactions");
+    } else if (pick < 75) {
+      route = "GET /api/stats";
+      server->inject(HTTP_GET, "/api/stats");
+    } else if (pick < 95) {
+      route = "GET static";
+      WebServer::Request request;
+      request.uri = STATIC_FILES[rng() % 5];
+      auto cached = cachedEtags.find(request.uri);
+      if (cached != cachedEtags.end() && rng() % 2 == 0) {
+        request.headers["If-None-Match"] = cached->second;
+      }
+      server->inject(request);
+    } else {
+      route = "GET missing";
+      server->inject(HTTP_GET, "/missing/" + std::to_string(i));
+    }
+
+    // Service time is host CPU time; it is also charged to the virtual
+    // clock so that a slow handler delays the requests behind it
+    double waitMs = std::max(0.0, (double)millis() - virtualArrivalMs);
+    double start = nowUs();
+    webServerLoop();
+    double serviceUs = nowUs() - start;
+    handlerUsTotal += serviceUs;
+    hostsim::advanceClock((uint64_t)(serviceUs / 1000.0));
+
+    const WebServer::Response &response = server->lastResponse();
+    RouteStats &stats = routes[route];
+    stats.serviceUs.push_back(serviceUs);
+    stats.responseMs.push_back(waitMs + serviceUs / 1000.0);
+    stats.statusCounts[response.code]++;
+    stats.bytesSent += response.bytesSent;
+    if (route == "GET static" && !response.header("ETag").empty()) {
+      cachedEtags[server->uri().str()] = response.header("ETag");
+    }
+    if (route.compare(0, 4, "POST") == 0 && response.code == 201) {
+      postsCreated++;
+    }
+  }
+
+  double wallSeconds = (nowUs() - wallStart) / 1e6;
+  hostsim::FsStats fs = hostsim::fsStats();
+  int stored = countStoredTransactions(fsRoot);
+
+  // The sales totals are kept separately from transactions.json
+  server->inject(HTTP_GET, "/api/stats");
+  webServerLoop();
+  int counted = atoi(server->lastResponse().body.c_str() +
+                     strlen("{\"invoices\":"));
+
+  server->inject(HTTP_GET, "/api/trace");
+  webServerLoop();
+  const WebServer::Response &trace = server->lastResponse();
+  const std::string traceBegin = "{\"displayTimeUnit\"";
+  const bool traceOk = traceStartCode == 200 && trace.code == 200 &&
+                       trace.body.compare(0, traceBegin.size(),
+                                          traceBegin) == 0;
+  size_t tracedPosts = 0;
+  for (size_t at = 0; (at = trace.body.find("\"POST transactions\",\"ph\":"
+                                            "\"B\"", at)) != std::string::npos;
+       at++) {
+    tracedPosts++;
+  }
+
+  printf("cardano-pos load test: %d requests, seed %u, %.1f req/s arrival\n\n",
+         requestCount, seed, requestsPerSecond);
+  printf("%-24s %6s %9s %9s %9s %10s %10s %10s %10s  %s\n", "route",
+         "count", "p50 us", "p95 us", "p99 us", "p50 ms", "p95 ms", "p99 ms",
+         "KB sent", "status codes");
+  for (const auto &entry : routes) {
+    const RouteStats &stats = entry.second;
+    std::string codes;
+    for (const auto &code : stats.statusCounts) {
+      codes += std::to_string(code.first) + "x" +
+               std::to_string(code.second) + " ";
+    }
+    printf("%-24s %6zu %9.0f %9.0f %9.0f %10.1f %10.1f %10.1f %10.1f  %s\n",
+           entry.first.c_str(), stats.serviceUs.size(),
+           percentile(stats.serviceUs, 0.50), percentile(stats.serviceUs, 0.95),
+           percentile(stats.serviceUs, 0.99),
+           percentile(stats.responseMs, 0.50),
+           percentile(stats.responseMs, 0.95),
+           percentile(stats.responseMs, 0.99), stats.bytesSent / 1024.0,
+           codes.c_str());
+  }
+  printf("\n(us = host CPU time in the handler, ms = arrival to response on "
+         "the simulated clock)\n\n");
+
+  printf("Throughput:            %.0f requests/s of handler CPU time, %.1f s "
+         "wall\n",
+         requestCount / (handlerUsTotal / 1e6), wallSeconds);
+  printf("Simulated time:        %.1f minutes\n", millis() / 60000.0);
+  printf("Longest loop block:    %llu ms\n",
+         (unsigned long long)maxLoopBlockMs);
+  printf("Koios calls:           %llu (%llu tx_cbor for payment checks)\n",
+         (unsigned long long)koiosCalls, (unsigned long long)txCborCalls);
+  printf("Price API calls:       %llu\n", (unsigned long long)priceCalls);
+  printf("Flash written:         %.1f KB (%.1f KB per invoice)\n",
+         fs.bytesWritten / 1024.0,
+         postsCreated ? fs.bytesWritten / 1024.0 / postsCreated : 0.0);
+  printf("Flash read:            %.1f KB, %llu opens, %llu exists() calls\n",
+         fs.bytesRead / 1024.0, (unsigned long long)fs.opens,
+         (unsigned long long)fs.existsCalls);
+  printf("Estimated flash time:  %.1f s (at %.0f KB/s read, %.0f KB/s write)\n",
+         fs.bytesRead / 1024.0 / FLASH_READ_KB_PER_S +
+             fs.bytesWritten / 1024.0 / FLASH_WRITE_KB_PER_S,
+         FLASH_READ_KB_PER_S, FLASH_WRITE_KB_PER_S);
+  printf("Peak heap above start: %.1f KB (host allocator)\n",
+         (hostsim::heapPeakBytes() - heapAtStart) / 1024.0);
+  printf("Invoices created:      %d, stored in transactions.json: %d\n",
+         postsCreated, stored);
+  printf("Invoices in /api/stats: %d\n", counted);
+  printf("Trace (GET /api/trace): %s, %.1f KB, %zu invoices in the last "
+         "4000 events\n", traceOk ? "ok" : "FAILED", trace.body.size() / 1024.0,
+         tracedPosts);
+  if (stored < postsCreated) {
+    printf("WARNING: %d invoices are missing from the transaction store\n",
+           postsCreated - stored);
+  }
+
+  stdfs::remove_all(fsRoot);
+  return traceOk ? 0 : 1;
+}
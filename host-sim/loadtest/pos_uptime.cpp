@@ -0,0 +1,375 @@
+/**
+ * pos_uptime.cpp - Weeks of cardano-pos on the virtual clock
+ *
+ * Includes cardano-pos.ino itself and runs its setup() and loop(), with
+ * the web server, QR screen, payment watcher, price service and profilers
+ * behind them, for 60 simulated days. loop() runs once per pass (a second
+ * by default). The web interface is copied into a simulated flash, Koios
+ * and the price API are stubbed as in pos_loadtest.cpp, and everything runs
+ * on the model of the ESP32 heap.
+ *
+ * The shop is open from 9:00 to 18:00 every day. About 6 customers an hour
+ * come in at random; for each the shop posts an invoice (3 in 10 in fiat,
+ * converted with the cached price) and its browser reloads the transaction
+ * list. 9 in 10 customers pay, 20 seconds to 3 minutes later; the others
+ * leave, and their invoice stays open until the next one replaces it. The
+ * next customer waits until "Payment Received!" is off the screen.
+ *
+ * The script (days as in the report, counted from 1):
+ *   day 5, 10:00   the APIs give no answer for 3 hours
+ *   day 12, 14:00  WiFi is down for 2 hours
+ *   day 20         the APIs answer 2.5 s slower all day
+ *   day 50, 17:02  millis() wraps to 0. An invoice is posted 18 seconds
+ *                  before and paid just before, so its checks run across
+ *                  the wrap-around; 20 seconds after it a fiat invoice uses
+ *                  a price fetched before it.
+ *
+ * What should happen on a schedule, and is checked (see uptime_sim.h):
+ *   price          a price request every minute
+ *   payment check  a Koios request every 10 seconds while an invoice is
+ *                  open (payment_watcher.cpp, CHECK_INTERVAL)
+ *   success screen "Payment Received!" cleared after 10 seconds
+ *                  (transaction_qr.cpp, SUCCESS_DISPLAY_TIME)
+ *
+ * The program fails like ticker_uptime.cpp, and also when an invoice was
+ * refused outside the scripted events.
+ *
+ * Usage: ./bin/pos_uptime [days] [pass ms] [arena in KB] [seed]
+ */
+
+// The sketch: setup(), loop() and the display it draws on
+#include "cardano-pos.ino"
+
+#include "hostsim.h"
+#include "tx_builder.h"
+#include "uptime_sim.h"
+
+#include <WebServer.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace stdfs = std::filesystem;
+
+namespace {
+const int DEFAULT_DAYS = 60;
+const uint64_t DEFAULT_PASS_MS = 1000;
+// Free heap of the ESP32 with WiFi connected, before the sketch allocates
+const size_t DEFAULT_ARENA_KB = 160;
+
+// Source of the web interface copied into the simulated flash
+const char *DATA_DIR = "../Workshop-05/examples/cardano-pos/data";
+
+// The shop
+const uint64_t OPENS_MS = 9 * uptime::HOUR_MS;
+const uint64_t CLOSES_MS = 18 * uptime::HOUR_MS;
+const double CUSTOMERS_PER_HOUR = 6.0;
+const int FIAT_PERCENT = 30;
+const int PAYING_PERCENT = 90;
+const uint64_t PAY_MIN_MS = 20000;
+const uint64_t PAY_MAX_MS = 180000;
+
+// As in payment_watcher.cpp, price_service.cpp and transaction_qr.cpp
+const uint64_t CHECK_INTERVAL_MS = 10000;
+const uint64_t PRICE_INTERVAL_MS = 60000;
+const uint64_t SUCCESS_DISPLAY_MS = 10000;
+
+// First string value after key in a request body, e.g. the address in
+// {"_addresses":["addr_test1..."]}
+std::string jsonStringAfter(const std::string &json, const char *key) {
+  size_t start = json.find(key);
+  if (start == std::string::npos ||
+      (start = json.find('"', start + strlen(key))) == std::string::npos) {
+    return "";
+  }
+  size_t end = json.find('"', start + 1);
+  return end == std::string::npos ? "" : json.substr(start + 1, end - start - 1);
+}
+
+// The customer in front of the POS
+enum Till {
+  TILL_IDLE,    // Nobody, or an invoice nobody will pay
+  TILL_WAITING, // Invoice on the screen, payment may come
+  TILL_SUCCESS, // "Payment Received!" on the screen
+};
+
+struct Invoice {
+  bool fiat = false;
+  uint64_t payAtMs = UINT64_MAX; // Never: the customer left
+};
+} // namespace
+
+int main(int argc, char **argv) {
+  const int days = argc > 1 ? atoi(argv[1]) : DEFAULT_DAYS;
+  const uint64_t passMs =
+      argc > 2 ? (uint64_t)atoll(argv[2]) : DEFAULT_PASS_MS;
+  const size_t arenaKb =
+      argc > 3 ? (size_t)atol(argv[3]) : DEFAULT_ARENA_KB;
+  const unsigned seed = argc > 4 ? (unsigned)atoi(argv[4]) : 42;
+  if (days < 1 || passMs < 1) {
+    fprintf(stderr, "Run at least 1 day, with passes of at least 1 ms\n");
+    return 1;
+  }
+  const uint64_t endMs = (uint64_t)days * uptime::DAY_MS;
+  std::mt19937 rng(seed);
+
+  // Fresh simulated flash with the web interface on it
+  const std::string fsRoot =
+      (stdfs::temp_directory_path() / ("pos_uptime_" + std::to_string(seed)))
+          .string();
+  stdfs::remove_all(fsRoot);
+  stdfs::create_directories(fsRoot);
+  for (const auto &entry : stdfs::directory_iterator(DATA_DIR)) {
+    if (entry.path().filename() != "README.md") {
+      stdfs::copy(entry.path(), fsRoot / entry.path().filename());
+    }
+  }
+  hostsim::setFsRoot(fsRoot);
+  hostsim::setSerialEcho(false);
+  hostsim::useVirtualClock(true);
+  hostsim::setDisplayDrawing(false); // Draw calls are counted, not drawn
+  hostsim::clearNvs();
+  hostsim::WiFiAccessPoint router;
+  router.ssid = WIFI_SSID; // The network in config/secrets.h
+  hostsim::setWiFiAccessPoint(router);
+
+  uptime::Script script;
+  script.add(uptime::EVENT_API_DOWN, 4 * uptime::DAY_MS + 10 * uptime::HOUR_MS,
+             3 * uptime::HOUR_MS);
+  script.add(uptime::EVENT_WIFI_DOWN,
+             11 * uptime::DAY_MS + 14 * uptime::HOUR_MS, 2 * uptime::HOUR_MS);
+  script.add(uptime::EVENT_API_SLOW, 19 * uptime::DAY_MS, uptime::DAY_MS, 2500);
+
+  // A check or a screen change may wait for the end of a pass
+  const uint64_t toleranceMs = passMs;
+  uptime::UptimeReport report(script, endMs);
+  const int koiosApi = report.addApi("koios");
+  const int priceApi = report.addApi("price");
+  const int priceDeadline =
+      report.addDeadline("price", PRICE_INTERVAL_MS, toleranceMs);
+  const int checkDeadline =
+      report.addDeadline("payment check", CHECK_INTERVAL_MS, toleranceMs);
+  const int successDeadline =
+      report.addDeadline("success screen", SUCCESS_DISPLAY_MS, toleranceMs);
+
+  // Stubs without latency: on the board the price and the payment checks
+  // are fetched by tasks of their own and do not hold up loop(), host
+  // builds fetch them from loop()
+  Invoice invoice;
+  std::map<std::string, std::vector<uint8_t>> paymentTransactions; // By hash
+  hostsim::setHttpHandler([&](const hostsim::HttpRequest &request) {
+    const uint64_t now = uptime::simMs();
+    hostsim::HttpResponse reply;
+    reply.code = 200;
+    if (request.url.find("simple/price") != std::string::npos) {
+      report.request(priceApi, now);
+      report.hit(priceDeadline, now);
+      reply.body = "{\"cardano\":{\"usd\":0.4123}}";
+    } else if (request.url.find("/tx_cbor") != std::string::npos) {
+      // Raw transaction, checked by the firmware before it counts as paid
+      report.request(koiosApi, now);
+      const std::string hash =
+          jsonStringAfter(request.body, "\"_tx_hashes\":[");
+      auto tx = paymentTransactions.find(hash);
+      reply.body = tx == paymentTransactions.end()
+                       ? "[]"
+                       : "[{\"tx_hash\":\"" + hash + "\",\"cbor\":\"" +
+                             txbuilder::toHex(tx->second.data(),
+                                              tx->second.size()) +
+                             "\"}]";
+    } else {
+      report.request(koiosApi, now);
+      report.hit(checkDeadline, now);
+      if (now >= invoice.payAtMs) {
+        // The shared address is paid the exact amount it asks for, an
+        // invoice address more than any invoice
+        const size_t filter = request.url.find("value=eq.");
+        const uint64_t lovelace =
+            filter != std::string::npos
+                ? strtoull(request.url.c_str() + filter + 9, nullptr, 10)
+                : 1000000000000ULL;
+        const std::string address =
+            jsonStringAfter(request.body, "\"_addresses\":[");
+        const txbuilder::Transaction tx =
+            txbuilder::build(txbuilder::addressBytes(address), lovelace,
+                             300 + rng() % 1700, rng());
+        paymentTransactions.clear(); // Only the newest is asked for
+        paymentTransactions[tx.hash] = tx.cbor;
+        reply.body = "[{\"tx_hash\":\"" + tx.hash + "\",\"value\":\"" +
+                     std::to_string(lovelace) + "\"}]";
+      } else {
+        reply.body = "[]";
+      }
+    }
+    script.shape(reply, now);
+    return reply;
+  });
+
+  printf("cardano-pos for %d days (simulated), loop() every %llu ms, on a "
+         "%zu KB heap model, seed %u\n\n", days, (unsigned long long)passMs,
+         arenaKb, seed);
+
+  // Customers come in at random while the shop is open
+  std::exponential_distribution<double> customerGap(CUSTOMERS_PER_HOUR /
+                                                    uptime::HOUR_MS);
+  auto nextCustomer = [&](uint64_t after) {
+    uint64_t at = after + (uint64_t)customerGap(rng);
+    const uint64_t day = at / uptime::DAY_MS * uptime::DAY_MS;
+    if (at < day + OPENS_MS) {
+      at = day + OPENS_MS + (uint64_t)customerGap(rng);
+    } else if (at >= day + CLOSES_MS) {
+      at = day + uptime::DAY_MS + OPENS_MS + (uint64_t)customerGap(rng);
+    }
+    // Around the wrap-around only the scripted customers below
+    if (at + 5 * uptime::MINUTE_MS >= uptime::WRAP_MS &&
+        at < uptime::WRAP_MS + 5 * uptime::MINUTE_MS) {
+      at = uptime::WRAP_MS + 5 * uptime::MINUTE_MS;
+    }
+    return at;
+  };
+  struct Customer {
+    uint64_t atMs;
+    bool fiat;
+    uint64_t payAfterMs; // UINT64_MAX: leaves without paying
+  };
+  std::vector<Customer> scripted = {
+      {uptime::WRAP_MS - 18000, false, 16000},
+      {uptime::WRAP_MS + 20000, true, 30000},
+  };
+
+  // From here on the firmware's allocations are on the modelled heap
+  hostsim::useHeapModel(arenaKb * 1024);
+  setup();
+  WebServer *server = WebServer::instance();
+  if (server == nullptr) {
+    fprintf(stderr, "Web server was not created\n");
+    return 1;
+  }
+
+  // loop() runs once a pass here, not over and over: the profiler counts
+  // the rest of the pass as "other". Only a loop() that takes longer than
+  // the sketch's budget on top of that is a stall.
+  loopProfilerBegin(SECTION_NAMES, SECTION_COUNT, passMs + LOOP_BUDGET_MS);
+
+  uint64_t now = uptime::simMs();
+  uint64_t customerAt = nextCustomer(now);
+  size_t scriptedNext = 0;
+  Till till = TILL_IDLE;
+  bool reloadList = false;
+  uint64_t invoices = 0;
+  uint64_t paid = 0;
+  uint64_t refused = 0;
+  uint64_t refusedOutsideEvents = 0;
+  uint64_t longestPaidToScreenMs = 0;
+  uint64_t drawCalls = display.stats().drawCalls;
+  while (now < endMs) {
+    script.update(now);
+
+    // A customer: post an invoice (unless the last one is still being
+    // thanked)
+    bool posted = false;
+    const bool scriptedDue = scriptedNext < scripted.size() &&
+                             now >= scripted[scriptedNext].atMs;
+    if ((scriptedDue || now >= customerAt) && till != TILL_SUCCESS) {
+      hostsim::HeapModelPause pause; // The browser's request
+      Customer customer;
+      if (scriptedDue) {
+        customer = scripted[scriptedNext++];
+      } else {
+        customer.atMs = now;
+        customer.fiat = (int)(rng() % 100) < FIAT_PERCENT;
+        customer.payAfterMs =
+            (int)(rng() % 100) < PAYING_PERCENT
+                ? PAY_MIN_MS + rng() % (PAY_MAX_MS - PAY_MIN_MS)
+                : UINT64_MAX;
+        customerAt = nextCustomer(now);
+      }
+      const uint64_t timestamp = 1700000000000ULL + now;
+      std::string body;
+      if (customer.fiat) {
+        char fiat[16];
+        snprintf(fiat, sizeof(fiat), "%u.%02u", 1 + (unsigned)(rng() % 200),
+                 (unsigned)(rng() % 100));
+        body = "{\"fiat_amount\":" + std::string(fiat);
+      } else {
+        body = "{\"amount\":" +
+               std::to_string((1 + rng() % 50000) * 10000ULL);
+      }
+      body += ",\"timestamp\":" + std::to_string(timestamp) + "}";
+      server->inject(HTTP_POST, "/api/transactions", body);
+      invoice.fiat = customer.fiat;
+      invoice.payAtMs = customer.payAfterMs == UINT64_MAX
+                            ? UINT64_MAX
+                            : now + customer.payAfterMs;
+      posted = true;
+    } else if (reloadList) {
+      hostsim::HeapModelPause pause;
+      server->inject(HTTP_GET, "/api/transactions");
+      reloadList = false;
+    }
+
+    const uint64_t passStart = now;
+    loop();
+    now = uptime::simMs();
+
+    if (posted) {
+      invoices++;
+      if (server->lastResponse().code == 201) {
+        till = TILL_WAITING;
+        report.start(checkDeadline, passStart);
+        reloadList = true;
+      } else {
+        refused++;
+        if (!script.disturbed(passStart, now)) {
+          refusedOutsideEvents++;
+        }
+        invoice.payAtMs = UINT64_MAX;
+      }
+    }
+
+    // Anything drawn without a new invoice: the payment was found, or the
+    // success message was cleared
+    const uint64_t draws = display.stats().drawCalls;
+    if (!posted && draws != drawCalls) {
+      if (till == TILL_WAITING) {
+        till = TILL_SUCCESS;
+        paid++;
+        report.stop(checkDeadline);
+        report.start(successDeadline, now);
+        const uint64_t paidToScreen = now - invoice.payAtMs;
+        longestPaidToScreenMs = paidToScreen > longestPaidToScreenMs
+                                    ? paidToScreen
+                                    : longestPaidToScreenMs;
+        invoice.payAtMs = UINT64_MAX;
+      } else if (till == TILL_SUCCESS) {
+        till = TILL_IDLE;
+        report.hit(successDeadline, now);
+        report.stop(successDeadline);
+      }
+    }
+    drawCalls = draws;
+    report.pass(now);
+
+    // On to the next pass
+    const uint64_t passEnd = (now / passMs + 1) * passMs;
+    hostsim::advanceClock(passEnd - now);
+    now = passEnd;
+  }
+
+  hostsim::HeapModelPause pause;
+  const bool ok = report.finish(now);
+  printf("\n  Invoices: %llu posted, %llu paid, %llu refused (%llu outside "
+         "events)\n", (unsigned long long)invoices,
+         (unsigned long long)paid, (unsigned long long)refused,
+         (unsigned long long)refusedOutsideEvents);
+  printf("  Longest from payment to \"Payment Received!\": %.1f s\n",
+         longestPaidToScreenMs / 1000.0);
+  stdfs::remove_all(fsRoot);
+  return ok && refusedOutsideEvents == 0 ? 0 : 1;
+}
@@ -0,0 +1,382 @@
+/**
+ * ticker_faults.cpp - CardanoTicker against APIs that fail like production
+ *
+ * Runs CardanoTicker's setup() and loop() steps (without MQTT) with the
+ * firmware's data_fetcher.cpp, ticker.cpp and screens against the API
+ * stand-in of fault_server.h, on the virtual clock with the display at
+ * 40 MHz SPI. loop() runs back to back as on the board, so a frame of the
+ * ticker takes its 30 ms delay, the sprite push and whatever request ran in
+ * the same pass.
+ *
+ * Every run starts from power-on and lasts 45.5 minutes: 10.5 minutes of
+ * normal answers, 20 minutes of one fault on all APIs, and 15 minutes to
+ * recover.
+ * The faults are those seen in production:
+ *   slow drip     bodies trickle in at 256 bytes per second
+ *   truncated     bodies end halfway, with 200 OK
+ *   429 storm     every request gets 429 Too Many Requests
+ *   TLS reset     half the connections are reset in the TLS handshake
+ *   DNS timeout   every DNS lookup gets no answer (10 s)
+ * and one run without faults to compare with.
+ *
+ * For each run it prints:
+ *   frame p99, max     loop() time once the screens are up: how long the
+ *                      ticker stands still
+ *   frozen             total time in frames over 100 ms
+ *   balance, tokens    the oldest data shown (since its request was made)
+ *   requests           requests to Koios, MinSwap and Cexplorer while the
+ *                      fault was on, with how many of them were hit
+ *   recovered          time from the end of the fault until no data shown
+ *                      is late any more: older than its interval (a minute
+ *                      for the balance, 10 for the tokens) plus a minute
+ *
+ * It fails when data is still late at the end of a run.
+ *
+ * Usage: ./bin/ticker_faults [fault minutes]
+ */
+
+#include "config.h"
+#include "data_fetcher.h"
+#include "datascreens.h"
+#include "fault_server.h"
+#include "hostsim.h"
+#include "portfolio_json.h"
+#include "screen_helper.h"
+#include "startscreen.h"
+#include "ticker.h"
+#include "wifi_manager.h"
+
+#include <TFT_eSPI.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// The display the firmware draws on (defined in CardanoTicker.ino)
+TFT_eSPI tft = TFT_eSPI();
+
+namespace {
+const uint64_t MINUTE_MS = 60000;
+// The fault ends 30 s after the third portfolio update has started, so the
+// update it spoils is the last one before it ends: the worst case
+const uint64_t WARMUP_MS = 10 * MINUTE_MS + 30000;
+const uint64_t RECOVERY_MS = 15 * MINUTE_MS;
+const int DEFAULT_FAULT_MINUTES = 20;
+const uint32_t SPI_HZ = 40000000; // TFT_eSPI's usual SPI_FREQUENCY
+
+const uint32_t KOIOS_LATENCY_MS = 300;
+const uint32_t MINSWAP_LATENCY_MS = 900;
+const uint32_t CEXPLORER_LATENCY_MS = 400;
+
+const uint32_t DRIP_BYTES_PER_SECOND = 256;
+const uint32_t TLS_HANDSHAKE_MS = 600;   // Until the reset
+const uint32_t DNS_GIVE_UP_MS = 10000;   // lwIP's retries, with growing waits
+const uint32_t RETRY_AFTER_S = 60;
+const uint64_t FROZEN_FRAME_MS = 100;    // The ticker visibly stops
+
+// As in data_fetcher.cpp; data older than this plus LATE_MS is late
+const uint64_t KOIOS_INTERVAL_MS = MINUTE_MS;
+const uint64_t PORTFOLIO_INTERVAL_MS = 10 * MINUTE_MS;
+const uint64_t LATE_MS = MINUTE_MS;
+
+const unsigned long SCREEN_DURATION_MS = 10000; // As in CardanoTicker.ino
+const uint8_t SCREENS = 4;
+
+// The APIs the ticker calls, as reported
+const faults::Api TICKER_APIS[] = {faults::API_KOIOS, faults::API_MINSWAP,
+                                   faults::API_CEXPLORER};
+
+uint64_t simMs() { return hostsim::clockMicros() / 1000; }
+
+int screenIndex = 0;
+
+// showCurrentScreen() of CardanoTicker.ino
+void showCurrentScreen() {
+  switch (screenIndex) {
+  case 0:
+    drawWalletScreen();
+    break;
+  case 1:
+    drawTokenScreen();
+    break;
+  case 2:
+    drawNFTScreen();
+    break;
+  default:
+    drawStatusScreen();
+    break;
+  }
+}
+
+struct Run {
+  bool faulty;
+  faults::FaultKind kind;
+  uint32_t percent;
+  uint32_t value;
+};
+
+struct Result {
+  double frameP99Ms = 0;
+  uint64_t maxFrameMs = 0;
+  uint64_t frozenMs = 0;
+  uint64_t maxBalanceAgeMs = 0;
+  uint64_t maxTokensAgeMs = 0;
+  faults::ApiStats during[faults::API_COUNT]; // While the fault was on
+  int64_t recoveredMs = -1; // -1: still late at the end
+};
+
+// The wallet all runs show; Koios answers with a new balance every time,
+// so the one shown tells which request it came from
+portfolio::Portfolio wallet = portfolio::generate(6, 4, 3, 7);
+std::string minswap = portfolio::minswapJson(wallet, 7);
+std::vector<uint64_t> balanceRequestMs; // Index: balance in ADA - 1000
+
+void serveWallet(faults::FaultServer &server) {
+  server.serve(faults::API_KOIOS, [](const hostsim::HttpRequest &request) {
+    (void)request;
+    hostsim::HttpResponse reply;
+    reply.code = 200;
+    balanceRequestMs.push_back(simMs());
+    reply.body = "[{\"stake_address\":\"stake1...\",\"total_balance\":\"" +
+                 std::to_string((1000ULL + balanceRequestMs.size() - 1) *
+                                1000000ULL) +
+                 "\"}]";
+    reply.latencyMs = KOIOS_LATENCY_MS;
+    return reply;
+  });
+  server.serve(faults::API_MINSWAP, [](const hostsim::HttpRequest &request) {
+    (void)request;
+    hostsim::HttpResponse reply;
+    reply.code = 200;
+    reply.body = minswap;
+    reply.latencyMs = MINSWAP_LATENCY_MS;
+    return reply;
+  });
+  server.serve(faults::API_CEXPLORER, [](const hostsim::HttpRequest &request) {
+    hostsim::HttpResponse reply;
+    reply.code = 404;
+    reply.latencyMs = CEXPLORER_LATENCY_MS;
+    for (const portfolio::Collection &collection : wallet.collections) {
+      if (request.url.find(collection.policyId) != std::string::npos) {
+        reply.code = 200;
+        reply.body = portfolio::cexplorerJson(collection);
+      }
+    }
+    return reply;
+  });
+}
+
+// When the request of the balance shown was made, 0 for none yet
+uint64_t shownBalanceRequestMs() {
+  const long index = lround(getWalletBalance() - 1000.0);
+  if (index < 0 || index >= (long)balanceRequestMs.size()) {
+    return 0;
+  }
+  return balanceRequestMs[index];
+}
+
+// Power on, then loop() until the end of the recovery time
+Result runOnce(faults::FaultServer &server, const Run &run,
+               uint64_t faultMs) {
+  WiFi.disconnect(); // Power off
+  hostsim::clearNvs();
+  balanceRequestMs.clear();
+  server.clearFaults();
+  server.resetStats();
+
+  const uint64_t startMs = simMs();
+  const uint64_t faultStart = startMs + WARMUP_MS;
+  const uint64_t faultEnd = faultStart + faultMs;
+  const uint64_t endMs = faultEnd + RECOVERY_MS;
+  if (run.faulty) {
+    server.add({run.kind, faults::ALL_APIS, faultStart, faultMs, run.percent,
+                run.value});
+  }
+
+  // setup()
+  displayStartScreen();
+  wifiManagerSetup("hostsim", "secret");
+  initDataFetcher();
+
+  Result result;
+  std::vector<uint32_t> frames;
+  faults::ApiStats atStart[faults::API_COUNT];
+  bool faultSeen = false;
+  bool started = false;
+  unsigned long lastScreenChange = 0;
+  bool faultOver = false;
+  uint64_t lastLateMs = 0; // When data was last late, 0 for never
+  bool late = false;
+  uint64_t tokensFetchedMs = 0; // Request time of the tokens shown
+  uint64_t portfolioRequestMs = 0;
+  screenIndex = 0;
+  while (simMs() < endMs) {
+    const uint64_t passStart = simMs();
+    if (!faultSeen && passStart >= faultStart) {
+      for (int api = 0; api < faults::API_COUNT; api++) {
+        atStart[api] = server.stats((faults::Api)api);
+      }
+      faultSeen = true;
+    }
+
+    // loop()
+    wifiManagerLoop();
+    const unsigned long portfolioBefore = getLastPortfolioFetchTime();
+    const uint64_t requestsBefore =
+        server.stats(faults::API_MINSWAP).requests;
+    const uint8_t changed = updateDataStep();
+    if (server.stats(faults::API_MINSWAP).requests > requestsBefore) {
+      portfolioRequestMs = passStart; // The token list of this update
+    }
+    if (getLastPortfolioFetchTime() != portfolioBefore) {
+      tokensFetchedMs = portfolioRequestMs;
+    }
+    const unsigned long now = millis();
+    if (!started) {
+      if (changed != 0) {
+        initTicker();
+        showCurrentScreen();
+        lastScreenChange = now;
+        started = true;
+      } else {
+        delay(10);
+      }
+    } else {
+      if (changed & DATA_TOKENS) {
+        refreshTicker();
+      }
+      const uint8_t shown[SCREENS] = {DATA_BALANCE, DATA_TOKENS, DATA_NFTS,
+                                      0};
+      if (changed & shown[screenIndex]) {
+        showCurrentScreen();
+      }
+      if (now - lastScreenChange >= SCREEN_DURATION_MS) {
+        screenIndex = (screenIndex + 1) % SCREENS;
+        showCurrentScreen();
+        lastScreenChange = now;
+      }
+      updateTicker();
+      const uint64_t frameMs = simMs() - passStart;
+      frames.push_back((uint32_t)frameMs);
+      result.maxFrameMs = std::max(result.maxFrameMs, frameMs);
+      if (frameMs > FROZEN_FRAME_MS) {
+        result.frozenMs += frameMs;
+      }
+    }
+
+    // How old the data on the screens is
+    const uint64_t nowMs = simMs();
+    const uint64_t balanceMs = shownBalanceRequestMs();
+    const uint64_t balanceAge = nowMs - (balanceMs ? balanceMs : startMs);
+    const uint64_t tokensAge =
+        nowMs - (tokensFetchedMs ? tokensFetchedMs : startMs);
+    result.maxBalanceAgeMs = std::max(result.maxBalanceAgeMs, balanceAge);
+    result.maxTokensAgeMs = std::max(result.maxTokensAgeMs, tokensAge);
+    late = balanceAge > KOIOS_INTERVAL_MS + LATE_MS ||
+           tokensAge > PORTFOLIO_INTERVAL_MS + LATE_MS;
+    if (late) {
+      lastLateMs = nowMs;
+    }
+    if (!faultOver && nowMs >= faultEnd) {
+      faultOver = true;
+      for (int api = 0; api < faults::API_COUNT; api++) {
+        const faults::ApiStats &stats = server.stats((faults::Api)api);
+        result.during[api].requests = stats.requests - atStart[api].requests;
+        result.during[api].faulted = stats.faulted - atStart[api].faulted;
+      }
+    }
+  }
+  if (!late) {
+    result.recoveredMs =
+        lastLateMs > faultEnd ? (int64_t)(lastLateMs - faultEnd) : 0;
+  }
+
+  std::sort(frames.begin(), frames.end());
+  if (!frames.empty()) {
+    result.frameP99Ms = frames[(frames.size() - 1) * 99 / 100];
+  }
+  return result;
+}
+
+std::string requestsText(const Result &result) {
+  std::string text;
+  for (faults::Api api : TICKER_APIS) {
+    if (!text.empty()) {
+      text += " ";
+    }
+    text += std::to_string(result.during[api].requests);
+    if (result.during[api].faulted > 0) {
+      text += "(" + std::to_string(result.during[api].faulted) + ")";
+    }
+  }
+  return text;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  const int faultMinutes = argc > 1 ? atoi(argv[1]) : DEFAULT_FAULT_MINUTES;
+  if (faultMinutes < 1) {
+    fprintf(stderr, "Inject faults for at least 1 minute\n");
+    return 1;
+  }
+  const uint64_t faultMs = (uint64_t)faultMinutes * MINUTE_MS;
+  hostsim::setSerialEcho(false);
+  hostsim::useVirtualClock(true);
+  hostsim::setDisplaySpiClock(SPI_HZ);
+
+  faults::FaultServer server;
+  serveWallet(server);
+  hostsim::setHttpHandler(server.handler());
+  tft.init();
+  tft.setRotation(1);
+
+  const Run runs[] = {
+      {false, faults::FAULT_SLOW_DRIP, 0, 0},
+      {true, faults::FAULT_SLOW_DRIP, 100, DRIP_BYTES_PER_SECOND},
+      {true, faults::FAULT_TRUNCATED, 100, 50},
+      {true, faults::FAULT_RATE_LIMIT, 100, RETRY_AFTER_S},
+      {true, faults::FAULT_TLS_RESET, 50, TLS_HANDSHAKE_MS},
+      {true, faults::FAULT_DNS_TIMEOUT, 100, DNS_GIVE_UP_MS},
+  };
+
+  printf("CardanoTicker against the API stand-in: %d minutes of each fault "
+         "after %.1f of normal answers, %llu to recover\n\n", faultMinutes,
+         WARMUP_MS / (double)MINUTE_MS,
+         (unsigned long long)(RECOVERY_MS / MINUTE_MS));
+  printf("  %-22s %9s %9s %8s %9s %9s %-17s %10s\n", "run", "frame p99",
+         "max frame", "frozen", "balance", "tokens", "requests k m c",
+         "recovered");
+
+  bool ok = true;
+  for (const Run &run : runs) {
+    const Result result = runOnce(server, run, faultMs);
+    char recovered[16];
+    if (result.recoveredMs < 0) {
+      snprintf(recovered, sizeof(recovered), "no");
+      ok = false;
+    } else {
+      snprintf(recovered, sizeof(recovered), "%.1f s",
+               result.recoveredMs / 1000.0);
+    }
+    const faults::Fault fault = {run.kind, faults::ALL_APIS, 0, 0, run.percent,
+                                 run.value};
+    const std::string name =
+        run.faulty ? faults::FaultServer::describe(fault) : "no faults";
+    printf("  %-22s %6.1f ms %6.1f s %6.1f s %7.1f m %7.1f m %-17s %10s\n",
+           name.c_str(), result.frameP99Ms, result.maxFrameMs / 1000.0,
+           result.frozenMs / 1000.0, result.maxBalanceAgeMs / 60000.0,
+           result.maxTokensAgeMs / 60000.0, requestsText(result).c_str(),
+           recovered);
+  }
+  printf("\n  balance, tokens: oldest data shown, in minutes. requests: "
+         "Koios, MinSwap, Cexplorer\n  while the fault was on (hit by it).\n");
+
+  if (!ok) {
+    fprintf(stderr, "\nData was still late %llu minutes after a fault\n",
+            (unsigned long long)(RECOVERY_MS / MINUTE_MS));
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,593 @@
+/**
+ * ticker_fleet.cpp - Office fleet simulation for CardanoTicker MQTT sharing
+ *
+ * Simulates a number of tickers showing the same wallet and sharing data
+ * through the host MQTT broker (hostsim.h), as fleet_node.h describes. One
+ * ticker is the real firmware: data_fetcher.cpp and fleet_sync.cpp, fetching
+ * from stubbed Koios, MinSwap and Cexplorer APIs. The others run FleetNode
+ * with the firmware's fetch schedule (1 minute balance, 10 minute portfolio)
+ * and count the same API requests; the firmware keeps its state in globals,
+ * so one process can hold only one of it.
+ *
+ * Token prices move every 5 minutes and the balance every 30. Each fleet
+ * size runs twice, every ticker fetching on its own and with sharing, and
+ * reports API requests and broker traffic per hour.
+ *
+ * A failover run follows: the leader loses power, then all tickers ahead of
+ * the firmware in line, then the broker goes down for two minutes. At the
+ * end every powered ticker must show the wallet's current data.
+ *
+ * Usage: ./bin/ticker_fleet [hours] [max tickers]
+ */
+
+#include "config.h"
+#include "data_fetcher.h"
+#include "fleet_node.h"
+#include "fleet_sync.h"
+#include "hostsim.h"
+#include "portfolio_json.h"
+#include "ticker_snapshot.h"
+#include "wifi_manager.h"
+
+#include <PubSubClient.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+const char *FLEET_TOPIC = "cardanoticker/office";
+const unsigned long STEP_MS = 100;
+const unsigned long KOIOS_INTERVAL_MS = 60UL * 1000UL;
+const unsigned long PORTFOLIO_INTERVAL_MS = 10UL * 60UL * 1000UL;
+const unsigned long PRICE_INTERVAL_MS = 5UL * 60UL * 1000UL;
+const unsigned long BALANCE_INTERVAL_MS = 30UL * 60UL * 1000UL;
+const unsigned long RETRY_INTERVAL_MS = 5000;
+// Prices stop moving this long before the end, so every ticker can catch up
+const unsigned long QUIET_END_MS = 12UL * 60UL * 1000UL;
+
+struct ApiCount {
+  uint64_t koios = 0;
+  uint64_t minswap = 0;
+  uint64_t cexplorer = 0;
+  uint64_t total() const { return koios + minswap + cexplorer; }
+};
+
+// The wallet as the APIs see it
+struct World {
+  portfolio::Portfolio wallet;
+  uint64_t balanceLovelace = 0;
+  std::mt19937 random{7};
+  unsigned long lastPriceChange = 0;
+  unsigned long lastBalanceChange = 0;
+  bool frozen = false;
+  ApiCount api;
+
+  void reset(unsigned long now) {
+    wallet = portfolio::generate(8, 6, 3, 42);
+    balanceLovelace = 1234567890;
+    lastPriceChange = lastBalanceChange = now;
+    frozen = false;
+    api = ApiCount();
+  }
+
+  void tick(unsigned long now) {
+    if (frozen) {
+      return;
+    }
+    if (now - lastPriceChange >= PRICE_INTERVAL_MS) {
+      lastPriceChange = now;
+      // About half the tokens move, rounded like a price feed
+      for (portfolio::Token &token : wallet.tokens) {
+        if (random() % 2 == 0) {
+          double move = 1 + ((double)(random() % 2001) - 1000) / 50000;
+          token.priceUsd = std::round(token.priceUsd * move * 1e6) / 1e6;
+          token.change24h = ((double)(random() % 4001) - 2000) / 100;
+        }
+      }
+    }
+    if (now - lastBalanceChange >= BALANCE_INTERVAL_MS) {
+      lastBalanceChange = now;
+      balanceLovelace += random() % 50000000;
+    }
+  }
+
+  double balanceAda() const { return balanceLovelace / 1e6; }
+
+  std::string snapshot() const {
+    SnapshotWriter writer;
+    for (const portfolio::Token &token : wallet.tokens) {
+      writer.addToken(token.ticker.c_str(), llround(token.amount * 1e6),
+                      llround(token.priceUsd * token.amount * 1e6),
+                      (int32_t)lround(token.change24h * 100));
+    }
+    for (const portfolio::Collection &collection : wallet.collections) {
+      writer.addNft(collection.name.c_str(), (uint32_t)collection.count,
+                    collection.floorLovelace);
+    }
+    uint8_t buffer[SNAPSHOT_MAX_SIZE];
+    size_t length = writer.finish(0, buffer, sizeof(buffer));
+    return std::string((const char *)buffer, length);
+  }
+};
+
+World world;
+
+std::string tickerId(int index) {
+  char id[FLEET_ID_LENGTH];
+  snprintf(id, sizeof(id), "ticker-240ac40000%02x", index & 0xff);
+  return id;
+}
+
+bool matches(double actual, double expected) {
+  return std::fabs(actual - expected) <=
+         1e-5 * std::max(1.0, std::fabs(expected));
+}
+
+// A snapshot holds the wallet's current tokens and NFTs (within float
+// precision, as the firmware keeps floats)
+bool snapshotShowsWallet(const uint8_t *data, size_t length) {
+  SnapshotReader reader;
+  if (!reader.open(data, length) ||
+      reader.tokenCount() != (int)world.wallet.tokens.size() ||
+      reader.nftCount() != (int)world.wallet.collections.size()) {
+    return false;
+  }
+  for (int i = 0; i < reader.tokenCount(); i++) {
+    const portfolio::Token &expected = world.wallet.tokens[i];
+    SnapshotToken token;
+    reader.token(i, token);
+    if (!matches(token.valueMicroUsd / 1e6, expected.priceUsd * expected.amount) ||
+        !matches(token.change24hCentiPercent / 100.0, expected.change24h)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// A ticker running FleetNode with the firmware's schedule
+class SimTicker : public FleetLink {
+public:
+  SimTicker(const std::string &id, bool sharing) : id_(id), sharing_(sharing) {
+    node_.begin(FLEET_TOPIC, id_.c_str(), this);
+    mqtt_.setBufferSize(SNAPSHOT_MAX_SIZE + FLEET_TOPIC_LENGTH + 8);
+    mqtt_.setKeepAlive(15);
+    mqtt_.setCallback([this](char *topic, uint8_t *payload, unsigned int n) {
+      node_.receive(topic, payload, n);
+    });
+  }
+
+  bool publish(const char *topic, const uint8_t *payload, size_t length,
+               bool retained) override {
+    return mqtt_.publish(topic, payload, length, retained);
+  }
+
+  void loop(unsigned long now) {
+    if (!powered_) {
+      return;
+    }
+    if (sharing_) {
+      if (!mqtt_.connected()) {
+        node_.disconnected();
+        if (lastAttempt_ == 0 || now - lastAttempt_ >= RETRY_INTERVAL_MS) {
+          lastAttempt_ = now;
+          if (mqtt_.connect(id_.c_str(), node_.nodeTopic(), 0, true, "")) {
+            mqtt_.subscribe(node_.subscription());
+            node_.connected(now);
+            published_ = false;
+          }
+        }
+      } else {
+        mqtt_.loop();
+      }
+    }
+
+    if (!sharing_ || !mqtt_.connected() || node_.isLeader(now)) {
+      fetch(now);
+      if (sharing_ && mqtt_.connected() && !published_) {
+        published_ = node_.publishBalance((float)balance_) &&
+                     node_.publishPortfolio(
+                         (const uint8_t *)snapshot_.data(), snapshot_.size());
+      }
+    } else if (sharing_ && mqtt_.connected()) {
+      // Like showWalletBalance() and showPortfolioSnapshot()
+      if (node_.balanceVersion() != balanceVersion_) {
+        balanceVersion_ = node_.balanceVersion();
+        balance_ = node_.balance();
+        lastKoios_ = now;
+      }
+      if (node_.portfolioVersion() != portfolioVersion_) {
+        portfolioVersion_ = node_.portfolioVersion();
+        size_t length;
+        const uint8_t *data = node_.portfolio(length);
+        snapshot_.assign((const char *)data, length);
+        lastPortfolio_ = now;
+      }
+    }
+  }
+
+  void powerOff() { powered_ = false; }
+  bool powered() const { return powered_; }
+  bool leads(unsigned long now) const {
+    return powered_ && node_.isLeader(now);
+  }
+  const std::string &id() const { return id_; }
+  const FleetNode &node() const { return node_; }
+
+  bool showsWallet() const {
+    return matches(balance_, (float)world.balanceAda()) &&
+           snapshotShowsWallet((const uint8_t *)snapshot_.data(),
+                               snapshot_.size());
+  }
+
+private:
+  void fetch(unsigned long now) {
+    if (lastKoios_ == 0 || now - lastKoios_ >= KOIOS_INTERVAL_MS) {
+      lastKoios_ = now;
+      world.api.koios++;
+      balance_ = world.balanceAda();
+      published_ = false;
+    }
+    if (lastPortfolio_ == 0 || now - lastPortfolio_ >= PORTFOLIO_INTERVAL_MS) {
+      lastPortfolio_ = now;
+      world.api.minswap++;
+      world.api.cexplorer += world.wallet.collections.size();
+      snapshot_ = world.snapshot();
+      published_ = false;
+    }
+  }
+
+  std::string id_;
+  bool sharing_;
+  bool powered_ = true;
+  PubSubClient mqtt_;
+  FleetNode node_;
+  unsigned long lastAttempt_ = 0;
+  unsigned long lastKoios_ = 0;
+  unsigned long lastPortfolio_ = 0;
+  bool published_ = false;
+  uint32_t balanceVersion_ = 0;
+  uint32_t portfolioVersion_ = 0;
+  double balance_ = 0;
+  std::string snapshot_;
+};
+
+// The real firmware, as setup() and loop() in CardanoTicker.ino run it
+struct Firmware {
+  bool sharing = false;
+  bool powered = true;
+
+  void boot(bool withSharing) {
+    sharing = withSharing;
+    powered = true;
+    wifiManagerSetup("hostsim", "");
+    initDataFetcher();
+    if (sharing) {
+      fleetSyncBegin(); // Connects once WiFi is up, setup() does not wait
+    }
+    loadSavedData();
+  }
+
+  void loop() {
+    if (!powered) {
+      return;
+    }
+    wifiManagerLoop();
+    if (sharing) {
+      fleetSyncLoop();
+    }
+    if (!sharing || fleetSyncShouldFetch()) {
+      updateDataStep(); // One request per loop() pass
+    }
+  }
+
+  bool leads() const {
+    return powered && sharing && strcmp(fleetSyncRole(), "Fetching") == 0;
+  }
+
+  bool showsWallet() const {
+    uint8_t snapshot[SNAPSHOT_MAX_SIZE];
+    size_t length = writePortfolioSnapshot(snapshot, sizeof(snapshot));
+    return matches(getWalletBalance(), (float)world.balanceAda()) &&
+           snapshotShowsWallet(snapshot, length);
+  }
+};
+
+Firmware firmware;
+
+hostsim::HttpResponse answerApi(const hostsim::HttpRequest &request) {
+  hostsim::HttpResponse reply;
+  reply.code = 404;
+  if (request.url.find("/account_info") != std::string::npos) {
+    world.api.koios++;
+    reply.code = 200;
+    reply.body = "[{\"stake_address\":\"stake1...\",\"total_balance\":\"" +
+                 std::to_string(world.balanceLovelace) + "\"}]";
+  } else if (request.url.find("/portfolio/tokens") != std::string::npos) {
+    world.api.minswap++;
+    reply.code = 200;
+    reply.body = portfolio::minswapJson(world.wallet, 42);
+  } else if (request.url.find("/policy/detail") != std::string::npos) {
+    world.api.cexplorer++;
+    for (const portfolio::Collection &collection : world.wallet.collections) {
+      if (request.url.find(collection.policyId) != std::string::npos) {
+        reply.code = 200;
+        reply.body = portfolio::cexplorerJson(collection);
+      }
+    }
+  }
+  return reply;
+}
+
+unsigned long now() { return millis(); }
+
+struct Fleet {
+  std::vector<std::unique_ptr<SimTicker>> tickers;
+  int firmwareIndex = -1; // Position of the firmware in line, -1 = none
+
+  // Tickers 0..count-1 by id; the firmware takes one position
+  void boot(int count, int firmwareAt, bool sharing) {
+    tickers.clear();
+    firmwareIndex = firmwareAt;
+    firmware.powered = false; // Until it boots below
+    for (int i = 0; i < count; i++) {
+      if (i == firmwareAt) {
+        continue;
+      }
+      tickers.push_back(std::make_unique<SimTicker>(tickerId(i), sharing));
+    }
+    // The simulated tickers come up first, then the firmware joins
+    for (int i = 0; i < 50; i++) {
+      step();
+    }
+    if (firmwareAt >= 0) {
+      std::string mac = tickerId(firmwareAt).substr(7);
+      char address[18];
+      snprintf(address, sizeof(address), "%c%c:%c%c:%c%c:%c%c:%c%c:%c%c",
+               mac[0], mac[1], mac[2], mac[3], mac[4], mac[5], mac[6], mac[7],
+               mac[8], mac[9], mac[10], mac[11]);
+      hostsim::setMacAddress(address);
+      firmware.boot(sharing);
+    }
+  }
+
+  void step() {
+    hostsim::advanceClock(STEP_MS);
+    world.tick(now());
+    for (auto &ticker : tickers) {
+      ticker->loop(now());
+    }
+    firmware.loop();
+  }
+
+  // Powered tickers that currently lead
+  std::vector<std::string> leaders() const {
+    std::vector<std::string> out;
+    for (const auto &ticker : tickers) {
+      if (ticker->leads(now())) {
+        out.push_back(ticker->id());
+      }
+    }
+    if (firmwareIndex >= 0 && firmware.leads()) {
+      out.push_back(tickerId(firmwareIndex) + " (firmware)");
+    }
+    return out;
+  }
+
+  int poweredCount() const {
+    int count = firmware.powered ? 1 : 0;
+    for (const auto &ticker : tickers) {
+      count += ticker->powered() ? 1 : 0;
+    }
+    return count;
+  }
+
+  // Powered tickers not showing the wallet's current data
+  int stale() const {
+    int count = firmware.powered && !firmware.showsWallet() ? 1 : 0;
+    for (const auto &ticker : tickers) {
+      if (ticker->powered() && !ticker->showsWallet()) {
+        count++;
+      }
+    }
+    return count;
+  }
+
+  uint32_t keyframes() const {
+    uint32_t count = 0;
+    for (const auto &ticker : tickers) {
+      count += ticker->node().stats().keyframes;
+    }
+    return count;
+  }
+
+  uint32_t deltas() const {
+    uint32_t count = 0;
+    for (const auto &ticker : tickers) {
+      count += ticker->node().stats().deltas;
+    }
+    return count;
+  }
+};
+
+Fleet fleet;
+
+void startRun(int count, int firmwareAt, bool sharing) {
+  hostsim::resetMqttBroker();
+  world.reset(now());
+  fleet.boot(count, firmwareAt, sharing);
+}
+
+void runFor(unsigned long ms) {
+  unsigned long end = now() + ms;
+  while ((long)(end - now()) > 0) {
+    fleet.step();
+  }
+}
+
+// Run until a leader is settled; returns how long that took
+double secondsUntilLeader(const char *exclude) {
+  unsigned long start = now();
+  for (;;) {
+    std::vector<std::string> leaders = fleet.leaders();
+    if (leaders.size() == 1 && (exclude == nullptr || leaders[0] != exclude)) {
+      return (now() - start) / 1000.0;
+    }
+    if (now() - start > 10UL * 60UL * 1000UL) {
+      return -1;
+    }
+    fleet.step();
+  }
+}
+
+bool sizeTable(double hours, int maxTickers) {
+  printf("%8s %8s %14s %12s %11s %12s %8s\n", "tickers", "sharing",
+         "API requests/h", "MQTT msgs/h", "MQTT KB/h", "full/deltas",
+         "stale");
+  unsigned long duration = (unsigned long)(hours * 3600000.0);
+  bool ok = true;
+  for (int count : {1, 5, 20, 50}) {
+    if (count > maxTickers) {
+      break;
+    }
+    for (bool sharing : {false, true}) {
+      startRun(count, count / 2, sharing);
+      world.api = ApiCount(); // Count from here, boot fetches included
+      hostsim::MqttStats before = hostsim::mqttStats();
+      unsigned long start = now();
+      runFor(duration - QUIET_END_MS);
+      world.frozen = true;
+      runFor(QUIET_END_MS);
+      double elapsedH = (now() - start) / 3600000.0;
+      hostsim::MqttStats mqtt = hostsim::mqttStats();
+      int stale = fleet.stale();
+      ok = ok && stale == 0;
+      printf("%8d %8s %14.0f %12.0f %11.1f %5u/%-6u %8d\n", count,
+             sharing ? "on" : "off", world.api.total() / elapsedH,
+             (mqtt.messagesDelivered - before.messagesDelivered) / elapsedH,
+             (mqtt.bytesDelivered - before.bytesDelivered) / 1024.0 /
+                 elapsedH,
+             fleet.keyframes(), fleet.deltas(), stale);
+    }
+  }
+  return ok;
+}
+
+bool failover() {
+  const int count = 20;
+  const int firmwareAt = 5;
+  printf("\nFailover: %d tickers, the firmware is %s\n", count,
+         tickerId(firmwareAt).c_str());
+  startRun(count, firmwareAt, true);
+  bool ok = true;
+
+  double seconds = secondsUntilLeader(nullptr);
+  std::vector<std::string> leaders = fleet.leaders();
+  printf("  boot                     %s leads after %.1f s\n",
+         leaders.empty() ? "nobody" : leaders[0].c_str(), seconds);
+  ok = ok && leaders.size() == 1 && leaders[0] == tickerId(0);
+  runFor(30UL * 60UL * 1000UL);
+
+  // The leader loses power: no clean disconnect, its last will comes when
+  // the broker's keep-alive runs out
+  fleet.tickers[0]->powerOff();
+  seconds = secondsUntilLeader(tickerId(0).c_str());
+  leaders = fleet.leaders();
+  printf("  leader loses power       %s leads after %.1f s\n",
+         leaders.empty() ? "nobody" : leaders[0].c_str(), seconds);
+  ok = ok && seconds > 0 && seconds < 30;
+  runFor(30UL * 60UL * 1000UL);
+
+  // Everyone ahead of the firmware loses power
+  for (int i = 1; i < firmwareAt; i++) {
+    fleet.tickers[i]->powerOff();
+  }
+  uint64_t before = hostsim::httpStats().requests;
+  seconds = secondsUntilLeader(tickerId(firmwareAt - 1).c_str());
+  leaders = fleet.leaders();
+  printf("  tickers 1-%d lose power   %s leads after %.1f s\n",
+         firmwareAt - 1, leaders.empty() ? "nobody" : leaders[0].c_str(),
+         seconds);
+  ok = ok && leaders.size() == 1 &&
+       leaders[0].find("firmware") != std::string::npos;
+  runFor(15UL * 60UL * 1000UL);
+  uint64_t firmwareRequests = hostsim::httpStats().requests - before;
+  printf("                           firmware made %llu API requests in 15 "
+         "min\n",
+         (unsigned long long)firmwareRequests);
+  ok = ok && firmwareRequests > 0;
+
+  // Broker outage: every ticker falls back to fetching on its own
+  ApiCount apiBefore = world.api;
+  hostsim::setMqttBrokerUp(false);
+  runFor(2UL * 60UL * 1000UL);
+  uint64_t outageRequests = world.api.total() - apiBefore.total();
+  hostsim::setMqttBrokerUp(true);
+  seconds = secondsUntilLeader(nullptr);
+  leaders = fleet.leaders();
+  printf("  broker down for 2 min    %llu API requests (tickers fetch on "
+         "their own)\n",
+         (unsigned long long)outageRequests);
+  printf("  broker back              %s leads after %.1f s\n",
+         leaders.empty() ? "nobody" : leaders[0].c_str(), seconds);
+  ok = ok && leaders.size() == 1;
+  runFor(20UL * 60UL * 1000UL);
+
+  // The firmware's WiFi drops for 40 s (only the firmware uses the
+  // simulated WiFi). Its broker session dies with it, so another ticker
+  // takes over; when WiFi is back, the firmware reconnects at once.
+  const std::string firmwareLabel = tickerId(firmwareAt) + " (firmware)";
+  hostsim::setWiFiConnected(false);
+  seconds = secondsUntilLeader(firmwareLabel.c_str());
+  leaders = fleet.leaders();
+  printf("  firmware WiFi down 40 s  %s leads after %.1f s\n",
+         leaders.empty() ? "nobody" : leaders[0].c_str(), seconds);
+  ok = ok && leaders.size() == 1 && leaders[0] != firmwareLabel;
+  runFor(40000UL - (unsigned long)(seconds * 1000.0));
+  hostsim::setWiFiConnected(true);
+  seconds = secondsUntilLeader(tickerId(firmwareAt + 1).c_str());
+  leaders = fleet.leaders();
+  WifiStats wifi = wifiManagerGetStats();
+  printf("  firmware WiFi back       %s leads after %.1f s (WiFi outage "
+         "%.1f s)\n",
+         leaders.empty() ? "nobody" : leaders[0].c_str(), seconds,
+         wifi.lastOutageMs / 1000.0);
+  ok = ok && leaders.size() == 1 && leaders[0] == firmwareLabel &&
+       wifi.disconnects == 1;
+
+  runFor(20UL * 60UL * 1000UL);
+  world.frozen = true;
+  runFor(QUIET_END_MS);
+  int stale = fleet.stale();
+  printf("  end                      %d of %d powered tickers show the "
+         "current data\n",
+         fleet.poweredCount() - stale, fleet.poweredCount());
+  return ok && stale == 0;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  double hours = argc > 1 ? atof(argv[1]) : 2.0;
+  int maxTickers = argc > 2 ? atoi(argv[2]) : 50;
+  hostsim::setSerialEcho(false);
+  hostsim::useVirtualClock(true);
+  hostsim::setWiFiConnected(true);
+  hostsim::setHttpHandler(answerApi);
+  mqttBroker = "mqtt.local";
+  fleetTopic = FLEET_TOPIC;
+
+  printf("CardanoTicker fleet simulation: %.1f h per run, prices move every "
+         "5 min, 8 tokens, 6 NFT collections\n\n",
+         hours);
+  bool ok = sizeTable(hours, maxTickers);
+  ok = failover() && ok;
+  printf("\n%s\n", ok ? "All checks passed"
+                      : "FAILED: see the stale column and failover lines");
+  return ok ? 0 : 1;
+}
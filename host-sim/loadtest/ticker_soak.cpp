@@ -0,0 +1,278 @@
+/**
+ * ticker_soak.cpp - Days of CardanoTicker on a model of the ESP32's heap
+ *
+ * Runs CardanoTicker's setup() and loop() steps (without MQTT) with the
+ * firmware's data_fetcher.cpp, ticker.cpp, screens and heap_profiler.cpp
+ * for many simulated hours, on hostsim::useHeapModel(): every allocation
+ * the firmware makes takes room in an arena the size of the heap the ESP32
+ * has left once WiFi is up, with the board's best fit allocator, so holes
+ * build up as they would on the board. https requests take mbedTLS's
+ * 20 KB of record buffers from it for as long as they run.
+ *
+ * The wallet changes every hour (tokens and NFT collections come and go),
+ * so the fetcher's Strings and JSON documents change size. Between fetches
+ * the ticker draws a frame a second and the screens rotate every 10 s, as
+ * the real loop() does (only fewer frames, to finish in reasonable time).
+ *
+ * heap_profiler.cpp samples the heap every 10 minutes. The program prints
+ * one line per hour: free heap, largest free block, holes, fragmentation
+ * and allocations. It fails when
+ * - the fragmentation of the last hour is more than the threshold (in
+ *   percentage points) above that of the first hour
+ * - any allocation would have failed on the board
+ * and ends with the profiler's report of the allocation sites.
+ *
+ * Usage: ./bin/ticker_soak [hours] [threshold in points] [arena in KB]
+ */
+
+#include "config.h"
+#include "data_fetcher.h"
+#include "datascreens.h"
+#include "heap_profiler.h"
+#include "hostsim.h"
+#include "portfolio_json.h"
+#include "screen_helper.h"
+#include "startscreen.h"
+#include "ticker.h"
+#include "wifi_manager.h"
+
+#include <TFT_eSPI.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// The display the firmware draws on (defined in CardanoTicker.ino)
+TFT_eSPI tft = TFT_eSPI();
+
+namespace {
+const int DEFAULT_HOURS = 48;
+const int DEFAULT_THRESHOLD_POINTS = 10;
+// Free heap of the ESP32 with WiFi connected, before the sketch allocates
+const size_t DEFAULT_ARENA_KB = 160;
+
+const uint32_t KOIOS_LATENCY_MS = 300;
+const uint32_t MINSWAP_LATENCY_MS = 900;
+const uint32_t CEXPLORER_LATENCY_MS = 400;
+
+const unsigned long SCREEN_DURATION_MS = 10000; // As in CardanoTicker.ino
+const unsigned long HEAP_SAMPLE_INTERVAL_MS = 600000UL;
+const unsigned long FRAME_INTERVAL_MS = 1000;
+const unsigned long HOUR_MS = 3600000UL;
+const uint8_t SCREENS = 4;
+
+// heapProfilerReport() to the terminal (Serial is silenced)
+class StdoutPrint : public Print {
+public:
+  size_t write(uint8_t c) override {
+    fputc(c, stdout);
+    return 1;
+  }
+};
+
+int screenIndex = 0;
+
+// showCurrentScreen() of CardanoTicker.ino
+void showCurrentScreen() {
+  switch (screenIndex) {
+  case 0:
+    drawWalletScreen();
+    break;
+  case 1:
+    drawTokenScreen();
+    break;
+  case 2:
+    drawNFTScreen();
+    break;
+  default:
+    drawStatusScreen();
+    break;
+  }
+}
+
+// The wallet in hour h: between 3 and 12 tokens, 1 to 5 collections
+portfolio::Portfolio walletOfHour(int hour) {
+  const uint32_t seed = 1000 + hour;
+  return portfolio::generate(3 + (hour * 7) % 10, 1 + (hour * 3) % 5,
+                             1 + hour % 4, seed);
+}
+
+// Mean fragmentation of the samples taken in one hour
+struct HourStats {
+  uint32_t samples = 0;
+  uint32_t fragmentationSum = 0;
+  uint32_t minLargest = UINT32_MAX;
+  uint32_t minFree = UINT32_MAX;
+  uint32_t maxHoles = 0;
+  uint64_t allocations = 0;
+
+  void add(const HeapSample &sample) {
+    samples++;
+    fragmentationSum += sample.fragmentation;
+    minLargest = sample.largestBlock < minLargest ? sample.largestBlock
+                                                  : minLargest;
+    minFree = sample.freeBytes < minFree ? sample.freeBytes : minFree;
+    maxHoles = sample.freeBlocks > maxHoles ? sample.freeBlocks : maxHoles;
+    allocations += sample.allocations;
+  }
+  double fragmentation() const {
+    return samples == 0 ? 0.0 : (double)fragmentationSum / samples;
+  }
+};
+} // namespace
+
+int main(int argc, char **argv) {
+  const int hours = argc > 1 ? atoi(argv[1]) : DEFAULT_HOURS;
+  const int thresholdPoints =
+      argc > 2 ? atoi(argv[2]) : DEFAULT_THRESHOLD_POINTS;
+  const size_t arenaKb =
+      argc > 3 ? (size_t)atol(argv[3]) : DEFAULT_ARENA_KB;
+  if (hours < 2) {
+    fprintf(stderr, "Run at least 2 hours\n");
+    return 1;
+  }
+  hostsim::setSerialEcho(false);
+  hostsim::useVirtualClock(true);
+  hostsim::setDisplayDrawing(false); // Draw calls are counted, not drawn
+  hostsim::clearNvs();
+
+  int walletHour = 0;
+  portfolio::Portfolio wallet = walletOfHour(0);
+  std::string minswap = portfolio::minswapJson(wallet, 0);
+  hostsim::setHttpHandler([&](const hostsim::HttpRequest &request) {
+    hostsim::HttpResponse reply;
+    reply.code = 404;
+    if (request.url.find("account_info") != std::string::npos) {
+      reply.code = 200;
+      reply.body = "[{\"stake_address\":\"stake1...\",\"total_balance\":\"" +
+                   std::to_string(1000000000ULL + walletHour * 7654321ULL) +
+                   "\"}]";
+      reply.latencyMs = KOIOS_LATENCY_MS;
+    } else if (request.url.find("/portfolio/tokens") != std::string::npos) {
+      reply.code = 200;
+      reply.body = minswap;
+      reply.latencyMs = MINSWAP_LATENCY_MS;
+    } else if (request.url.find("/policy/detail") != std::string::npos) {
+      reply.latencyMs = CEXPLORER_LATENCY_MS;
+      for (const portfolio::Collection &collection : wallet.collections) {
+        if (request.url.find(collection.policyId) != std::string::npos) {
+          reply.code = 200;
+          reply.body = portfolio::cexplorerJson(collection);
+        }
+      }
+    }
+    return reply;
+  });
+
+  // From here on the firmware's allocations are on the modelled heap
+  hostsim::useHeapModel(arenaKb * 1024);
+
+  // setup()
+  heapProfilerBegin(HEAP_SAMPLE_INTERVAL_MS);
+  tft.init();
+  tft.setRotation(1);
+  displayStartScreen();
+  wifiManagerSetup("hostsim", "secret");
+  initDataFetcher();
+
+  printf("CardanoTicker for %d hours (simulated) on a %zu KB heap model, "
+         "wallet changing every hour\n\n", hours, arenaKb);
+  printf("  %4s %9s %11s %6s %6s %12s\n", "hour", "free KB", "largest KB",
+         "holes", "frag", "allocs/hour");
+
+  // loop(), one pass per second
+  const unsigned long startMs = millis();
+  bool started = false;
+  unsigned long lastScreenChange = 0;
+  HourStats hourStats;
+  HourStats firstHour;
+  HourStats lastHour;
+  unsigned long lastSampleAt = 0;
+  int hour = 0;
+  while (hour < hours) {
+    const unsigned long passStart = millis();
+    wifiManagerLoop();
+    const uint8_t changed = updateDataStep();
+    heapProfilerLoop();
+    const unsigned long now = millis();
+    if (!started) {
+      if (changed != 0) {
+        initTicker();
+        showCurrentScreen();
+        lastScreenChange = now;
+        started = true;
+      }
+    } else {
+      if (changed & DATA_TOKENS) {
+        refreshTicker();
+      }
+      const uint8_t shown[SCREENS] = {DATA_BALANCE, DATA_TOKENS, DATA_NFTS,
+                                      0};
+      if (changed & shown[screenIndex]) {
+        showCurrentScreen();
+      }
+      if (now - lastScreenChange >= SCREEN_DURATION_MS) {
+        screenIndex = (screenIndex + 1) % SCREENS;
+        showCurrentScreen();
+        lastScreenChange = now;
+      }
+      updateTicker();
+    }
+
+    const HeapSample sample = heapProfilerLast();
+    if (sample.atMs != lastSampleAt) {
+      lastSampleAt = sample.atMs;
+      hourStats.add(sample);
+    }
+
+    // A new hour: print the last one and change the wallet
+    if (millis() - startMs >= (unsigned long)(hour + 1) * HOUR_MS) {
+      printf("  %4d %9.1f %11.1f %6u %5.1f%% %12llu\n", hour + 1,
+             hourStats.minFree / 1024.0, hourStats.minLargest / 1024.0,
+             hourStats.maxHoles, hourStats.fragmentation(),
+             (unsigned long long)hourStats.allocations);
+      if (hour == 0) {
+        firstHour = hourStats;
+      }
+      lastHour = hourStats;
+      hourStats = HourStats();
+      hour++;
+
+      hostsim::HeapModelPause pause; // Not the firmware's memory
+      walletHour = hour;
+      wallet = walletOfHour(hour);
+      minswap = portfolio::minswapJson(wallet, hour);
+    }
+
+    const unsigned long passMs = millis() - passStart;
+    if (passMs < FRAME_INTERVAL_MS) {
+      delay(FRAME_INTERVAL_MS - passMs);
+    }
+  }
+
+  const hostsim::HeapModelStats model = hostsim::heapModelStats();
+  const double growth = lastHour.fragmentation() - firstHour.fragmentation();
+  printf("\n  Fragmentation: %.1f%% in the first hour, %.1f%% in the last "
+         "(%+.1f points, limit %d)\n", firstHour.fragmentation(),
+         lastHour.fragmentation(), growth, thresholdPoints);
+  printf("  Lowest free heap: %.1f KB, %llu allocations, %llu would have "
+         "failed\n\n", model.minFreeBytes / 1024.0,
+         (unsigned long long)model.allocations,
+         (unsigned long long)model.failures);
+
+  StdoutPrint out;
+  heapProfilerReport(out);
+
+  bool ok = true;
+  if (growth > thresholdPoints) {
+    fprintf(stderr, "\nFragmentation grew by %.1f points (limit %d)\n", growth,
+            thresholdPoints);
+    ok = false;
+  }
+  if (model.failures > 0) {
+    fprintf(stderr, "\n%llu allocations would have failed on the board\n",
+            (unsigned long long)model.failures);
+    ok = false;
+  }
+  return ok ? 0 : 1;
+}
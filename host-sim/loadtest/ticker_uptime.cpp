@@ -0,0 +1,179 @@
+/**
+ * ticker_uptime.cpp - Weeks of CardanoTicker on the virtual clock
+ *
+ * Includes CardanoTicker.ino itself and runs its setup() and loop(), with
+ * all the firmware behind them (data fetcher, screens, ticker, WiFi
+ * manager, profilers), for 60 simulated days in about a minute. loop() runs
+ * once per pass (a second by default); a pass that takes longer, because of
+ * a request, takes as long as it takes. The APIs are stubbed as in
+ * ticker_soak.cpp, on the same model of the ESP32 heap, and the wallet
+ * changes every hour.
+ *
+ * The script (days as in the report, counted from 1):
+ *   day 5, 10:00   the APIs give no answer for 3 hours
+ *   day 12, 02:00  WiFi is down for 6 hours
+ *   day 20         the APIs answer 2.5 s slower all day
+ *   day 50, 17:02  millis() wraps to 0 (49 days 17:02:47 after boot)
+ *
+ * What should happen on a schedule, and is checked (see uptime_sim.h):
+ *   balance        a Koios request every minute
+ *   portfolio      a MinSwap request every 10 minutes
+ *   screen change  the next screen every 10 seconds
+ *
+ * The program prints a line per day (requests per hour, deadlines missed,
+ * stalls, heap) and a summary, and fails when a deadline was missed or a
+ * loop() stalled outside the scripted events, or an allocation would have
+ * failed on the board.
+ *
+ * Usage: ./bin/ticker_uptime [days] [pass ms] [arena in KB]
+ */
+
+// The sketch, with its anonymous namespace (currentScreenIndex...) in this
+// file
+#include "CardanoTicker.ino"
+
+#include "hostsim.h"
+#include "portfolio_json.h"
+#include "uptime_sim.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace {
+const int DEFAULT_DAYS = 60;
+const uint64_t DEFAULT_PASS_MS = 1000;
+// Free heap of the ESP32 with WiFi connected, before the sketch allocates
+const size_t DEFAULT_ARENA_KB = 160;
+
+const uint32_t KOIOS_LATENCY_MS = 300;
+const uint32_t MINSWAP_LATENCY_MS = 900;
+const uint32_t CEXPLORER_LATENCY_MS = 400;
+
+// As in data_fetcher.cpp and CardanoTicker.ino
+const uint64_t KOIOS_INTERVAL_MS = 60000;
+const uint64_t PORTFOLIO_INTERVAL_MS = 600000;
+
+// The wallet in hour h: between 3 and 12 tokens, 1 to 5 collections
+portfolio::Portfolio walletOfHour(uint64_t hour) {
+  const uint32_t seed = 1000 + (uint32_t)hour;
+  return portfolio::generate(3 + (hour * 7) % 10, 1 + (hour * 3) % 5,
+                             1 + hour % 4, seed);
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  const int days = argc > 1 ? atoi(argv[1]) : DEFAULT_DAYS;
+  const uint64_t passMs =
+      argc > 2 ? (uint64_t)atoll(argv[2]) : DEFAULT_PASS_MS;
+  const size_t arenaKb =
+      argc > 3 ? (size_t)atol(argv[3]) : DEFAULT_ARENA_KB;
+  if (days < 1 || passMs < 1) {
+    fprintf(stderr, "Run at least 1 day, with passes of at least 1 ms\n");
+    return 1;
+  }
+  const uint64_t endMs = (uint64_t)days * uptime::DAY_MS;
+  hostsim::setSerialEcho(false);
+  hostsim::useVirtualClock(true);
+  hostsim::setDisplayDrawing(false); // Draw calls are counted, not drawn
+  hostsim::clearNvs();
+  hostsim::WiFiAccessPoint router;
+  router.ssid = WIFI_SSID; // The network in config/secrets.h
+  hostsim::setWiFiAccessPoint(router);
+
+  uptime::Script script;
+  script.add(uptime::EVENT_API_DOWN, 4 * uptime::DAY_MS + 10 * uptime::HOUR_MS,
+             3 * uptime::HOUR_MS);
+  script.add(uptime::EVENT_WIFI_DOWN, 11 * uptime::DAY_MS + 2 * uptime::HOUR_MS,
+             6 * uptime::HOUR_MS);
+  script.add(uptime::EVENT_API_SLOW, 19 * uptime::DAY_MS, uptime::DAY_MS, 2500);
+
+  // A request may wait a pass, and for the request made before it
+  const uint64_t toleranceMs = passMs + MINSWAP_LATENCY_MS;
+  uptime::UptimeReport report(script, endMs);
+  const int koiosApi = report.addApi("koios");
+  const int minswapApi = report.addApi("minswap");
+  const int cexplorerApi = report.addApi("cexplorer");
+  const int balanceDeadline =
+      report.addDeadline("balance", KOIOS_INTERVAL_MS, toleranceMs);
+  const int portfolioDeadline =
+      report.addDeadline("portfolio", PORTFOLIO_INTERVAL_MS, toleranceMs);
+  const int screenDeadline =
+      report.addDeadline("screen change", SCREEN_DURATION_MS, toleranceMs);
+
+  uint64_t walletHour = 0;
+  portfolio::Portfolio wallet = walletOfHour(0);
+  std::string minswap = portfolio::minswapJson(wallet, 0);
+  hostsim::setHttpHandler([&](const hostsim::HttpRequest &request) {
+    const uint64_t now = uptime::simMs();
+    hostsim::HttpResponse reply;
+    reply.code = 404;
+    if (request.url.find("account_info") != std::string::npos) {
+      report.request(koiosApi, now);
+      report.hit(balanceDeadline, now);
+      reply.code = 200;
+      reply.body = "[{\"stake_address\":\"stake1...\",\"total_balance\":\"" +
+                   std::to_string(1000000000ULL + walletHour * 7654321ULL) +
+                   "\"}]";
+      reply.latencyMs = KOIOS_LATENCY_MS;
+    } else if (request.url.find("/portfolio/tokens") != std::string::npos) {
+      report.request(minswapApi, now);
+      report.hit(portfolioDeadline, now);
+      reply.code = 200;
+      reply.body = minswap;
+      reply.latencyMs = MINSWAP_LATENCY_MS;
+    } else if (request.url.find("/policy/detail") != std::string::npos) {
+      report.request(cexplorerApi, now);
+      reply.latencyMs = CEXPLORER_LATENCY_MS;
+      for (const portfolio::Collection &collection : wallet.collections) {
+        if (request.url.find(collection.policyId) != std::string::npos) {
+          reply.code = 200;
+          reply.body = portfolio::cexplorerJson(collection);
+        }
+      }
+    }
+    script.shape(reply, now);
+    return reply;
+  });
+
+  printf("CardanoTicker for %d days (simulated), loop() every %llu ms, on a "
+         "%zu KB heap model\n\n", days, (unsigned long long)passMs, arenaKb);
+
+  // From here on the firmware's allocations are on the modelled heap
+  hostsim::useHeapModel(arenaKb * 1024);
+  setup();
+
+  uint8_t shownScreen = currentScreenIndex;
+  bool screensWereStarted = false;
+  uint64_t now = uptime::simMs();
+  while (now < endMs) {
+    script.update(now);
+    loop();
+    now = uptime::simMs();
+
+    if (screensStarted && !screensWereStarted) {
+      report.start(screenDeadline, now);
+      screensWereStarted = true;
+    } else if (currentScreenIndex != shownScreen) {
+      report.hit(screenDeadline, now);
+    }
+    shownScreen = currentScreenIndex;
+    report.pass(now);
+
+    // A new hour: the wallet changes
+    if (now / uptime::HOUR_MS != walletHour) {
+      hostsim::HeapModelPause pause; // Not the firmware's memory
+      walletHour = now / uptime::HOUR_MS;
+      wallet = walletOfHour(walletHour);
+      minswap = portfolio::minswapJson(wallet, (uint32_t)walletHour);
+    }
+
+    // On to the next pass
+    const uint64_t passEnd = (now / passMs + 1) * passMs;
+    hostsim::advanceClock(passEnd - now);
+    now = passEnd;
+  }
+
+  hostsim::HeapModelPause pause;
+  return report.finish(now) ? 0 : 1;
+}
@@ -0,0 +1,517 @@
+/**
+ * uptime_sim.h - Shared parts of the uptime simulations
+ *
+ * ticker_uptime.cpp and pos_uptime.cpp run a sketch's own setup() and
+ * loop() for weeks on the virtual clock: loop() once per pass, and when a
+ * pass took less than the pass time, the clock moves on to the next one.
+ * What both need is here:
+ * - Script: outages and slow APIs at set times
+ * - UptimeReport: requests per hour for each API, the gaps between things
+ *   that should happen on a schedule (deadlines: a fetch every minute, a
+ *   screen change every 10 s), heap samples and loop() stalls. It prints a
+ *   line per day and a summary, with what happened around the millis()
+ *   wrap-around.
+ *
+ * millis() counts in 32 bits on the ESP32 and wraps to 0 after 2^32 ms,
+ * 49 days 17:02:47. The simulations keep a 64 bit time of their own
+ * (simMs()) to measure the firmware against.
+ */
+
+#ifndef UPTIME_SIM_H
+#define UPTIME_SIM_H
+
+#include "heap_profiler.h"
+#include "hostsim.h"
+#include "loop_profiler.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace uptime {
+
+const uint64_t SECOND_MS = 1000ULL;
+const uint64_t MINUTE_MS = 60ULL * SECOND_MS;
+const uint64_t HOUR_MS = 60ULL * MINUTE_MS;
+const uint64_t DAY_MS = 24ULL * HOUR_MS;
+
+// millis() is 0 again here
+const uint64_t WRAP_MS = 1ULL << 32;
+
+// Latency of an answer that never comes: every HTTPClient gives up first
+const uint32_t NO_ANSWER_MS = 60000;
+
+// After an event ends, reconnecting and catching up may take this long.
+// Gaps that overlap an event or this time after it are not counted as late
+// or early.
+const uint64_t RECOVERY_MS = 2ULL * MINUTE_MS;
+
+// Simulated time since the start, 64 bit (millis() of a board that would
+// not wrap)
+inline uint64_t simMs() { return hostsim::clockMicros() / 1000ULL; }
+
+// "49d 17:02:47"
+inline std::string formatTime(uint64_t ms) {
+  const unsigned long long seconds = ms / 1000ULL;
+  char text[40];
+  snprintf(text, sizeof(text), "%llud %02llu:%02llu:%02llu", seconds / 86400,
+           seconds / 3600 % 24, seconds / 60 % 60, seconds % 60);
+  return text;
+}
+
+// --- Script ---
+
+enum EventKind {
+  EVENT_API_DOWN,  // Requests get no answer (read timeout)
+  EVENT_API_SLOW,  // Answers take extraMs longer
+  EVENT_WIFI_DOWN, // The network is gone
+};
+
+struct Event {
+  EventKind kind;
+  uint64_t startMs;
+  uint64_t durationMs;
+  uint32_t extraMs; // EVENT_API_SLOW
+  uint64_t endMs() const { return startMs + durationMs; }
+};
+
+// What the world does to the device, and when
+class Script {
+public:
+  void add(EventKind kind, uint64_t startMs, uint64_t durationMs,
+           uint32_t extraMs = 0) {
+    events_.push_back({kind, startMs, durationMs, extraMs});
+  }
+
+  // Take the network away or bring it back (call every pass)
+  void update(uint64_t nowMs) {
+    const bool down = active(EVENT_WIFI_DOWN, nowMs) != nullptr;
+    if (down != wifiDown_) {
+      hostsim::setWiFiConnected(!down);
+      wifiDown_ = down;
+    }
+  }
+
+  // Change an API's answer to a request made now: no answer while the APIs
+  // are down, a later one while they are slow
+  void shape(hostsim::HttpResponse &reply, uint64_t nowMs) const {
+    if (active(EVENT_API_DOWN, nowMs) != nullptr) {
+      reply = hostsim::HttpResponse();
+      reply.latencyMs = NO_ANSWER_MS;
+      return;
+    }
+    const Event *slow = active(EVENT_API_SLOW, nowMs);
+    if (slow != nullptr) {
+      reply.latencyMs += slow->extraMs;
+    }
+  }
+
+  // Whether the time from fromMs to toMs overlaps an event (or the
+  // RECOVERY_MS after one)
+  bool disturbed(uint64_t fromMs, uint64_t toMs) const {
+    for (const Event &event : events_) {
+      if (fromMs < event.endMs() + RECOVERY_MS && toMs >= event.startMs) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // "WiFi down for 6 h" (for the report)
+  static std::string describe(const Event &event) {
+    char text[64];
+    const double hours = event.durationMs / (double)HOUR_MS;
+    switch (event.kind) {
+    case EVENT_API_DOWN:
+      snprintf(text, sizeof(text), "APIs down for %.1f h", hours);
+      break;
+    case EVENT_API_SLOW:
+      snprintf(text, sizeof(text), "APIs %u ms slower for %.1f h",
+               (unsigned)event.extraMs, hours);
+      break;
+    default:
+      snprintf(text, sizeof(text), "WiFi down for %.1f h", hours);
+      break;
+    }
+    return text;
+  }
+
+  const std::vector<Event> &events() const { return events_; }
+
+private:
+  const Event *active(EventKind kind, uint64_t nowMs) const {
+    for (const Event &event : events_) {
+      if (event.kind == kind && nowMs >= event.startMs &&
+          nowMs < event.endMs()) {
+        return &event;
+      }
+    }
+    return nullptr;
+  }
+
+  std::vector<Event> events_;
+  bool wifiDown_ = false;
+};
+
+// --- Report ---
+
+// Something that should happen every intervalMs, give or take toleranceMs
+// (the pass time, and the requests that may run in the same pass)
+struct Deadline {
+  const char *name = "";
+  uint64_t intervalMs = 0;
+  uint64_t toleranceMs = 0;
+
+  bool armed = false;   // Expected to happen again
+  bool overdue = false; // Counted as late already
+  uint64_t lastMs = 0;
+
+  uint64_t gaps = 0;
+  uint64_t early = 0;
+  uint64_t late = 0;
+  uint64_t excused = 0; // Early or late during an event
+  uint64_t minGapMs = UINT64_MAX;
+  uint64_t maxGapMs = 0;
+  uint64_t dayEarly = 0;
+  uint64_t dayLate = 0;
+
+  bool acrossWrap = false; // A gap spanned the millis() wrap-around
+  uint64_t wrapGapMs = 0;
+  bool wrapExcused = false;
+};
+
+class UptimeReport {
+public:
+  UptimeReport(const Script &script, uint64_t durationMs)
+      : script_(script),
+        hours_((size_t)((durationMs + HOUR_MS - 1) / HOUR_MS)) {}
+
+  // An API whose requests are counted per hour; returns its index
+  int addApi(const char *name) {
+    apis_.push_back(Api{name, std::vector<uint32_t>(hours_, 0)});
+    return (int)apis_.size() - 1;
+  }
+
+  // A schedule to check; returns its index. It is checked from the first
+  // start() or hit() on.
+  int addDeadline(const char *name, uint64_t intervalMs,
+                  uint64_t toleranceMs) {
+    Deadline deadline;
+    deadline.name = name;
+    deadline.intervalMs = intervalMs;
+    deadline.toleranceMs = toleranceMs;
+    deadlines_.push_back(deadline);
+    return (int)deadlines_.size() - 1;
+  }
+
+  void request(int api, uint64_t nowMs) {
+    const size_t hour = (size_t)(nowMs / HOUR_MS);
+    if (hour < hours_) {
+      apis_[api].perHour[hour]++;
+    }
+  }
+
+  // Expect the deadline's next hit intervalMs from now (a timer started)
+  void start(int index, uint64_t nowMs) {
+    Deadline &deadline = deadlines_[index];
+    deadline.armed = true;
+    deadline.overdue = false;
+    deadline.lastMs = nowMs;
+  }
+
+  // Not expected any more (a timer that ran out, a watch that ended)
+  void stop(int index) { deadlines_[index].armed = false; }
+
+  // It happened: check the gap since the last time, and expect it again
+  void hit(int index, uint64_t nowMs) {
+    Deadline &deadline = deadlines_[index];
+    if (deadline.armed) {
+      const uint64_t gap = nowMs - deadline.lastMs;
+      const bool excused = script_.disturbed(deadline.lastMs, nowMs);
+      const bool early = gap + deadline.toleranceMs < deadline.intervalMs;
+      const bool late = gap > deadline.intervalMs + deadline.toleranceMs;
+      deadline.gaps++;
+      if ((early || late) && excused) {
+        deadline.excused++;
+      } else if (early) {
+        deadline.early++;
+        deadline.dayEarly++;
+      } else if (late && !deadline.overdue) {
+        deadline.late++;
+        deadline.dayLate++;
+      }
+      if (!excused) {
+        deadline.minGapMs = gap < deadline.minGapMs ? gap : deadline.minGapMs;
+        deadline.maxGapMs = gap > deadline.maxGapMs ? gap : deadline.maxGapMs;
+      }
+      if (deadline.lastMs < WRAP_MS && nowMs >= WRAP_MS) {
+        deadline.acrossWrap = true;
+        deadline.wrapGapMs = gap;
+        deadline.wrapExcused = excused;
+      }
+    }
+    start(index, nowMs);
+  }
+
+  // Call after every pass: heap samples, stalls, overdue deadlines, and the
+  // line of a day that just ended
+  void pass(uint64_t nowMs) {
+    const HeapSample sample = heapProfilerLast();
+    if (sample.atMs != lastSampleAt_ && sample.freeBytes > 0) {
+      lastSampleAt_ = sample.atMs;
+      day_.add(sample);
+    }
+
+    const uint32_t stalls = loopProfilerStallCount();
+    if (stalls != stallCount_) {
+      const LoopStall stall = loopProfilerLastStall();
+      const uint64_t stallMs = stall.loopMicros / 1000;
+      if (script_.disturbed(nowMs - stallMs, nowMs)) {
+        excusedStalls_ += stalls - stallCount_;
+      } else {
+        day_.stalls += stalls - stallCount_;
+        stalls_ += stalls - stallCount_;
+        if (stall.loopMicros > longestStallMicros_) {
+          longestStallMicros_ = stall.loopMicros;
+          longestStallAt_ = nowMs;
+          longestStallSection_ = stall.section;
+        }
+      }
+      stallCount_ = stalls;
+    }
+
+    // A deadline that stops for good is late now, not only at the end
+    for (Deadline &deadline : deadlines_) {
+      if (deadline.armed && !deadline.overdue &&
+          nowMs - deadline.lastMs >
+              deadline.intervalMs + deadline.toleranceMs &&
+          !script_.disturbed(deadline.lastMs, nowMs)) {
+        deadline.overdue = true;
+        deadline.late++;
+        deadline.dayLate++;
+      }
+    }
+
+    while (nowMs >= (uint64_t)(days_ + 1) * DAY_MS) {
+      printDay();
+    }
+  }
+
+  // Print the summary; false if something was late or early without an
+  // event to explain it, a loop() stalled, or an allocation failed
+  bool finish(uint64_t nowMs) {
+    pass(nowMs);
+    if (nowMs > (uint64_t)days_ * DAY_MS) {
+      printDay(); // The part of a day at the end
+    }
+    bool ok = true;
+
+    printf("\n  Requests per hour\n");
+    printf("  %-12s %10s %8s %8s %8s  %s\n", "api", "requests", "mean",
+           "min", "max", "busiest hour");
+    for (const Api &api : apis_) {
+      uint64_t total = 0;
+      uint32_t least = UINT32_MAX;
+      uint32_t most = 0;
+      size_t busiest = 0;
+      const size_t hours = hoursUntil(nowMs);
+      for (size_t hour = 0; hour < hours; hour++) {
+        const uint32_t count = api.perHour[hour];
+        total += count;
+        least = count < least ? count : least;
+        if (count > most) {
+          most = count;
+          busiest = hour;
+        }
+      }
+      printf("  %-12s %10llu %8.1f %8u %8u  %s\n", api.name,
+             (unsigned long long)total, hours ? (double)total / hours : 0.0,
+             hours ? least : 0, most,
+             formatTime(busiest * HOUR_MS).c_str());
+    }
+
+    printf("\n  Deadlines (gaps outside events, in seconds)\n");
+    printf("  %-16s %9s %9s %7s %7s %8s %9s %9s\n", "deadline", "interval",
+           "gaps", "early", "late", "excused", "shortest", "longest");
+    for (const Deadline &deadline : deadlines_) {
+      printf("  %-16s %9.1f %9llu %7llu %7llu %8llu %9.1f %9.1f\n",
+             deadline.name, deadline.intervalMs / 1000.0,
+             (unsigned long long)deadline.gaps,
+             (unsigned long long)deadline.early,
+             (unsigned long long)deadline.late,
+             (unsigned long long)deadline.excused,
+             deadline.minGapMs == UINT64_MAX ? 0.0
+                                             : deadline.minGapMs / 1000.0,
+             deadline.maxGapMs / 1000.0);
+      if (deadline.early > 0 || deadline.late > 0) {
+        ok = false;
+      }
+    }
+
+    if (nowMs >= WRAP_MS) {
+      printf("\n  millis() wrapped to 0 at %s\n", formatTime(WRAP_MS).c_str());
+      for (const Deadline &deadline : deadlines_) {
+        if (!deadline.acrossWrap) {
+          printf("    %-16s no gap across it\n", deadline.name);
+          continue;
+        }
+        const bool onTime =
+            deadline.wrapGapMs + deadline.toleranceMs >= deadline.intervalMs &&
+            deadline.wrapGapMs <= deadline.intervalMs + deadline.toleranceMs;
+        printf("    %-16s gap across it %.1f s (%s)\n", deadline.name,
+               deadline.wrapGapMs / 1000.0,
+               onTime ? "on time"
+                      : deadline.wrapExcused ? "during an event" : "WRONG");
+      }
+    } else {
+      printf("\n  millis() wraps at %s, run longer to cross it\n",
+             formatTime(WRAP_MS).c_str());
+    }
+
+    printf("\n  loop() stalls: %llu outside events", (unsigned long long)stalls_);
+    if (stalls_ > 0) {
+      printf(" (longest %.1f ms in %s at %s)", longestStallMicros_ / 1000.0,
+             longestStallSection_, formatTime(longestStallAt_).c_str());
+      ok = false;
+    }
+    printf(", %llu during events\n", (unsigned long long)excusedStalls_);
+
+    const hostsim::HeapModelStats model = hostsim::heapModelStats();
+    if (model.arenaBytes > 0) {
+      printf("  Heap: first day %.1f KB free, largest %.1f KB, %.1f%% "
+             "fragmented; last day %.1f KB, %.1f KB, %.1f%%\n",
+             firstDay_.minFree / 1024.0, firstDay_.minLargest / 1024.0,
+             firstDay_.fragmentation(), lastDay_.minFree / 1024.0,
+             lastDay_.minLargest / 1024.0, lastDay_.fragmentation());
+      printf("  Lowest free heap %.1f KB, %llu allocations, %llu would have "
+             "failed\n", model.minFreeBytes / 1024.0,
+             (unsigned long long)model.allocations,
+             (unsigned long long)model.failures);
+      if (model.failures > 0) {
+        ok = false;
+      }
+    }
+    return ok;
+  }
+
+private:
+  struct Api {
+    const char *name;
+    std::vector<uint32_t> perHour;
+  };
+
+  struct Day {
+    uint32_t samples = 0;
+    uint32_t fragmentationSum = 0;
+    uint32_t minFree = UINT32_MAX;
+    uint32_t minLargest = UINT32_MAX;
+    uint64_t stalls = 0;
+
+    void add(const HeapSample &sample) {
+      samples++;
+      fragmentationSum += sample.fragmentation;
+      minFree = sample.freeBytes < minFree ? sample.freeBytes : minFree;
+      minLargest =
+          sample.largestBlock < minLargest ? sample.largestBlock : minLargest;
+    }
+    double fragmentation() const {
+      return samples == 0 ? 0.0 : (double)fragmentationSum / samples;
+    }
+  };
+
+  size_t hoursUntil(uint64_t nowMs) const {
+    const size_t hours = (size_t)(nowMs / HOUR_MS);
+    return hours < hours_ ? hours : hours_;
+  }
+
+  void printHeader() {
+    printf("  %4s", "day");
+    for (const Api &api : apis_) {
+      printf(" %11.11s", api.name);
+    }
+    printf(" %5s %5s %6s %8s %8s %5s  %s\n", "early", "late", "stalls",
+           "free KB", "block KB", "frag", "events");
+    printf("  %4s", "");
+    for (size_t i = 0; i < apis_.size(); i++) {
+      printf(" %11s", "min-max/h");
+    }
+    printf("\n");
+  }
+
+  void printDay() {
+    hostsim::HeapModelPause pause; // The report's strings are not firmware's
+    if (days_ == 0) {
+      printHeader();
+    }
+    const uint64_t dayStart = (uint64_t)days_ * DAY_MS;
+    const uint64_t dayEnd = dayStart + DAY_MS;
+    printf("  %4d", days_ + 1);
+    for (const Api &api : apis_) {
+      uint32_t least = UINT32_MAX;
+      uint32_t most = 0;
+      for (size_t hour = days_ * 24; hour < (size_t)(days_ + 1) * 24 &&
+                                     hour < hours_; hour++) {
+        least = api.perHour[hour] < least ? api.perHour[hour] : least;
+        most = api.perHour[hour] > most ? api.perHour[hour] : most;
+      }
+      char range[24];
+      snprintf(range, sizeof(range), "%u-%u", least == UINT32_MAX ? 0 : least,
+               most);
+      printf(" %11s", range);
+    }
+    uint64_t early = 0;
+    uint64_t late = 0;
+    for (Deadline &deadline : deadlines_) {
+      early += deadline.dayEarly;
+      late += deadline.dayLate;
+      deadline.dayEarly = deadline.dayLate = 0;
+    }
+    printf(" %5llu %5llu %6llu %8.1f %8.1f %4.1f%% ",
+           (unsigned long long)early, (unsigned long long)late,
+           (unsigned long long)day_.stalls,
+           day_.samples ? day_.minFree / 1024.0 : 0.0,
+           day_.samples ? day_.minLargest / 1024.0 : 0.0,
+           day_.fragmentation());
+    for (const Event &event : script_.events()) {
+      if (event.startMs >= dayStart && event.startMs < dayEnd) {
+        printf(" %s at %s;", Script::describe(event).c_str(),
+               formatTime(event.startMs % DAY_MS).c_str() + 3);
+      }
+    }
+    if (WRAP_MS >= dayStart && WRAP_MS < dayEnd) {
+      printf(" millis() wraps at %s;",
+             formatTime(WRAP_MS % DAY_MS).c_str() + 3);
+    }
+    printf("\n");
+
+    if (days_ == 0) {
+      firstDay_ = day_;
+    }
+    lastDay_ = day_;
+    day_ = Day();
+    days_++;
+  }
+
+  const Script &script_;
+  size_t hours_;
+  std::vector<Api> apis_;
+  std::vector<Deadline> deadlines_;
+
+  int days_ = 0; // Printed
+  Day day_;
+  Day firstDay_;
+  Day lastDay_;
+  unsigned long lastSampleAt_ = 0;
+
+  uint32_t stallCount_ = 0;
+  uint64_t stalls_ = 0;
+  uint64_t excusedStalls_ = 0;
+  uint32_t longestStallMicros_ = 0;
+  uint64_t longestStallAt_ = 0;
+  const char *longestStallSection_ = "";
+};
+
+} // namespace uptime
+
+#endif